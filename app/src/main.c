@@ -2153,6 +2153,66 @@ vkr_internal void application_update_scene(Application *application,
   }
 }
 
+/**
+ * @brief Click selection through the CPU scene raycast.
+ *
+ * Used when the renderer runs without the picking subsystem, so there is no
+ * ID buffer to read back. Hits come from the mesh manager's bounds index and
+ * per-asset triangle BVHs as of the last scene sync.
+ */
+vkr_internal void application_update_cpu_picking(Application *application) {
+  bool8_t left_pressed =
+      input_is_button_down(state->input_state, BUTTON_LEFT) &&
+      input_was_button_up(state->input_state, BUTTON_LEFT);
+  if (!left_pressed || !state->scene_resource.as.scene) {
+    return;
+  }
+
+  int32_t mouse_x = 0;
+  int32_t mouse_y = 0;
+  input_get_mouse_position(state->input_state, &mouse_x, &mouse_y);
+  VkrViewportHitInfo viewport_info =
+      application_get_viewport_hit_info(application, mouse_x, mouse_y);
+  VkrCamera *camera =
+      vkr_camera_registry_get_by_handle(&application->renderer.camera_system,
+                                        application->renderer.active_camera);
+  Vec3 ray_origin = vec3_zero();
+  Vec3 ray_dir = vec3_zero();
+  if (!camera || !viewport_info.has_target_coords ||
+      !application_build_view_ray(
+          camera, viewport_info.target_width, viewport_info.target_height,
+          viewport_info.target_x, viewport_info.target_y, &ray_origin,
+          &ray_dir)) {
+    return;
+  }
+
+  VkrSceneRayHit hit = {0};
+  const bool8_t picked = vkr_scene_handle_raycast(
+      state->scene_resource.as.scene, &application->renderer, ray_origin,
+      ray_dir, camera->far_clip, &hit);
+  const bool8_t picked_entity_valid =
+      picked && hit.entity.u64 != VKR_ENTITY_ID_INVALID.u64;
+  state->selected_entity =
+      picked_entity_valid ? hit.entity : VKR_ENTITY_ID_INVALID;
+  state->has_selection = picked_entity_valid;
+
+  VkrAllocator *frame_alloc = &application->renderer.scratch_allocator;
+  String8 picked_text = string8_lit("Picked: none");
+  if (picked_entity_valid) {
+    VkrScene *scene =
+        vkr_scene_handle_get_scene(state->scene_resource.as.scene);
+    String8 name = scene ? vkr_scene_get_name(scene, hit.entity) : (String8){0};
+    picked_text =
+        name.length > 0
+            ? string8_create_formatted(frame_alloc, "Picked: %.*s",
+                                       (int)name.length, name.str)
+            : string8_create_formatted(frame_alloc, "Picked: entity %u",
+                                       hit.entity.parts.index);
+  }
+  application_queue_ui_text_update(application, state->picked_object_text_id,
+                                   picked_text);
+}
+
 vkr_internal void application_update_picking(Application *application) {
   if (!application || !state || !state->input_state) {
     return;
@@ -2160,6 +2220,7 @@ vkr_internal void application_update_picking(Application *application) {
 
   VkrPickingContext *picking = &application->renderer.picking;
   if (!picking->initialized) {
+    application_update_cpu_picking(application);
     return;
   }
 
@@ -2540,7 +2601,7 @@ int main(int argc, char **argv) {
       metrics_json_path = argv[++i];
     } else if (strcmp(argv[i], "--renderer") == 0) {
       if (i + 1 >= argc || argv[i + 1][0] == '\0') {
-        fprintf(stderr, "--renderer requires 'vulkan' or 'metal'\n");
+        fprintf(stderr, "--renderer requires 'vulkan', 'metal', or 'null'\n");
         return 2;
       }
       const char *renderer_name = argv[++i];
@@ -2548,6 +2609,8 @@ int main(int argc, char **argv) {
         renderer_backend = VKR_RENDERER_BACKEND_TYPE_VULKAN;
       } else if (strcmp(renderer_name, "metal") == 0) {
         renderer_backend = VKR_RENDERER_BACKEND_TYPE_METAL;
+      } else if (strcmp(renderer_name, "null") == 0) {
+        renderer_backend = VKR_RENDERER_BACKEND_TYPE_NULL;
       } else {
         fprintf(stderr, "unknown renderer '%s'\n", renderer_name);
         return 2;
@@ -2558,6 +2621,13 @@ int main(int argc, char **argv) {
       application_env_flag("VKR_RG_GPU_TIMING", false_v);
   const bool8_t metrics_event_subjects =
       application_env_flag("VKR_METRICS_EVENT_SUBJECTS", false_v);
+  const bool8_t metrics_histogram_export =
+      application_env_flag("VKR_METRICS_HISTOGRAM_EXPORT", false_v);
+  const bool8_t async_logging = application_env_flag("VKR_ASYNC_LOG", false_v);
+  const bool8_t events_on_main_thread =
+      application_env_flag("VKR_EVENTS_MAIN_THREAD", false_v);
+  const bool8_t texture_streaming =
+      application_env_flag("VKR_TEXTURE_STREAMING", false_v);
 
   ApplicationConfig config = {0};
   config.title = "Hello, World!";
@@ -2568,9 +2638,14 @@ int main(int argc, char **argv) {
   config.app_arena_size = MB(1);
   config.target_frame_rate = 0;
   config.renderer_backend = renderer_backend;
+  config.async_logging = async_logging;
+  config.events_on_main_thread = events_on_main_thread;
+  config.texture_streaming = texture_streaming;
   config.metrics_config = (VkrMetricsConfig){
       .pass_gpu_timings = rg_gpu_timing_enabled,
       .event_subjects = metrics_event_subjects,
+      // About once a second at 60 Hz; four events per histogram.
+      .histogram_export_interval = metrics_histogram_export ? 60u : 0u,
   };
   config.device_requirements = (VkrDeviceRequirements){
       .supported_stages =
@@ -2714,6 +2789,10 @@ int main(int argc, char **argv) {
   if (metrics_event_subjects) {
     log_info("Metrics event subjects enabled via VKR_METRICS_EVENT_SUBJECTS");
   }
+  if (metrics_histogram_export) {
+    log_info("Metrics histogram export enabled via "
+             "VKR_METRICS_HISTOGRAM_EXPORT");
+  }
 
   state->assert_no_upload_waits =
       application_env_flag("VKR_ASSERT_NO_UPLOAD_WAITS", false_v);
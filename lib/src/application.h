@@ -51,23 +51,30 @@
 #include "core/vkr_clock.h"
 #include "core/vkr_gamepad.h"
 #include "core/vkr_job_system.h"
+#include "core/vkr_parallel_for.h"
 #include "core/vkr_metrics.h"
 #include "core/vkr_threads.h"
+#include "core/vkr_trace.h"
 #include "core/vkr_window.h"
 #include "defines.h"
 #include "math/vec.h"
 #include "math/vkr_frustum.h"
 #include "memory/arena.h"
 #include "memory/vkr_arena_allocator.h"
+#include "memory/vkr_dmemory_allocator.h"
 #include "renderer/renderer_frontend.h"
 #include "renderer/systems/vkr_camera.h"
 #include "renderer/systems/vkr_camera_controller.h"
 #include "renderer/systems/vkr_editor_viewport.h"
 #include "renderer/systems/vkr_picking_ids.h"
+#include "renderer/systems/vkr_texture_streaming.h"
+#include "renderer/vkr_occlusion.h"
 #include "renderer/vkr_render_packet.h"
 #include "renderer/vkr_renderer.h"
 #include "renderer/vkr_renderer_metrics.h"
 #include "renderer/vkr_visibility.h"
+#include "renderer/vkr_world_instancing.h"
+#include "renderer/vkr_world_payload.h"
 
 /**
  * @brief Editor viewport state owned by the application.
@@ -138,6 +145,14 @@ typedef struct ApplicationConfig {
   /** Boot intent only: `profile`, `requested_mask`, and `excluded_mask` are
       read and the closure is recomputed. Zero-initialized means full boot. */
   VkrSubsystemPlan subsystem_plan;
+  /** Defer log formatting to a drain thread (see LogAsyncConfig). */
+  bool8_t async_logging;
+  /** Dispatch events on the main thread once per frame, after window and
+      gamepad polling, instead of on the event worker thread. */
+  bool8_t events_on_main_thread;
+  /** Publish mip-chained textures as a low-resolution tail and stream finer
+      mips in by on-screen size (see vkr_texture_streaming.h). */
+  bool8_t texture_streaming;
 } ApplicationConfig;
 
 typedef struct ApplicationMetricIds {
@@ -156,6 +171,11 @@ typedef struct ApplicationMetricIds {
   // than in the renderer catalog.
   VkrMetricId shadow_update;
   VkrMetricId world_payload_build;
+  // Distributions of frame_wall and frame_work. The duration slots keep their
+  // exact per-frame sums; these carry the windowed tails (p99, p99.9) that a
+  // mean and a max cannot show.
+  VkrMetricId frame_wall_histogram;
+  VkrMetricId frame_work_histogram;
 } ApplicationMetricIds;
 
 /**
@@ -167,6 +187,7 @@ typedef struct Application {
   Arena *app_arena; /**< Main memory arena for general application use (e.g.,
                        game entities, state). */
   Arena *log_arena; /**< Memory arena dedicated to the logging system. */
+  VkrAllocator log_allocator; /**< Backs async log rings in `log_arena`. */
   VkrAllocator app_allocator; /**< Allocator backed by `app_arena` for thread
                                  primitives and other systems. */
   Arena *metrics_arena;
@@ -193,8 +214,23 @@ typedef struct Application {
   /** Last frame's frustum-culling counters, produced by payload construction.
    */
   VkrVisibilityStats visibility_stats;
+  /** Rolls mesh and material change counters into the payload's
+   * `opaque_set_version`. */
+  VkrOpaqueSetVersion opaque_set_version;
 
   VkrJobSystem job_system; /**< Engine-wide job system. */
+  /** Splits world payload construction across `job_system`. */
+  VkrParallelFor world_payload_for;
+  /** Occluder triangles the CPU occlusion buffer takes per frame; 0 turns
+   * occlusion culling off. */
+  uint32_t occlusion_triangle_budget;
+  /** Mip residency for textures loaded after startup; only valid while
+   * `texture_streaming_enabled`. Outlives the renderer, whose texture
+   * teardown unregisters from it. */
+  VkrTextureStreaming texture_streaming;
+  VkrDMemory texture_streaming_memory;
+  VkrAllocator texture_streaming_allocator;
+  bool8_t texture_streaming_enabled;
 
   ApplicationTextUpdate ui_text_updates[VKR_MAX_PENDING_TEXT_UPDATES];
   uint32_t ui_text_update_count;
@@ -286,6 +322,21 @@ vkr_internal bool8_t application_register_duration_metric(
   return vkr_metrics_register(metrics, &description, out_id);
 }
 
+vkr_internal bool8_t application_register_histogram_metric(
+    VkrMetrics *metrics, const char *name, VkrMetricId *out_id) {
+  const VkrMetricDescription description = {
+      .name =
+          string8_create_from_cstr((const uint8_t *)name, string_length(name)),
+      .domain = VKR_METRIC_DOMAIN_FRAME,
+      .kind = VKR_METRIC_KIND_HISTOGRAM,
+      .unit = VKR_METRIC_UNIT_NANOSECONDS,
+      .scalar = VKR_METRIC_SCALAR_U64,
+      .writer = VKR_METRIC_WRITER_RENDER_THREAD,
+      .required_when_enabled = false_v,
+  };
+  return vkr_metrics_register(metrics, &description, out_id);
+}
+
 vkr_internal bool8_t application_metrics_initialize(Application *application) {
   application->metrics_arena = arena_create(MB(2), KB(64));
   if (!application->metrics_arena) {
@@ -336,12 +387,58 @@ vkr_internal bool8_t application_metrics_initialize(Application *application) {
       !application_register_duration_metric(
           application->metrics, "cpu.world_payload_build",
           VKR_METRIC_DOMAIN_FRAME, false_v, &ids->world_payload_build) ||
+      !application_register_histogram_metric(application->metrics,
+                                             "frame.wall.histogram",
+                                             &ids->frame_wall_histogram) ||
+      !application_register_histogram_metric(application->metrics,
+                                             "cpu.frame_work.histogram",
+                                             &ids->frame_work_histogram) ||
       !vkr_renderer_metrics_register(&application->renderer_metrics,
                                      application->metrics)) {
     return false_v;
   }
   return true_v;
 }
+/**
+ * @brief Attaches a texture streamer to the renderer's texture system.
+ *
+ * Textures loaded before this point (the system defaults) keep their full
+ * chain. Streaming only trims memory, so a failure here logs and carries on
+ * with full chains rather than failing startup.
+ */
+vkr_internal void
+application_texture_streaming_initialize(Application *application) {
+  RendererFrontend *rf = &application->renderer;
+  if (!vkr_dmemory_create(MB(16), GB(2),
+                          &application->texture_streaming_memory)) {
+    log_warn("Texture streaming unavailable; loading full mip chains");
+    return;
+  }
+  application->texture_streaming_allocator =
+      (VkrAllocator){.ctx = &application->texture_streaming_memory};
+  vkr_dmemory_allocator_create(&application->texture_streaming_allocator);
+
+  const VkrTextureStreamingConfig streaming_config = {
+      .capacity = rf->texture_system.config.max_texture_count,
+      .tail_mip_count = 4u,
+      .resident_budget_bytes = MB(512),
+      .upload_budget_bytes = MB(16),
+      // About two seconds at 60 Hz.
+      .idle_frames_before_drop = 120u,
+  };
+  if (!vkr_texture_streaming_init(
+          &application->texture_streaming,
+          &application->texture_streaming_allocator, &rf->asset_publisher,
+          &streaming_config)) {
+    log_warn("Texture streaming unavailable; loading full mip chains");
+    vkr_dmemory_allocator_destroy(&application->texture_streaming_allocator);
+    return;
+  }
+  vkr_texture_system_set_streaming(&rf->texture_system,
+                                   &application->texture_streaming);
+  application->texture_streaming_enabled = true_v;
+}
+
 /**
  * @brief Creates a cube mesh and uploads it to GPU buffers
  * @param application Pointer to the `Application` structure.
@@ -407,6 +504,14 @@ bool8_t application_create(Application *application,
   }
 
   log_init(application->log_arena);
+  if (config->async_logging) {
+    application->log_allocator = (VkrAllocator){.ctx = application->log_arena};
+    vkr_allocator_arena(&application->log_allocator);
+    const LogAsyncConfig log_config = log_async_config_default();
+    if (!log_async_start(&application->log_allocator, &log_config)) {
+      log_warn("Async logging unavailable; logging synchronously");
+    }
+  }
 
   log_debug("Initialized logging");
 
@@ -415,7 +520,15 @@ bool8_t application_create(Application *application,
     return false_v;
   }
 
-  event_manager_create(&application->event_manager);
+  EventManagerConfig event_config = event_manager_config_default();
+  if (config->events_on_main_thread) {
+    event_config.mode = EVENT_DISPATCH_MODE_MANUAL;
+  }
+  if (!event_manager_create_with_config(&application->event_manager,
+                                        &event_config)) {
+    log_fatal("Failed to create event manager");
+    return false_v;
+  }
   const bool8_t windowed =
       config->present_target.kind != VKR_PRESENT_TARGET_OFFSCREEN;
   if (windowed) {
@@ -438,12 +551,17 @@ bool8_t application_create(Application *application,
     log_fatal("Failed to initialize job system");
     return false_v;
   }
+  vkr_parallel_for_init(&application->world_payload_for,
+                        &application->job_system);
+  application->occlusion_triangle_budget =
+      VKR_OCCLUSION_DEFAULT_TRIANGLE_BUDGET;
 
   VkrRendererError renderer_error = VKR_RENDERER_ERROR_NONE;
   const VkrRendererMetricsProducerConfig *metrics_producers =
       vkr_renderer_metrics_get_producers(&application->renderer_metrics);
   VkrRendererBackendConfig backend_cfg = {
       .application_name = "vulkan_renderer",
+      .job_system = &application->job_system,
       .present_target = config->present_target,
       .requested_present_mode = config->requested_present_mode,
       .capture_enabled = config->capture_enabled,
@@ -486,6 +604,8 @@ bool8_t application_create(Application *application,
     log_fatal("Failed to initialize renderer frontend systems");
     return false_v;
   }
+  if (config->texture_streaming)
+    application_texture_streaming_initialize(application);
   if (!vkr_renderer_metrics_prepare_pass_table(
           &application->renderer_metrics, &application->renderer,
           &application->metrics_allocator)) {
@@ -553,412 +673,78 @@ bool8_t application_create(Application *application,
   return true_v;
 }
 
-vkr_internal VkrMaterial *application_get_material(RendererFrontend *rf,
-                                                   VkrMaterialHandle handle) {
-  return vkr_material_system_get_live(&rf->material_system, handle);
-}
-
-vkr_internal VkrDrawAlphaRouting application_material_alpha_routing(
-    RendererFrontend *rf, VkrMaterial *material) {
-  return vkr_draw_alpha_routing(
-      vkr_material_system_material_alpha_mode(&rf->material_system, material));
-}
-
-vkr_internal bool8_t application_material_is_transmissive(
-    RendererFrontend *rf, VkrMaterial *material) {
-  return vkr_material_system_material_is_transmissive(&rf->material_system,
-                                                      material);
-}
-
-vkr_internal float32_t application_transparent_depth(Mat4 view, Mat4 model,
-                                                     Vec3 local_center) {
-  Vec3 world_center = mat4_mul_vec3(model, local_center);
-  Vec4 view_pos = mat4_mul_vec4(
-      view, vec4_new(world_center.x, world_center.y, world_center.z, 1.0f));
-  float32_t depth = -view_pos.z;
-  return depth > 0.0f ? depth : 0.0f;
-}
-
-vkr_internal uint64_t application_pack_transparent_sort_key(
-    float32_t distance, uint32_t tie_breaker) {
-  uint32_t distance_bits = 0;
-  MemCopy(&distance_bits, &distance, sizeof(distance_bits));
-  return ((uint64_t)distance_bits << 32) | (uint64_t)tie_breaker;
-}
-
-typedef struct ApplicationWorldSource {
-  VkrMeshHandle mesh;
-  VkrGeometryHandle geometry;
-  VkrMaterialHandle material;
-  Mat4 model;
-  Vec3 center;
-  Vec3 min_extents;
-  Vec3 max_extents;
-  VkrDrawAlphaRouting alpha;
-  uint32_t submesh_index;
-  uint32_t object_id;
-  bool8_t bounds_valid;
-  bool8_t transmissive;
-  bool8_t double_sided;
-} ApplicationWorldSource;
-
-typedef struct ApplicationWorldEmitContext {
-  Mat4 view;
-  const uint8_t *transparent_visible;
-  VkrWorldDrawCandidate *gpu_candidates;
-  VkrWorldDrawCandidate *transmission_gpu_candidates;
-  VkrTransparentDrawCandidate *transparent_candidates;
-  uint32_t source_index;
-  uint32_t gpu_index;
-  uint32_t transmission_index;
-  uint32_t transparent_index;
-} ApplicationWorldEmitContext;
-
-vkr_internal inline void
-application_emit_world_source(ApplicationWorldEmitContext *context,
-                              const ApplicationWorldSource *source) {
-  const Vec3 half_extents =
-      vec3_scale(vec3_sub(source->max_extents, source->min_extents), 0.5f);
-  const VkrWorldDrawCandidate candidate = {
-      .mesh = source->mesh,
-      .geometry = source->geometry,
-      .submesh_index = source->submesh_index,
-      .material = source->material,
-      .instance = {.model = source->model, .object_id = source->object_id},
-      .local_bounding_sphere = {source->center.x, source->center.y,
-                                source->center.z, vec3_length(half_extents)},
-      .state_bucket = vkr_world_draw_state_bucket(
-          source->alpha.shadow_alpha_tested ? VKR_MATERIAL_ALPHA_CUTOUT
-                                            : VKR_MATERIAL_ALPHA_OPAQUE,
-          source->double_sided),
-      .flags =
-          (source->bounds_valid ? VKR_WORLD_DRAW_CANDIDATE_BOUNDS_VALID : 0u) |
-          (!source->transmissive && !source->alpha.world_transparent
-               ? VKR_WORLD_DRAW_CANDIDATE_CAMERA_OPAQUE
-               : 0u) |
-          VKR_WORLD_DRAW_CANDIDATE_SHADOW_CASTER,
+/** Builds this frame's world payload; see vkr_world_payload_build(). */
+vkr_internal bool8_t application_build_world_payload(
+    Application *application, VkrAllocator *scratch, bool8_t picking,
+    VkrWorldPassPayload *out_payload, VkrVisibilityStats *out_stats) {
+  const VkrWorldPayloadBuildDesc desc = {
+      .rf = &application->renderer,
+      .dispatch = &application->world_payload_for,
+      .scratch = scratch,
+      .occlusion_triangle_budget = application->occlusion_triangle_budget,
+      .picking = picking,
+      .opaque_set_version = &application->opaque_set_version,
   };
-  context->gpu_candidates[context->gpu_index++] = candidate;
-  if (source->transmissive)
-    context->transmission_gpu_candidates[context->transmission_index++] =
-        candidate;
-  if (!source->transmissive && source->alpha.world_transparent &&
-      context->transparent_visible[context->source_index]) {
-    const float32_t depth = application_transparent_depth(
-        context->view, source->model, source->center);
-    context->transparent_candidates[context->transparent_index++] =
-        (VkrTransparentDrawCandidate){
-            .model = source->model,
-            .mesh = source->mesh,
-            .geometry = source->geometry,
-            .material = source->material,
-            .submesh_index = source->submesh_index,
-            .object_id = source->object_id,
-            .sort_key = application_pack_transparent_sort_key(
-                depth, context->source_index + 1u),
-        };
-  }
-  context->source_index++;
+  return vkr_world_payload_build(&desc, out_payload, out_stats);
 }
 
 /**
- * @brief Builds the sole GPU-driven world source and retained blend list.
+ * @brief Requests texture detail for one candidate stream's instance runs.
  *
- * Opaque, cutout, transmission, and shadow visibility remain unculled packet
- * candidates; the selected backend owns their multi-view classification.
- * Ordinary alpha blend is the only camera-culled and depth-sorted CPU list.
+ * Rows of a run share a material, so each run requests its textures once with
+ * the largest on-screen area among its rows inside the camera frustum. Rows
+ * without valid bounds count as covering the viewport. UV area is not tracked
+ * per submesh, so every surface is taken to be mapped once.
  */
-vkr_internal bool8_t application_build_world_payload(
-    Application *application, VkrAllocator *scratch,
-    VkrWorldPassPayload *out_payload, VkrVisibilityStats *out_stats) {
+vkr_internal void application_request_texture_detail(
+    Application *application, const VkrFrustum *frustum,
+    const VkrWorldDrawCandidate *candidates, const VkrWorldInstanceRun *runs,
+    uint32_t run_count) {
   RendererFrontend *rf = &application->renderer;
-  const Mat4 view = rf->globals.view;
-  const VkrFrustum camera_frustum =
-      vkr_frustum_from_view_projection(view, rf->globals.projection);
-  const uint32_t mesh_count = vkr_mesh_manager_count(&rf->mesh_manager);
-  const uint32_t live_instance_count =
-      vkr_mesh_manager_instance_count(&rf->mesh_manager);
-  VkrVisibilityStats stats = {0};
-  uint64_t candidate_count_64 = 0u;
-
-  for (uint32_t i = 0; i < mesh_count; ++i) {
-    uint32_t mesh_slot = 0;
-    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
-                                                            i, &mesh_slot);
-    if (mesh->visible && mesh->loading_state == VKR_MESH_LOADING_STATE_LOADED)
-      candidate_count_64 += vkr_mesh_manager_submesh_count(mesh);
-  }
-  for (uint32_t i = 0; i < live_instance_count; ++i) {
-    uint32_t instance_slot = 0;
-    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
-        &rf->mesh_manager, i, &instance_slot);
-    if (!instance->visible ||
-        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
-      continue;
-    VkrMeshAsset *asset =
-        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
-    candidate_count_64 += asset->submeshes.length;
-  }
-
-  if (candidate_count_64 > VKR_GPU_DRAW_CANDIDATE_CAPACITY) {
-    *out_payload = (VkrWorldPassPayload){
-        .gpu_candidate_count = VKR_GPU_DRAW_CANDIDATE_CAPACITY + 1u,
-    };
-    stats.objects_tested = VKR_GPU_DRAW_CANDIDATE_CAPACITY + 1u;
-    if (out_stats)
-      *out_stats = stats;
-    return true_v;
-  }
-
-  const uint32_t gpu_candidate_count = (uint32_t)candidate_count_64;
-  uint8_t *transparent_visible = NULL;
-  if (gpu_candidate_count > 0u) {
-    transparent_visible = vkr_allocator_alloc(scratch, gpu_candidate_count,
-                                              VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-    if (!transparent_visible) {
-      *out_payload = (VkrWorldPassPayload){0};
-      return false_v;
-    }
-    MemZero(transparent_visible, gpu_candidate_count);
-  }
-
-  uint32_t gpu_camera_opaque_candidate_count = 0u;
-  uint32_t transmission_gpu_candidate_count = 0u;
-  uint32_t transparent_draw_count = 0u;
-  uint32_t source_index = 0u;
-
-  for (uint32_t i = 0; i < mesh_count; ++i) {
-    uint32_t mesh_slot = 0;
-    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
-                                                            i, &mesh_slot);
-    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
-      continue;
-    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
-    for (uint32_t s = 0; s < submesh_count; ++s) {
-      VkrSubMesh *submesh =
-          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
-      VkrMaterial *material = application_get_material(rf, submesh->material);
-      const VkrDrawAlphaRouting alpha =
-          application_material_alpha_routing(rf, material);
-      const bool8_t transmissive =
-          application_material_is_transmissive(rf, material);
-      stats.objects_tested++;
-      stats.objects_without_bounds += mesh->bounds_valid ? 0u : 1u;
-      gpu_camera_opaque_candidate_count +=
-          !transmissive && !alpha.world_transparent ? 1u : 0u;
-      transmission_gpu_candidate_count += transmissive ? 1u : 0u;
-      if (!transmissive && alpha.world_transparent) {
-        bool8_t visible = true_v;
-        if (mesh->bounds_valid) {
-          Vec3 center = {0};
-          float32_t radius = 0.0f;
-          vkr_visibility_submesh_sphere(mesh->model, submesh->center,
-                                        submesh->min_extents,
-                                        submesh->max_extents, &center, &radius);
-          visible = vkr_frustum_test_sphere(&camera_frustum, center, radius);
-        }
-        transparent_visible[source_index] = visible;
-        transparent_draw_count += visible ? 1u : 0u;
-        stats.objects_culled_camera += visible ? 0u : 1u;
-      }
-      source_index++;
-    }
-  }
-
-  for (uint32_t i = 0; i < live_instance_count; ++i) {
-    uint32_t instance_slot = 0;
-    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
-        &rf->mesh_manager, i, &instance_slot);
-    if (!instance->visible ||
-        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
-      continue;
-    VkrMeshAsset *asset =
-        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
-    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
-    for (uint32_t s = 0; s < submesh_count; ++s) {
-      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
-      VkrMaterial *material = application_get_material(rf, submesh->material);
-      const VkrDrawAlphaRouting alpha =
-          application_material_alpha_routing(rf, material);
-      const bool8_t transmissive =
-          application_material_is_transmissive(rf, material);
-      stats.objects_tested++;
-      stats.objects_without_bounds += instance->bounds_valid ? 0u : 1u;
-      gpu_camera_opaque_candidate_count +=
-          !transmissive && !alpha.world_transparent ? 1u : 0u;
-      transmission_gpu_candidate_count += transmissive ? 1u : 0u;
-      if (!transmissive && alpha.world_transparent) {
-        bool8_t visible = true_v;
-        if (instance->bounds_valid) {
-          Vec3 center = {0};
-          float32_t radius = 0.0f;
-          vkr_visibility_submesh_sphere(instance->model, submesh->center,
-                                        submesh->min_extents,
-                                        submesh->max_extents, &center, &radius);
-          visible = vkr_frustum_test_sphere(&camera_frustum, center, radius);
-        }
-        transparent_visible[source_index] = visible;
-        transparent_draw_count += visible ? 1u : 0u;
-        stats.objects_culled_camera += visible ? 0u : 1u;
+  const float32_t viewport_area = (float32_t)rf->last_window_width *
+                                  (float32_t)rf->last_window_height;
+  for (uint32_t r = 0; r < run_count; ++r) {
+    const VkrWorldDrawCandidate *rows = candidates + runs[r].first_candidate;
+    float32_t screen_area = 0.0f;
+    for (uint32_t i = 0; i < runs[r].instance_count; ++i) {
+      if (!(rows[i].flags & VKR_WORLD_DRAW_CANDIDATE_BOUNDS_VALID)) {
+        screen_area = viewport_area;
+        break;
       }
-      source_index++;
+      const Vec4 local = rows[i].local_bounding_sphere;
+      Vec3 center = vec3_zero();
+      float32_t radius = 0.0f;
+      // A segment of length 2r about the center has the sphere's radius.
+      vkr_visibility_submesh_sphere(
+          rows[i].instance.model, vec3_new(local.x, local.y, local.z),
+          vec3_new(-local.w, 0.0f, 0.0f), vec3_new(local.w, 0.0f, 0.0f),
+          &center, &radius);
+      if (!vkr_frustum_test_sphere(frustum, center, radius))
+        continue;
+      screen_area = vkr_max_f32(
+          screen_area,
+          vkr_visibility_sphere_screen_area(
+              center, radius, rf->globals.view_position,
+              rf->globals.projection.m11, rf->last_window_width,
+              rf->last_window_height));
     }
-  }
-
-  VkrWorldDrawCandidate *gpu_candidates = NULL;
-  VkrWorldDrawCandidate *transmission_gpu_candidates = NULL;
-  VkrTransparentDrawCandidate *transparent_candidates = NULL;
-  VkrDrawItem *transparent_draws = NULL;
-  VkrInstanceDataGPU *transparent_instances = NULL;
-  if (gpu_candidate_count > 0u)
-    gpu_candidates = vkr_allocator_alloc(
-        scratch, sizeof(*gpu_candidates) * (uint64_t)gpu_candidate_count,
-        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-  if (transmission_gpu_candidate_count > 0u)
-    transmission_gpu_candidates =
-        vkr_allocator_alloc(scratch,
-                            sizeof(*transmission_gpu_candidates) *
-                                (uint64_t)transmission_gpu_candidate_count,
-                            VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-  if (transparent_draw_count > 0u) {
-    transparent_candidates = vkr_allocator_alloc(
-        scratch,
-        sizeof(*transparent_candidates) * (uint64_t)transparent_draw_count,
-        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-    transparent_draws = vkr_allocator_alloc(
-        scratch, sizeof(*transparent_draws) * (uint64_t)transparent_draw_count,
-        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-    transparent_instances = vkr_allocator_alloc(
-        scratch,
-        sizeof(*transparent_instances) * (uint64_t)transparent_draw_count,
-        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
-  }
-  if ((gpu_candidate_count > 0u && !gpu_candidates) ||
-      (transmission_gpu_candidate_count > 0u && !transmission_gpu_candidates) ||
-      (transparent_draw_count > 0u &&
-       (!transparent_candidates || !transparent_draws ||
-        !transparent_instances))) {
-    *out_payload = (VkrWorldPassPayload){0};
-    return false_v;
-  }
-
-  ApplicationWorldEmitContext emit = {
-      .view = view,
-      .transparent_visible = transparent_visible,
-      .gpu_candidates = gpu_candidates,
-      .transmission_gpu_candidates = transmission_gpu_candidates,
-      .transparent_candidates = transparent_candidates,
-  };
-
-  for (uint32_t i = 0; i < mesh_count; ++i) {
-    uint32_t mesh_slot = 0;
-    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
-                                                            i, &mesh_slot);
-    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+    if (screen_area <= 0.0f)
       continue;
-    const uint32_t object_id =
-        mesh->render_id
-            ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE, mesh->render_id)
-            : 0u;
-    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
-    for (uint32_t s = 0; s < submesh_count; ++s) {
-      VkrSubMesh *submesh =
-          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
-      VkrMaterial *material = application_get_material(rf, submesh->material);
-      const VkrMaterialHandle draw_material =
-          material ? (VkrMaterialHandle){.id = material->id,
-                                         .generation = material->generation}
-                   : submesh->material;
-      const VkrDrawAlphaRouting alpha =
-          application_material_alpha_routing(rf, material);
-      const bool8_t transmissive =
-          application_material_is_transmissive(rf, material);
-      const ApplicationWorldSource source = {
-          .mesh = {.id = mesh_slot + 1u, .generation = 0u},
-          .geometry = submesh->geometry,
-          .material = draw_material,
-          .model = mesh->model,
-          .center = submesh->center,
-          .min_extents = submesh->min_extents,
-          .max_extents = submesh->max_extents,
-          .alpha = alpha,
-          .submesh_index = s,
-          .object_id = object_id,
-          .bounds_valid = mesh->bounds_valid,
-          .transmissive = transmissive,
-          .double_sided = material ? material->double_sided : false_v,
-      };
-      application_emit_world_source(&emit, &source);
-    }
-  }
 
-  for (uint32_t i = 0; i < live_instance_count; ++i) {
-    uint32_t instance_slot = 0;
-    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
-        &rf->mesh_manager, i, &instance_slot);
-    if (!instance->visible ||
-        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+    const VkrMaterial *material =
+        vkr_world_payload_material(rf, rows[0].material);
+    if (!material)
       continue;
-    VkrMeshAsset *asset =
-        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
-    const uint32_t object_id =
-        instance->render_id ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE,
-                                                    instance->render_id)
-                            : 0u;
-    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
-    for (uint32_t s = 0; s < submesh_count; ++s) {
-      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
-      VkrMaterial *material = application_get_material(rf, submesh->material);
-      const VkrMaterialHandle draw_material =
-          material ? (VkrMaterialHandle){.id = material->id,
-                                         .generation = material->generation}
-                   : submesh->material;
-      const VkrDrawAlphaRouting alpha =
-          application_material_alpha_routing(rf, material);
-      const bool8_t transmissive =
-          application_material_is_transmissive(rf, material);
-      const ApplicationWorldSource source = {
-          .mesh = {.id = instance_slot + 1u,
-                   .generation = instance->generation},
-          .geometry = submesh->geometry,
-          .material = draw_material,
-          .model = instance->model,
-          .center = submesh->center,
-          .min_extents = submesh->min_extents,
-          .max_extents = submesh->max_extents,
-          .alpha = alpha,
-          .submesh_index = s,
-          .object_id = object_id,
-          .bounds_valid = instance->bounds_valid,
-          .transmissive = transmissive,
-          .double_sided = material ? material->double_sided : false_v,
-      };
-      application_emit_world_source(&emit, &source);
+    for (uint32_t t = 0; t < VKR_TEXTURE_SLOT_COUNT; ++t) {
+      const VkrMaterialTexture *texture = &material->textures[t];
+      if (texture->enabled && texture->handle.id != 0)
+        vkr_texture_streaming_request_uv_density(
+            &application->texture_streaming, texture->handle, 1.0f,
+            screen_area);
     }
   }
-
-  if (transparent_draw_count > 1u)
-    qsort(transparent_candidates, transparent_draw_count,
-          sizeof(*transparent_candidates), vkr_transparent_draw_depth_compare);
-  vkr_transparent_draw_emit(transparent_candidates, transparent_draw_count,
-                            transparent_draws, transparent_instances);
-
-  *out_payload = (VkrWorldPassPayload){
-      .gpu_candidates = gpu_candidates,
-      .gpu_candidate_count = gpu_candidate_count,
-      .gpu_camera_opaque_candidate_count = gpu_camera_opaque_candidate_count,
-      .gpu_shadow_candidate_count = gpu_candidate_count,
-      .transmission_gpu_candidates = transmission_gpu_candidates,
-      .transmission_gpu_candidate_count = transmission_gpu_candidate_count,
-      .transparent_draws = transparent_draws,
-      .transparent_draw_count = transparent_draw_count,
-      .instances = transparent_instances,
-      .instance_count = transparent_draw_count,
-  };
-  if (out_stats)
-    *out_stats = stats;
-  return true_v;
 }
+
 /**
  * @brief Draws a frame using the renderer.
  * This function is called once per frame from within the main application
@@ -1009,16 +795,49 @@ void application_draw_frame(Application *application, float64_t delta) {
         shadow_frame.enabled ? shadow_frame.cascade_count : 0u;
   }
 
+  bool8_t has_picking =
+      application->renderer.picking.state == VKR_PICKING_STATE_RENDER_PENDING;
+  /* An identifier capture has no producer unless the picking pass runs this
+     frame, so the request itself schedules it. The catalog names the dependency
+     as a subsystem; matching on the channel name instead would silently stop
+     working the moment a channel is renamed. */
+  if (!has_picking && application->capture_request) {
+    for (uint32_t i = 0; i < application->capture_request->item_count; ++i) {
+      const VkrCaptureChannelDescription *channel =
+          vkr_renderer_capture_channel_get(
+              application->capture_request->items[i].channel);
+      if (channel &&
+          channel->required_subsystem == VKR_RENDERER_SUBSYSTEM_PICKING) {
+        has_picking = true_v;
+        break;
+      }
+    }
+  }
+
   VkrWorldPassPayload world_payload = {0};
   VkrVisibilityStats visibility_stats = {0};
   bool8_t has_world = false_v;
   VKR_METRICS_SCOPE_NS(application->metrics,
                        application->metric_ids.world_payload_build) {
     has_world = application_build_world_payload(
-        application, scratch, &world_payload, &visibility_stats);
+        application, scratch, has_picking, &world_payload, &visibility_stats);
   }
   application->visibility_stats = visibility_stats;
 
+  if (has_world && application->texture_streaming_enabled) {
+    const VkrFrustum frustum = vkr_frustum_from_view_projection(
+        application->renderer.globals.view,
+        application->renderer.globals.projection);
+    application_request_texture_detail(
+        application, &frustum, world_payload.gpu_candidates,
+        world_payload.gpu_instance_runs, world_payload.gpu_instance_run_count);
+    application_request_texture_detail(
+        application, &frustum, world_payload.transmission_gpu_candidates,
+        world_payload.transmission_instance_runs,
+        world_payload.transmission_instance_run_count);
+    vkr_texture_streaming_update(&application->texture_streaming, NULL);
+  }
+
   VkrShadowPassPayload shadow_payload = {0};
   /* Raster depth bias, distinct from receiver bias. Lowered from the shadow
      config so both selected implementations apply the same configured values
@@ -1045,24 +864,6 @@ void application_draw_frame(Application *application, float64_t delta) {
   }
 
   VkrPickingPassPayload picking_payload = {0};
-  bool8_t has_picking =
-      application->renderer.picking.state == VKR_PICKING_STATE_RENDER_PENDING;
-  /* An identifier capture has no producer unless the picking pass runs this
-     frame, so the request itself schedules it. The catalog names the dependency
-     as a subsystem; matching on the channel name instead would silently stop
-     working the moment a channel is renamed. */
-  if (!has_picking && application->capture_request) {
-    for (uint32_t i = 0; i < application->capture_request->item_count; ++i) {
-      const VkrCaptureChannelDescription *channel =
-          vkr_renderer_capture_channel_get(
-              application->capture_request->items[i].channel);
-      if (channel &&
-          channel->required_subsystem == VKR_RENDERER_SUBSYSTEM_PICKING) {
-        has_picking = true_v;
-        break;
-      }
-    }
-  }
   if (has_picking) {
     picking_payload.pending = true_v;
     picking_payload.x = application->renderer.picking.requested_x;
@@ -1369,6 +1170,7 @@ void application_start(Application *application) {
         1.0 / (float64_t)application->config->target_frame_rate;
   }
 
+  VKR_TRACE_THREAD_NAME("main");
   bool8_t running = true_v;
   while (
       running &&
@@ -1398,6 +1200,9 @@ void application_start(Application *application) {
       running = vkr_window_update(&application->window);
       vkr_gamepad_poll_all(&application->gamepad);
     }
+    if (application->event_manager.mode == EVENT_DISPATCH_MODE_MANUAL) {
+      event_manager_pump(&application->event_manager);
+    }
 
     if (!running ||
         bitset8_is_set(&application->app_flags, APPLICATION_FLAG_SUSPENDED)) {
@@ -1411,6 +1216,7 @@ void application_start(Application *application) {
     vkr_metrics_begin_frame(
         application->metrics, application->renderer.frame_number + 1u,
         vkr_renderer_get_submit_serial(&application->renderer));
+    VKR_TRACE_FRAME(application->renderer.frame_number + 1u);
 
     VkrAllocatorScope frame_scope = {0};
     VkrAllocator *frame_alloc = &application->renderer.scratch_allocator;
@@ -1420,7 +1226,8 @@ void application_start(Application *application) {
     application->ui_text_update_count = 0;
     application->world_text_update_count = 0;
 
-    VKR_METRICS_SCOPE_NS(application->metrics, application->metric_ids.update) {
+    VKR_METRICS_SCOPE_NS(application->metrics, application->metric_ids.update)
+    VKR_TRACE_SCOPE("frame.update") {
       application_update(application, delta);
     }
 
@@ -1462,16 +1269,6 @@ void application_start(Application *application) {
           application->renderer.active_scene);
     }
 
-    if (camera) {
-      VKR_METRICS_SCOPE_NS(application->metrics,
-                           application->metric_ids.shadow_update) {
-        vkr_shadow_system_update(
-            &application->renderer.shadow_system, camera,
-            application->renderer.lighting_system.directional.enabled,
-            application->renderer.lighting_system.directional.direction);
-      }
-    }
-
     if (camera) {
       // update_all() refreshed these cached matrices above.
       application->renderer.globals.view = camera->view;
@@ -1501,6 +1298,18 @@ void application_start(Application *application) {
                                     mesh_index);
     }
 
+    // Runs after every world-bounds update for the frame, so the caster lists
+    // it records match the bounds the world payload is built from.
+    if (camera) {
+      VKR_METRICS_SCOPE_NS(application->metrics,
+                           application->metric_ids.shadow_update) {
+        vkr_shadow_system_update(
+            &application->renderer.shadow_system, camera,
+            application->renderer.lighting_system.directional.enabled,
+            application->renderer.lighting_system.directional.direction);
+      }
+    }
+
     if (!bitset8_is_set(&application->app_flags, APPLICATION_FLAG_RUNNING) ||
         !bitset8_is_set(&application->app_flags,
                         APPLICATION_FLAG_INITIALIZED)) {
@@ -1513,11 +1322,16 @@ void application_start(Application *application) {
       break;
     }
 
-    application_draw_frame(application, delta);
+    VKR_TRACE_SCOPE("frame.draw") {
+      application_draw_frame(application, delta);
+    }
 
     VKR_METRICS_ADD_ELAPSED_NS(application->metrics,
                                application->metric_ids.frame_work,
                                current_absolute_time);
+    VKR_METRICS_HISTOGRAM_ADD_ELAPSED_NS(
+        application->metrics, application->metric_ids.frame_work_histogram,
+        current_absolute_time);
 
     if (vkr_allocator_scope_is_valid(&frame_scope)) {
       vkr_allocator_end_scope(&frame_scope, VKR_ALLOCATOR_MEMORY_TAG_STRING);
@@ -1547,6 +1361,9 @@ void application_start(Application *application) {
     VKR_METRICS_ADD_ELAPSED_NS(application->metrics,
                                application->metric_ids.frame_wall,
                                current_absolute_time);
+    VKR_METRICS_HISTOGRAM_ADD_ELAPSED_NS(
+        application->metrics, application->metric_ids.frame_wall_histogram,
+        current_absolute_time);
     vkr_metrics_end_frame(application->metrics);
 
     application->last_frame_time = current_total_time;
@@ -1646,6 +1463,11 @@ void application_shutdown(Application *application) {
   vkr_job_system_shutdown(&application->job_system);
 
   vkr_renderer_destroy(&application->renderer);
+  if (application->texture_streaming_enabled) {
+    vkr_texture_streaming_shutdown(&application->texture_streaming);
+    vkr_dmemory_allocator_destroy(&application->texture_streaming_allocator);
+    application->texture_streaming_enabled = false_v;
+  }
   if (application_is_windowed(application)) {
     vkr_window_destroy(&application->window);
   }
@@ -1659,6 +1481,8 @@ void application_shutdown(Application *application) {
   application->metrics_arena = NULL;
   application->metrics = NULL;
 
+  // Worker threads are joined above, so nothing else is logging.
+  log_async_stop();
   vkr_platform_shutdown();
 
   arena_destroy(application->log_arena);
@@ -1,214 +1,482 @@
 #include "event.h"
 #include "memory/vkr_arena_allocator.h"
 
+#define EVENT_CONSUMER_ARENA_SIZE KB(64)
+// Share of the consumer scratch a batch may spend on out-of-line payload
+// copies; the rest is left for the callback snapshots.
+#define EVENT_CONSUMER_PAYLOAD_BUDGET (EVENT_CONSUMER_ARENA_SIZE / 2)
+
+/**
+ * @brief Callbacks of one event type, copied out of the registry for a batch.
+ */
+typedef struct EventCallbackSnapshot {
+  EventType type;
+  uint32_t count;
+  EventCallbackData *callbacks;
+} EventCallbackSnapshot;
+
 static bool8_t event_callback_equals(EventCallbackData *current_value,
                                      EventCallbackData *value) {
   return current_value->callback == value->callback &&
          current_value->user_data == value->user_data;
 }
 
+vkr_internal uint32_t event_ring_capacity_for(uint32_t requested) {
+  uint32_t capacity = 2;
+  while (capacity < requested && capacity < (1u << 30)) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+vkr_internal bool8_t event_ring_create(VkrAllocator *allocator,
+                                       uint32_t requested_capacity,
+                                       EventRing *out_ring) {
+  MemZero(out_ring, sizeof(*out_ring));
+  const uint32_t capacity = event_ring_capacity_for(requested_capacity);
+  out_ring->slots = vkr_allocator_alloc_aligned(
+      allocator, sizeof(EventSlot) * (uint64_t)capacity, EVENT_CACHE_LINE_SIZE,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!out_ring->slots) {
+    return false_v;
+  }
+
+  out_ring->capacity = capacity;
+  out_ring->mask = capacity - 1u;
+  for (uint32_t i = 0; i < capacity; ++i) {
+    vkr_atomic_uint64_store(&out_ring->slots[i].sequence, i,
+                            VKR_MEMORY_ORDER_RELAXED);
+  }
+  vkr_atomic_uint64_store(&out_ring->enqueue_position, 0,
+                          VKR_MEMORY_ORDER_RELAXED);
+  return true_v;
+}
+
 /**
- * @brief The main function for the dedicated event processing thread.
- * Waits for events on the queue using a condition variable. When woken up,
- * it checks if the manager is still running and if events are available.
- * If an event is dequeued, it retrieves the list of subscribed callbacks
- * for that event type (copying them to a temporary buffer to minimize lock
- * duration), releases the lock, and invokes the callbacks.
- * Uses a thread-local arena with scratch allocations for the temporary callback
- * buffer.
- * Continues processing until the `manager->running` flag is set to false and
- * all remaining events in the queue have been drained (graceful shutdown).
- * Cleans up the thread-local arena before exiting.
- * @param arg Pointer to the EventManager instance.
- * @return void* Always returns NULL.
+ * @brief Claims the next free slot (Vyukov bounded queue, producer side).
+ * @return The claimed slot, or NULL when the ring is full. The caller fills it
+ * and publishes with `event_ring_publish`.
  */
-static void *events_processor(void *arg) {
-  EventManager *manager = (EventManager *)arg;
-  Arena *local_thread_arena = arena_create(KB(64), KB(64));
-  VkrAllocator thread_allocator = manager->allocator;
-  thread_allocator.ctx = local_thread_arena;
-  bool32_t should_run = true;
+vkr_internal EventSlot *event_ring_claim(EventRing *ring,
+                                         uint64_t *out_position) {
+  uint64_t position = vkr_atomic_uint64_load(&ring->enqueue_position,
+                                             VKR_MEMORY_ORDER_RELAXED);
+  for (;;) {
+    EventSlot *slot = &ring->slots[position & ring->mask];
+    const uint64_t sequence =
+        vkr_atomic_uint64_load(&slot->sequence, VKR_MEMORY_ORDER_ACQUIRE);
+    const int64_t difference = (int64_t)(sequence - position);
+    if (difference == 0) {
+      if (vkr_atomic_uint64_compare_exchange(
+              &ring->enqueue_position, &position, position + 1u,
+              VKR_MEMORY_ORDER_RELAXED, VKR_MEMORY_ORDER_RELAXED)) {
+        *out_position = position;
+        return slot;
+      }
+      // A failed CAS reloaded `position`.
+    } else if (difference < 0) {
+      // The slot still holds an event from the previous lap.
+      return NULL;
+    } else {
+      position = vkr_atomic_uint64_load(&ring->enqueue_position,
+                                        VKR_MEMORY_ORDER_RELAXED);
+    }
+  }
+}
 
-  while (should_run) {
-    Event event;
-    Event local_event;
-    bool32_t event_dequeued = false;
-    bool8_t payload_pending_free = false_v;
+vkr_internal INLINE void event_ring_publish(EventSlot *slot,
+                                            uint64_t position) {
+  vkr_atomic_uint64_store(&slot->sequence, position + 1u,
+                          VKR_MEMORY_ORDER_RELEASE);
+}
 
-    vkr_mutex_lock(manager->mutex);
+/**
+ * @brief Returns the oldest published slot, or NULL when the ring is empty.
+ * Consumer only; release it with `event_ring_release`.
+ */
+vkr_internal INLINE EventSlot *event_ring_peek(EventRing *ring,
+                                               VkrMemoryOrder order) {
+  EventSlot *slot = &ring->slots[ring->dequeue_position & ring->mask];
+  const uint64_t sequence = vkr_atomic_uint64_load(&slot->sequence, order);
+  return sequence == ring->dequeue_position + 1u ? slot : NULL;
+}
 
-    while (queue_is_empty_Event(&manager->queue) && manager->running) {
-      vkr_cond_wait(manager->cond, manager->mutex);
-    }
+vkr_internal INLINE void event_ring_release(EventRing *ring, EventSlot *slot) {
+  vkr_atomic_uint64_store(&slot->sequence,
+                          ring->dequeue_position + ring->capacity,
+                          VKR_MEMORY_ORDER_RELEASE);
+  ring->dequeue_position++;
+}
+
+vkr_internal void event_manager_free_payloads(EventManager *manager,
+                                              const uint64_t *sizes,
+                                              uint32_t count) {
+  if (count == 0) {
+    return;
+  }
 
-    should_run = manager->running || !queue_is_empty_Event(&manager->queue);
+  vkr_mutex_lock(manager->payload_mutex);
+  for (uint32_t i = 0; i < count; ++i) {
+    if (!vkr_event_data_buffer_free(&manager->event_data_buf, sizes[i])) {
+      log_error("Events_processor: Failed to free %llu bytes from event data "
+                "buffer.",
+                sizes[i]);
+    }
+  }
+  vkr_mutex_unlock(manager->payload_mutex);
+}
 
-    if (!queue_is_empty_Event(&manager->queue)) {
-      event_dequeued = queue_dequeue_Event(&manager->queue, &event);
-      if (event_dequeued && event.data_size > 0 && event.data != NULL) {
-        payload_pending_free = true_v;
+/**
+ * @brief Dequeues up to EVENT_DISPATCH_BATCH_SIZE slots, keeping the valid
+ * events in `out_events`.
+ * Payloads are copied out of the ring so callbacks may keep writing to them
+ * after the slot is recycled: inline payloads into the caller's `inline_copies`
+ * rows, larger ones into consumer scratch. The batch ends early once the next
+ * out-of-line payload would push the copies past
+ * EVENT_CONSUMER_PAYLOAD_BUDGET; that event stays queued for the next batch
+ * (a single oversized payload is still taken when it is first in line).
+ * Out-of-line payload blocks are returned to the data buffer under one lock
+ * for the whole batch.
+ * @return Number of slots consumed, which may exceed `*out_count`.
+ */
+vkr_internal uint32_t event_manager_dequeue_batch(
+    EventManager *manager,
+    uint8_t (*inline_copies)[EVENT_INLINE_PAYLOAD_SIZE], Event *out_events,
+    uint32_t *out_count) {
+  EventRing *ring = &manager->queue;
+  uint64_t external_sizes[EVENT_DISPATCH_BATCH_SIZE];
+  uint32_t external_count = 0;
+  uint64_t external_bytes = 0;
+  uint32_t consumed = 0;
+  uint32_t count = 0;
+
+  EventSlot *slot = NULL;
+  while (consumed < EVENT_DISPATCH_BATCH_SIZE &&
+         (slot = event_ring_peek(ring, VKR_MEMORY_ORDER_ACQUIRE)) != NULL) {
+    const uint64_t data_size = slot->data_size;
+    const bool8_t external = data_size > EVENT_INLINE_PAYLOAD_SIZE;
+    if (external) {
+      const uint64_t copy_size = AlignPow2(data_size, MaxAlign());
+      if (consumed > 0 &&
+          external_bytes + copy_size > EVENT_CONSUMER_PAYLOAD_BUDGET) {
+        break;
       }
+      external_bytes += copy_size;
+    }
+    const void *source =
+        external ? slot->payload.external : slot->payload.bytes;
+
+    Event event = {.type = slot->type, .data = NULL, .data_size = data_size};
+    if (data_size > 0) {
+      event.data = external ? vkr_allocator_alloc(
+                                  &manager->consumer_allocator, data_size,
+                                  VKR_ALLOCATOR_MEMORY_TAG_STRUCT)
+                            : inline_copies[count];
+      if (event.data) {
+        MemCopy(event.data, source, data_size);
+      } else {
+        log_error("Events_processor: Failed to allocate %llu bytes for event "
+                  "type %d payload copy.",
+                  data_size, event.type);
+      }
+    }
+    if (external) {
+      external_sizes[external_count++] = data_size;
     }
+    event_ring_release(ring, slot);
+    consumed++;
 
-    if (!event_dequeued) {
-      vkr_mutex_unlock(manager->mutex);
+    if (data_size > 0 && !event.data) {
       continue;
     }
-
     if (event.type >= EVENT_TYPE_MAX) {
       log_warn("Processed event with invalid type: %u", event.type);
-      if (payload_pending_free) {
-        if (!vkr_event_data_buffer_free(&manager->event_data_buf,
-                                        event.data_size)) {
-          log_error("Events_processor: Failed to free data for event type %d, "
-                    "size %llu from event data buffer.",
-                    event.type, event.data_size);
-        }
-      }
-      vkr_mutex_unlock(manager->mutex);
       continue;
     }
+    out_events[count++] = event;
+  }
 
-    Vector_EventCallbackData *callbacks_vec = &manager->callbacks[event.type];
-    uint16_t subs_count = callbacks_vec->length;
-
-    if (subs_count == 0) {
-      if (payload_pending_free) {
-        if (!vkr_event_data_buffer_free(&manager->event_data_buf,
-                                        event.data_size)) {
-          log_error("Events_processor: Failed to free data for event type %d, "
-                    "size %llu from event data buffer.",
-                    event.type, event.data_size);
-        }
+  event_manager_free_payloads(manager, external_sizes, external_count);
+  *out_count = count;
+  return consumed;
+}
+
+/**
+ * @brief Copies the callbacks of every event type in `events` into scratch,
+ * one snapshot per distinct type, under a single registry lock.
+ * @return The registry generation the snapshots correspond to.
+ */
+vkr_internal uint32_t event_manager_snapshot_callbacks(
+    EventManager *manager, const Event *events, uint32_t event_count,
+    EventCallbackSnapshot *snapshots, uint32_t *snapshot_count) {
+  *snapshot_count = 0;
+
+  vkr_mutex_lock(manager->mutex);
+  const uint32_t generation = vkr_atomic_uint32_load(
+      &manager->subscription_generation, VKR_MEMORY_ORDER_RELAXED);
+  for (uint32_t i = 0; i < event_count; ++i) {
+    const EventType type = events[i].type;
+    bool8_t seen = false_v;
+    for (uint32_t s = 0; s < *snapshot_count; ++s) {
+      if (snapshots[s].type == type) {
+        seen = true_v;
+        break;
       }
-      vkr_mutex_unlock(manager->mutex);
+    }
+    if (seen) {
       continue;
     }
 
-    VkrAllocatorScope scope = vkr_allocator_begin_scope(&thread_allocator);
-    if (!vkr_allocator_scope_is_valid(&scope)) {
-      if (payload_pending_free) {
-        if (!vkr_event_data_buffer_free(&manager->event_data_buf,
-                                        event.data_size)) {
-          log_error("Events_processor: Failed to free data for event type %d, "
-                    "size %llu from event data buffer.",
-                    event.type, event.data_size);
-        }
-      }
-      vkr_mutex_unlock(manager->mutex);
+    EventCallbackSnapshot *snapshot = &snapshots[(*snapshot_count)++];
+    const Vector_EventCallbackData *vec = &manager->callbacks[type];
+    snapshot->type = type;
+    snapshot->count = 0;
+    snapshot->callbacks = NULL;
+    if (vec->length == 0) {
+      continue;
+    }
+    if (vec->data == NULL) {
+      log_warn("Event_processor: subs_count (%llu) for event type %d, but "
+               "vector data pointer is NULL. Callbacks skipped.",
+               vec->length, type);
       continue;
     }
 
-    local_event = event;
-    if (payload_pending_free) {
-      void *payload_copy = vkr_allocator_alloc(
-          &thread_allocator, event.data_size, VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
-      if (!payload_copy) {
-        log_error("Events_processor: Failed to allocate %llu bytes for event "
-                  "type %d payload copy.",
-                  event.data_size, event.type);
-        if (!vkr_event_data_buffer_free(&manager->event_data_buf,
-                                        event.data_size)) {
-          log_error("Events_processor: Failed to free data for event type %d, "
-                    "size %llu from event data buffer.",
-                    event.type, event.data_size);
-        }
-        vkr_mutex_unlock(manager->mutex);
-        vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
-        continue;
-      }
+    snapshot->callbacks = vkr_allocator_alloc(
+        &manager->consumer_allocator, vec->length * sizeof(EventCallbackData),
+        VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+    if (!snapshot->callbacks) {
+      log_error("Event_processor: Failed to snapshot %llu callbacks for event "
+                "type %d.",
+                vec->length, type);
+      continue;
+    }
+    MemCopy(snapshot->callbacks, vec->data,
+            vec->length * sizeof(EventCallbackData));
+    snapshot->count = (uint32_t)vec->length;
+  }
+  vkr_mutex_unlock(manager->mutex);
+  return generation;
+}
 
-      MemCopy(payload_copy, event.data, event.data_size);
-      local_event.data = payload_copy;
+/**
+ * @brief Dequeues and dispatches one batch.
+ * Events are delivered strictly in ring order; the batch only shares the
+ * callback snapshot. A subscription change made while the batch runs (for
+ * example a callback unsubscribing itself) invalidates the snapshot, so later
+ * events in the batch see the registry as it is then, exactly as if each
+ * event had been dispatched on its own.
+ * @return Number of ring slots consumed.
+ */
+vkr_internal uint32_t event_manager_process_batch(EventManager *manager) {
+  VkrAllocatorScope scope =
+      vkr_allocator_begin_scope(&manager->consumer_allocator);
+  if (!vkr_allocator_scope_is_valid(&scope)) {
+    log_error("Events_processor: Failed to open consumer scratch scope.");
+    return 0;
+  }
+
+  _Alignas(16) uint8_t
+      inline_copies[EVENT_DISPATCH_BATCH_SIZE][EVENT_INLINE_PAYLOAD_SIZE];
+  Event events[EVENT_DISPATCH_BATCH_SIZE];
+  uint32_t count = 0;
+  const uint32_t consumed =
+      event_manager_dequeue_batch(manager, inline_copies, events, &count);
+
+  EventCallbackSnapshot snapshots[EVENT_DISPATCH_BATCH_SIZE];
+  uint32_t snapshot_count = 0;
+  uint32_t generation = 0;
+  if (count > 0) {
+    generation = event_manager_snapshot_callbacks(manager, events, count,
+                                                  snapshots, &snapshot_count);
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    if (vkr_atomic_uint32_load(&manager->subscription_generation,
+                               VKR_MEMORY_ORDER_ACQUIRE) != generation) {
+      generation = event_manager_snapshot_callbacks(
+          manager, &events[i], count - i, snapshots, &snapshot_count);
+    }
 
-      if (!vkr_event_data_buffer_free(&manager->event_data_buf,
-                                      event.data_size)) {
-        log_error("Events_processor: Failed to free data for event type %d, "
-                  "size %llu from event data buffer.",
-                  event.type, event.data_size);
+    const EventCallbackSnapshot *snapshot = NULL;
+    for (uint32_t s = 0; s < snapshot_count; ++s) {
+      if (snapshots[s].type == events[i].type) {
+        snapshot = &snapshots[s];
+        break;
       }
     }
+    if (!snapshot) {
+      continue;
+    }
 
-    EventCallbackData *local_callbacks_copy = vkr_allocator_alloc(
-        &thread_allocator, (uint64_t)subs_count * sizeof(EventCallbackData),
-        VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+    for (uint32_t c = 0; c < snapshot->count; ++c) {
+      if (snapshot->callbacks[c].callback != NULL) {
+        snapshot->callbacks[c].callback(&events[i],
+                                        snapshot->callbacks[c].user_data);
+      }
+    }
+  }
 
-    if (callbacks_vec->data != NULL && local_callbacks_copy != NULL) {
-      MemCopy(local_callbacks_copy, callbacks_vec->data,
-              (size_t)subs_count * sizeof(EventCallbackData));
-      vkr_mutex_unlock(manager->mutex);
+  vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+  return consumed;
+}
 
-      for (uint16_t i = 0; i < subs_count; i++) {
-        if (local_callbacks_copy[i].callback != NULL) {
-          local_callbacks_copy[i].callback(&local_event,
-                                           local_callbacks_copy[i].user_data);
-        }
-      }
+/**
+ * @brief The main function for the dedicated event processing thread.
+ * Drains the ring batch by batch while it has events. When it runs dry the
+ * thread announces that it is going to sleep through `consumer_sleeping`,
+ * re-checks the ring, and only then waits on the condition variable, so a
+ * producer that publishes concurrently either sees the flag and signals or
+ * its event is seen by the re-check.
+ * Continues processing until the `manager->running` flag is set to false and
+ * all remaining events in the ring have been drained (graceful shutdown).
+ * @param arg Pointer to the EventManager instance.
+ * @return void* Always returns NULL.
+ */
+static void *events_processor(void *arg) {
+  EventManager *manager = (EventManager *)arg;
 
-    } else {
-      log_warn("Event_processor: subs_count (%u) for event type %d, but "
-               "vector or array data pointer is NULL. Callbacks skipped.",
-               subs_count, event.type);
-      vkr_mutex_unlock(manager->mutex);
+  for (;;) {
+    if (event_manager_process_batch(manager) > 0) {
+      continue;
+    }
+
+    vkr_mutex_lock(manager->mutex);
+    vkr_atomic_bool_store(&manager->consumer_sleeping, true_v,
+                          VKR_MEMORY_ORDER_SEQ_CST);
+    while (manager->running &&
+           !event_ring_peek(&manager->queue, VKR_MEMORY_ORDER_SEQ_CST)) {
+      vkr_cond_wait(manager->cond, manager->mutex);
     }
+    vkr_atomic_bool_store(&manager->consumer_sleeping, false_v,
+                          VKR_MEMORY_ORDER_RELAXED);
+    const bool32_t should_stop =
+        !manager->running &&
+        !event_ring_peek(&manager->queue, VKR_MEMORY_ORDER_ACQUIRE);
+    vkr_mutex_unlock(manager->mutex);
 
-    vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+    if (should_stop) {
+      break;
+    }
   }
 
-  arena_destroy(local_thread_arena);
   return NULL;
 }
 
+vkr_internal void event_manager_wake_consumer(EventManager *manager) {
+  if (manager->mode != EVENT_DISPATCH_MODE_THREAD) {
+    return;
+  }
+
+  // Pairs with the sleeping store and ring re-check in events_processor.
+  vkr_atomic_thread_fence(VKR_MEMORY_ORDER_SEQ_CST);
+  if (vkr_atomic_bool_load(&manager->consumer_sleeping,
+                           VKR_MEMORY_ORDER_RELAXED)) {
+    vkr_mutex_lock(manager->mutex);
+    vkr_cond_signal(manager->cond);
+    vkr_mutex_unlock(manager->mutex);
+  }
+}
+
+EventManagerConfig event_manager_config_default(void) {
+  return (EventManagerConfig){
+      .mode = EVENT_DISPATCH_MODE_THREAD,
+      .queue_capacity = DEFAULT_EVENT_QUEUE_CAPACITY,
+  };
+}
+
 void event_manager_create(EventManager *manager) {
+  const EventManagerConfig config = event_manager_config_default();
+  if (!event_manager_create_with_config(manager, &config)) {
+    log_fatal("Failed to create event manager.");
+  }
+}
+
+bool8_t event_manager_create_with_config(EventManager *manager,
+                                         const EventManagerConfig *config) {
   assert_log(manager != NULL, "Manager is NULL");
+  assert_log(config != NULL, "Config is NULL");
 
+  MemZero(manager, sizeof(*manager));
+  manager->mode = config->mode;
   manager->arena = arena_create(MB(1), MB(1));
   manager->allocator = (VkrAllocator){.ctx = manager->arena};
   if (!vkr_allocator_arena(&manager->allocator)) {
-    queue_destroy_Event(&manager->queue);
     arena_destroy(manager->arena);
     log_fatal("Failed to initialize event manager allocator.");
-    return;
+    return false_v;
+  }
+
+  manager->consumer_arena =
+      arena_create(EVENT_CONSUMER_ARENA_SIZE, EVENT_CONSUMER_ARENA_SIZE);
+  manager->consumer_allocator = (VkrAllocator){.ctx = manager->consumer_arena};
+  if (!vkr_allocator_arena(&manager->consumer_allocator)) {
+    arena_destroy(manager->consumer_arena);
+    arena_destroy(manager->arena);
+    log_fatal("Failed to initialize event consumer allocator.");
+    return false_v;
+  }
+
+  const uint32_t capacity = config->queue_capacity > 0
+                                ? config->queue_capacity
+                                : DEFAULT_EVENT_QUEUE_CAPACITY;
+  if (!event_ring_create(&manager->allocator, capacity, &manager->queue)) {
+    arena_destroy(manager->consumer_arena);
+    arena_destroy(manager->arena);
+    log_fatal("Failed to create event ring for EventManager.");
+    return false_v;
   }
-  MemZero(manager->callbacks, sizeof(manager->callbacks));
-  manager->queue =
-      queue_create_Event(&manager->allocator, DEFAULT_EVENT_QUEUE_CAPACITY);
 
   if (!vkr_event_data_buffer_create(&manager->allocator,
                                     DEFAULT_EVENT_DATA_RING_BUFFER_CAPACITY,
                                     &manager->event_data_buf)) {
-    queue_destroy_Event(&manager->queue);
+    arena_destroy(manager->consumer_arena);
     arena_destroy(manager->arena);
     log_fatal("Failed to create event data buffer for EventManager.");
-    return;
+    return false_v;
   }
 
   vkr_mutex_create(&manager->allocator, &manager->mutex);
+  vkr_mutex_create(&manager->allocator, &manager->payload_mutex);
   vkr_cond_create(&manager->allocator, &manager->cond);
+  vkr_atomic_uint32_store(&manager->subscription_generation, 0,
+                          VKR_MEMORY_ORDER_RELAXED);
+  vkr_atomic_bool_store(&manager->consumer_sleeping, false_v,
+                        VKR_MEMORY_ORDER_RELAXED);
   manager->running = true;
 
-  vkr_thread_create(&manager->allocator, &manager->thread, events_processor,
-                    manager);
+  if (manager->mode == EVENT_DISPATCH_MODE_THREAD) {
+    vkr_thread_create(&manager->allocator, &manager->thread, events_processor,
+                      manager);
+  }
+  return true_v;
 }
 
 void event_manager_destroy(EventManager *manager) {
   assert_log(manager != NULL, "Manager is NULL");
   vkr_mutex_lock(manager->mutex);
   manager->running = false;
-  vkr_mutex_unlock(manager->mutex);
   vkr_cond_signal(manager->cond);
+  vkr_mutex_unlock(manager->mutex);
+
+  if (manager->mode == EVENT_DISPATCH_MODE_THREAD) {
+    vkr_thread_join(manager->thread);
+    vkr_thread_destroy(&manager->allocator, &manager->thread);
+  } else {
+    while (event_manager_process_batch(manager) > 0) {
+    }
+  }
 
-  vkr_thread_join(manager->thread);
-  vkr_thread_destroy(&manager->allocator, &manager->thread);
   vkr_mutex_destroy(&manager->allocator, &manager->mutex);
+  vkr_mutex_destroy(&manager->allocator, &manager->payload_mutex);
   vkr_cond_destroy(&manager->allocator, &manager->cond);
 
   for (uint32_t i = 0; i < EVENT_TYPE_MAX; i++) {
     vector_destroy_EventCallbackData(&manager->callbacks[i]);
   }
 
-  queue_destroy_Event(&manager->queue);
   vkr_event_data_buffer_destroy(&manager->event_data_buf);
+  arena_destroy(manager->consumer_arena);
   arena_destroy(manager->arena);
 }
 
@@ -237,6 +505,8 @@ void event_manager_subscribe(EventManager *manager, EventType type,
 
   vector_push_EventCallbackData(&manager->callbacks[type],
                                 (EventCallbackData){callback, user_data});
+  vkr_atomic_uint32_fetch_add(&manager->subscription_generation, 1,
+                              VKR_MEMORY_ORDER_RELEASE);
   vkr_mutex_unlock(manager->mutex);
 }
 
@@ -252,73 +522,110 @@ void event_manager_unsubscribe(EventManager *manager, EventType type,
       event_callback_equals);
   if (res.found) {
     vector_pop_at_EventCallbackData(&manager->callbacks[type], res.index, NULL);
+    vkr_atomic_uint32_fetch_add(&manager->subscription_generation, 1,
+                                VKR_MEMORY_ORDER_RELEASE);
   }
   vkr_mutex_unlock(manager->mutex);
 }
 
+/**
+ * @brief Dispatch path for payloads that do not fit in a slot.
+ * Allocation and enqueue happen under `payload_mutex` so blocks enter the ring
+ * in the order the data buffer hands them out, which is the order the
+ * consumer frees them in.
+ */
+vkr_internal bool32_t event_manager_dispatch_external(EventManager *manager,
+                                                      Event event) {
+  vkr_mutex_lock(manager->payload_mutex);
+
+  if (!vkr_event_data_buffer_can_alloc(&manager->event_data_buf,
+                                       event.data_size)) {
+    log_warn("Event data buffer cannot allocate %llu bytes for event type %d "
+             "(full or too fragmented).",
+             event.data_size, event.type);
+    vkr_mutex_unlock(manager->payload_mutex);
+    return false;
+  }
+
+  uint64_t position = 0;
+  EventSlot *slot = event_ring_claim(&manager->queue, &position);
+  if (!slot) {
+    log_warn("Event queue full. Cannot dispatch event type %d.", event.type);
+    vkr_mutex_unlock(manager->payload_mutex);
+    return false;
+  }
+
+  void *copied_data_ptr_in_buffer = NULL;
+  if (!vkr_event_data_buffer_alloc(&manager->event_data_buf, event.data_size,
+                                   &copied_data_ptr_in_buffer)) {
+    // The slot is already claimed, so it has to be published; an empty
+    // invalid-type event is dropped by the consumer.
+    log_warn("Failed to allocate %llu bytes in event data buffer for event "
+             "type %d. Allocation failed unexpectedly after can_alloc passed.",
+             event.data_size, event.type);
+    slot->type = EVENT_TYPE_MAX;
+    slot->data_size = 0;
+    event_ring_publish(slot, position);
+    vkr_mutex_unlock(manager->payload_mutex);
+    return false;
+  }
+
+  MemCopy(copied_data_ptr_in_buffer, event.data, event.data_size);
+  slot->type = event.type;
+  slot->data_size = (uint32_t)event.data_size;
+  slot->payload.external = copied_data_ptr_in_buffer;
+  event_ring_publish(slot, position);
+  vkr_mutex_unlock(manager->payload_mutex);
+  return true;
+}
+
 bool32_t event_manager_dispatch(EventManager *manager, Event event) {
   assert_log(manager != NULL, "Manager is NULL");
   assert_log(event.type < EVENT_TYPE_MAX, "Invalid event type");
   assert_log(!(event.data_size > 0 && event.data == NULL),
              "Event data is NULL but data_size is greater than 0");
 
-  vkr_mutex_lock(manager->mutex);
-
-  Event event_to_enqueue = event;
-  void *copied_data_ptr_in_buffer = NULL;
+  if (event.data_size > UINT32_MAX) {
+    log_warn("Event payload of %llu bytes for event type %d is too large.",
+             event.data_size, event.type);
+    return false;
+  }
 
-  if (event.data_size > 0) {
-    if (queue_is_full_Event(&manager->queue)) {
-      log_warn("Event queue full. Cannot dispatch event type %d.", event.type);
-      vkr_mutex_unlock(manager->mutex);
+  if (event.data_size > EVENT_INLINE_PAYLOAD_SIZE) {
+    if (!event_manager_dispatch_external(manager, event)) {
       return false;
     }
-
-    if (!vkr_event_data_buffer_can_alloc(&manager->event_data_buf,
-                                         event.data_size)) {
-      log_warn("Event data buffer cannot allocate %llu bytes for event type %d "
-               "(full or too fragmented).",
-               event.data_size, event.type);
-      vkr_mutex_unlock(manager->mutex);
+  } else {
+    uint64_t position = 0;
+    EventSlot *slot = event_ring_claim(&manager->queue, &position);
+    if (!slot) {
+      log_warn("Event queue full. Cannot dispatch event type %d.", event.type);
       return false;
     }
-
-    if (!vkr_event_data_buffer_alloc(&manager->event_data_buf, event.data_size,
-                                     &copied_data_ptr_in_buffer)) {
-      log_warn(
-          "Failed to allocate %llu bytes in event data buffer for event type "
-          "%d. Allocation failed unexpectedly after can_alloc passed.",
-          event.data_size, event.type);
-      vkr_mutex_unlock(manager->mutex);
-      return false;
+    slot->type = event.type;
+    slot->data_size = (uint32_t)event.data_size;
+    if (event.data_size > 0) {
+      MemCopy(slot->payload.bytes, event.data, event.data_size);
     }
-
-    MemCopy(copied_data_ptr_in_buffer, event.data, event.data_size);
-
-    event_to_enqueue.data = copied_data_ptr_in_buffer;
-
-  } else {
-    event_to_enqueue.data = NULL;
-    event_to_enqueue.data_size = 0;
+    event_ring_publish(slot, position);
   }
 
-  if (!queue_enqueue_Event(&manager->queue, event_to_enqueue)) {
-    log_warn("Failed to enqueue event (type: %d). Event queue might be full.",
-             event_to_enqueue.type);
+  event_manager_wake_consumer(manager);
+  return true;
+}
 
-    if (event.data_size > 0 && copied_data_ptr_in_buffer != NULL) {
-      log_debug("Rolling back event data buffer allocation for event type %d "
-                "due to queue enqueue failure.",
-                event.type);
-      vkr_event_data_buffer_rollback_last_alloc(&manager->event_data_buf);
+uint32_t event_manager_pump(EventManager *manager) {
+  assert_log(manager != NULL, "Manager is NULL");
+  assert_log(manager->mode == EVENT_DISPATCH_MODE_MANUAL,
+             "event_manager_pump requires EVENT_DISPATCH_MODE_MANUAL");
+
+  uint32_t total = 0;
+  while (total < manager->queue.capacity) {
+    const uint32_t count = event_manager_process_batch(manager);
+    if (count == 0) {
+      break;
     }
-
-    vkr_mutex_unlock(manager->mutex);
-    return false;
+    total += count;
   }
-
-  vkr_cond_signal(manager->cond);
-  vkr_mutex_unlock(manager->mutex);
-
-  return true;
+  return total;
 }
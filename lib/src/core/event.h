@@ -5,40 +5,53 @@
  * @brief Defines a thread-safe, asynchronous event processing system.
  *
  * This system allows different parts of an application to communicate by
- * dispatching events without blocking the sender. Events are queued and processed
- * by a dedicated background thread, which invokes registered callback functions
- * for each event type.
+ * dispatching events without blocking the sender. Events are queued into a
+ * lock-free ring and drained in batches by a single consumer, which invokes
+ * registered callback functions for each event type.
  *
  * Key Features:
  * - **Asynchronous Processing:** Events are dispatched quickly into a queue and
- *   processed later by a worker thread, preventing the dispatcher from blocking.
- * - **Thread Safety:** Subscription, unsubscription, and dispatch operations are
- *   thread-safe using mutexes and condition variables.
+ *   processed later by the consumer, preventing the dispatcher from blocking.
+ * - **Lock-Free Dispatch:** Producers claim ring slots with a single CAS; small
+ *   payloads are copied inline into the slot, so the common dispatch path
+ *   takes no lock.
+ * - **Batched Processing:** The consumer drains up to
+ *   `EVENT_DISPATCH_BATCH_SIZE` events at a time and snapshots each event
+ *   type's callbacks once per batch instead of once per event.
+ * - **Selectable Consumer:** Either a dedicated worker thread or the owner,
+ *   calling `event_manager_pump` at a fixed point of its frame.
  * - **Type-Based Subscription:** Callbacks are registered based on specific
  *   `EventType` values.
  * - **Dynamic Subscription:** Callbacks can be subscribed and unsubscribed at
- *   runtime.
+ *   runtime, including from inside a callback.
  *
  * Architecture:
- * 1. **EventManager:** The central structure holding the event queue, callback
- *    registrations, synchronization primitives (mutex, condition variable), and
- *    the worker thread handle.
- * 2. **Event Queue:** A thread-safe queue (`Queue_Event`) stores pending events.
+ * 1. **EventManager:** The central structure holding the event ring, callback
+ *    registrations, synchronization primitives, and the worker thread handle.
+ * 2. **Event Ring (`EventRing`):** A bounded multi-producer/single-consumer
+ *    ring of cache-line sized slots. Each slot carries a sequence number that
+ *    tells producers when it is free and the consumer when it is published.
+ *    Payloads up to `EVENT_INLINE_PAYLOAD_SIZE` bytes live in the slot; larger
+ *    ones are copied into `event_data_buf` under `payload_mutex`.
  * 3. **Callback Registry:** An array (`callbacks`) where each index corresponds
  *    to an `EventType`. Each element is a dynamic vector (`Vector_EventCallback`)
- *    storing the function pointers subscribed to that event type.
- * 4. **Worker Thread:** A dedicated thread (`events_processor` in event.c)
- *    continuously waits for events on the queue. When events are available, it
- *    dequeues them and executes all registered callbacks for the event's type.
+ *    storing the function pointers subscribed to that event type. Every change
+ *    bumps `subscription_generation` so the consumer can tell when a batch
+ *    snapshot went stale.
+ * 4. **Consumer:** In `EVENT_DISPATCH_MODE_THREAD` a dedicated thread
+ *    (`events_processor` in event.c) drains the ring and sleeps when it is
+ *    empty. In `EVENT_DISPATCH_MODE_MANUAL` no thread exists and the owner
+ *    drains the ring with `event_manager_pump`. Events are always delivered in
+ *    dispatch order; batching only shares the callback snapshot.
  * 5. **Synchronization:**
- *    - A `Mutex` protects access to the event queue and the callback
- *      registry vectors.
+ *    - A `Mutex` protects the callback registry vectors and the worker's sleep.
  *    - A `CondVar` allows the worker thread to sleep efficiently when the
- *      queue is empty, waking up only when new events are dispatched or when the
- *      manager is shutting down.
+ *      ring is empty. Producers only take the mutex to wake a worker that has
+ *      announced it is going to sleep (`consumer_sleeping`).
  *
  * Usage Pattern:
- * 1. Create an `EventManager` using `event_manager_create`.
+ * 1. Create an `EventManager` using `event_manager_create` (worker thread) or
+ *    `event_manager_create_with_config`.
  * 2. Define callback functions matching the `EventCallback` signature.
  * 3. Register callbacks for specific event types using
  *    `event_manager_subscribe`.
@@ -46,17 +59,19 @@
  *    pointer within the dispatched `Event` is copied by the event system when
  *    `data_size` is greater than zero. Callbacks receive a stable copy that
  *    remains valid for the duration of the callback execution.
- * 5. Optionally, unregister callbacks using `event_manager_unsubscribe`.
- * 6. When done, destroy the manager using `event_manager_destroy` to signal the
- *    worker thread, wait for it to finish, and clean up resources.
+ * 5. In manual mode, call `event_manager_pump` once per frame from the thread
+ *    that owns the manager.
+ * 6. Optionally, unregister callbacks using `event_manager_unsubscribe`.
+ * 7. When done, destroy the manager using `event_manager_destroy` to drain the
+ *    remaining events, stop the worker thread, and clean up resources.
  */
 
 // clang-format on
 #pragma once
 
 #include "containers/array.h"
-#include "containers/queue.h"
 #include "containers/vector.h"
+#include "core/vkr_atomic.h"
 #include "core/vkr_threads.h"
 #include "defines.h"
 #include "memory/arena.h"
@@ -137,44 +152,101 @@ typedef struct EventCallbackData {
   UserData user_data;     /**< User-defined data passed to the callback. */
 } EventCallbackData;
 
-Queue(Event);
 Vector(EventCallbackData);
 Array(EventCallbackData);
 
 #define DEFAULT_EVENT_DATA_RING_BUFFER_CAPACITY                                \
   (MB(4)) // Default capacity for the event data ring buffer
 #define DEFAULT_EVENT_QUEUE_CAPACITY 1024
+#define EVENT_CACHE_LINE_SIZE 64u
+/** Largest payload stored directly in a ring slot. */
+#define EVENT_INLINE_PAYLOAD_SIZE 48u
+/** Events drained per callback snapshot. */
+#define EVENT_DISPATCH_BATCH_SIZE 64u
 
 /**
- * @brief Manages the event queue, callback subscriptions, and the processing
- * thread.
+ * @brief Selects which thread drains the event ring.
+ */
+typedef enum EventDispatchMode {
+  EVENT_DISPATCH_MODE_THREAD = 0, /**< A dedicated worker thread dispatches. */
+  EVENT_DISPATCH_MODE_MANUAL = 1, /**< The owner calls `event_manager_pump`. */
+} EventDispatchMode;
+
+typedef struct EventManagerConfig {
+  EventDispatchMode mode;
+  uint32_t queue_capacity; /**< Rounded up to a power of two. */
+} EventManagerConfig;
+
+/**
+ * @brief One ring entry, sized to a single cache line.
+ *
+ * `sequence` equals the slot's ring position while the slot is free and
+ * position + 1 once a producer has published into it.
+ */
+typedef struct EventSlot {
+  VkrAtomicUint64 sequence;
+  EventType type;
+  uint32_t data_size;
+  union {
+    uint8_t bytes[EVENT_INLINE_PAYLOAD_SIZE];
+    void *external; /**< Block in `event_data_buf` for larger payloads. */
+  } payload;
+} EventSlot;
+_Static_assert(sizeof(EventSlot) == EVENT_CACHE_LINE_SIZE,
+               "EventSlot must fill exactly one cache line");
+
+/**
+ * @brief Bounded MPSC ring of event slots.
+ */
+typedef struct EventRing {
+  EventSlot *slots;
+  uint32_t capacity;
+  uint32_t mask;
+  uint8_t producer_pad[EVENT_CACHE_LINE_SIZE];
+  VkrAtomicUint64 enqueue_position; /**< Shared by producers. */
+  uint8_t consumer_pad[EVENT_CACHE_LINE_SIZE - sizeof(VkrAtomicUint64)];
+  uint64_t dequeue_position; /**< Owned by the single consumer. */
+} EventRing;
+
+/**
+ * @brief Manages the event ring, callback subscriptions, and the consumer.
  */
 typedef struct EventManager {
   Arena *arena; /**< Arena used for internal allocations (e.g., callback
                  vectors, event data ring buffer). */
   VkrAllocator allocator; /**< Allocator backed by arena, used for threading
                              primitives. */
-  Queue_Event queue;      /**< The queue holding dispatched events awaiting
+  EventDispatchMode mode; /**< Which thread drains `queue`. */
+  EventRing queue;        /**< The ring holding dispatched events awaiting
                            processing. */
   Vector_EventCallbackData
       callbacks[EVENT_TYPE_MAX]; /**< Array of vectors, indexed by EventType,
                                     storing registered callbacks. */
+  VkrAtomicUint32 subscription_generation; /**< Bumped on every subscribe or
+                                              unsubscribe. */
+
+  VkrEventDataBuffer event_data_buf; /**< Buffer for payloads too large to
+                                        store inline in a slot. */
+  VkrMutex payload_mutex; /**< Serializes `event_data_buf` so its blocks are
+                             enqueued in allocation order. */
 
-  VkrEventDataBuffer
-      event_data_buf; /**< Buffer for storing variable-sized event data. */
+  Arena *consumer_arena; /**< Scratch for payload copies and callback
+                            snapshots, used only by the consumer. */
+  VkrAllocator consumer_allocator;
 
-  VkrMutex mutex;   /**< Mutex protecting access to the queue,
-                              callback vectors, and event data buffer. */
+  VkrMutex mutex;   /**< Mutex protecting the callback vectors and the
+                       worker's sleep. */
   VkrCondVar cond;  /**< Condition variable used by the worker thread to wait
                          for events or shutdown signal. */
   VkrThread thread; /**< Handle for the dedicated event processing thread. */
+  VkrAtomicBool consumer_sleeping; /**< Set while the worker waits on `cond`. */
   bool32_t running; /**< Flag indicating if the event processor thread should
                      continue running. */
   /*
    * IMPORTANT NOTE ON THREAD SAFETY:
    * The EventManager guarantees thread safety for its internal operations
-   * (subscribing, unsubscribing, dispatching). However, the internal mutex is
-   * *released* before callbacks are executed by the worker thread.
+   * (subscribing, unsubscribing, dispatching). However, no internal lock is
+   * held while callbacks are executed by the consumer.
    * Therefore, it is the responsibility of the individual EventCallback
    * implementations to ensure thread safety if they access or modify any shared
    * application data that could be concurrently accessed by other threads.
@@ -183,28 +255,44 @@ typedef struct EventManager {
    */
 } EventManager;
 
+/**
+ * @brief Returns the worker-thread configuration used by
+ * `event_manager_create`.
+ */
+EventManagerConfig event_manager_config_default(void);
+
 /**
  * @brief Creates and initializes a new EventManager.
- * Allocates necessary resources (queue, mutex, condition variable) and starts
+ * Allocates necessary resources (ring, mutex, condition variable) and starts
  * the background event processing thread.
  * @param manager Pointer to the EventManager structure to initialize.
  */
 void event_manager_create(EventManager *manager);
 
+/**
+ * @brief Creates an EventManager with an explicit dispatch mode and ring
+ * capacity. The worker thread is only started in `EVENT_DISPATCH_MODE_THREAD`.
+ * @param manager Pointer to the EventManager structure to initialize.
+ * @param config Mode and capacity.
+ * @return true on success, false if any resource could not be created.
+ */
+bool8_t event_manager_create_with_config(EventManager *manager,
+                                         const EventManagerConfig *config);
+
 /**
  * @brief Destroys an EventManager, cleans up resources, and stops the
  * processing thread.
- * Signals the processing thread to stop, waits for it to finish processing
- * remaining events and exit (joins the thread), then destroys synchronization
- * primitives and internal data structures.
+ * Dispatches the events still in the ring (on the worker thread, or on the
+ * calling thread in manual mode), joins the worker, then destroys
+ * synchronization primitives and internal data structures.
  * @param manager Pointer to the EventManager to destroy.
  */
 void event_manager_destroy(EventManager *manager);
 
 /**
  * @brief Subscribes a callback function to a specific event type.
- * The provided callback will be invoked by the processing thread whenever an
- * event of the specified type is dequeued.
+ * The provided callback will be invoked by the consumer whenever an event of
+ * the specified type is dequeued.
  * This operation is thread-safe.
  * Duplicate subscriptions of the same callback to the same event type are
  * ignored.
@@ -220,6 +308,8 @@ void event_manager_subscribe(EventManager *manager, EventType type,
  * @brief Unsubscribes a callback function from a specific event type.
  * Removes the specified callback from the list of subscribers for the given
  * event type. If the callback was not subscribed, this function has no effect.
+ * The change applies from the next dispatched event, even when it lands in
+ * the middle of a batch.
  * This operation is thread-safe.
  * @param manager Pointer to the EventManager.
  * @param type The `EventType` to unsubscribe from.
@@ -229,19 +319,29 @@ void event_manager_unsubscribe(EventManager *manager, EventType type,
                                EventCallback callback);
 
 /**
- * @brief Dispatches an event into the queue for asynchronous processing.
- * Enqueues the event and signals the processing thread if it is waiting.
- * This operation is thread-safe and non-blocking unless the queue is full.
- * The caller provides an `Event` structure. If `event.data_size` is greater
- * than zero and `event.data` is non-NULL, the data pointed to by `event.data`
- * (up to `event.data_size` bytes) is copied into memory managed by the
- * `EventManager`'s arena. The `Event` enqueued will then point to this
- * copied data. If `event.data_size` is zero, no copy occurs.
+ * @brief Dispatches an event into the ring for asynchronous processing.
+ * Publishes the event and wakes the worker thread if it is sleeping.
+ * This operation is thread-safe and never blocks on the consumer. Payloads of
+ * at most `EVENT_INLINE_PAYLOAD_SIZE` bytes are copied into the ring slot
+ * without taking a lock; larger payloads are copied into the manager's data
+ * buffer under `payload_mutex`. If `event.data_size` is zero, no copy occurs
+ * and callbacks receive a NULL `data`.
  * @param manager Pointer to the EventManager.
  * @param event The `Event` structure to dispatch. Its `type`, `data`, and
  * `data_size` fields are used.
  * @return `true` if the event was successfully enqueued (and data copied, if
- * applicable), `false` if the queue was full or memory allocation for data
+ * applicable), `false` if the ring was full or memory allocation for data
  * copy failed.
  */
 bool32_t event_manager_dispatch(EventManager *manager, Event event);
+
+/**
+ * @brief Dispatches pending events on the calling thread.
+ * Only valid in `EVENT_DISPATCH_MODE_MANUAL`, from one thread at a time
+ * (typically the main thread at a fixed frame phase). Drains at most one
+ * ring's worth of events so callbacks that dispatch more events cannot stall
+ * the frame; the remainder is handled by the next pump.
+ * @param manager Pointer to the EventManager.
+ * @return Number of events dequeued.
+ */
+uint32_t event_manager_pump(EventManager *manager);
@@ -1,15 +1,105 @@
 #include "logger.h"
 
+#include "core/vkr_atomic.h"
 #include "core/vkr_threads.h"
 #include "memory/vkr_arena_allocator.h"
 
 vkr_global Arena *g_log_arena = NULL;
 vkr_global VkrAllocator g_log_allocator = {0};
 vkr_global VkrMutex g_log_mutex = NULL;
+vkr_global LogSinkFn g_log_sink = NULL;
+vkr_global void *g_log_sink_user_data = NULL;
 
 vkr_global const char *LOG_LEVELS[6] = {
     "[FATAL]: ", "[ERROR]: ", "[WARN]: ", "[INFO]: ", "[DEBUG]: ", "[TRACE]: "};
 
+// =============================================================================
+// Asynchronous mode state
+// =============================================================================
+
+#define LOG_RECORD_MAX_SIZE 2048u
+#define LOG_LINE_MAX_SIZE 4096u
+#define LOG_SPEC_MAX_SIZE 32u
+#define LOG_SITE_TABLE_SIZE 1024u
+#define LOG_SITE_PROBE_LIMIT 16u
+#define LOG_CACHE_LINE_SIZE 64u
+
+typedef enum LogRecordKind {
+  LOG_RECORD_KIND_MESSAGE = 0,
+  LOG_RECORD_KIND_PADDING = 1,
+} LogRecordKind;
+
+/**
+ * Ring record header. Packed arguments follow in 8-byte slots; a `%s`
+ * argument is a length slot followed by its NUL-terminated bytes, padded to
+ * the next slot.
+ */
+typedef struct LogRecord {
+  uint32_t size;
+  uint8_t kind;
+  uint8_t level;
+  uint16_t reserved;
+  uint32_t line;
+  uint32_t suppressed;
+  const char *file;
+  const char *fmt;
+} LogRecord;
+
+typedef struct LogRing {
+  VkrAtomicUint64 head; // Producer cursor, in bytes.
+  uint8_t head_pad[LOG_CACHE_LINE_SIZE - sizeof(VkrAtomicUint64)];
+  VkrAtomicUint64 tail; // Consumer cursor, in bytes.
+  uint8_t tail_pad[LOG_CACHE_LINE_SIZE - sizeof(VkrAtomicUint64)];
+  uint8_t *data;
+  // Producer-owned counters; kept per ring so the hot path never writes a
+  // cache line shared with other producers.
+  VkrAtomicUint64 enqueued;
+  VkrAtomicUint64 dropped_full;
+} LogRing;
+
+typedef struct LogSite {
+  VkrAtomicUint64 key;
+  VkrAtomicUint64 window;
+  VkrAtomicUint32 count;
+  VkrAtomicUint32 suppressed;
+} LogSite;
+
+typedef struct LogAsyncState {
+  VkrAtomicBool active;
+  VkrAtomicBool running;
+  VkrAtomicUint32 generation;
+  VkrAtomicUint32 claimed_rings;
+  // Producers between log_async_enter() and log_async_leave(); the rings stay
+  // allocated until this drops to zero.
+  VkrAtomicUint32 in_flight;
+
+  VkrAllocator *allocator;
+  LogAsyncConfig config;
+  uint64_t ring_size;
+  LogRing *rings;
+  uint8_t *ring_data;
+  VkrThread drain_thread;
+  VkrMutex drain_mutex;
+
+  LogSite sites[LOG_SITE_TABLE_SIZE];
+
+  VkrAtomicUint64 written;
+  VkrAtomicUint64 dropped_rate_limited;
+  VkrAtomicUint64 synchronous;
+  // Ring counters folded in when the rings are released.
+  uint64_t stopped_enqueued;
+  uint64_t stopped_dropped_full;
+} LogAsyncState;
+
+vkr_global LogAsyncState g_log_async = {0};
+// Set while log_async_stop() drains the rings. Lives outside g_log_async so the
+// reset in log_async_start() cannot clear it under a waiting producer.
+vkr_global VkrAtomicBool g_log_async_stopping = {0};
+
+vkr_internal _Thread_local LogRing *t_log_ring = NULL;
+vkr_internal _Thread_local uint32_t t_log_ring_generation = 0;
+vkr_internal _Thread_local bool8_t t_log_in_drain = false_v;
+
 vkr_internal INLINE void log_lock(void) {
   if (g_log_mutex) {
     vkr_mutex_lock(g_log_mutex);
@@ -22,6 +112,16 @@ vkr_internal INLINE void log_unlock(void) {
   }
 }
 
+/** Writes one formatted line to the sink. Caller holds the log mutex. */
+vkr_internal void log_emit_locked(LogLevel level, const char *line,
+                                  uint64_t length) {
+  if (g_log_sink) {
+    g_log_sink(level, line, length, g_log_sink_user_data);
+  } else {
+    vkr_platform_console_write(line, level);
+  }
+}
+
 void log_init(Arena *arena) {
   assert(arena != NULL && "Log arena is not initialized.");
   g_log_arena = arena;
@@ -37,8 +137,16 @@ void log_init(Arena *arena) {
   }
 }
 
-void _log_message(LogLevel level, const char *file, uint32_t line,
-                  const char *fmt, ...) {
+void log_set_sink(LogSinkFn sink, void *user_data) {
+  log_lock();
+  g_log_sink = sink;
+  g_log_sink_user_data = user_data;
+  log_unlock();
+}
+
+vkr_internal void log_write_sync_v(LogLevel level, const char *file,
+                                   uint32_t line, const char *fmt,
+                                   va_list args) {
   assert(g_log_arena != NULL && "Log arena is not initialized.");
 
   log_lock();
@@ -49,10 +157,7 @@ void _log_message(LogLevel level, const char *file, uint32_t line,
     log_unlock();
     return;
   }
-  va_list args;
-  va_start(args, fmt);
   String8 message = string8_create_formatted_v(&g_log_allocator, fmt, args);
-  va_end(args);
 
   assert(message.str != NULL && "Error formatting log message.");
 
@@ -63,13 +168,904 @@ void _log_message(LogLevel level, const char *file, uint32_t line,
   assert(formatted_message.str != NULL &&
          "Error formatting final log message.");
 
-  vkr_platform_console_write(string8_cstr(&formatted_message), level);
+  log_emit_locked(level, string8_cstr(&formatted_message),
+                  formatted_message.length);
 
   vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_STRING);
 
   log_unlock();
+}
+
+// =============================================================================
+// Format specifiers
+// =============================================================================
+
+typedef enum LogLengthModifier {
+  LOG_LENGTH_NONE = 0,
+  LOG_LENGTH_CHAR,
+  LOG_LENGTH_SHORT,
+  LOG_LENGTH_LONG,
+  LOG_LENGTH_LONG_LONG,
+  LOG_LENGTH_SIZE,
+  LOG_LENGTH_INTMAX,
+  LOG_LENGTH_PTRDIFF,
+  LOG_LENGTH_LONG_DOUBLE,
+} LogLengthModifier;
+
+/** One printf conversion: `%[flags][width][.precision][length]conversion`. */
+typedef struct LogSpec {
+  const char *start;
+  uint32_t length;
+  uint8_t star_count;
+  bool8_t star_precision; // Precision is the last star argument.
+  int32_t precision;      // Literal precision, or -1.
+  LogLengthModifier length_modifier;
+  char conversion;
+} LogSpec;
+
+/** Parses the specifier starting at `p` (which points at '%'). */
+vkr_internal const char *log_parse_spec(const char *p, LogSpec *spec) {
+  MemZero(spec, sizeof(*spec));
+  spec->start = p;
+  spec->precision = -1;
+  p++;
+
+  while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+    p++;
+  }
+  if (*p == '*') {
+    spec->star_count++;
+    p++;
+  } else {
+    while (*p >= '0' && *p <= '9') {
+      p++;
+    }
+  }
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      spec->star_count++;
+      spec->star_precision = true_v;
+      p++;
+    } else {
+      spec->precision = 0;
+      while (*p >= '0' && *p <= '9') {
+        spec->precision = spec->precision * 10 + (*p - '0');
+        p++;
+      }
+    }
+  }
+
+  switch (*p) {
+  case 'h':
+    p++;
+    spec->length_modifier = LOG_LENGTH_SHORT;
+    if (*p == 'h') {
+      p++;
+      spec->length_modifier = LOG_LENGTH_CHAR;
+    }
+    break;
+  case 'l':
+    p++;
+    spec->length_modifier = LOG_LENGTH_LONG;
+    if (*p == 'l') {
+      p++;
+      spec->length_modifier = LOG_LENGTH_LONG_LONG;
+    }
+    break;
+  case 'z':
+    p++;
+    spec->length_modifier = LOG_LENGTH_SIZE;
+    break;
+  case 'j':
+    p++;
+    spec->length_modifier = LOG_LENGTH_INTMAX;
+    break;
+  case 't':
+    p++;
+    spec->length_modifier = LOG_LENGTH_PTRDIFF;
+    break;
+  case 'L':
+    p++;
+    spec->length_modifier = LOG_LENGTH_LONG_DOUBLE;
+    break;
+  default:
+    break;
+  }
+
+  spec->conversion = *p;
+  if (*p != '\0') {
+    p++;
+  }
+  spec->length = (uint32_t)(p - spec->start);
+  return p;
+}
+
+vkr_internal INLINE bool8_t log_spec_is_signed(const LogSpec *spec) {
+  return spec->conversion == 'd' || spec->conversion == 'i';
+}
+
+vkr_internal INLINE bool8_t log_spec_is_unsigned(const LogSpec *spec) {
+  return spec->conversion == 'u' || spec->conversion == 'o' ||
+         spec->conversion == 'x' || spec->conversion == 'X';
+}
+
+vkr_internal INLINE bool8_t log_spec_is_float(const LogSpec *spec) {
+  switch (spec->conversion) {
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    return true_v;
+  default:
+    return false_v;
+  }
+}
+
+// =============================================================================
+// Record packing (producer side)
+// =============================================================================
+
+typedef struct LogPacker {
+  uint8_t *data;
+  uint32_t size;
+  uint32_t capacity;
+} LogPacker;
+
+vkr_internal INLINE bool8_t log_pack_u64(LogPacker *packer, uint64_t value) {
+  if (packer->size + sizeof(uint64_t) > packer->capacity) {
+    return false_v;
+  }
+  MemCopy(packer->data + packer->size, &value, sizeof(value));
+  packer->size += sizeof(uint64_t);
+  return true_v;
+}
+
+vkr_internal bool8_t log_pack_string(LogPacker *packer, const char *str,
+                                     int32_t precision) {
+  if (!str) {
+    str = "(null)";
+  }
+  uint64_t length = 0;
+  while ((precision < 0 || length < (uint64_t)precision) && str[length]) {
+    length++;
+  }
+
+  const uint64_t padded = AlignPow2(length + 1u, sizeof(uint64_t));
+  if (!log_pack_u64(packer, length) ||
+      packer->size + padded > packer->capacity) {
+    return false_v;
+  }
+  MemCopy(packer->data + packer->size, str, length);
+  MemZero(packer->data + packer->size + length, padded - length);
+  packer->size += (uint32_t)padded;
+  return true_v;
+}
+
+vkr_internal bool8_t log_pack_integer(LogPacker *packer, const LogSpec *spec,
+                                      va_list *args) {
+  uint64_t value = 0;
+  if (log_spec_is_signed(spec)) {
+    switch (spec->length_modifier) {
+    case LOG_LENGTH_LONG:
+      value = (uint64_t)(int64_t)va_arg(*args, long);
+      break;
+    case LOG_LENGTH_LONG_LONG:
+      value = (uint64_t)(int64_t)va_arg(*args, long long);
+      break;
+    case LOG_LENGTH_SIZE:
+      value = (uint64_t)va_arg(*args, size_t);
+      break;
+    case LOG_LENGTH_INTMAX:
+      value = (uint64_t)(int64_t)va_arg(*args, intmax_t);
+      break;
+    case LOG_LENGTH_PTRDIFF:
+      value = (uint64_t)(int64_t)va_arg(*args, ptrdiff_t);
+      break;
+    default:
+      value = (uint64_t)(int64_t)va_arg(*args, int);
+      break;
+    }
+  } else {
+    switch (spec->length_modifier) {
+    case LOG_LENGTH_LONG:
+      value = (uint64_t)va_arg(*args, unsigned long);
+      break;
+    case LOG_LENGTH_LONG_LONG:
+      value = (uint64_t)va_arg(*args, unsigned long long);
+      break;
+    case LOG_LENGTH_SIZE:
+      value = (uint64_t)va_arg(*args, size_t);
+      break;
+    case LOG_LENGTH_INTMAX:
+      value = (uint64_t)va_arg(*args, uintmax_t);
+      break;
+    case LOG_LENGTH_PTRDIFF:
+      value = (uint64_t)va_arg(*args, ptrdiff_t);
+      break;
+    default:
+      value = (uint64_t)va_arg(*args, unsigned int);
+      break;
+    }
+  }
+  return log_pack_u64(packer, value);
+}
+
+/**
+ * Packs the arguments `fmt` consumes. Returns false when the message cannot
+ * be deferred (unsupported conversion or too large for one record).
+ */
+vkr_internal bool8_t log_pack_arguments(LogPacker *packer, const char *fmt,
+                                        va_list *args) {
+  for (const char *p = fmt; *p;) {
+    if (*p != '%') {
+      p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      p += 2;
+      continue;
+    }
+
+    LogSpec spec;
+    p = log_parse_spec(p, &spec);
+    if (spec.length >= LOG_SPEC_MAX_SIZE) {
+      return false_v;
+    }
+
+    int32_t star_precision = -1;
+    for (uint8_t i = 0; i < spec.star_count; ++i) {
+      const int32_t value = va_arg(*args, int);
+      star_precision = value;
+      if (!log_pack_u64(packer, (uint64_t)(int64_t)value)) {
+        return false_v;
+      }
+    }
+
+    bool8_t packed = false_v;
+    if (log_spec_is_signed(&spec) || log_spec_is_unsigned(&spec)) {
+      packed = log_pack_integer(packer, &spec, args);
+    } else if (log_spec_is_float(&spec)) {
+      float64_t value = spec.length_modifier == LOG_LENGTH_LONG_DOUBLE
+                            ? (float64_t)va_arg(*args, long double)
+                            : va_arg(*args, double);
+      uint64_t bits = 0;
+      MemCopy(&bits, &value, sizeof(bits));
+      packed = log_pack_u64(packer, bits);
+    } else if (spec.conversion == 'c' &&
+               spec.length_modifier == LOG_LENGTH_NONE) {
+      packed = log_pack_u64(packer, (uint64_t)(int64_t)va_arg(*args, int));
+    } else if (spec.conversion == 'p') {
+      packed = log_pack_u64(packer, (uint64_t)(uintptr_t)va_arg(*args, void *));
+    } else if (spec.conversion == 's' &&
+               spec.length_modifier == LOG_LENGTH_NONE) {
+      const int32_t precision =
+          spec.star_precision ? star_precision : spec.precision;
+      packed = log_pack_string(packer, va_arg(*args, const char *), precision);
+    }
+    if (!packed) {
+      return false_v;
+    }
+  }
+  return true_v;
+}
+
+// =============================================================================
+// Record formatting (drain side)
+// =============================================================================
+
+typedef struct LogReader {
+  const uint8_t *data;
+  uint32_t offset;
+  uint32_t size;
+} LogReader;
+
+vkr_internal INLINE uint64_t log_read_u64(LogReader *reader) {
+  uint64_t value = 0;
+  if (reader->offset + sizeof(uint64_t) <= reader->size) {
+    MemCopy(&value, reader->data + reader->offset, sizeof(value));
+    reader->offset += sizeof(uint64_t);
+  }
+  return value;
+}
+
+#define LOG_FORMAT_ONE(value)                                                  \
+  (star_count == 0   ? snprintf(out, remaining, spec_text, value)              \
+   : star_count == 1 ? snprintf(out, remaining, spec_text, stars[0], value)    \
+                     : snprintf(out, remaining, spec_text, stars[0], stars[1], \
+                                value))
+
+/** Formats one specifier's packed argument into `out`. */
+vkr_internal int32_t log_format_spec(const LogSpec *spec, LogReader *reader,
+                                     char *out, uint64_t remaining) {
+  char spec_text[LOG_SPEC_MAX_SIZE];
+  MemCopy(spec_text, spec->start, spec->length);
+  spec_text[spec->length] = '\0';
+
+  int32_t stars[2] = {0, 0};
+  const uint8_t star_count = spec->star_count;
+  for (uint8_t i = 0; i < star_count; ++i) {
+    stars[i] = (int32_t)(int64_t)log_read_u64(reader);
+  }
+
+  if (spec->conversion == 's') {
+    const uint64_t length = log_read_u64(reader);
+    const char *str = (const char *)(reader->data + reader->offset);
+    reader->offset += (uint32_t)AlignPow2(length + 1u, sizeof(uint64_t));
+    return LOG_FORMAT_ONE(str);
+  }
+
+  const uint64_t value = log_read_u64(reader);
+  if (log_spec_is_float(spec)) {
+    float64_t number = 0.0;
+    MemCopy(&number, &value, sizeof(number));
+    if (spec->length_modifier == LOG_LENGTH_LONG_DOUBLE) {
+      return LOG_FORMAT_ONE((long double)number);
+    }
+    return LOG_FORMAT_ONE(number);
+  }
+  if (spec->conversion == 'p') {
+    return LOG_FORMAT_ONE((void *)(uintptr_t)value);
+  }
+  if (spec->conversion == 'c') {
+    return LOG_FORMAT_ONE((int)(int64_t)value);
+  }
+
+  switch (spec->length_modifier) {
+  case LOG_LENGTH_LONG:
+    return log_spec_is_signed(spec) ? LOG_FORMAT_ONE((long)(int64_t)value)
+                                    : LOG_FORMAT_ONE((unsigned long)value);
+  case LOG_LENGTH_LONG_LONG:
+    return log_spec_is_signed(spec) ? LOG_FORMAT_ONE((long long)(int64_t)value)
+                                    : LOG_FORMAT_ONE((unsigned long long)value);
+  case LOG_LENGTH_SIZE:
+    return LOG_FORMAT_ONE((size_t)value);
+  case LOG_LENGTH_INTMAX:
+    return log_spec_is_signed(spec) ? LOG_FORMAT_ONE((intmax_t)(int64_t)value)
+                                    : LOG_FORMAT_ONE((uintmax_t)value);
+  case LOG_LENGTH_PTRDIFF:
+    return LOG_FORMAT_ONE((ptrdiff_t)(int64_t)value);
+  default:
+    // char/short modifiers are promoted to int by the caller and narrowed by
+    // printf itself.
+    return log_spec_is_signed(spec) ? LOG_FORMAT_ONE((int)(int64_t)value)
+                                    : LOG_FORMAT_ONE((unsigned int)value);
+  }
+}
+
+#undef LOG_FORMAT_ONE
+
+vkr_internal INLINE uint64_t log_advance(int32_t written, uint64_t remaining) {
+  if (written < 0) {
+    return 0;
+  }
+  return (uint64_t)written < remaining ? (uint64_t)written : remaining - 1u;
+}
+
+/** Formats a record into `out` as one complete log line. */
+vkr_internal uint64_t log_format_record(const LogRecord *record, char *out,
+                                        uint64_t capacity) {
+  // Reserve room for the trailing newline.
+  const uint64_t limit = capacity - 1u;
+  uint64_t length = log_advance(
+      snprintf(out, limit, "%s(%s:%u) ", LOG_LEVELS[record->level],
+               record->file, record->line),
+      limit);
+
+  LogReader reader = {.data = (const uint8_t *)(record + 1),
+                      .offset = 0,
+                      .size = record->size - (uint32_t)sizeof(LogRecord)};
+  for (const char *p = record->fmt; *p && length + 1u < limit;) {
+    if (*p != '%') {
+      out[length++] = *p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      out[length++] = '%';
+      p += 2;
+      continue;
+    }
+
+    LogSpec spec;
+    p = log_parse_spec(p, &spec);
+    length += log_advance(
+        log_format_spec(&spec, &reader, out + length, limit - length),
+        limit - length);
+  }
+
+  if (record->suppressed > 0 && length + 1u < limit) {
+    length += log_advance(snprintf(out + length, limit - length,
+                                   " (%u similar messages suppressed)",
+                                   record->suppressed),
+                          limit - length);
+  }
+  out[length++] = '\n';
+  out[length] = '\0';
+  return length;
+}
+
+// =============================================================================
+// Rings
+// =============================================================================
+
+vkr_internal LogRing *log_ring_for_current_thread(void) {
+  const uint32_t generation = vkr_atomic_uint32_load(
+      &g_log_async.generation, VKR_MEMORY_ORDER_RELAXED);
+  if (t_log_ring_generation == generation) {
+    return t_log_ring;
+  }
+
+  t_log_ring_generation = generation;
+  t_log_ring = NULL;
+  const uint32_t index = vkr_atomic_uint32_fetch_add(
+      &g_log_async.claimed_rings, 1u, VKR_MEMORY_ORDER_RELAXED);
+  if (index < g_log_async.config.max_threads) {
+    t_log_ring = &g_log_async.rings[index];
+  }
+  return t_log_ring;
+}
+
+/** Copies a packed record into the ring. False when the ring is full. */
+vkr_internal bool8_t log_ring_push(LogRing *ring, const LogRecord *record) {
+  const uint64_t capacity = g_log_async.ring_size;
+  const uint64_t head =
+      vkr_atomic_uint64_load(&ring->head, VKR_MEMORY_ORDER_RELAXED);
+  const uint64_t tail =
+      vkr_atomic_uint64_load(&ring->tail, VKR_MEMORY_ORDER_ACQUIRE);
+  const uint64_t offset = head & (capacity - 1u);
+  const uint64_t contiguous = capacity - offset;
+
+  // Records never wrap: pad out the tail of the buffer instead.
+  const uint64_t padding = record->size > contiguous ? contiguous : 0;
+  if (head + padding + record->size - tail > capacity) {
+    return false_v;
+  }
+
+  if (padding > 0) {
+    LogRecord *pad = (LogRecord *)(ring->data + offset);
+    pad->size = (uint32_t)padding;
+    pad->kind = LOG_RECORD_KIND_PADDING;
+  }
+  MemCopy(ring->data + ((head + padding) & (capacity - 1u)), record,
+          record->size);
+  vkr_atomic_uint64_store(&ring->head, head + padding + record->size,
+                          VKR_MEMORY_ORDER_RELEASE);
+  return true_v;
+}
+
+/** Formats and writes every visible record. Caller holds the drain mutex. */
+vkr_internal uint32_t log_ring_drain(LogRing *ring) {
+  const uint64_t capacity = g_log_async.ring_size;
+  const uint64_t head =
+      vkr_atomic_uint64_load(&ring->head, VKR_MEMORY_ORDER_ACQUIRE);
+  uint64_t tail = vkr_atomic_uint64_load(&ring->tail, VKR_MEMORY_ORDER_RELAXED);
+  uint32_t drained = 0;
+  char line[LOG_LINE_MAX_SIZE];
+
+  while (tail < head) {
+    const LogRecord *record =
+        (const LogRecord *)(ring->data + (tail & (capacity - 1u)));
+    if (record->kind == LOG_RECORD_KIND_MESSAGE) {
+      const uint64_t length = log_format_record(record, line, sizeof(line));
+      log_lock();
+      log_emit_locked((LogLevel)record->level, line, length);
+      log_unlock();
+      drained++;
+    }
+    tail += record->size;
+    vkr_atomic_uint64_store(&ring->tail, tail, VKR_MEMORY_ORDER_RELEASE);
+  }
+
+  if (drained > 0) {
+    vkr_atomic_uint64_fetch_add(&g_log_async.written, drained,
+                                VKR_MEMORY_ORDER_RELAXED);
+  }
+  return drained;
+}
+
+vkr_internal uint32_t log_drain_all(void) {
+  t_log_in_drain = true_v;
+  vkr_mutex_lock(g_log_async.drain_mutex);
+  uint32_t ring_count = vkr_atomic_uint32_load(&g_log_async.claimed_rings,
+                                               VKR_MEMORY_ORDER_ACQUIRE);
+  if (ring_count > g_log_async.config.max_threads) {
+    ring_count = g_log_async.config.max_threads;
+  }
+  uint32_t drained = 0;
+  for (uint32_t i = 0; i < ring_count; ++i) {
+    drained += log_ring_drain(&g_log_async.rings[i]);
+  }
+  vkr_mutex_unlock(g_log_async.drain_mutex);
+  t_log_in_drain = false_v;
+  return drained;
+}
+
+/**
+ * Writes what the calling thread has queued so far, so a message it is about
+ * to write synchronously cannot overtake them.
+ */
+vkr_internal void log_drain_current_thread(void) {
+  if (!t_log_ring ||
+      t_log_ring_generation != vkr_atomic_uint32_load(
+                                   &g_log_async.generation,
+                                   VKR_MEMORY_ORDER_RELAXED)) {
+    return;
+  }
+  t_log_in_drain = true_v;
+  vkr_mutex_lock(g_log_async.drain_mutex);
+  log_ring_drain(t_log_ring);
+  vkr_mutex_unlock(g_log_async.drain_mutex);
+  t_log_in_drain = false_v;
+}
+
+vkr_internal void *log_drain_thread(void *arg) {
+  (void)arg;
+  while (vkr_atomic_bool_load(&g_log_async.running, VKR_MEMORY_ORDER_ACQUIRE)) {
+    if (log_drain_all() == 0) {
+      vkr_thread_sleep(1);
+    }
+  }
+  return NULL;
+}
+
+// =============================================================================
+// Per-site rate limiting
+// =============================================================================
+
+vkr_internal LogSite *log_site_get(const char *file, uint32_t line) {
+  // User-space addresses fit in 48 bits on the supported targets, which
+  // leaves the top bits for the line number.
+  const uint64_t key =
+      ((uint64_t)(uintptr_t)file ^ ((uint64_t)line << 48)) | 1u;
+  uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+  for (uint32_t probe = 0; probe < LOG_SITE_PROBE_LIMIT; ++probe) {
+    LogSite *site =
+        &g_log_async.sites[(hash >> 54) & (LOG_SITE_TABLE_SIZE - 1u)];
+    uint64_t current =
+        vkr_atomic_uint64_load(&site->key, VKR_MEMORY_ORDER_ACQUIRE);
+    if (current == key) {
+      return site;
+    }
+    if (current == 0 &&
+        vkr_atomic_uint64_compare_exchange(&site->key, &current, key,
+                                           VKR_MEMORY_ORDER_ACQ_REL,
+                                           VKR_MEMORY_ORDER_ACQUIRE)) {
+      return site;
+    }
+    if (current == key) {
+      return site;
+    }
+    hash += 1ull << 54;
+  }
+  return NULL; // Table saturated: the site goes unlimited.
+}
+
+/**
+ * Returns false when the site is over budget for the current window. On the
+ * first message of a new window, `out_suppressed` receives how many were
+ * dropped in the previous one.
+ */
+vkr_internal bool8_t log_site_allow(const char *file, uint32_t line,
+                                    uint32_t *out_suppressed) {
+  *out_suppressed = 0;
+  const uint32_t limit = g_log_async.config.site_rate_limit;
+  if (limit == 0) {
+    return true_v;
+  }
+  LogSite *site = log_site_get(file, line);
+  if (!site) {
+    return true_v;
+  }
+
+  const uint64_t window =
+      (uint64_t)(vkr_platform_get_absolute_time() * 1000.0 /
+                 (float64_t)g_log_async.config.rate_limit_window_ms) +
+      1u;
+  uint64_t current =
+      vkr_atomic_uint64_load(&site->window, VKR_MEMORY_ORDER_ACQUIRE);
+  uint32_t suppressed = 0;
+  if (current != window &&
+      vkr_atomic_uint64_compare_exchange(&site->window, &current, window,
+                                         VKR_MEMORY_ORDER_ACQ_REL,
+                                         VKR_MEMORY_ORDER_ACQUIRE)) {
+    vkr_atomic_uint32_store(&site->count, 0, VKR_MEMORY_ORDER_RELAXED);
+    suppressed = vkr_atomic_uint32_exchange(&site->suppressed, 0,
+                                            VKR_MEMORY_ORDER_RELAXED);
+  }
+
+  if (vkr_atomic_uint32_fetch_add(&site->count, 1u,
+                                  VKR_MEMORY_ORDER_RELAXED) >= limit) {
+    vkr_atomic_uint32_fetch_add(&site->suppressed, suppressed + 1u,
+                                VKR_MEMORY_ORDER_RELAXED);
+    return false_v;
+  }
+  *out_suppressed = suppressed;
+  return true_v;
+}
+
+// =============================================================================
+// Public API
+// =============================================================================
+
+/**
+ * Registers the caller with the running async session. False in synchronous
+ * mode. The increment and the `active` check are both sequentially
+ * consistent, pairing with log_async_stop(): either the stop sees this
+ * producer and waits for it, or this producer sees the stop and stays out.
+ */
+vkr_internal bool8_t log_async_enter(void) {
+  vkr_atomic_uint32_fetch_add(&g_log_async.in_flight, 1u,
+                              VKR_MEMORY_ORDER_SEQ_CST);
+  if (vkr_atomic_bool_load(&g_log_async.active, VKR_MEMORY_ORDER_SEQ_CST)) {
+    return true_v;
+  }
+  vkr_atomic_uint32_fetch_sub(&g_log_async.in_flight, 1u,
+                              VKR_MEMORY_ORDER_RELEASE);
+  return false_v;
+}
+
+vkr_internal void log_async_leave(void) {
+  vkr_atomic_uint32_fetch_sub(&g_log_async.in_flight, 1u,
+                              VKR_MEMORY_ORDER_RELEASE);
+}
+
+/**
+ * A thread that queued records must not write synchronously until the stop
+ * has drained them. Threads without a ring have nothing to overtake, which
+ * also keeps the drain thread itself out of this wait.
+ */
+vkr_internal void log_async_wait_for_stop(void) {
+  if (!t_log_ring) {
+    return;
+  }
+  while (vkr_atomic_bool_load(&g_log_async_stopping,
+                              VKR_MEMORY_ORDER_ACQUIRE)) {
+    vkr_thread_sleep(0);
+  }
+}
+
+vkr_internal bool8_t log_enqueue(LogLevel level, const char *file,
+                                 uint32_t line, uint32_t suppressed,
+                                 const char *fmt, va_list args) {
+  LogRing *ring = log_ring_for_current_thread();
+  if (!ring) {
+    return false_v;
+  }
+
+  _Alignas(8) uint8_t buffer[LOG_RECORD_MAX_SIZE];
+  LogRecord *record = (LogRecord *)buffer;
+  *record = (LogRecord){
+      .kind = LOG_RECORD_KIND_MESSAGE,
+      .level = (uint8_t)level,
+      .line = line,
+      .suppressed = suppressed,
+      .file = file,
+      .fmt = fmt,
+  };
+  LogPacker packer = {.data = buffer + sizeof(LogRecord),
+                      .capacity = LOG_RECORD_MAX_SIZE - sizeof(LogRecord)};
+  va_list pack_args;
+  va_copy(pack_args, args);
+  const bool8_t packed = log_pack_arguments(&packer, fmt, &pack_args);
+  va_end(pack_args);
+  if (!packed) {
+    return false_v;
+  }
+  record->size = (uint32_t)sizeof(LogRecord) + packer.size;
+
+  // Single writer per ring, so a plain load/store pair suffices.
+  VkrAtomicUint64 *counter =
+      log_ring_push(ring, record) ? &ring->enqueued : &ring->dropped_full;
+  vkr_atomic_uint64_store(
+      counter, vkr_atomic_uint64_load(counter, VKR_MEMORY_ORDER_RELAXED) + 1u,
+      VKR_MEMORY_ORDER_RELAXED);
+  return true_v; // A full ring drops rather than blocking the producer.
+}
+
+void _log_message(LogLevel level, const char *file, uint32_t line,
+                  const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+
+  if (!t_log_in_drain && log_async_enter()) {
+    if (level == LOG_LEVEL_FATAL) {
+      // Everything logged before the fatal error must reach the sink before
+      // the debugger (or the crash) takes over.
+      log_drain_all();
+    } else {
+      uint32_t suppressed = 0;
+      if (!log_site_allow(file, line, &suppressed)) {
+        vkr_atomic_uint64_fetch_add(&g_log_async.dropped_rate_limited, 1u,
+                                    VKR_MEMORY_ORDER_RELAXED);
+        log_async_leave();
+        va_end(args);
+        return;
+      }
+      if (log_enqueue(level, file, line, suppressed, fmt, args)) {
+        log_async_leave();
+        va_end(args);
+        return;
+      }
+      log_drain_current_thread();
+    }
+    vkr_atomic_uint64_fetch_add(&g_log_async.synchronous, 1u,
+                                VKR_MEMORY_ORDER_RELAXED);
+    log_async_leave();
+  } else if (!t_log_in_drain) {
+    log_async_wait_for_stop();
+  }
+
+  log_write_sync_v(level, file, line, fmt, args);
+  va_end(args);
 
   if (level == LOG_LEVEL_FATAL) {
     debug_break();
   }
 }
+
+LogAsyncConfig log_async_config_default(void) {
+  return (LogAsyncConfig){
+      .max_threads = 32,
+      .ring_size = (uint32_t)KB(64),
+      .site_rate_limit = 64,
+      .rate_limit_window_ms = 1000,
+  };
+}
+
+bool8_t log_async_start(VkrAllocator *allocator, const LogAsyncConfig *config) {
+  assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(config != NULL, "Config is NULL");
+
+  if (log_async_is_active()) {
+    return true_v;
+  }
+  if (config->max_threads == 0 || config->ring_size < LOG_RECORD_MAX_SIZE) {
+    log_error("Async logging needs at least one ring of %u bytes",
+              LOG_RECORD_MAX_SIZE);
+    return false_v;
+  }
+
+  uint64_t ring_size = LOG_RECORD_MAX_SIZE;
+  while (ring_size < config->ring_size) {
+    ring_size <<= 1u;
+  }
+
+  const uint32_t generation = vkr_atomic_uint32_load(&g_log_async.generation,
+                                                     VKR_MEMORY_ORDER_RELAXED);
+  // Callers backing out of log_async_enter() may still decrement this.
+  const uint32_t in_flight = vkr_atomic_uint32_load(&g_log_async.in_flight,
+                                                    VKR_MEMORY_ORDER_ACQUIRE);
+  MemZero(&g_log_async, sizeof(g_log_async));
+  vkr_atomic_uint32_store(&g_log_async.generation, generation + 1u,
+                          VKR_MEMORY_ORDER_RELAXED);
+  vkr_atomic_uint32_store(&g_log_async.in_flight, in_flight,
+                          VKR_MEMORY_ORDER_RELEASE);
+  g_log_async.allocator = allocator;
+  g_log_async.config = *config;
+  if (g_log_async.config.rate_limit_window_ms == 0) {
+    g_log_async.config.rate_limit_window_ms = 1000;
+  }
+  g_log_async.ring_size = ring_size;
+
+  g_log_async.rings = vkr_allocator_alloc_aligned(
+      allocator, sizeof(LogRing) * config->max_threads, LOG_CACHE_LINE_SIZE,
+      VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  g_log_async.ring_data = vkr_allocator_alloc_aligned(
+      allocator, ring_size * config->max_threads, LOG_CACHE_LINE_SIZE,
+      VKR_ALLOCATOR_MEMORY_TAG_BUFFER);
+  if (!g_log_async.rings || !g_log_async.ring_data ||
+      !vkr_mutex_create(allocator, &g_log_async.drain_mutex)) {
+    log_error("Failed to allocate async log rings");
+    log_async_stop();
+    return false_v;
+  }
+  MemZero(g_log_async.rings, sizeof(LogRing) * config->max_threads);
+  for (uint32_t i = 0; i < config->max_threads; ++i) {
+    g_log_async.rings[i].data = g_log_async.ring_data + ring_size * i;
+  }
+
+  vkr_atomic_bool_store(&g_log_async.running, true_v,
+                        VKR_MEMORY_ORDER_RELEASE);
+  if (!vkr_thread_create(allocator, &g_log_async.drain_thread,
+                         log_drain_thread, NULL)) {
+    log_error("Failed to start log drain thread");
+    log_async_stop();
+    return false_v;
+  }
+
+  vkr_atomic_bool_store(&g_log_async.active, true_v, VKR_MEMORY_ORDER_RELEASE);
+  return true_v;
+}
+
+void log_async_stop(void) {
+  VkrAllocator *allocator = g_log_async.allocator;
+  if (!allocator) {
+    return;
+  }
+
+  // New messages take the synchronous path once the rings are drained, and
+  // threads re-register on the next start.
+  vkr_atomic_bool_store(&g_log_async_stopping, true_v,
+                        VKR_MEMORY_ORDER_SEQ_CST);
+  vkr_atomic_bool_store(&g_log_async.active, false_v,
+                        VKR_MEMORY_ORDER_SEQ_CST);
+  vkr_atomic_uint32_fetch_add(&g_log_async.generation, 1u,
+                              VKR_MEMORY_ORDER_RELAXED);
+  // Producers that saw async mode active may still be writing a record.
+  while (vkr_atomic_uint32_load(&g_log_async.in_flight,
+                                VKR_MEMORY_ORDER_SEQ_CST) != 0) {
+    vkr_thread_sleep(0);
+  }
+
+  vkr_atomic_bool_store(&g_log_async.running, false_v,
+                        VKR_MEMORY_ORDER_RELEASE);
+  if (g_log_async.drain_thread) {
+    vkr_thread_join(g_log_async.drain_thread);
+    vkr_thread_destroy(allocator, &g_log_async.drain_thread);
+  }
+  if (g_log_async.drain_mutex) {
+    log_drain_all();
+    vkr_mutex_destroy(allocator, &g_log_async.drain_mutex);
+  }
+  vkr_atomic_bool_store(&g_log_async_stopping, false_v,
+                        VKR_MEMORY_ORDER_RELEASE);
+  const uint32_t max_threads = g_log_async.config.max_threads;
+  if (g_log_async.rings) {
+    const LogAsyncStats stats = log_async_get_stats();
+    g_log_async.stopped_enqueued = stats.enqueued;
+    g_log_async.stopped_dropped_full = stats.dropped_full;
+  }
+  if (g_log_async.ring_data) {
+    vkr_allocator_free_aligned(allocator, g_log_async.ring_data,
+                               g_log_async.ring_size * max_threads,
+                               LOG_CACHE_LINE_SIZE,
+                               VKR_ALLOCATOR_MEMORY_TAG_BUFFER);
+    g_log_async.ring_data = NULL;
+  }
+  if (g_log_async.rings) {
+    vkr_allocator_free_aligned(allocator, g_log_async.rings,
+                               sizeof(LogRing) * max_threads,
+                               LOG_CACHE_LINE_SIZE,
+                               VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+    g_log_async.rings = NULL;
+  }
+  g_log_async.allocator = NULL;
+}
+
+void log_flush(void) {
+  if (t_log_in_drain || !log_async_enter()) {
+    return;
+  }
+  log_drain_all();
+  log_async_leave();
+}
+
+bool8_t log_async_is_active(void) {
+  return vkr_atomic_bool_load(&g_log_async.active, VKR_MEMORY_ORDER_ACQUIRE);
+}
+
+LogAsyncStats log_async_get_stats(void) {
+  LogAsyncStats stats = {
+      .enqueued = g_log_async.stopped_enqueued,
+      .written = vkr_atomic_uint64_load(&g_log_async.written,
+                                        VKR_MEMORY_ORDER_RELAXED),
+      .dropped_full = g_log_async.stopped_dropped_full,
+      .dropped_rate_limited = vkr_atomic_uint64_load(
+          &g_log_async.dropped_rate_limited, VKR_MEMORY_ORDER_RELAXED),
+      .synchronous = vkr_atomic_uint64_load(&g_log_async.synchronous,
+                                            VKR_MEMORY_ORDER_RELAXED),
+  };
+  if (g_log_async.rings) {
+    for (uint32_t i = 0; i < g_log_async.config.max_threads; ++i) {
+      stats.enqueued += vkr_atomic_uint64_load(&g_log_async.rings[i].enqueued,
+                                               VKR_MEMORY_ORDER_RELAXED);
+      stats.dropped_full += vkr_atomic_uint64_load(
+          &g_log_async.rings[i].dropped_full, VKR_MEMORY_ORDER_RELAXED);
+    }
+  }
+  return stats;
+}
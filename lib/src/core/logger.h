@@ -14,10 +14,83 @@ typedef enum LogLevel {
   LOG_LEVEL_TRACE = 5,
 } LogLevel;
 
+/**
+ * @brief Receives each formatted log line (prefix and trailing newline
+ * included). Called from the logging thread in synchronous mode and from the
+ * drain thread in asynchronous mode, never concurrently.
+ */
+typedef void (*LogSinkFn)(LogLevel level, const char *line, uint64_t length,
+                          void *user_data);
+
+/**
+ * @brief Asynchronous logging configuration.
+ *
+ * In asynchronous mode each producing thread owns a single-producer ring of
+ * binary records (format pointer, call site, packed arguments). A drain
+ * thread formats records and writes them to the sink, so producers never take
+ * a lock or format text. Ordering is preserved per thread only.
+ *
+ * Format strings must outlive the drain (string literals do); `%s` arguments
+ * are copied into the record. Messages that do not fit a record, use
+ * unsupported conversions, or come from threads beyond `max_threads` are
+ * written synchronously instead, after the thread's queued records.
+ */
+typedef struct LogAsyncConfig {
+  /** Producer rings; threads registering after these run out log sync. */
+  uint32_t max_threads;
+  /** Bytes per ring; rounded up to a power of two. A full ring drops. */
+  uint32_t ring_size;
+  /** Messages allowed per call site per window; 0 disables limiting. */
+  uint32_t site_rate_limit;
+  uint32_t rate_limit_window_ms;
+} LogAsyncConfig;
+
+typedef struct LogAsyncStats {
+  uint64_t enqueued;
+  uint64_t written;
+  uint64_t dropped_full;
+  uint64_t dropped_rate_limited;
+  /** Messages written on the calling thread while async mode was active. */
+  uint64_t synchronous;
+} LogAsyncStats;
+
 void log_init(Arena *arena);
 void _log_message(LogLevel level, const char *file, uint32_t line,
                   const char *fmt, ...);
 
+/**
+ * @brief Routes formatted lines to `sink` instead of the platform console.
+ * Passing NULL restores console output. Set while no other thread is logging.
+ */
+void log_set_sink(LogSinkFn sink, void *user_data);
+
+LogAsyncConfig log_async_config_default(void);
+
+/**
+ * @brief Switches to asynchronous logging and starts the drain thread.
+ *
+ * Ring storage is allocated from `allocator` and must stay valid until
+ * log_async_stop() returns.
+ */
+bool8_t log_async_start(VkrAllocator *allocator, const LogAsyncConfig *config);
+
+/**
+ * @brief Returns to synchronous logging, drains every pending record and stops
+ * the drain thread. Other threads may keep logging: the call waits for
+ * producers already writing a record, and later messages are written
+ * synchronously.
+ */
+void log_async_stop(void);
+
+/**
+ * @brief Writes every record enqueued before the call. No-op in synchronous
+ * mode. Fatal messages flush implicitly before they are written.
+ */
+void log_flush(void);
+
+bool8_t log_async_is_active(void);
+LogAsyncStats log_async_get_stats(void);
+
 #define log_fatal(fmt, ...)                                                    \
   _log_message(LOG_LEVEL_FATAL, __FILE__, __LINE__, fmt, ##__VA_ARGS__);
 
@@ -62,3 +62,7 @@ VKR_ATOMIC_DEFINE_INT_FUNCS(int64_t, VkrAtomicInt64, int64)
 VKR_ATOMIC_DEFINE_INT_FUNCS(uint64_t, VkrAtomicUint64, uint64)
 
 #undef VKR_ATOMIC_DEFINE_INT_FUNCS
+
+void vkr_atomic_thread_fence(VkrMemoryOrder order) {
+  atomic_thread_fence(order);
+}
@@ -309,3 +309,9 @@ bool32_t vkr_atomic_uint64_compare_exchange(VkrAtomicUint64 *obj,
                                             uint64_t desired,
                                             VkrMemoryOrder success_order,
                                             VkrMemoryOrder failure_order);
+
+/**
+ * @brief Issue a memory fence with the given order.
+ * @param order The memory order to use.
+ */
+void vkr_atomic_thread_fence(VkrMemoryOrder order);
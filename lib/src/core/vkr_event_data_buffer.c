@@ -75,12 +75,17 @@ bool8_t vkr_event_data_buffer_alloc(VkrEventDataBuffer *edb,
   uint64_t new_tail_candidate = edb->tail;
   uint8_t *actual_write_location = NULL;
 
-  if (edb->tail >= edb->head) {
+  // tail == head with live data means the buffer is full, not empty.
+  if (edb->tail > edb->head || edb->fill == 0) {
     if (edb->tail + block_size_needed <= edb->capacity) {
       actual_write_location = write_ptr_base + edb->tail;
       new_tail_candidate = edb->tail + block_size_needed;
     } else {
       if (block_size_needed <= edb->head) {
+        // Leave a zero header in the skipped tail so free() knows to wrap.
+        if (edb->capacity - edb->tail >= sizeof(uint64_t)) {
+          MemZero(write_ptr_base + edb->tail, sizeof(uint64_t));
+        }
         actual_write_location = write_ptr_base + 0; // Write at the start
         new_tail_candidate = block_size_needed;
       } else {
@@ -133,9 +138,16 @@ bool8_t vkr_event_data_buffer_free(VkrEventDataBuffer *edb,
 
   assert_log(edb->head < edb->capacity, "Buffer head out of bounds.");
 
-  uint64_t actual_payload_size_in_header;
-  MemCopy(&actual_payload_size_in_header, edb->buffer + edb->head,
-          sizeof(uint64_t));
+  uint64_t actual_payload_size_in_header = 0;
+  if (edb->capacity - edb->head >= sizeof(uint64_t)) {
+    MemCopy(&actual_payload_size_in_header, edb->buffer + edb->head,
+            sizeof(uint64_t));
+  }
+  if (actual_payload_size_in_header == 0) {
+    // The block at head was placed at the start when alloc() wrapped.
+    edb->head = 0;
+    MemCopy(&actual_payload_size_in_header, edb->buffer, sizeof(uint64_t));
+  }
 
   if (actual_payload_size_in_header != payload_size_from_event) {
     log_fatal(
@@ -1,5 +1,6 @@
 #include "core/vkr_job_system.h"
 #include "core/logger.h"
+#include "core/vkr_trace.h"
 #include "memory/vkr_allocator.h"
 #include "memory/vkr_arena_allocator.h"
 #include "platform/vkr_platform.h"
@@ -237,6 +238,10 @@ vkr_internal void job_worker_complete(VkrJobSystem *system, VkrJobSlot *slot,
             child->state == JOB_STATE_PENDING) {
           if (!job_system_enqueue_locked(system, child)) {
             log_warn("Job failed to enqueue dependency child job");
+          } else {
+            VKR_TRACE_FLOW_STEP("job",
+                                vkr_trace_flow_id(child->handle.id,
+                                                  child->handle.generation));
           }
         }
       }
@@ -274,6 +279,7 @@ vkr_internal void *job_worker_thread(void *param) {
 
   VkrJobWorker *worker = (VkrJobWorker *)param;
   VkrJobSystem *system = worker->system;
+  VKR_TRACE_THREAD_NAME("job.worker");
 
   while (true) {
     vkr_mutex_lock(system->mutex);
@@ -324,12 +330,16 @@ vkr_internal void *job_worker_thread(void *param) {
                          .allocator = scratch_alloc,
                          .scope = scope};
 
-    bool8_t success = false_v;
-    if (slot->run) {
-      success = slot->run(&ctx, slot->payload);
-    }
+    VKR_TRACE_SCOPE("job") {
+      VKR_TRACE_FLOW_END("job",
+                         vkr_trace_flow_id(handle.id, handle.generation));
+      bool8_t success = false_v;
+      if (slot->run) {
+        success = slot->run(&ctx, slot->payload);
+      }
 
-    job_worker_complete(system, slot, handle, &ctx, success);
+      job_worker_complete(system, slot, handle, &ctx, success);
+    }
     vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
   }
 
@@ -641,6 +651,12 @@ vkr_internal bool8_t vkr_job_submit_internal(VkrJobSystem *system,
   }
 
   vkr_mutex_unlock(system->mutex);
+  // Starts the job's flow arrow; dependency wakeups step it and the worker
+  // that runs the job ends it.
+  VKR_TRACE_SCOPE("job.submit") {
+    VKR_TRACE_FLOW_BEGIN("job",
+                         vkr_trace_flow_id(handle.id, handle.generation));
+  }
   return true_v;
 }
 
@@ -1,10 +1,24 @@
 #include "core/vkr_metrics.h"
 
 #include "core/logger.h"
+#include "math/vkr_math.h"
 
 #define VKR_METRICS_SNAPSHOT_WRITER_OWNED UINT32_MAX
 
 static VkrAtomicUint32 s_vkr_metrics_next_generation = 1u;
+static VkrAtomicUint32 s_vkr_metrics_next_histogram_shard = 0u;
+vkr_internal _Thread_local uint32_t t_vkr_metrics_histogram_shard = UINT32_MAX;
+
+/** Percentiles exported per histogram; basis points and event subject. */
+static const struct {
+  uint16_t basis_points;
+  const char *subject;
+} s_vkr_metrics_export_percentiles[] = {
+    {5000u, "p50"},
+    {9000u, "p90"},
+    {9900u, "p99"},
+    {9990u, "p99.9"},
+};
 
 vkr_internal bool8_t vkr_metrics_name_is_valid(const String8 *name) {
   if (!name || !name->str || name->length == 0 ||
@@ -30,17 +44,23 @@ vkr_internal bool8_t
 vkr_metrics_description_is_valid(const VkrMetricDescription *description) {
   if (!description || !vkr_metrics_name_is_valid(&description->name) ||
       description->domain >= VKR_METRIC_DOMAIN_COUNT ||
-      description->kind > VKR_METRIC_KIND_DURATION ||
+      description->kind > VKR_METRIC_KIND_HISTOGRAM ||
       description->unit >= VKR_METRIC_UNIT_COUNT_MAX ||
       description->scalar > VKR_METRIC_SCALAR_F64 ||
       description->writer > VKR_METRIC_WRITER_CONCURRENT) {
     return false_v;
   }
   if ((description->kind == VKR_METRIC_KIND_COUNTER ||
-       description->kind == VKR_METRIC_KIND_DURATION) &&
+       description->kind == VKR_METRIC_KIND_DURATION ||
+       description->kind == VKR_METRIC_KIND_HISTOGRAM) &&
       description->scalar != VKR_METRIC_SCALAR_U64) {
     return false_v;
   }
+  // Bucket geometry and exported events are both defined in nanoseconds.
+  if (description->kind == VKR_METRIC_KIND_HISTOGRAM &&
+      description->unit != VKR_METRIC_UNIT_NANOSECONDS) {
+    return false_v;
+  }
   if (description->writer == VKR_METRIC_WRITER_CONCURRENT &&
       description->scalar != VKR_METRIC_SCALAR_U64) {
     return false_v;
@@ -58,6 +78,13 @@ void vkr_metrics_init(VkrMetrics *metrics) {
     vkr_atomic_uint64_store(&metrics->events[i].sequence, i,
                             VKR_MEMORY_ORDER_RELAXED);
   }
+  for (uint32_t h = 0; h < VKR_METRICS_MAX_HISTOGRAMS; ++h) {
+    for (uint32_t shard = 0; shard < VKR_METRIC_HISTOGRAM_SHARD_COUNT;
+         ++shard) {
+      vkr_atomic_uint64_store(&metrics->histograms[h].shards[shard].min_ns,
+                              UINT64_MAX, VKR_MEMORY_ORDER_RELAXED);
+    }
+  }
 }
 
 bool8_t vkr_metrics_register(VkrMetrics *metrics,
@@ -71,6 +98,10 @@ bool8_t vkr_metrics_register(VkrMetrics *metrics,
       !vkr_metrics_description_is_valid(description)) {
     return false_v;
   }
+  if (description->kind == VKR_METRIC_KIND_HISTOGRAM &&
+      metrics->histogram_count >= VKR_METRICS_MAX_HISTOGRAMS) {
+    return false_v;
+  }
 
   for (uint32_t i = 0; i < metrics->slot_count; ++i) {
     const VkrMetricCatalogEntry *entry = &metrics->catalog[i];
@@ -94,6 +125,17 @@ bool8_t vkr_metrics_register(VkrMetrics *metrics,
   entry->scalar = description->scalar;
   entry->writer = description->writer;
   entry->required_when_enabled = description->required_when_enabled;
+  if (description->kind == VKR_METRIC_KIND_HISTOGRAM) {
+    const uint32_t histogram = metrics->histogram_count++;
+    const uint32_t half_life =
+        description->histogram_half_life_frames > 0
+            ? description->histogram_half_life_frames
+            : VKR_METRIC_HISTOGRAM_DEFAULT_HALF_LIFE_FRAMES;
+    entry->histogram_index = (uint8_t)histogram;
+    metrics->histograms[histogram].id = id;
+    metrics->histograms[histogram].decay =
+        vkr_pow_f32(0.5f, 1.0f / (float32_t)half_life);
+  }
   *out_id = id;
   return true_v;
 }
@@ -115,11 +157,17 @@ void vkr_metrics_begin_frame(VkrMetrics *metrics, uint64_t cpu_frame_index,
   assert(metrics->render_thread_id == vkr_thread_current_id());
   assert(!metrics->frame_active);
   MemZero(metrics->active, sizeof(VkrMetricSample) * metrics->slot_count);
+  MemZero(metrics->active_histograms,
+          sizeof(VkrMetricHistogramCounts) * metrics->histogram_count);
   for (uint32_t i = 0; i < metrics->slot_count; ++i) {
     // Kind/scalar are mirrored from the catalog every frame so a consumer that
     // holds only a published frame can prove which union member is live.
     metrics->active[i].kind = metrics->catalog[i].kind;
     metrics->active[i].scalar = metrics->catalog[i].scalar;
+    if (metrics->catalog[i].kind == VKR_METRIC_KIND_HISTOGRAM) {
+      metrics->active[i].value.histogram.histogram_index =
+          metrics->catalog[i].histogram_index;
+    }
     // A counter that is simply not incremented this frame is a valid zero, not
     // an absent sample; anything else conflates "no draws" with "not measured".
     if (metrics->catalog[i].kind == VKR_METRIC_KIND_COUNTER) {
@@ -139,7 +187,8 @@ vkr_internal void vkr_metrics_collect_concurrent(VkrMetrics *metrics,
                                                  VkrMetricsFrame *frame) {
   for (uint32_t i = 0; i < metrics->slot_count; ++i) {
     const VkrMetricCatalogEntry *entry = &metrics->catalog[i];
-    if (entry->writer != VKR_METRIC_WRITER_CONCURRENT) {
+    if (entry->writer != VKR_METRIC_WRITER_CONCURRENT ||
+        entry->kind == VKR_METRIC_KIND_HISTOGRAM) {
       continue;
     }
 
@@ -178,7 +227,8 @@ vkr_internal void vkr_metrics_collect_concurrent(VkrMetrics *metrics,
 vkr_internal void vkr_metrics_discard_concurrent_interval(VkrMetrics *metrics) {
   for (uint32_t i = 0; i < metrics->slot_count; ++i) {
     const VkrMetricCatalogEntry *entry = &metrics->catalog[i];
-    if (entry->writer != VKR_METRIC_WRITER_CONCURRENT) {
+    if (entry->writer != VKR_METRIC_WRITER_CONCURRENT ||
+        entry->kind == VKR_METRIC_KIND_HISTOGRAM) {
       continue;
     }
 
@@ -192,6 +242,111 @@ vkr_internal void vkr_metrics_discard_concurrent_interval(VkrMetrics *metrics) {
   }
 }
 
+void vkr_metrics_histogram_record_concurrent(VkrMetrics *metrics,
+                                             uint32_t index,
+                                             uint64_t duration_ns) {
+  if (t_vkr_metrics_histogram_shard == UINT32_MAX) {
+    t_vkr_metrics_histogram_shard =
+        vkr_atomic_uint32_fetch_add(&s_vkr_metrics_next_histogram_shard, 1u,
+                                    VKR_MEMORY_ORDER_RELAXED) %
+        VKR_METRIC_HISTOGRAM_SHARD_COUNT;
+  }
+  VkrMetricHistogramShard *shard =
+      &metrics->histograms[metrics->catalog[index].histogram_index]
+           .shards[t_vkr_metrics_histogram_shard];
+  vkr_atomic_uint32_fetch_add(
+      &shard->counts[vkr_metric_histogram_bucket(duration_ns)], 1u,
+      VKR_MEMORY_ORDER_RELAXED);
+  vkr_atomic_uint64_fetch_add(&shard->sum_ns, duration_ns,
+                              VKR_MEMORY_ORDER_RELAXED);
+  // Extremes only move outward, so the CAS loops exit after the first load in
+  // the common case and contend only with the thread sharing this shard.
+  uint64_t min_ns =
+      vkr_atomic_uint64_load(&shard->min_ns, VKR_MEMORY_ORDER_RELAXED);
+  while (duration_ns < min_ns &&
+         !vkr_atomic_uint64_compare_exchange(&shard->min_ns, &min_ns,
+                                             duration_ns,
+                                             VKR_MEMORY_ORDER_RELAXED,
+                                             VKR_MEMORY_ORDER_RELAXED)) {
+  }
+  uint64_t max_ns =
+      vkr_atomic_uint64_load(&shard->max_ns, VKR_MEMORY_ORDER_RELAXED);
+  while (duration_ns > max_ns &&
+         !vkr_atomic_uint64_compare_exchange(&shard->max_ns, &max_ns,
+                                             duration_ns,
+                                             VKR_MEMORY_ORDER_RELAXED,
+                                             VKR_MEMORY_ORDER_RELAXED)) {
+  }
+}
+
+/**
+ * Differences every shard of a concurrent histogram into the active row and
+ * sample. Counts written while this runs land in this interval or the next,
+ * never both, because each bucket's baseline is the value actually read.
+ */
+vkr_internal void
+vkr_metrics_collect_histogram_shards(VkrMetricHistogramState *state,
+                                     VkrMetricHistogramCounts *counts,
+                                     VkrMetricSample *sample) {
+  VkrMetricHistogramSample *aggregate = &sample->value.histogram;
+  uint64_t min_ns = UINT64_MAX;
+  for (uint32_t s = 0; s < VKR_METRIC_HISTOGRAM_SHARD_COUNT; ++s) {
+    VkrMetricHistogramShard *shard = &state->shards[s];
+    uint32_t *previous = state->previous_counts[s];
+    for (uint32_t b = 0; b < VKR_METRIC_HISTOGRAM_BUCKET_COUNT; ++b) {
+      const uint32_t current =
+          vkr_atomic_uint32_load(&shard->counts[b], VKR_MEMORY_ORDER_RELAXED);
+      const uint32_t delta = current - previous[b];
+      counts->counts[b] += delta;
+      aggregate->count += delta;
+      previous[b] = current;
+    }
+    const uint64_t sum_ns =
+        vkr_atomic_uint64_load(&shard->sum_ns, VKR_MEMORY_ORDER_ACQUIRE);
+    aggregate->sum_ns += sum_ns - state->previous_sum_ns[s];
+    state->previous_sum_ns[s] = sum_ns;
+    const uint64_t shard_min_ns = vkr_atomic_uint64_exchange(
+        &shard->min_ns, UINT64_MAX, VKR_MEMORY_ORDER_RELAXED);
+    const uint64_t shard_max_ns =
+        vkr_atomic_uint64_exchange(&shard->max_ns, 0u, VKR_MEMORY_ORDER_RELAXED);
+    min_ns = Min(min_ns, shard_min_ns);
+    aggregate->max_ns = Max(aggregate->max_ns, shard_max_ns);
+  }
+  aggregate->min_ns = aggregate->count > 0 ? min_ns : 0u;
+  if (aggregate->count == 0) {
+    aggregate->max_ns = 0;
+  }
+  sample->availability = VKR_METRIC_AVAILABILITY_VALID;
+  sample->reason = VKR_METRIC_REASON_NONE;
+}
+
+/**
+ * Closes the frame's histogram interval: gathers concurrent shards into the
+ * active rows and folds every row into its decayed window. This runs whether
+ * or not the frame is published, so a dropped publication still shapes the
+ * window instead of vanishing from it.
+ */
+vkr_internal void vkr_metrics_fold_histograms(VkrMetrics *metrics) {
+  for (uint32_t h = 0; h < metrics->histogram_count; ++h) {
+    VkrMetricHistogramState *state = &metrics->histograms[h];
+    const uint32_t index = vkr_metric_id_index(state->id);
+    VkrMetricHistogramCounts *counts = &metrics->active_histograms[h];
+    VkrMetricSample *sample = &metrics->active[index];
+    if (metrics->catalog[index].writer == VKR_METRIC_WRITER_CONCURRENT) {
+      vkr_metrics_collect_histogram_shards(state, counts, sample);
+    }
+
+    VkrMetricHistogramWindow *window = &state->window;
+    const float32_t decay = state->decay;
+    for (uint32_t b = 0; b < VKR_METRIC_HISTOGRAM_BUCKET_COUNT; ++b) {
+      window->counts[b] =
+          window->counts[b] * decay + (float32_t)counts->counts[b];
+    }
+    window->total = window->total * (float64_t)decay +
+                    (float64_t)sample->value.histogram.count;
+  }
+}
+
 vkr_internal bool8_t vkr_metrics_claim_publish_buffer(VkrMetrics *metrics,
                                                       uint32_t *out_index) {
   const uint32_t current = vkr_atomic_uint32_load(&metrics->published_index,
@@ -216,6 +371,8 @@ bool8_t vkr_metrics_end_frame(VkrMetrics *metrics) {
   assert(metrics != NULL && metrics->sealed && metrics->frame_active);
   assert(metrics->render_thread_id == vkr_thread_current_id());
 
+  vkr_metrics_fold_histograms(metrics);
+
   uint32_t target_index = 0;
   if (!vkr_metrics_claim_publish_buffer(metrics, &target_index)) {
     vkr_metrics_discard_concurrent_interval(metrics);
@@ -237,8 +394,14 @@ bool8_t vkr_metrics_end_frame(VkrMetrics *metrics) {
   frame->event_subjects_truncated = vkr_atomic_uint64_load(
       &metrics->event_subjects_truncated, VKR_MEMORY_ORDER_ACQUIRE);
   frame->slot_count = metrics->slot_count;
+  frame->histogram_count = metrics->histogram_count;
   MemCopy(frame->samples, metrics->active,
           sizeof(VkrMetricSample) * metrics->slot_count);
+  MemCopy(frame->histograms, metrics->active_histograms,
+          sizeof(VkrMetricHistogramCounts) * metrics->histogram_count);
+  for (uint32_t h = 0; h < metrics->histogram_count; ++h) {
+    frame->histogram_windows[h] = metrics->histograms[h].window;
+  }
   vkr_metrics_collect_concurrent(metrics, frame);
 
   vkr_atomic_uint32_store(&metrics->published_index, target_index,
@@ -248,6 +411,15 @@ bool8_t vkr_metrics_end_frame(VkrMetrics *metrics) {
   vkr_atomic_uint32_store(&metrics->snapshot_owners[target_index], 0,
                           VKR_MEMORY_ORDER_RELEASE);
   metrics->frame_active = false_v;
+
+  // The published buffer may now be pinned by readers but never rewritten
+  // until the next end_frame, which runs on this thread.
+  if (metrics->config.histogram_export_interval > 0 &&
+      metrics->histogram_count > 0 &&
+      frame->publication_serial % metrics->config.histogram_export_interval ==
+          0) {
+    vkr_metrics_histograms_export(metrics, frame);
+  }
   return true_v;
 }
 #endif
@@ -495,7 +667,8 @@ bool8_t vkr_metrics_frame_read_u64(const VkrMetricsFrame *frame, VkrMetricId id,
   if (!out_value || !sample ||
       sample->availability == VKR_METRIC_AVAILABILITY_UNAVAILABLE ||
       sample->scalar != VKR_METRIC_SCALAR_U64 ||
-      sample->kind == VKR_METRIC_KIND_DURATION) {
+      sample->kind == VKR_METRIC_KIND_DURATION ||
+      sample->kind == VKR_METRIC_KIND_HISTOGRAM) {
     return false_v;
   }
   *out_value = sample->value.u64;
@@ -525,6 +698,164 @@ bool8_t vkr_metrics_frame_read_duration(const VkrMetricsFrame *frame,
   return true_v;
 }
 
+bool8_t vkr_metrics_frame_read_histogram(const VkrMetricsFrame *frame,
+                                         VkrMetricId id,
+                                         VkrMetricHistogramSample *out_sample) {
+  const VkrMetricSample *sample =
+      vkr_metrics_frame_readable(frame, id, VKR_METRIC_KIND_HISTOGRAM);
+  if (!out_sample || !sample) {
+    return false_v;
+  }
+  *out_sample = sample->value.histogram;
+  return true_v;
+}
+
+/**
+ * Walks one distribution once for several ascending percentiles. Ranks are
+ * 1-based like HdrHistogram: p50 of {1, 2} is 1, and p100 is the last value.
+ */
+vkr_internal bool8_t vkr_metrics_histogram_values_at(
+    const VkrMetricsFrame *frame, VkrMetricId id,
+    VkrMetricHistogramRange range, const float64_t *percentiles,
+    uint32_t percentile_count, uint64_t *out_values) {
+  const VkrMetricSample *sample = vkr_metrics_frame_get(frame, id);
+  if (!sample || sample->kind != VKR_METRIC_KIND_HISTOGRAM ||
+      sample->value.histogram.histogram_index >= frame->histogram_count) {
+    return false_v;
+  }
+  const uint32_t histogram = sample->value.histogram.histogram_index;
+  const VkrMetricHistogramCounts *counts = &frame->histograms[histogram];
+  const VkrMetricHistogramWindow *window = &frame->histogram_windows[histogram];
+  const bool8_t windowed = range == VKR_METRIC_HISTOGRAM_RANGE_WINDOW;
+  float64_t total = 0.0;
+  if (windowed) {
+    total = window->total;
+  } else if (sample->availability != VKR_METRIC_AVAILABILITY_UNAVAILABLE) {
+    total = (float64_t)sample->value.histogram.count;
+  }
+  if (total <= 0.0) {
+    return false_v;
+  }
+
+  uint32_t bucket = 0;
+  float64_t cumulative = 0.0;
+  for (uint32_t i = 0; i < percentile_count; ++i) {
+    const float64_t percentile = Clamp(percentiles[i], 0.0, 100.0);
+    float64_t rank = percentile / 100.0 * total;
+    if (!windowed) {
+      const uint64_t whole = (uint64_t)rank;
+      rank = Max(1.0, (float64_t)whole < rank ? (float64_t)(whole + 1u)
+                                               : (float64_t)whole);
+    }
+    // The window is a float sum, so a rank equal to the total may sit a
+    // rounding error past the last bucket; stop on the last nonempty one.
+    while (bucket < VKR_METRIC_HISTOGRAM_BUCKET_COUNT) {
+      const float64_t count = windowed ? (float64_t)window->counts[bucket]
+                                       : (float64_t)counts->counts[bucket];
+      if (count > 0.0 && cumulative + count >= rank) {
+        break;
+      }
+      cumulative += count;
+      bucket++;
+    }
+    if (bucket == VKR_METRIC_HISTOGRAM_BUCKET_COUNT) {
+      bucket = VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u;
+      while (bucket > 0 && (windowed ? window->counts[bucket] <= 0.0f
+                                     : counts->counts[bucket] == 0)) {
+        bucket--;
+      }
+      cumulative = total;
+    }
+    uint64_t value = vkr_metric_histogram_bucket_highest(bucket);
+    if (!windowed) {
+      value = Clamp(value, sample->value.histogram.min_ns,
+                    sample->value.histogram.max_ns);
+    } else if (bucket == VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u) {
+      value = vkr_metric_histogram_bucket_lowest(bucket);
+    }
+    out_values[i] = value;
+  }
+  return true_v;
+}
+
+bool8_t vkr_metrics_frame_read_percentile_ns(const VkrMetricsFrame *frame,
+                                             VkrMetricId id,
+                                             VkrMetricHistogramRange range,
+                                             float64_t percentile,
+                                             uint64_t *out_value_ns) {
+  if (!out_value_ns) {
+    return false_v;
+  }
+  return vkr_metrics_histogram_values_at(frame, id, range, &percentile, 1u,
+                                         out_value_ns);
+}
+
+bool8_t vkr_metrics_frame_read_percentiles(const VkrMetricsFrame *frame,
+                                           VkrMetricId id,
+                                           VkrMetricHistogramRange range,
+                                           VkrMetricPercentiles *out) {
+  const float64_t percentiles[4] = {50.0, 90.0, 99.0, 99.9};
+  uint64_t values[4] = {0};
+  if (!out || !vkr_metrics_histogram_values_at(frame, id, range, percentiles,
+                                               ArrayCount(percentiles),
+                                               values)) {
+    return false_v;
+  }
+  *out = (VkrMetricPercentiles){
+      .p50_ns = values[0],
+      .p90_ns = values[1],
+      .p99_ns = values[2],
+      .p999_ns = values[3],
+  };
+  return true_v;
+}
+
+bool8_t vkr_metrics_histograms_export(VkrMetrics *metrics,
+                                      const VkrMetricsFrame *frame) {
+  if (!metrics || !frame ||
+      frame->registry_generation != metrics->registry_generation) {
+    return false_v;
+  }
+  enum { PERCENTILE_COUNT = ArrayCount(s_vkr_metrics_export_percentiles) };
+  float64_t percentiles[PERCENTILE_COUNT];
+  for (uint32_t i = 0; i < PERCENTILE_COUNT; ++i) {
+    percentiles[i] =
+        (float64_t)s_vkr_metrics_export_percentiles[i].basis_points / 100.0;
+  }
+
+  bool8_t success = true_v;
+  const uint32_t count = Min(frame->histogram_count, metrics->histogram_count);
+  for (uint32_t h = 0; h < count; ++h) {
+    const VkrMetricId id = metrics->histograms[h].id;
+    uint64_t values[PERCENTILE_COUNT] = {0};
+    if (!vkr_metrics_histogram_values_at(frame, id,
+                                         VKR_METRIC_HISTOGRAM_RANGE_WINDOW,
+                                         percentiles, PERCENTILE_COUNT,
+                                         values)) {
+      continue;
+    }
+    const uint64_t window_count =
+        (uint64_t)(frame->histogram_windows[h].total + 0.5);
+    for (uint32_t i = 0; i < PERCENTILE_COUNT; ++i) {
+      const char *subject = s_vkr_metrics_export_percentiles[i].subject;
+      const VkrMetricEvent event = {
+          .source = id,
+          .duration_ns = values[i],
+          .bytes = window_count,
+          .status = VKR_METRIC_EVENT_STATUS_SUCCESS,
+          .percentile_bp = s_vkr_metrics_export_percentiles[i].basis_points,
+      };
+      if (!vkr_metrics_event_push(
+              metrics, &event,
+              string8_create_from_cstr((const uint8_t *)subject,
+                                       string_length(subject)))) {
+        success = false_v;
+      }
+    }
+  }
+  return success;
+}
+
 bool8_t vkr_metrics_frame_read_duration_mean_ns(const VkrMetricsFrame *frame,
                                                 VkrMetricId id,
                                                 uint64_t *out_mean_ns) {
@@ -27,6 +27,27 @@
 #define VKR_METRIC_EVENT_SUBJECT_MAX 95u
 #define VKR_METRIC_ID_INVALID UINT32_MAX
 
+/**
+ * Histogram geometry. Buckets are log-linear in the style of HdrHistogram:
+ * values below 2^SUB_BUCKET_BITS get one bucket each, and every power of two
+ * above that is split into SUB_BUCKET_COUNT equal buckets, so a bucket is
+ * never wider than 1/32 (about 3%) of the values it holds. Values at or above
+ * 2^(MAX_EXPONENT + 1) nanoseconds (about 68 s) share the last bucket; the
+ * exact maximum is still carried by the sample.
+ */
+#define VKR_METRICS_MAX_HISTOGRAMS 8u
+#define VKR_METRIC_HISTOGRAM_SUB_BUCKET_BITS 5u
+#define VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT                                  \
+  (1u << VKR_METRIC_HISTOGRAM_SUB_BUCKET_BITS)
+#define VKR_METRIC_HISTOGRAM_MAX_EXPONENT 35u
+#define VKR_METRIC_HISTOGRAM_BUCKET_COUNT                                      \
+  ((VKR_METRIC_HISTOGRAM_MAX_EXPONENT -                                        \
+    VKR_METRIC_HISTOGRAM_SUB_BUCKET_BITS + 2u) *                               \
+   VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT)
+/** Concurrent writers are spread over this many independently counted rows. */
+#define VKR_METRIC_HISTOGRAM_SHARD_COUNT 4u
+#define VKR_METRIC_HISTOGRAM_DEFAULT_HALF_LIFE_FRAMES 120u
+
 /**
  * Stable metric handle: low 16 bits are the slot, high 16 bits are the
  * registry generation. The generation catches handles retained across a
@@ -39,6 +60,9 @@ typedef enum VkrMetricKind {
                                differenced. */
   VKR_METRIC_KIND_GAUGE,    /**< Instantaneous u64 or f64. */
   VKR_METRIC_KIND_DURATION, /**< Integer nanoseconds; sum/count/min/max. */
+  VKR_METRIC_KIND_HISTOGRAM, /**< Integer nanoseconds; duration aggregate plus
+                                a log-linear distribution and its decayed
+                                window. */
 } VkrMetricKind;
 
 typedef enum VkrMetricDomain {
@@ -115,6 +139,12 @@ typedef struct VkrMetricDescription {
    * vkr_metrics_frame_missing_required().
    */
   bool8_t required_when_enabled;
+  /**
+   * Histogram kind only: frames after which a recorded value carries half
+   * its weight in the windowed distribution. Zero selects
+   * VKR_METRIC_HISTOGRAM_DEFAULT_HALF_LIFE_FRAMES.
+   */
+  uint16_t histogram_half_life_frames;
 } VkrMetricDescription;
 
 typedef struct VkrMetricCatalogEntry {
@@ -126,6 +156,7 @@ typedef struct VkrMetricCatalogEntry {
   VkrMetricScalar scalar;
   VkrMetricWriter writer;
   bool8_t required_when_enabled;
+  uint8_t histogram_index; /**< Row in the histogram pool; histogram kind. */
 } VkrMetricCatalogEntry;
 
 typedef struct VkrMetricDurationSample {
@@ -135,6 +166,49 @@ typedef struct VkrMetricDurationSample {
   uint64_t max_ns;
 } VkrMetricDurationSample;
 
+/**
+ * @brief Per-frame aggregate of a histogram slot.
+ *
+ * The bucket counts live beside the samples in VkrMetricsFrame; the index
+ * names that row so a reader holding only the frame can find them.
+ */
+typedef struct VkrMetricHistogramSample {
+  uint64_t sum_ns;
+  uint64_t min_ns;
+  uint64_t max_ns;
+  uint32_t count;
+  uint32_t histogram_index;
+} VkrMetricHistogramSample;
+
+typedef struct VkrMetricHistogramCounts {
+  uint32_t counts[VKR_METRIC_HISTOGRAM_BUCKET_COUNT];
+} VkrMetricHistogramCounts;
+
+/**
+ * @brief Exponentially decayed distribution over recent frames.
+ *
+ * Each frame scales every bucket by the slot's decay factor before adding
+ * that frame's counts, so `total` approaches rate * half-life / ln 2 for a
+ * steady producer and old outliers fade instead of pinning p99 forever.
+ */
+typedef struct VkrMetricHistogramWindow {
+  float32_t counts[VKR_METRIC_HISTOGRAM_BUCKET_COUNT];
+  float64_t total;
+} VkrMetricHistogramWindow;
+
+/** Which distribution a percentile query reads. */
+typedef enum VkrMetricHistogramRange {
+  VKR_METRIC_HISTOGRAM_RANGE_FRAME,  /**< Only the published frame. */
+  VKR_METRIC_HISTOGRAM_RANGE_WINDOW, /**< The decayed multi-frame window. */
+} VkrMetricHistogramRange;
+
+typedef struct VkrMetricPercentiles {
+  uint64_t p50_ns;
+  uint64_t p90_ns;
+  uint64_t p99_ns;
+  uint64_t p999_ns;
+} VkrMetricPercentiles;
+
 /**
  * @brief One slot's published value for one frame.
  *
@@ -147,6 +221,7 @@ typedef struct VkrMetricSample {
     uint64_t u64;
     float64_t f64;
     VkrMetricDurationSample duration;
+    VkrMetricHistogramSample histogram;
   } value;
   VkrMetricAvailability availability;
   VkrMetricReason reason;
@@ -163,7 +238,10 @@ typedef struct VkrMetricsFrame {
   uint64_t events_dropped;
   uint64_t event_subjects_truncated;
   uint32_t slot_count;
+  uint32_t histogram_count;
   VkrMetricSample samples[VKR_METRICS_MAX_SLOTS];
+  VkrMetricHistogramCounts histograms[VKR_METRICS_MAX_HISTOGRAMS];
+  VkrMetricHistogramWindow histogram_windows[VKR_METRICS_MAX_HISTOGRAMS];
 } VkrMetricsFrame;
 
 typedef struct VkrMetricsSnapshotView {
@@ -172,6 +250,15 @@ typedef struct VkrMetricsSnapshotView {
   uint64_t publication_serial;
 } VkrMetricsSnapshotView;
 
+/**
+ * @brief One bounded event.
+ *
+ * Operation events describe a single load or build. Percentile events are
+ * exported from a histogram slot: `percentile_bp` names the percentile in
+ * basis points (9990 is p99.9), `duration_ns` carries the windowed value and
+ * `bytes` the rounded number of samples in the window. Operation events leave
+ * `percentile_bp` zero.
+ */
 typedef struct VkrMetricEvent {
   VkrMetricId source;
   uint8_t subject_length;
@@ -181,6 +268,7 @@ typedef struct VkrMetricEvent {
   uint64_t bytes;
   uint32_t thread_id;
   VkrMetricEventStatus status;
+  uint16_t percentile_bp;
   bool8_t subject_truncated;
 } VkrMetricEvent;
 
@@ -202,6 +290,31 @@ typedef struct VkrMetricConcurrentSlot {
   uint64_t previous_aux;
 } VkrMetricConcurrentSlot;
 
+/**
+ * @brief One concurrent writer row of a histogram.
+ *
+ * Bucket counts and the sum are cumulative and differenced at end_frame, the
+ * same way concurrent counters are; a uint32 bucket only has to not wrap
+ * twice within one frame. min/max are exchanged back to their identities
+ * when collected.
+ */
+typedef struct VkrMetricHistogramShard {
+  VkrAtomicUint32 counts[VKR_METRIC_HISTOGRAM_BUCKET_COUNT];
+  VkrAtomicUint64 sum_ns;
+  VkrAtomicUint64 min_ns;
+  VkrAtomicUint64 max_ns;
+} VkrMetricHistogramShard;
+
+typedef struct VkrMetricHistogramState {
+  VkrMetricHistogramShard shards[VKR_METRIC_HISTOGRAM_SHARD_COUNT];
+  uint32_t previous_counts[VKR_METRIC_HISTOGRAM_SHARD_COUNT]
+                         [VKR_METRIC_HISTOGRAM_BUCKET_COUNT];
+  uint64_t previous_sum_ns[VKR_METRIC_HISTOGRAM_SHARD_COUNT];
+  VkrMetricId id;
+  float32_t decay;
+  VkrMetricHistogramWindow window;
+} VkrMetricHistogramState;
+
 typedef struct VkrMetricEventSlot {
   VkrAtomicUint64 sequence;
   VkrMetricEvent event;
@@ -218,12 +331,20 @@ typedef struct VkrMetricEventSlot {
 typedef struct VkrMetricsConfig {
   bool8_t pass_gpu_timings;
   bool8_t event_subjects;
+  /**
+   * Publications between percentile exports of every histogram into the
+   * event ring; zero disables export. Export only adds events, it never
+   * changes what a histogram records.
+   */
+  uint32_t histogram_export_interval;
 } VkrMetricsConfig;
 
 typedef struct VkrMetrics {
   VkrMetricCatalogEntry catalog[VKR_METRICS_MAX_SLOTS];
   VkrMetricSample active[VKR_METRICS_MAX_SLOTS];
   VkrMetricConcurrentSlot concurrent[VKR_METRICS_MAX_SLOTS];
+  VkrMetricHistogramCounts active_histograms[VKR_METRICS_MAX_HISTOGRAMS];
+  VkrMetricHistogramState histograms[VKR_METRICS_MAX_HISTOGRAMS];
   VkrMetricsFrame published[VKR_METRICS_SNAPSHOT_BUFFER_COUNT];
   VkrAtomicUint32 snapshot_owners[VKR_METRICS_SNAPSHOT_BUFFER_COUNT];
   VkrAtomicUint32 published_index;
@@ -240,6 +361,7 @@ typedef struct VkrMetrics {
   uint64_t active_cpu_frame_index;
   uint64_t active_submit_serial;
   uint32_t slot_count;
+  uint32_t histogram_count;
   uint16_t registry_generation;
   VkrThreadId render_thread_id;
   VkrMetricsConfig config;
@@ -255,6 +377,47 @@ static INLINE uint16_t vkr_metric_id_generation(VkrMetricId id) {
   return (uint16_t)(id >> 16u);
 }
 
+/** Bucket holding `value`; exact below SUB_BUCKET_COUNT, log-linear above. */
+static INLINE uint32_t vkr_metric_histogram_bucket(uint64_t value) {
+  if (value < VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT) {
+    return (uint32_t)value;
+  }
+  if ((value >> (VKR_METRIC_HISTOGRAM_MAX_EXPONENT + 1u)) != 0) {
+    return VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u;
+  }
+  const uint32_t high = (uint32_t)(value >> 32u);
+  const uint32_t exponent =
+      high != 0 ? 63u - (uint32_t)VkrCountLeadingZeros32(high)
+                : 31u - (uint32_t)VkrCountLeadingZeros32((uint32_t)value);
+  const uint32_t shift = exponent - VKR_METRIC_HISTOGRAM_SUB_BUCKET_BITS;
+  return (shift + 1u) * VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT +
+         (uint32_t)(value >> shift) - VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+}
+
+/** Smallest value that maps to `bucket`. */
+static INLINE uint64_t vkr_metric_histogram_bucket_lowest(uint32_t bucket) {
+  if (bucket < VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT) {
+    return bucket;
+  }
+  const uint32_t block = bucket / VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+  const uint64_t mantissa = VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT +
+                            bucket % VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+  return mantissa << (block - 1u);
+}
+
+/** Largest value that maps to `bucket` (the last bucket is open-ended). */
+static INLINE uint64_t vkr_metric_histogram_bucket_highest(uint32_t bucket) {
+  if (bucket < VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT) {
+    return bucket;
+  }
+  if (bucket >= VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u) {
+    return UINT64_MAX;
+  }
+  const uint32_t block = bucket / VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+  return vkr_metric_histogram_bucket_lowest(bucket) + (1ull << (block - 1u)) -
+         1u;
+}
+
 void vkr_metrics_init(VkrMetrics *metrics);
 bool8_t vkr_metrics_register(VkrMetrics *metrics,
                              const VkrMetricDescription *description,
@@ -356,6 +519,44 @@ static INLINE void vkr_metrics_duration_add_ns(VkrMetrics *metrics,
   metrics->active[index].reason = VKR_METRIC_REASON_NONE;
 }
 
+/** Lock-free shard write used by concurrent histogram slots. */
+void vkr_metrics_histogram_record_concurrent(VkrMetrics *metrics,
+                                             uint32_t index,
+                                             uint64_t duration_ns);
+
+/**
+ * @brief Records one value into a histogram slot.
+ *
+ * Render-thread slots write plain memory. Concurrent slots write one of
+ * VKR_METRIC_HISTOGRAM_SHARD_COUNT atomic rows, chosen once per thread, so
+ * writers on different threads rarely share a cache line and never take a
+ * lock.
+ */
+static INLINE void vkr_metrics_histogram_record_ns(VkrMetrics *metrics,
+                                                   VkrMetricId id,
+                                                   uint64_t duration_ns) {
+  const uint32_t index = vkr_metrics_writer_slot(
+      metrics, id, VKR_METRIC_KIND_HISTOGRAM, VKR_METRIC_SCALAR_U64);
+  if (metrics->catalog[index].writer == VKR_METRIC_WRITER_CONCURRENT) {
+    vkr_metrics_histogram_record_concurrent(metrics, index, duration_ns);
+    return;
+  }
+
+  VkrMetricHistogramSample *sample = &metrics->active[index].value.histogram;
+  metrics->active_histograms[sample->histogram_index]
+      .counts[vkr_metric_histogram_bucket(duration_ns)]++;
+  sample->sum_ns += duration_ns;
+  sample->count++;
+  if (sample->count == 1u || duration_ns < sample->min_ns) {
+    sample->min_ns = duration_ns;
+  }
+  if (duration_ns > sample->max_ns) {
+    sample->max_ns = duration_ns;
+  }
+  metrics->active[index].availability = VKR_METRIC_AVAILABILITY_VALID;
+  metrics->active[index].reason = VKR_METRIC_REASON_NONE;
+}
+
 static INLINE void vkr_metrics_mark(VkrMetrics *metrics, VkrMetricId id,
                                     VkrMetricAvailability availability,
                                     VkrMetricReason reason) {
@@ -390,6 +591,7 @@ bool8_t vkr_metrics_event_record(VkrMetricEventProducer producer,
 #define vkr_metrics_gauge_set_u64(metrics, id, value) ((void)0)
 #define vkr_metrics_gauge_set_f64(metrics, id, value) ((void)0)
 #define vkr_metrics_duration_add_ns(metrics, id, duration_ns) ((void)0)
+#define vkr_metrics_histogram_record_ns(metrics, id, duration_ns) ((void)0)
 #define vkr_metrics_mark(metrics, id, availability, reason) ((void)0)
 #define vkr_metrics_event_record(producer, subject, start_ns, duration_ns,     \
                                  bytes, status)                                \
@@ -432,9 +634,15 @@ static INLINE uint64_t vkr_metrics_elapsed_ns(float64_t start_seconds) {
 #define VKR_METRICS_ADD_ELAPSED_NS(metrics, id, start_seconds)                 \
   vkr_metrics_duration_add_ns((metrics), (id),                                 \
                               vkr_metrics_elapsed_ns((start_seconds)))
+
+#define VKR_METRICS_HISTOGRAM_ADD_ELAPSED_NS(metrics, id, start_seconds)       \
+  vkr_metrics_histogram_record_ns((metrics), (id),                             \
+                                  vkr_metrics_elapsed_ns((start_seconds)))
 #else
 #define VKR_METRICS_SCOPE_NS(metrics, id)
 #define VKR_METRICS_ADD_ELAPSED_NS(metrics, id, start_seconds) ((void)0)
+#define VKR_METRICS_HISTOGRAM_ADD_ELAPSED_NS(metrics, id, start_seconds)       \
+  ((void)0)
 #endif
 
 bool8_t vkr_metrics_snapshot_acquire(VkrMetrics *metrics,
@@ -472,6 +680,40 @@ bool8_t vkr_metrics_frame_read_duration(const VkrMetricsFrame *frame,
 bool8_t vkr_metrics_frame_read_duration_mean_ns(const VkrMetricsFrame *frame,
                                                 VkrMetricId id,
                                                 uint64_t *out_mean_ns);
+bool8_t vkr_metrics_frame_read_histogram(const VkrMetricsFrame *frame,
+                                         VkrMetricId id,
+                                         VkrMetricHistogramSample *out_sample);
+
+/**
+ * @brief Value at `percentile` (0..100) of a histogram slot.
+ *
+ * Returns the highest value equivalent to the bucket holding that rank, so a
+ * reported latency is never below the true one by more than a bucket width.
+ * The frame range is additionally clamped to the frame's exact min/max. The
+ * window range stays readable while the current frame is unsampled; both
+ * return false for an empty distribution.
+ */
+bool8_t vkr_metrics_frame_read_percentile_ns(const VkrMetricsFrame *frame,
+                                             VkrMetricId id,
+                                             VkrMetricHistogramRange range,
+                                             float64_t percentile,
+                                             uint64_t *out_value_ns);
+/** p50, p90, p99 and p99.9 in one pass over the buckets. */
+bool8_t vkr_metrics_frame_read_percentiles(const VkrMetricsFrame *frame,
+                                           VkrMetricId id,
+                                           VkrMetricHistogramRange range,
+                                           VkrMetricPercentiles *out);
+
+/**
+ * @brief Pushes the windowed p50/p90/p99/p99.9 of every histogram slot in
+ * `frame` into the event ring.
+ *
+ * end_frame calls this every `histogram_export_interval` publications; a
+ * consumer may also call it for a pinned snapshot. Returns false when any
+ * event was dropped because the ring was full.
+ */
+bool8_t vkr_metrics_histograms_export(VkrMetrics *metrics,
+                                      const VkrMetricsFrame *frame);
 
 /**
  * @brief Counts required slots the frame did not carry.
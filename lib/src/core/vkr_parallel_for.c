@@ -0,0 +1,133 @@
+#include "core/vkr_parallel_for.h"
+
+typedef struct VkrParallelForJob {
+  VkrParallelFor *dispatch;
+} VkrParallelForJob;
+
+vkr_internal INLINE uint64_t vkr_parallel_for_cursor(uint32_t chunk_count,
+                                                     uint32_t next_chunk) {
+  return ((uint64_t)chunk_count << 32) | next_chunk;
+}
+
+/** Claims the next chunk of the running dispatch, if one is left. */
+vkr_internal bool8_t vkr_parallel_for_claim(VkrParallelFor *dispatch,
+                                            uint32_t *out_chunk) {
+  uint64_t cursor =
+      vkr_atomic_uint64_load(&dispatch->cursor, VKR_MEMORY_ORDER_ACQUIRE);
+  for (;;) {
+    const uint32_t chunk_count = (uint32_t)(cursor >> 32);
+    const uint32_t next_chunk = (uint32_t)cursor;
+    if (next_chunk >= chunk_count)
+      return false_v;
+    if (vkr_atomic_uint64_compare_exchange(
+            &dispatch->cursor, &cursor,
+            vkr_parallel_for_cursor(chunk_count, next_chunk + 1u),
+            VKR_MEMORY_ORDER_ACQUIRE, VKR_MEMORY_ORDER_ACQUIRE)) {
+      *out_chunk = next_chunk;
+      return true_v;
+    }
+  }
+}
+
+/** Runs claimed chunks until none is left; returns how many it ran. */
+vkr_internal uint32_t vkr_parallel_for_drain(VkrParallelFor *dispatch) {
+  uint32_t ran = 0u;
+  uint32_t chunk = 0u;
+  while (vkr_parallel_for_claim(dispatch, &chunk)) {
+    const uint32_t first = chunk * dispatch->chunk_size;
+    dispatch->fn(dispatch->context, chunk, first,
+                 Min(dispatch->chunk_size, dispatch->item_count - first));
+    vkr_atomic_uint32_fetch_add(&dispatch->chunks_done, 1u,
+                                VKR_MEMORY_ORDER_RELEASE);
+    ran++;
+  }
+  return ran;
+}
+
+vkr_internal bool8_t vkr_parallel_for_job_run(VkrJobContext *ctx,
+                                              void *payload) {
+  (void)ctx;
+  VkrParallelFor *dispatch = ((VkrParallelForJob *)payload)->dispatch;
+  vkr_parallel_for_drain(dispatch);
+  vkr_atomic_uint32_fetch_sub(&dispatch->helpers_pending, 1u,
+                              VKR_MEMORY_ORDER_RELEASE);
+  return true_v;
+}
+
+void vkr_parallel_for_init(VkrParallelFor *dispatch, VkrJobSystem *job_system) {
+  MemZero(dispatch, sizeof(*dispatch));
+  dispatch->job_system = job_system;
+}
+
+uint32_t vkr_parallel_for_chunk_count(uint32_t item_count,
+                                      uint32_t chunk_size) {
+  if (!chunk_size)
+    return 0u;
+  return (uint32_t)(((uint64_t)item_count + chunk_size - 1u) / chunk_size);
+}
+
+VkrParallelForStats vkr_parallel_for_run(VkrParallelFor *dispatch,
+                                         uint32_t item_count,
+                                         uint32_t chunk_size,
+                                         VkrParallelForFn fn, void *context) {
+  VkrParallelForStats stats = {
+      .chunks = vkr_parallel_for_chunk_count(item_count, chunk_size),
+  };
+  if (!stats.chunks)
+    return stats;
+
+  dispatch->fn = fn;
+  dispatch->context = context;
+  dispatch->item_count = item_count;
+  dispatch->chunk_size = chunk_size;
+  vkr_atomic_uint32_store(&dispatch->chunks_done, 0u,
+                          VKR_MEMORY_ORDER_RELAXED);
+  vkr_atomic_uint64_store(&dispatch->cursor,
+                          vkr_parallel_for_cursor(stats.chunks, 0u),
+                          VKR_MEMORY_ORDER_RELEASE);
+
+  // The caller runs one chunk itself, so at most chunks - 1 helpers are
+  // useful; helpers still queued from earlier dispatches count against that.
+  VkrJobSystem *job_system = dispatch->job_system;
+  const uint32_t pending = vkr_atomic_uint32_load(&dispatch->helpers_pending,
+                                                  VKR_MEMORY_ORDER_ACQUIRE);
+  const uint32_t wanted =
+      job_system ? Min(job_system->worker_count, stats.chunks - 1u) : 0u;
+  if (wanted > pending) {
+    Bitset8 type_mask = bitset8_create();
+    bitset8_set(&type_mask, VKR_JOB_TYPE_GENERAL);
+    const VkrParallelForJob job = {.dispatch = dispatch};
+    const VkrJobDesc desc = {
+        .priority = VKR_JOB_PRIORITY_HIGH,
+        .type_mask = type_mask,
+        .run = vkr_parallel_for_job_run,
+        .payload = &job,
+        .payload_size = sizeof(job),
+    };
+    for (uint32_t i = pending; i < wanted; ++i) {
+      vkr_atomic_uint32_fetch_add(&dispatch->helpers_pending, 1u,
+                                  VKR_MEMORY_ORDER_RELAXED);
+      VkrJobHandle handle = {0};
+      if (!vkr_job_try_submit(job_system, &desc, &handle)) {
+        vkr_atomic_uint32_fetch_sub(&dispatch->helpers_pending, 1u,
+                                    VKR_MEMORY_ORDER_RELAXED);
+        break;
+      }
+      stats.helpers_submitted++;
+    }
+  }
+
+  stats.caller_chunks = vkr_parallel_for_drain(dispatch);
+  // Whatever is left was claimed by helpers and is bounded by one chunk each.
+  while (vkr_atomic_uint32_load(&dispatch->chunks_done,
+                                VKR_MEMORY_ORDER_ACQUIRE) < stats.chunks) {
+  }
+  return stats;
+}
+
+void vkr_parallel_for_wait_idle(VkrParallelFor *dispatch) {
+  while (vkr_atomic_uint32_load(&dispatch->helpers_pending,
+                                VKR_MEMORY_ORDER_ACQUIRE) > 0u) {
+    vkr_thread_sleep(0);
+  }
+}
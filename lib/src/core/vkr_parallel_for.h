@@ -0,0 +1,74 @@
+/**
+ * @file vkr_parallel_for.h
+ * @brief Runs a callback over the chunks of an index range on the job system
+ * and the calling thread.
+ *
+ * The caller always takes part: it claims chunks exactly like the helper jobs
+ * and afterwards waits only for chunks a helper has already claimed. A frame
+ * therefore never blocks behind asset loads that keep every worker busy; at
+ * worst it runs all chunks itself.
+ *
+ * Helper jobs are not waited on. One that starts after its dispatch returned
+ * finds no chunk left, or claims a chunk of whatever dispatch is running then,
+ * which is equally valid. Either way it only touches the dispatcher, so a
+ * dispatcher must outlive the job system it submits to, or be released only
+ * after vkr_parallel_for_wait_idle().
+ *
+ * Chunks are fixed ranges of `chunk_size` items and the callback receives the
+ * chunk index, so callers that write per-chunk results and merge them in chunk
+ * order get the same output however the chunks were scheduled.
+ */
+#pragma once
+
+#include "core/vkr_atomic.h"
+#include "core/vkr_job_system.h"
+#include "defines.h"
+
+/** Runs items [first, first + count) of chunk `chunk_index`. */
+typedef void (*VkrParallelForFn)(void *context, uint32_t chunk_index,
+                                 uint32_t first, uint32_t count);
+
+typedef struct VkrParallelFor {
+  /** NULL runs every chunk on the calling thread. */
+  VkrJobSystem *job_system;
+  /** Chunk count in the high half, next unclaimed chunk in the low half. */
+  VkrAtomicUint64 cursor;
+  VkrAtomicUint32 chunks_done;
+  /** Helper jobs submitted and not yet finished, across dispatches. */
+  VkrAtomicUint32 helpers_pending;
+  /* Written by the caller before the cursor is published and read by a helper
+     only after it claimed a chunk, which keeps the dispatch from returning. */
+  VkrParallelForFn fn;
+  void *context;
+  uint32_t item_count;
+  uint32_t chunk_size;
+} VkrParallelFor;
+
+/** Counters for the last dispatch. */
+typedef struct VkrParallelForStats {
+  uint32_t chunks;
+  /** Chunks the calling thread ran itself. */
+  uint32_t caller_chunks;
+  uint32_t helpers_submitted;
+} VkrParallelForStats;
+
+void vkr_parallel_for_init(VkrParallelFor *dispatch, VkrJobSystem *job_system);
+
+/** @return Chunks a range of `item_count` items splits into. */
+uint32_t vkr_parallel_for_chunk_count(uint32_t item_count, uint32_t chunk_size);
+
+/**
+ * @brief Runs `fn` once per chunk and returns when every chunk has run.
+ *
+ * Not reentrant: one dispatcher runs one range at a time, from one thread.
+ */
+VkrParallelForStats vkr_parallel_for_run(VkrParallelFor *dispatch,
+                                         uint32_t item_count,
+                                         uint32_t chunk_size,
+                                         VkrParallelForFn fn, void *context);
+
+/**
+ * @brief Blocks until every helper job the dispatcher submitted has finished,
+ * so its memory can be released. The job system must still be running.
+ */
+void vkr_parallel_for_wait_idle(VkrParallelFor *dispatch);
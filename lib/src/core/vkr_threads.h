@@ -109,6 +109,14 @@ VkrThreadId vkr_thread_get_id(VkrThread thread);
  */
 VkrThreadId vkr_thread_current_id(void);
 
+/**
+ * @brief Restricts the calling thread to a single logical core.
+ * @param logical_core Zero-based logical core index.
+ * @return true_v when the OS enforces the restriction, false_v when the core
+ * is out of range or the platform only treats affinity as a hint.
+ */
+bool32_t vkr_thread_pin_current(uint32_t logical_core);
+
 /**
  * @brief Waits for a thread to complete execution.
  * @param thread VkrThread to wait for.
@@ -0,0 +1,827 @@
+#include "core/vkr_trace.h"
+#include "core/logger.h"
+#include "core/vkr_threads.h"
+#include "platform/vkr_platform.h"
+
+#include <stdio.h>
+
+/** Every exported track lives in one synthetic process. */
+#define VKR_TRACE_PROCESS_ID 1u
+#define VKR_TRACE_PROCESS_TRACK_UUID 1u
+#define VKR_TRACE_THREAD_TRACK_UUID_BASE 0x100u
+#define VKR_TRACE_SEQUENCE_ID 1u
+/** Counter tracks given a descriptor once; later names re-describe. */
+#define VKR_TRACE_MAX_COUNTER_TRACKS 64u
+#define VKR_TRACE_PACKET_MAX 512u
+
+typedef struct VkrTraceState {
+  VkrAtomicBool active;
+  VkrAtomicUint32 generation;
+  VkrAtomicUint32 claimed_buffers;
+  /** Records lost because no buffer was left for the thread. */
+  VkrAtomicUint64 dropped_unclaimed;
+
+  VkrAllocator *allocator;
+  VkrTraceConfig config;
+  VkrTraceBuffer *buffers;
+  VkrTraceRecord *record_data;
+  uint64_t start_ns;
+  uint64_t stop_ns;
+} VkrTraceState;
+
+vkr_global VkrTraceState g_trace = {0};
+
+vkr_internal _Thread_local VkrTraceBuffer *t_trace_buffer = NULL;
+vkr_internal _Thread_local uint32_t t_trace_generation = 0;
+
+vkr_internal INLINE uint64_t trace_now_ns(void) {
+  return (uint64_t)(vkr_platform_get_absolute_time() * 1000000000.0);
+}
+
+vkr_internal uint32_t trace_claimed_buffer_count(void) {
+  const uint32_t claimed = vkr_atomic_uint32_load(&g_trace.claimed_buffers,
+                                                  VKR_MEMORY_ORDER_ACQUIRE);
+  return Min(claimed, g_trace.config.max_threads);
+}
+
+/** Returns the calling thread's buffer, claiming one on first use. */
+vkr_internal VkrTraceBuffer *trace_buffer_for_current_thread(void) {
+  const uint32_t generation =
+      vkr_atomic_uint32_load(&g_trace.generation, VKR_MEMORY_ORDER_RELAXED);
+  if (t_trace_generation == generation) {
+    return t_trace_buffer;
+  }
+
+  t_trace_generation = generation;
+  t_trace_buffer = NULL;
+  if (!g_trace.buffers) {
+    return NULL;
+  }
+  const uint32_t index = vkr_atomic_uint32_fetch_add(
+      &g_trace.claimed_buffers, 1u, VKR_MEMORY_ORDER_ACQ_REL);
+  if (index < g_trace.config.max_threads) {
+    t_trace_buffer = &g_trace.buffers[index];
+  }
+  return t_trace_buffer;
+}
+
+VkrTraceConfig vkr_trace_config_default(void) {
+  return (VkrTraceConfig){
+      .max_threads = VKR_TRACE_DEFAULT_MAX_THREADS,
+      .records_per_thread = VKR_TRACE_DEFAULT_RECORDS_PER_THREAD,
+  };
+}
+
+bool8_t vkr_trace_init(VkrAllocator *allocator, const VkrTraceConfig *config) {
+  assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(config != NULL, "Config is NULL");
+
+  if (g_trace.buffers) {
+    return true_v;
+  }
+  // Room for a span and its END on top of a full stack of pending ENDs.
+  if (config->max_threads == 0 || config->records_per_thread < 4u) {
+    log_error("Tracing needs at least one buffer of 4 records");
+    return false_v;
+  }
+
+  const uint32_t generation =
+      vkr_atomic_uint32_load(&g_trace.generation, VKR_MEMORY_ORDER_RELAXED);
+  MemZero(&g_trace, sizeof(g_trace));
+  g_trace.allocator = allocator;
+  g_trace.config = *config;
+
+  const uint64_t record_count =
+      (uint64_t)config->max_threads * config->records_per_thread;
+  g_trace.buffers = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrTraceBuffer) * config->max_threads,
+      VKR_TRACE_CACHE_LINE_SIZE, VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  g_trace.record_data = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrTraceRecord) * record_count,
+      VKR_TRACE_CACHE_LINE_SIZE, VKR_ALLOCATOR_MEMORY_TAG_BUFFER);
+  if (!g_trace.buffers || !g_trace.record_data) {
+    log_error("Failed to allocate trace buffers");
+    vkr_trace_shutdown();
+    return false_v;
+  }
+  MemZero(g_trace.buffers, sizeof(VkrTraceBuffer) * config->max_threads);
+  for (uint32_t i = 0; i < config->max_threads; ++i) {
+    g_trace.buffers[i].records =
+        g_trace.record_data + (uint64_t)config->records_per_thread * i;
+  }
+
+  // Threads re-claim buffers from the new storage.
+  vkr_atomic_uint32_store(&g_trace.generation, generation + 1u,
+                          VKR_MEMORY_ORDER_RELEASE);
+  return true_v;
+}
+
+void vkr_trace_shutdown(void) {
+  VkrAllocator *allocator = g_trace.allocator;
+  if (!allocator) {
+    return;
+  }
+  vkr_trace_capture_stop();
+
+  const uint32_t max_threads = g_trace.config.max_threads;
+  if (g_trace.record_data) {
+    vkr_allocator_free_aligned(
+        allocator, g_trace.record_data,
+        sizeof(VkrTraceRecord) * max_threads *
+            (uint64_t)g_trace.config.records_per_thread,
+        VKR_TRACE_CACHE_LINE_SIZE, VKR_ALLOCATOR_MEMORY_TAG_BUFFER);
+    g_trace.record_data = NULL;
+  }
+  if (g_trace.buffers) {
+    vkr_allocator_free_aligned(allocator, g_trace.buffers,
+                               sizeof(VkrTraceBuffer) * max_threads,
+                               VKR_TRACE_CACHE_LINE_SIZE,
+                               VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+    g_trace.buffers = NULL;
+  }
+  g_trace.allocator = NULL;
+  vkr_atomic_uint32_fetch_add(&g_trace.generation, 1u,
+                              VKR_MEMORY_ORDER_RELEASE);
+}
+
+bool8_t vkr_trace_capture_start(void) {
+  if (!g_trace.buffers || vkr_trace_is_capturing()) {
+    return false_v;
+  }
+
+  // No writer touches a buffer while inactive, so the reset is race-free.
+  for (uint32_t i = 0; i < g_trace.config.max_threads; ++i) {
+    VkrTraceBuffer *buffer = &g_trace.buffers[i];
+    vkr_atomic_uint32_store(&buffer->count, 0, VKR_MEMORY_ORDER_RELAXED);
+    vkr_atomic_uint64_store(&buffer->dropped, 0, VKR_MEMORY_ORDER_RELAXED);
+    buffer->open_depth = 0;
+    buffer->dropped_depth = 0;
+  }
+  vkr_atomic_uint64_store(&g_trace.dropped_unclaimed, 0,
+                          VKR_MEMORY_ORDER_RELAXED);
+  g_trace.start_ns = trace_now_ns();
+  g_trace.stop_ns = g_trace.start_ns;
+  vkr_atomic_bool_store(&g_trace.active, true_v, VKR_MEMORY_ORDER_SEQ_CST);
+  return true_v;
+}
+
+void vkr_trace_capture_stop(void) {
+  if (!vkr_trace_is_capturing()) {
+    return;
+  }
+  vkr_atomic_bool_store(&g_trace.active, false_v, VKR_MEMORY_ORDER_SEQ_CST);
+
+  // Pairs with the busy store in vkr_trace_record(): a writer either sees the
+  // capture stopped or is seen here as busy and waited out.
+  const uint32_t buffer_count = trace_claimed_buffer_count();
+  for (uint32_t i = 0; i < buffer_count; ++i) {
+    while (vkr_atomic_uint32_load(&g_trace.buffers[i].busy,
+                                  VKR_MEMORY_ORDER_SEQ_CST) != 0) {
+      vkr_thread_sleep(0);
+    }
+  }
+  g_trace.stop_ns = trace_now_ns();
+}
+
+bool8_t vkr_trace_is_capturing(void) {
+  return vkr_atomic_bool_load(&g_trace.active, VKR_MEMORY_ORDER_ACQUIRE);
+}
+
+VkrTraceStats vkr_trace_get_stats(void) {
+  VkrTraceStats stats = {0};
+  if (!g_trace.buffers) {
+    return stats;
+  }
+  stats.threads = trace_claimed_buffer_count();
+  stats.dropped = vkr_atomic_uint64_load(&g_trace.dropped_unclaimed,
+                                         VKR_MEMORY_ORDER_RELAXED);
+  for (uint32_t i = 0; i < stats.threads; ++i) {
+    stats.recorded += vkr_atomic_uint32_load(&g_trace.buffers[i].count,
+                                             VKR_MEMORY_ORDER_ACQUIRE);
+    stats.dropped += vkr_atomic_uint64_load(&g_trace.buffers[i].dropped,
+                                            VKR_MEMORY_ORDER_RELAXED);
+  }
+  return stats;
+}
+
+void vkr_trace_set_thread_name(const char *name) {
+  VkrTraceBuffer *buffer = trace_buffer_for_current_thread();
+  if (buffer) {
+    buffer->thread_name = name;
+  }
+}
+
+/**
+ * Records that must be left free for the END of every recorded open span, so
+ * a full buffer still closes what it opened.
+ */
+vkr_internal INLINE bool8_t trace_buffer_has_room(const VkrTraceBuffer *buffer,
+                                                  uint32_t count,
+                                                  uint32_t needed) {
+  return (uint64_t)count + buffer->open_depth + needed <=
+         g_trace.config.records_per_thread;
+}
+
+void vkr_trace_record(VkrTraceRecordType type, const char *name,
+                      uint64_t value) {
+  if (!vkr_atomic_bool_load(&g_trace.active, VKR_MEMORY_ORDER_RELAXED)) {
+    return;
+  }
+  VkrTraceBuffer *buffer = trace_buffer_for_current_thread();
+  if (!buffer) {
+    vkr_atomic_uint64_fetch_add(&g_trace.dropped_unclaimed, 1u,
+                                VKR_MEMORY_ORDER_RELAXED);
+    return;
+  }
+
+  vkr_atomic_uint32_store(&buffer->busy, 1u, VKR_MEMORY_ORDER_SEQ_CST);
+  if (!vkr_atomic_bool_load(&g_trace.active, VKR_MEMORY_ORDER_SEQ_CST)) {
+    vkr_atomic_uint32_store(&buffer->busy, 0, VKR_MEMORY_ORDER_RELEASE);
+    return;
+  }
+
+  const uint32_t count =
+      vkr_atomic_uint32_load(&buffer->count, VKR_MEMORY_ORDER_RELAXED);
+  bool8_t keep = false_v;
+  bool8_t orphan = false_v;
+  switch (type) {
+  case VKR_TRACE_RECORD_BEGIN:
+    // Once one BEGIN is dropped every later one is too, so dropped spans are
+    // always the innermost open ones.
+    if (buffer->dropped_depth == 0 &&
+        trace_buffer_has_room(buffer, count, 2u)) {
+      buffer->open_depth++;
+      keep = true_v;
+    } else {
+      buffer->dropped_depth++;
+    }
+    break;
+  case VKR_TRACE_RECORD_END:
+    if (buffer->dropped_depth > 0) {
+      buffer->dropped_depth--;
+    } else if (buffer->open_depth > 0) {
+      // The slot was reserved when the BEGIN was kept.
+      buffer->open_depth--;
+      keep = true_v;
+    } else {
+      // The span was opened before the capture started.
+      orphan = true_v;
+    }
+    break;
+  default:
+    keep = trace_buffer_has_room(buffer, count, 1u);
+    break;
+  }
+
+  if (keep) {
+    VkrTraceRecord *record = &buffer->records[count];
+    record->timestamp_ns = trace_now_ns();
+    record->value = value;
+    record->name = name;
+    record->type = (uint8_t)type;
+    vkr_atomic_uint32_store(&buffer->count, count + 1u,
+                            VKR_MEMORY_ORDER_RELEASE);
+  } else if (!orphan) {
+    vkr_atomic_uint64_fetch_add(&buffer->dropped, 1u,
+                                VKR_MEMORY_ORDER_RELAXED);
+  }
+  vkr_atomic_uint32_store(&buffer->busy, 0, VKR_MEMORY_ORDER_RELEASE);
+}
+
+// =============================================================================
+// Chrome Trace Event JSON
+// =============================================================================
+
+vkr_internal INLINE String8 trace_name_string(const char *name) {
+  if (!name) {
+    return string8_lit("");
+  }
+  uint64_t length = 0;
+  while (length < VKR_TRACE_NAME_MAX && name[length] != '\0') {
+    length++;
+  }
+  return string8_create_from_cstr((const uint8_t *)name, length);
+}
+
+vkr_internal INLINE float64_t trace_relative_us(uint64_t timestamp_ns) {
+  const uint64_t relative = timestamp_ns > g_trace.start_ns
+                                ? timestamp_ns - g_trace.start_ns
+                                : 0u;
+  return (float64_t)relative / 1000.0;
+}
+
+/** Opens an event object with the fields every phase shares. */
+vkr_internal void trace_chrome_event_begin(VkrJsonWriter *writer,
+                                           const char *phase,
+                                           const char *name, uint32_t tid,
+                                           uint64_t timestamp_ns) {
+  vkr_json_writer_begin_object(writer);
+  vkr_json_writer_name(writer, string8_lit("name"));
+  vkr_json_writer_string(writer, trace_name_string(name));
+  vkr_json_writer_name(writer, string8_lit("cat"));
+  vkr_json_writer_string(writer, string8_lit("vkr"));
+  vkr_json_writer_name(writer, string8_lit("ph"));
+  vkr_json_writer_string(writer, trace_name_string(phase));
+  vkr_json_writer_name(writer, string8_lit("ts"));
+  vkr_json_writer_f64(writer, trace_relative_us(timestamp_ns));
+  vkr_json_writer_name(writer, string8_lit("pid"));
+  vkr_json_writer_u64(writer, VKR_TRACE_PROCESS_ID);
+  vkr_json_writer_name(writer, string8_lit("tid"));
+  vkr_json_writer_u64(writer, tid);
+}
+
+vkr_internal void trace_chrome_metadata(VkrJsonWriter *writer,
+                                        const char *kind, uint32_t tid,
+                                        String8 name) {
+  vkr_json_writer_begin_object(writer);
+  vkr_json_writer_name(writer, string8_lit("name"));
+  vkr_json_writer_string(writer, trace_name_string(kind));
+  vkr_json_writer_name(writer, string8_lit("ph"));
+  vkr_json_writer_string(writer, string8_lit("M"));
+  vkr_json_writer_name(writer, string8_lit("pid"));
+  vkr_json_writer_u64(writer, VKR_TRACE_PROCESS_ID);
+  vkr_json_writer_name(writer, string8_lit("tid"));
+  vkr_json_writer_u64(writer, tid);
+  vkr_json_writer_name(writer, string8_lit("args"));
+  vkr_json_writer_begin_object(writer);
+  vkr_json_writer_name(writer, string8_lit("name"));
+  vkr_json_writer_string(writer, name);
+  vkr_json_writer_end_object(writer);
+  vkr_json_writer_end_object(writer);
+}
+
+vkr_internal void trace_chrome_write_record(VkrJsonWriter *writer,
+                                            const VkrTraceRecord *record,
+                                            uint32_t tid) {
+  char id[24];
+  switch ((VkrTraceRecordType)record->type) {
+  case VKR_TRACE_RECORD_BEGIN:
+    trace_chrome_event_begin(writer, "B", record->name, tid,
+                             record->timestamp_ns);
+    break;
+  case VKR_TRACE_RECORD_END:
+    trace_chrome_event_begin(writer, "E", record->name, tid,
+                             record->timestamp_ns);
+    break;
+  case VKR_TRACE_RECORD_INSTANT:
+    trace_chrome_event_begin(writer, "i", record->name, tid,
+                             record->timestamp_ns);
+    vkr_json_writer_name(writer, string8_lit("s"));
+    vkr_json_writer_string(writer, string8_lit("t"));
+    break;
+  case VKR_TRACE_RECORD_COUNTER:
+    trace_chrome_event_begin(writer, "C", record->name, tid,
+                             record->timestamp_ns);
+    vkr_json_writer_name(writer, string8_lit("args"));
+    vkr_json_writer_begin_object(writer);
+    vkr_json_writer_name(writer, string8_lit("value"));
+    vkr_json_writer_u64(writer, record->value);
+    vkr_json_writer_end_object(writer);
+    break;
+  case VKR_TRACE_RECORD_FRAME:
+    trace_chrome_event_begin(writer, "i", record->name, tid,
+                             record->timestamp_ns);
+    vkr_json_writer_name(writer, string8_lit("s"));
+    vkr_json_writer_string(writer, string8_lit("g"));
+    vkr_json_writer_name(writer, string8_lit("args"));
+    vkr_json_writer_begin_object(writer);
+    vkr_json_writer_name(writer, string8_lit("frame"));
+    vkr_json_writer_u64(writer, record->value);
+    vkr_json_writer_end_object(writer);
+    break;
+  case VKR_TRACE_RECORD_FLOW_BEGIN:
+  case VKR_TRACE_RECORD_FLOW_STEP:
+  case VKR_TRACE_RECORD_FLOW_END: {
+    const char *phase = record->type == VKR_TRACE_RECORD_FLOW_BEGIN  ? "s"
+                        : record->type == VKR_TRACE_RECORD_FLOW_STEP ? "t"
+                                                                     : "f";
+    trace_chrome_event_begin(writer, phase, record->name, tid,
+                             record->timestamp_ns);
+    // Ids are 64-bit; a JSON number would lose the generation half.
+    snprintf(id, sizeof(id), "0x%llx", (unsigned long long)record->value);
+    vkr_json_writer_name(writer, string8_lit("id"));
+    vkr_json_writer_string(writer, trace_name_string(id));
+    // Bind to the enclosing span rather than the next one to start.
+    vkr_json_writer_name(writer, string8_lit("bp"));
+    vkr_json_writer_string(writer, string8_lit("e"));
+    break;
+  }
+  default:
+    return;
+  }
+  vkr_json_writer_end_object(writer);
+}
+
+bool8_t vkr_trace_write_chrome_json(VkrJsonWriter *writer) {
+  if (!writer || !g_trace.buffers || vkr_trace_is_capturing()) {
+    return false_v;
+  }
+  const VkrTraceStats stats = vkr_trace_get_stats();
+
+  vkr_json_writer_begin_object(writer);
+  vkr_json_writer_name(writer, string8_lit("displayTimeUnit"));
+  vkr_json_writer_string(writer, string8_lit("ns"));
+  vkr_json_writer_name(writer, string8_lit("otherData"));
+  vkr_json_writer_begin_object(writer);
+  vkr_json_writer_name(writer, string8_lit("recorded"));
+  vkr_json_writer_u64(writer, stats.recorded);
+  vkr_json_writer_name(writer, string8_lit("dropped"));
+  vkr_json_writer_u64(writer, stats.dropped);
+  vkr_json_writer_end_object(writer);
+
+  vkr_json_writer_name(writer, string8_lit("traceEvents"));
+  vkr_json_writer_begin_array(writer);
+  trace_chrome_metadata(writer, "process_name", 0, string8_lit("vkr"));
+
+  char thread_name[32];
+  for (uint32_t i = 0; i < stats.threads; ++i) {
+    const VkrTraceBuffer *buffer = &g_trace.buffers[i];
+    const uint32_t tid = i + 1u;
+    String8 name = trace_name_string(buffer->thread_name);
+    if (!buffer->thread_name) {
+      snprintf(thread_name, sizeof(thread_name), "thread %u", tid);
+      name = trace_name_string(thread_name);
+    }
+    trace_chrome_metadata(writer, "thread_name", tid, name);
+
+    const uint32_t count =
+        vkr_atomic_uint32_load(&buffer->count, VKR_MEMORY_ORDER_ACQUIRE);
+    uint32_t depth = 0;
+    for (uint32_t r = 0; r < count; ++r) {
+      const VkrTraceRecord *record = &buffer->records[r];
+      if (record->type == VKR_TRACE_RECORD_BEGIN) {
+        depth++;
+      } else if (record->type == VKR_TRACE_RECORD_END) {
+        depth--;
+      }
+      trace_chrome_write_record(writer, record, tid);
+    }
+    for (; depth > 0; --depth) {
+      trace_chrome_event_begin(writer, "E", NULL, tid, g_trace.stop_ns);
+      vkr_json_writer_end_object(writer);
+    }
+  }
+
+  vkr_json_writer_end_array(writer);
+  vkr_json_writer_end_object(writer);
+  return !writer->failed;
+}
+
+// =============================================================================
+// Perfetto protobuf
+// =============================================================================
+
+// Field numbers from perfetto/trace/trace_packet.proto, track_event.proto and
+// track_descriptor.proto.
+#define TRACE_PB_TRACE_PACKET 1u
+#define TRACE_PB_PACKET_TIMESTAMP 8u
+#define TRACE_PB_PACKET_SEQUENCE_ID 10u
+#define TRACE_PB_PACKET_SEQUENCE_FLAGS 13u
+#define TRACE_PB_PACKET_TRACK_EVENT 11u
+#define TRACE_PB_PACKET_TRACK_DESCRIPTOR 60u
+#define TRACE_PB_EVENT_TYPE 9u
+#define TRACE_PB_EVENT_TRACK_UUID 11u
+#define TRACE_PB_EVENT_CATEGORIES 22u
+#define TRACE_PB_EVENT_NAME 23u
+#define TRACE_PB_EVENT_COUNTER_VALUE 30u
+#define TRACE_PB_EVENT_FLOW_IDS 47u
+#define TRACE_PB_EVENT_TERMINATING_FLOW_IDS 48u
+#define TRACE_PB_TRACK_UUID 1u
+#define TRACE_PB_TRACK_NAME 2u
+#define TRACE_PB_TRACK_PROCESS 3u
+#define TRACE_PB_TRACK_THREAD 4u
+#define TRACE_PB_TRACK_PARENT_UUID 5u
+#define TRACE_PB_TRACK_COUNTER 8u
+#define TRACE_PB_PROCESS_PID 1u
+#define TRACE_PB_PROCESS_NAME 6u
+#define TRACE_PB_THREAD_PID 1u
+#define TRACE_PB_THREAD_TID 2u
+#define TRACE_PB_THREAD_NAME 5u
+
+#define TRACE_PB_WIRE_VARINT 0u
+#define TRACE_PB_WIRE_FIXED64 1u
+#define TRACE_PB_WIRE_BYTES 2u
+
+#define TRACE_PB_SEQ_INCREMENTAL_STATE_CLEARED 1u
+
+typedef enum TracePbEventType {
+  TRACE_PB_SLICE_BEGIN = 1,
+  TRACE_PB_SLICE_END = 2,
+  TRACE_PB_INSTANT = 3,
+  TRACE_PB_COUNTER = 4,
+} TracePbEventType;
+
+/** Bounded scratch for one message; overflow poisons it instead of writing. */
+typedef struct TracePbBuffer {
+  uint8_t data[VKR_TRACE_PACKET_MAX];
+  uint32_t length;
+  bool8_t overflow;
+} TracePbBuffer;
+
+vkr_internal void trace_pb_raw(TracePbBuffer *buffer, const void *data,
+                               uint64_t length) {
+  if (buffer->overflow || buffer->length + length > sizeof(buffer->data)) {
+    buffer->overflow = true_v;
+    return;
+  }
+  MemCopy(buffer->data + buffer->length, data, length);
+  buffer->length += (uint32_t)length;
+}
+
+vkr_internal void trace_pb_varint(TracePbBuffer *buffer, uint64_t value) {
+  uint8_t bytes[10];
+  uint32_t length = 0;
+  do {
+    uint8_t byte = (uint8_t)(value & 0x7fu);
+    value >>= 7u;
+    if (value) {
+      byte |= 0x80u;
+    }
+    bytes[length++] = byte;
+  } while (value);
+  trace_pb_raw(buffer, bytes, length);
+}
+
+vkr_internal INLINE void trace_pb_tag(TracePbBuffer *buffer, uint32_t field,
+                                      uint32_t wire_type) {
+  trace_pb_varint(buffer, ((uint64_t)field << 3u) | wire_type);
+}
+
+vkr_internal void trace_pb_uint(TracePbBuffer *buffer, uint32_t field,
+                                uint64_t value) {
+  trace_pb_tag(buffer, field, TRACE_PB_WIRE_VARINT);
+  trace_pb_varint(buffer, value);
+}
+
+vkr_internal void trace_pb_fixed64(TracePbBuffer *buffer, uint32_t field,
+                                   uint64_t value) {
+  uint8_t bytes[8];
+  for (uint32_t i = 0; i < 8u; ++i) {
+    bytes[i] = (uint8_t)(value >> (8u * i));
+  }
+  trace_pb_tag(buffer, field, TRACE_PB_WIRE_FIXED64);
+  trace_pb_raw(buffer, bytes, sizeof(bytes));
+}
+
+vkr_internal void trace_pb_bytes(TracePbBuffer *buffer, uint32_t field,
+                                 const void *data, uint64_t length) {
+  trace_pb_tag(buffer, field, TRACE_PB_WIRE_BYTES);
+  trace_pb_varint(buffer, length);
+  trace_pb_raw(buffer, data, length);
+}
+
+vkr_internal INLINE void trace_pb_string(TracePbBuffer *buffer, uint32_t field,
+                                         String8 value) {
+  trace_pb_bytes(buffer, field, value.str, value.length);
+}
+
+vkr_internal INLINE void trace_pb_message(TracePbBuffer *buffer,
+                                          uint32_t field,
+                                          const TracePbBuffer *message) {
+  if (message->overflow) {
+    buffer->overflow = true_v;
+    return;
+  }
+  trace_pb_bytes(buffer, field, message->data, message->length);
+}
+
+typedef struct TracePbWriter {
+  VkrJsonWriteSink sink;
+  void *sink_context;
+  bool8_t sequence_started;
+  bool8_t failed;
+} TracePbWriter;
+
+/** Every packet shares one sequence; the first one declares it fresh. */
+vkr_internal void trace_pb_packet_sequence(TracePbWriter *writer,
+                                           TracePbBuffer *packet) {
+  trace_pb_uint(packet, TRACE_PB_PACKET_SEQUENCE_ID, VKR_TRACE_SEQUENCE_ID);
+  if (!writer->sequence_started) {
+    trace_pb_uint(packet, TRACE_PB_PACKET_SEQUENCE_FLAGS,
+                  TRACE_PB_SEQ_INCREMENTAL_STATE_CLEARED);
+    writer->sequence_started = true_v;
+  }
+}
+
+/** Wraps a finished TracePacket body as `Trace.packet` and emits it. */
+vkr_internal void trace_pb_emit_packet(TracePbWriter *writer,
+                                       const TracePbBuffer *packet) {
+  if (writer->failed) {
+    return;
+  }
+  TracePbBuffer framed = {0};
+  trace_pb_message(&framed, TRACE_PB_TRACE_PACKET, packet);
+  if (framed.overflow ||
+      !writer->sink(writer->sink_context, framed.data, framed.length)) {
+    writer->failed = true_v;
+  }
+}
+
+vkr_internal void trace_pb_emit_descriptor(TracePbWriter *writer,
+                                           const TracePbBuffer *descriptor) {
+  TracePbBuffer packet = {0};
+  trace_pb_packet_sequence(writer, &packet);
+  trace_pb_message(&packet, TRACE_PB_PACKET_TRACK_DESCRIPTOR, descriptor);
+  trace_pb_emit_packet(writer, &packet);
+}
+
+vkr_internal void trace_pb_emit_event(TracePbWriter *writer,
+                                      uint64_t timestamp_ns,
+                                      const TracePbBuffer *event) {
+  TracePbBuffer packet = {0};
+  trace_pb_uint(&packet, TRACE_PB_PACKET_TIMESTAMP,
+                timestamp_ns > g_trace.start_ns
+                    ? timestamp_ns - g_trace.start_ns
+                    : 0u);
+  trace_pb_packet_sequence(writer, &packet);
+  trace_pb_message(&packet, TRACE_PB_PACKET_TRACK_EVENT, event);
+  trace_pb_emit_packet(writer, &packet);
+}
+
+/** FNV-1a of the counter name with the top bit set, away from thread ids. */
+vkr_internal uint64_t trace_counter_track_uuid(String8 name) {
+  uint64_t hash = 1469598103934665603ull;
+  for (uint64_t i = 0; i < name.length; ++i) {
+    hash ^= name.str[i];
+    hash *= 1099511628211ull;
+  }
+  return hash | (1ull << 63u);
+}
+
+typedef struct TraceCounterTracks {
+  uint64_t uuids[VKR_TRACE_MAX_COUNTER_TRACKS];
+  uint32_t count;
+} TraceCounterTracks;
+
+vkr_internal void trace_pb_describe_counter(TracePbWriter *writer,
+                                            TraceCounterTracks *tracks,
+                                            uint64_t uuid, String8 name) {
+  for (uint32_t i = 0; i < tracks->count; ++i) {
+    if (tracks->uuids[i] == uuid) {
+      return;
+    }
+  }
+  // Past the table, descriptors repeat; identical ones are harmless.
+  if (tracks->count < VKR_TRACE_MAX_COUNTER_TRACKS) {
+    tracks->uuids[tracks->count++] = uuid;
+  }
+  TracePbBuffer descriptor = {0};
+  TracePbBuffer counter = {0};
+  trace_pb_uint(&descriptor, TRACE_PB_TRACK_UUID, uuid);
+  trace_pb_string(&descriptor, TRACE_PB_TRACK_NAME, name);
+  trace_pb_uint(&descriptor, TRACE_PB_TRACK_PARENT_UUID,
+                VKR_TRACE_PROCESS_TRACK_UUID);
+  trace_pb_message(&descriptor, TRACE_PB_TRACK_COUNTER, &counter);
+  trace_pb_emit_descriptor(writer, &descriptor);
+}
+
+vkr_internal void trace_pb_write_record(TracePbWriter *writer,
+                                        TraceCounterTracks *counters,
+                                        const VkrTraceRecord *record,
+                                        uint64_t track_uuid) {
+  const String8 name = trace_name_string(record->name);
+  TracePbBuffer event = {0};
+  switch ((VkrTraceRecordType)record->type) {
+  case VKR_TRACE_RECORD_BEGIN:
+    trace_pb_uint(&event, TRACE_PB_EVENT_TYPE, TRACE_PB_SLICE_BEGIN);
+    trace_pb_uint(&event, TRACE_PB_EVENT_TRACK_UUID, track_uuid);
+    trace_pb_string(&event, TRACE_PB_EVENT_CATEGORIES, string8_lit("vkr"));
+    trace_pb_string(&event, TRACE_PB_EVENT_NAME, name);
+    break;
+  case VKR_TRACE_RECORD_END:
+    trace_pb_uint(&event, TRACE_PB_EVENT_TYPE, TRACE_PB_SLICE_END);
+    trace_pb_uint(&event, TRACE_PB_EVENT_TRACK_UUID, track_uuid);
+    break;
+  case VKR_TRACE_RECORD_COUNTER: {
+    const uint64_t counter_uuid = trace_counter_track_uuid(name);
+    trace_pb_describe_counter(writer, counters, counter_uuid, name);
+    trace_pb_uint(&event, TRACE_PB_EVENT_TYPE, TRACE_PB_COUNTER);
+    trace_pb_uint(&event, TRACE_PB_EVENT_TRACK_UUID, counter_uuid);
+    trace_pb_uint(&event, TRACE_PB_EVENT_COUNTER_VALUE, record->value);
+    break;
+  }
+  case VKR_TRACE_RECORD_INSTANT:
+  case VKR_TRACE_RECORD_FRAME:
+  case VKR_TRACE_RECORD_FLOW_BEGIN:
+  case VKR_TRACE_RECORD_FLOW_STEP:
+  case VKR_TRACE_RECORD_FLOW_END:
+    // Flow points are zero-length slices carrying the flow id; Perfetto
+    // connects consecutive occurrences of an id into arrows.
+    trace_pb_uint(&event, TRACE_PB_EVENT_TYPE, TRACE_PB_INSTANT);
+    trace_pb_uint(&event, TRACE_PB_EVENT_TRACK_UUID, track_uuid);
+    trace_pb_string(&event, TRACE_PB_EVENT_CATEGORIES, string8_lit("vkr"));
+    trace_pb_string(&event, TRACE_PB_EVENT_NAME, name);
+    if (record->type == VKR_TRACE_RECORD_FLOW_END) {
+      trace_pb_fixed64(&event, TRACE_PB_EVENT_TERMINATING_FLOW_IDS,
+                       record->value);
+    } else if (record->type != VKR_TRACE_RECORD_INSTANT &&
+               record->type != VKR_TRACE_RECORD_FRAME) {
+      trace_pb_fixed64(&event, TRACE_PB_EVENT_FLOW_IDS, record->value);
+    }
+    break;
+  default:
+    return;
+  }
+  trace_pb_emit_event(writer, record->timestamp_ns, &event);
+}
+
+bool8_t vkr_trace_write_perfetto(VkrJsonWriteSink sink, void *sink_context) {
+  if (!sink || !g_trace.buffers || vkr_trace_is_capturing()) {
+    return false_v;
+  }
+  TracePbWriter writer = {.sink = sink, .sink_context = sink_context};
+  TraceCounterTracks counters = {0};
+
+  TracePbBuffer process = {0};
+  TracePbBuffer descriptor = {0};
+  trace_pb_uint(&process, TRACE_PB_PROCESS_PID, VKR_TRACE_PROCESS_ID);
+  trace_pb_string(&process, TRACE_PB_PROCESS_NAME, string8_lit("vkr"));
+  trace_pb_uint(&descriptor, TRACE_PB_TRACK_UUID, VKR_TRACE_PROCESS_TRACK_UUID);
+  trace_pb_message(&descriptor, TRACE_PB_TRACK_PROCESS, &process);
+  trace_pb_emit_descriptor(&writer, &descriptor);
+
+  char thread_name[32];
+  const uint32_t buffer_count = trace_claimed_buffer_count();
+  for (uint32_t i = 0; i < buffer_count && !writer.failed; ++i) {
+    const VkrTraceBuffer *buffer = &g_trace.buffers[i];
+    const uint32_t tid = i + 1u;
+    const uint64_t track_uuid = VKR_TRACE_THREAD_TRACK_UUID_BASE + i;
+    String8 name = trace_name_string(buffer->thread_name);
+    if (!buffer->thread_name) {
+      snprintf(thread_name, sizeof(thread_name), "thread %u", tid);
+      name = trace_name_string(thread_name);
+    }
+
+    TracePbBuffer thread = {0};
+    MemZero(&descriptor, sizeof(descriptor));
+    trace_pb_uint(&thread, TRACE_PB_THREAD_PID, VKR_TRACE_PROCESS_ID);
+    trace_pb_uint(&thread, TRACE_PB_THREAD_TID, tid);
+    trace_pb_string(&thread, TRACE_PB_THREAD_NAME, name);
+    trace_pb_uint(&descriptor, TRACE_PB_TRACK_UUID, track_uuid);
+    trace_pb_message(&descriptor, TRACE_PB_TRACK_THREAD, &thread);
+    trace_pb_emit_descriptor(&writer, &descriptor);
+
+    const uint32_t count =
+        vkr_atomic_uint32_load(&buffer->count, VKR_MEMORY_ORDER_ACQUIRE);
+    uint32_t depth = 0;
+    for (uint32_t r = 0; r < count && !writer.failed; ++r) {
+      const VkrTraceRecord *record = &buffer->records[r];
+      if (record->type == VKR_TRACE_RECORD_BEGIN) {
+        depth++;
+      } else if (record->type == VKR_TRACE_RECORD_END) {
+        depth--;
+      }
+      trace_pb_write_record(&writer, &counters, record, track_uuid);
+    }
+    for (; depth > 0; --depth) {
+      const VkrTraceRecord end = {.timestamp_ns = g_trace.stop_ns,
+                                  .type = VKR_TRACE_RECORD_END};
+      trace_pb_write_record(&writer, &counters, &end, track_uuid);
+    }
+  }
+  return !writer.failed;
+}
+
+// =============================================================================
+// File export
+// =============================================================================
+
+vkr_internal bool8_t trace_file_sink(void *context, const uint8_t *data,
+                                     uint64_t length) {
+  return fwrite(data, 1, length, (FILE *)context) == length;
+}
+
+bool8_t vkr_trace_export_file(String8 path, VkrTraceFormat format) {
+  if (format == VKR_TRACE_FORMAT_CHROME_JSON) {
+    VkrJsonFileWriter file_writer;
+    if (!vkr_json_file_writer_begin(&file_writer, path)) {
+      return false_v;
+    }
+    if (!vkr_trace_write_chrome_json(&file_writer.writer)) {
+      vkr_json_file_writer_abort(&file_writer);
+      return false_v;
+    }
+    return vkr_json_file_writer_commit(&file_writer);
+  }
+
+  if (format == VKR_TRACE_FORMAT_PERFETTO) {
+    char path_cstr[VKR_JSON_WRITER_PATH_MAX + 1u];
+    if (!path.str || path.length == 0 || path.length >= sizeof(path_cstr)) {
+      return false_v;
+    }
+    MemCopy(path_cstr, path.str, path.length);
+    path_cstr[path.length] = '\0';
+    FILE *file = fopen(path_cstr, "wb");
+    if (!file) {
+      return false_v;
+    }
+    const bool8_t written = vkr_trace_write_perfetto(trace_file_sink, file);
+    const bool8_t closed = fclose(file) == 0;
+    if (!written || !closed) {
+      remove(path_cstr);
+      return false_v;
+    }
+    return true_v;
+  }
+  return false_v;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file vkr_trace.h
+ * @brief Per-thread hierarchical trace spans with Chrome and Perfetto export.
+ *
+ * Each recording thread owns a fixed buffer of trace records (timestamp,
+ * static name, value, type). Writers never take a lock: a record is written in
+ * place and published by bumping the buffer's count. Buffers are claimed once
+ * per trace system lifetime and reused by every capture.
+ *
+ * A capture is bracketed by vkr_trace_capture_start() and
+ * vkr_trace_capture_stop(). Outside a capture every macro costs one relaxed
+ * load. After stop the buffers are stable and can be exported as Chrome Trace
+ * Event JSON (chrome://tracing, ui.perfetto.dev) or as a Perfetto protobuf
+ * trace. Buffers that fill up drop further records and count them; spans that
+ * are still open when the capture stops are closed at the stop time.
+ *
+ * Names must be string literals or otherwise outlive the export.
+ *
+ * Everything compiles out with VKR_METRICS_ENABLED=0.
+ */
+#pragma once
+
+#include "containers/str.h"
+#include "core/vkr_atomic.h"
+#include "core/vkr_json_writer.h"
+#include "core/vkr_metrics.h"
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+
+#define VKR_TRACE_CACHE_LINE_SIZE 64u
+#define VKR_TRACE_DEFAULT_MAX_THREADS 16u
+#define VKR_TRACE_DEFAULT_RECORDS_PER_THREAD (32u * 1024u)
+/** Longest name copied into an exported event; longer names are cut. */
+#define VKR_TRACE_NAME_MAX 127u
+
+typedef enum VkrTraceRecordType {
+  VKR_TRACE_RECORD_BEGIN = 1,
+  VKR_TRACE_RECORD_END,
+  VKR_TRACE_RECORD_INSTANT,
+  VKR_TRACE_RECORD_COUNTER,
+  VKR_TRACE_RECORD_FLOW_BEGIN,
+  VKR_TRACE_RECORD_FLOW_STEP,
+  VKR_TRACE_RECORD_FLOW_END,
+  VKR_TRACE_RECORD_FRAME,
+} VkrTraceRecordType;
+
+typedef enum VkrTraceFormat {
+  VKR_TRACE_FORMAT_NONE = 0,
+  VKR_TRACE_FORMAT_CHROME_JSON,
+  VKR_TRACE_FORMAT_PERFETTO,
+} VkrTraceFormat;
+
+/**
+ * One recorded event. `value` is the counter value, flow id or frame index,
+ * depending on `type`.
+ */
+typedef struct VkrTraceRecord {
+  uint64_t timestamp_ns;
+  uint64_t value;
+  const char *name;
+  uint8_t type;
+} VkrTraceRecord;
+
+/**
+ * Single-writer record buffer. `busy` is raised around every write so a
+ * stopping capture can wait out writers that raced with it; `open_depth` and
+ * `dropped_depth` are owned by the writer and only reset between captures.
+ */
+typedef struct VkrTraceBuffer {
+  VkrAtomicUint32 busy;
+  VkrAtomicUint32 count;
+  VkrAtomicUint64 dropped;
+  uint32_t open_depth;
+  /** Open spans whose BEGIN was dropped; always the innermost ones. */
+  uint32_t dropped_depth;
+  const char *thread_name;
+  VkrTraceRecord *records;
+  uint8_t pad[VKR_TRACE_CACHE_LINE_SIZE - 40u];
+} VkrTraceBuffer;
+
+typedef struct VkrTraceConfig {
+  /** Recording threads; threads claiming buffers after these run out drop. */
+  uint32_t max_threads;
+  /** Records per thread buffer. */
+  uint32_t records_per_thread;
+} VkrTraceConfig;
+
+typedef struct VkrTraceStats {
+  uint64_t recorded;
+  uint64_t dropped;
+  uint32_t threads;
+} VkrTraceStats;
+
+VkrTraceConfig vkr_trace_config_default(void);
+
+/**
+ * @brief Allocates the per-thread buffers. Storage comes from `allocator` and
+ * stays valid until vkr_trace_shutdown().
+ */
+bool8_t vkr_trace_init(VkrAllocator *allocator, const VkrTraceConfig *config);
+
+/**
+ * @brief Releases the buffers. Call once other threads have stopped recording.
+ */
+void vkr_trace_shutdown(void);
+
+/**
+ * @brief Discards the previous capture and starts recording. Fails when the
+ * trace system is not initialized or a capture is already running.
+ */
+bool8_t vkr_trace_capture_start(void);
+
+/**
+ * @brief Stops recording and waits for writers that are mid-record. Safe to
+ * call while other threads are still emitting events.
+ */
+void vkr_trace_capture_stop(void);
+
+bool8_t vkr_trace_is_capturing(void);
+VkrTraceStats vkr_trace_get_stats(void);
+
+/**
+ * @brief Names the calling thread's track. `name` must outlive the export.
+ */
+void vkr_trace_set_thread_name(const char *name);
+
+/**
+ * @brief Appends a record to the calling thread's buffer. No-op outside a
+ * capture. Prefer the VKR_TRACE_* macros, which compile out with metrics.
+ */
+void vkr_trace_record(VkrTraceRecordType type, const char *name,
+                      uint64_t value);
+
+/**
+ * @brief Writes the stopped capture as a Chrome Trace Event JSON object.
+ */
+bool8_t vkr_trace_write_chrome_json(VkrJsonWriter *writer);
+
+/**
+ * @brief Streams the stopped capture as a Perfetto `Trace` protobuf.
+ */
+bool8_t vkr_trace_write_perfetto(VkrJsonWriteSink sink, void *sink_context);
+
+/**
+ * @brief Exports the stopped capture to `path` in the requested format.
+ * Chrome JSON goes through VkrJsonFileWriter and is replaced atomically; the
+ * Perfetto trace is written in place.
+ */
+bool8_t vkr_trace_export_file(String8 path, VkrTraceFormat format);
+
+/**
+ * @brief Flow id that stays unique for as long as the slot generation does.
+ */
+static INLINE uint64_t vkr_trace_flow_id(uint32_t id, uint32_t generation) {
+  return ((uint64_t)generation << 32u) | (uint64_t)id;
+}
+
+/*
+ * Spans must be properly nested per thread. VKR_TRACE_SCOPE wraps a block:
+ *
+ *   VKR_TRACE_SCOPE("frame.prepare") {
+ *     err = vkr_renderer_prepare_frame(renderer, &setup);
+ *   }
+ *
+ * Leaving the block with break, return or goto skips the END record; the
+ * exporter closes such spans when the capture stops.
+ */
+#if VKR_METRICS_ENABLED
+#define VKR_TRACE_SCOPE(name)                                                  \
+  for (bool8_t vkr_trace_scope_ =                                              \
+           (vkr_trace_record(VKR_TRACE_RECORD_BEGIN, (name), 0), true_v);      \
+       vkr_trace_scope_; vkr_trace_scope_ = false_v,                           \
+               vkr_trace_record(VKR_TRACE_RECORD_END, (name), 0))
+#define VKR_TRACE_BEGIN(name)                                                  \
+  vkr_trace_record(VKR_TRACE_RECORD_BEGIN, (name), 0)
+#define VKR_TRACE_END(name) vkr_trace_record(VKR_TRACE_RECORD_END, (name), 0)
+#define VKR_TRACE_INSTANT(name)                                                \
+  vkr_trace_record(VKR_TRACE_RECORD_INSTANT, (name), 0)
+#define VKR_TRACE_COUNTER(name, value)                                         \
+  vkr_trace_record(VKR_TRACE_RECORD_COUNTER, (name), (uint64_t)(value))
+#define VKR_TRACE_FRAME(frame_index)                                           \
+  vkr_trace_record(VKR_TRACE_RECORD_FRAME, "frame", (uint64_t)(frame_index))
+#define VKR_TRACE_FLOW_BEGIN(name, flow_id)                                    \
+  vkr_trace_record(VKR_TRACE_RECORD_FLOW_BEGIN, (name), (flow_id))
+#define VKR_TRACE_FLOW_STEP(name, flow_id)                                     \
+  vkr_trace_record(VKR_TRACE_RECORD_FLOW_STEP, (name), (flow_id))
+#define VKR_TRACE_FLOW_END(name, flow_id)                                      \
+  vkr_trace_record(VKR_TRACE_RECORD_FLOW_END, (name), (flow_id))
+#define VKR_TRACE_THREAD_NAME(name) vkr_trace_set_thread_name((name))
+#else
+#define VKR_TRACE_SCOPE(name)
+#define VKR_TRACE_BEGIN(name) ((void)0)
+#define VKR_TRACE_END(name) ((void)0)
+#define VKR_TRACE_INSTANT(name) ((void)0)
+#define VKR_TRACE_COUNTER(name, value) ((void)0)
+#define VKR_TRACE_FRAME(frame_index) ((void)0)
+#define VKR_TRACE_FLOW_BEGIN(name, flow_id) ((void)0)
+#define VKR_TRACE_FLOW_STEP(name, flow_id) ((void)0)
+#define VKR_TRACE_FLOW_END(name, flow_id) ((void)0)
+#define VKR_TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,556 @@
+/**
+ * @file vkr_bvh.c
+ * @brief Binned-SAH BVH build, refit, and convex-volume, sphere, and ray
+ * queries.
+ */
+
+#include "math/vkr_bvh.h"
+
+#include "core/logger.h"
+
+#define VKR_BVH_ALIGNMENT 16u
+
+typedef struct VkrBvhBin {
+  VkrAabb bounds;
+  uint32_t count;
+} VkrBvhBin;
+
+bool8_t vkr_aabb_test_planes(const VkrAabb *box, const VkrPlane *planes,
+                             uint32_t plane_count) {
+  for (uint32_t i = 0; i < plane_count; ++i) {
+    const VkrPlane *plane = &planes[i];
+    // The corner furthest along the plane normal; if even that one is behind
+    // the plane, so is the whole box.
+    const Vec3 positive =
+        vec3_new(plane->normal.x >= 0.0f ? box->max.x : box->min.x,
+                 plane->normal.y >= 0.0f ? box->max.y : box->min.y,
+                 plane->normal.z >= 0.0f ? box->max.z : box->min.z);
+    if (vec3_dot(plane->normal, positive) + plane->d < 0.0f) {
+      return false_v;
+    }
+  }
+  return true_v;
+}
+
+Vec3 vkr_ray_inverse_direction(Vec3 direction) {
+  // Any finite stand-in for infinity works: the slab test only compares the
+  // products, and a finite factor never turns a zero offset into NaN.
+  const float32_t huge = VKR_FLOAT_MAX;
+  return vec3_new(direction.x != 0.0f ? 1.0f / direction.x : huge,
+                  direction.y != 0.0f ? 1.0f / direction.y : huge,
+                  direction.z != 0.0f ? 1.0f / direction.z : huge);
+}
+
+bool8_t vkr_aabb_intersect_ray(const VkrAabb *box, Vec3 origin,
+                               Vec3 inv_direction, float32_t max_t,
+                               float32_t *out_t) {
+  const float32_t tx0 = (box->min.x - origin.x) * inv_direction.x;
+  const float32_t tx1 = (box->max.x - origin.x) * inv_direction.x;
+  const float32_t ty0 = (box->min.y - origin.y) * inv_direction.y;
+  const float32_t ty1 = (box->max.y - origin.y) * inv_direction.y;
+  const float32_t tz0 = (box->min.z - origin.z) * inv_direction.z;
+  const float32_t tz1 = (box->max.z - origin.z) * inv_direction.z;
+
+  float32_t t_enter = vkr_max_f32(
+      vkr_max_f32(vkr_min_f32(tx0, tx1), vkr_min_f32(ty0, ty1)),
+      vkr_min_f32(tz0, tz1));
+  const float32_t t_exit = vkr_min_f32(
+      vkr_min_f32(vkr_max_f32(tx0, tx1), vkr_max_f32(ty0, ty1)),
+      vkr_max_f32(tz0, tz1));
+
+  t_enter = vkr_max_f32(t_enter, 0.0f);
+  if (t_enter > t_exit || t_enter >= max_t) {
+    return false_v;
+  }
+  *out_t = t_enter;
+  return true_v;
+}
+
+bool8_t vkr_aabb_intersect_sphere(const VkrAabb *box, Vec3 center,
+                                  float32_t radius) {
+  const float32_t dx =
+      center.x - vkr_clamp_f32(center.x, box->min.x, box->max.x);
+  const float32_t dy =
+      center.y - vkr_clamp_f32(center.y, box->min.y, box->max.y);
+  const float32_t dz =
+      center.z - vkr_clamp_f32(center.z, box->min.z, box->max.z);
+  return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+bool8_t vkr_bvh_create(VkrAllocator *allocator, uint32_t capacity,
+                       VkrBvh *out_bvh) {
+  assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(out_bvh != NULL, "Out BVH is NULL");
+
+  MemZero(out_bvh, sizeof(*out_bvh));
+  if (capacity == 0) {
+    capacity = 1;
+  }
+
+  // A binary tree with at least one primitive per leaf has fewer than twice
+  // as many nodes as primitives.
+  const uint64_t node_capacity = (uint64_t)capacity * 2u;
+  out_bvh->nodes = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrBvhNode) * node_capacity, VKR_BVH_ALIGNMENT,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  out_bvh->centroids = vkr_allocator_alloc_aligned(
+      allocator, sizeof(Vec3) * (uint64_t)capacity, VKR_BVH_ALIGNMENT,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  out_bvh->primitives =
+      vkr_allocator_alloc(allocator, sizeof(uint32_t) * (uint64_t)capacity,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!out_bvh->nodes || !out_bvh->centroids || !out_bvh->primitives) {
+    log_error("Failed to allocate BVH storage for %u primitives", capacity);
+    out_bvh->allocator = allocator;
+    out_bvh->capacity = capacity;
+    out_bvh->node_capacity = (uint32_t)node_capacity;
+    vkr_bvh_destroy(out_bvh);
+    return false_v;
+  }
+
+  out_bvh->allocator = allocator;
+  out_bvh->capacity = capacity;
+  out_bvh->node_capacity = (uint32_t)node_capacity;
+  return true_v;
+}
+
+void vkr_bvh_destroy(VkrBvh *bvh) {
+  if (!bvh || !bvh->allocator) {
+    return;
+  }
+
+  const uint64_t capacity = bvh->capacity;
+  if (bvh->nodes) {
+    vkr_allocator_free_aligned(bvh->allocator, bvh->nodes,
+                               sizeof(VkrBvhNode) * bvh->node_capacity,
+                               VKR_BVH_ALIGNMENT,
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (bvh->centroids) {
+    vkr_allocator_free_aligned(bvh->allocator, bvh->centroids,
+                               sizeof(Vec3) * capacity, VKR_BVH_ALIGNMENT,
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (bvh->primitives) {
+    vkr_allocator_free(bvh->allocator, bvh->primitives,
+                       sizeof(uint32_t) * capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(bvh, sizeof(*bvh));
+}
+
+bool8_t vkr_bvh_compact(VkrBvh *bvh) {
+  assert_log(bvh != NULL, "BVH is NULL");
+
+  if (!bvh->allocator) {
+    return false_v;
+  }
+
+  if (bvh->centroids) {
+    vkr_allocator_free_aligned(bvh->allocator, bvh->centroids,
+                               sizeof(Vec3) * (uint64_t)bvh->capacity,
+                               VKR_BVH_ALIGNMENT,
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    bvh->centroids = NULL;
+  }
+
+  const uint32_t node_count = bvh->node_count > 0 ? bvh->node_count : 1u;
+  if (node_count == bvh->node_capacity) {
+    return true_v;
+  }
+
+  VkrBvhNode *nodes = vkr_allocator_alloc_aligned(
+      bvh->allocator, sizeof(VkrBvhNode) * (uint64_t)node_count,
+      VKR_BVH_ALIGNMENT, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!nodes) {
+    return false_v;
+  }
+  MemCopy(nodes, bvh->nodes, sizeof(VkrBvhNode) * (uint64_t)bvh->node_count);
+  vkr_allocator_free_aligned(bvh->allocator, bvh->nodes,
+                             sizeof(VkrBvhNode) * (uint64_t)bvh->node_capacity,
+                             VKR_BVH_ALIGNMENT, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  bvh->nodes = nodes;
+  bvh->node_capacity = node_count;
+  return true_v;
+}
+
+vkr_internal INLINE float32_t vkr_bvh_axis(Vec3 v, uint32_t axis) {
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+vkr_internal INLINE uint32_t vkr_bvh_bin_index(float32_t value,
+                                               float32_t axis_min,
+                                               float32_t bin_scale) {
+  const float32_t scaled = (value - axis_min) * bin_scale;
+  if (!(scaled > 0.0f)) {
+    return 0;
+  }
+  const uint32_t bin = (uint32_t)scaled;
+  return bin < VKR_BVH_BIN_COUNT ? bin : VKR_BVH_BIN_COUNT - 1;
+}
+
+/**
+ * Finds the cheapest binned split of [first, first + count). Returns false
+ * when every centroid coincides and no plane separates them.
+ */
+vkr_internal bool8_t vkr_bvh_find_split(const VkrBvh *bvh,
+                                        const VkrAabb *bounds, uint32_t first,
+                                        uint32_t count, VkrAabb centroid_bounds,
+                                        uint32_t *out_axis,
+                                        uint32_t *out_bin,
+                                        float32_t *out_cost) {
+  bool8_t found = false_v;
+  float32_t best_cost = VKR_FLOAT_MAX;
+
+  for (uint32_t axis = 0; axis < 3u; ++axis) {
+    const float32_t axis_min = vkr_bvh_axis(centroid_bounds.min, axis);
+    const float32_t axis_max = vkr_bvh_axis(centroid_bounds.max, axis);
+    if (!(axis_max - axis_min > 1e-6f)) {
+      continue;
+    }
+
+    VkrBvhBin bins[VKR_BVH_BIN_COUNT];
+    for (uint32_t b = 0; b < VKR_BVH_BIN_COUNT; ++b) {
+      bins[b].bounds = vkr_aabb_empty();
+      bins[b].count = 0;
+    }
+
+    const float32_t bin_scale =
+        (float32_t)VKR_BVH_BIN_COUNT / (axis_max - axis_min);
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t primitive = bvh->primitives[first + i];
+      const uint32_t b = vkr_bvh_bin_index(
+          vkr_bvh_axis(bvh->centroids[primitive], axis), axis_min, bin_scale);
+      bins[b].bounds = vkr_aabb_union(bins[b].bounds, bounds[primitive]);
+      bins[b].count++;
+    }
+
+    // Sweep from the right to record the cost terms of every suffix, then
+    // from the left to combine them with each prefix.
+    float32_t right_area[VKR_BVH_BIN_COUNT];
+    uint32_t right_count[VKR_BVH_BIN_COUNT];
+    VkrAabb right_bounds = vkr_aabb_empty();
+    uint32_t right_total = 0;
+    for (uint32_t b = VKR_BVH_BIN_COUNT - 1; b > 0; --b) {
+      right_bounds = vkr_aabb_union(right_bounds, bins[b].bounds);
+      right_total += bins[b].count;
+      right_area[b] = vkr_aabb_surface_area(right_bounds);
+      right_count[b] = right_total;
+    }
+
+    VkrAabb left_bounds = vkr_aabb_empty();
+    uint32_t left_total = 0;
+    for (uint32_t b = 0; b < VKR_BVH_BIN_COUNT - 1; ++b) {
+      left_bounds = vkr_aabb_union(left_bounds, bins[b].bounds);
+      left_total += bins[b].count;
+      if (left_total == 0 || right_count[b + 1] == 0) {
+        continue;
+      }
+      const float32_t cost =
+          vkr_aabb_surface_area(left_bounds) * (float32_t)left_total +
+          right_area[b + 1] * (float32_t)right_count[b + 1];
+      if (cost < best_cost) {
+        best_cost = cost;
+        *out_axis = axis;
+        *out_bin = b;
+        found = true_v;
+      }
+    }
+  }
+
+  *out_cost = best_cost;
+  return found;
+}
+
+vkr_internal void vkr_bvh_build_node(VkrBvh *bvh, const VkrAabb *bounds,
+                                     uint32_t node_index, uint32_t first,
+                                     uint32_t count, uint32_t depth) {
+  VkrBvhNode *node = &bvh->nodes[node_index];
+  VkrAabb node_bounds = vkr_aabb_empty();
+  VkrAabb centroid_bounds = vkr_aabb_empty();
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t primitive = bvh->primitives[first + i];
+    node_bounds = vkr_aabb_union(node_bounds, bounds[primitive]);
+    centroid_bounds =
+        vkr_aabb_include_point(centroid_bounds, bvh->centroids[primitive]);
+  }
+  node->bounds = node_bounds;
+  node->first = first;
+  node->count = count;
+
+  if (count <= VKR_BVH_LEAF_SIZE || depth + 1u >= VKR_BVH_MAX_DEPTH) {
+    return;
+  }
+
+  uint32_t axis = 0;
+  uint32_t split_bin = 0;
+  float32_t split_cost = 0.0f;
+  uint32_t mid = first + count / 2u;
+  if (vkr_bvh_find_split(bvh, bounds, first, count, centroid_bounds, &axis,
+                         &split_bin, &split_cost)) {
+    // Both costs are expressed relative to the parent's surface area, with
+    // one unit per primitive test and one per traversal step.
+    const float32_t leaf_cost =
+        vkr_aabb_surface_area(node_bounds) * (float32_t)count;
+    if (split_cost + vkr_aabb_surface_area(node_bounds) >= leaf_cost &&
+        count <= VKR_BVH_MAX_LEAF_SIZE) {
+      return;
+    }
+
+    const float32_t axis_min = vkr_bvh_axis(centroid_bounds.min, axis);
+    const float32_t bin_scale =
+        (float32_t)VKR_BVH_BIN_COUNT /
+        (vkr_bvh_axis(centroid_bounds.max, axis) - axis_min);
+    uint32_t left = first;
+    uint32_t right = first + count;
+    while (left < right) {
+      const uint32_t primitive = bvh->primitives[left];
+      const uint32_t b = vkr_bvh_bin_index(
+          vkr_bvh_axis(bvh->centroids[primitive], axis), axis_min, bin_scale);
+      if (b <= split_bin) {
+        left++;
+      } else {
+        right--;
+        bvh->primitives[left] = bvh->primitives[right];
+        bvh->primitives[right] = primitive;
+      }
+    }
+    if (left > first && left < first + count) {
+      mid = left;
+    }
+  } else if (count <= VKR_BVH_MAX_LEAF_SIZE) {
+    return;
+  }
+  // Coincident centroids fall through with the midpoint split, which keeps
+  // the tree balanced even though neither half is spatially tighter.
+
+  const uint32_t left_child = bvh->node_count;
+  bvh->node_count += 2u;
+  node->first = left_child;
+  node->count = 0;
+  vkr_bvh_build_node(bvh, bounds, left_child, first, mid - first, depth + 1u);
+  vkr_bvh_build_node(bvh, bounds, left_child + 1u, mid, first + count - mid,
+                     depth + 1u);
+}
+
+void vkr_bvh_build(VkrBvh *bvh, const VkrAabb *bounds,
+                   const uint32_t *primitives, uint32_t count) {
+  assert_log(bvh != NULL, "BVH is NULL");
+  assert_log(count <= bvh->capacity, "BVH primitive count exceeds capacity");
+  assert_log(bvh->centroids != NULL, "BVH build scratch was released");
+
+  bvh->node_count = 0;
+  bvh->primitive_count = 0;
+  if (count == 0 || !bounds || !primitives) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t primitive = primitives[i];
+    assert_log(primitive < bvh->capacity, "BVH primitive id out of range");
+    bvh->primitives[i] = primitive;
+    bvh->centroids[primitive] = vkr_aabb_center(bounds[primitive]);
+  }
+
+  bvh->primitive_count = count;
+  bvh->node_count = 1;
+  vkr_bvh_build_node(bvh, bounds, 0, 0, count, 0);
+}
+
+void vkr_bvh_refit(VkrBvh *bvh, const VkrAabb *bounds) {
+  assert_log(bvh != NULL, "BVH is NULL");
+
+  for (uint32_t i = bvh->node_count; i > 0; --i) {
+    VkrBvhNode *node = &bvh->nodes[i - 1u];
+    if (node->count > 0) {
+      VkrAabb leaf_bounds = vkr_aabb_empty();
+      for (uint32_t p = 0; p < node->count; ++p) {
+        leaf_bounds = vkr_aabb_union(
+            leaf_bounds, bounds[bvh->primitives[node->first + p]]);
+      }
+      node->bounds = leaf_bounds;
+    } else {
+      node->bounds = vkr_aabb_union(bvh->nodes[node->first].bounds,
+                                    bvh->nodes[node->first + 1u].bounds);
+    }
+  }
+}
+
+uint32_t vkr_bvh_query_planes(const VkrBvh *bvh, const VkrAabb *bounds,
+                              const VkrPlane *planes, uint32_t plane_count,
+                              VkrBvhVisitFn visit, void *user_data) {
+  assert_log(bvh != NULL, "BVH is NULL");
+
+  if (bvh->node_count == 0) {
+    return 0;
+  }
+
+  uint32_t visited = 0;
+  uint32_t stack[VKR_BVH_MAX_DEPTH + 1];
+  uint32_t stack_size = 0;
+  stack[stack_size++] = 0;
+
+  while (stack_size > 0) {
+    const VkrBvhNode *node = &bvh->nodes[stack[--stack_size]];
+    if (!vkr_aabb_test_planes(&node->bounds, planes, plane_count)) {
+      continue;
+    }
+
+    if (node->count == 0) {
+      stack[stack_size++] = node->first + 1u;
+      stack[stack_size++] = node->first;
+      continue;
+    }
+
+    for (uint32_t p = 0; p < node->count; ++p) {
+      const uint32_t primitive = bvh->primitives[node->first + p];
+      if (node->count > 1u &&
+          !vkr_aabb_test_planes(&bounds[primitive], planes, plane_count)) {
+        continue;
+      }
+      visited++;
+      if (visit && !visit(primitive, user_data)) {
+        return visited;
+      }
+    }
+  }
+
+  return visited;
+}
+
+uint32_t vkr_bvh_query_sphere(const VkrBvh *bvh, const VkrAabb *bounds,
+                              Vec3 center, float32_t radius,
+                              VkrBvhVisitFn visit, void *user_data) {
+  assert_log(bvh != NULL, "BVH is NULL");
+
+  if (bvh->node_count == 0) {
+    return 0;
+  }
+
+  uint32_t visited = 0;
+  uint32_t stack[VKR_BVH_MAX_DEPTH + 1];
+  uint32_t stack_size = 0;
+  stack[stack_size++] = 0;
+
+  while (stack_size > 0) {
+    const VkrBvhNode *node = &bvh->nodes[stack[--stack_size]];
+    if (!vkr_aabb_intersect_sphere(&node->bounds, center, radius)) {
+      continue;
+    }
+
+    if (node->count == 0) {
+      stack[stack_size++] = node->first + 1u;
+      stack[stack_size++] = node->first;
+      continue;
+    }
+
+    for (uint32_t p = 0; p < node->count; ++p) {
+      const uint32_t primitive = bvh->primitives[node->first + p];
+      if (node->count > 1u &&
+          !vkr_aabb_intersect_sphere(&bounds[primitive], center, radius)) {
+        continue;
+      }
+      visited++;
+      if (visit && !visit(primitive, user_data)) {
+        return visited;
+      }
+    }
+  }
+
+  return visited;
+}
+
+bool8_t vkr_bvh_query_ray(const VkrBvh *bvh, const VkrAabb *bounds,
+                          const VkrRay *ray, float32_t max_t,
+                          VkrBvhRayFn intersect, void *user_data,
+                          VkrBvhRayHit *out_hit) {
+  assert_log(bvh != NULL, "BVH is NULL");
+  assert_log(ray != NULL, "Ray is NULL");
+  assert_log(bounds != NULL || intersect != NULL,
+             "Ray query needs primitive bounds or an intersect callback");
+
+  if (bvh->node_count == 0) {
+    return false_v;
+  }
+
+  const Vec3 inv_direction = vkr_ray_inverse_direction(ray->direction);
+  float32_t closest = max_t;
+  uint32_t closest_primitive = VKR_INVALID_ID;
+
+  float32_t root_t = 0.0f;
+  if (!vkr_aabb_intersect_ray(&bvh->nodes[0].bounds, ray->origin,
+                              inv_direction, closest, &root_t)) {
+    return false_v;
+  }
+
+  // Entries carry the node's entry distance so nodes pushed before a closer
+  // hit was found can be discarded without re-testing their box.
+  uint32_t stack[VKR_BVH_MAX_DEPTH + 1];
+  float32_t stack_t[VKR_BVH_MAX_DEPTH + 1];
+  uint32_t stack_size = 0;
+  stack[stack_size] = 0;
+  stack_t[stack_size++] = root_t;
+
+  while (stack_size > 0) {
+    --stack_size;
+    if (stack_t[stack_size] >= closest) {
+      continue;
+    }
+    const VkrBvhNode *node = &bvh->nodes[stack[stack_size]];
+
+    if (node->count == 0) {
+      const uint32_t near_child = node->first;
+      const uint32_t far_child = node->first + 1u;
+      float32_t near_t = 0.0f;
+      float32_t far_t = 0.0f;
+      const bool8_t near_hit =
+          vkr_aabb_intersect_ray(&bvh->nodes[near_child].bounds, ray->origin,
+                                 inv_direction, closest, &near_t);
+      const bool8_t far_hit =
+          vkr_aabb_intersect_ray(&bvh->nodes[far_child].bounds, ray->origin,
+                                 inv_direction, closest, &far_t);
+      if (near_hit && far_hit) {
+        // Push the farther child first so the nearer one is popped next.
+        const bool8_t swap = far_t < near_t;
+        stack[stack_size] = swap ? near_child : far_child;
+        stack_t[stack_size++] = swap ? near_t : far_t;
+        stack[stack_size] = swap ? far_child : near_child;
+        stack_t[stack_size++] = swap ? far_t : near_t;
+      } else if (near_hit) {
+        stack[stack_size] = near_child;
+        stack_t[stack_size++] = near_t;
+      } else if (far_hit) {
+        stack[stack_size] = far_child;
+        stack_t[stack_size++] = far_t;
+      }
+      continue;
+    }
+
+    for (uint32_t p = 0; p < node->count; ++p) {
+      const uint32_t primitive = bvh->primitives[node->first + p];
+      float32_t t = 0.0f;
+      if (bounds && (node->count > 1u || !intersect)) {
+        if (!vkr_aabb_intersect_ray(&bounds[primitive], ray->origin,
+                                    inv_direction, closest, &t)) {
+          continue;
+        }
+      }
+      if (intersect && !intersect(primitive, ray, closest, &t, user_data)) {
+        continue;
+      }
+      if (t < closest) {
+        closest = t;
+        closest_primitive = primitive;
+      }
+    }
+  }
+
+  if (closest_primitive == VKR_INVALID_ID) {
+    return false_v;
+  }
+  if (out_hit) {
+    out_hit->primitive = closest_primitive;
+    out_hit->t = closest;
+  }
+  return true_v;
+}
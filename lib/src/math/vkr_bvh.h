@@ -0,0 +1,246 @@
+/**
+ * @file vkr_bvh.h
+ * @brief Axis-aligned bounding boxes and a binned-SAH bounding volume
+ * hierarchy over caller-owned primitive bounds.
+ *
+ * The BVH never owns primitive bounds. Callers keep a table of AABBs indexed
+ * by primitive id and pass it to build, refit, and query, so a moving
+ * primitive only has to update its table entry before the next refit.
+ * Storage is sized once at creation; build, refit, and query do not allocate.
+ *
+ * Queries cover convex volumes (frustums, light volumes), spheres, and rays.
+ * Ray traversal visits children front to back and shrinks the search interval
+ * to the closest hit so far, so closest-hit picking stays logarithmic.
+ */
+#pragma once
+
+#include "defines.h"
+#include "math/vec.h"
+#include "math/vkr_frustum.h"
+#include "math/vkr_math.h"
+#include "memory/vkr_allocator.h"
+
+/** Deepest node the builder creates; deeper ranges become oversized leaves. */
+#define VKR_BVH_MAX_DEPTH 64
+/** Ranges at or below this size become leaves without evaluating splits. */
+#define VKR_BVH_LEAF_SIZE 2
+/** Largest leaf the builder accepts when SAH prefers not to split. */
+#define VKR_BVH_MAX_LEAF_SIZE 8
+/** Centroid bins evaluated per axis by the SAH builder. */
+#define VKR_BVH_BIN_COUNT 12
+
+/**
+ * @brief Axis-aligned bounding box. Empty boxes have min > max.
+ */
+typedef struct VkrAabb {
+  Vec3 min;
+  Vec3 max;
+} VkrAabb;
+
+/**
+ * @brief One BVH node. Interior nodes store their left child in `first` with
+ * the right child at `first + 1`; leaves store a primitive range.
+ */
+typedef struct VkrBvhNode {
+  VkrAabb bounds;
+  uint32_t first; /**< Left child (interior) or first primitive (leaf). */
+  uint32_t count; /**< Primitive count; zero marks an interior node. */
+} VkrBvhNode;
+
+/**
+ * @brief Flattened BVH. Children are always stored after their parent, so a
+ * reverse walk over `nodes` visits every child before its parent.
+ */
+typedef struct VkrBvh {
+  VkrAllocator *allocator;
+  VkrBvhNode *nodes;
+  uint32_t *primitives; /**< Primitive ids in leaf order. */
+  Vec3 *centroids;      /**< Build scratch indexed by primitive id. */
+  uint32_t capacity;    /**< Exclusive upper bound on primitive ids. */
+  uint32_t node_capacity;
+  uint32_t node_count;
+  uint32_t primitive_count;
+} VkrBvh;
+
+/**
+ * @brief Ray with an unnormalized direction; hits are reported in units of
+ * `direction`, so a unit direction yields world distances.
+ */
+typedef struct VkrRay {
+  Vec3 origin;
+  Vec3 direction;
+} VkrRay;
+
+/**
+ * @brief Closest hit reported by vkr_bvh_query_ray.
+ */
+typedef struct VkrBvhRayHit {
+  uint32_t primitive;
+  float32_t t;
+} VkrBvhRayHit;
+
+/**
+ * @brief Query visitor. Return false to stop the traversal early.
+ */
+typedef bool8_t (*VkrBvhVisitFn)(uint32_t primitive, void *user_data);
+
+/**
+ * @brief Exact ray test for one primitive whose bounds the ray entered.
+ *
+ * Writes the hit parameter to `out_t` and returns true only for hits in
+ * [0, max_t). `max_t` is the closest hit found so far.
+ */
+typedef bool8_t (*VkrBvhRayFn)(uint32_t primitive, const VkrRay *ray,
+                               float32_t max_t, float32_t *out_t,
+                               void *user_data);
+
+vkr_internal INLINE VkrAabb vkr_aabb_empty(void) {
+  return (VkrAabb){
+      .min = vec3_new(VKR_FLOAT_MAX, VKR_FLOAT_MAX, VKR_FLOAT_MAX),
+      .max = vec3_new(-VKR_FLOAT_MAX, -VKR_FLOAT_MAX, -VKR_FLOAT_MAX),
+  };
+}
+
+vkr_internal INLINE VkrAabb vkr_aabb_from_sphere(Vec3 center,
+                                                 float32_t radius) {
+  const Vec3 half = vec3_new(radius, radius, radius);
+  return (VkrAabb){.min = vec3_sub(center, half),
+                   .max = vec3_add(center, half)};
+}
+
+vkr_internal INLINE VkrAabb vkr_aabb_union(VkrAabb a, VkrAabb b) {
+  return (VkrAabb){
+      .min = vec3_new(vkr_min_f32(a.min.x, b.min.x),
+                      vkr_min_f32(a.min.y, b.min.y),
+                      vkr_min_f32(a.min.z, b.min.z)),
+      .max = vec3_new(vkr_max_f32(a.max.x, b.max.x),
+                      vkr_max_f32(a.max.y, b.max.y),
+                      vkr_max_f32(a.max.z, b.max.z)),
+  };
+}
+
+vkr_internal INLINE VkrAabb vkr_aabb_include_point(VkrAabb box, Vec3 point) {
+  return vkr_aabb_union(box, (VkrAabb){.min = point, .max = point});
+}
+
+vkr_internal INLINE Vec3 vkr_aabb_center(VkrAabb box) {
+  return vec3_scale(vec3_add(box.min, box.max), 0.5f);
+}
+
+vkr_internal INLINE bool8_t vkr_aabb_is_empty(VkrAabb box) {
+  return box.min.x > box.max.x || box.min.y > box.max.y ||
+         box.min.z > box.max.z;
+}
+
+vkr_internal INLINE float32_t vkr_aabb_surface_area(VkrAabb box) {
+  if (vkr_aabb_is_empty(box)) {
+    return 0.0f;
+  }
+  const Vec3 d = vec3_sub(box.max, box.min);
+  return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+vkr_internal INLINE bool8_t vkr_aabb_equal(VkrAabb a, VkrAabb b) {
+  return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+         a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+}
+
+/**
+ * @brief Conservative convex-volume test. Returns false only when the box is
+ * entirely on the negative side of at least one plane.
+ */
+bool8_t vkr_aabb_test_planes(const VkrAabb *box, const VkrPlane *planes,
+                             uint32_t plane_count);
+
+/**
+ * @brief Slab test. On a hit writes the entry parameter (clamped to zero when
+ * the origin is inside) to `out_t`.
+ *
+ * @param inv_direction Componentwise reciprocal of the ray direction, as
+ * produced by vkr_ray_inverse_direction.
+ */
+bool8_t vkr_aabb_intersect_ray(const VkrAabb *box, Vec3 origin,
+                               Vec3 inv_direction, float32_t max_t,
+                               float32_t *out_t);
+
+/**
+ * @brief Reciprocal direction for slab tests. Zero components map to a huge
+ * finite value so axis-parallel rays never produce NaNs.
+ */
+Vec3 vkr_ray_inverse_direction(Vec3 direction);
+
+/**
+ * @brief Returns true when the box and sphere overlap.
+ */
+bool8_t vkr_aabb_intersect_sphere(const VkrAabb *box, Vec3 center,
+                                  float32_t radius);
+
+/**
+ * @brief Allocates node and scratch storage for primitive ids below
+ * `capacity`.
+ */
+bool8_t vkr_bvh_create(VkrAllocator *allocator, uint32_t capacity,
+                       VkrBvh *out_bvh);
+
+/**
+ * @brief Releases storage obtained by vkr_bvh_create.
+ */
+void vkr_bvh_destroy(VkrBvh *bvh);
+
+/**
+ * @brief Frees the build scratch and trims node storage to the built tree,
+ * for trees that will never be rebuilt.
+ *
+ * Refit and query keep working; a later vkr_bvh_build is not allowed.
+ * @return False when the trimmed copy could not be allocated; the tree is
+ * left untrimmed but valid.
+ */
+bool8_t vkr_bvh_compact(VkrBvh *bvh);
+
+/**
+ * @brief Rebuilds the hierarchy over `primitives` with a binned SAH.
+ *
+ * @param bounds Table of primitive bounds indexed by primitive id.
+ * @param primitives Primitive ids to insert; each must be below capacity.
+ * @param count Number of entries in `primitives`.
+ */
+void vkr_bvh_build(VkrBvh *bvh, const VkrAabb *bounds,
+                   const uint32_t *primitives, uint32_t count);
+
+/**
+ * @brief Recomputes node bounds bottom-up without changing topology.
+ *
+ * Cheaper than a build when primitives moved but the set did not change; the
+ * tree quality degrades as primitives drift from where they were built.
+ */
+void vkr_bvh_refit(VkrBvh *bvh, const VkrAabb *bounds);
+
+/**
+ * @brief Visits every primitive whose bounds pass vkr_aabb_test_planes.
+ * @return Number of primitives visited.
+ */
+uint32_t vkr_bvh_query_planes(const VkrBvh *bvh, const VkrAabb *bounds,
+                              const VkrPlane *planes, uint32_t plane_count,
+                              VkrBvhVisitFn visit, void *user_data);
+
+/**
+ * @brief Visits every primitive whose bounds overlap the sphere.
+ * @return Number of primitives visited.
+ */
+uint32_t vkr_bvh_query_sphere(const VkrBvh *bvh, const VkrAabb *bounds,
+                              Vec3 center, float32_t radius,
+                              VkrBvhVisitFn visit, void *user_data);
+
+/**
+ * @brief Finds the closest primitive hit along the ray within [0, max_t).
+ *
+ * `bounds` may be NULL when leaves should hand every primitive to
+ * `intersect` directly. When `intersect` is NULL the entry point into the
+ * primitive's bounds counts as the hit.
+ *
+ * @return True when a hit was found; `out_hit` is only written then.
+ */
+bool8_t vkr_bvh_query_ray(const VkrBvh *bvh, const VkrAabb *bounds,
+                          const VkrRay *ray, float32_t max_t,
+                          VkrBvhRayFn intersect, void *user_data,
+                          VkrBvhRayHit *out_hit);
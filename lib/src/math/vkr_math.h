@@ -478,6 +478,24 @@ vkr_internal INLINE float32_t vkr_log_f32(float32_t value) {
   return logf(value);
 }
 
+/** @brief Computes e^x in double precision. */
+vkr_internal INLINE float64_t vkr_exp_f64(float64_t value) {
+  return exp(value);
+}
+
+/** @brief Computes the natural logarithm in double precision. */
+vkr_internal INLINE float64_t vkr_log_f64(float64_t value) {
+  return log(value);
+}
+
+/**
+ * @brief Complementary error function, 1 - erf(x).
+ * @note Accurate in the far tail, where 1 - erf(x) would cancel to zero.
+ */
+vkr_internal INLINE float64_t vkr_erfc_f64(float64_t value) {
+  return erfc(value);
+}
+
 /**
  * @brief Computes the sine of an angle in radians
  * @param value Angle in radians
@@ -395,6 +395,23 @@ vkr_internal INLINE bool8_t vkr_simd_compare_f32x4(VKR_SIMD_F32X4 a,
                                                    VkrSimdCompareMode mode,
                                                    float32_t epsilon);
 
+/**
+ * @brief Lane-wise select on a >= b.
+ * @return Vector holding x in lanes where a >= b and y elsewhere. Lanes where
+ * either operand is NaN take y.
+ */
+vkr_internal INLINE VKR_SIMD_F32X4 vkr_simd_select_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                            VKR_SIMD_F32X4 b,
+                                                            VKR_SIMD_F32X4 x,
+                                                            VKR_SIMD_F32X4 y);
+
+/**
+ * @brief Lane-wise a >= b as a bit mask.
+ * @return Bit i set when lane i of a >= lane i of b; NaN lanes stay clear.
+ */
+vkr_internal INLINE uint32_t vkr_simd_mask_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                    VKR_SIMD_F32X4 b);
+
 // =============================================================================
 // SIMD Operations for int32_t vectors
 // =============================================================================
@@ -769,6 +786,21 @@ vkr_internal INLINE bool8_t vkr_simd_compare_f32x4(VKR_SIMD_F32X4 a,
   }
 }
 
+vkr_internal INLINE VKR_SIMD_F32X4 vkr_simd_select_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                            VKR_SIMD_F32X4 b,
+                                                            VKR_SIMD_F32X4 x,
+                                                            VKR_SIMD_F32X4 y) {
+  VKR_SIMD_F32X4 result;
+  result.neon = vbslq_f32(vcgeq_f32(a.neon, b.neon), x.neon, y.neon);
+  return result;
+}
+
+vkr_internal INLINE uint32_t vkr_simd_mask_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                    VKR_SIMD_F32X4 b) {
+  const uint32x4_t lane_bits = {1u, 2u, 4u, 8u};
+  return vaddvq_u32(vandq_u32(vcgeq_f32(a.neon, b.neon), lane_bits));
+}
+
 #elif defined(VKR_SIMD_X86_AVX)
 
 vkr_internal INLINE float32_t vkr_sse_sum_f32x4(__m128 v) {
@@ -1052,6 +1084,21 @@ vkr_internal INLINE bool8_t vkr_simd_compare_f32x4(VKR_SIMD_F32X4 a,
     return false_v;
   }
 }
+
+vkr_internal INLINE VKR_SIMD_F32X4 vkr_simd_select_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                            VKR_SIMD_F32X4 b,
+                                                            VKR_SIMD_F32X4 x,
+                                                            VKR_SIMD_F32X4 y) {
+  const __m128 mask = _mm_cmpge_ps(a.sse, b.sse);
+  VKR_SIMD_F32X4 result;
+  result.sse = _mm_or_ps(_mm_and_ps(mask, x.sse), _mm_andnot_ps(mask, y.sse));
+  return result;
+}
+
+vkr_internal INLINE uint32_t vkr_simd_mask_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                    VKR_SIMD_F32X4 b) {
+  return (uint32_t)_mm_movemask_ps(_mm_cmpge_ps(a.sse, b.sse));
+}
 #else
 // Fallback scalar implementations
 vkr_internal INLINE VKR_SIMD_F32X4 vkr_simd_load_f32x4(const float32_t *ptr) {
@@ -1319,4 +1366,25 @@ vkr_internal INLINE bool8_t vkr_simd_compare_f32x4(VKR_SIMD_F32X4 a,
     return false_v;
   }
 }
+
+vkr_internal INLINE VKR_SIMD_F32X4 vkr_simd_select_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                            VKR_SIMD_F32X4 b,
+                                                            VKR_SIMD_F32X4 x,
+                                                            VKR_SIMD_F32X4 y) {
+  VKR_SIMD_F32X4 result;
+  for (int i = 0; i < 4; i++) {
+    result.elements[i] =
+        a.elements[i] >= b.elements[i] ? x.elements[i] : y.elements[i];
+  }
+  return result;
+}
+
+vkr_internal INLINE uint32_t vkr_simd_mask_ge_f32x4(VKR_SIMD_F32X4 a,
+                                                    VKR_SIMD_F32X4 b) {
+  uint32_t mask = 0u;
+  for (int i = 0; i < 4; i++) {
+    mask |= a.elements[i] >= b.elements[i] ? 1u << i : 0u;
+  }
+  return mask;
+}
 #endif
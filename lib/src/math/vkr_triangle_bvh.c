@@ -0,0 +1,250 @@
+/**
+ * @file vkr_triangle_bvh.c
+ * @brief Static triangle BVH build and closest-hit ray queries.
+ */
+
+#include "math/vkr_triangle_bvh.h"
+
+#include "core/logger.h"
+
+#define VKR_TRIANGLE_BVH_ALIGNMENT 16u
+
+vkr_internal INLINE bool8_t vkr_triangle_source_index(
+    const VkrTriangleMeshSource *source, uint32_t index, uint32_t *out_vertex) {
+  const uint32_t raw = source->index_size == sizeof(uint16_t)
+                           ? ((const uint16_t *)source->indices)[index]
+                           : ((const uint32_t *)source->indices)[index];
+  const int64_t vertex = (int64_t)raw + (int64_t)source->vertex_offset;
+  if (vertex < 0 || vertex >= (int64_t)source->vertex_count) {
+    return false_v;
+  }
+  *out_vertex = (uint32_t)vertex;
+  return true_v;
+}
+
+vkr_internal INLINE Vec3
+vkr_triangle_source_position(const VkrTriangleMeshSource *source,
+                             uint32_t vertex) {
+  const float32_t *position =
+      (const float32_t *)((const uint8_t *)source->positions +
+                          (uint64_t)vertex * source->position_stride);
+  return vec3_new(position[0], position[1], position[2]);
+}
+
+vkr_internal bool8_t
+vkr_triangle_source_is_valid(const VkrTriangleMeshSource *source) {
+  return source->positions && source->indices &&
+         source->position_stride >= sizeof(float32_t) * 3u &&
+         (source->index_size == sizeof(uint16_t) ||
+          source->index_size == sizeof(uint32_t));
+}
+
+bool8_t vkr_triangle_intersect_ray(const VkrTriangle *triangle,
+                                   const VkrRay *ray, float32_t max_t,
+                                   float32_t *out_t) {
+  const Vec3 edge1 = vec3_sub(triangle->b, triangle->a);
+  const Vec3 edge2 = vec3_sub(triangle->c, triangle->a);
+  const Vec3 p = vec3_cross(ray->direction, edge2);
+  const float32_t det = vec3_dot(edge1, p);
+  // Parallel test relative to |edge1| * |p|: picking rays are unnormalized
+  // in mesh space, so an absolute threshold would reject small or heavily
+  // scaled meshes.
+  if (det * det <=
+      1e-14f * vec3_length_squared(edge1) * vec3_length_squared(p)) {
+    return false_v;
+  }
+
+  const float32_t inv_det = 1.0f / det;
+  const Vec3 s = vec3_sub(ray->origin, triangle->a);
+  const float32_t u = vec3_dot(s, p) * inv_det;
+  if (u < 0.0f || u > 1.0f) {
+    return false_v;
+  }
+
+  const Vec3 q = vec3_cross(s, edge1);
+  const float32_t v = vec3_dot(ray->direction, q) * inv_det;
+  if (v < 0.0f || u + v > 1.0f) {
+    return false_v;
+  }
+
+  const float32_t t = vec3_dot(edge2, q) * inv_det;
+  if (t < 0.0f || t >= max_t) {
+    return false_v;
+  }
+  *out_t = t;
+  return true_v;
+}
+
+bool8_t vkr_triangle_bvh_create(VkrAllocator *allocator,
+                                const VkrTriangleMeshSource *sources,
+                                uint32_t source_count,
+                                VkrTriangleBvh *out_bvh) {
+  assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(out_bvh != NULL, "Out BVH is NULL");
+
+  MemZero(out_bvh, sizeof(*out_bvh));
+
+  uint64_t max_triangles = 0;
+  for (uint32_t s = 0; s < source_count; ++s) {
+    if (vkr_triangle_source_is_valid(&sources[s])) {
+      max_triangles += sources[s].index_count / 3u;
+    }
+  }
+  if (max_triangles == 0 || max_triangles > UINT32_MAX / 2u) {
+    return false_v;
+  }
+
+  // Build-time tables: triangles and bounds in source order, plus the id list
+  // handed to the builder. All three are released once the leaf-ordered copy
+  // exists.
+  VkrTriangle *source_triangles = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrTriangle) * max_triangles,
+      VKR_TRIANGLE_BVH_ALIGNMENT, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrAabb *bounds = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrAabb) * max_triangles, VKR_TRIANGLE_BVH_ALIGNMENT,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint32_t *ids = vkr_allocator_alloc(allocator,
+                                      sizeof(uint32_t) * max_triangles,
+                                      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+
+  bool8_t success = source_triangles && bounds && ids;
+  uint32_t triangle_count = 0;
+  for (uint32_t s = 0; success && s < source_count; ++s) {
+    const VkrTriangleMeshSource *source = &sources[s];
+    if (!vkr_triangle_source_is_valid(source)) {
+      continue;
+    }
+
+    const uint32_t end = source->first_index + source->index_count / 3u * 3u;
+    for (uint32_t i = source->first_index; i < end; i += 3u) {
+      uint32_t v0 = 0;
+      uint32_t v1 = 0;
+      uint32_t v2 = 0;
+      if (!vkr_triangle_source_index(source, i, &v0) ||
+          !vkr_triangle_source_index(source, i + 1u, &v1) ||
+          !vkr_triangle_source_index(source, i + 2u, &v2)) {
+        continue;
+      }
+
+      VkrTriangle *triangle = &source_triangles[triangle_count];
+      triangle->a = vkr_triangle_source_position(source, v0);
+      triangle->b = vkr_triangle_source_position(source, v1);
+      triangle->c = vkr_triangle_source_position(source, v2);
+
+      VkrAabb box = {.min = triangle->a, .max = triangle->a};
+      box = vkr_aabb_include_point(box, triangle->b);
+      box = vkr_aabb_include_point(box, triangle->c);
+      bounds[triangle_count] = box;
+      ids[triangle_count] = triangle_count;
+      triangle_count++;
+    }
+  }
+
+  success = success && triangle_count > 0 &&
+            vkr_bvh_create(allocator, triangle_count, &out_bvh->bvh);
+  if (success) {
+    vkr_bvh_build(&out_bvh->bvh, bounds, ids, triangle_count);
+    out_bvh->triangles = vkr_allocator_alloc_aligned(
+        allocator, sizeof(VkrTriangle) * (uint64_t)triangle_count,
+        VKR_TRIANGLE_BVH_ALIGNMENT, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    success = out_bvh->triangles != NULL;
+  }
+
+  if (success) {
+    // Store triangles in leaf order so each leaf reads one contiguous run,
+    // then make primitive ids refer to that order.
+    for (uint32_t i = 0; i < triangle_count; ++i) {
+      out_bvh->triangles[i] = source_triangles[out_bvh->bvh.primitives[i]];
+      out_bvh->bvh.primitives[i] = i;
+    }
+    out_bvh->allocator = allocator;
+    out_bvh->triangle_count = triangle_count;
+    // A failed trim leaves a valid, merely larger, tree.
+    (void)vkr_bvh_compact(&out_bvh->bvh);
+  } else {
+    if (out_bvh->bvh.allocator) {
+      vkr_bvh_destroy(&out_bvh->bvh);
+    }
+    if (triangle_count > 0 || !source_triangles || !bounds || !ids) {
+      log_error("Failed to build triangle BVH (%u triangles)",
+                triangle_count);
+    }
+  }
+
+  if (ids) {
+    vkr_allocator_free(allocator, ids, sizeof(uint32_t) * max_triangles,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (bounds) {
+    vkr_allocator_free_aligned(allocator, bounds,
+                               sizeof(VkrAabb) * max_triangles,
+                               VKR_TRIANGLE_BVH_ALIGNMENT,
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (source_triangles) {
+    vkr_allocator_free_aligned(allocator, source_triangles,
+                               sizeof(VkrTriangle) * max_triangles,
+                               VKR_TRIANGLE_BVH_ALIGNMENT,
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+
+  if (!success) {
+    MemZero(out_bvh, sizeof(*out_bvh));
+  }
+  return success;
+}
+
+void vkr_triangle_bvh_destroy(VkrTriangleBvh *bvh) {
+  if (!bvh || !bvh->allocator) {
+    return;
+  }
+
+  vkr_bvh_destroy(&bvh->bvh);
+  if (bvh->triangles) {
+    vkr_allocator_free_aligned(
+        bvh->allocator, bvh->triangles,
+        sizeof(VkrTriangle) * (uint64_t)bvh->triangle_count,
+        VKR_TRIANGLE_BVH_ALIGNMENT, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(bvh, sizeof(*bvh));
+}
+
+vkr_internal bool8_t vkr_triangle_bvh_intersect(uint32_t primitive,
+                                                const VkrRay *ray,
+                                                float32_t max_t,
+                                                float32_t *out_t,
+                                                void *user_data) {
+  const VkrTriangleBvh *bvh = (const VkrTriangleBvh *)user_data;
+  return vkr_triangle_intersect_ray(&bvh->triangles[primitive], ray, max_t,
+                                    out_t);
+}
+
+bool8_t vkr_triangle_bvh_raycast(const VkrTriangleBvh *bvh, const VkrRay *ray,
+                                 float32_t max_t, float32_t *out_t,
+                                 uint32_t *out_triangle) {
+  if (!bvh || bvh->triangle_count == 0) {
+    return false_v;
+  }
+
+  VkrBvhRayHit hit = {0};
+  if (!vkr_bvh_query_ray(&bvh->bvh, NULL, ray, max_t,
+                         vkr_triangle_bvh_intersect, (void *)bvh, &hit)) {
+    return false_v;
+  }
+  if (out_t) {
+    *out_t = hit.t;
+  }
+  if (out_triangle) {
+    *out_triangle = hit.primitive;
+  }
+  return true_v;
+}
+
+uint64_t vkr_triangle_bvh_memory_size(const VkrTriangleBvh *bvh) {
+  if (!bvh) {
+    return 0;
+  }
+  return sizeof(VkrTriangle) * (uint64_t)bvh->triangle_count +
+         sizeof(VkrBvhNode) * (uint64_t)bvh->bvh.node_capacity +
+         sizeof(uint32_t) * (uint64_t)bvh->bvh.capacity;
+}
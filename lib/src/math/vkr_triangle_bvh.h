@@ -0,0 +1,82 @@
+/**
+ * @file vkr_triangle_bvh.h
+ * @brief Static triangle BVH (bottom-level acceleration structure) for CPU
+ * ray picking against mesh geometry.
+ *
+ * Built once from the CPU copy of a mesh while it is still resident during
+ * loading. Triangles are copied into leaf order so a leaf's triangles are
+ * contiguous, and the build scratch and per-triangle bounds are dropped after
+ * the build; only nodes, leaf-ordered triangles, and their ids remain.
+ */
+#pragma once
+
+#include "defines.h"
+#include "math/vkr_bvh.h"
+#include "memory/vkr_allocator.h"
+
+/**
+ * @brief One indexed triangle range inside a vertex/index buffer pair.
+ *
+ * Positions are read as three floats at the start of each `position_stride`
+ * byte vertex. Triangles that reference vertices outside the buffer are
+ * skipped.
+ */
+typedef struct VkrTriangleMeshSource {
+  const void *positions;
+  uint32_t position_stride;
+  uint32_t vertex_count;
+  const void *indices;
+  uint32_t index_size; /**< 2 or 4 bytes. */
+  uint32_t first_index;
+  uint32_t index_count;
+  int32_t vertex_offset; /**< Added to every index before lookup. */
+} VkrTriangleMeshSource;
+
+typedef struct VkrTriangle {
+  Vec3 a;
+  Vec3 b;
+  Vec3 c;
+} VkrTriangle;
+
+typedef struct VkrTriangleBvh {
+  VkrAllocator *allocator;
+  VkrBvh bvh;
+  VkrTriangle *triangles; /**< Leaf order; BVH primitive ids index this. */
+  uint32_t triangle_count;
+} VkrTriangleBvh;
+
+/**
+ * @brief Builds a triangle BVH over every triangle of `sources`.
+ *
+ * Fails (leaving `out_bvh` zeroed) when allocation fails or no triangle is
+ * valid.
+ */
+bool8_t vkr_triangle_bvh_create(VkrAllocator *allocator,
+                                const VkrTriangleMeshSource *sources,
+                                uint32_t source_count,
+                                VkrTriangleBvh *out_bvh);
+
+void vkr_triangle_bvh_destroy(VkrTriangleBvh *bvh);
+
+/**
+ * @brief Double-sided ray/triangle test (Moller-Trumbore).
+ *
+ * Writes the hit parameter to `out_t` for hits in [0, max_t).
+ */
+bool8_t vkr_triangle_intersect_ray(const VkrTriangle *triangle,
+                                   const VkrRay *ray, float32_t max_t,
+                                   float32_t *out_t);
+
+/**
+ * @brief Closest triangle hit within [0, max_t).
+ *
+ * @param out_triangle Optional; receives the leaf-order triangle index.
+ */
+bool8_t vkr_triangle_bvh_raycast(const VkrTriangleBvh *bvh, const VkrRay *ray,
+                                 float32_t max_t, float32_t *out_t,
+                                 uint32_t *out_triangle);
+
+/**
+ * @brief Approximate bytes held by the structure.
+ */
+uint64_t vkr_triangle_bvh_memory_size(const VkrTriangleBvh *bvh);
@@ -172,6 +172,13 @@ VkrThreadId vkr_thread_current_id(void) {
   return tid;
 }
 
+// macOS offers only affinity tags, which the scheduler may ignore and Apple
+// silicon does not implement, so no request can be reported as enforced.
+bool32_t vkr_thread_pin_current(uint32_t logical_core) {
+  (void)logical_core;
+  return false_v;
+}
+
 bool32_t vkr_thread_join(VkrThread thread) {
   if (thread == NULL || thread->joined || thread->detached) {
     return false_v;
@@ -166,6 +166,14 @@ VkrThreadId vkr_thread_current_id(void) {
   return (VkrThreadId)GetCurrentThreadId();
 }
 
+bool32_t vkr_thread_pin_current(uint32_t logical_core) {
+  if (logical_core >= sizeof(DWORD_PTR) * 8u) {
+    return false_v;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(),
+                               (DWORD_PTR)1 << logical_core) != 0;
+}
+
 bool32_t vkr_thread_join(VkrThread thread) {
   if (thread == NULL || thread->joined || thread->detached ||
       thread->handle == NULL) {
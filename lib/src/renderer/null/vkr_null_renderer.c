@@ -0,0 +1,929 @@
+#include "renderer/null/vkr_null_renderer.h"
+
+#include "core/logger.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+#include "platform/vkr_platform.h"
+#include "renderer/resources/loaders/mesh_loader.h"
+#include "renderer/systems/vkr_geometry_system.h"
+#include "renderer/systems/vkr_texture_system.h"
+#include "renderer/vkr_render_graph_internal.h"
+#include "renderer/vkr_rg_json.h"
+
+typedef enum VkrNullRetirementKind {
+  VKR_NULL_RETIREMENT_GEOMETRY = 0,
+  VKR_NULL_RETIREMENT_TEXTURE,
+  VKR_NULL_RETIREMENT_MATERIAL,
+} VkrNullRetirementKind;
+
+typedef struct VkrNullPublication {
+  uint32_t generation;
+  uint64_t bytes;
+  bool8_t live;
+} VkrNullPublication;
+
+typedef struct VkrNullRetirement {
+  VkrNullRetirementKind kind;
+  uint64_t bytes;
+  uint64_t retire_value;
+} VkrNullRetirement;
+
+struct VkrNullRenderer {
+  VkrAllocator *allocator;
+  VkrNullRendererConfig config;
+  VkrNullPublication *geometries;
+  VkrNullPublication *textures;
+  VkrNullPublication *materials;
+  VkrNullRetirement *retirements;
+  uint32_t retirement_count;
+  uint32_t pending_ibl_bake_count;
+
+  Arena *graph_frame_arena;
+  VkrAllocator graph_frame_allocator;
+  VkrRgExecutorRegistry executors;
+  VkrRgJsonGraph json_graph;
+  VkrRenderGraph *graph;
+  VkrRenderGraphFrameInfo prepared_frame;
+  VkrRenderGraphResourceStats graph_stats;
+  /** Executor callbacks observed while walking the current schedule. */
+  uint32_t frame_executor_calls;
+
+  uint64_t submit_value;
+  uint64_t completed_value;
+  uint64_t source_frame_index;
+  uint32_t frame_slot;
+  bool8_t frame_active;
+  VkrNullResult slot_results[VKR_NULL_FRAME_SLOT_COUNT];
+  VkrNullRendererMetrics metrics;
+};
+
+// =============================================================================
+// Memory accounting
+// =============================================================================
+
+vkr_internal VkrRendererImplMemoryClass
+vkr_null_retirement_class(VkrNullRetirementKind kind) {
+  return kind == VKR_NULL_RETIREMENT_GEOMETRY
+             ? VKR_RENDERER_IMPL_MEMORY_CLASS_BUFFER
+             : VKR_RENDERER_IMPL_MEMORY_CLASS_TEXTURE;
+}
+
+vkr_internal void vkr_null_memory_publish(VkrNullRenderer *renderer,
+                                          VkrRendererImplMemoryClass klass,
+                                          uint64_t bytes) {
+  VkrRendererImplMemoryMetrics *memory = &renderer->metrics.memory;
+  VkrRendererImplMemoryClassMetrics *class_metrics = &memory->classes[klass];
+  memory->live_requested_bytes += bytes;
+  memory->live_reserved_bytes += bytes;
+  memory->allocations_created++;
+  memory->live_allocations++;
+  memory->peak_requested_bytes =
+      Max(memory->peak_requested_bytes, memory->live_requested_bytes);
+  memory->peak_reserved_bytes = memory->peak_requested_bytes;
+  memory->peak_allocations =
+      Max(memory->peak_allocations, memory->live_allocations);
+  class_metrics->live_requested_bytes += bytes;
+  class_metrics->live_reserved_bytes += bytes;
+  class_metrics->allocations_created++;
+  class_metrics->live_allocations++;
+  class_metrics->peak_requested_bytes = Max(
+      class_metrics->peak_requested_bytes, class_metrics->live_requested_bytes);
+  class_metrics->peak_reserved_bytes = class_metrics->peak_requested_bytes;
+  class_metrics->peak_allocations =
+      Max(class_metrics->peak_allocations, class_metrics->live_allocations);
+}
+
+/** Moves one allocation from live to retired; the bytes stay resident. */
+vkr_internal void vkr_null_memory_retire(VkrNullRenderer *renderer,
+                                         VkrRendererImplMemoryClass klass,
+                                         uint64_t bytes) {
+  VkrRendererImplMemoryMetrics *memory = &renderer->metrics.memory;
+  VkrRendererImplMemoryClassMetrics *class_metrics = &memory->classes[klass];
+  memory->live_requested_bytes -= Min(memory->live_requested_bytes, bytes);
+  memory->live_reserved_bytes = memory->live_requested_bytes;
+  memory->live_allocations -= Min(memory->live_allocations, 1u);
+  memory->retired_requested_bytes += bytes;
+  memory->retired_reserved_bytes += bytes;
+  memory->retired_allocations++;
+  class_metrics->live_requested_bytes -=
+      Min(class_metrics->live_requested_bytes, bytes);
+  class_metrics->live_reserved_bytes = class_metrics->live_requested_bytes;
+  class_metrics->live_allocations -= Min(class_metrics->live_allocations, 1u);
+  class_metrics->retired_requested_bytes += bytes;
+  class_metrics->retired_reserved_bytes += bytes;
+  class_metrics->retired_allocations++;
+}
+
+vkr_internal void vkr_null_memory_collect(VkrNullRenderer *renderer,
+                                          VkrRendererImplMemoryClass klass,
+                                          uint64_t bytes) {
+  VkrRendererImplMemoryMetrics *memory = &renderer->metrics.memory;
+  VkrRendererImplMemoryClassMetrics *class_metrics = &memory->classes[klass];
+  memory->retired_requested_bytes -=
+      Min(memory->retired_requested_bytes, bytes);
+  memory->retired_reserved_bytes = memory->retired_requested_bytes;
+  memory->retired_allocations -= Min(memory->retired_allocations, 1u);
+  memory->retirements_collected++;
+  class_metrics->retired_requested_bytes -=
+      Min(class_metrics->retired_requested_bytes, bytes);
+  class_metrics->retired_reserved_bytes =
+      class_metrics->retired_requested_bytes;
+  class_metrics->retired_allocations -=
+      Min(class_metrics->retired_allocations, 1u);
+}
+
+/** Releases every retirement whose last submit has completed. */
+vkr_internal void vkr_null_collect_retirements(VkrNullRenderer *renderer) {
+  uint32_t write = 0u;
+  for (uint32_t i = 0u; i < renderer->retirement_count; ++i) {
+    const VkrNullRetirement *retirement = &renderer->retirements[i];
+    if (retirement->retire_value > renderer->completed_value) {
+      renderer->retirements[write++] = *retirement;
+      continue;
+    }
+    if (retirement->kind == VKR_NULL_RETIREMENT_MATERIAL) {
+      renderer->metrics.materials.rows_retired -=
+          Min(renderer->metrics.materials.rows_retired, 1u);
+      renderer->metrics.materials.rows_collected++;
+    } else {
+      vkr_null_memory_collect(renderer,
+                              vkr_null_retirement_class(retirement->kind),
+                              retirement->bytes);
+    }
+  }
+  renderer->retirement_count = write;
+  renderer->metrics.retirements_pending = write;
+}
+
+/**
+ * Defers release until the last submit that may reference the resource has
+ * completed. A queued IBL bake reads its textures in the next submit, so while
+ * one is pending that submit is the last possible use.
+ */
+vkr_internal bool8_t vkr_null_retire(VkrNullRenderer *renderer,
+                                     VkrNullRetirementKind kind,
+                                     uint64_t bytes) {
+  if (renderer->retirement_count >= renderer->config.retirement_capacity) {
+    if (kind == VKR_NULL_RETIREMENT_MATERIAL)
+      renderer->metrics.materials.retirement_capacity_failures++;
+    else
+      renderer->metrics.memory.retirement_capacity_failures++;
+    log_error("Null renderer retirement capacity exhausted");
+    return false_v;
+  }
+  renderer->retirements[renderer->retirement_count++] = (VkrNullRetirement){
+      .kind = kind,
+      .bytes = bytes,
+      .retire_value = renderer->submit_value +
+                      (renderer->pending_ibl_bake_count ? 1u : 0u),
+  };
+  if (kind == VKR_NULL_RETIREMENT_MATERIAL) {
+    renderer->metrics.materials.rows_retired++;
+  } else {
+    vkr_null_memory_retire(renderer, vkr_null_retirement_class(kind), bytes);
+  }
+  vkr_null_collect_retirements(renderer);
+  return true_v;
+}
+
+// =============================================================================
+// Asset publisher
+// =============================================================================
+
+vkr_internal VkrNullPublication *
+vkr_null_publication(VkrNullPublication *records, uint32_t capacity,
+                     uint32_t id) {
+  return records && id != 0u && id <= capacity ? &records[id - 1u] : NULL;
+}
+
+vkr_internal VkrNullPublication *
+vkr_null_live_texture(VkrNullRenderer *renderer, VkrTextureHandle handle) {
+  VkrNullPublication *record = vkr_null_publication(
+      renderer->textures, renderer->config.texture_capacity, handle.id);
+  return record && record->live && record->generation == handle.generation
+             ? record
+             : NULL;
+}
+
+/** Base-level bytes across every layer; block formats round up per block. */
+vkr_internal uint64_t
+vkr_null_texture_bytes(const VkrTextureDescription *description) {
+  VkrTextureFormatInfo format = {0};
+  if (!vkr_texture_format_get_info(description->format, &format) ||
+      !format.block_width || !format.block_height)
+    return 0u;
+  const uint64_t blocks_x =
+      (description->width + format.block_width - 1u) / format.block_width;
+  const uint64_t blocks_y =
+      (description->height + format.block_height - 1u) / format.block_height;
+  const uint64_t layers =
+      description->type == VKR_TEXTURE_TYPE_CUBE_MAP ? 6u : 1u;
+  return blocks_x * blocks_y * format.bytes_per_block * layers *
+         Max((uint32_t)description->sample_count, 1u);
+}
+
+vkr_internal bool8_t vkr_null_asset_publications_idle(void *state) {
+  const VkrNullRenderer *renderer = state;
+  return renderer && !renderer->pending_ibl_bake_count;
+}
+
+vkr_internal bool8_t
+vkr_null_asset_publish_geometry(void *state, VkrGeometryHandle handle,
+                                const VkrGeometryConfig *geometry) {
+  VkrNullRenderer *renderer = state;
+  VkrNullPublication *record =
+      renderer ? vkr_null_publication(renderer->geometries,
+                                      renderer->config.geometry_capacity,
+                                      handle.id)
+               : NULL;
+  if (!record || !geometry || !geometry->vertices || !geometry->indices ||
+      !geometry->vertex_count || !geometry->index_count ||
+      !geometry->vertex_size || !geometry->index_size)
+    return false_v;
+  // Indices are widened to 32 bits on upload, as the Vulkan megabuffer does.
+  const uint64_t bytes =
+      (uint64_t)geometry->vertex_count * geometry->vertex_size +
+      (uint64_t)geometry->index_count * sizeof(uint32_t);
+  if (record->live) {
+    if (record->generation != handle.generation || record->bytes != bytes) {
+      renderer->metrics.memory.stale_handle_failures++;
+      log_error("Null renderer geometry %u:%u conflicts with generation %u",
+                handle.id, handle.generation, record->generation);
+      return false_v;
+    }
+  } else {
+    *record = (VkrNullPublication){
+        .generation = handle.generation,
+        .bytes = bytes,
+        .live = true_v,
+    };
+    vkr_null_memory_publish(renderer, VKR_RENDERER_IMPL_MEMORY_CLASS_BUFFER,
+                            bytes);
+  }
+  renderer->metrics.geometry_publications++;
+  renderer->metrics.geometry_upload_bytes += bytes;
+  return true_v;
+}
+
+vkr_internal bool8_t
+vkr_null_asset_publish_loaded_mesh(void *state, VkrGeometryHandle handle,
+                                   const VkrMeshLoaderResult *mesh) {
+  if (!mesh || !mesh->has_mesh_buffer || !mesh->submeshes.length)
+    return false_v;
+  const VkrGeometryConfig geometry = {
+      .vertex_size = mesh->mesh_buffer.vertex_size,
+      .vertex_count = mesh->mesh_buffer.vertex_count,
+      .vertices = mesh->mesh_buffer.vertices,
+      .index_size = mesh->mesh_buffer.index_size,
+      .index_count = mesh->mesh_buffer.index_count,
+      .indices = mesh->mesh_buffer.indices,
+  };
+  return vkr_null_asset_publish_geometry(state, handle, &geometry);
+}
+
+vkr_internal bool8_t vkr_null_asset_unpublish_geometry(
+    void *state, VkrGeometryHandle handle) {
+  VkrNullRenderer *renderer = state;
+  VkrNullPublication *record =
+      renderer ? vkr_null_publication(renderer->geometries,
+                                      renderer->config.geometry_capacity,
+                                      handle.id)
+               : NULL;
+  if (!record || !record->live || record->generation != handle.generation ||
+      !vkr_null_retire(renderer, VKR_NULL_RETIREMENT_GEOMETRY, record->bytes))
+    return false_v;
+  record->live = false_v;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_texture_publish_bytes(VkrNullRenderer *renderer,
+                                                    VkrTextureHandle handle,
+                                                    uint64_t bytes) {
+  VkrNullPublication *record = vkr_null_publication(
+      renderer->textures, renderer->config.texture_capacity, handle.id);
+  if (!record || !bytes)
+    return false_v;
+  if (record->live) {
+    if (record->generation != handle.generation) {
+      renderer->metrics.memory.stale_handle_failures++;
+      return false_v;
+    }
+    // A same-generation republish replaces the image; the old one retires.
+    if (!vkr_null_retire(renderer, VKR_NULL_RETIREMENT_TEXTURE, record->bytes))
+      return false_v;
+  }
+  *record = (VkrNullPublication){
+      .generation = handle.generation,
+      .bytes = bytes,
+      .live = true_v,
+  };
+  vkr_null_memory_publish(renderer, VKR_RENDERER_IMPL_MEMORY_CLASS_TEXTURE,
+                          bytes);
+  renderer->metrics.texture_publications++;
+  return true_v;
+}
+
+vkr_internal bool8_t
+vkr_null_asset_publish_texture(void *state, VkrTextureHandle handle,
+                               const VkrTexturePreparedLoad *texture) {
+  VkrNullRenderer *renderer = state;
+  if (!renderer || !texture || !texture->upload_data ||
+      !texture->upload_data_size)
+    return false_v;
+  const uint64_t bytes =
+      Max(texture->upload_data_size,
+          vkr_null_texture_bytes(&texture->description));
+  if (!vkr_null_texture_publish_bytes(renderer, handle, bytes))
+    return false_v;
+  renderer->metrics.texture_upload_bytes += texture->upload_data_size;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_asset_publish_writable_texture(
+    void *state, VkrTextureHandle handle,
+    const VkrTextureDescription *description) {
+  VkrNullRenderer *renderer = state;
+  if (!renderer || !description)
+    return false_v;
+  return vkr_null_texture_publish_bytes(renderer, handle,
+                                        vkr_null_texture_bytes(description));
+}
+
+vkr_internal bool8_t vkr_null_asset_update_texture_sampler(
+    void *state, VkrTextureHandle handle,
+    const VkrTextureDescription *description) {
+  VkrNullRenderer *renderer = state;
+  if (!renderer || !description || description->id != handle.id ||
+      description->generation != handle.generation ||
+      !vkr_null_live_texture(renderer, handle))
+    return false_v;
+  renderer->metrics.sampler_updates++;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_queue_ibl_bake(VkrNullRenderer *renderer,
+                                             VkrTextureHandle equirect,
+                                             VkrTextureHandle source,
+                                             VkrTextureHandle irradiance,
+                                             VkrTextureHandle prefilter,
+                                             bool8_t convert_equirect) {
+  if (!renderer || !vkr_null_live_texture(renderer, source) ||
+      !vkr_null_live_texture(renderer, irradiance) ||
+      !vkr_null_live_texture(renderer, prefilter) ||
+      (convert_equirect && !vkr_null_live_texture(renderer, equirect)))
+    return false_v;
+  renderer->pending_ibl_bake_count++;
+  if (convert_equirect)
+    renderer->metrics.hdr_environment_bakes++;
+  else
+    renderer->metrics.ibl_bakes++;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_asset_bake_ibl_cubemap(
+    void *state, VkrTextureHandle source, VkrTextureHandle irradiance,
+    VkrTextureHandle prefilter) {
+  return vkr_null_queue_ibl_bake(state, VKR_TEXTURE_HANDLE_INVALID, source,
+                                 irradiance, prefilter, false_v);
+}
+
+vkr_internal bool8_t vkr_null_asset_bake_hdr_environment(
+    void *state, VkrTextureHandle equirect, VkrTextureHandle source,
+    VkrTextureHandle irradiance, VkrTextureHandle prefilter) {
+  return vkr_null_queue_ibl_bake(state, equirect, source, irradiance,
+                                 prefilter, true_v);
+}
+
+vkr_internal bool8_t vkr_null_asset_unpublish_texture(void *state,
+                                                      VkrTextureHandle handle) {
+  VkrNullRenderer *renderer = state;
+  VkrNullPublication *record =
+      renderer ? vkr_null_live_texture(renderer, handle) : NULL;
+  if (!record ||
+      !vkr_null_retire(renderer, VKR_NULL_RETIREMENT_TEXTURE, record->bytes))
+    return false_v;
+  record->live = false_v;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_asset_publish_material(
+    void *state, VkrMaterialHandle handle, const VkrMaterial *material) {
+  VkrNullRenderer *renderer = state;
+  VkrNullPublication *record =
+      renderer ? vkr_null_publication(renderer->materials,
+                                      renderer->config.material_capacity,
+                                      handle.id)
+               : NULL;
+  if (!record || !material || material->id != handle.id ||
+      material->generation != handle.generation)
+    return false_v;
+  VkrRendererImplMaterialMetrics *rows = &renderer->metrics.materials;
+  if (record->live) {
+    if (record->generation != handle.generation) {
+      rows->stale_handle_failures++;
+      return false_v;
+    }
+    // Replacement writes a fresh row; the previous one stays readable by
+    // in-flight frames until it retires.
+    if (!vkr_null_retire(renderer, VKR_NULL_RETIREMENT_MATERIAL, 0u))
+      return false_v;
+    rows->rows_replaced++;
+  } else {
+    rows->rows_live++;
+    rows->rows_peak = Max(rows->rows_peak, rows->rows_live);
+  }
+  *record = (VkrNullPublication){
+      .generation = handle.generation,
+      .live = true_v,
+  };
+  rows->rows_published++;
+  renderer->metrics.material_publications++;
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_null_asset_unpublish_material(
+    void *state, VkrMaterialHandle handle) {
+  VkrNullRenderer *renderer = state;
+  VkrNullPublication *record =
+      renderer ? vkr_null_publication(renderer->materials,
+                                      renderer->config.material_capacity,
+                                      handle.id)
+               : NULL;
+  if (!record || !record->live || record->generation != handle.generation ||
+      !vkr_null_retire(renderer, VKR_NULL_RETIREMENT_MATERIAL, 0u))
+    return false_v;
+  record->live = false_v;
+  renderer->metrics.materials.rows_live -=
+      Min(renderer->metrics.materials.rows_live, 1u);
+  return true_v;
+}
+
+void vkr_null_renderer_get_asset_publisher(VkrNullRenderer *renderer,
+                                           VkrAssetPublisher *out_publisher) {
+  if (!out_publisher)
+    return;
+  if (!renderer) {
+    *out_publisher = (VkrAssetPublisher){0};
+    return;
+  }
+  *out_publisher = (VkrAssetPublisher){
+      .state = renderer,
+      .publications_idle = vkr_null_asset_publications_idle,
+      .publish_geometry = vkr_null_asset_publish_geometry,
+      .publish_loaded_mesh = vkr_null_asset_publish_loaded_mesh,
+      .unpublish_geometry = vkr_null_asset_unpublish_geometry,
+      .publish_texture = vkr_null_asset_publish_texture,
+      .publish_writable_texture = vkr_null_asset_publish_writable_texture,
+      .update_texture_sampler = vkr_null_asset_update_texture_sampler,
+      .bake_ibl_cubemap = vkr_null_asset_bake_ibl_cubemap,
+      .bake_hdr_environment = vkr_null_asset_bake_hdr_environment,
+      .unpublish_texture = vkr_null_asset_unpublish_texture,
+      .publish_material = vkr_null_asset_publish_material,
+      .unpublish_material = vkr_null_asset_unpublish_material,
+  };
+}
+
+// =============================================================================
+// Render graph
+// =============================================================================
+
+vkr_internal void vkr_null_graph_execute(VkrRgPassContext *ctx,
+                                         void *user_data) {
+  (void)ctx;
+  VkrNullRenderer *renderer = user_data;
+  renderer->frame_executor_calls++;
+}
+
+/**
+ * Registers one no-op executor per distinct authored `execute` name, typed
+ * from the first pass that names it. Binding then rejects any later pass that
+ * disagrees, exactly as it would against a device backend's table.
+ */
+vkr_internal bool8_t vkr_null_register_graph_executors(
+    VkrNullRenderer *renderer) {
+  uint32_t executor_id = 1u;
+  for (uint64_t i = 0u; i < renderer->json_graph.passes.length; ++i) {
+    const VkrRgJsonPass *pass =
+        vector_get_VkrRgJsonPass(&renderer->json_graph.passes, i);
+    if (vkr_rg_executor_registry_find(&renderer->executors, pass->execute))
+      continue;
+    const VkrRgPassExecutor executor = {
+        .name = pass->execute,
+        .id = executor_id++,
+        .type = (VkrRgPassType)pass->type,
+        .execute = vkr_null_graph_execute,
+        .user_data = renderer,
+    };
+    if (!vkr_rg_executor_registry_register(&renderer->executors, &executor))
+      return false_v;
+  }
+  return true_v;
+}
+
+/** Graph-owned image bytes for this frame; imported targets are excluded. */
+vkr_internal void vkr_null_update_graph_stats(VkrNullRenderer *renderer) {
+  VkrRenderGraphResourceStats *stats = &renderer->graph_stats;
+  stats->live_image_textures = 0u;
+  stats->live_image_bytes = 0u;
+  stats->live_buffers = 0u;
+  stats->live_buffer_bytes = 0u;
+  for (uint64_t i = 0u; i < renderer->graph->images.length; ++i) {
+    const VkrRgImage *image =
+        vector_get_VkrRgImage(&renderer->graph->images, i);
+    if (image->imported || !image->declared_this_frame)
+      continue;
+    VkrTextureFormatInfo format = {0};
+    if (!vkr_texture_format_get_info(image->desc.format, &format) ||
+        format.block_width != 1u || format.block_height != 1u)
+      continue;
+    uint64_t texels = 0u;
+    for (uint32_t mip = 0u; mip < Max(image->desc.mip_levels, 1u); ++mip) {
+      texels += (uint64_t)Max(image->desc.width >> mip, 1u) *
+                Max(image->desc.height >> mip, 1u);
+    }
+    stats->live_image_textures++;
+    stats->live_image_bytes += texels * Max(image->desc.layers, 1u) *
+                               Max((uint32_t)image->desc.samples, 1u) *
+                               format.bytes_per_block;
+  }
+  for (uint64_t i = 0u; i < renderer->graph->buffers.length; ++i) {
+    const VkrRgBuffer *buffer =
+        vector_get_VkrRgBuffer(&renderer->graph->buffers, i);
+    if (buffer->imported || !buffer->declared_this_frame)
+      continue;
+    stats->live_buffers++;
+    stats->live_buffer_bytes += buffer->desc.size;
+  }
+  stats->peak_image_textures =
+      Max(stats->peak_image_textures, stats->live_image_textures);
+  stats->peak_image_bytes =
+      Max(stats->peak_image_bytes, stats->live_image_bytes);
+  stats->peak_buffers = Max(stats->peak_buffers, stats->live_buffers);
+  stats->peak_buffer_bytes =
+      Max(stats->peak_buffer_bytes, stats->live_buffer_bytes);
+}
+
+/** Walks the compiled schedule in order, timing each no-op executor. */
+vkr_internal void vkr_null_execute_schedule(VkrNullRenderer *renderer,
+                                            VkrNullResult *result) {
+  VkrRenderGraph *graph = renderer->graph;
+  renderer->frame_executor_calls = 0u;
+  for (uint64_t i = 0u; i < graph->passes.length; ++i) {
+    if (vector_get_VkrRgPass(&graph->passes, i)->culled)
+      result->culled_pass_count++;
+  }
+  for (uint64_t order = 0u; order < graph->execution_order.length; ++order) {
+    const uint32_t pass_index =
+        *vector_get_uint32_t(&graph->execution_order, order);
+    const VkrRgPass *pass = vector_get_VkrRgPass(&graph->passes, pass_index);
+    const float64_t cpu_begin = vkr_platform_get_absolute_time();
+    result->image_barrier_count += (uint32_t)pass->pre_image_barriers.length;
+    result->buffer_barrier_count += (uint32_t)pass->pre_buffer_barriers.length;
+    if (pass->desc.execute) {
+      VkrRgPassContext ctx = {
+          .graph = graph,
+          .pass_desc = &pass->desc,
+          .pass_index = pass_index,
+          .frame_index = renderer->prepared_frame.frame_index,
+          .image_index = renderer->prepared_frame.image_index,
+          .delta_time = renderer->prepared_frame.delta_time,
+      };
+      pass->desc.execute(&ctx, pass->desc.user_data);
+    }
+    result->executed_pass_count++;
+    if (result->pass_timing_count < VKR_RENDERER_IMPL_MAX_PASS_TIMINGS) {
+      VkrRendererImplPassTiming *timing =
+          &result->pass_timings[result->pass_timing_count++];
+      MemZero(timing, sizeof(*timing));
+      const uint64_t length =
+          Min(pass->desc.name.length,
+              (uint64_t)VKR_RENDERER_IMPL_TIMING_NAME_CAPACITY - 1u);
+      if (length > 0u)
+        MemCopy(timing->name, pass->desc.name.str, length);
+      timing->name[length] = '\0';
+      timing->pass_index = pass_index;
+      timing->cpu_ms = (vkr_platform_get_absolute_time() - cpu_begin) * 1000.0;
+    }
+  }
+  result->image_barrier_count +=
+      (uint32_t)graph->terminal_image_barriers.length;
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+bool8_t vkr_null_renderer_create(const VkrNullRendererConfig *config,
+                                 VkrNullRenderer **out_renderer) {
+  if (!out_renderer)
+    return false_v;
+  *out_renderer = NULL;
+  if (!config || !config->allocator || !config->width || !config->height ||
+      !config->image_count || !config->geometry_capacity ||
+      !config->texture_capacity || !config->material_capacity ||
+      config->gpu_latency_frames >= VKR_NULL_FRAME_SLOT_COUNT) {
+    log_error("Invalid null renderer configuration (extent=%ux%u, "
+              "images=%u, latency=%u)",
+              config ? config->width : 0u, config ? config->height : 0u,
+              config ? config->image_count : 0u,
+              config ? config->gpu_latency_frames : 0u);
+    return false_v;
+  }
+  VkrNullRenderer *renderer = vkr_allocator_alloc(
+      config->allocator, sizeof(*renderer), VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  if (!renderer)
+    return false_v;
+  MemZero(renderer, sizeof(*renderer));
+  renderer->allocator = config->allocator;
+  renderer->config = *config;
+  if (!renderer->config.graph_path)
+    renderer->config.graph_path = "assets/render_graphs/main.rendergraph.json";
+  if (!renderer->config.max_graph_passes)
+    renderer->config.max_graph_passes = 64u;
+  if (!renderer->config.retirement_capacity)
+    renderer->config.retirement_capacity = config->geometry_capacity +
+                                           config->texture_capacity +
+                                           config->material_capacity;
+
+  renderer->geometries = vkr_allocator_alloc(
+      renderer->allocator,
+      (uint64_t)config->geometry_capacity * sizeof(*renderer->geometries),
+      VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  renderer->textures = vkr_allocator_alloc(
+      renderer->allocator,
+      (uint64_t)config->texture_capacity * sizeof(*renderer->textures),
+      VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  renderer->materials = vkr_allocator_alloc(
+      renderer->allocator,
+      (uint64_t)config->material_capacity * sizeof(*renderer->materials),
+      VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  renderer->retirements =
+      vkr_allocator_alloc(renderer->allocator,
+                          (uint64_t)renderer->config.retirement_capacity *
+                              sizeof(*renderer->retirements),
+                          VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  if (!renderer->geometries || !renderer->textures || !renderer->materials ||
+      !renderer->retirements) {
+    log_error("Null renderer failed to allocate publication records");
+    vkr_null_renderer_destroy(renderer);
+    return false_v;
+  }
+  MemZero(renderer->geometries,
+          (uint64_t)config->geometry_capacity * sizeof(*renderer->geometries));
+  MemZero(renderer->textures,
+          (uint64_t)config->texture_capacity * sizeof(*renderer->textures));
+  MemZero(renderer->materials,
+          (uint64_t)config->material_capacity * sizeof(*renderer->materials));
+
+  renderer->graph_frame_arena = arena_create(MB(8), KB(256));
+  renderer->graph_frame_allocator =
+      (VkrAllocator){.ctx = renderer->graph_frame_arena};
+  const bool8_t graph_source_ready =
+      renderer->graph_frame_arena &&
+      vkr_allocator_arena(&renderer->graph_frame_allocator) &&
+      vkr_rg_executor_registry_init(&renderer->executors,
+                                    renderer->allocator) &&
+      vkr_rg_json_load_file(renderer->allocator, renderer->config.graph_path,
+                            &renderer->json_graph) &&
+      vkr_null_register_graph_executors(renderer) &&
+      vkr_rg_json_bind_executors(&renderer->json_graph, &renderer->executors);
+  renderer->graph =
+      graph_source_ready ? vkr_rg_create(renderer->allocator) : NULL;
+  if (!renderer->graph ||
+      !vkr_rg_set_frame_allocator(renderer->graph,
+                                  &renderer->graph_frame_allocator)) {
+    log_error("Null renderer failed to initialize the authored render graph");
+    vkr_null_renderer_destroy(renderer);
+    return false_v;
+  }
+  *out_renderer = renderer;
+  return true_v;
+}
+
+void vkr_null_renderer_destroy(VkrNullRenderer *renderer) {
+  if (!renderer)
+    return;
+  VkrAllocator *allocator = renderer->allocator;
+  if (renderer->retirements) {
+    vkr_allocator_free(allocator, renderer->retirements,
+                       (uint64_t)renderer->config.retirement_capacity *
+                           sizeof(*renderer->retirements),
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+  if (renderer->materials) {
+    vkr_allocator_free(allocator, renderer->materials,
+                       (uint64_t)renderer->config.material_capacity *
+                           sizeof(*renderer->materials),
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+  if (renderer->textures) {
+    vkr_allocator_free(allocator, renderer->textures,
+                       (uint64_t)renderer->config.texture_capacity *
+                           sizeof(*renderer->textures),
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+  if (renderer->geometries) {
+    vkr_allocator_free(allocator, renderer->geometries,
+                       (uint64_t)renderer->config.geometry_capacity *
+                           sizeof(*renderer->geometries),
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+  if (renderer->graph)
+    vkr_rg_destroy(renderer->graph);
+  if (renderer->graph_frame_arena)
+    arena_destroy(renderer->graph_frame_arena);
+  vkr_rg_json_destroy(&renderer->json_graph);
+  vkr_rg_executor_registry_destroy(&renderer->executors);
+  vkr_allocator_free(allocator, renderer, sizeof(*renderer),
+                     VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+}
+
+// =============================================================================
+// Frame path
+// =============================================================================
+
+bool8_t vkr_null_renderer_prepare_frame(VkrNullRenderer *renderer,
+                                        const VkrRenderGraphFrameInfo *frame,
+                                        VkrFrameSetup *out_setup) {
+  if (!renderer || !frame || !out_setup || renderer->frame_active)
+    return false_v;
+  vkr_null_collect_retirements(renderer);
+  renderer->frame_slot =
+      (uint32_t)(renderer->submit_value % VKR_NULL_FRAME_SLOT_COUNT);
+  renderer->prepared_frame = *frame;
+  renderer->prepared_frame.image_index =
+      (uint32_t)(renderer->submit_value % renderer->config.image_count);
+  renderer->prepared_frame.target_width = renderer->config.width;
+  renderer->prepared_frame.target_height = renderer->config.height;
+  renderer->prepared_frame.window_width = renderer->config.width;
+  renderer->prepared_frame.window_height = renderer->config.height;
+  renderer->prepared_frame.viewport_width = renderer->config.width;
+  renderer->prepared_frame.viewport_height = renderer->config.height;
+  renderer->source_frame_index = frame->frame_index;
+  renderer->frame_active = true_v;
+  *out_setup = (VkrFrameSetup){
+      .image_index = renderer->prepared_frame.image_index,
+      .window_width = renderer->config.width,
+      .window_height = renderer->config.height,
+      .swapchain_format = frame->target_color_format,
+      .swapchain_depth_format = frame->target_depth_format,
+  };
+  return true_v;
+}
+
+bool8_t vkr_null_renderer_submit_packet(VkrNullRenderer *renderer,
+                                        const VkrRenderPacket *packet,
+                                        VkrNullResult *out_result) {
+  if (!renderer || !packet || !renderer->frame_active)
+    return false_v;
+  VkrRenderGraphFrameInfo *frame = &renderer->prepared_frame;
+  frame->editor_enabled = packet->frame.editor_enabled;
+  frame->picking_pending = packet->picking && packet->picking->pending;
+  frame->transmission_pending =
+      packet->world && packet->world->transmission_gpu_candidate_count > 0u;
+  frame->transmission_compact_enabled = false_v;
+  frame->timing_enabled = packet->debug && packet->debug->enable_timing &&
+                          packet->debug->capture_pass_timestamps;
+  frame->shadow_cascade_count =
+      packet->shadow
+          ? Min(packet->shadow->cascade_count, VKR_SHADOW_CASCADE_COUNT_MAX)
+          : 0u;
+  uint32_t hzb_mip_count = 1u;
+  uint32_t hzb_extent = Max(frame->viewport_width, frame->viewport_height);
+  while (hzb_extent > 1u) {
+    hzb_extent >>= 1u;
+    hzb_mip_count++;
+  }
+  frame->hzb_reduce_pass_count = hzb_mip_count - 1u;
+
+  vkr_rg_begin_frame(renderer->graph, frame);
+  vkr_rg_set_packet(renderer->graph, packet);
+  if (!vkr_rg_build_from_json(renderer->graph, &renderer->json_graph, frame) ||
+      !vkr_rg_compile_schedule(renderer->graph)) {
+    log_error("Null renderer failed to build the authored render graph");
+    vkr_null_renderer_cancel_frame(renderer);
+    return false_v;
+  }
+  if (renderer->graph->passes.length > renderer->config.max_graph_passes) {
+    log_error("Null renderer authored graph exceeds %u passes (%llu)",
+              renderer->config.max_graph_passes,
+              (unsigned long long)renderer->graph->passes.length);
+    vkr_null_renderer_cancel_frame(renderer);
+    return false_v;
+  }
+
+  VkrNullResult *result = &renderer->slot_results[renderer->frame_slot];
+  MemZero(result, sizeof(*result));
+  vkr_null_execute_schedule(renderer, result);
+  vkr_null_update_graph_stats(renderer);
+  vkr_rg_end_frame(renderer->graph);
+
+  const uint64_t signal_value = renderer->submit_value + 1u;
+  result->submit_value = signal_value;
+  result->source_frame_index = renderer->source_frame_index;
+  renderer->submit_value = signal_value;
+  if (signal_value > renderer->config.gpu_latency_frames)
+    renderer->completed_value = Max(
+        renderer->completed_value,
+        signal_value - renderer->config.gpu_latency_frames);
+  renderer->pending_ibl_bake_count = 0u;
+  renderer->frame_active = false_v;
+
+  VkrNullRendererMetrics *metrics = &renderer->metrics;
+  metrics->graph_builds++;
+  metrics->passes_executed += result->executed_pass_count;
+  metrics->passes_culled += result->culled_pass_count;
+  metrics->image_barriers += result->image_barrier_count;
+  metrics->buffer_barriers += result->buffer_barrier_count;
+  vkr_null_collect_retirements(renderer);
+  if (out_result)
+    *out_result = *result;
+  return true_v;
+}
+
+bool8_t vkr_null_renderer_poll_result(VkrNullRenderer *renderer,
+                                      uint64_t after_submit_value,
+                                      VkrNullResult *out_result) {
+  if (!renderer || !out_result)
+    return false_v;
+  const VkrNullResult *best = NULL;
+  for (uint32_t i = 0u; i < VKR_NULL_FRAME_SLOT_COUNT; ++i) {
+    const VkrNullResult *result = &renderer->slot_results[i];
+    if (result->submit_value <= after_submit_value ||
+        result->submit_value > renderer->completed_value)
+      continue;
+    if (!best || result->submit_value > best->submit_value)
+      best = result;
+  }
+  if (!best)
+    return false_v;
+  *out_result = *best;
+  return true_v;
+}
+
+void vkr_null_renderer_cancel_frame(VkrNullRenderer *renderer) {
+  if (!renderer)
+    return;
+  renderer->frame_active = false_v;
+  vkr_rg_end_frame(renderer->graph);
+}
+
+bool8_t vkr_null_renderer_resize(VkrNullRenderer *renderer, uint32_t width,
+                                 uint32_t height, uint32_t image_count) {
+  if (!renderer || renderer->frame_active || !width || !height ||
+      !image_count)
+    return false_v;
+  renderer->config.width = width;
+  renderer->config.height = height;
+  renderer->config.image_count = image_count;
+  return true_v;
+}
+
+bool8_t vkr_null_renderer_wait_idle(VkrNullRenderer *renderer) {
+  if (!renderer)
+    return false_v;
+  renderer->completed_value = renderer->submit_value;
+  vkr_null_collect_retirements(renderer);
+  return true_v;
+}
+
+uint64_t vkr_null_renderer_submit_value(const VkrNullRenderer *renderer) {
+  return renderer ? renderer->submit_value : 0u;
+}
+
+uint64_t vkr_null_renderer_completed_value(const VkrNullRenderer *renderer) {
+  return renderer ? renderer->completed_value : 0u;
+}
+
+uint32_t vkr_null_renderer_frame_slot(const VkrNullRenderer *renderer) {
+  return renderer ? renderer->frame_slot : 0u;
+}
+
+void vkr_null_renderer_metrics(const VkrNullRenderer *renderer,
+                               VkrNullRendererMetrics *out_metrics) {
+  if (!out_metrics)
+    return;
+  *out_metrics = renderer ? renderer->metrics : (VkrNullRendererMetrics){0};
+  if (!renderer)
+    return;
+  VkrRendererImplSlotTableMetrics *materials =
+      &out_metrics->memory.slot_tables[VKR_RENDERER_IMPL_SLOT_TABLE_MATERIAL];
+  materials->live = renderer->metrics.materials.rows_live;
+  materials->peak = renderer->metrics.materials.rows_peak;
+  materials->capacity = renderer->config.material_capacity;
+  materials->published = renderer->metrics.materials.rows_published;
+  materials->retired = renderer->metrics.materials.rows_retired;
+  materials->collected = renderer->metrics.materials.rows_collected;
+}
+
+bool8_t vkr_null_renderer_graph_resource_stats(
+    const VkrNullRenderer *renderer, VkrRenderGraphResourceStats *out_stats) {
+  if (!renderer || !out_stats)
+    return false_v;
+  *out_stats = renderer->graph_stats;
+  return true_v;
+}
+
+VkrAllocator *vkr_null_renderer_allocator(VkrNullRenderer *renderer) {
+  return renderer ? renderer->allocator : NULL;
+}
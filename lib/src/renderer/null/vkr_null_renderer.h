@@ -0,0 +1,111 @@
+#pragma once
+
+#include "renderer/vkr_asset_publisher.h"
+#include "renderer/vkr_render_graph.h"
+#include "renderer/vkr_render_packet.h"
+#include "renderer/vkr_renderer_impl.h"
+
+/**
+ * Headless renderer that runs the shared frame path without a device.
+ *
+ * Publications are accounted as if they were uploaded to device memory, a
+ * submit completes `gpu_latency_frames` submits later, and the authored graph
+ * is built, compiled, and walked in schedule order with every pass executor
+ * reduced to a counting no-op. What remains is the CPU cost of the frontend,
+ * graph compilation, and publication bookkeeping, which is what the null
+ * backend exists to measure.
+ */
+enum {
+  VKR_NULL_FRAME_SLOT_COUNT = 3,
+};
+
+typedef struct VkrNullRenderer VkrNullRenderer;
+
+typedef struct VkrNullRendererConfig {
+  VkrAllocator *allocator;
+  const char *graph_path;
+  uint32_t width;
+  uint32_t height;
+  uint32_t image_count;
+  /** Logical IDs admitted by the publisher; records are indexed by id. */
+  uint32_t geometry_capacity;
+  uint32_t texture_capacity;
+  uint32_t material_capacity;
+  /** Unpublished resources awaiting their last submit's completion. */
+  uint32_t retirement_capacity;
+  /**
+   * Submits a frame stays in flight before it reads as completed. Zero
+   * completes every submit immediately; must stay below
+   * VKR_NULL_FRAME_SLOT_COUNT so a frame slot is never reused while busy.
+   */
+  uint32_t gpu_latency_frames;
+  uint32_t max_graph_passes;
+} VkrNullRendererConfig;
+
+typedef struct VkrNullResult {
+  uint64_t submit_value;
+  uint64_t source_frame_index;
+  uint32_t executed_pass_count;
+  uint32_t culled_pass_count;
+  uint32_t image_barrier_count;
+  uint32_t buffer_barrier_count;
+  uint32_t pass_timing_count;
+  VkrRendererImplPassTiming pass_timings[VKR_RENDERER_IMPL_MAX_PASS_TIMINGS];
+} VkrNullResult;
+
+/** Cumulative publication and upload accounting since creation. */
+typedef struct VkrNullRendererMetrics {
+  uint64_t geometry_upload_bytes;
+  uint64_t texture_upload_bytes;
+  uint64_t geometry_publications;
+  uint64_t texture_publications;
+  uint64_t material_publications;
+  uint64_t ibl_bakes;
+  uint64_t hdr_environment_bakes;
+  uint64_t sampler_updates;
+  uint64_t retirements_pending;
+  uint64_t graph_builds;
+  uint64_t passes_executed;
+  uint64_t passes_culled;
+  uint64_t image_barriers;
+  uint64_t buffer_barriers;
+  VkrRendererImplMemoryMetrics memory;
+  VkrRendererImplMaterialMetrics materials;
+} VkrNullRendererMetrics;
+
+/** On failure, releases partial state and leaves `*out_renderer` null. */
+bool8_t vkr_null_renderer_create(const VkrNullRendererConfig *config,
+                                 VkrNullRenderer **out_renderer);
+void vkr_null_renderer_destroy(VkrNullRenderer *renderer);
+
+/**
+ * Opens a frame. `frame` supplies the per-frame graph inputs the frontend
+ * owns; target extent and formats are overwritten from the renderer's own
+ * target so the graph sees the same values every frame.
+ */
+bool8_t vkr_null_renderer_prepare_frame(VkrNullRenderer *renderer,
+                                        const VkrRenderGraphFrameInfo *frame,
+                                        VkrFrameSetup *out_setup);
+bool8_t vkr_null_renderer_submit_packet(VkrNullRenderer *renderer,
+                                        const VkrRenderPacket *packet,
+                                        VkrNullResult *out_result);
+/** Latest completed result newer than `after_submit_value`, if any. */
+bool8_t vkr_null_renderer_poll_result(VkrNullRenderer *renderer,
+                                      uint64_t after_submit_value,
+                                      VkrNullResult *out_result);
+void vkr_null_renderer_cancel_frame(VkrNullRenderer *renderer);
+bool8_t vkr_null_renderer_resize(VkrNullRenderer *renderer, uint32_t width,
+                                 uint32_t height, uint32_t image_count);
+
+/** Completes every outstanding submit and collects all retirements. */
+bool8_t vkr_null_renderer_wait_idle(VkrNullRenderer *renderer);
+uint64_t vkr_null_renderer_submit_value(const VkrNullRenderer *renderer);
+uint64_t vkr_null_renderer_completed_value(const VkrNullRenderer *renderer);
+uint32_t vkr_null_renderer_frame_slot(const VkrNullRenderer *renderer);
+void vkr_null_renderer_metrics(const VkrNullRenderer *renderer,
+                               VkrNullRendererMetrics *out_metrics);
+bool8_t vkr_null_renderer_graph_resource_stats(
+    const VkrNullRenderer *renderer, VkrRenderGraphResourceStats *out_stats);
+VkrAllocator *vkr_null_renderer_allocator(VkrNullRenderer *renderer);
+void vkr_null_renderer_get_asset_publisher(VkrNullRenderer *renderer,
+                                           VkrAssetPublisher *out_publisher);
@@ -6,6 +6,7 @@
 #include "memory/vkr_arena_allocator.h"
 #include "memory/vkr_dmemory_allocator.h"
 #include "renderer/metal/vkr_metal_packet_renderer.h"
+#include "renderer/null/vkr_null_renderer.h"
 #include "renderer/resources/loaders/material_loader.h"
 #include "renderer/resources/loaders/scene_loader.h"
 #include "renderer/resources/loaders/texture_loader.h"
@@ -211,6 +212,7 @@ vkr_renderer_record_gpu_candidate_metrics(RendererFrontend *renderer,
 #define VKR_MESH_LOADER_ASYNC_DMEMORY_RESERVE MB(32)
 #define VKR_SCENE_LOADER_ASYNC_DMEMORY_INITIAL MB(8)
 #define VKR_SCENE_LOADER_ASYNC_DMEMORY_RESERVE MB(256)
+#define VKR_RENDERER_STREAMING_RESIDENT_BYTES MB(512)
 
 vkr_internal bool8_t
 renderer_frontend_validate_render_graph(RendererFrontend *rf);
@@ -319,6 +321,51 @@ static bool8_t
 renderer_impl_metal_poll_submit_result(void *state, uint64_t after_submit_value,
                                        VkrRendererImplSubmitResult *out_result);
 static VkrAllocator *renderer_impl_metal_allocator(void *state);
+static bool32_t
+renderer_impl_null_initialize(void *state, VkrWindow *window, uint32_t width,
+                              uint32_t height,
+                              VkrDeviceRequirements *device_requirements,
+                              const VkrRendererBackendConfig *backend_config,
+                              VkrRendererError *out_error);
+static void renderer_impl_null_destroy(void *state);
+static void renderer_impl_null_get_device_information(
+    void *state, VkrDeviceInformation *device_information, Arena *temp_arena);
+static VkrRendererError renderer_impl_null_wait_idle(void *state);
+static uint64_t renderer_impl_null_submit_serial(void *state);
+static uint64_t renderer_impl_null_completed_submit_serial(void *state);
+static bool8_t
+renderer_impl_null_upload_wait_stats(void *state,
+                                     VkrRendererUploadWaitStats *out_stats);
+static bool8_t renderer_impl_null_command_slot_waits(void *state,
+                                                     uint64_t *out_wait_count);
+static bool8_t
+renderer_impl_null_device_memory_stats(void *state,
+                                       VkrDeviceMemoryStats *out_stats);
+static bool8_t
+renderer_impl_null_memory_metrics(void *state,
+                                  VkrRendererImplMemoryMetrics *out_metrics);
+static VkrRendererError
+renderer_impl_null_prepare_frame(void *state, VkrFrameSetup *out_setup);
+static VkrRendererError
+renderer_impl_null_submit_packet(void *state, const VkrRenderPacket *packet,
+                                 VkrRendererFrameMetrics *out_metrics,
+                                 VkrValidationError *out_validation_error);
+static VkrRendererError renderer_impl_null_cancel_frame(void *state);
+static void renderer_impl_null_resize(void *state, uint32_t width,
+                                      uint32_t height);
+static VkrRendererError renderer_impl_null_present_target_recreate(
+    void *state, uint32_t width, uint32_t height, uint32_t image_count);
+static uint32_t renderer_impl_null_frame_in_flight_index(void *state);
+static VkrCaptureStatus
+renderer_impl_null_capture_poll(void *state, VkrCaptureRequestId request_id,
+                                VkrCapturePollResult *out_result);
+static bool8_t
+renderer_impl_null_capture_release(void *state,
+                                   VkrCaptureRequestId request_id);
+static bool8_t
+renderer_impl_null_poll_submit_result(void *state, uint64_t after_submit_value,
+                                      VkrRendererImplSubmitResult *out_result);
+static VkrAllocator *renderer_impl_null_allocator(void *state);
 
 static const VkrRendererImplOps renderer_impl_metal_ops = {
     .initialize = renderer_impl_metal_initialize,
@@ -368,9 +415,34 @@ static const VkrRendererImplOps renderer_impl_vulkan_ops = {
     .get_allocator = renderer_impl_vulkan_allocator,
 };
 
+static const VkrRendererImplOps renderer_impl_null_ops = {
+    .initialize = renderer_impl_null_initialize,
+    .destroy = renderer_impl_null_destroy,
+    .get_device_information = renderer_impl_null_get_device_information,
+    .wait_idle = renderer_impl_null_wait_idle,
+    .get_submit_serial = renderer_impl_null_submit_serial,
+    .get_completed_submit_serial = renderer_impl_null_completed_submit_serial,
+    .get_and_reset_upload_wait_stats = renderer_impl_null_upload_wait_stats,
+    .get_and_reset_command_slot_wait_count =
+        renderer_impl_null_command_slot_waits,
+    .get_device_memory_stats = renderer_impl_null_device_memory_stats,
+    .get_memory_metrics = renderer_impl_null_memory_metrics,
+    .prepare_frame = renderer_impl_null_prepare_frame,
+    .submit_packet = renderer_impl_null_submit_packet,
+    .cancel_frame = renderer_impl_null_cancel_frame,
+    .resize = renderer_impl_null_resize,
+    .present_target_recreate = renderer_impl_null_present_target_recreate,
+    .frame_in_flight_index = renderer_impl_null_frame_in_flight_index,
+    .capture_poll = renderer_impl_null_capture_poll,
+    .capture_release = renderer_impl_null_capture_release,
+    .poll_submit_result = renderer_impl_null_poll_submit_result,
+    .get_allocator = renderer_impl_null_allocator,
+};
+
 static const VkrRendererImplStrategies renderer_impl_strategies = {
     .metal = &renderer_impl_metal_ops,
     .vulkan = &renderer_impl_vulkan_ops,
+    .null = &renderer_impl_null_ops,
 };
 
 vkr_internal void
@@ -682,6 +754,8 @@ renderer_impl_vulkan_initialize(void *state, VkrWindow *window, uint32_t width,
   RendererFrontend *renderer = state;
   VkrVulkanRendererConfig config = {
       .allocator = &renderer->render_graph_allocator,
+      .job_system = backend_config->job_system,
+      .boot_metrics = backend_config->boot_metrics,
       .graph_path = "assets/render_graphs/main.rendergraph.json",
       .window = window,
       .target_kind = renderer->present_target.kind,
@@ -758,6 +832,47 @@ renderer_impl_vulkan_initialize(void *state, VkrWindow *window, uint32_t width,
   return true_v;
 }
 
+static bool32_t
+renderer_impl_null_initialize(void *state, VkrWindow *window, uint32_t width,
+                              uint32_t height,
+                              VkrDeviceRequirements *device_requirements,
+                              const VkrRendererBackendConfig *backend_config,
+                              VkrRendererError *out_error) {
+  (void)window;
+  (void)device_requirements;
+  (void)backend_config;
+  RendererFrontend *renderer = state;
+  const VkrNullRendererConfig config = {
+      .allocator = &renderer->render_graph_allocator,
+      .graph_path = "assets/render_graphs/main.rendergraph.json",
+      .width = width,
+      .height = height,
+      .image_count = renderer->present_target.image_count
+                         ? renderer->present_target.image_count
+                         : renderer->impl.caps.present_target_image_count,
+      // Same logical ID spaces the Vulkan publisher admits, so one scene
+      // publishes identically on either strategy.
+      .geometry_capacity = 16384u,
+      .texture_capacity = 16384u,
+      .material_capacity = 8192u,
+      // Completing two submits behind keeps deferred retirement and timing
+      // readback on the same one-frame-late path a device backend takes.
+      .gpu_latency_frames = 2u,
+      .max_graph_passes = 64u,
+  };
+  if (!vkr_null_renderer_create(&config, &renderer->null_renderer)) {
+    *out_error = VKR_RENDERER_ERROR_BACKEND_NOT_SUPPORTED;
+    return false_v;
+  }
+  vkr_null_renderer_get_asset_publisher(renderer->null_renderer,
+                                        &renderer->asset_publisher);
+  renderer->last_window_width = width;
+  renderer->last_window_height = height;
+  *out_error = VKR_RENDERER_ERROR_NONE;
+  log_info("Selected null renderer (%ux%u, no device)", width, height);
+  return true_v;
+}
+
 bool32_t vkr_renderer_initialize(VkrRendererFrontendHandle renderer,
                                  VkrRendererBackendType backend_type,
                                  VkrWindow *window, EventManager *event_manager,
@@ -842,6 +957,7 @@ bool32_t vkr_renderer_initialize(VkrRendererFrontendHandle renderer,
   renderer->frame_active = false;
   renderer->metal_renderer = NULL;
   renderer->vulkan_renderer = NULL;
+  renderer->null_renderer = NULL;
   renderer->asset_publisher = (VkrAssetPublisher){0};
   renderer->timing_result = (VkrRendererImplSubmitResult){0};
   renderer->timing_last_completed_submit_value = 0;
@@ -981,6 +1097,8 @@ void vkr_renderer_destroy(VkrRendererFrontendHandle renderer) {
   }
 
   vkr_lighting_system_shutdown(&rf->lighting_system);
+  // Unload cached streamed resources while their owning systems are alive.
+  vkr_resource_system_set_streaming_config(&(VkrResourceStreamingConfig){0});
   /* Renderer-only initialization is a supported focused-backend path, and
 
    * system initialization can fail partway through. These two shutdown
@@ -1086,9 +1204,10 @@ static void vkr_renderer_prepare_packet(RendererFrontend *rf,
   }
   if (rf->ui_system.initialized) {
     prepared->ui = packet->ui ? *packet->ui : (VkrUiPassPayload){0};
+    const bool8_t picking = packet->picking && packet->picking->pending;
     const uint32_t text_draw_count = vkr_ui_system_prepare_text_draws(
         rf, &rf->ui_system, prepared->ui_text_draws,
-        VKR_PREPARED_TEXT_DRAW_MAX);
+        VKR_PREPARED_TEXT_DRAW_MAX, !picking, &rf->frame_metrics.ui);
     if (text_draw_count) {
       prepared->ui.text_draws = prepared->ui_text_draws;
       prepared->ui.text_draw_count = text_draw_count;
@@ -1992,6 +2111,34 @@ vkr_renderer_validate_draw_ranges(const VkrDrawItem *draws, uint32_t draw_count,
   return VKR_RENDERER_ERROR_NONE;
 }
 
+static VkrRendererError vkr_renderer_validate_instance_runs(
+    const VkrWorldInstanceRun *runs, uint32_t run_count,
+    uint32_t candidate_count, const char *field, const char *count_field,
+    VkrValidationError *out_error) {
+  const VkrRendererError array_error = vkr_renderer_validate_packet_array(
+      runs, run_count, candidate_count, field, count_field, out_error);
+  if (array_error != VKR_RENDERER_ERROR_NONE)
+    return array_error;
+  if (run_count == 0u)
+    return VKR_RENDERER_ERROR_NONE;
+  // Backends walk runs instead of rows, so runs must cover every row once.
+  uint32_t next_candidate = 0u;
+  for (uint32_t i = 0u; i < run_count; ++i) {
+    const VkrWorldInstanceRun *run = &runs[i];
+    if (run->first_candidate != next_candidate || run->instance_count == 0u ||
+        run->instance_count > candidate_count - next_candidate)
+      return vkr_renderer_validation_fail(
+          out_error, VKR_RENDERER_ERROR_UNSUPPORTED_INPUT, field,
+          "must tile the candidate array in order");
+    next_candidate += run->instance_count;
+  }
+  if (next_candidate != candidate_count)
+    return vkr_renderer_validation_fail(
+        out_error, VKR_RENDERER_ERROR_UNSUPPORTED_INPUT, field,
+        "must tile the candidate array in order");
+  return VKR_RENDERER_ERROR_NONE;
+}
+
 static VkrRendererError vkr_renderer_validate_text_draws(
     const VkrPreparedTextDraw *draws, uint32_t draw_count, const char *field,
     const char *count_field, VkrValidationError *out_error) {
@@ -2302,6 +2449,20 @@ vkr_renderer_validate_packet(const VkrRenderPacket *packet,
         "packet.world.transmission_gpu_candidate_count", out_validation_error);
     if (error != VKR_RENDERER_ERROR_NONE)
       return error;
+    error = vkr_renderer_validate_instance_runs(
+        world->gpu_instance_runs, world->gpu_instance_run_count,
+        world->gpu_candidate_count, "packet.world.gpu_instance_runs",
+        "packet.world.gpu_instance_run_count", out_validation_error);
+    if (error != VKR_RENDERER_ERROR_NONE)
+      return error;
+    error = vkr_renderer_validate_instance_runs(
+        world->transmission_instance_runs,
+        world->transmission_instance_run_count,
+        world->transmission_gpu_candidate_count,
+        "packet.world.transmission_instance_runs",
+        "packet.world.transmission_instance_run_count", out_validation_error);
+    if (error != VKR_RENDERER_ERROR_NONE)
+      return error;
     if (world->gpu_camera_opaque_candidate_count > world->gpu_candidate_count)
       VKR_REJECT_PACKET(VKR_RENDERER_ERROR_UNSUPPORTED_INPUT,
                         "packet.world.gpu_camera_opaque_candidate_count",
@@ -2476,6 +2637,12 @@ vkr_renderer_submit_packet(VkrRendererFrontendHandle renderer,
     }
     return validation_error;
   }
+  if (packet->world && renderer->mesh_manager.arena) {
+    // Pending mesh loads are served nearest and largest on screen first.
+    vkr_mesh_manager_update_streaming(&renderer->mesh_manager,
+                                      packet->globals.view_position,
+                                      &packet->globals.projection);
+  }
   return renderer->impl.ops->submit_packet(renderer->impl.state, packet,
                                            out_metrics, out_validation_error);
 }
@@ -2644,6 +2811,295 @@ static VkrAllocator *renderer_impl_vulkan_allocator(void *state) {
   return vkr_vulkan_renderer_allocator(renderer->vulkan_renderer);
 }
 
+// =============================================================================
+// Null strategy
+// =============================================================================
+
+static void renderer_impl_null_destroy(void *state) {
+  RendererFrontend *renderer = state;
+  vkr_null_renderer_destroy(renderer->null_renderer);
+  renderer->null_renderer = NULL;
+}
+
+static void renderer_impl_null_get_device_information(
+    void *state, VkrDeviceInformation *device_information, Arena *temp_arena) {
+  (void)temp_arena;
+  RendererFrontend *renderer = state;
+  VkrDeviceTypeFlags device_types = bitset8_create();
+  VkrDeviceQueueFlags device_queues = bitset8_create();
+  VkrSamplerFilterFlags sampler_filters = bitset8_create();
+  bitset8_set(&device_types, VKR_DEVICE_TYPE_CPU_BIT);
+  bitset8_set(&device_queues, VKR_DEVICE_QUEUE_GRAPHICS_BIT);
+  bitset8_set(&device_queues, VKR_DEVICE_QUEUE_COMPUTE_BIT);
+  bitset8_set(&device_queues, VKR_DEVICE_QUEUE_TRANSFER_BIT);
+  bitset8_set(&sampler_filters, VKR_SAMPLER_FILTER_LINEAR_BIT);
+  *device_information = (VkrDeviceInformation){
+      .device_name = string8_lit("Null renderer"),
+      .vendor_name = string8_lit("None"),
+      .driver_version = string8_lit("none"),
+      .api_version = string8_lit("None"),
+      .device_types = device_types,
+      .device_queues = device_queues,
+      .sampler_filters = sampler_filters,
+      .max_sampler_anisotropy = 1.0f,
+      .actual_target_kind = renderer->present_target.kind,
+      .actual_present_mode = VKR_PRESENT_MODE_DEFAULT,
+      .actual_target_image_count = renderer->present_target.image_count,
+      .actual_target_width = renderer->last_window_width,
+      .actual_target_height = renderer->last_window_height,
+      .actual_color_format = VKR_SURFACE_COLOR_FORMAT_RGBA8_SRGB,
+      .actual_depth_format = VKR_SURFACE_DEPTH_FORMAT_D32_SFLOAT,
+      .actual_color_space = VKR_SURFACE_COLOR_SPACE_SRGB_NONLINEAR,
+      .actual_world_renderer_topology = VKR_WORLD_RENDERER_TOPOLOGY_DEFERRED,
+  };
+}
+
+static VkrRendererError renderer_impl_null_wait_idle(void *state) {
+  RendererFrontend *renderer = state;
+  return vkr_null_renderer_wait_idle(renderer->null_renderer)
+             ? VKR_RENDERER_ERROR_NONE
+             : VKR_RENDERER_ERROR_DEVICE_ERROR;
+}
+
+static uint64_t renderer_impl_null_submit_serial(void *state) {
+  RendererFrontend *renderer = state;
+  return vkr_null_renderer_submit_value(renderer->null_renderer);
+}
+
+static uint64_t renderer_impl_null_completed_submit_serial(void *state) {
+  RendererFrontend *renderer = state;
+  return vkr_null_renderer_completed_value(renderer->null_renderer);
+}
+
+/** Nothing blocks without a device, so both wait counters are valid zeros. */
+static bool8_t
+renderer_impl_null_upload_wait_stats(void *state,
+                                     VkrRendererUploadWaitStats *out_stats) {
+  (void)state;
+  MemZero(out_stats, sizeof(*out_stats));
+  return true_v;
+}
+
+static bool8_t renderer_impl_null_command_slot_waits(void *state,
+                                                     uint64_t *out_wait_count) {
+  (void)state;
+  *out_wait_count = 0u;
+  return true_v;
+}
+
+/** Reports the accounted publication bytes as a single host-visible heap. */
+static bool8_t
+renderer_impl_null_device_memory_stats(void *state,
+                                       VkrDeviceMemoryStats *out_stats) {
+  RendererFrontend *renderer = state;
+  if (!renderer || !renderer->null_renderer || !out_stats)
+    return false_v;
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer->null_renderer, &metrics);
+  const VkrRendererImplMemoryMetrics *memory = &metrics.memory;
+  MemZero(out_stats, sizeof(*out_stats));
+  out_stats->live_allocation_count =
+      memory->live_allocations + memory->retired_allocations;
+  out_stats->peak_allocation_count = memory->peak_allocations;
+  out_stats->total_allocation_count = memory->allocations_created;
+  out_stats->max_allocation_count = UINT32_MAX;
+  out_stats->live_bytes =
+      memory->live_reserved_bytes + memory->retired_reserved_bytes;
+  out_stats->peak_bytes = memory->peak_reserved_bytes;
+  out_stats->live_totals_exact = true_v;
+  out_stats->memory_type_count = 1;
+  out_stats->live_bytes_by_type[0] = out_stats->live_bytes;
+  out_stats->live_count_by_type[0] = out_stats->live_allocation_count;
+  out_stats->heap_count = 1;
+  out_stats->heap_usage_bytes[0] = out_stats->live_bytes;
+  return true_v;
+}
+
+static bool8_t
+renderer_impl_null_memory_metrics(void *state,
+                                  VkrRendererImplMemoryMetrics *out_metrics) {
+  RendererFrontend *renderer = state;
+  if (!renderer || !renderer->null_renderer || !out_metrics)
+    return false_v;
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer->null_renderer, &metrics);
+  *out_metrics = metrics.memory;
+  return true_v;
+}
+
+static VkrRendererError
+renderer_impl_null_prepare_frame(void *state, VkrFrameSetup *out_setup) {
+  RendererFrontend *rf = state;
+  if (rf->frame_active) {
+    return VKR_RENDERER_ERROR_FRAME_IN_PROGRESS;
+  }
+  const VkrRenderGraphFrameInfo frame = {
+      .frame_index = (uint32_t)(rf->frame_number + 1u),
+      .delta_time = 1.0 / 60.0,
+      .target_color_format = rf->impl.caps.present_color_format,
+      .target_depth_format = rf->impl.caps.present_depth_format,
+      .target_color_initial_state = {.access = VKR_IMAGE_ACCESS_NONE,
+                                     .layout = VKR_TEXTURE_LAYOUT_UNDEFINED},
+      .target_depth_initial_state = {.access = VKR_IMAGE_ACCESS_NONE,
+                                     .layout = VKR_TEXTURE_LAYOUT_UNDEFINED},
+      .target_terminal_state = {.access = VKR_IMAGE_ACCESS_TRANSFER_SRC,
+                                .layout =
+                                    VKR_TEXTURE_LAYOUT_TRANSFER_SRC_OPTIMAL},
+      .shadow_depth_format = rf->impl.caps.shadow_depth_format,
+      .shadow_map_size =
+          rf->shadow_system.initialized
+              ? vkr_shadow_config_get_max_map_size(&rf->shadow_system.config)
+              : 2048u,
+      .shadow_map_layer_count = rf->shadow_system.initialized
+                                    ? rf->shadow_system.config.cascade_count
+                                    : 1u,
+  };
+  if (!vkr_null_renderer_prepare_frame(rf->null_renderer, &frame, out_setup)) {
+    return VKR_RENDERER_ERROR_FRAME_PREPARATION_FAILED;
+  }
+  rf->frame_active = true_v;
+  vkr_resource_system_pump(NULL);
+  vkr_mesh_manager_pump_async(&rf->mesh_manager);
+  rf->frame_number++;
+  rf->last_window_width = out_setup->window_width;
+  rf->last_window_height = out_setup->window_height;
+  rf->timing_completed_ready = renderer_impl_null_poll_submit_result(
+      rf, rf->timing_last_completed_submit_value, &rf->timing_result);
+  if (rf->timing_completed_ready) {
+    rf->timing_last_completed_submit_value = rf->timing_result.submit_value;
+  }
+  MemZero(&rf->frame_metrics, sizeof(rf->frame_metrics));
+  return VKR_RENDERER_ERROR_NONE;
+}
+
+/**
+ * No draws are recorded, so the world draw counters stay zero; candidate
+ * metrics still come from the prepared packet because packet lowering is
+ * shared CPU work the null strategy exists to measure.
+ */
+static VkrRendererError
+renderer_impl_null_submit_packet(void *state, const VkrRenderPacket *packet,
+                                 VkrRendererFrameMetrics *out_metrics,
+                                 VkrValidationError *out_validation_error) {
+  RendererFrontend *rf = state;
+  if (!rf->frame_active) {
+    return vkr_renderer_validation_fail(
+        out_validation_error, VKR_RENDERER_ERROR_FRAME_IN_PROGRESS, "frame",
+        "frame is not active; call vkr_renderer_prepare_frame first");
+  }
+  VkrRendererPreparedPacket prepared;
+  vkr_renderer_prepare_packet(rf, packet, &prepared);
+  VkrNullResult result = {0};
+  const bool8_t submitted = vkr_null_renderer_submit_packet(
+      rf->null_renderer, &prepared.packet, &result);
+  rf->frame_active = false_v;
+  if (!submitted) {
+    return vkr_renderer_validation_fail(
+        out_validation_error, VKR_RENDERER_ERROR_SUBMISSION_FAILED, "null",
+        "Null renderer packet submission failed");
+  }
+  if (packet->picking && packet->picking->pending &&
+      rf->picking.state == VKR_PICKING_STATE_RENDER_PENDING)
+    rf->picking.state = VKR_PICKING_STATE_READBACK_PENDING;
+  vkr_renderer_record_gpu_candidate_metrics(rf, &prepared.packet);
+  if (out_metrics) {
+    *out_metrics = rf->frame_metrics;
+  }
+  return VKR_RENDERER_ERROR_NONE;
+}
+
+static VkrRendererError renderer_impl_null_cancel_frame(void *state) {
+  RendererFrontend *renderer = state;
+  vkr_null_renderer_cancel_frame(renderer->null_renderer);
+  renderer->frame_active = false_v;
+  return VKR_RENDERER_ERROR_NONE;
+}
+
+static void renderer_impl_null_resize(void *state, uint32_t width,
+                                      uint32_t height) {
+  RendererFrontend *renderer = state;
+  if (vkr_null_renderer_resize(
+          renderer->null_renderer, width, height,
+          renderer->impl.caps.present_target_image_count)) {
+    renderer->last_window_width = width;
+    renderer->last_window_height = height;
+    renderer->present_target.width = width;
+    renderer->present_target.height = height;
+  }
+}
+
+static VkrRendererError renderer_impl_null_present_target_recreate(
+    void *state, uint32_t width, uint32_t height, uint32_t image_count) {
+  RendererFrontend *renderer = state;
+  if (!vkr_null_renderer_resize(renderer->null_renderer, width, height,
+                                image_count)) {
+    return VKR_RENDERER_ERROR_DEVICE_ERROR;
+  }
+  renderer->last_window_width = width;
+  renderer->last_window_height = height;
+  renderer->present_target.width = width;
+  renderer->present_target.height = height;
+  renderer->present_target.image_count = image_count;
+  renderer->impl.caps.present_target_image_count = image_count;
+  return VKR_RENDERER_ERROR_NONE;
+}
+
+static uint32_t renderer_impl_null_frame_in_flight_index(void *state) {
+  RendererFrontend *renderer = state;
+  return vkr_null_renderer_frame_slot(renderer->null_renderer);
+}
+
+static VkrCaptureStatus
+renderer_impl_null_capture_poll(void *state, VkrCaptureRequestId request_id,
+                                VkrCapturePollResult *out_result) {
+  (void)state;
+  (void)request_id;
+  if (out_result) {
+    MemZero(out_result, sizeof(*out_result));
+    out_result->error = VKR_RENDERER_ERROR_BACKEND_NOT_SUPPORTED;
+  }
+  return VKR_CAPTURE_STATUS_NOT_FOUND;
+}
+
+static bool8_t
+renderer_impl_null_capture_release(void *state,
+                                   VkrCaptureRequestId request_id) {
+  (void)state;
+  (void)request_id;
+  return false_v;
+}
+
+static bool8_t
+renderer_impl_null_poll_submit_result(void *state, uint64_t after_submit_value,
+                                      VkrRendererImplSubmitResult *out_result) {
+  RendererFrontend *renderer = state;
+  VkrNullResult source = {0};
+  if (!out_result ||
+      !vkr_null_renderer_poll_result(renderer->null_renderer,
+                                     after_submit_value, &source)) {
+    return false_v;
+  }
+  *out_result = (VkrRendererImplSubmitResult){
+      .submit_value = source.submit_value,
+      .source_frame_index = source.source_frame_index,
+      .executed_pass_count = source.executed_pass_count,
+      .pass_timing_count = source.pass_timing_count,
+  };
+  MemCopy(out_result->pass_timings, source.pass_timings,
+          (uint64_t)source.pass_timing_count *
+              sizeof(*out_result->pass_timings));
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer->null_renderer, &metrics);
+  out_result->memory = metrics.memory;
+  out_result->materials = metrics.materials;
+  return true_v;
+}
+
+static VkrAllocator *renderer_impl_null_allocator(void *state) {
+  RendererFrontend *renderer = state;
+  return vkr_null_renderer_allocator(renderer->null_renderer);
+}
+
 VkrRendererError vkr_renderer_cancel_frame(VkrRendererFrontendHandle renderer) {
   assert_log(renderer != NULL, "Renderer is NULL");
 
@@ -2663,6 +3119,13 @@ vkr_internal bool8_t renderer_frontend_initialize_packet_systems(
     log_error("Packet renderer resource system initialization failed");
     return false_v;
   }
+  // One prepare job per worker; the rest wait in the request table, where
+  // they stay cancelable and are submitted in priority order. Textures and
+  // materials pulled in by hinted meshes stay cached up to the budget.
+  vkr_resource_system_set_streaming_config(&(VkrResourceStreamingConfig){
+      .max_cpu_jobs_in_flight = job_system ? job_system->worker_count : 0u,
+      .max_resident_bytes = VKR_RENDERER_STREAMING_RESIDENT_BYTES,
+  });
   log_debug("Initializing packet renderer geometry system");
 
   VkrRendererError error = VKR_RENDERER_ERROR_NONE;
@@ -2696,7 +3159,9 @@ vkr_internal bool8_t renderer_frontend_initialize_packet_systems(
     log_error("Packet renderer material system initialization failed");
     return false_v;
   }
-  VkrMeshManagerConfig mesh_config = {.max_mesh_count = 16384};
+  VkrMeshManagerConfig mesh_config = {.max_mesh_count = 16384,
+                                      .build_picking_bvh = true_v,
+                                      .static_batching = true_v};
   if (!vkr_mesh_manager_init(&rf->mesh_manager, &rf->geometry_system,
                              &rf->material_system, &mesh_config)) {
     return false_v;
@@ -2788,7 +3253,9 @@ vkr_internal bool8_t renderer_frontend_initialize_packet_systems(
     return false_v;
   }
   VkrShadowConfig shadow_config = VKR_SHADOW_CONFIG_DEFAULT;
-  if (!vkr_shadow_system_init(&rf->shadow_system, rf, &shadow_config)) {
+  if (!vkr_shadow_system_init(&rf->shadow_system, rf, &shadow_config) ||
+      !vkr_shadow_system_set_caster_index(&rf->shadow_system, &rf->allocator,
+                                          &rf->mesh_manager.bounds_index)) {
     return false_v;
   }
   if (vkr_renderer_subsystem_plan_includes(&rf->subsystem_plan,
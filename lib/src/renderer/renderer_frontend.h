@@ -31,6 +31,7 @@
 
 typedef struct VkrMetalPacketRenderer VkrMetalPacketRenderer;
 typedef struct VkrVulkanRenderer VkrVulkanRenderer;
+typedef struct VkrNullRenderer VkrNullRenderer;
 
 /**
  * @brief Per-frame batching statistics for the world render path.
@@ -91,6 +92,7 @@ typedef struct VkrRendererFrameMetrics {
   VkrWorldBatchMetrics world;
   VkrShadowMetrics shadow;
   VkrPacketBuildMetrics packet_build;
+  VkrUiBatchMetrics ui;
   uint64_t backend_present_ns;
   bool8_t backend_present_valid;
 } VkrRendererFrameMetrics;
@@ -115,6 +117,7 @@ struct s_RendererFrontend {
   VkrRendererImpl impl;
   VkrMetalPacketRenderer *metal_renderer;
   VkrVulkanRenderer *vulkan_renderer;
+  VkrNullRenderer *null_renderer;
   VkrAssetPublisher asset_publisher;
   VkrRendererImplSubmitResult timing_result;
   uint64_t timing_last_completed_submit_value;
@@ -2730,5 +2730,7 @@ VkrResourceLoader vkr_mesh_loader_create(VkrMeshLoaderContext *context) {
   loader.release_async_payload = vkr_mesh_loader_release_async_payload;
   loader.unload = vkr_mesh_loader_unload;
   loader.batch_load = vkr_mesh_loader_batch_load;
+  // READY results hold a mesh arena pool chunk until unloaded.
+  loader.streaming_uncached = true_v;
   return loader;
 }
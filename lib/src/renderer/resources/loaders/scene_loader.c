@@ -92,6 +92,7 @@ typedef struct SceneEntityImport {
   String8 mesh_path;
   String8 shader_override;
   VkrPipelineDomain pipeline_domain;
+  bool8_t mesh_static;
   bool8_t has_text3d;
   SceneText3DImport text3d;
   bool8_t has_shape;
@@ -1043,6 +1044,14 @@ vkr_internal void scene_loader_apply_environment_import(
       vkr_texture_system_release_prepared_load(&local_prepared);
       goto failed;
     }
+    // The CPU bake needs only the decoded texels, so the equirect is never
+    // published when it succeeds.
+    if (vkr_world_resources_bake_scene_environment_on_cpu(
+            rf, &rf->world_resources, scene, environment_import->equirect_path,
+            upload)) {
+      vkr_texture_system_release_prepared_load(&local_prepared);
+      return;
+    }
     const bool8_t finalized = vkr_texture_system_finalize_prepared_load(
         &rf->texture_system, environment_import->equirect_path, upload,
         &delivery, &texture_error);
@@ -1112,6 +1121,7 @@ scene_loader_reset_scene_reflection_probes(VkrScene *scene,
         .bake_state = VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_NONE,
     };
   }
+  scene->reflection_probe_version++;
 }
 
 vkr_internal void scene_loader_apply_reflection_probe_imports(
@@ -1210,6 +1220,7 @@ vkr_internal void scene_loader_apply_reflection_probe_imports(
 
     scene->reflection_probes[scene->reflection_probe_count++] = probe;
   }
+  scene->reflection_probe_version++;
 }
 
 vkr_internal bool8_t scene_json_count_entities(const VkrJsonReader *root,
@@ -1349,6 +1360,9 @@ vkr_internal void scene_json_parse_mesh(const VkrJsonReader *entity_reader,
       shader_override.length > 0) {
     out_entity->shader_override = shader_override;
   }
+
+  (void)scene_json_read_bool_field(&mesh_obj, "static",
+                                   &out_entity->mesh_static);
 }
 
 vkr_internal void scene_json_parse_text3d(const VkrJsonReader *entity_reader,
@@ -1844,6 +1858,10 @@ bool8_t vkr_scene_load_from_json(VkrScene *scene, struct s_RendererFrontend *rf,
 
       uint32_t entity_index = mesh_entity_indices[i];
       VkrEntityId entity = entity_ids[entity_index];
+      if (imports[entity_index].mesh_static) {
+        vkr_mesh_manager_set_instance_static(&rf->mesh_manager, instance,
+                                             true_v);
+      }
 
       if (!vkr_scene_set_mesh_renderer(scene, entity, instance)) {
         if (out_error)
@@ -2467,6 +2485,10 @@ vkr_internal bool8_t scene_loader_attach_mesh_for_entity(
 
   VkrScene *scene = vkr_scene_handle_get_scene(payload->scene_handle);
   VkrEntityId entity = payload->entity_ids[entity_index];
+  if (entity_import->mesh_static) {
+    vkr_mesh_manager_set_instance_static(&payload->rf->mesh_manager, instance,
+                                         true_v);
+  }
 
   if (!vkr_scene_set_mesh_renderer(scene, entity, instance)) {
     *out_error = VKR_RENDERER_ERROR_RESOURCE_CREATION_FAILED;
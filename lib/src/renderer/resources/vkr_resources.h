@@ -324,6 +324,14 @@ typedef struct VkrMeshAsset {
   Vec3 bounds_local_center;
   float32_t bounds_local_radius;
 
+  // Mesh-space triangle BVH for CPU ray picking; NULL when disabled or the
+  // loader produced no CPU triangles.
+  struct VkrTriangleBvh *picking_bvh;
+
+  // CPU copy of the merged mesh buffer kept for static batching; NULL when
+  // batching is disabled or the asset was not loaded as one merged buffer.
+  struct VkrStaticBatchSource *static_source;
+
   /**
    * Asset readiness state for async mesh loading.
    *
@@ -373,6 +381,13 @@ typedef struct VkrMeshInstance {
   Vec3 bounds_world_center;
   float32_t bounds_world_radius;
 
+  // Set by the scene for instances that never move. Submeshes merged into a
+  // static batch are flagged in `static_batched` (one byte per asset submesh)
+  // and are drawn by their cluster instead.
+  bool8_t is_static;
+  uint32_t static_batched_count;
+  uint32_t static_batched_capacity;
+  uint8_t *static_batched;
 } VkrMeshInstance;
 Array(VkrMeshInstance);
 
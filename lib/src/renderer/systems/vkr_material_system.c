@@ -197,6 +197,7 @@ bool8_t vkr_material_system_publish(VkrMaterialSystem *system,
   if (out_error) {
     *out_error = VKR_RENDERER_ERROR_NONE;
   }
+  system->publication_version++;
   if (!system->asset_publisher || !system->asset_publisher->publish_material) {
     return true_v;
   }
@@ -226,6 +227,7 @@ bool8_t vkr_material_system_publish(VkrMaterialSystem *system,
 bool8_t vkr_material_system_unpublish(VkrMaterialSystem *system,
                                       VkrMaterialHandle handle) {
   assert_log(system != NULL, "Material system is NULL");
+  system->publication_version++;
   if (!system->asset_publisher ||
       !system->asset_publisher->unpublish_material) {
     return true_v;
@@ -90,6 +90,8 @@ typedef struct VkrMaterialSystem {
 
   uint32_t next_free_index;
   uint32_t generation_counter;
+  // Bumped by every publish/unpublish; material edits reach draws only there.
+  uint64_t publication_version;
 
   VkrMaterialHandle default_material;
 } VkrMaterialSystem;
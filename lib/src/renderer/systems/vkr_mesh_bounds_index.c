@@ -0,0 +1,185 @@
+#include "renderer/systems/vkr_mesh_bounds_index.h"
+
+#include "core/logger.h"
+
+bool8_t vkr_mesh_bounds_index_init(VkrMeshBoundsIndex *index,
+                                   VkrAllocator *allocator,
+                                   uint32_t instance_capacity,
+                                   uint32_t mesh_capacity) {
+  assert_log(index != NULL, "Index is NULL");
+  assert_log(allocator != NULL, "Allocator is NULL");
+
+  MemZero(index, sizeof(*index));
+  index->allocator = allocator;
+  index->instance_capacity = instance_capacity;
+  index->key_capacity = instance_capacity + mesh_capacity;
+  if (index->key_capacity == 0) {
+    return true_v;
+  }
+
+  const uint64_t key_capacity = index->key_capacity;
+  index->bounds = vkr_allocator_alloc_aligned(
+      allocator, sizeof(VkrAabb) * key_capacity, AlignOf(VkrAabb),
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  index->spheres = vkr_allocator_alloc_aligned(
+      allocator, sizeof(Vec4) * key_capacity, AlignOf(Vec4),
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  index->live_keys = vkr_allocator_alloc(allocator,
+                                         sizeof(uint32_t) * key_capacity,
+                                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  index->live_positions = vkr_allocator_alloc(
+      allocator, sizeof(uint32_t) * key_capacity,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!index->bounds || !index->spheres || !index->live_keys ||
+      !index->live_positions ||
+      !vkr_bvh_create(allocator, index->key_capacity, &index->bvh)) {
+    log_error("Failed to allocate mesh bounds index (%u keys)",
+              index->key_capacity);
+    vkr_mesh_bounds_index_shutdown(index);
+    return false_v;
+  }
+
+  for (uint32_t key = 0; key < index->key_capacity; ++key) {
+    index->live_positions[key] = VKR_INVALID_ID;
+  }
+  return true_v;
+}
+
+void vkr_mesh_bounds_index_shutdown(VkrMeshBoundsIndex *index) {
+  if (!index || !index->allocator) {
+    return;
+  }
+
+  const uint64_t key_capacity = index->key_capacity;
+  vkr_bvh_destroy(&index->bvh);
+  if (index->bounds) {
+    vkr_allocator_free_aligned(index->allocator, index->bounds,
+                               sizeof(VkrAabb) * key_capacity,
+                               AlignOf(VkrAabb),
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (index->spheres) {
+    vkr_allocator_free_aligned(index->allocator, index->spheres,
+                               sizeof(Vec4) * key_capacity, AlignOf(Vec4),
+                               VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (index->live_keys) {
+    vkr_allocator_free(index->allocator, index->live_keys,
+                       sizeof(uint32_t) * key_capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (index->live_positions) {
+    vkr_allocator_free(index->allocator, index->live_positions,
+                       sizeof(uint32_t) * key_capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(index, sizeof(*index));
+}
+
+void vkr_mesh_bounds_index_set(VkrMeshBoundsIndex *index, uint32_t key,
+                               Vec3 center, float32_t radius) {
+  if (!index || key >= index->key_capacity) {
+    return;
+  }
+
+  const VkrAabb bounds = vkr_aabb_from_sphere(center, radius);
+  if (index->live_positions[key] == VKR_INVALID_ID) {
+    index->live_positions[key] = index->live_count;
+    index->live_keys[index->live_count++] = key;
+    index->needs_rebuild = true_v;
+  } else if (vkr_aabb_equal(index->bounds[key], bounds)) {
+    return;
+  } else {
+    index->needs_refit = true_v;
+  }
+
+  index->bounds[key] = bounds;
+  index->spheres[key] = vec4_new(center.x, center.y, center.z, radius);
+}
+
+void vkr_mesh_bounds_index_remove(VkrMeshBoundsIndex *index, uint32_t key) {
+  if (!index || key >= index->key_capacity) {
+    return;
+  }
+
+  const uint32_t position = index->live_positions[key];
+  if (position == VKR_INVALID_ID) {
+    return;
+  }
+
+  const uint32_t last_key = index->live_keys[index->live_count - 1u];
+  index->live_keys[position] = last_key;
+  index->live_positions[last_key] = position;
+  index->live_positions[key] = VKR_INVALID_ID;
+  index->live_count--;
+  index->needs_rebuild = true_v;
+}
+
+bool8_t vkr_mesh_bounds_index_contains(const VkrMeshBoundsIndex *index,
+                                       uint32_t key) {
+  return index && key < index->key_capacity &&
+         index->live_positions[key] != VKR_INVALID_ID;
+}
+
+void vkr_mesh_bounds_index_commit(VkrMeshBoundsIndex *index) {
+  if (!index || index->key_capacity == 0) {
+    return;
+  }
+
+  if (index->needs_refit && !index->needs_rebuild &&
+      index->refits_since_build >= VKR_MESH_BOUNDS_INDEX_REFIT_LIMIT) {
+    index->needs_rebuild = true_v;
+  }
+
+  if (index->needs_rebuild) {
+    vkr_bvh_build(&index->bvh, index->bounds, index->live_keys,
+                  index->live_count);
+    index->refits_since_build = 0;
+  } else if (index->needs_refit) {
+    vkr_bvh_refit(&index->bvh, index->bounds);
+    index->refits_since_build++;
+  }
+
+  index->needs_rebuild = false_v;
+  index->needs_refit = false_v;
+}
+
+uint32_t vkr_mesh_bounds_index_query_planes(VkrMeshBoundsIndex *index,
+                                            const VkrPlane *planes,
+                                            uint32_t plane_count,
+                                            VkrBvhVisitFn visit,
+                                            void *user_data) {
+  if (!index || index->key_capacity == 0) {
+    return 0;
+  }
+
+  vkr_mesh_bounds_index_commit(index);
+  return vkr_bvh_query_planes(&index->bvh, index->bounds, planes, plane_count,
+                              visit, user_data);
+}
+
+uint32_t vkr_mesh_bounds_index_query_sphere(VkrMeshBoundsIndex *index,
+                                            Vec3 center, float32_t radius,
+                                            VkrBvhVisitFn visit,
+                                            void *user_data) {
+  if (!index || index->key_capacity == 0) {
+    return 0;
+  }
+
+  vkr_mesh_bounds_index_commit(index);
+  return vkr_bvh_query_sphere(&index->bvh, index->bounds, center, radius,
+                              visit, user_data);
+}
+
+bool8_t vkr_mesh_bounds_index_query_ray(VkrMeshBoundsIndex *index,
+                                        const VkrRay *ray, float32_t max_t,
+                                        VkrBvhRayFn intersect, void *user_data,
+                                        VkrBvhRayHit *out_hit) {
+  if (!index || index->key_capacity == 0) {
+    return false_v;
+  }
+
+  vkr_mesh_bounds_index_commit(index);
+  return vkr_bvh_query_ray(&index->bvh, index->bounds, ray, max_t, intersect,
+                           user_data, out_hit);
+}
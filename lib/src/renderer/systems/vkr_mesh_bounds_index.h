@@ -0,0 +1,137 @@
+/**
+ * @file vkr_mesh_bounds_index.h
+ * @brief World-bounds spatial index over mesh-manager meshes and instances.
+ *
+ * The mesh manager writes an entry whenever a drawable's world bounds change
+ * and removes it when the drawable stops being drawable (hidden, unloaded,
+ * destroyed). Consumers such as the shadow system then cull against a BVH
+ * instead of walking every live mesh.
+ *
+ * Instances and legacy meshes have independent slot spaces, so the index maps
+ * both into one key space: instance slots occupy [0, instance_capacity) and
+ * mesh slots follow them.
+ *
+ * Updates only touch the flat bounds table. The BVH is brought up to date in
+ * vkr_mesh_bounds_index_commit(): membership changes rebuild it, pure motion
+ * refits it, and a run of refits eventually forces a rebuild so the tree does
+ * not degrade without bound.
+ */
+#pragma once
+
+#include "defines.h"
+#include "math/vkr_bvh.h"
+#include "memory/vkr_allocator.h"
+
+/** Consecutive refits tolerated before the next commit rebuilds. */
+#define VKR_MESH_BOUNDS_INDEX_REFIT_LIMIT 64u
+
+typedef struct VkrMeshBoundsIndex {
+  VkrAllocator *allocator;
+  VkrBvh bvh;
+
+  /** World AABB per key, valid only while the key is live. */
+  VkrAabb *bounds;
+  /** World bounding sphere per key (xyz center, w radius). */
+  Vec4 *spheres;
+  /** Dense list of live keys. */
+  uint32_t *live_keys;
+  /** Position of each key in live_keys, or VKR_INVALID_ID when absent. */
+  uint32_t *live_positions;
+  uint32_t live_count;
+
+  uint32_t instance_capacity;
+  uint32_t key_capacity;
+
+  uint32_t refits_since_build;
+  bool8_t needs_rebuild;
+  bool8_t needs_refit;
+} VkrMeshBoundsIndex;
+
+/**
+ * @brief Allocates the key space for `instance_capacity` instances and
+ * `mesh_capacity` legacy meshes.
+ */
+bool8_t vkr_mesh_bounds_index_init(VkrMeshBoundsIndex *index,
+                                   VkrAllocator *allocator,
+                                   uint32_t instance_capacity,
+                                   uint32_t mesh_capacity);
+
+void vkr_mesh_bounds_index_shutdown(VkrMeshBoundsIndex *index);
+
+vkr_internal INLINE uint32_t vkr_mesh_bounds_index_instance_key(
+    const VkrMeshBoundsIndex *index, uint32_t instance_slot) {
+  (void)index;
+  return instance_slot;
+}
+
+vkr_internal INLINE uint32_t
+vkr_mesh_bounds_index_mesh_key(const VkrMeshBoundsIndex *index,
+                               uint32_t mesh_slot) {
+  return index->instance_capacity + mesh_slot;
+}
+
+vkr_internal INLINE bool8_t
+vkr_mesh_bounds_index_key_is_instance(const VkrMeshBoundsIndex *index,
+                                      uint32_t key) {
+  return key < index->instance_capacity;
+}
+
+/** Instance or mesh slot encoded by `key`. */
+vkr_internal INLINE uint32_t
+vkr_mesh_bounds_index_key_slot(const VkrMeshBoundsIndex *index, uint32_t key) {
+  return key < index->instance_capacity ? key
+                                        : key - index->instance_capacity;
+}
+
+/**
+ * @brief Inserts or moves a key. Unchanged bounds do not dirty the tree.
+ */
+void vkr_mesh_bounds_index_set(VkrMeshBoundsIndex *index, uint32_t key,
+                               Vec3 center, float32_t radius);
+
+/**
+ * @brief Removes a key. Removing an absent key is a no-op.
+ */
+void vkr_mesh_bounds_index_remove(VkrMeshBoundsIndex *index, uint32_t key);
+
+bool8_t vkr_mesh_bounds_index_contains(const VkrMeshBoundsIndex *index,
+                                       uint32_t key);
+
+/**
+ * @brief Brings the BVH up to date with the bounds table.
+ */
+void vkr_mesh_bounds_index_commit(VkrMeshBoundsIndex *index);
+
+/**
+ * @brief Visits every live key whose AABB intersects the convex volume.
+ *
+ * Commits pending updates first.
+ * @return Number of keys visited.
+ */
+uint32_t vkr_mesh_bounds_index_query_planes(VkrMeshBoundsIndex *index,
+                                            const VkrPlane *planes,
+                                            uint32_t plane_count,
+                                            VkrBvhVisitFn visit,
+                                            void *user_data);
+
+/**
+ * @brief Visits every live key whose AABB overlaps the sphere.
+ *
+ * Commits pending updates first.
+ * @return Number of keys visited.
+ */
+uint32_t vkr_mesh_bounds_index_query_sphere(VkrMeshBoundsIndex *index,
+                                            Vec3 center, float32_t radius,
+                                            VkrBvhVisitFn visit,
+                                            void *user_data);
+
+/**
+ * @brief Closest-hit ray query over live keys; see vkr_bvh_query_ray.
+ *
+ * Commits pending updates first. `intersect` refines each key whose AABB the
+ * ray enters, e.g. against the bounding sphere or the mesh triangles.
+ */
+bool8_t vkr_mesh_bounds_index_query_ray(VkrMeshBoundsIndex *index,
+                                        const VkrRay *ray, float32_t max_t,
+                                        VkrBvhRayFn intersect, void *user_data,
+                                        VkrBvhRayHit *out_hit);
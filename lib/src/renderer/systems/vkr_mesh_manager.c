@@ -8,6 +8,7 @@
 #include "math/vec.h"
 #include "math/vkr_math.h"
 #include "math/vkr_transform.h"
+#include "math/vkr_triangle_bvh.h"
 #include "memory/vkr_arena_allocator.h"
 #include "memory/vkr_dmemory_allocator.h"
 #include "renderer/resources/loaders/mesh_loader.h"
@@ -336,6 +337,510 @@ vkr_mesh_manager_update_instance_bounds(VkrMeshInstance *instance,
   instance->bounds_world_radius = asset->bounds_local_radius * max_scale;
 }
 
+/**
+ * @brief Mirrors a legacy mesh into the bounds index: present while it is
+ * drawable with valid bounds, absent otherwise.
+ */
+vkr_internal void vkr_mesh_manager_sync_mesh_bounds_index(
+    VkrMeshManager *manager, uint32_t slot, const VkrMesh *mesh) {
+  const uint32_t key =
+      vkr_mesh_bounds_index_mesh_key(&manager->bounds_index, slot);
+  if (mesh->visible && mesh->bounds_valid &&
+      mesh->loading_state == VKR_MESH_LOADING_STATE_LOADED) {
+    vkr_mesh_bounds_index_set(&manager->bounds_index, key,
+                              mesh->bounds_world_center,
+                              mesh->bounds_world_radius);
+  } else {
+    vkr_mesh_bounds_index_remove(&manager->bounds_index, key);
+  }
+}
+
+/** Records a change to the inputs of world candidate production. */
+vkr_internal INLINE void vkr_mesh_manager_touch(VkrMeshManager *manager) {
+  manager->render_version++;
+}
+
+/**
+ * @brief Instance counterpart of vkr_mesh_manager_sync_mesh_bounds_index.
+ */
+vkr_internal void vkr_mesh_manager_sync_instance_bounds_index(
+    VkrMeshManager *manager, uint32_t slot, const VkrMeshInstance *instance) {
+  const uint32_t key =
+      vkr_mesh_bounds_index_instance_key(&manager->bounds_index, slot);
+  if (instance->visible && instance->bounds_valid &&
+      instance->loading_state == VKR_MESH_LOADING_STATE_LOADED) {
+    vkr_mesh_bounds_index_set(&manager->bounds_index, key,
+                              instance->bounds_world_center,
+                              instance->bounds_world_radius);
+  } else {
+    vkr_mesh_bounds_index_remove(&manager->bounds_index, key);
+  }
+}
+
+vkr_internal void
+vkr_mesh_manager_release_asset_picking_bvh(VkrMeshManager *manager,
+                                           VkrMeshAsset *asset) {
+  if (!asset->picking_bvh) {
+    return;
+  }
+
+  vkr_triangle_bvh_destroy(asset->picking_bvh);
+  vkr_allocator_free(&manager->picking_allocator, asset->picking_bvh,
+                     sizeof(VkrTriangleBvh), VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  asset->picking_bvh = NULL;
+}
+
+/**
+ * @brief Builds the asset's picking BVH from the loader's CPU geometry.
+ *
+ * The loader result is the last point where CPU vertices exist, so this runs
+ * while the asset is being finalized. Failure only costs picking precision:
+ * raycasts fall back to the asset's bounding sphere.
+ */
+vkr_internal void vkr_mesh_manager_build_asset_picking_bvh(
+    VkrMeshManager *manager, VkrMeshAsset *asset,
+    const VkrMeshLoaderResult *mesh_result, bool8_t use_merged) {
+  vkr_mesh_manager_release_asset_picking_bvh(manager, asset);
+  if (!manager->config.build_picking_bvh) {
+    return;
+  }
+
+  const uint32_t source_count = use_merged
+                                    ? (uint32_t)mesh_result->submeshes.length
+                                    : (uint32_t)mesh_result->subsets.length;
+  if (source_count == 0) {
+    return;
+  }
+
+  VkrAllocator *scratch_allocator = &manager->scratch_allocator;
+  VkrAllocatorScope temp_scope = vkr_allocator_begin_scope(scratch_allocator);
+  if (!vkr_allocator_scope_is_valid(&temp_scope)) {
+    return;
+  }
+
+  VkrTriangleMeshSource *sources = vkr_allocator_alloc(
+      scratch_allocator, sizeof(VkrTriangleMeshSource) * source_count,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrTriangleBvh *bvh =
+      sources ? vkr_allocator_alloc(&manager->picking_allocator,
+                                    sizeof(VkrTriangleBvh),
+                                    VKR_ALLOCATOR_MEMORY_TAG_STRUCT)
+              : NULL;
+  if (!bvh) {
+    vkr_allocator_end_scope(&temp_scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    return;
+  }
+
+  for (uint32_t i = 0; i < source_count; ++i) {
+    if (use_merged) {
+      const VkrMeshLoaderBuffer *buffer = &mesh_result->mesh_buffer;
+      const VkrMeshLoaderSubmeshRange *range = &mesh_result->submeshes.data[i];
+      sources[i] = (VkrTriangleMeshSource){
+          .positions = buffer->vertices,
+          .position_stride = buffer->vertex_size,
+          .vertex_count = buffer->vertex_count,
+          .indices = buffer->indices,
+          .index_size = buffer->index_size,
+          .first_index = range->first_index,
+          .index_count = range->index_count,
+          .vertex_offset = range->vertex_offset,
+      };
+    } else {
+      const VkrGeometryConfig *config =
+          &mesh_result->subsets.data[i].geometry_config;
+      sources[i] = (VkrTriangleMeshSource){
+          .positions = config->vertices,
+          .position_stride = config->vertex_size,
+          .vertex_count = config->vertex_count,
+          .indices = config->indices,
+          .index_size = config->index_size,
+          .first_index = 0,
+          .index_count = config->index_count,
+          .vertex_offset = 0,
+      };
+    }
+  }
+
+  if (vkr_triangle_bvh_create(&manager->picking_allocator, sources,
+                              source_count, bvh)) {
+    asset->picking_bvh = bvh;
+  } else {
+    log_warn("MeshManager: no picking BVH for '%.*s'; raycasts use bounds",
+             (int)mesh_result->source_path.length,
+             mesh_result->source_path.str);
+    vkr_allocator_free(&manager->picking_allocator, bvh,
+                       sizeof(VkrTriangleBvh), VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  }
+
+  vkr_allocator_end_scope(&temp_scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+}
+
+vkr_internal void
+vkr_mesh_manager_release_asset_static_source(VkrMeshManager *manager,
+                                             VkrMeshAsset *asset) {
+  VkrStaticBatchSource *source = asset->static_source;
+  if (!source) {
+    return;
+  }
+
+  VkrAllocator *allocator = &manager->static_batch_allocator;
+  vkr_allocator_free(allocator, (void *)source->vertices,
+                     (uint64_t)source->vertex_count * sizeof(VkrVertex3d),
+                     VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  vkr_allocator_free(allocator, (void *)source->indices,
+                     (uint64_t)source->index_count * source->index_size,
+                     VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  vkr_allocator_free(allocator, source, sizeof(*source),
+                     VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  asset->static_source = NULL;
+}
+
+/**
+ * @brief Keeps a CPU copy of the merged mesh buffer for static batching.
+ *
+ * Like the picking BVH, this has to happen while the loader result still
+ * holds CPU vertices. Only merged buffers of VkrVertex3d are kept; anything
+ * else simply never batches.
+ */
+vkr_internal void vkr_mesh_manager_retain_asset_static_source(
+    VkrMeshManager *manager, VkrMeshAsset *asset,
+    const VkrMeshLoaderResult *mesh_result, bool8_t use_merged) {
+  vkr_mesh_manager_release_asset_static_source(manager, asset);
+  const VkrMeshLoaderBuffer *buffer = &mesh_result->mesh_buffer;
+  if (!manager->config.static_batching || !use_merged ||
+      buffer->vertex_size != sizeof(VkrVertex3d) ||
+      (buffer->index_size != sizeof(uint16_t) &&
+       buffer->index_size != sizeof(uint32_t))) {
+    return;
+  }
+
+  VkrAllocator *allocator = &manager->static_batch_allocator;
+  const uint64_t vertex_bytes =
+      (uint64_t)buffer->vertex_count * sizeof(VkrVertex3d);
+  const uint64_t index_bytes =
+      (uint64_t)buffer->index_count * buffer->index_size;
+  VkrStaticBatchSource *source = vkr_allocator_alloc(
+      allocator, sizeof(*source), VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  void *vertices = source ? vkr_allocator_alloc(allocator, vertex_bytes,
+                                                VKR_ALLOCATOR_MEMORY_TAG_ARRAY)
+                          : NULL;
+  void *indices = vertices ? vkr_allocator_alloc(allocator, index_bytes,
+                                                 VKR_ALLOCATOR_MEMORY_TAG_ARRAY)
+                           : NULL;
+  if (!indices) {
+    log_warn("MeshManager: '%.*s' will not be statically batched (out of "
+             "memory)",
+             (int)mesh_result->source_path.length,
+             mesh_result->source_path.str);
+    if (vertices) {
+      vkr_allocator_free(allocator, vertices, vertex_bytes,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    if (source) {
+      vkr_allocator_free(allocator, source, sizeof(*source),
+                         VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+    }
+    return;
+  }
+
+  MemCopy(vertices, buffer->vertices, vertex_bytes);
+  MemCopy(indices, buffer->indices, index_bytes);
+  *source = (VkrStaticBatchSource){
+      .vertices = vertices,
+      .vertex_count = buffer->vertex_count,
+      .indices = indices,
+      .index_size = buffer->index_size,
+      .index_count = buffer->index_count,
+  };
+  asset->static_source = source;
+}
+
+/** Hands every member of the cluster back to its original submesh draw. */
+vkr_internal void vkr_mesh_manager_dissolve_static_cluster(
+    VkrMeshManager *manager, VkrStaticBatchCluster *cluster) {
+  VkrAllocator *allocator = &manager->static_batch_allocator;
+  for (uint32_t i = 0; i < cluster->member_count; ++i) {
+    const VkrStaticBatchMember *member = &cluster->members[i];
+    VkrMeshInstance *instance =
+        &manager->mesh_instances.data[member->instance_slot];
+    if (instance->generation != member->instance_generation ||
+        !instance->static_batched ||
+        member->submesh_index >= instance->static_batched_capacity ||
+        !instance->static_batched[member->submesh_index]) {
+      continue;
+    }
+    instance->static_batched[member->submesh_index] = 0;
+    if (--instance->static_batched_count == 0) {
+      vkr_allocator_free(allocator, instance->static_batched,
+                         instance->static_batched_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+      instance->static_batched = NULL;
+      instance->static_batched_capacity = 0;
+    }
+  }
+
+  vkr_geometry_system_release(manager->geometry_system, cluster->geometry);
+  vkr_allocator_free(allocator, cluster->members,
+                     sizeof(*cluster->members) * cluster->member_count,
+                     VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  MemZero(cluster, sizeof(*cluster));
+  manager->static_cluster_count--;
+  vkr_mesh_manager_touch(manager);
+  // Surviving static members are picked up again by the next rebuild.
+  manager->static_batches_dirty = true_v;
+}
+
+vkr_internal void
+vkr_mesh_manager_dissolve_instance_static_clusters(VkrMeshManager *manager,
+                                                   uint32_t instance_slot) {
+  VkrMeshInstance *instance = &manager->mesh_instances.data[instance_slot];
+  const uint64_t cluster_slots = manager->static_clusters.length;
+  for (uint64_t c = 0; instance->static_batched_count > 0 && c < cluster_slots;
+       ++c) {
+    VkrStaticBatchCluster *cluster = &manager->static_clusters.data[c];
+    for (uint32_t i = 0; cluster->geometry.id != 0 && i < cluster->member_count;
+         ++i) {
+      if (cluster->members[i].instance_slot == instance_slot &&
+          cluster->members[i].instance_generation == instance->generation) {
+        vkr_mesh_manager_dissolve_static_cluster(manager, cluster);
+        break;
+      }
+    }
+  }
+}
+
+/** Batchable: opaque or cutout, and not routed through transmission. */
+vkr_internal bool8_t vkr_mesh_manager_static_batch_material_ok(
+    VkrMeshManager *manager, VkrMaterialHandle handle) {
+  VkrMaterial *material =
+      vkr_material_system_get_live(manager->material_system, handle);
+  return material &&
+         vkr_material_system_material_alpha_mode(manager->material_system,
+                                                 material) !=
+             VKR_MATERIAL_ALPHA_BLEND &&
+         !vkr_material_system_material_is_transmissive(
+             manager->material_system, material);
+}
+
+vkr_internal bool8_t vkr_mesh_manager_static_batch_eligible(
+    VkrMeshManager *manager, const VkrMeshInstance *instance,
+    const VkrMeshAsset **out_asset) {
+  if (!instance->is_static || !instance->visible ||
+      instance->loading_state != VKR_MESH_LOADING_STATE_LOADED) {
+    return false_v;
+  }
+  const VkrMeshAsset *asset =
+      vkr_mesh_manager_get_live_asset(manager, instance->asset);
+  *out_asset = asset;
+  return asset && asset->static_source;
+}
+
+/** Publishes one planned run as a cluster and claims its members. */
+vkr_internal bool8_t vkr_mesh_manager_publish_static_cluster(
+    VkrMeshManager *manager, VkrAllocator *scratch,
+    const VkrStaticBatchItem *items, const VkrStaticBatchRun *run,
+    const VkrStaticBatchMember *members) {
+  VkrAllocator *allocator = &manager->static_batch_allocator;
+  VkrVertex3d *vertices = vkr_allocator_alloc(
+      scratch, sizeof(*vertices) * (uint64_t)run->vertex_count,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint32_t *indices = vkr_allocator_alloc(
+      scratch, sizeof(*indices) * (uint64_t)run->index_count,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrStaticBatchMember *cluster_members = vkr_allocator_alloc(
+      allocator, sizeof(*cluster_members) * run->item_count,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!vertices || !indices || !cluster_members) {
+    if (cluster_members) {
+      vkr_allocator_free(allocator, cluster_members,
+                         sizeof(*cluster_members) * run->item_count,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    return false_v;
+  }
+
+  VkrAabb bounds = {0};
+  vkr_static_batch_merge(items, run, vertices, indices, &bounds);
+  const Vec3 center = vec3_scale(vec3_add(bounds.min, bounds.max), 0.5f);
+  VkrGeometryConfig config = {
+      .vertex_size = sizeof(VkrVertex3d),
+      .vertex_count = run->vertex_count,
+      .vertices = vertices,
+      .index_size = sizeof(uint32_t),
+      .index_count = run->index_count,
+      .indices = indices,
+      .center = center,
+      .min_extents = vec3_sub(bounds.min, center),
+      .max_extents = vec3_sub(bounds.max, center),
+  };
+  string_format(config.name, sizeof(config.name), "static_batch_%u",
+                ++manager->static_batch_serial);
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  VkrGeometryHandle geometry = vkr_geometry_system_create(
+      manager->geometry_system, &config, true_v, &error);
+  if (geometry.id == 0) {
+    vkr_allocator_free(allocator, cluster_members,
+                       sizeof(*cluster_members) * run->item_count,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+
+  for (uint32_t i = 0; i < run->item_count; ++i) {
+    const VkrStaticBatchMember *member =
+        &members[items[run->first_item + i].user_data];
+    VkrMeshInstance *instance =
+        &manager->mesh_instances.data[member->instance_slot];
+    if (!instance->static_batched) {
+      const VkrMeshAsset *asset =
+          vkr_mesh_manager_get_live_asset(manager, instance->asset);
+      const uint32_t capacity = (uint32_t)asset->submeshes.length;
+      instance->static_batched = vkr_allocator_alloc(
+          allocator, capacity, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+      assert_log(instance->static_batched != NULL,
+                 "Failed to allocate static batch flags");
+      MemZero(instance->static_batched, capacity);
+      instance->static_batched_capacity = capacity;
+    }
+    instance->static_batched[member->submesh_index] = 1;
+    instance->static_batched_count++;
+    cluster_members[i] = *member;
+  }
+
+  const VkrStaticBatchCluster cluster = {
+      .geometry = geometry,
+      .material = items[run->first_item].material,
+      .center = center,
+      .min_extents = config.min_extents,
+      .max_extents = config.max_extents,
+      .members = cluster_members,
+      .member_count = run->item_count,
+  };
+  uint64_t slot = 0;
+  while (slot < manager->static_clusters.length &&
+         manager->static_clusters.data[slot].geometry.id != 0) {
+    slot++;
+  }
+  if (slot < manager->static_clusters.length) {
+    manager->static_clusters.data[slot] = cluster;
+  } else {
+    vector_push_VkrStaticBatchCluster(&manager->static_clusters, cluster);
+  }
+  manager->static_cluster_count++;
+  vkr_mesh_manager_touch(manager);
+  return true_v;
+}
+
+/**
+ * @brief Bakes static submeshes that are not batched yet into new clusters.
+ *
+ * Runs only after something changed, and waits while any static instance is
+ * still loading so a scene's static set is clustered in one pass instead of
+ * trickling into small per-asset batches. Existing clusters are left alone.
+ */
+vkr_internal void
+vkr_mesh_manager_update_static_batches(VkrMeshManager *manager) {
+  if (!manager->config.static_batching || !manager->static_batches_dirty) {
+    return;
+  }
+
+  uint64_t item_count = 0;
+  for (uint32_t i = 0; i < manager->instance_count; ++i) {
+    const uint32_t slot = manager->instance_live_indices.data[i];
+    const VkrMeshInstance *instance = &manager->mesh_instances.data[slot];
+    if (instance->is_static &&
+        instance->loading_state == VKR_MESH_LOADING_STATE_PENDING) {
+      return;
+    }
+    const VkrMeshAsset *asset = NULL;
+    if (vkr_mesh_manager_static_batch_eligible(manager, instance, &asset)) {
+      item_count += asset->submeshes.length - instance->static_batched_count;
+    }
+  }
+  manager->static_batches_dirty = false_v;
+  if (item_count < 2 || item_count > UINT32_MAX) {
+    return;
+  }
+
+  VkrAllocator *scratch = &manager->scratch_allocator;
+  VkrAllocatorScope scope = vkr_allocator_begin_scope(scratch);
+  if (!vkr_allocator_scope_is_valid(&scope)) {
+    return;
+  }
+  VkrStaticBatchItem *items = vkr_allocator_alloc(
+      scratch, sizeof(*items) * item_count, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrStaticBatchMember *members = vkr_allocator_alloc(
+      scratch, sizeof(*members) * item_count, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrStaticBatchRun *runs =
+      vkr_allocator_alloc(scratch, sizeof(*runs) * (item_count / 2),
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!items || !members || !runs) {
+    log_warn("MeshManager: static batching skipped (out of scratch memory)");
+    vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    return;
+  }
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < manager->instance_count; ++i) {
+    const uint32_t slot = manager->instance_live_indices.data[i];
+    const VkrMeshInstance *instance = &manager->mesh_instances.data[slot];
+    const VkrMeshAsset *asset = NULL;
+    if (!vkr_mesh_manager_static_batch_eligible(manager, instance, &asset)) {
+      continue;
+    }
+    for (uint32_t s = 0; s < asset->submeshes.length; ++s) {
+      const VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      if ((instance->static_batched && instance->static_batched[s]) ||
+          !vkr_mesh_manager_static_batch_material_ok(manager,
+                                                     submesh->material)) {
+        continue;
+      }
+      members[count] = (VkrStaticBatchMember){
+          .instance_slot = slot,
+          .instance_generation = instance->generation,
+          .submesh_index = s,
+      };
+      items[count] = (VkrStaticBatchItem){
+          .source = asset->static_source,
+          .first_index = submesh->first_index,
+          .index_count = submesh->index_count,
+          .vertex_offset = submesh->vertex_offset,
+          .model = instance->model,
+          .material = submesh->material,
+          .world_center = mat4_mul_vec3(instance->model, submesh->center),
+          .user_data = count,
+      };
+      count++;
+    }
+  }
+
+  const uint32_t run_count = vkr_static_batch_plan(
+      items, count, manager->config.static_batch_cell_size,
+      VKR_STATIC_BATCH_DEFAULT_MAX_VERTICES, runs, (uint32_t)(item_count / 2));
+  uint32_t published = 0;
+  uint32_t merged_items = 0;
+  for (uint32_t r = 0; r < run_count; ++r) {
+    VkrAllocatorScope run_scope = vkr_allocator_begin_scope(scratch);
+    if (vkr_mesh_manager_publish_static_cluster(manager, scratch, items,
+                                                &runs[r], members)) {
+      published++;
+      merged_items += runs[r].item_count;
+    }
+    if (vkr_allocator_scope_is_valid(&run_scope)) {
+      vkr_allocator_end_scope(&run_scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+  }
+  if (published > 0) {
+    log_debug("MeshManager: merged %u static submeshes into %u batches",
+              merged_items, published);
+  }
+  if (published < run_count) {
+    log_warn("MeshManager: %u static batches could not be published",
+             run_count - published);
+  }
+
+  vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+}
+
 vkr_internal bool8_t vkr_mesh_manager_resolve_geometry(
     VkrMeshManager *manager, const VkrSubMeshDesc *desc,
     VkrGeometryHandle *out_handle, bool8_t *out_owned,
@@ -605,6 +1110,8 @@ vkr_internal void vkr_mesh_manager_destroy_asset_slot(VkrMeshManager *manager,
     array_destroy_VkrMeshAssetSubmesh(&asset->submeshes);
   }
 
+  vkr_mesh_manager_release_asset_picking_bvh(manager, asset);
+  vkr_mesh_manager_release_asset_static_source(manager, asset);
   vkr_mesh_manager_free_asset_strings(manager, asset);
 
   MemZero(asset, sizeof(*asset));
@@ -750,6 +1257,10 @@ vkr_mesh_manager_refresh_instances_for_asset(VkrMeshManager *manager,
       continue;
     }
 
+    const VkrMeshLoadingState previous_state = instance->loading_state;
+    const bool8_t previous_bounds_valid = instance->bounds_valid;
+    const Vec3 previous_center = instance->bounds_world_center;
+    const float32_t previous_radius = instance->bounds_world_radius;
     if (asset->loading_state == VKR_MESH_LOADING_STATE_FAILED) {
       instance->loading_state = VKR_MESH_LOADING_STATE_FAILED;
       instance->bounds_valid = false_v;
@@ -766,6 +1277,16 @@ vkr_mesh_manager_refresh_instances_for_asset(VkrMeshManager *manager,
                                                 instance->model);
       }
     }
+    vkr_mesh_manager_sync_instance_bounds_index(manager, instance_slot,
+                                                instance);
+    if (instance->loading_state != previous_state ||
+        instance->bounds_valid != previous_bounds_valid ||
+        (instance->bounds_valid &&
+         (MemCompare(&instance->bounds_world_center, &previous_center,
+                     sizeof(previous_center)) != 0 ||
+          instance->bounds_world_radius != previous_radius))) {
+      vkr_mesh_manager_touch(manager);
+    }
 
     instance_slot = next_slot;
   }
@@ -1111,6 +1632,36 @@ bool8_t vkr_mesh_manager_init(VkrMeshManager *manager,
     array_set_uint32_t(&manager->instance_asset_prev, i, VKR_INVALID_ID);
   }
 
+  if (!vkr_mesh_bounds_index_init(&manager->bounds_index, &manager->allocator,
+                                  max_instances,
+                                  manager->config.max_mesh_count)) {
+    log_error("Failed to create mesh bounds index");
+    return false_v;
+  }
+
+  if (manager->config.build_picking_bvh) {
+    // Triangle BVHs scale with scene geometry, so reserve generously and let
+    // dmemory commit on demand.
+    if (!vkr_dmemory_create(MB(8), GB(4), &manager->picking_dmemory)) {
+      log_error("Failed to create mesh manager picking dmemory");
+      return false_v;
+    }
+    manager->picking_allocator.ctx = &manager->picking_dmemory;
+    vkr_dmemory_allocator_create(&manager->picking_allocator);
+  }
+
+  if (manager->config.static_batching) {
+    // Retained sources are whole mesh buffers; reserve like the picking store.
+    if (!vkr_dmemory_create(MB(8), GB(4), &manager->static_batch_dmemory)) {
+      log_error("Failed to create mesh manager static batch dmemory");
+      return false_v;
+    }
+    manager->static_batch_allocator.ctx = &manager->static_batch_dmemory;
+    vkr_dmemory_allocator_create(&manager->static_batch_allocator);
+    manager->static_clusters =
+        vector_create_VkrStaticBatchCluster(&manager->static_batch_allocator);
+  }
+
   return true_v;
 }
 
@@ -1131,6 +1682,13 @@ void vkr_mesh_manager_shutdown(VkrMeshManager *manager) {
   manager->mesh_count = 0;
   manager->next_free_index = 0;
 
+  for (uint64_t i = 0; i < manager->static_clusters.length; ++i) {
+    VkrStaticBatchCluster *cluster = &manager->static_clusters.data[i];
+    if (cluster->geometry.id != 0) {
+      vkr_mesh_manager_dissolve_static_cluster(manager, cluster);
+    }
+  }
+
   array_destroy_VkrMeshInstance(&manager->mesh_instances);
   array_destroy_uint32_t(&manager->instance_live_indices);
   array_destroy_uint32_t(&manager->instance_free_indices);
@@ -1146,10 +1704,17 @@ void vkr_mesh_manager_shutdown(VkrMeshManager *manager) {
   array_destroy_uint32_t(&manager->asset_instance_generations);
   vkr_hash_table_destroy_VkrMeshAssetEntry(&manager->asset_by_key);
   vkr_dmemory_allocator_destroy(&manager->asset_allocator);
+  if (manager->picking_allocator.ctx) {
+    vkr_dmemory_allocator_destroy(&manager->picking_allocator);
+  }
+  if (manager->static_batch_allocator.ctx) {
+    vkr_dmemory_allocator_destroy(&manager->static_batch_allocator);
+  }
 
   array_destroy_VkrMesh(&manager->meshes);
   array_destroy_uint32_t(&manager->mesh_live_indices);
   array_destroy_uint32_t(&manager->free_indices);
+  vkr_mesh_bounds_index_shutdown(&manager->bounds_index);
   arena_destroy(manager->arena);
   arena_destroy(manager->scratch_arena);
 }
@@ -1180,6 +1745,7 @@ bool8_t vkr_mesh_manager_create(VkrMeshManager *manager,
   }
 
   mesh->loading_state = VKR_MESH_LOADING_STATE_LOADED;
+  vkr_mesh_manager_touch(manager);
 
   return true_v;
 }
@@ -1319,6 +1885,8 @@ bool8_t vkr_mesh_manager_add(VkrMeshManager *manager, const VkrMeshDesc *desc,
   array_set_VkrMesh(&manager->meshes, slot, new_mesh);
   array_set_uint32_t(&manager->mesh_live_indices, new_mesh.live_index, slot);
   manager->mesh_count++;
+  vkr_mesh_manager_sync_mesh_bounds_index(manager, slot, &new_mesh);
+  vkr_mesh_manager_touch(manager);
 
   if (out_index) {
     *out_index = slot;
@@ -1777,6 +2345,7 @@ vkr_internal bool8_t vkr_mesh_manager_process_resource_handle(
     VkrMesh *mesh = array_get_VkrMesh(&manager->meshes, mesh_index);
     if (mesh) {
       mesh->loading_state = VKR_MESH_LOADING_STATE_LOADED;
+      vkr_mesh_manager_touch(manager);
     }
     if (out_error) {
       *out_error = VKR_RENDERER_ERROR_NONE;
@@ -1799,8 +2368,12 @@ bool8_t vkr_mesh_manager_remove(VkrMeshManager *manager, uint32_t index) {
 
   uint32_t live_index = mesh->live_index;
 
+  vkr_mesh_bounds_index_remove(
+      &manager->bounds_index,
+      vkr_mesh_bounds_index_mesh_key(&manager->bounds_index, index));
   vkr_mesh_manager_release_handles(manager, mesh);
   array_destroy_VkrSubMesh(&mesh->submeshes);
+  vkr_mesh_manager_touch(manager);
 
   if (manager->mesh_count > 0 && live_index < manager->mesh_count) {
     uint32_t last_index = manager->mesh_count - 1;
@@ -1890,6 +2463,7 @@ bool8_t vkr_mesh_manager_set_submesh_material(VkrMeshManager *manager,
   submesh->material = material;
   submesh->owns_material = true_v;
   submesh->last_render_frame = 0;
+  vkr_mesh_manager_touch(manager);
 
   *out_error = VKR_RENDERER_ERROR_NONE;
   return true_v;
@@ -1905,9 +2479,14 @@ void vkr_mesh_manager_update_model(VkrMeshManager *manager, uint32_t index) {
   if (!mesh || !mesh->submeshes.data || mesh->submeshes.length == 0)
     return;
 
-  mesh->model = vkr_transform_get_world(&mesh->transform);
+  const Mat4 model = vkr_transform_get_world(&mesh->transform);
+  if (MemCompare(&mesh->model, &model, sizeof(model)) != 0) {
+    vkr_mesh_manager_touch(manager);
+  }
+  mesh->model = model;
 
   vkr_mesh_update_world_bounds(mesh);
+  vkr_mesh_manager_sync_mesh_bounds_index(manager, index, mesh);
 
   for (uint32_t submesh_index = 0; submesh_index < mesh->submeshes.length;
        ++submesh_index) {
@@ -1927,9 +2506,13 @@ bool8_t vkr_mesh_manager_set_model(VkrMeshManager *manager, uint32_t index,
   if (!mesh || !mesh->submeshes.data || mesh->submeshes.length == 0)
     return false_v;
 
+  if (MemCompare(&mesh->model, &model, sizeof(model)) != 0) {
+    vkr_mesh_manager_touch(manager);
+  }
   mesh->model = model;
 
   vkr_mesh_update_world_bounds(mesh);
+  vkr_mesh_manager_sync_mesh_bounds_index(manager, index, mesh);
 
   // Reset instance cache for all submeshes
   for (uint32_t submesh_index = 0; submesh_index < mesh->submeshes.length;
@@ -1952,7 +2535,11 @@ bool8_t vkr_mesh_manager_set_visible(VkrMeshManager *manager, uint32_t index,
   if (!mesh || !mesh->submeshes.data || mesh->submeshes.length == 0)
     return false_v;
 
+  if (mesh->visible != visible) {
+    vkr_mesh_manager_touch(manager);
+  }
   mesh->visible = visible;
+  vkr_mesh_manager_sync_mesh_bounds_index(manager, index, mesh);
 
   return true_v;
 }
@@ -2285,6 +2872,97 @@ void vkr_mesh_manager_pump_async(VkrMeshManager *manager) {
     }
     (void)vkr_mesh_manager_sync_pending_asset(manager, i, asset);
   }
+
+  vkr_mesh_manager_update_static_batches(manager);
+}
+
+/**
+ * @brief Fraction of the viewport a sphere covers, approximated by the ellipse
+ * its radius spans at the center's distance. Reaches 1 once the camera is
+ * inside the sphere.
+ */
+vkr_internal float32_t vkr_mesh_manager_sphere_coverage(
+    const Mat4 *projection, float32_t distance, float32_t radius) {
+  if (distance <= radius) {
+    return 1.0f;
+  }
+  // Orthographic projections keep w at 1; perspective ones divide by depth.
+  const float32_t w = projection->m33 != 0.0f ? 1.0f : distance;
+  const float32_t ndc_x = radius * vkr_abs_f32(projection->m00) / w;
+  const float32_t ndc_y = radius * vkr_abs_f32(projection->m11) / w;
+  // The NDC square is 2x2, so an ellipse of these half-axes covers
+  // pi * x * y / 4 of it.
+  return Min(VKR_PI * ndc_x * ndc_y * 0.25f, 1.0f);
+}
+
+void vkr_mesh_manager_update_streaming(VkrMeshManager *manager,
+                                       Vec3 view_position,
+                                       const Mat4 *projection) {
+  assert_log(manager != NULL, "Manager is NULL");
+  assert_log(projection != NULL, "Projection is NULL");
+
+  for (uint32_t slot = 0; slot < manager->mesh_assets.length; ++slot) {
+    VkrMeshAsset *asset = array_get_VkrMeshAsset(&manager->mesh_assets, slot);
+    if (!asset || asset->id == 0 ||
+        asset->loading_state != VKR_MESH_LOADING_STATE_PENDING ||
+        asset->pending_request_id == 0 ||
+        *array_get_uint32_t(&manager->asset_instance_generations, slot) !=
+            asset->generation) {
+      continue;
+    }
+
+    VkrResourceStreamingHint hint = {
+        .screen_coverage = 0.0f,
+        .camera_distance = VKR_FLOAT_MAX,
+    };
+    bool8_t used = false_v;
+    uint32_t instance_slot =
+        *array_get_uint32_t(&manager->asset_instance_heads, slot);
+    while (instance_slot != VKR_INVALID_ID &&
+           instance_slot < manager->mesh_instances.length &&
+           instance_slot < manager->instance_asset_next.length) {
+      const uint32_t next_slot =
+          *array_get_uint32_t(&manager->instance_asset_next, instance_slot);
+      const VkrMeshInstance *instance =
+          array_get_VkrMeshInstance(&manager->mesh_instances, instance_slot);
+      instance_slot = next_slot;
+      if (!instance || instance->asset.id != asset->id ||
+          instance->asset.generation != asset->generation) {
+        continue;
+      }
+
+      /*
+       * Pending assets have no bounds yet, so stand in a unit sphere under
+       * the instance transform.
+       */
+      const Mat4 model = instance->model;
+      const Vec3 center = vec3_new(model.m03, model.m13, model.m23);
+      const float32_t radius = vkr_max_f32(
+          vkr_max_f32(vec3_length(vec3_new(model.m00, model.m10, model.m20)),
+                      vec3_length(vec3_new(model.m01, model.m11, model.m21))),
+          vec3_length(vec3_new(model.m02, model.m12, model.m22)));
+      const float32_t center_distance =
+          vec3_length(vec3_sub(center, view_position));
+      hint.camera_distance =
+          Min(hint.camera_distance, Max(center_distance - radius, 0.0f));
+      if (instance->visible) {
+        hint.screen_coverage =
+            Max(hint.screen_coverage,
+                vkr_mesh_manager_sphere_coverage(projection, center_distance,
+                                                 radius));
+      }
+      used = true_v;
+    }
+    if (!used) {
+      continue;
+    }
+
+    VkrResourceHandleInfo tracked_info = {
+        .type = VKR_RESOURCE_TYPE_MESH,
+        .request_id = asset->pending_request_id,
+    };
+    vkr_resource_system_update_streaming(&tracked_info, &hint);
+  }
 }
 
 VkrMeshAsset *vkr_mesh_manager_get_asset(VkrMeshManager *manager,
@@ -2395,6 +3073,8 @@ VkrMeshInstanceHandle vkr_mesh_manager_create_instance(
                                                      inst->asset);
   asset->ref_count++;
   manager->instance_count++;
+  vkr_mesh_manager_sync_instance_bounds_index(manager, slot, inst);
+  vkr_mesh_manager_touch(manager);
 
   return (VkrMeshInstanceHandle){.id = slot + 1,
                                  .generation = inst->generation};
@@ -2840,6 +3520,10 @@ vkr_internal bool8_t vkr_mesh_manager_build_asset_from_mesh_result(
     asset->bounds_local_radius = vec3_length(half_extents);
   }
 
+  vkr_mesh_manager_build_asset_picking_bvh(manager, asset, mesh_result,
+                                           use_merged);
+  vkr_mesh_manager_retain_asset_static_source(manager, asset, mesh_result,
+                                              use_merged);
   return true_v;
 }
 
@@ -3167,6 +3851,11 @@ vkr_internal VkrMeshAssetHandle vkr_mesh_manager_create_asset_from_handle_info(
     asset->bounds_local_radius = vec3_length(half_extents);
   }
 
+  vkr_mesh_manager_build_asset_picking_bvh(manager, asset, mesh_result,
+                                           use_merged);
+  vkr_mesh_manager_retain_asset_static_source(manager, asset, mesh_result,
+                                              use_merged);
+
   char *key_copy =
       vkr_allocator_alloc(&manager->asset_allocator, string_length(key_buf) + 1,
                           VKR_ALLOCATOR_MEMORY_TAG_STRING);
@@ -3361,8 +4050,13 @@ bool8_t vkr_mesh_manager_destroy_instance(VkrMeshManager *manager,
 
   uint32_t live_index = inst->live_index;
 
+  vkr_mesh_manager_dissolve_instance_static_clusters(manager, slot);
+  vkr_mesh_bounds_index_remove(
+      &manager->bounds_index,
+      vkr_mesh_bounds_index_instance_key(&manager->bounds_index, slot));
   vkr_mesh_manager_asset_instance_index_remove_instance(manager, slot,
                                                         inst->asset);
+  vkr_mesh_manager_touch(manager);
 
   vkr_mesh_manager_release_asset(manager, inst->asset);
 
@@ -3437,16 +4131,68 @@ void vkr_mesh_manager_instance_sync_render_state(VkrMeshManager *manager,
                                                  VkrMeshInstanceHandle instance,
                                                  Mat4 model, uint32_t render_id,
                                                  bool8_t visible) {
-  VkrMeshInstance *inst = &manager->mesh_instances.data[instance.id - 1u];
+  const uint32_t slot = instance.id - 1u;
+  VkrMeshInstance *inst = &manager->mesh_instances.data[slot];
+
+  const bool8_t changed =
+      visible != inst->visible ||
+      (visible && MemCompare(&inst->model, &model, sizeof(model)) != 0);
+  if (changed) {
+    vkr_mesh_manager_touch(manager);
+  }
+  if (inst->is_static && changed) {
+    // Hidden or moved: restore the original draws and rebatch what is left,
+    // including this instance once it is visible again.
+    vkr_mesh_manager_dissolve_instance_static_clusters(manager, slot);
+    manager->static_batches_dirty = true_v;
+  }
 
   inst->visible = visible;
   inst->render_id = render_id;
   if (!visible) {
+    vkr_mesh_manager_sync_instance_bounds_index(manager, slot, inst);
     return;
   }
   inst->model = model;
   VkrMeshAsset *asset = vkr_mesh_manager_get_live_asset(manager, inst->asset);
   vkr_mesh_manager_update_instance_bounds(inst, asset, model);
+  vkr_mesh_manager_sync_instance_bounds_index(manager, slot, inst);
+}
+
+bool8_t vkr_mesh_manager_set_instance_static(VkrMeshManager *manager,
+                                             VkrMeshInstanceHandle instance,
+                                             bool8_t is_static) {
+  assert_log(manager != NULL, "Manager is NULL");
+
+  VkrMeshInstance *inst = vkr_mesh_manager_get_instance(manager, instance);
+  if (!inst) {
+    return false_v;
+  }
+  if (inst->is_static == is_static || !manager->config.static_batching) {
+    inst->is_static = is_static;
+    return true_v;
+  }
+
+  inst->is_static = is_static;
+  if (is_static) {
+    manager->static_batches_dirty = true_v;
+  } else {
+    vkr_mesh_manager_dissolve_instance_static_clusters(manager,
+                                                       instance.id - 1);
+  }
+  return true_v;
+}
+
+uint32_t
+vkr_mesh_manager_static_cluster_capacity(const VkrMeshManager *manager) {
+  return (uint32_t)manager->static_clusters.length;
+}
+
+const VkrStaticBatchCluster *
+vkr_mesh_manager_get_static_cluster(const VkrMeshManager *manager,
+                                    uint32_t index) {
+  const VkrStaticBatchCluster *cluster = &manager->static_clusters.data[index];
+  return cluster->geometry.id != 0 ? cluster : NULL;
 }
 
 uint32_t vkr_mesh_manager_instance_count(const VkrMeshManager *manager) {
@@ -3457,3 +4203,223 @@ uint32_t vkr_mesh_manager_instance_capacity(const VkrMeshManager *manager) {
   assert_log(manager != NULL, "Manager is NULL");
   return (uint32_t)manager->mesh_instances.length;
 }
+
+// ============================================================================
+// Spatial Queries
+// ============================================================================
+
+vkr_internal VkrMeshQueryItem
+vkr_mesh_manager_query_item(const VkrMeshManager *manager, uint32_t key) {
+  const VkrMeshBoundsIndex *index = &manager->bounds_index;
+  const uint32_t slot = vkr_mesh_bounds_index_key_slot(index, key);
+  if (vkr_mesh_bounds_index_key_is_instance(index, key)) {
+    return (VkrMeshQueryItem){
+        .is_instance = true_v,
+        .slot = slot,
+        .render_id = manager->mesh_instances.data[slot].render_id,
+    };
+  }
+  return (VkrMeshQueryItem){
+      .is_instance = false_v,
+      .slot = slot,
+      .render_id = manager->meshes.data[slot].render_id,
+  };
+}
+
+/**
+ * @brief Entry distance of a normalized ray into a sphere; 0 when the origin
+ * is inside.
+ */
+vkr_internal INLINE bool8_t vkr_mesh_manager_ray_sphere(const VkrRay *ray,
+                                                        Vec4 sphere,
+                                                        float32_t max_t,
+                                                        float32_t *out_t) {
+  const Vec3 offset =
+      vec3_sub(ray->origin, vec3_new(sphere.x, sphere.y, sphere.z));
+  const float32_t b = vec3_dot(offset, ray->direction);
+  const float32_t c = vec3_dot(offset, offset) - sphere.w * sphere.w;
+  if (c > 0.0f && b > 0.0f) {
+    return false_v;
+  }
+  const float32_t discriminant = b * b - c;
+  if (discriminant < 0.0f) {
+    return false_v;
+  }
+  const float32_t t = vkr_max_f32(-b - vkr_sqrt_f32(discriminant), 0.0f);
+  if (t >= max_t) {
+    return false_v;
+  }
+  *out_t = t;
+  return true_v;
+}
+
+typedef struct VkrMeshRaycastContext {
+  VkrMeshManager *manager;
+  VkrMeshQueryFn filter;
+  void *user_data;
+  VkrMeshQueryItem item;
+  bool8_t triangle_hit;
+} VkrMeshRaycastContext;
+
+vkr_internal bool8_t vkr_mesh_manager_raycast_key(uint32_t key,
+                                                  const VkrRay *ray,
+                                                  float32_t max_t,
+                                                  float32_t *out_t,
+                                                  void *user_data) {
+  VkrMeshRaycastContext *context = (VkrMeshRaycastContext *)user_data;
+  VkrMeshManager *manager = context->manager;
+  const VkrMeshQueryItem item = vkr_mesh_manager_query_item(manager, key);
+  if (context->filter && !context->filter(&item, context->user_data)) {
+    return false_v;
+  }
+
+  float32_t t = 0.0f;
+  if (!vkr_mesh_manager_ray_sphere(ray, manager->bounds_index.spheres[key],
+                                   max_t, &t)) {
+    return false_v;
+  }
+
+  const VkrMeshAsset *asset = NULL;
+  Mat4 model = mat4_identity();
+  if (item.is_instance) {
+    const VkrMeshInstance *instance = &manager->mesh_instances.data[item.slot];
+    asset = vkr_mesh_manager_get_live_asset(manager, instance->asset);
+    model = instance->model;
+  }
+
+  bool8_t triangle_hit = false_v;
+  if (asset && asset->picking_bvh) {
+    // Move the ray into mesh space without renormalizing the direction, so
+    // the mesh-space hit parameter is still the world distance.
+    const Mat4 inverse = mat4_inverse(model);
+    const Vec4 direction = mat4_mul_vec4(
+        inverse, vec4_new(ray->direction.x, ray->direction.y,
+                          ray->direction.z, 0.0f));
+    const VkrRay local_ray = {
+        .origin = mat4_mul_vec3(inverse, ray->origin),
+        .direction = vec3_new(direction.x, direction.y, direction.z),
+    };
+    if (!vkr_triangle_bvh_raycast(asset->picking_bvh, &local_ray, max_t, &t,
+                                  NULL)) {
+      return false_v;
+    }
+    triangle_hit = true_v;
+  }
+
+  // The traversal only accepts hits closer than max_t, so the last accepted
+  // item is the closest one.
+  context->item = item;
+  context->triangle_hit = triangle_hit;
+  *out_t = t;
+  return true_v;
+}
+
+bool8_t vkr_mesh_manager_raycast(VkrMeshManager *manager, Vec3 origin,
+                                 Vec3 direction, float32_t max_distance,
+                                 VkrMeshQueryFn filter, void *user_data,
+                                 VkrMeshRayHit *out_hit) {
+  assert_log(manager != NULL, "Manager is NULL");
+  assert_log(out_hit != NULL, "Out hit is NULL");
+
+  const float32_t length_squared = vec3_length_squared(direction);
+  if (length_squared <= VKR_FLOAT_EPSILON || max_distance <= 0.0f) {
+    return false_v;
+  }
+
+  const VkrRay ray = {
+      .origin = origin,
+      .direction = vec3_scale(direction, 1.0f / vkr_sqrt_f32(length_squared)),
+  };
+  VkrMeshRaycastContext context = {
+      .manager = manager,
+      .filter = filter,
+      .user_data = user_data,
+  };
+  VkrBvhRayHit hit = {0};
+  if (!vkr_mesh_bounds_index_query_ray(&manager->bounds_index, &ray,
+                                       max_distance,
+                                       vkr_mesh_manager_raycast_key, &context,
+                                       &hit)) {
+    return false_v;
+  }
+
+  out_hit->item = context.item;
+  out_hit->distance = hit.t;
+  out_hit->position = vec3_add(ray.origin, vec3_scale(ray.direction, hit.t));
+  out_hit->triangle_hit = context.triangle_hit;
+  return true_v;
+}
+
+typedef struct VkrMeshVolumeQueryContext {
+  VkrMeshManager *manager;
+  const VkrFrustum *frustum; /**< NULL for sphere queries. */
+  Vec3 center;
+  float32_t radius;
+  VkrMeshQueryFn visit;
+  void *user_data;
+  uint32_t visited;
+} VkrMeshVolumeQueryContext;
+
+vkr_internal bool8_t vkr_mesh_manager_volume_query_key(uint32_t key,
+                                                       void *user_data) {
+  VkrMeshVolumeQueryContext *context = (VkrMeshVolumeQueryContext *)user_data;
+  const Vec4 sphere = context->manager->bounds_index.spheres[key];
+  const Vec3 center = vec3_new(sphere.x, sphere.y, sphere.z);
+
+  // The index tests AABBs around the spheres; refine against the spheres.
+  if (context->frustum) {
+    if (!vkr_frustum_test_sphere(context->frustum, center, sphere.w)) {
+      return true_v;
+    }
+  } else {
+    const float32_t reach = context->radius + sphere.w;
+    if (vec3_length_squared(vec3_sub(center, context->center)) >
+        reach * reach) {
+      return true_v;
+    }
+  }
+
+  const VkrMeshQueryItem item =
+      vkr_mesh_manager_query_item(context->manager, key);
+  context->visited++;
+  return context->visit(&item, context->user_data);
+}
+
+uint32_t vkr_mesh_manager_query_sphere(VkrMeshManager *manager, Vec3 center,
+                                       float32_t radius, VkrMeshQueryFn visit,
+                                       void *user_data) {
+  assert_log(manager != NULL, "Manager is NULL");
+  assert_log(visit != NULL, "Visit is NULL");
+
+  VkrMeshVolumeQueryContext context = {
+      .manager = manager,
+      .center = center,
+      .radius = radius,
+      .visit = visit,
+      .user_data = user_data,
+  };
+  vkr_mesh_bounds_index_query_sphere(&manager->bounds_index, center, radius,
+                                     vkr_mesh_manager_volume_query_key,
+                                     &context);
+  return context.visited;
+}
+
+uint32_t vkr_mesh_manager_query_frustum(VkrMeshManager *manager,
+                                        const VkrFrustum *frustum,
+                                        VkrMeshQueryFn visit, void *user_data) {
+  assert_log(manager != NULL, "Manager is NULL");
+  assert_log(frustum != NULL, "Frustum is NULL");
+  assert_log(visit != NULL, "Visit is NULL");
+
+  VkrMeshVolumeQueryContext context = {
+      .manager = manager,
+      .frustum = frustum,
+      .visit = visit,
+      .user_data = user_data,
+  };
+  vkr_mesh_bounds_index_query_planes(&manager->bounds_index, frustum->planes,
+                                     VKR_FRUSTUM_PLANE_COUNT,
+                                     vkr_mesh_manager_volume_query_key,
+                                     &context);
+  return context.visited;
+}
@@ -9,6 +9,7 @@
 
 #include "containers/array.h"
 #include "containers/str.h"
+#include "containers/vector.h"
 #include "containers/vkr_hashtable.h"
 #include "defines.h"
 #include "math/vkr_transform.h"
@@ -17,6 +18,8 @@
 #include "renderer/resources/vkr_resources.h"
 #include "renderer/systems/vkr_geometry_system.h"
 #include "renderer/systems/vkr_material_system.h"
+#include "renderer/systems/vkr_mesh_bounds_index.h"
+#include "renderer/systems/vkr_static_batch.h"
 #include "renderer/vkr_renderer.h"
 
 // ============================================================================
@@ -26,9 +29,18 @@
 /**
  * @brief Configuration for the mesh manager.
  * @param max_mesh_count The maximum number of meshes to manage.
+ * @param build_picking_bvh Build a CPU triangle BVH per loaded mesh asset so
+ * vkr_mesh_manager_raycast can hit triangles instead of bounding spheres.
+ * @param static_batching Retain CPU copies of merged mesh buffers and bake the
+ * submeshes of static instances into per-material, per-cell batches.
+ * @param static_batch_cell_size World-space cell edge used to group static
+ * submeshes (0 uses VKR_STATIC_BATCH_DEFAULT_CELL_SIZE).
  */
 typedef struct VkrMeshManagerConfig {
   uint32_t max_mesh_count;
+  bool8_t build_picking_bvh;
+  bool8_t static_batching;
+  float32_t static_batch_cell_size;
 } VkrMeshManagerConfig;
 
 /**
@@ -113,6 +125,8 @@ typedef struct VkrMeshAssetEntry {
 } VkrMeshAssetEntry;
 VkrHashTable(VkrMeshAssetEntry);
 
+Vector(VkrStaticBatchCluster);
+
 /**
  * @brief Manager for the mesh system.
  * @param arena The arena to use for the mesh manager.
@@ -163,8 +177,66 @@ typedef struct VkrMeshManager {
   uint32_t instance_count;
   uint32_t next_instance_index;
   uint32_t instance_generation_counter;
+
+  // World-bounds BVH over drawable meshes and instances, kept in sync
+  // wherever world bounds, visibility, or loading state change.
+  VkrMeshBoundsIndex bounds_index;
+
+  // Backing store for per-asset picking BVHs (see build_picking_bvh).
+  VkrDMemory picking_dmemory;
+  VkrAllocator picking_allocator;
+
+  // Static batching (see static_batching): retained asset sources, member
+  // lists and per-instance flags live in their own freeable store. Cluster
+  // slots with a zero geometry id are free.
+  VkrDMemory static_batch_dmemory;
+  VkrAllocator static_batch_allocator;
+  Vector_VkrStaticBatchCluster static_clusters;
+  uint32_t static_cluster_count;
+  uint32_t static_batch_serial;
+  bool8_t static_batches_dirty;
+
+  /**
+   * Bumped whenever a drawable mesh or instance changes anything world
+   * candidates are built from: membership, visibility, loading state, model,
+   * submesh material or static batch clusters. Render-id changes do not
+   * count. Unchanged re-submissions leave it alone, so consumers can compare
+   * it instead of the candidates themselves.
+   */
+  uint64_t render_version;
 } VkrMeshManager;
 
+/**
+ * @brief Drawable returned by spatial queries: a mesh instance or a legacy
+ * mesh slot, with the render id it was last synced with.
+ */
+typedef struct VkrMeshQueryItem {
+  bool8_t is_instance;
+  uint32_t slot;
+  uint32_t render_id;
+} VkrMeshQueryItem;
+
+/**
+ * @brief Query visitor/filter. As a visitor, return false to stop; as a ray
+ * filter, return false to skip the item.
+ */
+typedef bool8_t (*VkrMeshQueryFn)(const VkrMeshQueryItem *item,
+                                  void *user_data);
+
+/**
+ * @brief Closest hit returned by vkr_mesh_manager_raycast.
+ * @param distance World distance along the normalized ray direction.
+ * @param triangle_hit True when the hit came from the asset's triangle BVH;
+ * false when only the bounding sphere was available (legacy meshes, assets
+ * without CPU triangles).
+ */
+typedef struct VkrMeshRayHit {
+  VkrMeshQueryItem item;
+  float32_t distance;
+  Vec3 position;
+  bool8_t triangle_hit;
+} VkrMeshRayHit;
+
 // ============================================================================
 // Functions
 // ============================================================================
@@ -377,12 +449,32 @@ VkrMeshAssetHandle vkr_mesh_manager_acquire_asset(VkrMeshManager *manager,
  * @brief Progress pending mesh asset requests on the render thread.
  *
  * Finalizes assets whose mesh resource requests reached READY state and updates
- * dependent instances from `PENDING` to `LOADED`.
+ * dependent instances from `PENDING` to `LOADED`. With static batching
+ * enabled, also bakes newly static submeshes into batches once no static
+ * instance is still loading.
  *
  * @param manager The mesh manager.
  */
 void vkr_mesh_manager_pump_async(VkrMeshManager *manager);
 
+/**
+ * @brief Hands the resource system a streaming hint for every pending asset.
+ *
+ * Each pending asset is ranked by the nearest of its instances and by the
+ * largest share of the viewport a visible instance covers, with a unit sphere
+ * under the instance transform standing in for bounds not loaded yet. Assets
+ * whose instances are all hidden rank last. Call once per frame with the
+ * camera the frame renders from; the next resource-system pump serves the
+ * hinted requests in that order.
+ *
+ * @param manager The mesh manager.
+ * @param view_position World-space camera position.
+ * @param projection Camera projection matrix.
+ */
+void vkr_mesh_manager_update_streaming(VkrMeshManager *manager,
+                                       Vec3 view_position,
+                                       const Mat4 *projection);
+
 /**
  * @brief Release a mesh asset reference.
  *
@@ -532,6 +624,36 @@ void vkr_mesh_manager_instance_sync_render_state(VkrMeshManager *manager,
                                                  Mat4 model, uint32_t render_id,
                                                  bool8_t visible);
 
+/**
+ * @brief Marks an instance static (never moves) or dynamic.
+ *
+ * Static instances are baked into static batches on a later
+ * vkr_mesh_manager_pump_async once their asset has loaded. Making an instance
+ * dynamic, moving it, hiding it, or destroying it dissolves every cluster it
+ * belongs to and restores the original submesh draws; the clusters' other
+ * static members are rebatched without it. Moving a static instance through
+ * vkr_mesh_manager_instance_sync_render_state also makes it dynamic.
+ *
+ * @return false if the handle is invalid.
+ */
+bool8_t vkr_mesh_manager_set_instance_static(VkrMeshManager *manager,
+                                             VkrMeshInstanceHandle instance,
+                                             bool8_t is_static);
+
+/**
+ * @brief Number of static cluster slots; pair with
+ * vkr_mesh_manager_get_static_cluster.
+ */
+uint32_t
+vkr_mesh_manager_static_cluster_capacity(const VkrMeshManager *manager);
+
+/**
+ * @brief Returns the static cluster at `index`, or NULL for a free slot.
+ */
+const VkrStaticBatchCluster *
+vkr_mesh_manager_get_static_cluster(const VkrMeshManager *manager,
+                                    uint32_t index);
+
 /**
  * @brief Get count of live mesh instances.
  */
@@ -541,3 +663,41 @@ uint32_t vkr_mesh_manager_instance_count(const VkrMeshManager *manager);
  * @brief Get capacity of mesh instance storage.
  */
 uint32_t vkr_mesh_manager_instance_capacity(const VkrMeshManager *manager);
+
+// ============================================================================
+// Spatial Queries
+// ============================================================================
+
+/**
+ * @brief Closest drawable hit by a world-space ray.
+ *
+ * Walks the bounds index front to back, rejects each candidate against its
+ * bounding sphere, then refines instances whose asset has a picking BVH
+ * against its triangles in mesh space. Reflects the state of the last
+ * bounds/visibility sync, so call after the scene has been synced.
+ *
+ * @param direction Ray direction; normalized internally.
+ * @param max_distance Hits at or beyond this distance are ignored.
+ * @param filter Optional; items it rejects are skipped.
+ * @return True when something was hit.
+ */
+bool8_t vkr_mesh_manager_raycast(VkrMeshManager *manager, Vec3 origin,
+                                 Vec3 direction, float32_t max_distance,
+                                 VkrMeshQueryFn filter, void *user_data,
+                                 VkrMeshRayHit *out_hit);
+
+/**
+ * @brief Visits every drawable whose bounding sphere overlaps the sphere.
+ * @return Number of items visited.
+ */
+uint32_t vkr_mesh_manager_query_sphere(VkrMeshManager *manager, Vec3 center,
+                                       float32_t radius, VkrMeshQueryFn visit,
+                                       void *user_data);
+
+/**
+ * @brief Visits every drawable whose bounding sphere passes the frustum test.
+ * @return Number of items visited.
+ */
+uint32_t vkr_mesh_manager_query_frustum(VkrMeshManager *manager,
+                                        const VkrFrustum *frustum,
+                                        VkrMeshQueryFn visit, void *user_data);
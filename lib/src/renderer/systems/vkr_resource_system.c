@@ -1,5 +1,6 @@
 #include "renderer/systems/vkr_resource_system.h"
 #include "containers/vkr_hashtable.h"
+#include "containers/vkr_sort.h"
 #include "filesystem/filesystem.h"
 #include "memory/vkr_allocator.h"
 #include "platform/vkr_platform.h"
@@ -25,8 +26,25 @@ typedef struct VkrResourceAsyncRequest {
   uint64_t metrics_start_ns;
   uint64_t metrics_bytes;
   bool8_t metrics_emitted;
+
+  // Streaming scheduler state.
+  float32_t screen_coverage;
+  float32_t camera_distance;
+  bool8_t streamed; // received a hint; cached once unreferenced
+  uint64_t last_hint_pump;
+  uint64_t resident_bytes;
+  uint64_t parent_request_id; // request whose load issued this one, 0 if none
+  uint32_t parent_index;
 } VkrResourceAsyncRequest;
 
+/** One pending request in the order a pump visits it. */
+typedef struct VkrResourcePumpEntry {
+  float32_t screen_coverage;
+  float32_t camera_distance;
+  uint64_t request_id;
+  uint32_t index;
+} VkrResourcePumpEntry;
+
 typedef struct VkrResourceAsyncCompletion {
   uint64_t request_id;
   uint32_t loader_id;
@@ -72,6 +90,15 @@ struct VkrResourceSystem {
   uint32_t completion_tail;
   uint32_t completion_count;
   VkrMetricEventProducer asset_load_metrics[VKR_RENDERER_ASSET_METRIC_COUNT];
+
+  // Streaming scheduler.
+  VkrResourceStreamingConfig streaming;
+  uint32_t cpu_jobs_in_flight;
+  uint64_t resident_bytes;
+  uint64_t pump_index;
+  float64_t finalize_ns_per_unit; // running average, 0 until measured
+  VkrResourcePumpEntry *pump_order;
+  uint32_t pump_order_capacity;
 };
 
 /**
@@ -81,12 +108,29 @@ vkr_global VkrResourceSystem *vkr_resource_system = NULL;
 
 vkr_internal _Thread_local bool8_t g_resource_system_force_sync = false_v;
 
+/*
+ * Request whose prepare or finalize callback is running on this thread, so the
+ * dependency loads it issues can inherit its streaming hint.
+ */
+vkr_internal _Thread_local uint64_t g_resource_system_parent_request_id = 0;
+
+/** Ancestor links followed when a dependency inherits a streaming hint. */
+#define VKR_RESOURCE_HINT_INHERIT_DEPTH 4u
+
 #define VKR_RESOURCE_COMPLETION_QUEUE_INITIAL_CAPACITY 512u
 
+/*
+ * Finalize cost units weigh one upload op like 64 KiB of upload bytes; the
+ * time model learns nanoseconds per unit.
+ */
+#define VKR_RESOURCE_FINALIZE_BYTES_PER_UNIT (64ull * 1024ull)
+#define VKR_RESOURCE_FINALIZE_AVERAGE_WEIGHT 0.125
+
 vkr_internal const VkrResourceAsyncBudget vkr_resource_async_budget_default = {
     .max_finalize_requests = 32,
     .max_gpu_upload_ops = 64,
     .max_gpu_upload_bytes = 32ull * 1024ull * 1024ull,
+    .max_finalize_ns = 4000000ull,
 };
 
 vkr_internal bool8_t vkr_resource_system_async_load_job_run(VkrJobContext *ctx,
@@ -516,6 +560,13 @@ vkr_internal int32_t vkr_resource_system_request_find_by_id_locked(
   return -1;
 }
 
+/** True when the loader's READY results must not be held by the cache. */
+vkr_internal bool8_t vkr_resource_system_loader_uncached(
+    const VkrResourceSystem *system, uint32_t loader_id) {
+  return loader_id < system->loader_count &&
+         system->loaders[loader_id].streaming_uncached;
+}
+
 vkr_internal bool8_t vkr_resource_system_allocate_string8_copy(
     VkrResourceSystem *system, String8 source, char **out_cstr,
     String8 *out_string8) {
@@ -576,6 +627,29 @@ vkr_resource_system_make_request_key(VkrResourceSystem *system,
   return key;
 }
 
+/** Clears a request's in-flight flag and returns its job-system slot. */
+vkr_internal void
+vkr_resource_system_cpu_job_done_locked(VkrResourceSystem *system,
+                                        VkrResourceAsyncRequest *request) {
+  if (!request->cpu_job_in_flight) {
+    return;
+  }
+  request->cpu_job_in_flight = false_v;
+  if (system->cpu_jobs_in_flight > 0) {
+    system->cpu_jobs_in_flight--;
+  }
+}
+
+vkr_internal void
+vkr_resource_system_set_resident_locked(VkrResourceSystem *system,
+                                        VkrResourceAsyncRequest *request,
+                                        uint64_t bytes) {
+  system->resident_bytes -=
+      Min(system->resident_bytes, request->resident_bytes);
+  system->resident_bytes += bytes;
+  request->resident_bytes = bytes;
+}
+
 vkr_internal void vkr_resource_system_request_release_locked(
     VkrResourceSystem *system, int32_t request_index,
     uint32_t *out_async_loader_id, void **out_async_payload) {
@@ -596,6 +670,9 @@ vkr_internal void vkr_resource_system_request_release_locked(
     *out_async_payload = NULL;
   }
 
+  vkr_resource_system_cpu_job_done_locked(system, request);
+  vkr_resource_system_set_resident_locked(system, request, 0);
+
   if (request->key) {
     vkr_hash_table_remove_uint32_t(&system->request_by_key, request->key);
     uint64_t key_len = string_length(request->key);
@@ -645,7 +722,8 @@ vkr_internal void vkr_resource_system_fill_info_from_request(
  * @brief Try to enqueue the CPU prepare job for a pending async request.
  *
  * Must be called with `system->mutex` held. This helper is non-blocking and
- * leaves the request in `PENDING_CPU` when the job system is saturated.
+ * leaves the request in `PENDING_CPU` when the job system is saturated or the
+ * in-flight cap is reached.
  */
 vkr_internal bool8_t vkr_resource_system_try_submit_cpu_job_locked(
     VkrResourceSystem *system, VkrResourceAsyncRequest *request) {
@@ -657,6 +735,10 @@ vkr_internal bool8_t vkr_resource_system_try_submit_cpu_job_locked(
       request->load_state != VKR_RESOURCE_LOAD_STATE_PENDING_CPU) {
     return false_v;
   }
+  if (system->streaming.max_cpu_jobs_in_flight > 0 &&
+      system->cpu_jobs_in_flight >= system->streaming.max_cpu_jobs_in_flight) {
+    return false_v;
+  }
 
   VkrResourceAsyncJobPayload payload = {
       .system = system,
@@ -695,6 +777,7 @@ vkr_internal bool8_t vkr_resource_system_try_submit_cpu_job_locked(
   }
 
   request->cpu_job_in_flight = true_v;
+  system->cpu_jobs_in_flight++;
   return true_v;
 }
 
@@ -736,6 +819,24 @@ vkr_internal bool8_t vkr_resource_system_completion_dequeue_locked(
   return true_v;
 }
 
+/**
+ * @brief True when a queued job's request was canceled or released before the
+ * job started, so its prepare work can be skipped.
+ */
+vkr_internal bool8_t
+vkr_resource_system_async_job_abandoned(VkrResourceSystem *system,
+                                        uint64_t request_id) {
+  if (!vkr_mutex_lock(system->mutex)) {
+    return false_v;
+  }
+  int32_t request_index =
+      vkr_resource_system_request_find_by_id_locked(system, request_id);
+  bool8_t abandoned = request_index < 0 ||
+                      system->requests[request_index].cancel_requested;
+  vkr_mutex_unlock(system->mutex);
+  return abandoned;
+}
+
 vkr_internal bool8_t vkr_resource_system_async_load_job_run(VkrJobContext *ctx,
                                                             void *payload) {
   assert_log(payload != NULL, "Payload is NULL");
@@ -771,12 +872,24 @@ vkr_internal bool8_t vkr_resource_system_async_load_job_run(VkrJobContext *ctx,
   completion.loader_id = loader ? loader->id : VKR_INVALID_ID;
   completion.load_error = VKR_RENDERER_ERROR_RESOURCE_NOT_LOADED;
 
-  if (loader && loader->prepare_async && loader->finalize_async) {
+  const bool8_t prepares_async =
+      loader && loader->prepare_async && loader->finalize_async;
+  if (prepares_async &&
+      vkr_resource_system_async_job_abandoned(system, job->request_id)) {
+    /*
+     * Canceled while queued: post an empty completion so the pump retires the
+     * request without paying for the decode.
+     */
+    completion.load_error = VKR_RENDERER_ERROR_NONE;
+  } else if (prepares_async) {
     void *async_payload = NULL;
     VkrRendererError prepare_error = VKR_RENDERER_ERROR_NONE;
-    if (loader->prepare_async(loader, path, temp_alloc, &async_payload,
-                              &prepare_error) &&
-        async_payload) {
+    const uint64_t previous_parent = g_resource_system_parent_request_id;
+    g_resource_system_parent_request_id = job->request_id;
+    const bool8_t prepared = loader->prepare_async(
+        loader, path, temp_alloc, &async_payload, &prepare_error);
+    g_resource_system_parent_request_id = previous_parent;
+    if (prepared && async_payload) {
       completion.has_async_payload = true_v;
       completion.async_payload = async_payload;
       completion.load_error = VKR_RENDERER_ERROR_NONE;
@@ -853,6 +966,7 @@ vkr_internal bool8_t vkr_resource_system_async_load_job_run(VkrJobContext *ctx,
     if (request_index >= 0) {
       VkrResourceAsyncRequest *request = &system->requests[request_index];
       if (request->in_use) {
+        vkr_resource_system_cpu_job_done_locked(system, request);
         request->load_state = VKR_RESOURCE_LOAD_STATE_FAILED;
         request->last_error = VKR_RENDERER_ERROR_OUT_OF_MEMORY;
         vkr_resource_system_record_request_load(system, request,
@@ -886,6 +1000,12 @@ vkr_internal void vkr_resource_system_init_cleanup(VkrResourceSystem *sys) {
     return;
   }
   VkrAllocator *a = sys->allocator;
+  if (sys->pump_order) {
+    vkr_allocator_free(a, sys->pump_order,
+                       sizeof(VkrResourcePumpEntry) * sys->pump_order_capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+    sys->pump_order = NULL;
+  }
   if (sys->completions) {
     vkr_allocator_free(a, sys->completions,
                        sizeof(VkrResourceAsyncCompletion) *
@@ -1219,6 +1339,19 @@ bool8_t vkr_resource_system_load(VkrResourceType type, String8 path,
   request->async_payload = NULL;
   request->metrics_start_ns = metrics_start_ns;
   request->metrics_bytes = vkr_resource_system_metric_source_bytes(path);
+  request->screen_coverage = 1.0f;
+  request->camera_distance = 0.0f;
+  request->last_hint_pump = vkr_resource_system->pump_index;
+  request->parent_request_id = g_resource_system_parent_request_id;
+  if (request->parent_request_id != 0) {
+    const int32_t parent_index = vkr_resource_system_request_find_by_id_locked(
+        vkr_resource_system, request->parent_request_id);
+    if (parent_index >= 0) {
+      request->parent_index = (uint32_t)parent_index;
+    } else {
+      request->parent_request_id = 0;
+    }
+  }
   vkr_resource_system_reset_handle_info(&request->loaded_info);
 
   if (!vkr_hash_table_insert_uint32_t(&vkr_resource_system->request_by_key,
@@ -1364,6 +1497,14 @@ void vkr_resource_system_unload(const VkrResourceHandleInfo *info,
     vkr_mutex_unlock(vkr_resource_system->mutex);
     return;
   case VKR_RESOURCE_LOAD_STATE_READY:
+    if (request->streamed &&
+        vkr_resource_system->streaming.max_resident_bytes > 0 &&
+        !vkr_resource_system_loader_uncached(vkr_resource_system,
+                                             request->loader_id)) {
+      // Cached for the next load of the key until the pump evicts it.
+      vkr_mutex_unlock(vkr_resource_system->mutex);
+      return;
+    }
     ready_info = request->loaded_info;
     unload_ready_resource = true_v;
 
@@ -1734,6 +1875,235 @@ vkr_internal void vkr_resource_system_estimate_finalize_cost(
   }
 }
 
+vkr_internal float64_t vkr_resource_system_finalize_cost_units(
+    const VkrResourceAsyncFinalizeCost *cost) {
+  const float64_t units =
+      (float64_t)cost->gpu_upload_ops +
+      (float64_t)cost->gpu_upload_bytes /
+          (float64_t)VKR_RESOURCE_FINALIZE_BYTES_PER_UNIT;
+  return Max(units, 1.0);
+}
+
+/**
+ * @brief Predicts whether one more finalize fits the pump's time budget.
+ *
+ * Until the first finalize has been measured the prediction is zero, so only
+ * the op/byte limits apply.
+ */
+vkr_internal bool8_t vkr_resource_system_finalize_fits_time(
+    const VkrResourceSystem *system, const VkrResourceAsyncFinalizeCost *cost,
+    uint32_t finalized_count, uint64_t used_ns,
+    const VkrResourceAsyncBudget *budget) {
+  if (budget->max_finalize_ns == 0 || finalized_count == 0) {
+    return true_v;
+  }
+  const float64_t predicted_ns = system->finalize_ns_per_unit *
+                                 vkr_resource_system_finalize_cost_units(cost);
+  return (float64_t)used_ns + predicted_ns <=
+         (float64_t)budget->max_finalize_ns;
+}
+
+vkr_internal void vkr_resource_system_finalize_record_time(
+    VkrResourceSystem *system, const VkrResourceAsyncFinalizeCost *cost,
+    uint64_t elapsed_ns) {
+  const float64_t sample =
+      (float64_t)elapsed_ns / vkr_resource_system_finalize_cost_units(cost);
+  if (system->finalize_ns_per_unit <= 0.0) {
+    system->finalize_ns_per_unit = sample;
+    return;
+  }
+  system->finalize_ns_per_unit +=
+      (sample - system->finalize_ns_per_unit) *
+      VKR_RESOURCE_FINALIZE_AVERAGE_WEIGHT;
+}
+
+vkr_internal uint64_t vkr_resource_system_now_ns(void) {
+  return (uint64_t)(vkr_platform_get_absolute_time() * 1000000000.0);
+}
+
+/** Higher coverage first, then nearer, then older requests. */
+vkr_internal int32_t vkr_resource_system_pump_entry_compare(const void *lhs,
+                                                           const void *rhs) {
+  const VkrResourcePumpEntry *a = lhs;
+  const VkrResourcePumpEntry *b = rhs;
+  if (a->screen_coverage != b->screen_coverage) {
+    return a->screen_coverage > b->screen_coverage ? -1 : 1;
+  }
+  if (a->camera_distance != b->camera_distance) {
+    return a->camera_distance < b->camera_distance ? -1 : 1;
+  }
+  return (a->request_id > b->request_id) - (a->request_id < b->request_id);
+}
+
+/**
+ * @brief Copies the hint of the nearest hinted ancestor onto a dependency load
+ * that was never hinted itself.
+ *
+ * The textures a streamed mesh pulls in through its materials are then served
+ * and cached like the mesh. Stops at the first ancestor that has been retired.
+ */
+vkr_internal void
+vkr_resource_system_inherit_hint_locked(VkrResourceSystem *system,
+                                        VkrResourceAsyncRequest *request) {
+  uint64_t parent_id = request->parent_request_id;
+  uint32_t parent_index = request->parent_index;
+  for (uint32_t depth = 0;
+       parent_id != 0 && depth < VKR_RESOURCE_HINT_INHERIT_DEPTH; ++depth) {
+    if (parent_index >= system->request_capacity) {
+      return;
+    }
+    const VkrResourceAsyncRequest *parent = &system->requests[parent_index];
+    if (!parent->in_use || parent->request_id != parent_id) {
+      return;
+    }
+    if (parent->streamed) {
+      request->screen_coverage = parent->screen_coverage;
+      request->camera_distance = parent->camera_distance;
+      request->streamed = true_v;
+      request->last_hint_pump = parent->last_hint_pump;
+      return;
+    }
+    parent_id = parent->parent_request_id;
+    parent_index = parent->parent_index;
+  }
+}
+
+/**
+ * @brief Snapshots the pending requests in the order this pump serves them.
+ *
+ * Finalize callbacks run unlocked and may grow the request table, so the pump
+ * walks this snapshot by slot index and request id rather than by pointer.
+ */
+vkr_internal uint32_t
+vkr_resource_system_build_pump_order_locked(VkrResourceSystem *system) {
+  if (system->pump_order_capacity < system->request_capacity) {
+    VkrResourcePumpEntry *order = vkr_allocator_alloc(
+        system->allocator,
+        sizeof(VkrResourcePumpEntry) * system->request_capacity,
+        VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+    if (!order) {
+      return 0;
+    }
+    if (system->pump_order) {
+      vkr_allocator_free(system->allocator, system->pump_order,
+                         sizeof(VkrResourcePumpEntry) *
+                             system->pump_order_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+    }
+    system->pump_order = order;
+    system->pump_order_capacity = system->request_capacity;
+  }
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < system->request_capacity; ++i) {
+    VkrResourceAsyncRequest *request = &system->requests[i];
+    if (!request->in_use) {
+      continue;
+    }
+    switch (request->load_state) {
+    case VKR_RESOURCE_LOAD_STATE_PENDING_CPU:
+    case VKR_RESOURCE_LOAD_STATE_PENDING_DEPENDENCIES:
+    case VKR_RESOURCE_LOAD_STATE_PENDING_GPU:
+    case VKR_RESOURCE_LOAD_STATE_CANCELED:
+      break;
+    default:
+      continue;
+    }
+    if (request->parent_request_id != 0) {
+      vkr_resource_system_inherit_hint_locked(system, request);
+    }
+    system->pump_order[count++] = (VkrResourcePumpEntry){
+        .screen_coverage = request->screen_coverage,
+        .camera_distance = request->camera_distance,
+        .request_id = request->request_id,
+        .index = i,
+    };
+  }
+  vkr_sort(system->pump_order, count, sizeof(VkrResourcePumpEntry),
+           vkr_resource_system_pump_entry_compare);
+  return count;
+}
+
+/**
+ * @brief Picks the unreferenced streamed READY request hinted least recently,
+ * skipping any hinted since the previous pump when `skip_recent` is set.
+ * Returns -1 when nothing can be evicted.
+ */
+vkr_internal int32_t
+vkr_resource_system_find_eviction_victim_locked(VkrResourceSystem *system,
+                                                bool8_t skip_recent) {
+  int32_t victim = -1;
+  for (uint32_t i = 0; i < system->request_capacity; ++i) {
+    const VkrResourceAsyncRequest *request = &system->requests[i];
+    if (!request->in_use || !request->streamed || request->ref_count > 0 ||
+        request->load_state != VKR_RESOURCE_LOAD_STATE_READY ||
+        (skip_recent && request->last_hint_pump >= system->pump_index)) {
+      continue;
+    }
+    if (victim < 0) {
+      victim = (int32_t)i;
+      continue;
+    }
+    const VkrResourceAsyncRequest *best = &system->requests[victim];
+    if (request->last_hint_pump < best->last_hint_pump ||
+        (request->last_hint_pump == best->last_hint_pump &&
+         request->screen_coverage < best->screen_coverage)) {
+      victim = (int32_t)i;
+    }
+  }
+  return victim;
+}
+
+/**
+ * @brief Unloads cached streamed resources, least recently hinted first,
+ * until the resident total fits `max_resident_bytes`.
+ *
+ * Only requests nobody holds are candidates, so no caller is left with a
+ * handle to an unloaded resource; referenced ones stay resident even over
+ * budget. With the budget at zero every cached request is released. Returns
+ * false if the mutex could not be re-acquired.
+ */
+vkr_internal bool8_t
+vkr_resource_system_evict_locked(VkrResourceSystem *system) {
+  const uint64_t limit = system->streaming.max_resident_bytes;
+  while (limit == 0 || system->resident_bytes > limit) {
+    int32_t victim =
+        vkr_resource_system_find_eviction_victim_locked(system, limit > 0);
+    if (victim < 0) {
+      break;
+    }
+    VkrResourceAsyncRequest *request = &system->requests[victim];
+    VkrResourceHandleInfo unload_info = request->loaded_info;
+    char *name_cstr = NULL;
+    String8 name = {0};
+    if (!vkr_resource_system_allocate_string8_copy(system, request->path,
+                                                   &name_cstr, &name)) {
+      break;
+    }
+
+    uint32_t release_loader_id = VKR_INVALID_ID;
+    void *release_payload = NULL;
+    vkr_resource_system_request_release_locked(system, victim,
+                                               &release_loader_id,
+                                               &release_payload);
+
+    vkr_mutex_unlock(system->mutex);
+    if (release_payload) {
+      vkr_resource_system_release_async_payload(release_loader_id,
+                                                release_payload);
+    }
+    vkr_resource_system_unload_sync_internal(&unload_info, name);
+    if (!vkr_mutex_lock(system->mutex)) {
+      vkr_allocator_free(system->allocator, name_cstr, name.length + 1,
+                         VKR_ALLOCATOR_MEMORY_TAG_STRING);
+      return false_v;
+    }
+    vkr_allocator_free(system->allocator, name_cstr, name.length + 1,
+                       VKR_ALLOCATOR_MEMORY_TAG_STRING);
+  }
+  return true_v;
+}
+
 void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
   if (!vkr_resource_system) {
     return;
@@ -1759,6 +2129,8 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
   uint32_t finalize_budget = effective_budget->max_finalize_requests;
   uint32_t used_gpu_upload_ops = 0;
   uint64_t used_gpu_upload_bytes = 0;
+  uint32_t finalized_count = 0;
+  uint64_t used_finalize_ns = 0;
   while (finalize_budget > 0) {
     VkrResourceAsyncCompletion completion = {0};
     if (!vkr_resource_system_completion_dequeue_locked(vkr_resource_system,
@@ -1785,7 +2157,7 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
     } else {
       VkrResourceAsyncRequest *request =
           &vkr_resource_system->requests[request_index];
-      request->cpu_job_in_flight = false_v;
+      vkr_resource_system_cpu_job_done_locked(vkr_resource_system, request);
       if (!request->in_use) {
         unload_loaded_resource = completion.loaded;
         unload_info = completion.loaded_info;
@@ -1816,6 +2188,20 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
           release_async_loader_id = detached_loader_id;
           release_async_ptr = detached_payload;
         }
+      } else if (request->cancel_requested) {
+        // Canceled while still referenced: discard the work, keep the slot
+        // until the last holder unloads it.
+        unload_loaded_resource = completion.loaded;
+        unload_info = completion.loaded_info;
+        if (completion.has_async_payload) {
+          release_async_payload = true_v;
+          release_async_loader_id = completion.loader_id;
+          release_async_ptr = completion.async_payload;
+        }
+        request->load_state = VKR_RESOURCE_LOAD_STATE_CANCELED;
+        request->last_error = VKR_RENDERER_ERROR_NONE;
+        vkr_resource_system_record_request_load(vkr_resource_system, request,
+                                                VKR_METRIC_EVENT_STATUS_FAILED);
       } else if (completion.has_async_payload) {
         request->loader_id = completion.loader_id;
         request->async_payload = completion.async_payload;
@@ -1866,10 +2252,14 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
     finalize_budget--;
   }
 
-  for (uint32_t i = 0;
-       i < vkr_resource_system->request_capacity && finalize_budget > 0; ++i) {
+  const uint32_t order_count =
+      vkr_resource_system_build_pump_order_locked(vkr_resource_system);
+  for (uint32_t order = 0; order < order_count && finalize_budget > 0;
+       ++order) {
+    const VkrResourcePumpEntry entry = vkr_resource_system->pump_order[order];
+    const uint32_t i = entry.index;
     VkrResourceAsyncRequest *request = &vkr_resource_system->requests[i];
-    if (!request->in_use) {
+    if (!request->in_use || request->request_id != entry.request_id) {
       continue;
     }
 
@@ -1985,7 +2375,10 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
         }
         if (!vkr_resource_system_gpu_cost_fits_budget(
                 &finalize_cost, used_gpu_upload_ops, used_gpu_upload_bytes,
-                effective_budget)) {
+                effective_budget) ||
+            !vkr_resource_system_finalize_fits_time(
+                vkr_resource_system, &finalize_cost, finalized_count,
+                used_finalize_ns, effective_budget)) {
           continue;
         }
 
@@ -2000,12 +2393,24 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
          * mutex to avoid re-entrant mutex deadlocks on the render thread.
          */
         vkr_mutex_unlock(vkr_resource_system->mutex);
+        const uint64_t previous_parent = g_resource_system_parent_request_id;
+        g_resource_system_parent_request_id = finalize_request_id;
+        const uint64_t finalize_start_ns = vkr_resource_system_now_ns();
         bool8_t finalized =
             loader->finalize_async(loader, finalize_path, payload_ptr,
                                    &finalized_info, &finalize_error);
+        const uint64_t finalize_end_ns = vkr_resource_system_now_ns();
+        g_resource_system_parent_request_id = previous_parent;
         if (!vkr_mutex_lock(vkr_resource_system->mutex)) {
           return;
         }
+        const uint64_t finalize_ns = finalize_end_ns > finalize_start_ns
+                                         ? finalize_end_ns - finalize_start_ns
+                                         : 0;
+        used_finalize_ns += finalize_ns;
+        finalized_count++;
+        vkr_resource_system_finalize_record_time(vkr_resource_system,
+                                                 &finalize_cost, finalize_ns);
 
         int32_t refreshed_index = vkr_resource_system_request_find_by_id_locked(
             vkr_resource_system, finalize_request_id);
@@ -2065,6 +2470,8 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
         finalized_info.last_error = VKR_RENDERER_ERROR_NONE;
         finalized_info.request_id = request->request_id;
         request->loaded_info = finalized_info;
+        vkr_resource_system_set_resident_locked(
+            vkr_resource_system, request, finalize_cost.gpu_upload_bytes);
         vkr_resource_system_gpu_cost_consume(
             &finalize_cost, &used_gpu_upload_ops, &used_gpu_upload_bytes,
             effective_budget);
@@ -2095,6 +2502,10 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget) {
     }
   }
 
+  if (!vkr_resource_system_evict_locked(vkr_resource_system)) {
+    return;
+  }
+  vkr_resource_system->pump_index++;
   vkr_mutex_unlock(vkr_resource_system->mutex);
 }
 
@@ -2124,3 +2535,60 @@ void vkr_resource_system_cancel(const VkrResourceHandleInfo *info) {
 
   vkr_mutex_unlock(vkr_resource_system->mutex);
 }
+
+void vkr_resource_system_update_streaming(
+    const VkrResourceHandleInfo *info, const VkrResourceStreamingHint *hint) {
+  if (!vkr_resource_system || !info || !hint || info->request_id == 0) {
+    return;
+  }
+
+  if (!vkr_mutex_lock(vkr_resource_system->mutex)) {
+    return;
+  }
+
+  int32_t request_index = vkr_resource_system_request_find_by_id_locked(
+      vkr_resource_system, info->request_id);
+  if (request_index >= 0) {
+    VkrResourceAsyncRequest *request =
+        &vkr_resource_system->requests[request_index];
+    if (request->in_use && !request->cancel_requested) {
+      request->screen_coverage = Clamp(hint->screen_coverage, 0.0f, 1.0f);
+      request->camera_distance = Max(hint->camera_distance, 0.0f);
+      request->streamed = true_v;
+      request->last_hint_pump = vkr_resource_system->pump_index;
+      // A direct hint outranks whatever the issuing load would pass down.
+      request->parent_request_id = 0;
+    }
+  }
+
+  vkr_mutex_unlock(vkr_resource_system->mutex);
+}
+
+void vkr_resource_system_set_streaming_config(
+    const VkrResourceStreamingConfig *config) {
+  if (!vkr_resource_system || !config) {
+    return;
+  }
+
+  if (!vkr_mutex_lock(vkr_resource_system->mutex)) {
+    return;
+  }
+  vkr_resource_system->streaming = *config;
+  if (!vkr_resource_system_evict_locked(vkr_resource_system)) {
+    return;
+  }
+  vkr_mutex_unlock(vkr_resource_system->mutex);
+}
+
+uint64_t vkr_resource_system_get_resident_bytes(void) {
+  if (!vkr_resource_system) {
+    return 0;
+  }
+
+  if (!vkr_mutex_lock(vkr_resource_system->mutex)) {
+    return 0;
+  }
+  const uint64_t bytes = vkr_resource_system->resident_bytes;
+  vkr_mutex_unlock(vkr_resource_system->mutex);
+  return bytes;
+}
@@ -45,12 +45,53 @@ typedef struct VkrResourceHandleInfo {
   } as;
 } VkrResourceHandleInfo;
 
+/**
+ * @brief Per-pump limits on async finalize work.
+ *
+ * `max_finalize_ns` bounds the wall time spent in `finalize_async` callbacks
+ * in one pump. The pump predicts each finalize from its
+ * `estimate_async_finalize_cost` using a running ns-per-cost average, so the
+ * number of finalizes per frame adapts to how expensive uploads actually are.
+ * The first finalize of a pump always runs; 0 disables the time limit.
+ */
 typedef struct VkrResourceAsyncBudget {
   uint32_t max_finalize_requests;
   uint32_t max_gpu_upload_ops;
   uint64_t max_gpu_upload_bytes;
+  uint64_t max_finalize_ns;
 } VkrResourceAsyncBudget;
 
+/**
+ * @brief View-dependent importance of a streamed request.
+ *
+ * `screen_coverage` is the fraction of the viewport the asset's bounds project
+ * to (0..1) and orders requests first; `camera_distance` breaks ties, nearer
+ * first. Requests that never receive a hint rank as full-screen at distance 0
+ * so non-streamed loads are not starved by streamed ones, unless they were
+ * issued by a hinted load's prepare or finalize step, in which case they take
+ * that load's hint.
+ */
+typedef struct VkrResourceStreamingHint {
+  float32_t screen_coverage;
+  float32_t camera_distance;
+} VkrResourceStreamingHint;
+
+/**
+ * @brief Scheduler limits shared by every async request.
+ *
+ * `max_cpu_jobs_in_flight` caps prepare jobs handed to the job system; the
+ * rest wait in the request table where they are still submitted in priority
+ * order and can be canceled without running. With `max_resident_bytes` set, a
+ * hinted resource whose last holder unloads it stays cached for the next load
+ * of its key, and the pump unloads cached ones, least recently hinted first,
+ * while READY resources exceed the budget in estimated upload bytes. Resources
+ * that still have holders are never unloaded. Zero disables either limit.
+ */
+typedef struct VkrResourceStreamingConfig {
+  uint32_t max_cpu_jobs_in_flight;
+  uint64_t max_resident_bytes;
+} VkrResourceStreamingConfig;
+
 /**
  * @brief Estimated GPU work consumed by one async finalize step.
  *
@@ -76,6 +117,13 @@ struct VkrResourceLoader {
   void *resource_system; // opaque pointer to loader-specific resource system
                          // implementation
 
+  /*
+   * Set when a READY result pins memory later loads of this loader wait on;
+   * such results are unloaded with their last holder instead of being cached
+   * under `VkrResourceStreamingConfig.max_resident_bytes`.
+   */
+  bool8_t streaming_uncached;
+
   /**
    * @brief Callback to check if the loader can load the resource
    * @param self The loader
@@ -352,6 +400,34 @@ void vkr_resource_system_pump(const VkrResourceAsyncBudget *budget);
  */
 void vkr_resource_system_cancel(const VkrResourceHandleInfo *info);
 
+/**
+ * @brief Updates the priority and recency of a tracked async request.
+ *
+ * Call once per frame for each streamed asset in view. A hinted request, and
+ * any dependency it loads, is cached after its last unload while
+ * `max_resident_bytes` is set. Untracked handles are ignored.
+ * @param info The info of the resource to reprioritize
+ * @param hint The view-dependent importance of the resource
+ */
+void vkr_resource_system_update_streaming(const VkrResourceHandleInfo *info,
+                                          const VkrResourceStreamingHint *hint);
+
+/**
+ * @brief Replaces the streaming scheduler limits.
+ *
+ * Lowering `max_resident_bytes` evicts cached resources right away; setting
+ * it to zero releases all of them.
+ * @param config The new limits
+ */
+void vkr_resource_system_set_streaming_config(
+    const VkrResourceStreamingConfig *config);
+
+/**
+ * @brief Returns the estimated bytes held by READY async requests.
+ * @return The resident byte total
+ */
+uint64_t vkr_resource_system_get_resident_bytes(void);
+
 // =============================================================================
 // Getters
 // =============================================================================
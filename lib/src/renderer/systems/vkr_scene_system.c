@@ -1199,6 +1199,7 @@ void vkr_scene_shutdown(VkrScene *scene, struct s_RendererFrontend *rf) {
       scene_reset_reflection_probe_runtime(probe);
     }
     scene->reflection_probe_count = 0;
+    scene->reflection_probe_version++;
     scene->environment.bake_state = VKR_SCENE_ENV_BAKE_STATE_NONE;
     scene->environment.enabled = false_v;
 
@@ -2371,6 +2372,99 @@ VkrEntityId vkr_scene_handle_entity_from_picking_id(VkrSceneHandle handle,
                                                     object_id);
 }
 
+vkr_internal VkrEntityId
+scene_render_bridge_entity_from_render_id(const VkrSceneRenderBridge *bridge,
+                                          uint32_t render_id) {
+  if (render_id >= bridge->render_id_capacity)
+    return VKR_ENTITY_ID_INVALID;
+  return bridge->render_id_to_entity[render_id];
+}
+
+vkr_internal bool8_t scene_query_owns_item(const VkrMeshQueryItem *item,
+                                           void *user_data) {
+  const VkrSceneRenderBridge *bridge = (const VkrSceneRenderBridge *)user_data;
+  return scene_render_bridge_entity_from_render_id(bridge, item->render_id)
+             .u64 != VKR_ENTITY_ID_INVALID.u64;
+}
+
+bool8_t vkr_scene_handle_raycast(VkrSceneHandle handle,
+                                 struct s_RendererFrontend *rf, Vec3 origin,
+                                 Vec3 direction, float32_t max_distance,
+                                 VkrSceneRayHit *out_hit) {
+  if (!handle || !rf || !out_hit)
+    return false_v;
+  struct VkrSceneRuntime *runtime = (struct VkrSceneRuntime *)handle;
+
+  VkrMeshRayHit hit = {0};
+  if (!vkr_mesh_manager_raycast(&rf->mesh_manager, origin, direction,
+                                max_distance, scene_query_owns_item,
+                                &runtime->bridge, &hit)) {
+    return false_v;
+  }
+
+  out_hit->entity = scene_render_bridge_entity_from_render_id(
+      &runtime->bridge, hit.item.render_id);
+  out_hit->distance = hit.distance;
+  out_hit->position = hit.position;
+  return true_v;
+}
+
+typedef struct SceneEntityQueryContext {
+  const VkrSceneRenderBridge *bridge;
+  VkrEntityId *out_entities;
+  uint32_t max_entities;
+  uint32_t count;
+} SceneEntityQueryContext;
+
+vkr_internal bool8_t scene_collect_query_item(const VkrMeshQueryItem *item,
+                                              void *user_data) {
+  SceneEntityQueryContext *context = (SceneEntityQueryContext *)user_data;
+  const VkrEntityId entity = scene_render_bridge_entity_from_render_id(
+      context->bridge, item->render_id);
+  if (entity.u64 == VKR_ENTITY_ID_INVALID.u64)
+    return true_v;
+  context->out_entities[context->count++] = entity;
+  return context->count < context->max_entities;
+}
+
+uint32_t vkr_scene_handle_query_sphere(VkrSceneHandle handle,
+                                       struct s_RendererFrontend *rf,
+                                       Vec3 center, float32_t radius,
+                                       VkrEntityId *out_entities,
+                                       uint32_t max_entities) {
+  if (!handle || !rf || !out_entities || max_entities == 0)
+    return 0;
+  struct VkrSceneRuntime *runtime = (struct VkrSceneRuntime *)handle;
+
+  SceneEntityQueryContext context = {
+      .bridge = &runtime->bridge,
+      .out_entities = out_entities,
+      .max_entities = max_entities,
+  };
+  vkr_mesh_manager_query_sphere(&rf->mesh_manager, center, radius,
+                                scene_collect_query_item, &context);
+  return context.count;
+}
+
+uint32_t vkr_scene_handle_query_frustum(VkrSceneHandle handle,
+                                        struct s_RendererFrontend *rf,
+                                        const VkrFrustum *frustum,
+                                        VkrEntityId *out_entities,
+                                        uint32_t max_entities) {
+  if (!handle || !rf || !frustum || !out_entities || max_entities == 0)
+    return 0;
+  struct VkrSceneRuntime *runtime = (struct VkrSceneRuntime *)handle;
+
+  SceneEntityQueryContext context = {
+      .bridge = &runtime->bridge,
+      .out_entities = out_entities,
+      .max_entities = max_entities,
+  };
+  vkr_mesh_manager_query_frustum(&rf->mesh_manager, frustum,
+                                 scene_collect_query_item, &context);
+  return context.count;
+}
+
 // ============================================================================
 // Text3D Implementation
 // ============================================================================
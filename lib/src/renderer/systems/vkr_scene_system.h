@@ -16,6 +16,7 @@
 #include "core/vkr_entity.h"
 #include "math/mat.h"
 #include "math/vec.h"
+#include "math/vkr_frustum.h"
 #include "math/vkr_quat.h"
 #include "memory/vkr_allocator.h"
 #include "renderer/resources/vkr_resources.h"
@@ -363,6 +364,8 @@ typedef struct VkrScene {
   VkrSceneEnvironment environment; // Scene environment and bake state
   VkrSceneReflectionProbe reflection_probes[VKR_SCENE_REFLECTION_PROBE_MAX];
   uint32_t reflection_probe_count;
+  // Bumped when probes are added or reset or change bake state
+  uint64_t reflection_probe_version;
 } VkrScene;
 
 // ============================================================================
@@ -480,6 +483,54 @@ void vkr_scene_handle_update_and_sync(VkrSceneHandle handle,
 VkrEntityId vkr_scene_handle_entity_from_picking_id(VkrSceneHandle handle,
                                                     uint32_t object_id);
 
+/**
+ * @brief Closest scene entity hit by a world-space ray.
+ */
+typedef struct VkrSceneRayHit {
+  VkrEntityId entity;
+  float32_t distance; /**< World distance along the normalized direction. */
+  Vec3 position;
+} VkrSceneRayHit;
+
+/**
+ * @brief CPU ray pick against this scene's visible meshes.
+ *
+ * Uses the mesh manager's bounds BVH and per-asset triangle BVHs, so it needs
+ * no GPU readback and can run every frame (hover, placement, gameplay). Sees
+ * the state of the last sync.
+ * @param handle Scene handle.
+ * @param rf Renderer frontend owning the mesh manager.
+ * @param origin Ray origin in world space.
+ * @param direction Ray direction; need not be normalized.
+ * @param max_distance Hits at or beyond this distance are ignored.
+ * @param out_hit Receives the closest hit.
+ * @return True when an entity was hit.
+ */
+bool8_t vkr_scene_handle_raycast(VkrSceneHandle handle,
+                                 struct s_RendererFrontend *rf, Vec3 origin,
+                                 Vec3 direction, float32_t max_distance,
+                                 VkrSceneRayHit *out_hit);
+
+/**
+ * @brief Collects visible entities whose bounds overlap a world sphere.
+ * @return Number of entities written to `out_entities` (at most `max_entities`).
+ */
+uint32_t vkr_scene_handle_query_sphere(VkrSceneHandle handle,
+                                       struct s_RendererFrontend *rf,
+                                       Vec3 center, float32_t radius,
+                                       VkrEntityId *out_entities,
+                                       uint32_t max_entities);
+
+/**
+ * @brief Collects visible entities whose bounds intersect a frustum.
+ * @return Number of entities written to `out_entities` (at most `max_entities`).
+ */
+uint32_t vkr_scene_handle_query_frustum(VkrSceneHandle handle,
+                                        struct s_RendererFrontend *rf,
+                                        const VkrFrustum *frustum,
+                                        VkrEntityId *out_entities,
+                                        uint32_t max_entities);
+
 // ============================================================================
 // Entity Management
 // ============================================================================
@@ -345,6 +345,77 @@ bool8_t vkr_shadow_fit_relevant_caster_z(
   return true_v;
 }
 
+void vkr_shadow_cascade_caster_planes(const Mat4 *light_view, float32_t left,
+                                      float32_t right, float32_t bottom,
+                                      float32_t top, float32_t min_z,
+                                      VkrPlane out_planes[5]) {
+  // Light-space x = dot(row0.xyz, p) + row0.w, and likewise for y and z. The
+  // light view is rigid, so the rows are already unit-length normals.
+  const Vec4 row_x = mat4_row(*light_view, 0);
+  const Vec4 row_y = mat4_row(*light_view, 1);
+  const Vec4 row_z = mat4_row(*light_view, 2);
+  const Vec3 axis_x = vec3_new(row_x.x, row_x.y, row_x.z);
+  const Vec3 axis_y = vec3_new(row_y.x, row_y.y, row_y.z);
+  const Vec3 axis_z = vec3_new(row_z.x, row_z.y, row_z.z);
+
+  out_planes[0] = (VkrPlane){.normal = axis_x, .d = row_x.w - left};
+  out_planes[1] = (VkrPlane){.normal = vec3_negate(axis_x),
+                             .d = right - row_x.w};
+  out_planes[2] = (VkrPlane){.normal = axis_y, .d = row_y.w - bottom};
+  out_planes[3] = (VkrPlane){.normal = vec3_negate(axis_y),
+                             .d = top - row_y.w};
+  out_planes[4] = (VkrPlane){.normal = axis_z, .d = row_z.w - min_z};
+}
+
+typedef struct VkrShadowCasterZFit {
+  const VkrMeshBoundsIndex *index;
+  Vec4 row_z;
+  bool8_t found;
+  float32_t min_z;
+  float32_t max_z;
+} VkrShadowCasterZFit;
+
+vkr_internal bool8_t vkr_shadow_fit_caster_visit(uint32_t key,
+                                                 void *user_data) {
+  VkrShadowCasterZFit *fit = (VkrShadowCasterZFit *)user_data;
+  const Vec4 sphere = fit->index->spheres[key];
+  const float32_t z = fit->row_z.x * sphere.x + fit->row_z.y * sphere.y +
+                      fit->row_z.z * sphere.z + fit->row_z.w;
+  vkr_shadow_include_z(z - sphere.w, &fit->found, &fit->min_z, &fit->max_z);
+  vkr_shadow_include_z(z + sphere.w, &fit->found, &fit->min_z, &fit->max_z);
+  return true_v;
+}
+
+bool8_t vkr_shadow_fit_indexed_caster_z(const Mat4 *light_view,
+                                        VkrMeshBoundsIndex *caster_index,
+                                        float32_t left, float32_t right,
+                                        float32_t bottom, float32_t top,
+                                        float32_t *out_min_z,
+                                        float32_t *out_max_z) {
+  if (!light_view || !caster_index || !out_min_z || !out_max_z ||
+      left > right || bottom > top) {
+    return false_v;
+  }
+
+  VkrPlane planes[5];
+  vkr_shadow_cascade_caster_planes(light_view, left, right, bottom, top, 0.0f,
+                                   planes);
+  VkrShadowCasterZFit fit = {
+      .index = caster_index,
+      .row_z = mat4_row(*light_view, 2),
+  };
+  // Only the four side planes: the fitted interval is what decides where the
+  // far plane goes, so it cannot be bounded by one yet.
+  vkr_mesh_bounds_index_query_planes(caster_index, planes, 4u,
+                                     vkr_shadow_fit_caster_visit, &fit);
+  if (!fit.found) {
+    return false_v;
+  }
+  *out_min_z = fit.min_z;
+  *out_max_z = fit.max_z;
+  return true_v;
+}
+
 float32_t vkr_shadow_quantize_extent_up(float32_t extent,
                                         uint32_t shadow_map_size) {
   // The quantum has to be independent of the extent, or quantization is a
@@ -420,7 +491,8 @@ vkr_internal void vkr_shadow_compute_cascade_matrix(
     const Mat4 *light_view, const Vec3 frustum_corners[8],
     uint32_t shadow_map_size, bool8_t stabilize, float32_t guard_band_texels,
     bool8_t use_constant_cascade_size, const VkrShadowSceneBounds *scene_bounds,
-    float32_t z_extension_factor, const VkrShadowFit *previous_fit,
+    VkrMeshBoundsIndex *caster_index, float32_t z_extension_factor,
+    const VkrShadowFit *previous_fit,
     Mat4 *out_view_projection, VkrShadowFit *out_fit,
     Vec2 *out_light_space_origin) {
   const Mat4 view = *light_view;
@@ -472,7 +544,7 @@ vkr_internal void vkr_shadow_compute_cascade_matrix(
     max_z = vkr_max_f32(max_z, corner_ls.z);
   }
 
-  if ((!scene_bounds || !scene_bounds->use_scene_bounds) &&
+  if (!caster_index && (!scene_bounds || !scene_bounds->use_scene_bounds) &&
       z_extension_factor > 0.0f) {
     float32_t z_ext = radius * z_extension_factor;
     min_z -= z_ext;
@@ -536,7 +608,17 @@ vkr_internal void vkr_shadow_compute_cascade_matrix(
   // The caster-Z fit needs the XY rectangle, so it runs before hysteresis. The
   // deadbands then apply to the complete raw interval rather than to a partial
   // one that a later widening would invalidate.
-  if (scene_bounds && scene_bounds->use_scene_bounds) {
+  if (caster_index) {
+    float32_t caster_min_z = 0.0f;
+    float32_t caster_max_z = 0.0f;
+    if (vkr_shadow_fit_indexed_caster_z(
+            &view, caster_index, center_x - half, center_x + half,
+            center_y - half, center_y + half, &caster_min_z, &caster_max_z)) {
+      // Casters further from the light than every receiver cannot shadow
+      // them, so only the light-facing end of the interval grows.
+      max_z = vkr_max_f32(max_z, caster_max_z);
+    }
+  } else if (scene_bounds && scene_bounds->use_scene_bounds) {
     float32_t caster_min_z = 0.0f;
     float32_t caster_max_z = 0.0f;
     if (vkr_shadow_fit_relevant_caster_z(
@@ -588,6 +670,163 @@ vkr_internal void vkr_shadow_compute_cascade_matrix(
   *out_view_projection = mat4_mul(light_projection, view);
 }
 
+// ============================================================================
+// Caster Lists
+// ============================================================================
+
+typedef struct VkrShadowCasterCollect {
+  VkrShadowSystem *system;
+  uint32_t *keys;
+  uint32_t count;
+  uint8_t cascade_bit;
+} VkrShadowCasterCollect;
+
+vkr_internal bool8_t vkr_shadow_collect_caster_visit(uint32_t key,
+                                                     void *user_data) {
+  VkrShadowCasterCollect *collect = (VkrShadowCasterCollect *)user_data;
+  collect->keys[collect->count++] = key;
+  collect->system->caster_cascade_masks[key] |= collect->cascade_bit;
+  return true_v;
+}
+
+vkr_internal void vkr_shadow_clear_caster_lists(VkrShadowSystem *system) {
+  if (system->caster_keys) {
+    for (uint32_t cascade = 0; cascade < VKR_SHADOW_CASCADE_COUNT_MAX;
+         ++cascade) {
+      const uint32_t *keys =
+          system->caster_keys + (uint64_t)cascade * system->caster_capacity;
+      for (uint32_t i = 0; i < system->caster_counts[cascade]; ++i) {
+        system->caster_cascade_masks[keys[i]] = 0;
+      }
+    }
+  }
+  MemZero(system->caster_counts, sizeof(system->caster_counts));
+  system->caster_lists_valid = false_v;
+}
+
+/**
+ * Records the casters overlapping a cascade's final volume. This runs on the
+ * post-hysteresis fit, which may be wider or shifted relative to the raw fit
+ * the depth interval was derived from.
+ */
+vkr_internal void vkr_shadow_collect_cascade_casters(VkrShadowSystem *system,
+                                                     uint32_t cascade,
+                                                     const Mat4 *light_view,
+                                                     const VkrShadowFit *fit) {
+  const float32_t half = fit->extent * 0.5f;
+  VkrPlane planes[5];
+  vkr_shadow_cascade_caster_planes(
+      light_view, fit->center_x - half, fit->center_x + half,
+      fit->center_y - half, fit->center_y + half, fit->min_z, planes);
+
+  VkrShadowCasterCollect collect = {
+      .system = system,
+      .keys = system->caster_keys + (uint64_t)cascade * system->caster_capacity,
+      .cascade_bit = (uint8_t)(1u << cascade),
+  };
+  vkr_mesh_bounds_index_query_planes(system->caster_index, planes, 5u,
+                                     vkr_shadow_collect_caster_visit,
+                                     &collect);
+  system->caster_counts[cascade] = collect.count;
+}
+
+vkr_internal void vkr_shadow_release_caster_lists(VkrShadowSystem *system) {
+  if (!system->caster_allocator) {
+    return;
+  }
+  const uint64_t capacity = system->caster_capacity;
+  if (system->caster_cascade_masks) {
+    vkr_allocator_free(system->caster_allocator, system->caster_cascade_masks,
+                       capacity, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (system->caster_keys) {
+    vkr_allocator_free(system->caster_allocator, system->caster_keys,
+                       sizeof(uint32_t) * capacity *
+                           VKR_SHADOW_CASCADE_COUNT_MAX,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  system->caster_index = NULL;
+  system->caster_allocator = NULL;
+  system->caster_cascade_masks = NULL;
+  system->caster_keys = NULL;
+  system->caster_capacity = 0;
+  MemZero(system->caster_counts, sizeof(system->caster_counts));
+  system->caster_lists_valid = false_v;
+}
+
+bool8_t vkr_shadow_system_set_caster_index(VkrShadowSystem *system,
+                                           VkrAllocator *allocator,
+                                           VkrMeshBoundsIndex *caster_index) {
+  if (!system || !system->initialized) {
+    return false_v;
+  }
+
+  vkr_shadow_release_caster_lists(system);
+  if (!caster_index || caster_index->key_capacity == 0) {
+    return true_v;
+  }
+  if (!allocator) {
+    return false_v;
+  }
+
+  const uint64_t capacity = caster_index->key_capacity;
+  uint8_t *masks = vkr_allocator_alloc(allocator, capacity,
+                                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint32_t *keys = vkr_allocator_alloc(
+      allocator, sizeof(uint32_t) * capacity * VKR_SHADOW_CASCADE_COUNT_MAX,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!masks || !keys) {
+    log_error("Failed to allocate shadow caster lists (%u keys)",
+              caster_index->key_capacity);
+    if (masks) {
+      vkr_allocator_free(allocator, masks, capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    if (keys) {
+      vkr_allocator_free(allocator, keys,
+                         sizeof(uint32_t) * capacity *
+                             VKR_SHADOW_CASCADE_COUNT_MAX,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    return false_v;
+  }
+  MemZero(masks, capacity);
+
+  system->caster_index = caster_index;
+  system->caster_allocator = allocator;
+  system->caster_cascade_masks = masks;
+  system->caster_keys = keys;
+  system->caster_capacity = caster_index->key_capacity;
+  // Fits made against the scene bounds are not previous values of the
+  // per-caster fit.
+  system->fit_history.valid = false_v;
+  return true_v;
+}
+
+bool8_t vkr_shadow_system_is_caster_relevant(const VkrShadowSystem *system,
+                                             uint32_t key) {
+  if (!system || !system->caster_lists_valid ||
+      key >= system->caster_capacity) {
+    return true_v;
+  }
+  return system->caster_cascade_masks[key] != 0;
+}
+
+const uint32_t *vkr_shadow_system_get_cascade_casters(
+    const VkrShadowSystem *system, uint32_t cascade, uint32_t *out_count) {
+  if (out_count) {
+    *out_count = 0;
+  }
+  if (!system || !system->caster_lists_valid ||
+      cascade >= system->config.cascade_count) {
+    return NULL;
+  }
+  if (out_count) {
+    *out_count = system->caster_counts[cascade];
+  }
+  return system->caster_keys + (uint64_t)cascade * system->caster_capacity;
+}
+
 bool8_t vkr_shadow_system_init(VkrShadowSystem *system, RendererFrontend *rf,
                                const VkrShadowConfig *config) {
   if (!system || !rf) {
@@ -647,6 +886,7 @@ bool8_t vkr_shadow_system_init(VkrShadowSystem *system, RendererFrontend *rf,
 void vkr_shadow_system_shutdown(VkrShadowSystem *system, RendererFrontend *rf) {
   (void)rf;
   if (system) {
+    vkr_shadow_release_caster_lists(system);
     MemZero(system, sizeof(*system));
   }
 }
@@ -669,6 +909,7 @@ void vkr_shadow_system_update(VkrShadowSystem *system, const VkrCamera *camera,
     if (was_enabled) {
       system->enable_generation++;
     }
+    vkr_shadow_clear_caster_lists(system);
     for (uint32_t i = 0; i < system->config.cascade_count; ++i) {
       system->cascades[i].view_projection = mat4_identity();
       system->cascades[i].split_far = 0.0f;
@@ -708,6 +949,11 @@ void vkr_shadow_system_update(VkrShadowSystem *system, const VkrCamera *camera,
                                      shadow_map_size, projection_convention,
                                      system->enable_generation);
 
+  vkr_shadow_clear_caster_lists(system);
+  if (system->caster_index) {
+    vkr_mesh_bounds_index_commit(system->caster_index);
+  }
+
   for (uint32_t i = 0; i < system->config.cascade_count; ++i) {
     float32_t split_near = system->cascade_splits[i];
     float32_t split_far = system->cascade_splits[i + 1];
@@ -741,10 +987,14 @@ void vkr_shadow_system_update(VkrShadowSystem *system, const VkrCamera *camera,
         &light_view, corners, shadow_map_size,
         system->config.stabilize_cascades, guard_band,
         system->config.use_constant_cascade_size, &system->config.scene_bounds,
-        z_extension, history_usable ? &history->cascades[i] : NULL,
+        system->caster_index, z_extension,
+        history_usable ? &history->cascades[i] : NULL,
         &system->cascades[i].view_projection, &fit,
         &system->cascades[i].light_space_origin);
     history->cascades[i] = fit;
+    if (system->caster_index) {
+      vkr_shadow_collect_cascade_casters(system, i, &light_view, &fit);
+    }
     system->cascades[i].world_units_per_texel = fit.world_units_per_texel;
     system->cascades[i].light_space_depth_span = fit.max_z - fit.min_z;
 
@@ -774,6 +1024,7 @@ void vkr_shadow_system_update(VkrShadowSystem *system, const VkrCamera *camera,
   history->projection_convention = projection_convention;
   history->enable_generation = system->enable_generation;
   history->valid = system->config.stabilize_cascades;
+  system->caster_lists_valid = system->caster_index != NULL;
 }
 
 void vkr_shadow_system_get_frame_data(const VkrShadowSystem *system,
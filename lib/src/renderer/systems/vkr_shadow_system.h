@@ -10,7 +10,9 @@
 #include "defines.h"
 #include "math/mat.h"
 #include "math/vec.h"
+#include "memory/vkr_allocator.h"
 #include "renderer/resources/vkr_resources.h"
+#include "renderer/systems/vkr_mesh_bounds_index.h"
 #include "renderer/vkr_renderer.h"
 
 struct s_RendererFrontend;
@@ -91,6 +93,9 @@ typedef struct VkrCascadeData {
  *
  * If use_scene_bounds is false, the system falls back to extending the camera
  * frustum along the light direction by z_extension_factor * radius.
+ *
+ * Both are superseded by a caster index (vkr_shadow_system_set_caster_index),
+ * which fits each cascade to the individual casters it overlaps instead.
  */
 typedef struct VkrShadowSceneBounds {
   Vec3 min;
@@ -286,6 +291,31 @@ bool8_t vkr_shadow_fit_relevant_caster_z(
     float32_t left, float32_t right, float32_t bottom, float32_t top,
     float32_t *out_min_z, float32_t *out_max_z);
 
+/**
+ * Builds the world-space planes bounding a light-space XY rectangle. Depth is
+ * bounded only on the far side (`min_z`), since casters between the light and
+ * the receivers can shadow them however close to the light they are.
+ *
+ * @param out_planes Receives 5 planes: left, right, bottom, top, far.
+ */
+void vkr_shadow_cascade_caster_planes(const Mat4 *light_view, float32_t left,
+                                      float32_t right, float32_t bottom,
+                                      float32_t top, float32_t min_z,
+                                      VkrPlane out_planes[5]);
+
+/**
+ * Fits the light-space Z interval of the indexed casters whose bounds overlap
+ * the supplied cascade XY rectangle. Unlike the scene-AABB fit, one tall or
+ * distant object only widens the cascades it actually overlaps. Returns false
+ * when no indexed caster overlaps the rectangle.
+ */
+bool8_t vkr_shadow_fit_indexed_caster_z(const Mat4 *light_view,
+                                        VkrMeshBoundsIndex *caster_index,
+                                        float32_t left, float32_t right,
+                                        float32_t bottom, float32_t top,
+                                        float32_t *out_min_z,
+                                        float32_t *out_max_z);
+
 /**
  * @brief CPU-side frame data for the shadow packet payload.
  *
@@ -324,9 +354,27 @@ typedef struct VkrShadowSystem {
   /** Bumped when enabled shadows are disabled; invalidates fit_history. */
   uint64_t enable_generation;
 
+  /**
+   * Optional world-bounds index of shadow casters. When set, cascades fit
+   * their depth range to the casters they overlap and record them below.
+   */
+  VkrMeshBoundsIndex *caster_index;
+  VkrAllocator *caster_allocator;
+  /** Per-key bitmask of the cascades whose final volume a caster overlaps. */
+  uint8_t *caster_cascade_masks;
+  /** Per-cascade caster key lists, caster_capacity entries per cascade. */
+  uint32_t *caster_keys;
+  uint32_t caster_capacity;
+  uint32_t caster_counts[VKR_SHADOW_CASCADE_COUNT_MAX];
+  /** True when the lists above describe the most recent update. */
+  bool8_t caster_lists_valid;
+
   bool8_t initialized;
 } VkrShadowSystem;
 
+_Static_assert(VKR_SHADOW_CASCADE_COUNT_MAX <= 8,
+               "caster_cascade_masks stores one bit per cascade in a byte");
+
 /**
  * @brief Discards the stored fit history.
  *
@@ -400,6 +448,31 @@ void vkr_shadow_system_update(VkrShadowSystem *system,
                               const struct VkrCamera *camera,
                               bool8_t light_enabled, Vec3 light_direction);
 
+/**
+ * @brief Attaches a caster index used for per-cascade fitting and culling.
+ *
+ * Allocates per-cascade caster lists sized to the index key space. Passing
+ * NULL detaches the index and restores the scene-bounds fit.
+ */
+bool8_t vkr_shadow_system_set_caster_index(VkrShadowSystem *system,
+                                           VkrAllocator *allocator,
+                                           VkrMeshBoundsIndex *caster_index);
+
+/**
+ * @brief Whether the caster with `key` can shadow any cascade this frame.
+ *
+ * Always true when no caster lists exist, so callers may filter
+ * unconditionally.
+ */
+bool8_t vkr_shadow_system_is_caster_relevant(const VkrShadowSystem *system,
+                                             uint32_t key);
+
+/**
+ * @brief Returns the keys of the casters overlapping one cascade this frame.
+ */
+const uint32_t *vkr_shadow_system_get_cascade_casters(
+    const VkrShadowSystem *system, uint32_t cascade, uint32_t *out_count);
+
 /**
  * @brief Fill frame data for shader upload and sampler binding.
  */
@@ -0,0 +1,205 @@
+/**
+ * @file vkr_static_batch.c
+ * @brief Static scene batching: planning and merging.
+ */
+
+#include "renderer/systems/vkr_static_batch.h"
+
+#include "containers/vkr_sort.h"
+#include "math/vec.h"
+#include "math/vkr_math.h"
+
+/** Cells are clamped so far-flung items still compare deterministically. */
+#define VKR_STATIC_BATCH_CELL_LIMIT 1000000
+
+vkr_internal uint32_t vkr_static_batch_read_index(
+    const VkrStaticBatchSource *source, uint32_t index) {
+  return source->index_size == sizeof(uint16_t)
+             ? ((const uint16_t *)source->indices)[index]
+             : ((const uint32_t *)source->indices)[index];
+}
+
+vkr_internal int32_t vkr_static_batch_cell(float32_t value,
+                                           float32_t inv_cell_size) {
+  const float32_t cell = vkr_floor_f32(value * inv_cell_size);
+  return (int32_t)vkr_clamp_f32(cell, (float32_t)-VKR_STATIC_BATCH_CELL_LIMIT,
+                                (float32_t)VKR_STATIC_BATCH_CELL_LIMIT);
+}
+
+/**
+ * Resolves the item's vertex range and cell. The range spans every vertex its
+ * indices reach; loader submeshes are contiguous, so this copies little more
+ * than the triangles actually use.
+ */
+vkr_internal void vkr_static_batch_measure(VkrStaticBatchItem *item,
+                                           float32_t inv_cell_size) {
+  const VkrStaticBatchSource *source = item->source;
+  item->valid = false_v;
+  item->vertex_first = 0u;
+  item->vertex_count = 0u;
+  if (!source || !source->vertices || !source->indices ||
+      item->index_count == 0u || item->index_count % 3u != 0u ||
+      item->first_index > source->index_count ||
+      item->index_count > source->index_count - item->first_index) {
+    return;
+  }
+
+  int64_t lowest = INT64_MAX;
+  int64_t highest = INT64_MIN;
+  for (uint32_t i = 0u; i < item->index_count; ++i) {
+    const int64_t vertex =
+        (int64_t)vkr_static_batch_read_index(source, item->first_index + i) +
+        item->vertex_offset;
+    lowest = Min(lowest, vertex);
+    highest = Max(highest, vertex);
+  }
+  if (lowest < 0 || highest >= (int64_t)source->vertex_count) {
+    return;
+  }
+
+  item->vertex_first = (uint32_t)lowest;
+  item->vertex_count = (uint32_t)(highest - lowest + 1);
+  item->cell[0] = vkr_static_batch_cell(item->world_center.x, inv_cell_size);
+  item->cell[1] = vkr_static_batch_cell(item->world_center.y, inv_cell_size);
+  item->cell[2] = vkr_static_batch_cell(item->world_center.z, inv_cell_size);
+  item->valid = true_v;
+}
+
+vkr_internal bool8_t vkr_static_batch_same_group(const VkrStaticBatchItem *a,
+                                                 const VkrStaticBatchItem *b) {
+  return a->valid && b->valid && a->material.id == b->material.id &&
+         a->material.generation == b->material.generation &&
+         a->cell[0] == b->cell[0] && a->cell[1] == b->cell[1] &&
+         a->cell[2] == b->cell[2];
+}
+
+#define VKR_STATIC_BATCH_COMPARE(a, b)                                         \
+  if ((a) != (b))                                                              \
+  return (a) < (b) ? -1 : 1
+
+vkr_internal int32_t vkr_static_batch_item_compare(const void *lhs,
+                                                   const void *rhs) {
+  const VkrStaticBatchItem *a = lhs;
+  const VkrStaticBatchItem *b = rhs;
+  // Invalid items sort last so the run walk can stop at the first one.
+  VKR_STATIC_BATCH_COMPARE(b->valid, a->valid);
+  VKR_STATIC_BATCH_COMPARE(a->material.id, b->material.id);
+  VKR_STATIC_BATCH_COMPARE(a->material.generation, b->material.generation);
+  VKR_STATIC_BATCH_COMPARE(a->cell[2], b->cell[2]);
+  VKR_STATIC_BATCH_COMPARE(a->cell[1], b->cell[1]);
+  VKR_STATIC_BATCH_COMPARE(a->cell[0], b->cell[0]);
+  VKR_STATIC_BATCH_COMPARE(a->user_data, b->user_data);
+  return 0;
+}
+
+#undef VKR_STATIC_BATCH_COMPARE
+
+uint32_t vkr_static_batch_plan(VkrStaticBatchItem *items, uint32_t item_count,
+                               float32_t cell_size, uint32_t max_vertices,
+                               VkrStaticBatchRun *out_runs,
+                               uint32_t run_capacity) {
+  if (!items || item_count < 2u || !out_runs || run_capacity == 0u) {
+    return 0u;
+  }
+  if (cell_size <= 0.0f) {
+    cell_size = VKR_STATIC_BATCH_DEFAULT_CELL_SIZE;
+  }
+  if (max_vertices == 0u) {
+    max_vertices = VKR_STATIC_BATCH_DEFAULT_MAX_VERTICES;
+  }
+
+  const float32_t inv_cell_size = 1.0f / cell_size;
+  for (uint32_t i = 0u; i < item_count; ++i) {
+    vkr_static_batch_measure(&items[i], inv_cell_size);
+  }
+  vkr_sort(items, item_count, sizeof(*items), vkr_static_batch_item_compare);
+
+  uint32_t run_count = 0u;
+  uint32_t i = 0u;
+  while (i < item_count && items[i].valid && run_count < run_capacity) {
+    VkrStaticBatchRun run = {.first_item = i};
+    while (i < item_count &&
+           (run.item_count == 0u ||
+            vkr_static_batch_same_group(&items[run.first_item], &items[i])) &&
+           (run.item_count == 0u ||
+            (uint64_t)run.vertex_count + items[i].vertex_count <=
+                max_vertices)) {
+      run.vertex_count += items[i].vertex_count;
+      run.index_count += items[i].index_count;
+      run.item_count++;
+      i++;
+    }
+    if (run.item_count >= 2u) {
+      out_runs[run_count++] = run;
+    }
+  }
+  return run_count;
+}
+
+void vkr_static_batch_merge(const VkrStaticBatchItem *items,
+                            const VkrStaticBatchRun *run,
+                            VkrVertex3d *out_vertices, uint32_t *out_indices,
+                            VkrAabb *out_bounds) {
+  VkrAabb bounds = {
+      .min = vec3_new(VKR_FLOAT_MAX, VKR_FLOAT_MAX, VKR_FLOAT_MAX),
+      .max = vec3_new(-VKR_FLOAT_MAX, -VKR_FLOAT_MAX, -VKR_FLOAT_MAX),
+  };
+  uint32_t vertex_base = 0u;
+  uint32_t index_cursor = 0u;
+
+  for (uint32_t r = 0u; r < run->item_count; ++r) {
+    const VkrStaticBatchItem *item = &items[run->first_item + r];
+    const VkrStaticBatchSource *source = item->source;
+    const Mat4 model = item->model;
+    const Mat4 normal_matrix = mat4_transpose(mat4_inverse(model));
+    const bool8_t mirrored = mat4_determinant(model) < 0.0f;
+
+    for (uint32_t v = 0u; v < item->vertex_count; ++v) {
+      const VkrVertex3d *in = &source->vertices[item->vertex_first + v];
+      VkrVertex3d *out = &out_vertices[vertex_base + v];
+      *out = *in;
+
+      const Vec3 position =
+          mat4_mul_vec3(model, vkr_vertex_unpack_vec3(in->position));
+      const Vec3 normal = vec3_normalize(vec4_to_vec3(mat4_mul_vec4(
+          normal_matrix,
+          vec4_new(in->normal.x, in->normal.y, in->normal.z, 0.0f))));
+      const Vec3 tangent = vec3_normalize(vec4_to_vec3(mat4_mul_vec4(
+          model, vec4_new(in->tangent.x, in->tangent.y, in->tangent.z, 0.0f))));
+      out->position = vkr_vertex_pack_vec3(position);
+      out->normal = vkr_vertex_pack_vec3(normal);
+      out->tangent = vec4_new(tangent.x, tangent.y, tangent.z,
+                              mirrored ? -in->tangent.w : in->tangent.w);
+
+      bounds.min.x = vkr_min_f32(bounds.min.x, position.x);
+      bounds.min.y = vkr_min_f32(bounds.min.y, position.y);
+      bounds.min.z = vkr_min_f32(bounds.min.z, position.z);
+      bounds.max.x = vkr_max_f32(bounds.max.x, position.x);
+      bounds.max.y = vkr_max_f32(bounds.max.y, position.y);
+      bounds.max.z = vkr_max_f32(bounds.max.z, position.z);
+    }
+
+    // Rebase from the source range onto this item's slot in the batch.
+    const int64_t rebase =
+        (int64_t)vertex_base + item->vertex_offset - item->vertex_first;
+    for (uint32_t t = 0u; t < item->index_count; t += 3u) {
+      const uint32_t base = item->first_index + t;
+      uint32_t *triangle = &out_indices[index_cursor + t];
+      triangle[0] = (uint32_t)(
+          vkr_static_batch_read_index(source, base) + rebase);
+      triangle[1] = (uint32_t)(
+          vkr_static_batch_read_index(source, base + (mirrored ? 2u : 1u)) +
+          rebase);
+      triangle[2] = (uint32_t)(
+          vkr_static_batch_read_index(source, base + (mirrored ? 1u : 2u)) +
+          rebase);
+    }
+
+    vertex_base += item->vertex_count;
+    index_cursor += item->index_count;
+  }
+
+  if (out_bounds) {
+    *out_bounds = bounds;
+  }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file vkr_static_batch.h
+ * @brief Static scene batching: merges draws of instances that never move.
+ *
+ * Static scenes submit thousands of small submesh draws, each with its own
+ * candidate row, material lookup and instance record. Once a scene marks an
+ * instance static, its submeshes become batch items: they are grouped by
+ * material and by the world-space cell their bounds center falls in, and each
+ * group of two or more is baked into one geometry whose vertices are already
+ * in world space. The group then draws as a single candidate with an identity
+ * model and its own world bounds, so GPU culling still rejects it per cell.
+ *
+ * This file holds the pure planning and merging steps. The mesh manager owns
+ * the runtime state: which items are merged, the published geometry of each
+ * cluster, and dissolving a cluster when one of its instances stops being
+ * static.
+ */
+#pragma once
+
+#include "defines.h"
+#include "math/mat.h"
+#include "math/vkr_bvh.h"
+#include "renderer/resources/vkr_resources.h"
+#include "renderer/vkr_buffer.h"
+
+/** Default world-space cell edge used to group batch items. */
+#define VKR_STATIC_BATCH_DEFAULT_CELL_SIZE 32.0f
+/** Default cap on the vertices baked into one cluster. */
+#define VKR_STATIC_BATCH_DEFAULT_MAX_VERTICES 65536u
+
+/**
+ * @brief CPU copy of a merged mesh buffer, retained per asset so its
+ * submeshes can be baked into static batches after the upload.
+ */
+typedef struct VkrStaticBatchSource {
+  const VkrVertex3d *vertices;
+  uint32_t vertex_count;
+  /** 16- or 32-bit indices, selected by `index_size`. */
+  const void *indices;
+  uint32_t index_size;
+  uint32_t index_count;
+} VkrStaticBatchSource;
+
+/**
+ * @brief One (instance, submesh) draw offered for batching.
+ *
+ * Callers fill everything above `vertex_first`; planning fills the rest.
+ * `user_data` is handed back untouched so the caller can map merged items
+ * to its own records.
+ */
+typedef struct VkrStaticBatchItem {
+  const VkrStaticBatchSource *source;
+  uint32_t first_index;
+  uint32_t index_count;
+  int32_t vertex_offset;
+  Mat4 model;
+  VkrMaterialHandle material;
+  Vec3 world_center;
+  uint32_t user_data;
+
+  /** Source vertex range referenced by the index range. */
+  uint32_t vertex_first;
+  uint32_t vertex_count;
+  int32_t cell[3];
+  /** False when the index range falls outside its source. */
+  bool8_t valid;
+} VkrStaticBatchItem;
+
+/** A run of planned items that merge into one cluster. */
+typedef struct VkrStaticBatchRun {
+  uint32_t first_item;
+  uint32_t item_count;
+  uint32_t vertex_count;
+  uint32_t index_count;
+} VkrStaticBatchRun;
+
+/** Runtime (instance, submesh) pair baked into a cluster. */
+typedef struct VkrStaticBatchMember {
+  uint32_t instance_slot;
+  uint32_t instance_generation;
+  uint32_t submesh_index;
+} VkrStaticBatchMember;
+
+/**
+ * @brief A published static batch, owned by the mesh manager.
+ *
+ * The geometry holds world-space vertices, so the cluster draws with an
+ * identity model; `center`/`min_extents`/`max_extents` are its world bounds
+ * in the same center-plus-extents form submeshes use. A cluster whose
+ * geometry id is 0 is a free slot.
+ */
+typedef struct VkrStaticBatchCluster {
+  VkrGeometryHandle geometry;
+  VkrMaterialHandle material;
+  Vec3 center;
+  Vec3 min_extents;
+  Vec3 max_extents;
+  VkrStaticBatchMember *members;
+  uint32_t member_count;
+} VkrStaticBatchCluster;
+
+/**
+ * @brief Measures, groups and orders `items` in place and emits the runs
+ * worth merging.
+ *
+ * Items are sorted by material, then by the cell their world center falls in
+ * (`cell_size` world units per edge). Each (material, cell) group is split
+ * wherever it would exceed `max_vertices`, and only runs of two or more items
+ * are emitted: a lone item gains nothing from being copied. Items left out of
+ * every run stay with their original draws.
+ *
+ * @return Number of runs written, at most `run_capacity`.
+ */
+uint32_t vkr_static_batch_plan(VkrStaticBatchItem *items, uint32_t item_count,
+                               float32_t cell_size, uint32_t max_vertices,
+                               VkrStaticBatchRun *out_runs,
+                               uint32_t run_capacity);
+
+/**
+ * @brief Bakes one planned run into world-space vertices and 32-bit indices.
+ *
+ * Positions go through each item's model, normals through its inverse
+ * transpose and tangents through the model, all renormalized. Mirroring
+ * models flip tangent handedness and triangle winding so the baked triangles
+ * face the same way the instanced draw did.
+ *
+ * @param out_vertices Receives `run->vertex_count` vertices.
+ * @param out_indices Receives `run->index_count` indices.
+ * @param out_bounds World AABB of the baked vertices.
+ */
+void vkr_static_batch_merge(const VkrStaticBatchItem *items,
+                            const VkrStaticBatchRun *run,
+                            VkrVertex3d *out_vertices, uint32_t *out_indices,
+                            VkrAabb *out_bounds);
@@ -0,0 +1,439 @@
+#include "renderer/systems/vkr_texture_streaming.h"
+
+#include "containers/vkr_sort.h"
+#include "core/logger.h"
+#include "math/vkr_math.h"
+
+typedef struct VkrTextureStreamingCandidate {
+  uint32_t index;
+  /** Mips between the resident and desired top; larger is more starved. */
+  uint32_t deficit;
+  uint64_t last_request_frame;
+  bool8_t downgrade;
+} VkrTextureStreamingCandidate;
+
+vkr_internal VkrTextureStreamingEntry *
+vkr_texture_streaming_entry(const VkrTextureStreaming *streaming,
+                            VkrTextureHandle handle) {
+  if (!streaming || !streaming->entries || !handle.id ||
+      handle.id > streaming->config.capacity)
+    return NULL;
+  VkrTextureStreamingEntry *entry = &streaming->entries[handle.id - 1u];
+  return entry->live && entry->handle.generation == handle.generation ? entry
+                                                                      : NULL;
+}
+
+vkr_internal void
+vkr_texture_streaming_free_entry(VkrTextureStreaming *streaming,
+                                 VkrTextureStreamingEntry *entry) {
+  if (entry->data) {
+    vkr_allocator_free(streaming->allocator, entry->data, entry->data_size,
+                       VKR_ALLOCATOR_MEMORY_TAG_TEXTURE);
+  }
+  if (entry->regions) {
+    vkr_allocator_free(streaming->allocator, entry->regions,
+                       sizeof(*entry->regions) * entry->region_count,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(entry, sizeof(*entry));
+}
+
+/**
+ * Republishes the sub-chain whose top is `top_mip`. Regions are rebased so the
+ * top becomes level 0, and only the byte window the kept regions span is
+ * handed over, so the publisher copies no more than it uploads.
+ */
+vkr_internal bool8_t
+vkr_texture_streaming_publish(VkrTextureStreaming *streaming,
+                              const VkrTextureStreamingEntry *entry,
+                              uint32_t top_mip) {
+  VkrTextureUploadRegion regions[VKR_TEXTURE_STREAMING_MAX_MIPS *
+                                 VKR_TEXTURE_STREAMING_MAX_LAYERS];
+  uint32_t region_count = 0u;
+  uint64_t window_begin = UINT64_MAX;
+  uint64_t window_end = 0u;
+  for (uint32_t i = 0u; i < entry->region_count; ++i) {
+    const VkrTextureUploadRegion *region = &entry->regions[i];
+    if (region->mip_level < top_mip)
+      continue;
+    regions[region_count] = *region;
+    regions[region_count].mip_level -= top_mip;
+    region_count++;
+    window_begin = Min(window_begin, region->byte_offset);
+    window_end = Max(window_end, region->byte_offset + region->byte_size);
+  }
+  if (!region_count || window_end <= window_begin)
+    return false_v;
+  for (uint32_t i = 0u; i < region_count; ++i) {
+    regions[i].byte_offset -= window_begin;
+  }
+
+  VkrTexturePreparedLoad prepared = {
+      .description = entry->description,
+      .upload_data = entry->data + window_begin,
+      .upload_data_size = window_end - window_begin,
+      .upload_regions = regions,
+      .upload_region_count = region_count,
+      .upload_mip_levels = entry->mip_count - top_mip,
+      .upload_array_layers = entry->layer_count,
+      .upload_is_compressed = entry->compressed,
+  };
+  prepared.description.width = Max(1u, entry->description.width >> top_mip);
+  prepared.description.height = Max(1u, entry->description.height >> top_mip);
+  return streaming->publisher->publish_texture(streaming->publisher->state,
+                                               entry->handle, &prepared);
+}
+
+/** Moves `entry` to `top_mip`; budget accounting follows only on success. */
+vkr_internal bool8_t
+vkr_texture_streaming_transition(VkrTextureStreaming *streaming,
+                                 VkrTextureStreamingEntry *entry,
+                                 uint32_t top_mip,
+                                 VkrTextureStreamingStats *stats) {
+  if (!vkr_texture_streaming_publish(streaming, entry, top_mip)) {
+    log_warn("Texture streaming failed to republish %u:%u at mip %u",
+             entry->handle.id, entry->handle.generation, top_mip);
+    entry->state = VKR_TEXTURE_RESIDENCY_FAILED;
+    entry->failed_mip = entry->desired_mip;
+    stats->failures++;
+    return false_v;
+  }
+  streaming->resident_bytes -= entry->chain_bytes[entry->resident_mip];
+  streaming->resident_bytes += entry->chain_bytes[top_mip];
+  stats->upload_bytes += entry->chain_bytes[top_mip];
+  if (top_mip < entry->resident_mip) {
+    stats->upgrades++;
+  } else {
+    stats->downgrades++;
+  }
+  entry->resident_mip = top_mip;
+  entry->state = top_mip == entry->desired_mip
+                     ? VKR_TEXTURE_RESIDENCY_RESIDENT
+                     : VKR_TEXTURE_RESIDENCY_UPGRADE_PENDING;
+  return true_v;
+}
+
+/** Downgrades first since they release budget, then most starved upgrades. */
+vkr_internal int32_t vkr_texture_streaming_candidate_compare(const void *lhs,
+                                                             const void *rhs) {
+  const VkrTextureStreamingCandidate *a = lhs;
+  const VkrTextureStreamingCandidate *b = rhs;
+  if (a->downgrade != b->downgrade)
+    return a->downgrade ? -1 : 1;
+  if (a->deficit != b->deficit)
+    return a->deficit > b->deficit ? -1 : 1;
+  if (a->last_request_frame != b->last_request_frame)
+    return a->last_request_frame > b->last_request_frame ? -1 : 1;
+  return (a->index > b->index) - (a->index < b->index);
+}
+
+bool8_t vkr_texture_streaming_init(VkrTextureStreaming *streaming,
+                                   VkrAllocator *allocator,
+                                   const VkrAssetPublisher *publisher,
+                                   const VkrTextureStreamingConfig *config) {
+  assert_log(streaming != NULL, "Streaming is NULL");
+  assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(config != NULL, "Config is NULL");
+
+  MemZero(streaming, sizeof(*streaming));
+  if (!publisher || !publisher->publish_texture || !config->capacity) {
+    log_error("Texture streaming needs a texture publisher and capacity");
+    return false_v;
+  }
+  streaming->allocator = allocator;
+  streaming->publisher = publisher;
+  streaming->config = *config;
+  streaming->config.tail_mip_count = Max(config->tail_mip_count, 1u);
+  streaming->entries = vkr_allocator_alloc(
+      allocator, sizeof(*streaming->entries) * config->capacity,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  streaming->candidates = vkr_allocator_alloc(
+      allocator, sizeof(*streaming->candidates) * config->capacity,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!streaming->entries || !streaming->candidates) {
+    log_error("Failed to allocate texture streaming for %u textures",
+              config->capacity);
+    vkr_texture_streaming_shutdown(streaming);
+    return false_v;
+  }
+  MemZero(streaming->entries,
+          sizeof(*streaming->entries) * config->capacity);
+  return true_v;
+}
+
+void vkr_texture_streaming_shutdown(VkrTextureStreaming *streaming) {
+  if (!streaming || !streaming->allocator)
+    return;
+  const uint32_t capacity = streaming->config.capacity;
+  if (streaming->entries) {
+    for (uint32_t i = 0u; i < capacity; ++i) {
+      if (streaming->entries[i].live) {
+        vkr_texture_streaming_free_entry(streaming, &streaming->entries[i]);
+      }
+    }
+    vkr_allocator_free(streaming->allocator, streaming->entries,
+                       sizeof(*streaming->entries) * capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (streaming->candidates) {
+    vkr_allocator_free(streaming->allocator, streaming->candidates,
+                       sizeof(*streaming->candidates) * capacity,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(streaming, sizeof(*streaming));
+}
+
+bool8_t
+vkr_texture_streaming_accepts(const VkrTexturePreparedLoad *prepared) {
+  if (!prepared || prepared->description.type != VKR_TEXTURE_TYPE_2D ||
+      !prepared->upload_data || !prepared->upload_data_size ||
+      !prepared->upload_regions || !prepared->upload_region_count ||
+      prepared->upload_mip_levels < 2u ||
+      prepared->upload_mip_levels > VKR_TEXTURE_STREAMING_MAX_MIPS ||
+      !prepared->upload_array_layers ||
+      prepared->upload_array_layers > VKR_TEXTURE_STREAMING_MAX_LAYERS ||
+      prepared->upload_region_count >
+          prepared->upload_mip_levels * prepared->upload_array_layers)
+    return false_v;
+  for (uint32_t i = 0u; i < prepared->upload_region_count; ++i) {
+    const VkrTextureUploadRegion *region = &prepared->upload_regions[i];
+    if (region->mip_level >= prepared->upload_mip_levels ||
+        region->byte_offset > prepared->upload_data_size ||
+        region->byte_size > prepared->upload_data_size - region->byte_offset)
+      return false_v;
+  }
+  return true_v;
+}
+
+bool8_t vkr_texture_streaming_register(VkrTextureStreaming *streaming,
+                                       VkrTextureHandle handle,
+                                       const VkrTexturePreparedLoad *prepared) {
+  assert_log(streaming != NULL, "Streaming is NULL");
+
+  if (!streaming->entries || !handle.id ||
+      handle.id > streaming->config.capacity ||
+      streaming->entries[handle.id - 1u].live ||
+      !vkr_texture_streaming_accepts(prepared))
+    return false_v;
+
+  VkrTextureStreamingEntry *entry = &streaming->entries[handle.id - 1u];
+  MemZero(entry, sizeof(*entry));
+  entry->data_size = prepared->upload_data_size;
+  entry->region_count = prepared->upload_region_count;
+  entry->data =
+      vkr_allocator_alloc(streaming->allocator, entry->data_size,
+                          VKR_ALLOCATOR_MEMORY_TAG_TEXTURE);
+  entry->regions = vkr_allocator_alloc(
+      streaming->allocator, sizeof(*entry->regions) * entry->region_count,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!entry->data || !entry->regions) {
+    vkr_texture_streaming_free_entry(streaming, entry);
+    return false_v;
+  }
+  MemCopy(entry->data, prepared->upload_data, entry->data_size);
+  MemCopy(entry->regions, prepared->upload_regions,
+          sizeof(*entry->regions) * entry->region_count);
+  entry->handle = handle;
+  entry->description = prepared->description;
+  entry->mip_count = prepared->upload_mip_levels;
+  entry->layer_count = prepared->upload_array_layers;
+  entry->compressed = prepared->upload_is_compressed;
+  for (uint32_t i = 0u; i < entry->region_count; ++i) {
+    // Each region counts toward every chain that still includes its mip.
+    for (uint32_t top = 0u; top <= entry->regions[i].mip_level; ++top) {
+      entry->chain_bytes[top] += entry->regions[i].byte_size;
+    }
+  }
+  entry->tail_mip =
+      entry->mip_count - Min(streaming->config.tail_mip_count,
+                             entry->mip_count);
+  entry->resident_mip = entry->tail_mip;
+  entry->desired_mip = entry->tail_mip;
+  entry->requested_mip = VKR_INVALID_ID;
+  entry->last_request_frame = streaming->frame_index;
+
+  if (!vkr_texture_streaming_publish(streaming, entry, entry->tail_mip)) {
+    vkr_texture_streaming_free_entry(streaming, entry);
+    return false_v;
+  }
+  entry->live = true_v;
+  entry->state = VKR_TEXTURE_RESIDENCY_RESIDENT;
+  streaming->resident_bytes += entry->chain_bytes[entry->tail_mip];
+  return true_v;
+}
+
+bool8_t vkr_texture_streaming_unregister(VkrTextureStreaming *streaming,
+                                         VkrTextureHandle handle) {
+  VkrTextureStreamingEntry *entry =
+      vkr_texture_streaming_entry(streaming, handle);
+  if (!entry)
+    return false_v;
+  streaming->resident_bytes -= entry->chain_bytes[entry->resident_mip];
+  vkr_texture_streaming_free_entry(streaming, entry);
+  return true_v;
+}
+
+uint32_t vkr_texture_streaming_mip_for_density(float32_t texels_per_pixel) {
+  // Halving until under two texels per pixel is floor(log2) without libm,
+  // and a NaN density fails the first comparison and stays at mip 0.
+  uint32_t mip = 0u;
+  while (texels_per_pixel >= 2.0f &&
+         mip + 1u < VKR_TEXTURE_STREAMING_MAX_MIPS) {
+    texels_per_pixel *= 0.5f;
+    mip++;
+  }
+  return mip;
+}
+
+void vkr_texture_streaming_request_mip(VkrTextureStreaming *streaming,
+                                       VkrTextureHandle handle,
+                                       uint32_t mip_level) {
+  VkrTextureStreamingEntry *entry =
+      vkr_texture_streaming_entry(streaming, handle);
+  if (entry) {
+    entry->requested_mip = Min(entry->requested_mip, mip_level);
+  }
+}
+
+void vkr_texture_streaming_request_uv_density(VkrTextureStreaming *streaming,
+                                              VkrTextureHandle handle,
+                                              float32_t uv_area,
+                                              float32_t screen_area_pixels) {
+  VkrTextureStreamingEntry *entry =
+      vkr_texture_streaming_entry(streaming, handle);
+  if (!entry || !(screen_area_pixels > 0.0f) || !(uv_area > 0.0f))
+    return;
+  const float32_t texels = (float32_t)entry->description.width *
+                           (float32_t)entry->description.height * uv_area;
+  const float32_t texels_per_pixel =
+      vkr_sqrt_f32(texels / screen_area_pixels);
+  entry->requested_mip =
+      Min(entry->requested_mip,
+          vkr_texture_streaming_mip_for_density(texels_per_pixel));
+}
+
+uint32_t vkr_texture_streaming_apply_feedback(
+    VkrTextureStreaming *streaming,
+    const VkrTextureStreamingFeedback *feedback, uint32_t count) {
+  if (!streaming || !streaming->entries || !feedback)
+    return 0u;
+  uint32_t matched = 0u;
+  for (uint32_t i = 0u; i < count; ++i) {
+    const uint32_t id = feedback[i].texture_id;
+    if (!id || id > streaming->config.capacity)
+      continue;
+    VkrTextureStreamingEntry *entry = &streaming->entries[id - 1u];
+    if (!entry->live)
+      continue;
+    entry->requested_mip = Min(entry->requested_mip, feedback[i].mip_level);
+    matched++;
+  }
+  return matched;
+}
+
+void vkr_texture_streaming_update(VkrTextureStreaming *streaming,
+                                  VkrTextureStreamingStats *out_stats) {
+  assert_log(streaming != NULL, "Streaming is NULL");
+
+  VkrTextureStreamingStats stats = {0};
+  const VkrTextureStreamingConfig *config = &streaming->config;
+  uint32_t candidate_count = 0u;
+  for (uint32_t i = 0u; streaming->entries && i < config->capacity; ++i) {
+    VkrTextureStreamingEntry *entry = &streaming->entries[i];
+    if (!entry->live)
+      continue;
+    if (entry->requested_mip != VKR_INVALID_ID) {
+      entry->desired_mip = Min(entry->requested_mip, entry->tail_mip);
+      entry->last_request_frame = streaming->frame_index;
+    } else if (streaming->frame_index - entry->last_request_frame >=
+               config->idle_frames_before_drop) {
+      entry->desired_mip = entry->tail_mip;
+    }
+    entry->requested_mip = VKR_INVALID_ID;
+
+    if (entry->state == VKR_TEXTURE_RESIDENCY_FAILED &&
+        entry->failed_mip == entry->desired_mip)
+      continue;
+    if (entry->desired_mip == entry->resident_mip) {
+      entry->state = VKR_TEXTURE_RESIDENCY_RESIDENT;
+      continue;
+    }
+    const bool8_t downgrade = entry->desired_mip > entry->resident_mip;
+    entry->state = downgrade ? VKR_TEXTURE_RESIDENCY_DOWNGRADE_PENDING
+                             : VKR_TEXTURE_RESIDENCY_UPGRADE_PENDING;
+    streaming->candidates[candidate_count++] = (VkrTextureStreamingCandidate){
+        .index = i,
+        .deficit = downgrade ? entry->desired_mip - entry->resident_mip
+                             : entry->resident_mip - entry->desired_mip,
+        .last_request_frame = entry->last_request_frame,
+        .downgrade = downgrade,
+    };
+  }
+  vkr_sort(streaming->candidates, candidate_count,
+           sizeof(*streaming->candidates),
+           vkr_texture_streaming_candidate_compare);
+
+  uint32_t transitions = 0u;
+  for (uint32_t i = 0u; i < candidate_count; ++i) {
+    const VkrTextureStreamingCandidate *candidate = &streaming->candidates[i];
+    VkrTextureStreamingEntry *entry = &streaming->entries[candidate->index];
+    uint32_t top = entry->desired_mip;
+    if (!candidate->downgrade && config->resident_budget_bytes) {
+      // Step toward the desired mip only as far as the resident budget allows.
+      const uint64_t others =
+          streaming->resident_bytes - entry->chain_bytes[entry->resident_mip];
+      while (top < entry->resident_mip &&
+             others + entry->chain_bytes[top] > config->resident_budget_bytes) {
+        top++;
+      }
+    }
+    if (config->upload_budget_bytes && transitions) {
+      const uint64_t remaining =
+          config->upload_budget_bytes - Min(config->upload_budget_bytes,
+                                            stats.upload_bytes);
+      if (candidate->downgrade) {
+        if (entry->chain_bytes[top] > remaining) {
+          top = entry->resident_mip;
+        }
+      } else {
+        while (top < entry->resident_mip &&
+               entry->chain_bytes[top] > remaining) {
+          top++;
+        }
+      }
+    }
+    if (top == entry->resident_mip) {
+      stats.deferred++;
+      continue;
+    }
+    if (vkr_texture_streaming_transition(streaming, entry, top, &stats)) {
+      transitions++;
+    }
+  }
+
+  streaming->frame_index++;
+  stats.resident_bytes = streaming->resident_bytes;
+  if (out_stats) {
+    *out_stats = stats;
+  }
+}
+
+bool8_t vkr_texture_streaming_get_residency(
+    const VkrTextureStreaming *streaming, VkrTextureHandle handle,
+    VkrTextureResidency *out_residency) {
+  assert_log(out_residency != NULL, "Out residency is NULL");
+  const VkrTextureStreamingEntry *entry =
+      vkr_texture_streaming_entry(streaming, handle);
+  if (!entry) {
+    MemZero(out_residency, sizeof(*out_residency));
+    return false_v;
+  }
+  *out_residency = (VkrTextureResidency){
+      .state = entry->state,
+      .mip_count = entry->mip_count,
+      .resident_mip = entry->resident_mip,
+      .desired_mip = entry->desired_mip,
+      .resident_bytes = entry->chain_bytes[entry->resident_mip],
+  };
+  return true_v;
+}
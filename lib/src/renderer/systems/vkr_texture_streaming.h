@@ -0,0 +1,205 @@
+/**
+ * @file vkr_texture_streaming.h
+ * @brief Mip-level residency for textures with a full CPU mip chain.
+ *
+ * A registered texture keeps its prepared mip chain on the CPU and publishes
+ * only a low-resolution tail. Each frame callers report how much detail they
+ * need, either as screen-space UV density per drawn instance or as entries
+ * read back from a feedback buffer, and vkr_texture_streaming_update() moves
+ * every texture toward the finest mip requested for it.
+ *
+ * A transition republishes the texture's sub-chain starting at its new top
+ * mip through the asset publisher under the same handle, so the publisher
+ * retires the previous image exactly as it does for any same-generation
+ * republish. Sampling is unaffected because UVs are normalized: a texture
+ * whose top mip is 2 simply samples a quarter-resolution base level.
+ *
+ * Upgrades are admitted against a global resident-byte budget and a
+ * per-update upload budget, most starved texture first. A texture that no
+ * caller has requested for `idle_frames_before_drop` updates falls back to
+ * its tail, which is what frees budget for the textures still in view.
+ */
+#pragma once
+
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+#include "renderer/systems/vkr_texture_system.h"
+#include "renderer/vkr_asset_publisher.h"
+
+/** Deepest chain a texture may register with (a 32768 texel base level). */
+#define VKR_TEXTURE_STREAMING_MAX_MIPS 16u
+/** Widest layer count a registered chain may have. */
+#define VKR_TEXTURE_STREAMING_MAX_LAYERS 6u
+
+typedef enum VkrTextureResidencyState {
+  VKR_TEXTURE_RESIDENCY_UNTRACKED = 0,
+  /** Resident top mip matches the desired mip. */
+  VKR_TEXTURE_RESIDENCY_RESIDENT,
+  /** Wants finer mips; waiting on the resident or upload budget. */
+  VKR_TEXTURE_RESIDENCY_UPGRADE_PENDING,
+  /** Wants coarser mips; applied on the next update. */
+  VKR_TEXTURE_RESIDENCY_DOWNGRADE_PENDING,
+  /**
+   * The publisher rejected the last transition. The texture keeps its
+   * previous image and is retried once its desired mip changes.
+   */
+  VKR_TEXTURE_RESIDENCY_FAILED,
+} VkrTextureResidencyState;
+
+typedef struct VkrTextureStreamingConfig {
+  /** Logical texture ids admitted; entries are indexed by id. */
+  uint32_t capacity;
+  /** Coarsest mips published at registration; at least one. */
+  uint32_t tail_mip_count;
+  /** Resident bytes across every streamed texture; zero is unbounded. */
+  uint64_t resident_budget_bytes;
+  /**
+   * Bytes republished per update; zero is unbounded. The first transition
+   * of an update is always admitted so an oversized chain cannot starve.
+   */
+  uint64_t upload_budget_bytes;
+  /** Updates without a request before a texture falls back to its tail. */
+  uint32_t idle_frames_before_drop;
+} VkrTextureStreamingConfig;
+
+/** One texel of a feedback buffer: the finest mip sampled from a texture. */
+typedef struct VkrTextureStreamingFeedback {
+  uint32_t texture_id;
+  uint32_t mip_level;
+} VkrTextureStreamingFeedback;
+
+typedef struct VkrTextureStreamingEntry {
+  VkrTextureHandle handle;
+  VkrTextureDescription description;
+  uint8_t *data;
+  uint64_t data_size;
+  VkrTextureUploadRegion *regions;
+  uint32_t region_count;
+  uint32_t mip_count;
+  uint32_t layer_count;
+  bool8_t compressed;
+  bool8_t live;
+
+  /** Resident bytes when mip `m` is the top of the published chain. */
+  uint64_t chain_bytes[VKR_TEXTURE_STREAMING_MAX_MIPS];
+  uint32_t tail_mip;
+  uint32_t resident_mip;
+  uint32_t desired_mip;
+  /** Finest mip requested since the last update, or VKR_INVALID_ID. */
+  uint32_t requested_mip;
+  uint32_t failed_mip;
+  uint64_t last_request_frame;
+  VkrTextureResidencyState state;
+} VkrTextureStreamingEntry;
+
+/** Outcome of the most recent update. */
+typedef struct VkrTextureStreamingStats {
+  uint32_t upgrades;
+  uint32_t downgrades;
+  /** Pending upgrades that did not fit either budget this update. */
+  uint32_t deferred;
+  uint32_t failures;
+  uint64_t upload_bytes;
+  uint64_t resident_bytes;
+} VkrTextureStreamingStats;
+
+typedef struct VkrTextureStreaming {
+  VkrAllocator *allocator;
+  const VkrAssetPublisher *publisher;
+  VkrTextureStreamingConfig config;
+  VkrTextureStreamingEntry *entries;
+  /** Scratch for the per-update transition order, `capacity` entries. */
+  struct VkrTextureStreamingCandidate *candidates;
+  uint64_t resident_bytes;
+  uint64_t frame_index;
+} VkrTextureStreaming;
+
+/** Snapshot of one texture's residency. */
+typedef struct VkrTextureResidency {
+  VkrTextureResidencyState state;
+  uint32_t mip_count;
+  uint32_t resident_mip;
+  uint32_t desired_mip;
+  uint64_t resident_bytes;
+} VkrTextureResidency;
+
+bool8_t vkr_texture_streaming_init(VkrTextureStreaming *streaming,
+                                   VkrAllocator *allocator,
+                                   const VkrAssetPublisher *publisher,
+                                   const VkrTextureStreamingConfig *config);
+
+/** Frees every retained mip chain. Published images are left to their owner. */
+void vkr_texture_streaming_shutdown(VkrTextureStreaming *streaming);
+
+/**
+ * Whether `prepared` is a 2D texture with a mip chain the streamer can
+ * register. Cube maps are sampled by direction, so UV density never asks for
+ * their finer mips and a streamed cube would stay at its tail.
+ */
+bool8_t
+vkr_texture_streaming_accepts(const VkrTexturePreparedLoad *prepared);
+
+/**
+ * @brief Copies `prepared`'s mip chain and publishes its tail under `handle`.
+ *
+ * On failure nothing is published and nothing is retained; the caller may
+ * publish the full chain itself.
+ */
+bool8_t vkr_texture_streaming_register(VkrTextureStreaming *streaming,
+                                       VkrTextureHandle handle,
+                                       const VkrTexturePreparedLoad *prepared);
+
+/**
+ * @brief Drops the retained chain for `handle`.
+ *
+ * The published image is not touched; unpublishing stays with the owner.
+ * @return false when `handle` is not registered.
+ */
+bool8_t vkr_texture_streaming_unregister(VkrTextureStreaming *streaming,
+                                         VkrTextureHandle handle);
+
+/**
+ * @brief Mip whose texel density is closest to, without undersampling,
+ * `texels_per_pixel` texels of the base level per screen pixel.
+ */
+uint32_t vkr_texture_streaming_mip_for_density(float32_t texels_per_pixel);
+
+/** Requests at least mip `mip_level` for `handle` this frame. */
+void vkr_texture_streaming_request_mip(VkrTextureStreaming *streaming,
+                                       VkrTextureHandle handle,
+                                       uint32_t mip_level);
+
+/**
+ * @brief Requests detail for one drawn instance from its screen-space UV
+ * density.
+ *
+ * `uv_area` is the instance's UV-space area (1 for a surface mapped once) and
+ * `screen_area_pixels` the area it covers on screen. Instances with no
+ * screen coverage make no request.
+ */
+void vkr_texture_streaming_request_uv_density(VkrTextureStreaming *streaming,
+                                              VkrTextureHandle handle,
+                                              float32_t uv_area,
+                                              float32_t screen_area_pixels);
+
+/**
+ * @brief Folds a feedback buffer into this frame's requests.
+ *
+ * Feedback carries texture ids only; entries name the live texture in that
+ * slot. Unknown ids are skipped.
+ * @return The number of entries that matched a registered texture.
+ */
+uint32_t vkr_texture_streaming_apply_feedback(
+    VkrTextureStreaming *streaming,
+    const VkrTextureStreamingFeedback *feedback, uint32_t count);
+
+/**
+ * @brief Resolves this frame's requests into desired mips and republishes
+ * as many transitions as the budgets admit.
+ */
+void vkr_texture_streaming_update(VkrTextureStreaming *streaming,
+                                  VkrTextureStreamingStats *out_stats);
+
+bool8_t vkr_texture_streaming_get_residency(
+    const VkrTextureStreaming *streaming, VkrTextureHandle handle,
+    VkrTextureResidency *out_residency);
@@ -5,7 +5,8 @@
 #include "memory/vkr_arena_allocator.h"
 #include "memory/vkr_dmemory_allocator.h"
 #include "renderer/systems/vkr_resource_system.h"
-#include "renderer/vkr_ibl_math.h"
+#include "renderer/systems/vkr_texture_streaming.h"
+#include "renderer/vkr_texture_convert.h"
 
 #include "ktx.h"
 #include "stb_image.h"
@@ -22,8 +23,12 @@
 // extension.
 
 #define VKR_TEXTURE_CACHE_MAGIC 0x564B5448u /* 'VKTH' in little-endian */
-#define VKR_TEXTURE_CACHE_VERSION 3u        /* Bump when format changes */
+#define VKR_TEXTURE_CACHE_VERSION 4u        /* Bump when format changes */
+/* Last version without stored analysis; still read, then upgraded. */
+#define VKR_TEXTURE_CACHE_VERSION_NO_ANALYSIS 3u
 #define VKR_TEXTURE_CACHE_EXT ".vkt"
+/* Share of sampled pixels that must look like normals to warn. */
+#define VKR_TEXTURE_NORMAL_LIKELIHOOD_WARN_THRESHOLD 0.9f
 #define VKR_TEXTURE_SYSTEM_ASYNC_DMEMORY_INITIAL MB(1)
 #define VKR_TEXTURE_SYSTEM_ASYNC_DMEMORY_RESERVE MB(16)
 
@@ -40,6 +45,8 @@ vkr_internal String8 vkr_texture_strip_query(String8 name, String8 *out_query);
  * @param height The height of the texture
  * @param channels The number of channels in the texture
  * @param has_transparency Whether any alpha value is not fully opaque
+ * @param alpha_class VkrTextureAlphaClass of the pixels (version 4+)
+ * @param normal_likelihood Normal-map likelihood scaled to 0-255 (version 4+)
  */
 typedef struct VkrTextureCacheHeader {
   uint32_t magic;
@@ -49,10 +56,22 @@ typedef struct VkrTextureCacheHeader {
   uint32_t height;
   uint32_t channels; // Always 4 (RGBA) after processing
   uint8_t has_transparency;
-  uint8_t padding[3];
+  uint8_t alpha_class;
+  uint8_t normal_likelihood;
+  uint8_t padding;
+  // Version 4+: followed by VkrTextureCacheRanges
   // Followed by: width * height * channels bytes of raw pixel data
 } VkrTextureCacheHeader;
 
+/**
+ * @brief Per-channel pixel ranges stored after the header since version 4,
+ * so warm loads know the analysis results without touching the pixels.
+ */
+typedef struct VkrTextureCacheRanges {
+  uint8_t channel_min[4];
+  uint8_t channel_max[4];
+} VkrTextureCacheRanges;
+
 /**
  * @brief Converts a 32-bit value from host endianness to little endian
  * @param value The value to convert
@@ -823,52 +842,6 @@ vkr_internal VkrTextureFormat vkr_texture_format_from_channels(
   }
 }
 
-typedef struct VkrTextureAlphaAnalysis {
-  bool8_t has_transparency;
-  bool8_t alpha_mask;
-} VkrTextureAlphaAnalysis;
-
-// Treat alpha as a cutout mask when only a small fraction of transparent texels
-// have intermediate coverage (typical for foliage with anti-aliased edges).
-#define VKR_TEXTURE_ALPHA_MASK_INTERMEDIATE_RATIO 0.30f
-
-vkr_internal VkrTextureAlphaAnalysis vkr_texture_analyze_alpha(
-    const uint8_t *pixels, uint64_t pixel_count, uint32_t channels) {
-  VkrTextureAlphaAnalysis analysis = {false_v, false_v};
-  if (!pixels || channels < VKR_TEXTURE_RGBA_CHANNELS || pixel_count == 0) {
-    return analysis;
-  }
-
-  uint64_t transparent_count = 0;
-  uint64_t intermediate_count = 0;
-  for (uint64_t pixel_index = 0; pixel_index < pixel_count; pixel_index++) {
-    uint8_t alpha = pixels[pixel_index * channels + 3];
-    if (alpha < 255) {
-      transparent_count++;
-      if (alpha > 0 && alpha < 255) {
-        intermediate_count++;
-      }
-    }
-  }
-
-  if (transparent_count == 0) {
-    return analysis;
-  }
-
-  analysis.has_transparency = true_v;
-  float32_t ratio =
-      (float32_t)intermediate_count / (float32_t)transparent_count;
-  analysis.alpha_mask = (ratio <= VKR_TEXTURE_ALPHA_MASK_INTERMEDIATE_RATIO);
-  return analysis;
-}
-
-vkr_internal bool8_t vkr_texture_has_transparency(const uint8_t *pixels,
-                                                  uint64_t pixel_count,
-                                                  uint32_t channels) {
-  return vkr_texture_analyze_alpha(pixels, pixel_count, channels)
-      .has_transparency;
-}
-
 vkr_internal bool8_t
 vkr_texture_format_is_block_compressed(VkrTextureFormat format) {
   VkrTextureFormatInfo info = {0};
@@ -922,15 +895,16 @@ bool8_t vkr_texture_format_has_ktx_transcode_target(VkrTextureFormat format) {
  * @param width The width of the texture
  * @param height The height of the texture
  * @param channels The number of channels in the texture
- * @param has_transparency Whether the texture has transparency
+ * @param analysis The analysis of the pixel data, stored with it
  * @param pixel_data The pixel data of the texture
  * @return true on success, false on failure
  */
 vkr_internal bool8_t vkr_texture_cache_write(
     VkrAllocator *allocator, String8 cache_path, uint64_t source_mtime,
     uint32_t width, uint32_t height, uint32_t channels,
-    bool8_t has_transparency, const uint8_t *pixel_data) {
+    const VkrTextureRgba8Analysis *analysis, const uint8_t *pixel_data) {
   assert_log(allocator != NULL, "Allocator is NULL");
+  assert_log(analysis != NULL, "Analysis is NULL");
 
   if (!cache_path.str || !pixel_data) {
     return false_v;
@@ -970,9 +944,19 @@ vkr_internal bool8_t vkr_texture_cache_write(
       .width = vkr_texture_host_to_little_u32(width),
       .height = vkr_texture_host_to_little_u32(height),
       .channels = vkr_texture_host_to_little_u32(channels),
-      .has_transparency = has_transparency ? 1 : 0,
-      .padding = {0, 0, 0},
+      .has_transparency =
+          analysis->alpha_class != VKR_TEXTURE_ALPHA_CLASS_OPAQUE ? 1 : 0,
+      .alpha_class = (uint8_t)analysis->alpha_class,
+      .normal_likelihood =
+          (uint8_t)(Clamp(analysis->normal_likelihood, 0.0f, 1.0f) * 255.0f +
+                    0.5f),
+      .padding = 0,
   };
+  VkrTextureCacheRanges ranges = {0};
+  MemCopy(ranges.channel_min, analysis->channel_min,
+          sizeof(ranges.channel_min));
+  MemCopy(ranges.channel_max, analysis->channel_max,
+          sizeof(ranges.channel_max));
 
   uint64_t written = 0;
   FileError write_err =
@@ -981,6 +965,12 @@ vkr_internal bool8_t vkr_texture_cache_write(
     file_close(&fh);
     return false_v;
   }
+  write_err =
+      file_write(&fh, sizeof(ranges), (const uint8_t *)&ranges, &written);
+  if (write_err != FILE_ERROR_NONE || written != sizeof(ranges)) {
+    file_close(&fh);
+    return false_v;
+  }
 
   uint64_t pixel_size = (uint64_t)width * (uint64_t)height * (uint64_t)channels;
   write_err = file_write(&fh, pixel_size, pixel_data, &written);
@@ -1005,16 +995,20 @@ vkr_internal bool8_t vkr_texture_cache_write(
  * @param out_width The width of the texture
  * @param out_height The height of the texture
  * @param out_channels The number of channels in the texture
- * @param out_has_transparency Whether any alpha value is not fully opaque
+ * @param out_analysis The stored analysis; pixel counts are not stored and
+ * read back as zero
+ * @param out_has_analysis False for caches written before analysis was
+ * stored; `out_analysis` is then zeroed
  */
 vkr_internal bool8_t vkr_texture_cache_read(
     VkrAllocator *allocator, String8 cache_path, bool8_t validate_source_mtime,
     uint64_t source_mtime, uint32_t *out_width, uint32_t *out_height,
-    uint32_t *out_channels, bool8_t *out_has_transparency,
-    uint8_t **out_pixel_data) {
+    uint32_t *out_channels, VkrTextureRgba8Analysis *out_analysis,
+    bool8_t *out_has_analysis, uint8_t **out_pixel_data) {
   assert_log(allocator != NULL, "Allocator is NULL");
 
-  if (!cache_path.str || !out_pixel_data) {
+  if (!cache_path.str || !out_pixel_data || !out_analysis ||
+      !out_has_analysis) {
     return false_v;
   }
 
@@ -1066,7 +1060,8 @@ vkr_internal bool8_t vkr_texture_cache_read(
   uint64_t cached_mtime = vkr_texture_host_to_little_u64(header.source_mtime);
 
   if (magic != VKR_TEXTURE_CACHE_MAGIC ||
-      version != VKR_TEXTURE_CACHE_VERSION) {
+      (version != VKR_TEXTURE_CACHE_VERSION &&
+       version != VKR_TEXTURE_CACHE_VERSION_NO_ANALYSIS)) {
     file_close(&fh);
     return false_v;
   }
@@ -1085,6 +1080,32 @@ vkr_internal bool8_t vkr_texture_cache_read(
     return false_v;
   }
 
+  VkrTextureRgba8Analysis analysis = {0};
+  const bool8_t has_analysis = version == VKR_TEXTURE_CACHE_VERSION;
+  if (has_analysis) {
+    uint8_t *ranges_buf = NULL;
+    read_err = file_read(&fh, allocator, sizeof(VkrTextureCacheRanges),
+                         &bytes_read, &ranges_buf);
+    if (read_err != FILE_ERROR_NONE ||
+        bytes_read != sizeof(VkrTextureCacheRanges) || !ranges_buf ||
+        header.alpha_class > VKR_TEXTURE_ALPHA_CLASS_BLENDED) {
+      file_close(&fh);
+      return false_v;
+    }
+    VkrTextureCacheRanges ranges;
+    MemCopy(&ranges, ranges_buf, sizeof(ranges));
+    analysis.is_constant = true_v;
+    for (uint32_t c = 0; c < 4; ++c) {
+      analysis.channel_min[c] = ranges.channel_min[c];
+      analysis.channel_max[c] = ranges.channel_max[c];
+      if (ranges.channel_min[c] != ranges.channel_max[c]) {
+        analysis.is_constant = false_v;
+      }
+    }
+    analysis.alpha_class = (VkrTextureAlphaClass)header.alpha_class;
+    analysis.normal_likelihood = (float32_t)header.normal_likelihood / 255.0f;
+  }
+
   uint64_t pixel_size = (uint64_t)width * (uint64_t)height * (uint64_t)channels;
 
   uint8_t *temp_pixels = NULL;
@@ -1106,7 +1127,8 @@ vkr_internal bool8_t vkr_texture_cache_read(
   *out_width = width;
   *out_height = height;
   *out_channels = channels;
-  *out_has_transparency = header.has_transparency != 0;
+  *out_analysis = analysis;
+  *out_has_analysis = has_analysis;
   *out_pixel_data = pixels;
 
   return true_v;
@@ -1968,6 +1990,9 @@ bool8_t vkr_texture_destroy(VkrTextureSystem *system, VkrTexture *texture) {
                handle.id, handle.generation);
       return false_v;
     }
+    if (system->streaming) {
+      (void)vkr_texture_streaming_unregister(system->streaming, handle);
+    }
   }
 
   MemZero(texture, sizeof(VkrTexture));
@@ -2047,6 +2072,9 @@ vkr_texture_system_get_default_specular_handle(VkrTextureSystem *system) {
  * @param original_channels The number of channels in the original texture
  * @param has_transparency Whether the texture has transparency (Set when loaded
  * from cache)
+ * @param is_constant_color Whether every decoded RGBA8 pixel is the same
+ * @param normal_likelihood Share of sampled RGBA8 pixels that look like
+ * tangent-space normals
  * @param loaded_from_cache True if loaded from .vkt cache
  * @param error The error code
  * @param success True if the texture was loaded successfully
@@ -2066,6 +2094,8 @@ typedef struct VkrTextureDecodeResult {
   int32_t height;
   int32_t original_channels;
   bool8_t has_transparency;
+  bool8_t is_constant_color;
+  float32_t normal_likelihood;
   bool8_t loaded_from_cache;
   VkrRendererError error;
   bool8_t success;
@@ -2119,9 +2149,20 @@ vkr_texture_decode_result_reset(VkrTextureDecodeResult *result) {
   result->upload_is_compressed = false_v;
   result->upload_format = VKR_TEXTURE_FORMAT_R8G8B8A8_UNORM;
   result->alpha_mask = false_v;
+  result->is_constant_color = false_v;
+  result->normal_likelihood = 0.0f;
   result->loaded_from_cache = false_v;
 }
 
+vkr_internal void vkr_texture_decode_result_apply_analysis(
+    VkrTextureDecodeResult *result, const VkrTextureRgba8Analysis *analysis) {
+  result->has_transparency =
+      analysis->alpha_class != VKR_TEXTURE_ALPHA_CLASS_OPAQUE;
+  result->alpha_mask = analysis->alpha_class == VKR_TEXTURE_ALPHA_CLASS_CUTOUT;
+  result->is_constant_color = analysis->is_constant;
+  result->normal_likelihood = analysis->normal_likelihood;
+}
+
 vkr_internal void
 vkr_texture_decode_result_release(VkrTextureDecodeResult *result) {
   if (!result) {
@@ -2594,37 +2635,36 @@ vkr_internal bool8_t vkr_texture_try_read_legacy_cache(
   uint32_t cached_width = 0;
   uint32_t cached_height = 0;
   uint32_t cached_channels = 0;
-  bool8_t cached_transparency = false_v;
+  VkrTextureRgba8Analysis analysis = {0};
+  bool8_t has_analysis = false_v;
   uint8_t *cached_pixels = NULL;
 
   if (!vkr_texture_cache_read(allocator, cache_path, validate_source_mtime,
                               source_mtime, &cached_width, &cached_height,
-                              &cached_channels, &cached_transparency,
+                              &cached_channels, &analysis, &has_analysis,
                               &cached_pixels)) {
     return false_v;
   }
 
-  if (!cached_transparency && cached_channels == VKR_TEXTURE_RGBA_CHANNELS) {
+  // Caches from before the analysis was stored pay for one pass here and are
+  // rewritten so the next warm load skips it.
+  if (!has_analysis && cached_channels == VKR_TEXTURE_RGBA_CHANNELS) {
     uint64_t pixel_count = (uint64_t)cached_width * (uint64_t)cached_height;
-    if (vkr_texture_has_transparency(cached_pixels, pixel_count,
-                                     cached_channels)) {
-      cached_transparency = true_v;
-      VkrTextureCacheWriteGuard *cache_guard =
-          system ? system->cache_guard : NULL;
-      bool8_t cache_lock_acquired = true_v;
+    vkr_texture_analyze_rgba8(cached_pixels, pixel_count, &analysis);
+    VkrTextureCacheWriteGuard *cache_guard =
+        system ? system->cache_guard : NULL;
+    bool8_t cache_lock_acquired = true_v;
+    if (cache_guard && cache_guard_key) {
+      cache_lock_acquired =
+          vkr_texture_cache_guard_try_acquire(cache_guard, cache_guard_key);
+    }
+    if (cache_lock_acquired) {
+      const uint64_t mtime_to_write = validate_source_mtime ? source_mtime : 0;
+      vkr_texture_cache_write(allocator, cache_path, mtime_to_write,
+                              cached_width, cached_height, cached_channels,
+                              &analysis, cached_pixels);
       if (cache_guard && cache_guard_key) {
-        cache_lock_acquired =
-            vkr_texture_cache_guard_try_acquire(cache_guard, cache_guard_key);
-      }
-      if (cache_lock_acquired) {
-        const uint64_t mtime_to_write =
-            validate_source_mtime ? source_mtime : 0;
-        vkr_texture_cache_write(allocator, cache_path, mtime_to_write,
-                                cached_width, cached_height, cached_channels,
-                                cached_transparency, cached_pixels);
-        if (cache_guard && cache_guard_key) {
-          vkr_texture_cache_guard_release(cache_guard, cache_guard_key);
-        }
+        vkr_texture_cache_guard_release(cache_guard, cache_guard_key);
       }
     }
   }
@@ -2633,27 +2673,145 @@ vkr_internal bool8_t vkr_texture_try_read_legacy_cache(
   out_result->width = (int32_t)cached_width;
   out_result->height = (int32_t)cached_height;
   out_result->original_channels = (int32_t)cached_channels;
-  out_result->has_transparency = cached_transparency;
-  out_result->alpha_mask = false_v;
-  if (cached_channels == VKR_TEXTURE_RGBA_CHANNELS) {
-    uint64_t pixel_count = (uint64_t)cached_width * (uint64_t)cached_height;
-    out_result->alpha_mask =
-        vkr_texture_analyze_alpha(cached_pixels, pixel_count, cached_channels)
-            .alpha_mask;
-  }
+  vkr_texture_decode_result_apply_analysis(out_result, &analysis);
   out_result->loaded_from_cache = true_v;
   out_result->success = true_v;
   return true_v;
 }
 
 /**
- * @brief Decodes a source image file and optionally refreshes sidecar cache.
+ * @brief Returns the next Radiance header line without its newline.
+ *
+ * False once the data ends before a newline; a complete header always has one.
+ */
+vkr_internal bool8_t vkr_texture_rgbe_next_line(const uint8_t *data,
+                                                uint64_t size, uint64_t *cursor,
+                                                String8 *out_line) {
+  const uint64_t start = *cursor;
+  uint64_t at = start;
+  while (at < size && data[at] != '\n') {
+    at++;
+  }
+  if (at >= size) {
+    return false_v;
+  }
+  *out_line = string8_create_from_cstr(data + start, at - start);
+  *cursor = at + 1u;
+  return true_v;
+}
+
+/**
+ * @brief Parses the Radiance header up to the first scanline.
+ *
+ * Accepts the same files stb_image does: `#?RADIANCE` or `#?RGBE` magic, the
+ * `32-bit_rle_rgbe` format and the standard `-Y height +X width` orientation.
+ *
+ * @return NULL on success, otherwise why the header was rejected.
+ */
+vkr_internal const char *
+vkr_texture_rgbe_read_header(const uint8_t *data, uint64_t size,
+                             uint64_t *cursor, int32_t *out_width,
+                             int32_t *out_height) {
+  String8 line = {0};
+  if (!vkr_texture_rgbe_next_line(data, size, cursor, &line) ||
+      (!vkr_string8_equals_cstr(&line, "#?RADIANCE") &&
+       !vkr_string8_equals_cstr(&line, "#?RGBE"))) {
+    return "not a Radiance HDR file";
+  }
+
+  bool8_t rle_rgbe = false_v;
+  for (;;) {
+    if (!vkr_texture_rgbe_next_line(data, size, cursor, &line)) {
+      return "truncated header";
+    }
+    if (line.length == 0u) {
+      break;
+    }
+    if (vkr_string8_equals_cstr(&line, "FORMAT=32-bit_rle_rgbe")) {
+      rle_rgbe = true_v;
+    }
+  }
+  if (!rle_rgbe) {
+    return "unsupported format, expected 32-bit_rle_rgbe";
+  }
+
+  String8 tokens[5] = {0};
+  if (!vkr_texture_rgbe_next_line(data, size, cursor, &line) ||
+      string8_split_whitespace(&line, tokens, ArrayCount(tokens)) != 4u ||
+      !vkr_string8_equals_cstr(&tokens[0], "-Y") ||
+      !vkr_string8_equals_cstr(&tokens[2], "+X") ||
+      !string8_to_i32(&tokens[1], out_height) ||
+      !string8_to_i32(&tokens[3], out_width)) {
+    return "unsupported orientation, expected -Y height +X width";
+  }
+  return NULL;
+}
+
+/**
+ * @brief Decodes one scanline into `width` RGBE pixels.
+ *
+ * Scanlines 8 to 32767 pixels wide that open with the 2, 2 marker are run
+ * length encoded one channel at a time; anything else is stored flat.
+ *
+ * @return NULL on success, otherwise why the scanline is corrupt.
+ */
+vkr_internal const char *
+vkr_texture_rgbe_read_scanline(const uint8_t *data, uint64_t size,
+                               uint64_t *cursor, uint32_t width,
+                               uint8_t *out_rgbe) {
+  const uint8_t *in = data + *cursor;
+  const uint64_t available = size - *cursor;
+  if (width < 8u || width >= 32768u || available < 4u || in[0] != 2u ||
+      in[1] != 2u || (in[2] & 0x80u) != 0u) {
+    const uint64_t bytes = (uint64_t)width * 4u;
+    if (available < bytes) {
+      return "truncated scanline";
+    }
+    MemCopy(out_rgbe, in, bytes);
+    *cursor += bytes;
+    return NULL;
+  }
+  if ((((uint32_t)in[2] << 8u) | (uint32_t)in[3]) != width) {
+    return "scanline length does not match the image width";
+  }
+
+  uint64_t at = *cursor + 4u;
+  for (uint32_t channel = 0u; channel < 4u; ++channel) {
+    uint32_t x = 0u;
+    while (x < width) {
+      if (at >= size) {
+        return "truncated scanline";
+      }
+      uint32_t count = data[at++];
+      const bool8_t run = count > 128u;
+      count = run ? count - 128u : count;
+      if (count == 0u || count > width - x) {
+        return "run overflows the scanline";
+      }
+      if (size - at < (run ? 1u : count)) {
+        return "truncated scanline";
+      }
+      for (uint32_t i = 0u; i < count; ++i) {
+        out_rgbe[(x + i) * 4u + channel] = run ? data[at] : data[at + i];
+      }
+      at += run ? 1u : count;
+      x += count;
+    }
+  }
+  *cursor = at;
+  return NULL;
+}
+
+/**
+ * @brief Decodes a Radiance `.hdr` environment to RGBA16F.
+ *
+ * Scanlines go through the RGBE and half-float kernels one row at a time, so
+ * no full-size float copy of the image is ever held.
  */
 vkr_internal bool8_t vkr_texture_decode_hdr_image(
     const uint8_t *file_data, uint64_t file_size, const char *source_cstr,
     VkrTextureDecodeResult *out_result) {
-  if (!file_data || file_size == 0u || file_size > INT_MAX || !source_cstr ||
-      !out_result) {
+  if (!file_data || file_size == 0u || !source_cstr || !out_result) {
     if (out_result) {
       out_result->error = VKR_RENDERER_ERROR_INVALID_PARAMETER;
     }
@@ -2662,80 +2820,76 @@ vkr_internal bool8_t vkr_texture_decode_hdr_image(
 
   int32_t width = 0;
   int32_t height = 0;
-  int32_t source_channels = 0;
-  stbi_set_flip_vertically_on_load_thread(0);
-  float32_t *rgb =
-      stbi_loadf_from_memory(file_data, (int)file_size, &width, &height,
-                             &source_channels, VKR_TEXTURE_RGB_CHANNELS);
-  if (!rgb) {
-    const char *reason = stbi_failure_reason();
-    log_error("Failed to decode HDR texture '%s': %s", source_cstr,
-              reason ? reason : "unknown");
+  uint64_t cursor = 0u;
+  const char *reason = vkr_texture_rgbe_read_header(file_data, file_size,
+                                                    &cursor, &width, &height);
+  if (reason) {
+    log_error("Failed to decode HDR texture '%s': %s", source_cstr, reason);
     out_result->error = VKR_RENDERER_ERROR_RESOURCE_CREATION_FAILED;
     return false_v;
   }
 
-  uint16_t *rgba16 = NULL;
-  VkrTextureUploadRegion *upload_region = NULL;
-  bool8_t success = false_v;
   if (width <= 0 || height <= 0 || width > VKR_TEXTURE_MAX_DIMENSION ||
       height > VKR_TEXTURE_MAX_DIMENSION || width != height * 2) {
     log_error("HDR environment '%s' must have a positive 2:1 equirectangular "
               "extent (got %dx%d)",
               source_cstr, width, height);
     out_result->error = VKR_RENDERER_ERROR_INVALID_PARAMETER;
-    goto cleanup;
+    return false_v;
   }
 
   const uint64_t pixel_count = (uint64_t)width * (uint64_t)height;
   if (pixel_count > SIZE_MAX / (VKR_TEXTURE_RGBA_CHANNELS * sizeof(uint16_t))) {
     out_result->error = VKR_RENDERER_ERROR_OUT_OF_MEMORY;
-    goto cleanup;
+    return false_v;
   }
 
   const uint64_t upload_size =
       pixel_count * VKR_TEXTURE_RGBA_CHANNELS * sizeof(uint16_t);
-  rgba16 = (uint16_t *)malloc((size_t)upload_size);
-  upload_region =
+  uint16_t *rgba16 = (uint16_t *)malloc((size_t)upload_size);
+  VkrTextureUploadRegion *upload_region =
       (VkrTextureUploadRegion *)malloc(sizeof(VkrTextureUploadRegion));
-  if (!rgba16 || !upload_region) {
+  uint8_t *row_rgbe = (uint8_t *)malloc((size_t)width * 4u);
+  float32_t *row_rgb = (float32_t *)malloc(
+      (size_t)width * VKR_TEXTURE_RGB_CHANNELS * sizeof(float32_t));
+  bool8_t success = false_v;
+  if (!rgba16 || !upload_region || !row_rgbe || !row_rgb) {
     out_result->error = VKR_RENDERER_ERROR_OUT_OF_MEMORY;
     goto cleanup;
   }
 
-  uint64_t clamped_count = 0u;
-  float32_t observed_min = FLT_MAX;
-  float32_t observed_max = -FLT_MAX;
-  for (uint64_t pixel_index = 0; pixel_index < pixel_count; ++pixel_index) {
-    for (uint32_t channel = 0; channel < VKR_TEXTURE_RGB_CHANNELS; ++channel) {
-      float32_t value = rgb[pixel_index * VKR_TEXTURE_RGB_CHANNELS + channel];
-      if (!isfinite(value)) {
-        log_error("HDR environment '%s' contains a non-finite sample at "
-                  "pixel %llu channel %u",
-                  source_cstr, (unsigned long long)pixel_index, channel);
-        out_result->error = VKR_RENDERER_ERROR_INVALID_PARAMETER;
-        goto cleanup;
-      }
-      observed_min = Min(observed_min, value);
-      observed_max = Max(observed_max, value);
-      if (value < 0.0f) {
-        value = 0.0f;
-        clamped_count++;
-      } else if (value > 65504.0f) {
-        value = 65504.0f;
-        clamped_count++;
-      }
-      rgba16[pixel_index * VKR_TEXTURE_RGBA_CHANNELS + channel] =
-          vkr_float32_to_float16(value);
-    }
-    rgba16[pixel_index * VKR_TEXTURE_RGBA_CHANNELS + 3u] = 0x3c00u;
-  }
-
-  if (clamped_count > 0u) {
+  VkrTextureHdrConvertStats stats = {
+      .observed_min = FLT_MAX,
+      .observed_max = -FLT_MAX,
+  };
+  for (int32_t y = 0; y < height; ++y) {
+    reason = vkr_texture_rgbe_read_scanline(file_data, file_size, &cursor,
+                                            (uint32_t)width, row_rgbe);
+    if (reason) {
+      log_error("Failed to decode HDR texture '%s': row %d: %s", source_cstr,
+                y, reason);
+      out_result->error = VKR_RENDERER_ERROR_RESOURCE_CREATION_FAILED;
+      goto cleanup;
+    }
+    vkr_texture_convert_rgbe_to_rgb32f(row_rgbe, row_rgb, (uint64_t)width);
+
+    // RGBE tops out near 2^127, so every decoded sample is finite and the
+    // conversion cannot fail; it only clamps.
+    VkrTextureHdrConvertStats row_stats = {0};
+    vkr_texture_convert_rgb32f_to_rgba16f(
+        row_rgb,
+        rgba16 + (uint64_t)y * (uint64_t)width * VKR_TEXTURE_RGBA_CHANNELS,
+        (uint64_t)width, &row_stats);
+    stats.clamped_count += row_stats.clamped_count;
+    stats.observed_min = Min(stats.observed_min, row_stats.observed_min);
+    stats.observed_max = Max(stats.observed_max, row_stats.observed_max);
+  }
+
+  if (stats.clamped_count > 0u) {
     log_warn("HDR environment '%s' clamped %llu radiance samples to [0, "
              "65504] (observed finite min=%g max=%g)",
-             source_cstr, (unsigned long long)clamped_count,
-             (double)observed_min, (double)observed_max);
+             source_cstr, (unsigned long long)stats.clamped_count,
+             (double)stats.observed_min, (double)stats.observed_max);
   }
 
   *upload_region = (VkrTextureUploadRegion){
@@ -2757,7 +2911,7 @@ vkr_internal bool8_t vkr_texture_decode_hdr_image(
   out_result->upload_is_compressed = false_v;
   out_result->width = width;
   out_result->height = height;
-  out_result->original_channels = source_channels;
+  out_result->original_channels = VKR_TEXTURE_RGB_CHANNELS;
   out_result->has_transparency = false_v;
   out_result->alpha_mask = false_v;
   out_result->success = true_v;
@@ -2766,13 +2920,18 @@ vkr_internal bool8_t vkr_texture_decode_hdr_image(
   success = true_v;
 
 cleanup:
-  stbi_image_free(rgb);
   if (rgba16) {
     free(rgba16);
   }
   if (upload_region) {
     free(upload_region);
   }
+  if (row_rgbe) {
+    free(row_rgbe);
+  }
+  if (row_rgb) {
+    free(row_rgb);
+  }
   return success;
 }
 
@@ -2859,10 +3018,10 @@ vkr_internal bool8_t vkr_texture_decode_from_source_image(
 
   const uint64_t pixel_count =
       (uint64_t)out_result->width * (uint64_t)out_result->height;
-  VkrTextureAlphaAnalysis alpha = vkr_texture_analyze_alpha(
-      out_result->decoded_pixels, pixel_count, VKR_TEXTURE_RGBA_CHANNELS);
-  out_result->has_transparency = alpha.has_transparency;
-  out_result->alpha_mask = alpha.alpha_mask;
+  VkrTextureRgba8Analysis analysis = {0};
+  vkr_texture_analyze_rgba8(out_result->decoded_pixels, pixel_count,
+                            &analysis);
+  vkr_texture_decode_result_apply_analysis(out_result, &analysis);
 
   if (allow_cache_write && sidecar_cache_path.str) {
     VkrTextureCacheWriteGuard *cache_guard =
@@ -2876,8 +3035,7 @@ vkr_internal bool8_t vkr_texture_decode_from_source_image(
       vkr_texture_cache_write(
           allocator, sidecar_cache_path, source_stats.last_modified,
           (uint32_t)out_result->width, (uint32_t)out_result->height,
-          VKR_TEXTURE_RGBA_CHANNELS, out_result->has_transparency,
-          out_result->decoded_pixels);
+          VKR_TEXTURE_RGBA_CHANNELS, &analysis, out_result->decoded_pixels);
       if (cache_guard && cache_guard_key) {
         vkr_texture_cache_guard_release(cache_guard, cache_guard_key);
       }
@@ -3087,6 +3245,12 @@ vkr_internal bool8_t vkr_texture_decode_job_run(VkrJobContext *ctx,
       sidecar_path_for_write, allow_sidecar_cache_write, source_cstr, result);
 }
 
+void vkr_texture_system_set_streaming(VkrTextureSystem *system,
+                                      struct VkrTextureStreaming *streaming) {
+  assert_log(system != NULL, "System is NULL");
+  system->streaming = streaming;
+}
+
 void vkr_texture_system_release_prepared_load(
     VkrTexturePreparedLoad *prepared) {
   if (!prepared) {
@@ -3189,6 +3353,29 @@ bool8_t vkr_texture_system_prepare_load_from_file(
         vkr_texture_format_from_channels(actual_channels, request.colorspace);
   }
 
+  if (!has_upload_payload) {
+    // Only class the texture as a normal map when the request said so; a
+    // sky-blue color texture can pass the per-pixel test too.
+    if (!request.has_explicit_class &&
+        request.texture_class != VKR_TEXTURE_CLASS_NORMAL_RG &&
+        !decode_result.is_constant_color &&
+        decode_result.normal_likelihood >=
+            VKR_TEXTURE_NORMAL_LIKELIHOOD_WARN_THRESHOLD) {
+      log_warn("Texture '%.*s' decodes like a tangent-space normal map; add "
+               "`?tc=normal` if it is one",
+               (int32_t)base_path.length, base_path.str);
+    }
+
+    // Constant material data reads the same texel at every UV, so one texel
+    // is enough. Color classes keep their size for UI and environment users.
+    if (decode_result.is_constant_color &&
+        (request.texture_class == VKR_TEXTURE_CLASS_NORMAL_RG ||
+         request.texture_class == VKR_TEXTURE_CLASS_DATA_MASK)) {
+      width = 1;
+      height = 1;
+    }
+  }
+
   VkrTexturePropertyFlags props = vkr_texture_property_flags_create();
   if (decode_result.has_transparency) {
     bitset8_set(&props, VKR_TEXTURE_PROPERTY_HAS_TRANSPARENCY_BIT);
@@ -3341,8 +3528,15 @@ bool8_t vkr_texture_system_finalize_prepared_load(
       .generation = texture->description.generation,
   };
   VkrRendererError renderer_error = VKR_RENDERER_ERROR_NONE;
-  if (!vkr_texture_system_publish_prepared(system, logical_handle, prepared,
-                                           &texture->handle, &renderer_error)) {
+  // A streamed texture publishes only its tail; if the streamer cannot take
+  // it, the full chain is published as before.
+  if (system->streaming &&
+      vkr_texture_streaming_register(system->streaming, logical_handle,
+                                     prepared)) {
+    texture->handle = (VkrTextureOpaqueHandle)texture;
+  } else if (!vkr_texture_system_publish_prepared(system, logical_handle,
+                                                  prepared, &texture->handle,
+                                                  &renderer_error)) {
     vkr_allocator_free(&system->string_allocator, stable_key, name.length + 1,
                        VKR_ALLOCATOR_MEMORY_TAG_STRING);
     MemZero(texture, sizeof(*texture));
@@ -9,6 +9,8 @@
 #include "renderer/vkr_asset_publisher.h"
 #include "renderer/vkr_renderer.h"
 
+struct VkrTextureStreaming;
+
 // todo: should we merge this with material system, since
 // textures are only used by materials?
 
@@ -80,6 +82,7 @@ typedef struct VkrTextureSystem {
   VkrJobSystem *job_system;                      // For async texture loading
   struct VkrTextureCacheWriteGuard *cache_guard; // Internal cache write guard
   VkrMetricEventProducer hdr_decode_metrics;
+  struct VkrTextureStreaming *streaming; // Mip residency; NULL loads full
 
   // Device-dependent transcode policy inputs for KTX2/UASTC decode.
   VkrDeviceTypeFlags device_types;   // Device type bits used as preference hint
@@ -380,6 +383,18 @@ bool8_t vkr_texture_system_finalize_prepared_load(
     const VkrTexturePreparedLoad *prepared, VkrTextureHandle *out_handle,
     VkrRendererError *out_error);
 
+/**
+ * @brief Routes subsequently finalized mip-chained textures through
+ * `streaming`.
+ *
+ * Such textures publish only their low-resolution tail and are upgraded by
+ * vkr_texture_streaming_update(). Textures that do not qualify, and every
+ * texture while `streaming` is NULL, publish their full chain. `streaming`
+ * must outlive every texture registered with it.
+ */
+void vkr_texture_system_set_streaming(VkrTextureSystem *system,
+                                      struct VkrTextureStreaming *streaming);
+
 /**
  * @brief Releases CPU memory owned by a prepared texture payload.
  */
@@ -0,0 +1,355 @@
+/**
+ * @file vkr_ui_batcher.c
+ * @brief Retained UI text batching over a persistent vertex arena.
+ */
+
+#include "renderer/systems/vkr_ui_batcher.h"
+
+#include "core/logger.h"
+#include "renderer/vkr_render_packet.h"
+
+vkr_internal bool8_t vkr_ui_batcher_model_is_flat(const Mat4 *model) {
+  // Arena vertices only keep x/y, so the model must leave z at zero and w at
+  // one for every point on the z = 0 plane.
+  return model->cols[0].z == 0.0f && model->cols[1].z == 0.0f &&
+         model->cols[3].z == 0.0f && model->cols[0].w == 0.0f &&
+         model->cols[1].w == 0.0f && model->cols[3].w == 1.0f;
+}
+
+vkr_internal bool8_t vkr_ui_batcher_same_key(const VkrUiBatchWidget *a,
+                                             const VkrUiBatchWidget *b) {
+  return a->atlas.id == b->atlas.id &&
+         a->atlas.generation == b->atlas.generation &&
+         a->font_mode == b->font_mode &&
+         a->screen_px_range == b->screen_px_range;
+}
+
+vkr_internal bool8_t vkr_ui_batcher_reserve(VkrUiBatcher *batcher,
+                                            VkrUiBatchArena *arena,
+                                            uint32_t vertex_count,
+                                            uint32_t index_count) {
+  // Callers only reserve an arena whose contents are about to be rewritten,
+  // so growth frees instead of copying.
+  if (vertex_count > arena->vertex_capacity) {
+    uint32_t capacity = Max(arena->vertex_capacity * 2u, 256u);
+    capacity = Max(capacity, vertex_count);
+    VkrTextVertex *vertices = vkr_allocator_alloc(
+        batcher->allocator, sizeof(VkrTextVertex) * (uint64_t)capacity,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (!vertices) {
+      return false_v;
+    }
+    if (arena->vertices) {
+      vkr_allocator_free(batcher->allocator, arena->vertices,
+                         sizeof(VkrTextVertex) *
+                             (uint64_t)arena->vertex_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    arena->vertices = vertices;
+    arena->vertex_capacity = capacity;
+  }
+  if (index_count > arena->index_capacity) {
+    uint32_t capacity = Max(arena->index_capacity * 2u, 384u);
+    capacity = Max(capacity, index_count);
+    uint32_t *indices = vkr_allocator_alloc(
+        batcher->allocator, sizeof(uint32_t) * (uint64_t)capacity,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (!indices) {
+      return false_v;
+    }
+    if (arena->indices) {
+      vkr_allocator_free(batcher->allocator, arena->indices,
+                         sizeof(uint32_t) * (uint64_t)arena->index_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    arena->indices = indices;
+    arena->index_capacity = capacity;
+  }
+  return true_v;
+}
+
+vkr_internal void vkr_ui_batcher_write_vertices(VkrTextVertex *dst,
+                                                const VkrTextVertex *src,
+                                                uint32_t count,
+                                                const Mat4 *model) {
+  const Vec4 c0 = model->cols[0];
+  const Vec4 c1 = model->cols[1];
+  const Vec4 c3 = model->cols[3];
+  for (uint32_t i = 0; i < count; ++i) {
+    const Vec2 p = src[i].position;
+    dst[i] = src[i];
+    dst[i].position.x = c0.x * p.x + c1.x * p.y + c3.x;
+    dst[i].position.y = c0.y * p.x + c1.y * p.y + c3.y;
+  }
+}
+
+bool8_t vkr_ui_batcher_create(VkrUiBatcher *batcher, VkrAllocator *allocator,
+                              uint32_t max_widgets) {
+  if (!batcher || !allocator || max_widgets == 0) {
+    return false_v;
+  }
+  MemZero(batcher, sizeof(*batcher));
+  batcher->allocator = allocator;
+  batcher->max_widgets = max_widgets;
+  batcher->widgets = vkr_allocator_alloc(
+      allocator, sizeof(VkrUiBatchWidget) * (uint64_t)max_widgets,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  batcher->scratch = vkr_allocator_alloc(
+      allocator, sizeof(VkrUiBatchWidget) * (uint64_t)max_widgets,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  batcher->dirty = vkr_allocator_alloc(
+      allocator, sizeof(bool8_t) * (uint64_t)max_widgets,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  batcher->draws = vkr_allocator_alloc(
+      allocator, sizeof(VkrPreparedTextDraw) * (uint64_t)max_widgets,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!batcher->widgets || !batcher->scratch || !batcher->dirty ||
+      !batcher->draws) {
+    vkr_ui_batcher_destroy(batcher);
+    return false_v;
+  }
+  return true_v;
+}
+
+void vkr_ui_batcher_destroy(VkrUiBatcher *batcher) {
+  if (!batcher || !batcher->allocator) {
+    return;
+  }
+  VkrAllocator *allocator = batcher->allocator;
+  for (uint32_t i = 0; i < ArrayCount(batcher->arenas); ++i) {
+    VkrUiBatchArena *arena = &batcher->arenas[i];
+    if (arena->vertices) {
+      vkr_allocator_free(allocator, arena->vertices,
+                         sizeof(VkrTextVertex) *
+                             (uint64_t)arena->vertex_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+    if (arena->indices) {
+      vkr_allocator_free(allocator, arena->indices,
+                         sizeof(uint32_t) * (uint64_t)arena->index_capacity,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    }
+  }
+  if (batcher->widgets) {
+    vkr_allocator_free(allocator, batcher->widgets,
+                       sizeof(VkrUiBatchWidget) *
+                           (uint64_t)batcher->max_widgets,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (batcher->scratch) {
+    vkr_allocator_free(allocator, batcher->scratch,
+                       sizeof(VkrUiBatchWidget) *
+                           (uint64_t)batcher->max_widgets,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (batcher->dirty) {
+    vkr_allocator_free(allocator, batcher->dirty,
+                       sizeof(bool8_t) * (uint64_t)batcher->max_widgets,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if (batcher->draws) {
+    vkr_allocator_free(allocator, batcher->draws,
+                       sizeof(VkrPreparedTextDraw) *
+                           (uint64_t)batcher->max_widgets,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(batcher, sizeof(*batcher));
+}
+
+uint32_t vkr_ui_batcher_build(VkrUiBatcher *batcher,
+                              const VkrPreparedTextDraw *widgets,
+                              uint32_t widget_count, bool8_t batched,
+                              VkrPreparedTextDraw *out_draws,
+                              uint32_t capacity,
+                              VkrUiBatchMetrics *out_metrics) {
+  if (out_metrics) {
+    MemZero(out_metrics, sizeof(*out_metrics));
+  }
+  if (!batcher || !batcher->widgets || (widget_count > 0 && !widgets) ||
+      !out_draws) {
+    return 0;
+  }
+  if (widget_count > batcher->max_widgets) {
+    log_error("UI batcher widget capacity exceeded (%u)", batcher->max_widgets);
+    widget_count = batcher->max_widgets;
+  }
+
+  VkrUiBatchMetrics metrics = {.text_widgets = widget_count};
+
+  /* Lay the frame's widgets out in draw order. A widget keeps its arena
+     bytes when its identity, revision, model and counts all match the record
+     at the same position; anything else is rewritten. */
+  VkrUiBatchWidget *next = batcher->scratch;
+  bool8_t *dirty = batcher->dirty;
+  bool8_t layout_changed = widget_count != batcher->widget_count;
+  bool8_t keys_changed = layout_changed;
+  uint32_t vertex_total = 0;
+  uint32_t index_total = 0;
+  for (uint32_t i = 0; i < widget_count; ++i) {
+    const VkrPreparedTextDraw *src = &widgets[i];
+    VkrUiBatchWidget *widget = &next[i];
+    *widget = (VkrUiBatchWidget){
+        .object_id = src->object_id,
+        .revision = src->revision,
+        .model = src->model,
+        .atlas = src->atlas,
+        .screen_px_range = src->screen_px_range,
+        .font_mode = src->font_mode,
+        .retained = vkr_ui_batcher_model_is_flat(&src->model),
+        .vertex_offset = vertex_total,
+        .index_offset = index_total,
+    };
+    if (widget->retained) {
+      widget->vertex_count = src->vertex_count;
+      widget->index_count = src->index_count;
+      vertex_total += src->vertex_count;
+      index_total += src->index_count;
+    }
+
+    dirty[i] = true_v;
+    if (i < batcher->widget_count) {
+      const VkrUiBatchWidget *prev = &batcher->widgets[i];
+      dirty[i] = prev->object_id != widget->object_id ||
+                 prev->revision != widget->revision ||
+                 prev->retained != widget->retained ||
+                 prev->vertex_count != widget->vertex_count ||
+                 prev->index_count != widget->index_count ||
+                 MemCompare(&prev->model, &widget->model, sizeof(Mat4)) != 0;
+      if (prev->vertex_offset != widget->vertex_offset ||
+          prev->index_offset != widget->index_offset) {
+        layout_changed = true_v;
+      }
+      if (!vkr_ui_batcher_same_key(prev, widget)) {
+        keys_changed = true_v;
+      }
+    }
+  }
+
+  // A widget's batch-relative base depends on its neighbours' keys, so it is
+  // resolved before deciding which index ranges need rewriting.
+  for (uint32_t i = 0; i < widget_count; ++i) {
+    VkrUiBatchWidget *widget = &next[i];
+    if (!widget->retained) {
+      continue;
+    }
+    const VkrUiBatchWidget *prev = i > 0 ? &next[i - 1] : NULL;
+    if (prev && prev->retained && vkr_ui_batcher_same_key(prev, widget)) {
+      widget->batch_base = prev->batch_base + prev->vertex_count;
+    }
+  }
+
+  VkrUiBatchArena *source = &batcher->arenas[batcher->active];
+  VkrUiBatchArena *target = source;
+  if (layout_changed) {
+    target = &batcher->arenas[batcher->active ^ 1u];
+  }
+  if (!vkr_ui_batcher_reserve(batcher, target, vertex_total, index_total)) {
+    log_error("UI batcher failed to grow its arena");
+    batcher->widget_count = 0;
+    batcher->draws_valid = false_v;
+    return 0;
+  }
+
+  bool8_t arena_changed = layout_changed;
+  for (uint32_t i = 0; i < widget_count; ++i) {
+    const VkrUiBatchWidget *widget = &next[i];
+    if (!widget->retained) {
+      continue;
+    }
+    const VkrUiBatchWidget *prev =
+        i < batcher->widget_count ? &batcher->widgets[i] : NULL;
+    VkrTextVertex *vertices = target->vertices + widget->vertex_offset;
+    uint32_t *indices = target->indices + widget->index_offset;
+    if (dirty[i]) {
+      vkr_ui_batcher_write_vertices(vertices, widgets[i].vertices,
+                                    widget->vertex_count, &widget->model);
+      metrics.widgets_rebuilt++;
+      metrics.rebuilt_bytes +=
+          sizeof(VkrTextVertex) * (uint64_t)widget->vertex_count;
+      arena_changed = true_v;
+    } else if (target != source) {
+      MemCopy(vertices, source->vertices + prev->vertex_offset,
+              sizeof(VkrTextVertex) * (uint64_t)widget->vertex_count);
+    }
+
+    if (dirty[i] || prev->batch_base != widget->batch_base) {
+      const uint32_t *local = widgets[i].indices;
+      for (uint32_t j = 0; j < widget->index_count; ++j) {
+        indices[j] = local[j] + widget->batch_base;
+      }
+      metrics.rebuilt_bytes += sizeof(uint32_t) * (uint64_t)widget->index_count;
+      arena_changed = true_v;
+    } else if (target != source) {
+      MemCopy(indices, source->indices + prev->index_offset,
+              sizeof(uint32_t) * (uint64_t)widget->index_count);
+    }
+  }
+  if (target != source) {
+    batcher->active ^= 1u;
+  }
+  if (arena_changed) {
+    batcher->revision++;
+  }
+
+  batcher->scratch = batcher->widgets;
+  batcher->widgets = next;
+  batcher->widget_count = widget_count;
+
+  /* Nothing moved and no widget changed key: last frame's batched draws still
+     describe the arena exactly. Draws that borrow widget geometry (unbatched
+     indices, unretained widgets) are re-emitted every frame regardless. */
+  bool8_t has_unretained = false_v;
+  for (uint32_t i = 0; i < widget_count; ++i) {
+    has_unretained |= !next[i].retained;
+  }
+  if (!batched || !batcher->draws_valid || !batcher->draws_batched ||
+      arena_changed || keys_changed || has_unretained) {
+    const VkrUiBatchArena *arena = &batcher->arenas[batcher->active];
+    uint32_t draw_count = 0;
+    for (uint32_t i = 0; i < widget_count; ++i) {
+      const VkrUiBatchWidget *widget = &next[i];
+      if (!widget->retained) {
+        batcher->draws[draw_count++] = widgets[i];
+        continue;
+      }
+      if (widget->vertex_count == 0) {
+        continue;
+      }
+      if (batched && widget->batch_base > 0) {
+        VkrPreparedTextDraw *draw = &batcher->draws[draw_count - 1];
+        draw->vertex_count += widget->vertex_count;
+        draw->index_count += widget->index_count;
+        draw->max_index = draw->vertex_count - 1u;
+        continue;
+      }
+      batcher->draws[draw_count++] = (VkrPreparedTextDraw){
+          .vertices = arena->vertices + widget->vertex_offset,
+          .vertex_count = widget->vertex_count,
+          // Unbatched draws keep the widget's local indices, which address
+          // the same vertices relative to the widget's own offset.
+          .indices = batched ? arena->indices + widget->index_offset
+                             : widgets[i].indices,
+          .index_count = widget->index_count,
+          .max_index = widget->vertex_count - 1u,
+          .atlas = widget->atlas,
+          .model = mat4_identity(),
+          .screen_px_range = widget->screen_px_range,
+          .font_mode = widget->font_mode,
+          .object_id = widget->object_id,
+          .revision = batcher->revision,
+      };
+    }
+    batcher->draw_count = draw_count;
+    batcher->draws_batched = batched;
+    batcher->draws_valid = true_v;
+  }
+
+  const uint32_t count = Min(batcher->draw_count, capacity);
+  MemCopy(out_draws, batcher->draws,
+          sizeof(VkrPreparedTextDraw) * (uint64_t)count);
+  metrics.draw_calls = count;
+  if (out_metrics) {
+    *out_metrics = metrics;
+  }
+  return count;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file vkr_ui_batcher.h
+ * @brief Retained UI text batching over a persistent vertex arena.
+ *
+ * The batcher keeps every widget's quads in one CPU arena, packed in draw
+ * order and already transformed by the widget's model matrix. A widget's
+ * range is rewritten only when its geometry revision or model changes, so a
+ * frame that edits one label touches that label's bytes and nothing else.
+ *
+ * Because arena vertices live in a shared space, widgets that are adjacent in
+ * draw order and sample the same atlas with the same font parameters collapse
+ * into one indexed draw with an identity model. Draw order is preserved: a
+ * widget with a different key, or one whose model cannot be flattened into
+ * 2D positions, ends the current batch.
+ *
+ * Picking needs one object id per widget, so callers request unbatched output
+ * on frames that resolve a pick. Unbatched draws still read from the arena.
+ */
+#pragma once
+
+#include "defines.h"
+#include "math/mat.h"
+#include "memory/vkr_allocator.h"
+#include "renderer/resources/vkr_resources.h"
+#include "renderer/vkr_buffer.h"
+
+typedef struct VkrPreparedTextDraw VkrPreparedTextDraw;
+
+/** Counters for the most recent build. */
+typedef struct VkrUiBatchMetrics {
+  uint32_t text_widgets;
+  /** Widgets whose arena range was rewritten this frame. */
+  uint32_t widgets_rebuilt;
+  uint32_t draw_calls;
+  /** Vertex and index bytes rewritten this frame, excluding moved ranges. */
+  uint64_t rebuilt_bytes;
+} VkrUiBatchMetrics;
+
+typedef struct VkrUiBatchWidget {
+  uint32_t object_id;
+  uint32_t revision;
+  Mat4 model;
+  VkrTextureHandle atlas;
+  float32_t screen_px_range;
+  uint32_t font_mode;
+  /** False when the model is not a 2D affine map; the widget bypasses us. */
+  bool8_t retained;
+  uint32_t vertex_offset;
+  uint32_t vertex_count;
+  uint32_t index_offset;
+  uint32_t index_count;
+  /** Vertex offset of this widget within its batch, baked into its indices. */
+  uint32_t batch_base;
+} VkrUiBatchWidget;
+
+typedef struct VkrUiBatchArena {
+  VkrTextVertex *vertices;
+  uint32_t vertex_capacity;
+  uint32_t *indices;
+  uint32_t index_capacity;
+} VkrUiBatchArena;
+
+typedef struct VkrUiBatcher {
+  VkrAllocator *allocator;
+  uint32_t max_widgets;
+  VkrUiBatchWidget *widgets;
+  uint32_t widget_count;
+  /** Next frame's records while building; swapped with `widgets` after. */
+  VkrUiBatchWidget *scratch;
+  bool8_t *dirty;
+  /**
+   * Two arenas so a layout change can copy clean ranges to their new offsets
+   * without overlapping moves; `active` names the one the draws borrow.
+   */
+  VkrUiBatchArena arenas[2];
+  uint32_t active;
+  VkrPreparedTextDraw *draws;
+  uint32_t draw_count;
+  bool8_t draws_batched;
+  bool8_t draws_valid;
+  /** Bumped whenever borrowed arena bytes change. */
+  uint32_t revision;
+} VkrUiBatcher;
+
+bool8_t vkr_ui_batcher_create(VkrUiBatcher *batcher, VkrAllocator *allocator,
+                              uint32_t max_widgets);
+
+void vkr_ui_batcher_destroy(VkrUiBatcher *batcher);
+
+/**
+ * @brief Updates the arena from this frame's per-widget draws and emits the
+ * draws to record.
+ *
+ * `widgets` are unbatched draws in draw order; `object_id` identifies a
+ * widget across frames and `revision` must change whenever its geometry
+ * does. The emitted draws borrow the batcher's arena until the next build.
+ * `out_draws` may alias `widgets`; it is written only after every widget has
+ * been read.
+ * @return The number of draws written to `out_draws`.
+ */
+uint32_t vkr_ui_batcher_build(VkrUiBatcher *batcher,
+                              const VkrPreparedTextDraw *widgets,
+                              uint32_t widget_count, bool8_t batched,
+                              VkrPreparedTextDraw *out_draws,
+                              uint32_t capacity,
+                              VkrUiBatchMetrics *out_metrics);
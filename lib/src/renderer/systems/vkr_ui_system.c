@@ -171,6 +171,11 @@ bool8_t vkr_ui_system_init(RendererFrontend *rf, VkrUiSystem *system) {
   }
   MemZero(system->text_slots.data,
           sizeof(VkrUiTextSlot) * (uint64_t)system->text_slots.length);
+  if (!vkr_ui_batcher_create(&system->batcher, &rf->allocator,
+                             VKR_UI_SYSTEM_MAX_TEXTS)) {
+    array_destroy_VkrUiTextSlot(&system->text_slots);
+    return false_v;
+  }
   system->screen_width = rf->last_window_width;
   system->screen_height = rf->last_window_height;
   system->initialized = true_v;
@@ -190,6 +195,7 @@ void vkr_ui_system_shutdown(RendererFrontend *rf, VkrUiSystem *system) {
     }
   }
   array_destroy_VkrUiTextSlot(&system->text_slots);
+  vkr_ui_batcher_destroy(&system->batcher);
 
   system->initialized = false_v;
 }
@@ -330,7 +336,8 @@ bool8_t vkr_ui_system_text_destroy(RendererFrontend *rf, VkrUiSystem *system,
 uint32_t vkr_ui_system_prepare_text_draws(RendererFrontend *rf,
                                           VkrUiSystem *system,
                                           VkrPreparedTextDraw *out_draws,
-                                          uint32_t capacity) {
+                                          uint32_t capacity, bool8_t batched,
+                                          VkrUiBatchMetrics *out_metrics) {
   vkr_ui_system_refresh_layout(rf, system);
   uint32_t count = 0;
   for (uint64_t i = 0; i < system->text_slots.length; ++i) {
@@ -371,5 +378,8 @@ uint32_t vkr_ui_system_prepare_text_draws(RendererFrontend *rf,
         .revision = slot->text.geometry.revision,
     };
   }
-  return count;
+  // The per-slot draws above become the batcher's input and are replaced in
+  // place by the draws that borrow its arena.
+  return vkr_ui_batcher_build(&system->batcher, out_draws, count, batched,
+                              out_draws, capacity, out_metrics);
 }
@@ -11,6 +11,7 @@
 #include "defines.h"
 #include "math/vec.h"
 #include "renderer/resources/ui/vkr_ui_text.h"
+#include "renderer/systems/vkr_ui_batcher.h"
 #include "renderer/vkr_renderer.h"
 
 struct s_RendererFrontend;
@@ -45,6 +46,7 @@ typedef struct VkrUiSystem {
   uint32_t screen_height;    /**< Last layout height used */
 
   Array_VkrUiTextSlot text_slots; /**< Allocated text slots */
+  VkrUiBatcher batcher;           /**< Retained arena the text draws borrow */
   bool8_t initialized;            /**< System has been initialized */
 } VkrUiSystem;
 
@@ -131,8 +133,15 @@ bool8_t vkr_ui_system_text_update(struct s_RendererFrontend *rf,
 bool8_t vkr_ui_system_text_destroy(struct s_RendererFrontend *rf,
                                    VkrUiSystem *system, uint32_t text_id);
 
-/** Builds packet-ready UI text descriptors without issuing GPU commands. */
+/**
+ * @brief Builds packet-ready UI text descriptors without issuing GPU commands.
+ *
+ * Text sharing an atlas is merged into batched draws unless `batched` is
+ * false, which frames resolving a pick request so each draw keeps its own
+ * object id.
+ */
 uint32_t vkr_ui_system_prepare_text_draws(struct s_RendererFrontend *rf,
                                           VkrUiSystem *system,
                                           VkrPreparedTextDraw *out_draws,
-                                          uint32_t capacity);
+                                          uint32_t capacity, bool8_t batched,
+                                          VkrUiBatchMetrics *out_metrics);
@@ -6,6 +6,7 @@
 #include "renderer/systems/vkr_world_resources.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "containers/str.h"
 #include "core/logger.h"
@@ -13,16 +14,20 @@
 #include "math/vec.h"
 #include "math/vkr_math.h"
 #include "math/vkr_transform.h"
+#include "memory/vkr_arena_allocator.h"
 #include "renderer/renderer_frontend.h"
 #include "renderer/systems/vkr_picking_ids.h"
 #include "renderer/systems/vkr_scene_system.h"
+#include "renderer/vkr_ibl_bake.h"
 #include "renderer/vkr_ibl_math.h"
 #include "renderer/vkr_render_packet.h"
+#include "renderer/vkr_texture_convert.h"
 
 #define VKR_WORLD_RESOURCES_MAX_TEXTS 16
 #define VKR_WORLD_RESOURCES_IBL_IRRADIANCE_SIZE VKR_IBL_IRRADIANCE_SIZE
 #define VKR_WORLD_RESOURCES_IBL_PREFILTER_SIZE VKR_IBL_PREFILTER_SIZE
 #define VKR_WORLD_RESOURCES_IBL_BRDF_SIZE VKR_IBL_BRDF_SIZE
+#define VKR_WORLD_RESOURCES_IBL_CACHE_EXT ".vkibl"
 #define VKR_WORLD_RESOURCES_IBL_RENDERPASS_NAME                                \
   "Renderpass.Builtin.IBL.Convolution"
 
@@ -120,14 +125,9 @@ vkr_world_resources_ibl_mip_limit(const VkrWorldResources *resources) {
                    : 0u;
 }
 
-vkr_internal bool8_t vkr_world_resources_create_writable_cube_texture(
-    RendererFrontend *rf, String8 name, uint32_t size, bool8_t with_mips,
-    VkrTextureFormat format, VkrTextureHandle *out_handle) {
-  if (!rf || !name.str || !out_handle || size == 0) {
-    return false_v;
-  }
-
-  VkrTextureDescription desc = {
+vkr_internal VkrTextureDescription vkr_world_resources_cube_description(
+    uint32_t size, bool8_t with_mips, VkrTextureFormat format) {
+  return (VkrTextureDescription){
       .width = size,
       .height = size,
       .channels = 4,
@@ -144,6 +144,17 @@ vkr_internal bool8_t vkr_world_resources_create_writable_cube_texture(
       .mip_filter = with_mips ? VKR_MIP_FILTER_LINEAR : VKR_MIP_FILTER_NONE,
       .anisotropy_enable = false_v,
   };
+}
+
+vkr_internal bool8_t vkr_world_resources_create_writable_cube_texture(
+    RendererFrontend *rf, String8 name, uint32_t size, bool8_t with_mips,
+    VkrTextureFormat format, VkrTextureHandle *out_handle) {
+  if (!rf || !name.str || !out_handle || size == 0) {
+    return false_v;
+  }
+
+  VkrTextureDescription desc =
+      vkr_world_resources_cube_description(size, with_mips, format);
 
   VkrRendererError texture_err = VKR_RENDERER_ERROR_NONE;
   if (!vkr_texture_system_create_writable(&rf->texture_system, name, &desc,
@@ -358,6 +369,15 @@ vkr_world_resources_fail_scene_environment(RendererFrontend *rf,
   environment->bake_state = VKR_SCENE_ENV_BAKE_STATE_FAILED;
 }
 
+vkr_internal String8 vkr_world_resources_scene_ibl_name(char *storage,
+                                                        uint64_t size,
+                                                        const VkrScene *scene,
+                                                        const char *target) {
+  snprintf(storage, size, "__ibl.scene.%p.%s", (const void *)scene, target);
+  return string8_create_from_cstr((const uint8_t *)storage,
+                                  string_length(storage));
+}
+
 vkr_internal bool8_t vkr_world_resources_prepare_published_environment(
     RendererFrontend *rf, VkrWorldResources *resources, VkrScene *scene) {
   VkrSceneEnvironment *environment = &scene->environment;
@@ -392,20 +412,14 @@ vkr_internal bool8_t vkr_world_resources_prepare_published_environment(
   char source_name_storage[128];
   char irradiance_name_storage[128];
   char prefilter_name_storage[128];
-  snprintf(source_name_storage, sizeof(source_name_storage),
-           "__ibl.scene.%p.source", (void *)scene);
-  snprintf(irradiance_name_storage, sizeof(irradiance_name_storage),
-           "__ibl.scene.%p.irradiance", (void *)scene);
-  snprintf(prefilter_name_storage, sizeof(prefilter_name_storage),
-           "__ibl.scene.%p.prefilter", (void *)scene);
-  const String8 source_name = string8_create_from_cstr(
-      (const uint8_t *)source_name_storage, string_length(source_name_storage));
-  const String8 irradiance_name =
-      string8_create_from_cstr((const uint8_t *)irradiance_name_storage,
-                               string_length(irradiance_name_storage));
-  const String8 prefilter_name =
-      string8_create_from_cstr((const uint8_t *)prefilter_name_storage,
-                               string_length(prefilter_name_storage));
+  const String8 source_name = vkr_world_resources_scene_ibl_name(
+      source_name_storage, sizeof(source_name_storage), scene, "source");
+  const String8 irradiance_name = vkr_world_resources_scene_ibl_name(
+      irradiance_name_storage, sizeof(irradiance_name_storage), scene,
+      "irradiance");
+  const String8 prefilter_name = vkr_world_resources_scene_ibl_name(
+      prefilter_name_storage, sizeof(prefilter_name_storage), scene,
+      "prefilter");
 
   if ((environment->source_kind == VKR_SCENE_ENV_SOURCE_EQUIRECT &&
        !vkr_world_resources_create_writable_cube_texture(
@@ -459,6 +473,265 @@ bool8_t vkr_world_resources_prepare_scene_environment(
                                                            scene);
 }
 
+/**
+ * Box-filters mip 0 of an RGBA16F equirect down to four texels per cube face
+ * texel across, as much detail as the cube resampling can use, into RGBA
+ * floats.
+ */
+vkr_internal float32_t *vkr_world_resources_downsample_equirect(
+    const VkrTexturePreparedLoad *equirect, uint32_t face_size,
+    VkrAllocator *allocator, uint32_t *out_width, uint32_t *out_height) {
+  const uint32_t width = equirect->description.width;
+  const uint32_t height = equirect->description.height;
+  const VkrTextureUploadRegion *base = NULL;
+  for (uint32_t i = 0; i < equirect->upload_region_count; ++i) {
+    const VkrTextureUploadRegion *region = &equirect->upload_regions[i];
+    if (region->mip_level == 0u && region->array_layer == 0u) {
+      base = region;
+      break;
+    }
+  }
+  const uint64_t row_floats = (uint64_t)width * 4u;
+  if (!base || base->width != width || base->height != height ||
+      base->byte_offset > equirect->upload_data_size ||
+      base->byte_size > equirect->upload_data_size - base->byte_offset ||
+      base->byte_size < row_floats * height * sizeof(uint16_t)) {
+    return NULL;
+  }
+
+  const uint32_t target_width = Min(width, face_size * 4u);
+  const uint32_t target_height =
+      Max((uint32_t)((uint64_t)target_width * height / width), 1u);
+  float32_t *rgba = vkr_allocator_alloc(
+      allocator,
+      sizeof(float32_t) * (uint64_t)target_width * target_height * 4u,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  float32_t *row =
+      vkr_allocator_alloc(allocator, sizeof(float32_t) * row_floats,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!rgba || !row) {
+    return NULL;
+  }
+
+  const uint16_t *texels =
+      (const uint16_t *)(equirect->upload_data + base->byte_offset);
+  for (uint32_t y = 0; y < target_height; ++y) {
+    const uint32_t y0 = (uint32_t)((uint64_t)y * height / target_height);
+    const uint32_t y1 = (uint32_t)((uint64_t)(y + 1u) * height / target_height);
+    float32_t *dst = rgba + (uint64_t)y * target_width * 4u;
+    MemZero(dst, sizeof(float32_t) * target_width * 4u);
+    for (uint32_t source_y = y0; source_y < y1; ++source_y) {
+      vkr_texture_convert_f16_to_f32(texels + source_y * row_floats, row,
+                                     row_floats);
+      for (uint32_t x = 0; x < target_width; ++x) {
+        const uint32_t x0 = (uint32_t)((uint64_t)x * width / target_width);
+        const uint32_t x1 =
+            (uint32_t)((uint64_t)(x + 1u) * width / target_width);
+        for (uint32_t source_x = x0; source_x < x1; ++source_x) {
+          for (uint32_t c = 0; c < 4u; ++c) {
+            dst[x * 4u + c] += row[source_x * 4u + c];
+          }
+        }
+      }
+    }
+    for (uint32_t x = 0; x < target_width; ++x) {
+      const uint32_t x0 = (uint32_t)((uint64_t)x * width / target_width);
+      const uint32_t x1 = (uint32_t)((uint64_t)(x + 1u) * width / target_width);
+      const float32_t weight = 1.0f / (float32_t)((y1 - y0) * (x1 - x0));
+      for (uint32_t c = 0; c < 4u; ++c) {
+        dst[x * 4u + c] *= weight;
+      }
+    }
+  }
+
+  *out_width = target_width;
+  *out_height = target_height;
+  return rgba;
+}
+
+/** Publishes `cube` as an RGBA16F cube texture and takes a reference on it. */
+vkr_internal bool8_t vkr_world_resources_publish_ibl_cube(
+    RendererFrontend *rf, String8 name, const VkrIblCube *cube,
+    VkrTextureHandle *out_handle) {
+  const uint64_t texel_count =
+      vkr_ibl_cube_texel_count(cube->face_size, cube->mip_count);
+  const uint32_t region_count = cube->mip_count * 6u;
+  VkrTexturePreparedLoad prepared = {
+      .description = vkr_world_resources_cube_description(
+          cube->face_size, cube->mip_count > 1u,
+          VKR_TEXTURE_FORMAT_R16G16B16A16_SFLOAT),
+      .upload_data = malloc(texel_count * 4u * sizeof(uint16_t)),
+      .upload_data_size = texel_count * 4u * sizeof(uint16_t),
+      .upload_regions = malloc(sizeof(VkrTextureUploadRegion) * region_count),
+      .upload_region_count = region_count,
+      .upload_mip_levels = cube->mip_count,
+      .upload_array_layers = 6u,
+  };
+  prepared.description.generation = VKR_INVALID_ID;
+
+  bool8_t published = false_v;
+  if (prepared.upload_data && prepared.upload_regions) {
+    // Cube texels are mip-major, then face, so they convert in one run and
+    // each face of each mip is the next slice of the result.
+    vkr_texture_convert_f32_to_f16((const float32_t *)cube->texels,
+                                   (uint16_t *)prepared.upload_data,
+                                   texel_count * 4u);
+    uint64_t offset = 0u;
+    for (uint32_t mip = 0; mip < cube->mip_count; ++mip) {
+      const uint32_t size = Max(cube->face_size >> mip, 1u);
+      const uint64_t face_bytes =
+          (uint64_t)size * size * 4u * sizeof(uint16_t);
+      for (uint32_t face = 0; face < 6u; ++face) {
+        prepared.upload_regions[mip * 6u + face] = (VkrTextureUploadRegion){
+            .mip_level = mip,
+            .array_layer = face,
+            .width = size,
+            .height = size,
+            .depth = 1u,
+            .byte_offset = offset,
+            .byte_size = face_bytes,
+        };
+        offset += face_bytes;
+      }
+    }
+    VkrRendererError texture_error = VKR_RENDERER_ERROR_NONE;
+    published = vkr_texture_system_finalize_prepared_load(
+        &rf->texture_system, name, &prepared, out_handle, &texture_error);
+  }
+  vkr_texture_system_release_prepared_load(&prepared);
+  if (!published) {
+    log_warn("World resources: failed to publish baked cubemap '%.*s'",
+             (int)name.length, name.str);
+    return false_v;
+  }
+  vkr_texture_system_add_ref_by_handle(&rf->texture_system, *out_handle);
+  return true_v;
+}
+
+bool8_t vkr_world_resources_bake_scene_environment_on_cpu(
+    RendererFrontend *rf, VkrWorldResources *resources, VkrScene *scene,
+    String8 equirect_path, const VkrTexturePreparedLoad *equirect) {
+  if (!rf || !resources || !scene || !equirect_path.str || !equirect ||
+      !scene->environment.enabled || !rf->asset_publisher.attach_ibl_maps ||
+      equirect->upload_is_compressed ||
+      equirect->description.type != VKR_TEXTURE_TYPE_2D ||
+      equirect->description.format != VKR_TEXTURE_FORMAT_R16G16B16A16_SFLOAT) {
+    return false_v;
+  }
+
+  uint32_t face_size = 0u;
+  uint32_t mip_count = 0u;
+  if (!vkr_ibl_derive_cubemap_size(
+          equirect->description.width, equirect->description.height,
+          resources->hdr_ibl_max_cube_extent,
+          vkr_world_resources_ibl_mip_limit(resources), &face_size,
+          &mip_count)) {
+    return false_v;
+  }
+
+  // The float source, its cube and the prefilter run to tens of megabytes,
+  // more than the frame scratch holds, so the bake gets its own arena.
+  Arena *arena = arena_create(MB(32), MB(4));
+  VkrAllocator allocator = {.ctx = arena};
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, rf->texture_system.job_system);
+  VkrIblCube source = {0};
+  VkrIblCube irradiance = {0};
+  VkrIblCube prefilter = {0};
+  VkrTextureHandle source_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  VkrTextureHandle irradiance_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  VkrTextureHandle prefilter_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  float32_t *rgba = NULL;
+  uint32_t width = 0u;
+  uint32_t height = 0u;
+  bool8_t baked = false_v;
+  if (!arena || !vkr_allocator_arena(&allocator) ||
+      !(rgba = vkr_world_resources_downsample_equirect(
+            equirect, face_size, &allocator, &width, &height)) ||
+      !vkr_ibl_cube_create(&source, &allocator, face_size, mip_count) ||
+      !vkr_ibl_cube_create(&irradiance, &allocator,
+                           VKR_WORLD_RESOURCES_IBL_IRRADIANCE_SIZE, 1u) ||
+      !vkr_ibl_cube_create(&prefilter, &allocator,
+                           VKR_WORLD_RESOURCES_IBL_PREFILTER_SIZE,
+                           VKR_IBL_PREFILTER_MIP_COUNT)) {
+    goto cleanup;
+  }
+
+  vkr_ibl_bake_equirect_to_cube(rgba, width, height, &source, &dispatch);
+  const String8 cache_path = string8_create_formatted(
+      &allocator, "%.*s%s", (int32_t)equirect_path.length, equirect_path.str,
+      VKR_WORLD_RESOURCES_IBL_CACHE_EXT);
+  const uint64_t key =
+      vkr_ibl_bake_key(rgba, width, height, &irradiance, &prefilter,
+                       VKR_IBL_BAKE_PREFILTER_SAMPLES);
+  if (!vkr_ibl_bake_cache_read(&allocator, cache_path, key, &irradiance,
+                               &prefilter)) {
+    const VkrIblSh9 sh = vkr_ibl_bake_project_sh9(&source, 0u);
+    vkr_ibl_bake_irradiance(&sh, &irradiance, &dispatch);
+    if (!vkr_ibl_bake_prefilter(&source, &prefilter,
+                                VKR_IBL_BAKE_PREFILTER_SAMPLES, &allocator,
+                                &dispatch)) {
+      goto cleanup;
+    }
+    if (!vkr_ibl_bake_cache_write(&allocator, cache_path, key, &irradiance,
+                                  &prefilter)) {
+      log_warn("World resources: failed to cache IBL bake at '%.*s'",
+               (int)cache_path.length, cache_path.str);
+    }
+  }
+
+  char source_name_storage[128];
+  char irradiance_name_storage[128];
+  char prefilter_name_storage[128];
+  if (!vkr_world_resources_publish_ibl_cube(
+          rf,
+          vkr_world_resources_scene_ibl_name(source_name_storage,
+                                             sizeof(source_name_storage), scene,
+                                             "source"),
+          &source, &source_cubemap) ||
+      !vkr_world_resources_publish_ibl_cube(
+          rf,
+          vkr_world_resources_scene_ibl_name(irradiance_name_storage,
+                                             sizeof(irradiance_name_storage),
+                                             scene, "irradiance"),
+          &irradiance, &irradiance_cubemap) ||
+      !vkr_world_resources_publish_ibl_cube(
+          rf,
+          vkr_world_resources_scene_ibl_name(prefilter_name_storage,
+                                             sizeof(prefilter_name_storage),
+                                             scene, "prefilter"),
+          &prefilter, &prefilter_cubemap) ||
+      !rf->asset_publisher.attach_ibl_maps(rf->asset_publisher.state,
+                                           source_cubemap, irradiance_cubemap,
+                                           prefilter_cubemap)) {
+    goto cleanup;
+  }
+
+  VkrSceneEnvironment *environment = &scene->environment;
+  environment->source_cubemap = source_cubemap;
+  environment->irradiance_cubemap = irradiance_cubemap;
+  environment->prefilter_cubemap = prefilter_cubemap;
+  environment->source_face_size = source.face_size;
+  environment->source_mip_count = source.mip_count;
+  environment->bake_state = VKR_SCENE_ENV_BAKE_STATE_READY;
+  source_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  irradiance_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  prefilter_cubemap = VKR_TEXTURE_HANDLE_INVALID;
+  baked = true_v;
+
+cleanup:
+  vkr_world_resources_release_texture(&rf->texture_system, &prefilter_cubemap);
+  vkr_world_resources_release_texture(&rf->texture_system,
+                                      &irradiance_cubemap);
+  vkr_world_resources_release_texture(&rf->texture_system, &source_cubemap);
+  // Helper jobs may still hold the dispatcher after the last bake pass.
+  vkr_parallel_for_wait_idle(&dispatch);
+  if (arena) {
+    arena_destroy(arena);
+  }
+  return baked;
+}
+
 void vkr_world_resources_bake_scene_ibl_if_pending(RendererFrontend *rf,
                                                    VkrWorldResources *resources,
                                                    VkrScene *scene) {
@@ -469,8 +742,16 @@ void vkr_world_resources_bake_scene_ibl_if_pending(RendererFrontend *rf,
 
 void vkr_world_resources_release_scene_reflection_probe_targets(
     RendererFrontend *rf, VkrScene *scene) {
-  (void)rf;
-  (void)scene;
+  if (!rf || !scene) {
+    return;
+  }
+
+  // A scene initialized at the same address restarts its probe version.
+  VkrWorldResources *resources = &rf->world_resources;
+  if (resources->probe_index_scene == scene) {
+    resources->probe_index_scene = NULL;
+    resources->probe_index.count = 0;
+  }
 }
 
 vkr_internal void
@@ -520,6 +801,7 @@ bool8_t vkr_world_resources_prepare_scene_reflection_probes(
   }
 
   bool8_t all_prepared = true_v;
+  bool8_t probes_changed = false_v;
   for (uint32_t i = 0; i < scene->reflection_probe_count; ++i) {
     VkrSceneReflectionProbe *probe = &scene->reflection_probes[i];
     if (!probe->enabled ||
@@ -531,6 +813,7 @@ bool8_t vkr_world_resources_prepare_scene_reflection_probes(
         if (scene->environment.bake_state == VKR_SCENE_ENV_BAKE_STATE_FAILED) {
           vkr_world_resources_fail_reflection_probe(rf, probe);
           all_prepared = false_v;
+          probes_changed = true_v;
         }
         continue;
       }
@@ -539,6 +822,7 @@ bool8_t vkr_world_resources_prepare_scene_reflection_probes(
         vkr_world_resources_fail_reflection_probe(rf, probe);
         all_prepared = false_v;
       }
+      probes_changed = true_v;
       continue;
     }
 
@@ -567,9 +851,14 @@ bool8_t vkr_world_resources_prepare_scene_reflection_probes(
             probe->irradiance_cubemap, probe->prefilter_cubemap)) {
       vkr_world_resources_fail_reflection_probe(rf, probe);
       all_prepared = false_v;
+      probes_changed = true_v;
       continue;
     }
     probe->bake_state = VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY;
+    probes_changed = true_v;
+  }
+  if (probes_changed) {
+    scene->reflection_probe_version++;
   }
   return all_prepared;
 }
@@ -619,6 +908,90 @@ bool8_t vkr_world_resources_probe_intersects_sphere(Vec3 center, Vec3 extents,
   return vec3_length_squared(outside) <= radius * radius ? true_v : false_v;
 }
 
+_Static_assert(VKR_WORLD_PROBE_INDEX_CAPACITY >= VKR_SCENE_REFLECTION_PROBE_MAX,
+               "probe index must hold every scene reflection probe");
+
+/** Distance from `value` to [min_value, max_value] along one axis. */
+vkr_internal INLINE float32_t vkr_world_resources_box_outside(
+    float32_t min_value, float32_t max_value, float32_t value) {
+  return vkr_max_f32(0.0f, vkr_max_f32(min_value - value, value - max_value));
+}
+
+void vkr_world_resources_build_probe_index(const VkrScene *scene,
+                                           VkrWorldProbeIndex *out_index) {
+  if (!out_index) {
+    return;
+  }
+
+  out_index->count = 0;
+  if (!scene) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < scene->reflection_probe_count; ++i) {
+    const VkrSceneReflectionProbe *probe = &scene->reflection_probes[i];
+    if (!probe->enabled ||
+        probe->bake_state != VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY) {
+      continue;
+    }
+
+    Vec3 influence_extents =
+        vec3_add(probe->extents,
+                 vec3_new(probe->blend_distance, probe->blend_distance,
+                          probe->blend_distance));
+    out_index->entries[out_index->count++] = (VkrWorldProbeIndexEntry){
+        .influence_min = vec3_sub(probe->center, influence_extents),
+        .influence_max = vec3_add(probe->center, influence_extents),
+        .center = probe->center,
+        .probe_index = i,
+    };
+  }
+}
+
+uint32_t vkr_world_resources_query_probe_index(
+    const VkrWorldProbeIndex *index, Vec3 sphere_center,
+    float32_t sphere_radius,
+    uint32_t out_probes[VKR_WORLD_PROBE_INDEX_CAPACITY]) {
+  if (!index || !out_probes) {
+    return 0;
+  }
+
+  float32_t radius = vkr_max_f32(sphere_radius, 0.0f);
+  float32_t radius_squared = radius * radius;
+  float32_t distances[VKR_WORLD_PROBE_INDEX_CAPACITY];
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < index->count; ++i) {
+    const VkrWorldProbeIndexEntry *entry = &index->entries[i];
+    Vec3 outside = vec3_new(
+        vkr_world_resources_box_outside(entry->influence_min.x,
+                                        entry->influence_max.x,
+                                        sphere_center.x),
+        vkr_world_resources_box_outside(entry->influence_min.y,
+                                        entry->influence_max.y,
+                                        sphere_center.y),
+        vkr_world_resources_box_outside(entry->influence_min.z,
+                                        entry->influence_max.z,
+                                        sphere_center.z));
+    if (vec3_length_squared(outside) > radius_squared) {
+      continue;
+    }
+
+    // Entries are in probe order, so inserting after equal distances keeps
+    // the lower probe index first.
+    float32_t distance =
+        vec3_length_squared(vec3_sub(sphere_center, entry->center));
+    uint32_t slot = count++;
+    while (slot > 0 && distances[slot - 1] > distance) {
+      distances[slot] = distances[slot - 1];
+      out_probes[slot] = out_probes[slot - 1];
+      --slot;
+    }
+    distances[slot] = distance;
+    out_probes[slot] = entry->probe_index;
+  }
+  return count;
+}
+
 vkr_internal VkrWorldIblProbeSlot vkr_world_resources_fallback_probe_slot(
     RendererFrontend *rf, VkrWorldResources *resources) {
   VkrWorldIblProbeSlot slot = {
@@ -694,62 +1067,41 @@ void vkr_world_resources_select_probe_slots_for_bounds(
   out_slots[1].weight = 0.0f;
   out_slots[2].weight = 1.0f;
 
-  uint32_t best_probe_index[2] = {0xFFFFFFFFu, 0xFFFFFFFFu};
-  float32_t best_probe_score[2] = {-VKR_FLOAT_MAX, -VKR_FLOAT_MAX};
-  if (scene) {
-    for (uint32_t i = 0; i < scene->reflection_probe_count; ++i) {
-      const VkrSceneReflectionProbe *probe = &scene->reflection_probes[i];
-      if (!probe->enabled ||
-          probe->bake_state != VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY) {
-        continue;
-      }
-
-      VkrTextureOpaqueHandle irradiance =
-          vkr_world_resources_resolve_backend_texture(
-              &rf->texture_system, probe->irradiance_cubemap,
-              VKR_TEXTURE_TYPE_CUBE_MAP);
-      VkrTextureOpaqueHandle prefilter =
-          vkr_world_resources_resolve_backend_texture(
-              &rf->texture_system, probe->prefilter_cubemap,
-              VKR_TEXTURE_TYPE_CUBE_MAP);
-      if (!irradiance || !prefilter) {
-        continue;
-      }
-
-      if (!vkr_world_resources_probe_intersects_sphere(
-              probe->center, probe->extents, probe->blend_distance,
-              bounds_center, bounds_radius)) {
-        continue;
-      }
+  if (!scene) {
+    return;
+  }
 
-      float32_t center_distance =
-          vec3_length(vec3_sub(bounds_center, probe->center));
-      float32_t score = -center_distance;
-      if (score > best_probe_score[0]) {
-        best_probe_score[1] = best_probe_score[0];
-        best_probe_index[1] = best_probe_index[0];
-        best_probe_score[0] = score;
-        best_probe_index[0] = i;
-      } else if (score > best_probe_score[1]) {
-        best_probe_score[1] = score;
-        best_probe_index[1] = i;
-      }
-    }
+  if (resources->probe_index_scene != scene ||
+      resources->probe_index_version != scene->reflection_probe_version) {
+    vkr_world_resources_build_probe_index(scene, &resources->probe_index);
+    resources->probe_index_scene = scene;
+    resources->probe_index_version = scene->reflection_probe_version;
   }
 
-  for (uint32_t slot_index = 0; slot_index < 2u; ++slot_index) {
-    if (best_probe_index[slot_index] == 0xFFFFFFFFu) {
-      continue;
-    }
+  // Textures are resolved only for the nearest candidates, until two probes
+  // with both maps resident fill the local slots.
+  uint32_t candidates[VKR_WORLD_PROBE_INDEX_CAPACITY];
+  uint32_t candidate_count = vkr_world_resources_query_probe_index(
+      &resources->probe_index, bounds_center, bounds_radius, candidates);
+  uint32_t slot_index = 0;
+  for (uint32_t i = 0; i < candidate_count && slot_index < 2u; ++i) {
     const VkrSceneReflectionProbe *probe =
-        &scene->reflection_probes[best_probe_index[slot_index]];
-    out_slots[slot_index] = (VkrWorldIblProbeSlot){
-        .irradiance_map = vkr_world_resources_resolve_backend_texture(
+        &scene->reflection_probes[candidates[i]];
+    VkrTextureOpaqueHandle irradiance =
+        vkr_world_resources_resolve_backend_texture(
             &rf->texture_system, probe->irradiance_cubemap,
-            VKR_TEXTURE_TYPE_CUBE_MAP),
-        .prefilter_map = vkr_world_resources_resolve_backend_texture(
+            VKR_TEXTURE_TYPE_CUBE_MAP);
+    VkrTextureOpaqueHandle prefilter =
+        vkr_world_resources_resolve_backend_texture(
             &rf->texture_system, probe->prefilter_cubemap,
-            VKR_TEXTURE_TYPE_CUBE_MAP),
+            VKR_TEXTURE_TYPE_CUBE_MAP);
+    if (!irradiance || !prefilter) {
+      continue;
+    }
+
+    out_slots[slot_index++] = (VkrWorldIblProbeSlot){
+        .irradiance_map = irradiance,
+        .prefilter_map = prefilter,
         .center = probe->center,
         .extents = probe->extents,
         .blend_distance = probe->blend_distance,
@@ -15,6 +15,7 @@
 #include "renderer/vkr_renderer.h"
 
 struct s_RendererFrontend;
+struct VkrTexturePreparedLoad;
 typedef struct VkrScene VkrScene;
 typedef struct VkrPreparedTextDraw VkrPreparedTextDraw;
 
@@ -41,6 +42,45 @@ bool8_t vkr_world_resources_probe_intersects_sphere(Vec3 center, Vec3 extents,
                                                     Vec3 sphere_center,
                                                     float32_t sphere_radius);
 
+/** Probes an index holds; at least VKR_SCENE_REFLECTION_PROBE_MAX. */
+#define VKR_WORLD_PROBE_INDEX_CAPACITY 16u
+
+/** Influence box of one enabled, ready reflection probe. */
+typedef struct VkrWorldProbeIndexEntry {
+  Vec3 influence_min; /**< Probe box grown by its blend distance */
+  Vec3 influence_max;
+  Vec3 center;
+  uint32_t probe_index; /**< Index into VkrScene.reflection_probes */
+} VkrWorldProbeIndexEntry;
+
+/**
+ * @brief Selectable reflection probes of a scene, flattened for queries.
+ *
+ * Built once per probe set and bake state instead of re-filtering every probe
+ * on each selection.
+ */
+typedef struct VkrWorldProbeIndex {
+  VkrWorldProbeIndexEntry entries[VKR_WORLD_PROBE_INDEX_CAPACITY];
+  uint32_t count;
+} VkrWorldProbeIndex;
+
+/** Collects the enabled, ready probes of `scene` into `out_index`. */
+void vkr_world_resources_build_probe_index(const VkrScene *scene,
+                                           VkrWorldProbeIndex *out_index);
+
+/**
+ * @brief Finds the probes whose influence overlaps a sphere.
+ *
+ * Matches vkr_world_resources_probe_intersects_sphere() per probe.
+ *
+ * @return Number of scene probe indices written to `out_probes`, nearest
+ * center first and the lower probe index first on ties.
+ */
+uint32_t vkr_world_resources_query_probe_index(
+    const VkrWorldProbeIndex *index, Vec3 sphere_center,
+    float32_t sphere_radius,
+    uint32_t out_probes[VKR_WORLD_PROBE_INDEX_CAPACITY]);
+
 /**
  * @brief A single 3D text slot in the world resources.
  *
@@ -78,6 +118,12 @@ typedef struct VkrWorldResources {
   uint32_t hdr_ibl_max_cube_extent;
   uint32_t hdr_ibl_max_mip_levels;
 
+  /** Ready probes of `probe_index_scene`, current while the scene's
+   * reflection_probe_version equals `probe_index_version`. */
+  VkrWorldProbeIndex probe_index;
+  const VkrScene *probe_index_scene;
+  uint64_t probe_index_version;
+
   bool8_t initialized; /**< Resources have been initialized */
 } VkrWorldResources;
 
@@ -118,6 +164,20 @@ vkr_world_resources_prepare_scene_environment(struct s_RendererFrontend *rf,
                                               VkrWorldResources *resources,
                                               VkrScene *scene);
 
+/**
+ * @brief Bakes the scene environment from its decoded RGBA16F equirect on the
+ * CPU and publishes the source, irradiance and prefilter cubes.
+ *
+ * A bake cached next to `equirect_path` under the same key is read back
+ * instead of baked. Runs only when the renderer can attach CPU-baked maps to
+ * a source cube; returns false, with nothing published, when it cannot or
+ * when any step fails, leaving the environment to the GPU bake.
+ */
+bool8_t vkr_world_resources_bake_scene_environment_on_cpu(
+    struct s_RendererFrontend *rf, VkrWorldResources *resources,
+    VkrScene *scene, String8 equirect_path,
+    const struct VkrTexturePreparedLoad *equirect);
+
 /** Destroys cached target views before their scene-owned textures retire. */
 void vkr_world_resources_release_scene_environment_targets(
     struct s_RendererFrontend *rf, VkrScene *scene);
@@ -157,7 +217,8 @@ void vkr_world_resources_set_active_ibl_from_scene_or_default(
  * @brief Selects two local probe candidates plus a global fallback.
  *
  * Slot selection prefers local reflection probes by influence and falls back
- * to active/global IBL maps when no local probe contributes.
+ * to active/global IBL maps when no local probe contributes. Candidates come
+ * from the cached probe index, rebuilt when the scene's probe version moves.
  */
 void vkr_world_resources_select_probe_slots_for_position(
     struct s_RendererFrontend *rf, VkrWorldResources *resources,
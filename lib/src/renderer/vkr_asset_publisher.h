@@ -36,6 +36,14 @@ typedef struct VkrAssetPublisher {
                                   VkrTextureHandle source,
                                   VkrTextureHandle irradiance,
                                   VkrTextureHandle prefilter);
+  /**
+   * Optional. Makes already published `irradiance` and `prefilter` cubes the
+   * lighting maps of `source`, for bakes done off the renderer. Backends that
+   * leave it NULL only take bakes through the two callbacks above.
+   */
+  bool8_t (*attach_ibl_maps)(void *state, VkrTextureHandle source,
+                             VkrTextureHandle irradiance,
+                             VkrTextureHandle prefilter);
   bool8_t (*unpublish_texture)(void *state, VkrTextureHandle handle);
   bool8_t (*publish_material)(void *state, VkrMaterialHandle handle,
                               const struct VkrMaterial *material);
@@ -0,0 +1,730 @@
+#include "renderer/vkr_ibl_bake.h"
+
+#include "filesystem/filesystem.h"
+#include "math/vkr_math.h"
+#include "math/vkr_simd.h"
+#include "renderer/vkr_ibl_math.h"
+#include "renderer/vkr_pipeline_manifest.h"
+#include "renderer/vkr_texture_convert.h"
+
+#include <math.h>
+
+/** Texel rows per parallel-for chunk. */
+#define VKR_IBL_BAKE_ROWS_PER_CHUNK 4u
+/** Enough mips for a 2^31 face; caps the per-mip tables. */
+#define VKR_IBL_BAKE_MAX_MIPS 32u
+
+#define VKR_IBL_BAKE_CACHE_MAGIC 0x42494B56u /* "VKIB" */
+#define VKR_IBL_BAKE_CACHE_VERSION 1u
+/** Magic, version, key (two words), then size and mips of both cubes. */
+#define VKR_IBL_BAKE_CACHE_HEADER_SIZE 32u
+
+/** One prefilter sample, shared by every texel of a mip. */
+typedef struct VkrIblBakeSample {
+  /** Tangent-space light direction in xyz, its n.l weight in w. */
+  Vec4 light;
+  float32_t lod;
+} VkrIblBakeSample;
+
+typedef struct VkrIblBakeEquirectJob {
+  const float32_t *rgba;
+  uint32_t width;
+  uint32_t height;
+  VkrIblCube *cube;
+} VkrIblBakeEquirectJob;
+
+typedef struct VkrIblBakeIrradianceJob {
+  const VkrIblSh9 *sh;
+  VkrIblCube *irradiance;
+} VkrIblBakeIrradianceJob;
+
+typedef struct VkrIblBakePrefilterJob {
+  const VkrIblCube *source;
+  VkrIblCube *prefilter;
+  const VkrIblBakeSample *samples;
+  uint32_t sample_stride;
+  uint32_t sample_counts[VKR_IBL_BAKE_MAX_MIPS];
+  /** First work row of each mip; rows run over all six faces of a mip. */
+  uint32_t row_first[VKR_IBL_BAKE_MAX_MIPS + 1u];
+} VkrIblBakePrefilterJob;
+
+vkr_internal INLINE uint32_t vkr_ibl_bake_mip_size(uint32_t face_size,
+                                                   uint32_t mip) {
+  return Max(1u, face_size >> mip);
+}
+
+vkr_internal uint32_t vkr_ibl_bake_full_mip_count(uint32_t face_size) {
+  uint32_t mip_count = 1u;
+  for (uint32_t extent = face_size; extent > 1u; extent >>= 1u) {
+    mip_count++;
+  }
+  return mip_count;
+}
+
+vkr_internal INLINE Vec3 vkr_ibl_bake_face_direction(uint32_t face,
+                                                     uint32_t size, uint32_t x,
+                                                     uint32_t y) {
+  const float32_t inverse_size = 1.0f / (float32_t)size;
+  const VkrIblDirection direction = vkr_ibl_cube_face_uv_to_direction(
+      (VkrIblCubeFace)face, (VkrIblUv){((float32_t)x + 0.5f) * inverse_size,
+                                       ((float32_t)y + 0.5f) * inverse_size});
+  return vec3_new(direction.x, direction.y, direction.z);
+}
+
+/** Maps a work row to its face and row within `mip_count` mips. */
+vkr_internal INLINE uint32_t vkr_ibl_bake_row_mip(const uint32_t *row_first,
+                                                  uint32_t mip_count,
+                                                  uint32_t row) {
+  uint32_t mip = 0u;
+  while (mip + 1u < mip_count && row >= row_first[mip + 1u]) {
+    mip++;
+  }
+  return mip;
+}
+
+/* ========================================================================== */
+/* Cube storage and sampling                                                  */
+/* ========================================================================== */
+
+uint64_t vkr_ibl_cube_texel_count(uint32_t face_size, uint32_t mip_count) {
+  uint64_t count = 0u;
+  for (uint32_t mip = 0u; mip < mip_count; ++mip) {
+    const uint64_t size = vkr_ibl_bake_mip_size(face_size, mip);
+    count += size * size * VKR_IBL_CUBE_FACE_COUNT;
+  }
+  return count;
+}
+
+bool8_t vkr_ibl_cube_create(VkrIblCube *cube, VkrAllocator *allocator,
+                            uint32_t face_size, uint32_t mip_count) {
+  if (!cube || !allocator || face_size == 0u || mip_count == 0u) {
+    return false_v;
+  }
+
+  MemZero(cube, sizeof(*cube));
+  mip_count = Min(mip_count, vkr_ibl_bake_full_mip_count(face_size));
+  const uint64_t texel_count = vkr_ibl_cube_texel_count(face_size, mip_count);
+  cube->texels = vkr_allocator_alloc_aligned(
+      allocator, sizeof(*cube->texels) * texel_count, 16u,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!cube->texels) {
+    return false_v;
+  }
+  cube->face_size = face_size;
+  cube->mip_count = mip_count;
+  return true_v;
+}
+
+void vkr_ibl_cube_destroy(VkrIblCube *cube, VkrAllocator *allocator) {
+  if (!cube || !allocator) {
+    return;
+  }
+  if (cube->texels) {
+    vkr_allocator_free_aligned(
+        allocator, cube->texels,
+        sizeof(*cube->texels) *
+            vkr_ibl_cube_texel_count(cube->face_size, cube->mip_count),
+        16u, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  MemZero(cube, sizeof(*cube));
+}
+
+Vec4 *vkr_ibl_cube_face(const VkrIblCube *cube, uint32_t mip, uint32_t face) {
+  const uint64_t size = vkr_ibl_bake_mip_size(cube->face_size, mip);
+  return cube->texels + vkr_ibl_cube_texel_count(cube->face_size, mip) +
+         (uint64_t)face * size * size;
+}
+
+vkr_internal Vec4 vkr_ibl_bake_bilinear(const Vec4 *face, uint32_t size,
+                                        VkrIblUv uv) {
+  const float32_t limit = (float32_t)(size - 1u);
+  const float32_t x = Clamp(uv.u * (float32_t)size - 0.5f, 0.0f, limit);
+  const float32_t y = Clamp(uv.v * (float32_t)size - 0.5f, 0.0f, limit);
+  const uint32_t x0 = (uint32_t)x;
+  const uint32_t y0 = (uint32_t)y;
+  const uint32_t x1 = Min(x0 + 1u, size - 1u);
+  const uint32_t y1 = Min(y0 + 1u, size - 1u);
+  const float32_t fx = x - (float32_t)x0;
+  const float32_t fy = y - (float32_t)y0;
+  const Vec4 *row0 = face + (uint64_t)y0 * size;
+  const Vec4 *row1 = face + (uint64_t)y1 * size;
+  return vec4_lerp(vec4_lerp(row0[x0], row0[x1], fx),
+                   vec4_lerp(row1[x0], row1[x1], fx), fy);
+}
+
+Vec4 vkr_ibl_cube_sample(const VkrIblCube *cube, Vec3 direction,
+                         float32_t lod) {
+  VkrIblUv uv;
+  const VkrIblCubeFace face = vkr_ibl_direction_to_cube_face_uv(
+      (VkrIblDirection){direction.x, direction.y, direction.z}, &uv);
+  lod = Clamp(lod, 0.0f, (float32_t)(cube->mip_count - 1u));
+  const uint32_t mip = (uint32_t)lod;
+  const float32_t blend = lod - (float32_t)mip;
+  const Vec4 near_mip =
+      vkr_ibl_bake_bilinear(vkr_ibl_cube_face(cube, mip, face),
+                            vkr_ibl_bake_mip_size(cube->face_size, mip), uv);
+  if (blend <= 0.0f || mip + 1u >= cube->mip_count) {
+    return near_mip;
+  }
+  const Vec4 far_mip = vkr_ibl_bake_bilinear(
+      vkr_ibl_cube_face(cube, mip + 1u, face),
+      vkr_ibl_bake_mip_size(cube->face_size, mip + 1u), uv);
+  return vec4_lerp(near_mip, far_mip, blend);
+}
+
+/* ========================================================================== */
+/* Source cube                                                                */
+/* ========================================================================== */
+
+/** Bilinear equirect lookup, wrapping in longitude and clamping at poles. */
+vkr_internal Vec4 vkr_ibl_bake_equirect_sample(const VkrIblBakeEquirectJob *job,
+                                               VkrIblUv uv) {
+  const float32_t x = uv.u * (float32_t)job->width - 0.5f;
+  const float32_t y = Clamp(uv.v * (float32_t)job->height - 0.5f, 0.0f,
+                            (float32_t)(job->height - 1u));
+  const float32_t x_floor = floorf(x);
+  const float32_t fx = x - x_floor;
+  const int64_t xi = (int64_t)x_floor;
+  const uint32_t x0 = (uint32_t)((xi % job->width + job->width) % job->width);
+  const uint32_t x1 = x0 + 1u == job->width ? 0u : x0 + 1u;
+  const uint32_t y0 = (uint32_t)y;
+  const uint32_t y1 = Min(y0 + 1u, job->height - 1u);
+  const float32_t fy = y - (float32_t)y0;
+  const float32_t *row0 = job->rgba + (uint64_t)y0 * job->width * 4u;
+  const float32_t *row1 = job->rgba + (uint64_t)y1 * job->width * 4u;
+  const Vec4 top = vec4_lerp(vkr_simd_load_f32x4(row0 + x0 * 4u),
+                             vkr_simd_load_f32x4(row0 + x1 * 4u), fx);
+  const Vec4 bottom = vec4_lerp(vkr_simd_load_f32x4(row1 + x0 * 4u),
+                                vkr_simd_load_f32x4(row1 + x1 * 4u), fx);
+  return vec4_lerp(top, bottom, fy);
+}
+
+vkr_internal void vkr_ibl_bake_equirect_rows(void *context,
+                                             uint32_t chunk_index,
+                                             uint32_t first, uint32_t count) {
+  (void)chunk_index;
+  const VkrIblBakeEquirectJob *job = context;
+  const uint32_t size = job->cube->face_size;
+  for (uint32_t row = first; row < first + count; ++row) {
+    const uint32_t face = row / size;
+    const uint32_t y = row % size;
+    Vec4 *out = vkr_ibl_cube_face(job->cube, 0u, face) + (uint64_t)y * size;
+    for (uint32_t x = 0u; x < size; ++x) {
+      const Vec3 direction = vkr_ibl_bake_face_direction(face, size, x, y);
+      out[x] = vkr_ibl_bake_equirect_sample(
+          job, vkr_ibl_direction_to_equirect_uv(
+                   (VkrIblDirection){direction.x, direction.y, direction.z}));
+    }
+  }
+}
+
+void vkr_ibl_bake_equirect_to_cube(const float32_t *rgba, uint32_t width,
+                                   uint32_t height, VkrIblCube *cube,
+                                   VkrParallelFor *dispatch) {
+  if (!rgba || width == 0u || height == 0u || !cube || !cube->texels ||
+      !dispatch) {
+    return;
+  }
+
+  VkrIblBakeEquirectJob job = {
+      .rgba = rgba,
+      .width = width,
+      .height = height,
+      .cube = cube,
+  };
+  vkr_parallel_for_run(dispatch, cube->face_size * VKR_IBL_CUBE_FACE_COUNT,
+                       VKR_IBL_BAKE_ROWS_PER_CHUNK, vkr_ibl_bake_equirect_rows,
+                       &job);
+  vkr_ibl_bake_build_mips(cube);
+}
+
+void vkr_ibl_bake_build_mips(VkrIblCube *cube) {
+  if (!cube || !cube->texels) {
+    return;
+  }
+
+  const Vec4 quarter = vkr_simd_set1_f32x4(0.25f);
+  for (uint32_t mip = 1u; mip < cube->mip_count; ++mip) {
+    const uint32_t size = vkr_ibl_bake_mip_size(cube->face_size, mip);
+    const uint32_t source_size =
+        vkr_ibl_bake_mip_size(cube->face_size, mip - 1u);
+    for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+      const Vec4 *source = vkr_ibl_cube_face(cube, mip - 1u, face);
+      Vec4 *out = vkr_ibl_cube_face(cube, mip, face);
+      for (uint32_t y = 0u; y < size; ++y) {
+        const Vec4 *row0 = source + (uint64_t)(2u * y) * source_size;
+        const Vec4 *row1 = source + (uint64_t)(2u * y + 1u) * source_size;
+        for (uint32_t x = 0u; x < size; ++x) {
+          const Vec4 sum = vkr_simd_add_f32x4(
+              vkr_simd_add_f32x4(row0[2u * x], row0[2u * x + 1u]),
+              vkr_simd_add_f32x4(row1[2u * x], row1[2u * x + 1u]));
+          out[(uint64_t)y * size + x] = vkr_simd_mul_f32x4(sum, quarter);
+        }
+      }
+    }
+  }
+}
+
+/* ========================================================================== */
+/* Diffuse irradiance                                                         */
+/* ========================================================================== */
+
+/** Real SH basis of bands 0..2 at unit `n`. */
+vkr_internal INLINE void vkr_ibl_bake_sh9_basis(Vec3 n, float32_t out[9]) {
+  out[0] = 0.282095f;
+  out[1] = 0.488603f * n.y;
+  out[2] = 0.488603f * n.z;
+  out[3] = 0.488603f * n.x;
+  out[4] = 1.092548f * n.x * n.y;
+  out[5] = 1.092548f * n.y * n.z;
+  out[6] = 0.315392f * (3.0f * n.z * n.z - 1.0f);
+  out[7] = 1.092548f * n.x * n.z;
+  out[8] = 0.546274f * (n.x * n.x - n.y * n.y);
+}
+
+VkrIblSh9 vkr_ibl_bake_project_sh9(const VkrIblCube *cube, uint32_t mip) {
+  VkrIblSh9 sh = {0};
+  if (!cube || !cube->texels || mip >= cube->mip_count) {
+    return sh;
+  }
+
+  // Texel solid angle is (2 / size)^2 / r^3 for the unnormalized direction
+  // of length r; the constant factor is folded into the final normalization
+  // to 4 pi, which also absorbs the discretization error.
+  const uint32_t size = vkr_ibl_bake_mip_size(cube->face_size, mip);
+  float64_t total_weight = 0.0;
+  for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+    const Vec4 *texels = vkr_ibl_cube_face(cube, mip, face);
+    for (uint32_t y = 0u; y < size; ++y) {
+      for (uint32_t x = 0u; x < size; ++x) {
+        const Vec3 direction = vkr_ibl_bake_face_direction(face, size, x, y);
+        const float32_t length_squared = vec3_length_squared(direction);
+        const float32_t inverse_length = 1.0f / sqrtf(length_squared);
+        const float32_t weight =
+            inverse_length * inverse_length * inverse_length;
+        float32_t basis[9];
+        vkr_ibl_bake_sh9_basis(vec3_scale(direction, inverse_length), basis);
+        const Vec4 texel = texels[(uint64_t)y * size + x];
+        for (uint32_t i = 0u; i < 9u; ++i) {
+          sh.coefficients[i] =
+              vec4_scaleadd(sh.coefficients[i], texel, basis[i] * weight);
+        }
+        total_weight += weight;
+      }
+    }
+  }
+
+  const float32_t scale = (float32_t)(4.0 * (float64_t)VKR_PI / total_weight);
+  for (uint32_t i = 0u; i < 9u; ++i) {
+    sh.coefficients[i] = vec3_scale(sh.coefficients[i], scale);
+    sh.coefficients[i].w = 0.0f;
+  }
+  return sh;
+}
+
+Vec3 vkr_ibl_sh9_irradiance(const VkrIblSh9 *sh, Vec3 normal) {
+  // Clamped-cosine lobe per band (pi, 2 pi / 3, pi / 4), divided by pi.
+  static const float32_t k_band_scale[9] = {
+      1.0f,  2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f,
+      0.25f, 0.25f,       0.25f,       0.25f,
+  };
+  float32_t basis[9];
+  vkr_ibl_bake_sh9_basis(vec3_normalize(normal), basis);
+  Vec4 sum = vec4_zero();
+  for (uint32_t i = 0u; i < 9u; ++i) {
+    sum = vec4_scaleadd(sum, sh->coefficients[i], basis[i] * k_band_scale[i]);
+  }
+  sum = vkr_simd_max_f32x4(sum, vec4_zero());
+  return vec3_new(sum.x, sum.y, sum.z);
+}
+
+vkr_internal void vkr_ibl_bake_irradiance_rows(void *context,
+                                               uint32_t chunk_index,
+                                               uint32_t first, uint32_t count) {
+  (void)chunk_index;
+  const VkrIblBakeIrradianceJob *job = context;
+  const uint32_t size = job->irradiance->face_size;
+  for (uint32_t row = first; row < first + count; ++row) {
+    const uint32_t face = row / size;
+    const uint32_t y = row % size;
+    Vec4 *out =
+        vkr_ibl_cube_face(job->irradiance, 0u, face) + (uint64_t)y * size;
+    for (uint32_t x = 0u; x < size; ++x) {
+      const Vec3 irradiance = vkr_ibl_sh9_irradiance(
+          job->sh, vkr_ibl_bake_face_direction(face, size, x, y));
+      out[x] = vec4_new(irradiance.x, irradiance.y, irradiance.z, 1.0f);
+    }
+  }
+}
+
+void vkr_ibl_bake_irradiance(const VkrIblSh9 *sh, VkrIblCube *irradiance,
+                             VkrParallelFor *dispatch) {
+  if (!sh || !irradiance || !irradiance->texels || !dispatch) {
+    return;
+  }
+
+  VkrIblBakeIrradianceJob job = {.sh = sh, .irradiance = irradiance};
+  vkr_parallel_for_run(dispatch,
+                       irradiance->face_size * VKR_IBL_CUBE_FACE_COUNT,
+                       VKR_IBL_BAKE_ROWS_PER_CHUNK,
+                       vkr_ibl_bake_irradiance_rows, &job);
+}
+
+/* ========================================================================== */
+/* Specular prefilter                                                         */
+/* ========================================================================== */
+
+vkr_internal INLINE float32_t vkr_ibl_bake_radical_inverse(uint32_t bits) {
+  bits = (bits << 16u) | (bits >> 16u);
+  bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+  bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+  bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+  bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+  return (float32_t)bits * 2.3283064365386963e-10f;
+}
+
+/**
+ * Tangent-space samples of one mip. The GPU pass sets the view to the normal,
+ * so each light direction and its source LOD are the same for every texel.
+ *
+ * @return Samples with a positive n.l weight.
+ */
+vkr_internal uint32_t vkr_ibl_bake_prefilter_samples(
+    float32_t roughness, uint32_t sample_count, uint32_t source_face_size,
+    uint32_t source_mip_count, VkrIblBakeSample *out_samples) {
+  if (roughness <= 0.001f) {
+    out_samples[0] = (VkrIblBakeSample){
+        .light = vec4_new(0.0f, 0.0f, 1.0f, 1.0f),
+        .lod = 0.0f,
+    };
+    return 1u;
+  }
+
+  const float32_t alpha = roughness * roughness;
+  uint32_t count = 0u;
+  for (uint32_t i = 0u; i < sample_count; ++i) {
+    const float32_t xi_x = (float32_t)i / (float32_t)sample_count;
+    const float32_t xi_y = vkr_ibl_bake_radical_inverse(i);
+    const float32_t phi = 2.0f * VKR_PI * xi_x;
+    const float32_t cos_theta =
+        sqrtf((1.0f - xi_y) / (1.0f + (alpha * alpha - 1.0f) * xi_y));
+    const float32_t sin_theta = sqrtf(Max(1.0f - cos_theta * cos_theta, 0.0f));
+    // L = 2 (V.H) H - V with V = N = +Z, so V.H = N.H = cos_theta.
+    const float32_t twice_cos = 2.0f * cos_theta;
+    const float32_t no_l = twice_cos * cos_theta - 1.0f;
+    if (no_l <= 0.0f) {
+      continue;
+    }
+    const float32_t no_h = Max(cos_theta, 1e-6f);
+    out_samples[count++] = (VkrIblBakeSample){
+        .light = vec4_new(twice_cos * cosf(phi) * sin_theta,
+                          twice_cos * sinf(phi) * sin_theta, no_l, no_l),
+        .lod = vkr_ibl_prefilter_source_lod(no_h, no_h, roughness,
+                                            sample_count, source_face_size,
+                                            source_mip_count),
+    };
+  }
+  return count;
+}
+
+vkr_internal void vkr_ibl_bake_prefilter_rows(void *context,
+                                              uint32_t chunk_index,
+                                              uint32_t first, uint32_t count) {
+  (void)chunk_index;
+  const VkrIblBakePrefilterJob *job = context;
+  const uint32_t mip_count = job->prefilter->mip_count;
+  for (uint32_t row = first; row < first + count; ++row) {
+    const uint32_t mip = vkr_ibl_bake_row_mip(job->row_first, mip_count, row);
+    const uint32_t size =
+        vkr_ibl_bake_mip_size(job->prefilter->face_size, mip);
+    const uint32_t mip_row = row - job->row_first[mip];
+    const uint32_t face = mip_row / size;
+    const uint32_t y = mip_row % size;
+    const VkrIblBakeSample *samples =
+        job->samples + (uint64_t)mip * job->sample_stride;
+    const uint32_t sample_count = job->sample_counts[mip];
+    Vec4 *out =
+        vkr_ibl_cube_face(job->prefilter, mip, face) + (uint64_t)y * size;
+
+    for (uint32_t x = 0u; x < size; ++x) {
+      const Vec3 normal =
+          vec3_normalize(vkr_ibl_bake_face_direction(face, size, x, y));
+      const Vec3 up = vkr_abs_f32(normal.z) < 0.999f
+                          ? vec3_new(0.0f, 0.0f, 1.0f)
+                          : vec3_new(1.0f, 0.0f, 0.0f);
+      const Vec3 tangent = vec3_normalize(vec3_cross(up, normal));
+      const Vec3 bitangent = vec3_cross(normal, tangent);
+
+      Vec4 color = vec4_zero();
+      float32_t total_weight = 0.0f;
+      for (uint32_t s = 0u; s < sample_count; ++s) {
+        const Vec4 light = samples[s].light;
+        const Vec3 direction = vkr_simd_fma_f32x4(
+            vkr_simd_fma_f32x4(
+                vkr_simd_mul_f32x4(normal, vkr_simd_set1_f32x4(light.z)),
+                tangent, vkr_simd_set1_f32x4(light.x)),
+            bitangent, vkr_simd_set1_f32x4(light.y));
+        color = vec4_scaleadd(
+            color, vkr_ibl_cube_sample(job->source, direction, samples[s].lod),
+            light.w);
+        total_weight += light.w;
+      }
+      color = vec4_scale(color, 1.0f / Max(total_weight, 1e-4f));
+      color.w = 1.0f;
+      out[x] = color;
+    }
+  }
+}
+
+bool8_t vkr_ibl_bake_prefilter(const VkrIblCube *source,
+                               VkrIblCube *prefilter, uint32_t sample_count,
+                               VkrAllocator *scratch,
+                               VkrParallelFor *dispatch) {
+  if (!source || !source->texels || !prefilter || !prefilter->texels ||
+      !scratch || !dispatch || prefilter->mip_count > VKR_IBL_BAKE_MAX_MIPS) {
+    return false_v;
+  }
+
+  sample_count = Max(sample_count, 1u);
+  const uint64_t table_size =
+      sizeof(VkrIblBakeSample) * sample_count * prefilter->mip_count;
+  VkrIblBakeSample *samples = vkr_allocator_alloc_aligned(
+      scratch, table_size, 16u, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!samples) {
+    return false_v;
+  }
+
+  VkrIblBakePrefilterJob job = {
+      .source = source,
+      .prefilter = prefilter,
+      .samples = samples,
+      .sample_stride = sample_count,
+  };
+  uint32_t rows = 0u;
+  for (uint32_t mip = 0u; mip < prefilter->mip_count; ++mip) {
+    const float32_t roughness =
+        prefilter->mip_count > 1u
+            ? (float32_t)mip / (float32_t)(prefilter->mip_count - 1u)
+            : 0.0f;
+    job.sample_counts[mip] = vkr_ibl_bake_prefilter_samples(
+        roughness, sample_count, source->face_size, source->mip_count,
+        samples + (uint64_t)mip * sample_count);
+    job.row_first[mip] = rows;
+    rows += vkr_ibl_bake_mip_size(prefilter->face_size, mip) *
+            VKR_IBL_CUBE_FACE_COUNT;
+  }
+  job.row_first[prefilter->mip_count] = rows;
+
+  vkr_parallel_for_run(dispatch, rows, VKR_IBL_BAKE_ROWS_PER_CHUNK,
+                       vkr_ibl_bake_prefilter_rows, &job);
+  vkr_allocator_free_aligned(scratch, samples, table_size, 16u,
+                             VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  return true_v;
+}
+
+/* ========================================================================== */
+/* Baked-probe cache                                                          */
+/* ========================================================================== */
+
+uint64_t vkr_ibl_bake_key(const float32_t *rgba, uint32_t width,
+                          uint32_t height, const VkrIblCube *irradiance,
+                          const VkrIblCube *prefilter, uint32_t sample_count) {
+  uint64_t key = vkr_pipeline_key_u32(VKR_PIPELINE_KEY_SEED,
+                                      VKR_IBL_BAKE_CACHE_VERSION);
+  key = vkr_pipeline_key_u32(key, width);
+  key = vkr_pipeline_key_u32(key, height);
+  key = vkr_pipeline_key_u32(key, irradiance ? irradiance->face_size : 0u);
+  key = vkr_pipeline_key_u32(key, prefilter ? prefilter->face_size : 0u);
+  key = vkr_pipeline_key_u32(key, prefilter ? prefilter->mip_count : 0u);
+  key = vkr_pipeline_key_u32(key, sample_count);
+  if (rgba) {
+    key = vkr_pipeline_key_bytes(key, rgba,
+                                 sizeof(float32_t) * 4u * (uint64_t)width *
+                                     (uint64_t)height);
+  }
+  return key;
+}
+
+vkr_internal INLINE void vkr_ibl_bake_put_u32(uint8_t *out, uint32_t value) {
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8u);
+  out[2] = (uint8_t)(value >> 16u);
+  out[3] = (uint8_t)(value >> 24u);
+}
+
+/** Serializes the header; the stored values are little-endian. */
+vkr_internal void vkr_ibl_bake_cache_header(uint8_t *out, uint64_t key,
+                                            const VkrIblCube *irradiance,
+                                            const VkrIblCube *prefilter) {
+  vkr_ibl_bake_put_u32(out, VKR_IBL_BAKE_CACHE_MAGIC);
+  vkr_ibl_bake_put_u32(out + 4u, VKR_IBL_BAKE_CACHE_VERSION);
+  vkr_ibl_bake_put_u32(out + 8u, (uint32_t)key);
+  vkr_ibl_bake_put_u32(out + 12u, (uint32_t)(key >> 32u));
+  vkr_ibl_bake_put_u32(out + 16u, irradiance->face_size);
+  vkr_ibl_bake_put_u32(out + 20u, irradiance->mip_count);
+  vkr_ibl_bake_put_u32(out + 24u, prefilter->face_size);
+  vkr_ibl_bake_put_u32(out + 28u, prefilter->mip_count);
+}
+
+/** Bytes of both cubes as RGBA half floats. */
+vkr_internal uint64_t vkr_ibl_bake_cache_texel_bytes(
+    const VkrIblCube *irradiance, const VkrIblCube *prefilter) {
+  return (vkr_ibl_cube_texel_count(irradiance->face_size,
+                                   irradiance->mip_count) +
+          vkr_ibl_cube_texel_count(prefilter->face_size,
+                                   prefilter->mip_count)) *
+         4u * sizeof(uint16_t);
+}
+
+vkr_internal bool8_t vkr_ibl_bake_host_is_little_endian(void) {
+  const union {
+    uint32_t u32;
+    uint8_t u8[4];
+  } endian_check = {0x01020304};
+  return endian_check.u8[0] == 0x04 ? true_v : false_v;
+}
+
+vkr_internal uint8_t *vkr_ibl_bake_encode_cube(const VkrIblCube *cube,
+                                               uint8_t *out) {
+  const uint64_t texel_count =
+      vkr_ibl_cube_texel_count(cube->face_size, cube->mip_count);
+  if (vkr_ibl_bake_host_is_little_endian()) {
+    vkr_texture_convert_f32_to_f16((const float32_t *)cube->texels,
+                                   (uint16_t *)out, texel_count * 4u);
+    return out + texel_count * 4u * sizeof(uint16_t);
+  }
+  for (uint64_t i = 0u; i < texel_count; ++i) {
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      const uint16_t half = vkr_float32_to_float16(cube->texels[i].elements[c]);
+      out[0] = (uint8_t)half;
+      out[1] = (uint8_t)(half >> 8u);
+      out += 2u;
+    }
+  }
+  return out;
+}
+
+vkr_internal const uint8_t *vkr_ibl_bake_decode_cube(VkrIblCube *cube,
+                                                     const uint8_t *in) {
+  const uint64_t texel_count =
+      vkr_ibl_cube_texel_count(cube->face_size, cube->mip_count);
+  if (vkr_ibl_bake_host_is_little_endian()) {
+    vkr_texture_convert_f16_to_f32((const uint16_t *)in,
+                                   (float32_t *)cube->texels,
+                                   texel_count * 4u);
+    return in + texel_count * 4u * sizeof(uint16_t);
+  }
+  for (uint64_t i = 0u; i < texel_count; ++i) {
+    float32_t rgba[4];
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      rgba[c] = vkr_float16_to_float32((uint16_t)(in[0] | (in[1] << 8u)));
+      in += 2u;
+    }
+    cube->texels[i] = vkr_simd_load_f32x4(rgba);
+  }
+  return in;
+}
+
+bool8_t vkr_ibl_bake_cache_write(VkrAllocator *allocator, String8 path,
+                                 uint64_t key, const VkrIblCube *irradiance,
+                                 const VkrIblCube *prefilter) {
+  if (!allocator || !path.str || path.length == 0 || !irradiance ||
+      !irradiance->texels || !prefilter || !prefilter->texels) {
+    return false_v;
+  }
+
+  FilePath file_path = file_path_create((const char *)path.str, allocator,
+                                        FILE_PATH_TYPE_RELATIVE);
+  String8 cache_dir = file_path_get_directory(allocator, file_path.path);
+  if (cache_dir.length > 0 && !file_ensure_directory(allocator, &cache_dir)) {
+    return false_v;
+  }
+
+  const uint64_t size = VKR_IBL_BAKE_CACHE_HEADER_SIZE +
+                        vkr_ibl_bake_cache_texel_bytes(irradiance, prefilter);
+  uint8_t *bytes =
+      vkr_allocator_alloc(allocator, size, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!bytes) {
+    return false_v;
+  }
+  vkr_ibl_bake_cache_header(bytes, key, irradiance, prefilter);
+  vkr_ibl_bake_encode_cube(
+      prefilter, vkr_ibl_bake_encode_cube(
+                     irradiance, bytes + VKR_IBL_BAKE_CACHE_HEADER_SIZE));
+
+  FileMode mode = bitset8_create();
+  bitset8_set(&mode, FILE_MODE_WRITE);
+  bitset8_set(&mode, FILE_MODE_TRUNCATE);
+  bitset8_set(&mode, FILE_MODE_BINARY);
+
+  FileHandle handle = {0};
+  bool8_t written_ok = false_v;
+  if (file_open(&file_path, mode, &handle) == FILE_ERROR_NONE) {
+    uint64_t written = 0u;
+    written_ok = file_write(&handle, size, bytes, &written) ==
+                         FILE_ERROR_NONE &&
+                     written == size
+                 ? true_v
+                 : false_v;
+    file_close(&handle);
+  }
+  vkr_allocator_free(allocator, bytes, size, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  return written_ok;
+}
+
+bool8_t vkr_ibl_bake_cache_read(VkrAllocator *allocator, String8 path,
+                                uint64_t key, VkrIblCube *irradiance,
+                                VkrIblCube *prefilter) {
+  if (!allocator || !path.str || path.length == 0 || !irradiance ||
+      !irradiance->texels || !prefilter || !prefilter->texels) {
+    return false_v;
+  }
+
+  FilePath file_path = file_path_create((const char *)path.str, allocator,
+                                        FILE_PATH_TYPE_RELATIVE);
+  if (!file_exists(&file_path)) {
+    return false_v;
+  }
+  FileMode mode = bitset8_create();
+  bitset8_set(&mode, FILE_MODE_READ);
+  bitset8_set(&mode, FILE_MODE_BINARY);
+  FileHandle handle = {0};
+  if (file_open(&file_path, mode, &handle) != FILE_ERROR_NONE) {
+    return false_v;
+  }
+
+  uint8_t header[VKR_IBL_BAKE_CACHE_HEADER_SIZE];
+  uint8_t expected[VKR_IBL_BAKE_CACHE_HEADER_SIZE];
+  vkr_ibl_bake_cache_header(expected, key, irradiance, prefilter);
+  uint64_t bytes_read = 0u;
+  if (file_read_into(&handle, header, sizeof(header), &bytes_read) !=
+          FILE_ERROR_NONE ||
+      bytes_read != sizeof(header) ||
+      MemCompare(header, expected, sizeof(header)) != 0) {
+    file_close(&handle);
+    return false_v;
+  }
+
+  // The header fixes every size, so the texels must fill the rest exactly.
+  const uint64_t size = vkr_ibl_bake_cache_texel_bytes(irradiance, prefilter);
+  uint8_t *bytes =
+      vkr_allocator_alloc(allocator, size + 1u, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!bytes) {
+    file_close(&handle);
+    return false_v;
+  }
+  const bool8_t read_ok =
+      file_read_into(&handle, bytes, size + 1u, &bytes_read) ==
+                  FILE_ERROR_NONE &&
+              bytes_read == size
+          ? true_v
+          : false_v;
+  file_close(&handle);
+  if (read_ok) {
+    vkr_ibl_bake_decode_cube(prefilter,
+                             vkr_ibl_bake_decode_cube(irradiance, bytes));
+  }
+  vkr_allocator_free(allocator, bytes, size + 1u,
+                     VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  return read_ok;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file vkr_ibl_bake.h
+ * @brief CPU bake of the IBL targets the GPU ibl_* compute passes produce.
+ *
+ * Bakes the scene environment on renderers that accept finished maps (see
+ * vkr_world_resources_bake_scene_environment_on_cpu), and makes the bake
+ * testable against vkr_ibl_math. The source cube, its mip chain and the
+ * specular prefilter follow the GPU passes: the same face convention,
+ * Hammersley sequence, GGX importance sampling and source-LOD rule, with the
+ * roughness of a prefilter mip being mip / (mip_count - 1). Diffuse
+ * irradiance is evaluated from a nine-coefficient spherical-harmonic
+ * projection of the source rather than by hemisphere sampling; both produce
+ * the cosine-weighted mean radiance, and at the irradiance size the SH result
+ * is the smoother of the two.
+ *
+ * Texels are RGBA float vectors, so every filter tap and accumulation is one
+ * four-lane SIMD operation. Prefiltering precomputes one tangent-space sample
+ * table per mip and splits the rows of every mip and face across
+ * parallel-for chunks.
+ *
+ * A finished bake can be stored as half floats, the format of the GPU
+ * targets, under a key hashed from its source texels and bake parameters, so
+ * a warm start reads the texels back instead of baking.
+ */
+#pragma once
+
+#include "containers/str.h"
+#include "core/vkr_parallel_for.h"
+#include "defines.h"
+#include "math/vec.h"
+#include "memory/vkr_allocator.h"
+
+/** Hemisphere samples per texel the GPU prefilter pass uses. */
+#define VKR_IBL_BAKE_PREFILTER_SAMPLES 256u
+
+/** RGBA float cubemap, laid out mip-major, then face, then row. */
+typedef struct VkrIblCube {
+  Vec4 *texels;
+  uint32_t face_size;
+  uint32_t mip_count;
+} VkrIblCube;
+
+/** Radiance projected on the real spherical harmonics of bands 0 to 2. */
+typedef struct VkrIblSh9 {
+  Vec3 coefficients[9];
+} VkrIblSh9;
+
+/** @return Texels of a cube with `mip_count` mips starting at `face_size`. */
+uint64_t vkr_ibl_cube_texel_count(uint32_t face_size, uint32_t mip_count);
+
+/**
+ * @brief Allocates an uninitialized cube. `mip_count` is clamped to the mips
+ * a `face_size` chain has.
+ */
+bool8_t vkr_ibl_cube_create(VkrIblCube *cube, VkrAllocator *allocator,
+                            uint32_t face_size, uint32_t mip_count);
+
+void vkr_ibl_cube_destroy(VkrIblCube *cube, VkrAllocator *allocator);
+
+/** @return First texel of `face` in `mip`. */
+Vec4 *vkr_ibl_cube_face(const VkrIblCube *cube, uint32_t mip, uint32_t face);
+
+/**
+ * @brief Trilinear lookup along an unnormalized `direction`.
+ *
+ * Bilinear taps clamp to the edge of the selected face instead of crossing
+ * to the neighbouring face.
+ */
+Vec4 vkr_ibl_cube_sample(const VkrIblCube *cube, Vec3 direction,
+                         float32_t lod);
+
+/**
+ * @brief Resamples a 2:1 RGBA float equirect into mip 0 of `cube` and builds
+ * the remaining mips.
+ *
+ * @param rgba `width` x `height` texels of four floats, row-major.
+ * @param dispatch Runs rows of the six faces; its job system may be NULL.
+ */
+void vkr_ibl_bake_equirect_to_cube(const float32_t *rgba, uint32_t width,
+                                   uint32_t height, VkrIblCube *cube,
+                                   VkrParallelFor *dispatch);
+
+/** Box-filters every mip of `cube` from the one above it. */
+void vkr_ibl_bake_build_mips(VkrIblCube *cube);
+
+/** Projects `mip` of `cube`, weighting each texel by its solid angle. */
+VkrIblSh9 vkr_ibl_bake_project_sh9(const VkrIblCube *cube, uint32_t mip);
+
+/**
+ * @brief Cosine-weighted mean radiance around `normal`, the value the GPU
+ * irradiance pass stores. Negative lobes from SH ringing clamp to zero.
+ */
+Vec3 vkr_ibl_sh9_irradiance(const VkrIblSh9 *sh, Vec3 normal);
+
+/** Fills mip 0 of `irradiance` from `sh`. */
+void vkr_ibl_bake_irradiance(const VkrIblSh9 *sh, VkrIblCube *irradiance,
+                             VkrParallelFor *dispatch);
+
+/**
+ * @brief GGX-prefilters `source` into every mip of `prefilter`.
+ *
+ * `source` needs its full mip chain; the sample tables come from `scratch`.
+ *
+ * @return False when the sample tables cannot be allocated.
+ */
+bool8_t vkr_ibl_bake_prefilter(const VkrIblCube *source,
+                               VkrIblCube *prefilter, uint32_t sample_count,
+                               VkrAllocator *scratch,
+                               VkrParallelFor *dispatch);
+
+/** @return Cache key over the source texels and every bake parameter. */
+uint64_t vkr_ibl_bake_key(const float32_t *rgba, uint32_t width,
+                          uint32_t height, const VkrIblCube *irradiance,
+                          const VkrIblCube *prefilter, uint32_t sample_count);
+
+/**
+ * @brief Stores a bake at the project-relative `path`, creating its
+ * directory.
+ */
+bool8_t vkr_ibl_bake_cache_write(VkrAllocator *allocator, String8 path,
+                                 uint64_t key, const VkrIblCube *irradiance,
+                                 const VkrIblCube *prefilter);
+
+/**
+ * @brief Reads a bake stored under `key` into cubes created with the sizes it
+ * was baked at.
+ *
+ * @return False when the file is missing, truncated, from another format
+ * version, or holds another key or size; the cubes are then unspecified.
+ */
+bool8_t vkr_ibl_bake_cache_read(VkrAllocator *allocator, String8 path,
+                                uint64_t key, VkrIblCube *irradiance,
+                                VkrIblCube *prefilter);
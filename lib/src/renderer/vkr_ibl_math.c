@@ -147,6 +147,43 @@ VkrIblDirection vkr_ibl_cube_face_uv_to_direction(VkrIblCubeFace face,
   }
 }
 
+VkrIblCubeFace vkr_ibl_direction_to_cube_face_uv(VkrIblDirection direction,
+                                                 VkrIblUv *out_uv) {
+  const float32_t ax = fabsf(direction.x);
+  const float32_t ay = fabsf(direction.y);
+  const float32_t az = fabsf(direction.z);
+  VkrIblCubeFace face;
+  float32_t s;
+  float32_t t;
+  float32_t major;
+  if (ax >= ay && ax >= az) {
+    face = direction.x >= 0.0f ? VKR_IBL_CUBE_FACE_POSITIVE_X
+                               : VKR_IBL_CUBE_FACE_NEGATIVE_X;
+    s = direction.x >= 0.0f ? -direction.z : direction.z;
+    t = -direction.y;
+    major = ax;
+  } else if (ay >= az) {
+    face = direction.y >= 0.0f ? VKR_IBL_CUBE_FACE_POSITIVE_Y
+                               : VKR_IBL_CUBE_FACE_NEGATIVE_Y;
+    s = direction.x;
+    t = direction.y >= 0.0f ? direction.z : -direction.z;
+    major = ay;
+  } else {
+    face = direction.z >= 0.0f ? VKR_IBL_CUBE_FACE_POSITIVE_Z
+                               : VKR_IBL_CUBE_FACE_NEGATIVE_Z;
+    s = direction.z >= 0.0f ? direction.x : -direction.x;
+    t = -direction.y;
+    major = az;
+  }
+
+  if (out_uv) {
+    const float32_t inverse_major = major > 0.0f ? 0.5f / major : 0.0f;
+    out_uv->u = s * inverse_major + 0.5f;
+    out_uv->v = t * inverse_major + 0.5f;
+  }
+  return face;
+}
+
 float32_t vkr_ibl_prefilter_source_lod(float32_t no_h, float32_t vo_h,
                                        float32_t roughness,
                                        uint32_t sample_count,
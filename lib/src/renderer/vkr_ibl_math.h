@@ -60,6 +60,14 @@ VkrIblDirection vkr_ibl_equirect_uv_to_direction(VkrIblUv uv);
 VkrIblDirection vkr_ibl_cube_face_uv_to_direction(VkrIblCubeFace face,
                                                   VkrIblUv uv);
 
+/**
+ * Inverse of vkr_ibl_cube_face_uv_to_direction(): picks the face of the major
+ * axis the way Vulkan cubemap sampling does and writes its face coordinates.
+ * A zero direction maps to the center of +X.
+ */
+VkrIblCubeFace vkr_ibl_direction_to_cube_face_uv(VkrIblDirection direction,
+                                                 VkrIblUv *out_uv);
+
 /**
  * Computes the source-cubemap mip for GGX prefiltered importance sampling.
  * The returned value is finite and clamped to the initialized source range.
@@ -0,0 +1,403 @@
+#include "renderer/vkr_occlusion.h"
+
+#include "math/vkr_simd.h"
+
+/** Depth every cleared pixel keeps; nothing is ever occluded by it. */
+#define VKR_OCCLUSION_EMPTY_DEPTH 3.402823466e+38f
+/** Occludees must be this much farther than the occluder depth. */
+#define VKR_OCCLUSION_DEPTH_BIAS 1e-6f
+/** Three triangle vertices plus one per clip plane. */
+#define VKR_OCCLUSION_CLIP_VERTEX_MAX 8u
+
+/**
+ * Clip-space planes a point v keeps when dot(plane, v) >= 0: near (z >= 0 in
+ * the renderer's [0,1] depth range) and the four sides. The far plane is left
+ * open; anything past it is past every occludee too.
+ */
+static const float32_t vkr_occlusion_clip_planes[5][4] = {
+    {0.0f, 0.0f, 1.0f, 0.0f},  {1.0f, 0.0f, 0.0f, 1.0f},
+    {-1.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 1.0f},
+    {0.0f, -1.0f, 0.0f, 1.0f},
+};
+
+vkr_internal INLINE float32_t vkr_occlusion_plane_distance(uint32_t plane,
+                                                           Vec4 v) {
+  const float32_t *p = vkr_occlusion_clip_planes[plane];
+  return p[0] * v.x + p[1] * v.y + p[2] * v.z + p[3] * v.w;
+}
+
+/** Sutherland-Hodgman against one plane; returns the output vertex count. */
+vkr_internal uint32_t vkr_occlusion_clip_polygon(uint32_t plane,
+                                                 const Vec4 *in,
+                                                 uint32_t in_count, Vec4 *out) {
+  uint32_t out_count = 0u;
+  for (uint32_t i = 0; i < in_count; ++i) {
+    const Vec4 a = in[i];
+    const Vec4 b = in[(i + 1u) % in_count];
+    const float32_t da = vkr_occlusion_plane_distance(plane, a);
+    const float32_t db = vkr_occlusion_plane_distance(plane, b);
+    if (da >= 0.0f)
+      out[out_count++] = a;
+    if ((da >= 0.0f) != (db >= 0.0f)) {
+      const float32_t t = da / (da - db);
+      out[out_count++] = vec4_add(a, vec4_scale(vec4_sub(b, a), t));
+    }
+  }
+  return out_count;
+}
+
+typedef struct VkrOcclusionScreenVertex {
+  float32_t x;
+  float32_t y;
+  float32_t z;
+} VkrOcclusionScreenVertex;
+
+vkr_internal INLINE VkrOcclusionScreenVertex
+vkr_occlusion_to_screen(Vec4 clip) {
+  const float32_t inv_w = 1.0f / clip.w;
+  return (VkrOcclusionScreenVertex){
+      .x = (clip.x * inv_w * 0.5f + 0.5f) * (float32_t)VKR_OCCLUSION_WIDTH,
+      .y = (clip.y * inv_w * 0.5f + 0.5f) * (float32_t)VKR_OCCLUSION_HEIGHT,
+      .z = clip.z * inv_w,
+  };
+}
+
+vkr_internal INLINE uint16_t vkr_occlusion_pixel(float32_t coordinate,
+                                                 uint32_t extent) {
+  if (coordinate <= 0.0f)
+    return 0u;
+  const uint32_t pixel = (uint32_t)coordinate;
+  return (uint16_t)Min(pixel, extent - 1u);
+}
+
+/**
+ * Sets up one screen triangle. Vulkan counts a triangle front-facing when
+ * its framebuffer-space (y down) winding is counter-clockwise, which is a
+ * negative cross product here; setup flips front faces so every kept
+ * triangle has non-negative edge functions inside.
+ */
+vkr_internal bool8_t vkr_occlusion_setup_triangle(VkrOcclusionScreenVertex v0,
+                                                  VkrOcclusionScreenVertex v1,
+                                                  VkrOcclusionScreenVertex v2,
+                                                  bool8_t double_sided,
+                                                  VkrOcclusionTriangle *out) {
+  float32_t cross =
+      (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+  if (!double_sided && cross >= 0.0f)
+    return false_v;
+  if (vkr_abs_f32(cross) < 1e-8f)
+    return false_v;
+  if (cross < 0.0f) {
+    const VkrOcclusionScreenVertex swap = v1;
+    v1 = v2;
+    v2 = swap;
+    cross = -cross;
+  }
+
+  const VkrOcclusionScreenVertex v[3] = {v0, v1, v2};
+  for (uint32_t e = 0; e < 3u; ++e) {
+    const VkrOcclusionScreenVertex a = v[e];
+    const VkrOcclusionScreenVertex b = v[(e + 1u) % 3u];
+    out->edge_a[e] = a.y - b.y;
+    out->edge_b[e] = b.x - a.x;
+    out->edge_c[e] = -(out->edge_a[e] * a.x + out->edge_b[e] * a.y);
+  }
+  const float32_t inv_cross = 1.0f / cross;
+  out->depth_a =
+      ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) *
+      inv_cross;
+  out->depth_b =
+      ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) *
+      inv_cross;
+  out->depth_c = v0.z - out->depth_a * v0.x - out->depth_b * v0.y;
+  out->depth_min = vkr_min_f32(v0.z, vkr_min_f32(v1.z, v2.z));
+
+  out->min_x = vkr_occlusion_pixel(vkr_min_f32(v0.x, vkr_min_f32(v1.x, v2.x)),
+                                   VKR_OCCLUSION_WIDTH);
+  out->max_x = vkr_occlusion_pixel(vkr_max_f32(v0.x, vkr_max_f32(v1.x, v2.x)),
+                                   VKR_OCCLUSION_WIDTH);
+  out->min_y = vkr_occlusion_pixel(vkr_min_f32(v0.y, vkr_min_f32(v1.y, v2.y)),
+                                   VKR_OCCLUSION_HEIGHT);
+  out->max_y = vkr_occlusion_pixel(vkr_max_f32(v0.y, vkr_max_f32(v1.y, v2.y)),
+                                   VKR_OCCLUSION_HEIGHT);
+  return true_v;
+}
+
+vkr_internal bool8_t vkr_occlusion_read_position(
+    const VkrTriangleMeshSource *source, uint32_t index_slot, Vec4 *out) {
+  uint32_t index = 0u;
+  if (source->index_size == sizeof(uint16_t)) {
+    index = ((const uint16_t *)source->indices)[index_slot];
+  } else {
+    index = ((const uint32_t *)source->indices)[index_slot];
+  }
+  const int64_t vertex = (int64_t)index + source->vertex_offset;
+  if (vertex < 0 || vertex >= (int64_t)source->vertex_count)
+    return false_v;
+  const float32_t *position =
+      (const float32_t *)((const uint8_t *)source->positions +
+                          (uint64_t)vertex * source->position_stride);
+  *out = vec4_new(position[0], position[1], position[2], 1.0f);
+  return true_v;
+}
+
+bool8_t vkr_occlusion_buffer_init(VkrOcclusionBuffer *buffer,
+                                  VkrAllocator *allocator,
+                                  Mat4 view_projection,
+                                  uint32_t triangle_budget) {
+  MemZero(buffer, sizeof(*buffer));
+  const uint64_t pixel_count =
+      (uint64_t)VKR_OCCLUSION_WIDTH * VKR_OCCLUSION_HEIGHT;
+  buffer->depth = vkr_allocator_alloc_aligned(
+      allocator, sizeof(*buffer->depth) * pixel_count, 16u,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  buffer->triangles =
+      triangle_budget > 0u
+          ? vkr_allocator_alloc(allocator,
+                                sizeof(*buffer->triangles) *
+                                    (uint64_t)triangle_budget,
+                                VKR_ALLOCATOR_MEMORY_TAG_ARRAY)
+          : NULL;
+  if (!buffer->depth || !buffer->triangles) {
+    buffer->depth = NULL;
+    buffer->triangles = NULL;
+    return false_v;
+  }
+  buffer->view_projection = view_projection;
+  buffer->triangle_capacity = triangle_budget;
+  return true_v;
+}
+
+bool8_t vkr_occlusion_add_occluder(VkrOcclusionBuffer *buffer, Mat4 model,
+                                   const VkrTriangleMeshSource *source,
+                                   bool8_t double_sided) {
+  const uint32_t source_triangles = source->index_count / 3u;
+  if (!buffer->triangles || source_triangles == 0u ||
+      source_triangles > VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES)
+    return false_v;
+
+  const Mat4 mvp = mat4_mul(buffer->view_projection, model);
+  const uint32_t first_triangle = buffer->triangle_count;
+  for (uint32_t t = 0; t < source_triangles; ++t) {
+    Vec4 polygon[2][VKR_OCCLUSION_CLIP_VERTEX_MAX];
+    bool8_t valid = true_v;
+    for (uint32_t k = 0; k < 3u && valid; ++k) {
+      Vec4 position = {0};
+      valid = vkr_occlusion_read_position(
+          source, source->first_index + t * 3u + k, &position);
+      polygon[0][k] = mat4_mul_vec4(mvp, position);
+    }
+    if (!valid)
+      continue;
+
+    uint32_t count = 3u;
+    uint32_t current = 0u;
+    for (uint32_t plane = 0; plane < ArrayCount(vkr_occlusion_clip_planes) &&
+                             count >= 3u;
+         ++plane) {
+      uint32_t outside = 0u;
+      for (uint32_t k = 0; k < count; ++k)
+        outside += vkr_occlusion_plane_distance(plane, polygon[current][k]) <
+                           0.0f
+                       ? 1u
+                       : 0u;
+      if (outside == 0u)
+        continue;
+      count = vkr_occlusion_clip_polygon(plane, polygon[current], count,
+                                         polygon[current ^ 1u]);
+      current ^= 1u;
+    }
+    if (count < 3u)
+      continue;
+
+    VkrOcclusionScreenVertex screen[VKR_OCCLUSION_CLIP_VERTEX_MAX];
+    for (uint32_t k = 0; k < count; ++k) {
+      if (polygon[current][k].w <= 0.0f) {
+        count = 0u;
+        break;
+      }
+      screen[k] = vkr_occlusion_to_screen(polygon[current][k]);
+    }
+    for (uint32_t k = 1; k + 1u < count; ++k) {
+      if (buffer->triangle_count == buffer->triangle_capacity) {
+        buffer->triangle_count = first_triangle;
+        return false_v;
+      }
+      if (vkr_occlusion_setup_triangle(
+              screen[0], screen[k], screen[k + 1u], double_sided,
+              &buffer->triangles[buffer->triangle_count]))
+        buffer->triangle_count++;
+    }
+  }
+  buffer->occluder_count++;
+  return true_v;
+}
+
+vkr_internal void vkr_occlusion_raster_band(void *context,
+                                            uint32_t chunk_index,
+                                            uint32_t first, uint32_t count) {
+  (void)chunk_index;
+  VkrOcclusionBuffer *buffer = context;
+  const uint32_t band_min_y = first;
+  const uint32_t band_max_y = first + count - 1u;
+  for (uint32_t y = band_min_y; y <= band_max_y; ++y) {
+    float32_t *row = buffer->depth + (uint64_t)y * VKR_OCCLUSION_WIDTH;
+    for (uint32_t x = 0; x < VKR_OCCLUSION_WIDTH; x += 4u)
+      vkr_simd_store_f32x4(row + x,
+                           vkr_simd_set1_f32x4(VKR_OCCLUSION_EMPTY_DEPTH));
+  }
+
+  const VKR_SIMD_F32X4 zero = vkr_simd_set1_f32x4(0.0f);
+  const VKR_SIMD_F32X4 lane_x = vkr_simd_set_f32x4(0.5f, 1.5f, 2.5f, 3.5f);
+  for (uint32_t t = 0; t < buffer->triangle_count; ++t) {
+    const VkrOcclusionTriangle *tri = &buffer->triangles[t];
+    if (tri->max_y < band_min_y || tri->min_y > band_max_y)
+      continue;
+    const uint32_t min_y = Max((uint32_t)tri->min_y, band_min_y);
+    const uint32_t max_y = Min((uint32_t)tri->max_y, band_max_y);
+    const uint32_t min_x = tri->min_x & ~3u;
+    const VKR_SIMD_F32X4 pixel_x =
+        vkr_simd_add_f32x4(lane_x, vkr_simd_set1_f32x4((float32_t)min_x));
+    VKR_SIMD_F32X4 edge_step[3];
+    VKR_SIMD_F32X4 edge_x[3];
+    for (uint32_t e = 0; e < 3u; ++e) {
+      const VKR_SIMD_F32X4 a = vkr_simd_set1_f32x4(tri->edge_a[e]);
+      edge_step[e] = vkr_simd_set1_f32x4(tri->edge_a[e] * 4.0f);
+      edge_x[e] = vkr_simd_fma_f32x4(vkr_simd_set1_f32x4(tri->edge_c[e]), a,
+                                     pixel_x);
+    }
+    const VKR_SIMD_F32X4 depth_step = vkr_simd_set1_f32x4(tri->depth_a * 4.0f);
+    const VKR_SIMD_F32X4 depth_x =
+        vkr_simd_fma_f32x4(vkr_simd_set1_f32x4(tri->depth_c),
+                           vkr_simd_set1_f32x4(tri->depth_a), pixel_x);
+    const VKR_SIMD_F32X4 depth_min = vkr_simd_set1_f32x4(tri->depth_min);
+
+    for (uint32_t y = min_y; y <= max_y; ++y) {
+      const float32_t py = (float32_t)y + 0.5f;
+      VKR_SIMD_F32X4 e0 = vkr_simd_add_f32x4(
+          edge_x[0], vkr_simd_set1_f32x4(tri->edge_b[0] * py));
+      VKR_SIMD_F32X4 e1 = vkr_simd_add_f32x4(
+          edge_x[1], vkr_simd_set1_f32x4(tri->edge_b[1] * py));
+      VKR_SIMD_F32X4 e2 = vkr_simd_add_f32x4(
+          edge_x[2], vkr_simd_set1_f32x4(tri->edge_b[2] * py));
+      VKR_SIMD_F32X4 depth = vkr_simd_add_f32x4(
+          depth_x, vkr_simd_set1_f32x4(tri->depth_b * py));
+      float32_t *row = buffer->depth + (uint64_t)y * VKR_OCCLUSION_WIDTH;
+      for (uint32_t x = min_x; x <= tri->max_x; x += 4u) {
+        const VKR_SIMD_F32X4 inside =
+            vkr_simd_min_f32x4(e0, vkr_simd_min_f32x4(e1, e2));
+        if (vkr_simd_mask_ge_f32x4(inside, zero) != 0u) {
+          const VKR_SIMD_F32X4 stored = vkr_simd_load_f32x4(row + x);
+          const VKR_SIMD_F32X4 nearest = vkr_simd_min_f32x4(
+              stored, vkr_simd_max_f32x4(depth, depth_min));
+          vkr_simd_store_f32x4(
+              row + x, vkr_simd_select_ge_f32x4(inside, zero, nearest, stored));
+        }
+        e0 = vkr_simd_add_f32x4(e0, edge_step[0]);
+        e1 = vkr_simd_add_f32x4(e1, edge_step[1]);
+        e2 = vkr_simd_add_f32x4(e2, edge_step[2]);
+        depth = vkr_simd_add_f32x4(depth, depth_step);
+      }
+    }
+  }
+
+  for (uint32_t ty = band_min_y / VKR_OCCLUSION_TILE_SIZE;
+       ty <= band_max_y / VKR_OCCLUSION_TILE_SIZE; ++ty) {
+    for (uint32_t tx = 0; tx < VKR_OCCLUSION_TILES_X; ++tx) {
+      VKR_SIMD_F32X4 farthest = zero;
+      for (uint32_t y = 0; y < VKR_OCCLUSION_TILE_SIZE; ++y) {
+        const float32_t *row =
+            buffer->depth +
+            (uint64_t)(ty * VKR_OCCLUSION_TILE_SIZE + y) * VKR_OCCLUSION_WIDTH +
+            tx * VKR_OCCLUSION_TILE_SIZE;
+        for (uint32_t x = 0; x < VKR_OCCLUSION_TILE_SIZE; x += 4u)
+          farthest =
+              vkr_simd_max_f32x4(farthest, vkr_simd_load_f32x4(row + x));
+      }
+      buffer->tile_max[ty * VKR_OCCLUSION_TILES_X + tx] =
+          vkr_max_f32(vkr_max_f32(farthest.x, farthest.y),
+                      vkr_max_f32(farthest.z, farthest.w));
+    }
+  }
+}
+
+void vkr_occlusion_rasterize(VkrOcclusionBuffer *buffer,
+                             VkrParallelFor *dispatch) {
+  buffer->rasterized = false_v;
+  if (!buffer->depth || buffer->triangle_count == 0u)
+    return;
+  vkr_parallel_for_run(dispatch, VKR_OCCLUSION_HEIGHT,
+                       VKR_OCCLUSION_BAND_HEIGHT, vkr_occlusion_raster_band,
+                       buffer);
+  buffer->rasterized = true_v;
+}
+
+bool8_t vkr_occlusion_test_box(const VkrOcclusionBuffer *buffer, Mat4 model,
+                               Vec3 min_extents, Vec3 max_extents) {
+  if (!buffer->rasterized)
+    return false_v;
+
+  const Mat4 mvp = mat4_mul(buffer->view_projection, model);
+  float32_t min_x = VKR_OCCLUSION_EMPTY_DEPTH;
+  float32_t min_y = VKR_OCCLUSION_EMPTY_DEPTH;
+  float32_t max_x = -VKR_OCCLUSION_EMPTY_DEPTH;
+  float32_t max_y = -VKR_OCCLUSION_EMPTY_DEPTH;
+  float32_t nearest = VKR_OCCLUSION_EMPTY_DEPTH;
+  for (uint32_t corner = 0; corner < 8u; ++corner) {
+    const Vec4 position =
+        vec4_new((corner & 1u) ? max_extents.x : min_extents.x,
+                 (corner & 2u) ? max_extents.y : min_extents.y,
+                 (corner & 4u) ? max_extents.z : min_extents.z, 1.0f);
+    const Vec4 clip = mat4_mul_vec4(mvp, position);
+    // A corner at or before the near plane may cover any pixel.
+    if (clip.w <= 0.0f || clip.z < 0.0f)
+      return false_v;
+    const VkrOcclusionScreenVertex screen = vkr_occlusion_to_screen(clip);
+    min_x = vkr_min_f32(min_x, screen.x);
+    min_y = vkr_min_f32(min_y, screen.y);
+    max_x = vkr_max_f32(max_x, screen.x);
+    max_y = vkr_max_f32(max_y, screen.y);
+    nearest = vkr_min_f32(nearest, screen.z);
+  }
+  if (max_x < 0.0f || max_y < 0.0f || min_x >= (float32_t)VKR_OCCLUSION_WIDTH ||
+      min_y >= (float32_t)VKR_OCCLUSION_HEIGHT)
+    return false_v;
+
+  // Every pixel the rectangle touches, not only those whose centers it holds.
+  const uint32_t px0 = vkr_occlusion_pixel(min_x, VKR_OCCLUSION_WIDTH);
+  const uint32_t px1 = vkr_occlusion_pixel(max_x, VKR_OCCLUSION_WIDTH);
+  const uint32_t py0 = vkr_occlusion_pixel(min_y, VKR_OCCLUSION_HEIGHT);
+  const uint32_t py1 = vkr_occlusion_pixel(max_y, VKR_OCCLUSION_HEIGHT);
+  const float32_t threshold = nearest - VKR_OCCLUSION_DEPTH_BIAS;
+  const VKR_SIMD_F32X4 threshold4 = vkr_simd_set1_f32x4(threshold);
+  for (uint32_t ty = py0 / VKR_OCCLUSION_TILE_SIZE;
+       ty <= py1 / VKR_OCCLUSION_TILE_SIZE; ++ty) {
+    for (uint32_t tx = px0 / VKR_OCCLUSION_TILE_SIZE;
+         tx <= px1 / VKR_OCCLUSION_TILE_SIZE; ++tx) {
+      if (buffer->tile_max[ty * VKR_OCCLUSION_TILES_X + tx] < threshold)
+        continue;
+      // The tile holds something at or behind the box; check its pixels.
+      const uint32_t x0 = Max(px0, tx * VKR_OCCLUSION_TILE_SIZE);
+      const uint32_t x1 = Min(px1, tx * VKR_OCCLUSION_TILE_SIZE +
+                                       VKR_OCCLUSION_TILE_SIZE - 1u);
+      const uint32_t y0 = Max(py0, ty * VKR_OCCLUSION_TILE_SIZE);
+      const uint32_t y1 = Min(py1, ty * VKR_OCCLUSION_TILE_SIZE +
+                                       VKR_OCCLUSION_TILE_SIZE - 1u);
+      for (uint32_t y = y0; y <= y1; ++y) {
+        const float32_t *row =
+            buffer->depth + (uint64_t)y * VKR_OCCLUSION_WIDTH;
+        for (uint32_t x = x0 & ~3u; x <= x1; x += 4u) {
+          uint32_t lanes = vkr_simd_mask_ge_f32x4(vkr_simd_load_f32x4(row + x),
+                                                  threshold4);
+          if (x < x0)
+            lanes &= 0xFu << (x0 - x);
+          if (x + 3u > x1)
+            lanes &= 0xFu >> (x + 3u - x1);
+          if (lanes != 0u)
+            return false_v;
+        }
+      }
+    }
+  }
+  return true_v;
+}
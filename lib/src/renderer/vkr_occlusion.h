@@ -0,0 +1,108 @@
+/**
+ * @file vkr_occlusion.h
+ * @brief CPU software occlusion culling against a low-resolution depth buffer.
+ *
+ * A frame adds a small budget of opaque occluder triangles, which are clipped
+ * to the view frustum and set up once, then rasterized in horizontal bands,
+ * one band per parallel-for chunk, four pixels at a time with the vkr_simd
+ * lane ops. Each tile of the result keeps its farthest depth, so most
+ * occludee boxes are accepted or rejected from the tiles alone.
+ *
+ * Depth is the Vulkan NDC depth of the renderer's projections ([0,1], near
+ * at 0), which is affine in screen space for perspective and orthographic
+ * cameras alike. A box is occluded only when its nearest corner lies behind
+ * the rasterized depth of every pixel its screen rectangle touches, so an
+ * empty pixel, a box crossing the near plane, or one outside the screen is
+ * always reported visible.
+ */
+#pragma once
+
+#include "core/vkr_parallel_for.h"
+#include "defines.h"
+#include "math/mat.h"
+#include "math/vkr_triangle_bvh.h"
+#include "memory/vkr_allocator.h"
+
+#define VKR_OCCLUSION_WIDTH 256u
+#define VKR_OCCLUSION_HEIGHT 128u
+#define VKR_OCCLUSION_TILE_SIZE 8u
+#define VKR_OCCLUSION_TILES_X (VKR_OCCLUSION_WIDTH / VKR_OCCLUSION_TILE_SIZE)
+#define VKR_OCCLUSION_TILES_Y (VKR_OCCLUSION_HEIGHT / VKR_OCCLUSION_TILE_SIZE)
+/** Rows per raster job; a band is a whole number of tile rows. */
+#define VKR_OCCLUSION_BAND_HEIGHT 16u
+/** Default screen-triangle budget per frame, which bounds raster time. */
+#define VKR_OCCLUSION_DEFAULT_TRIANGLE_BUDGET 16384u
+/** Occluders with more source triangles than this are skipped. */
+#define VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES 2048u
+
+/** One clipped screen-space triangle with its edge and depth planes. */
+typedef struct VkrOcclusionTriangle {
+  /** Edge functions e(x, y) = a x + b y + c, >= 0 inside. */
+  float32_t edge_a[3];
+  float32_t edge_b[3];
+  float32_t edge_c[3];
+  /** Depth plane z(x, y) = a x + b y + c. */
+  float32_t depth_a;
+  float32_t depth_b;
+  float32_t depth_c;
+  /** Nearest vertex depth; clamps plane extrapolation at edge pixels. */
+  float32_t depth_min;
+  /** Inclusive pixel bounds, clamped to the buffer. */
+  uint16_t min_x;
+  uint16_t min_y;
+  uint16_t max_x;
+  uint16_t max_y;
+} VkrOcclusionTriangle;
+
+typedef struct VkrOcclusionBuffer {
+  Mat4 view_projection;
+  /** VKR_OCCLUSION_WIDTH x VKR_OCCLUSION_HEIGHT, row-major, 16-byte aligned. */
+  float32_t *depth;
+  /** Farthest depth per tile, valid after vkr_occlusion_rasterize(). */
+  float32_t tile_max[VKR_OCCLUSION_TILES_X * VKR_OCCLUSION_TILES_Y];
+  VkrOcclusionTriangle *triangles;
+  uint32_t triangle_count;
+  uint32_t triangle_capacity;
+  uint32_t occluder_count;
+  bool8_t rasterized;
+} VkrOcclusionBuffer;
+
+/**
+ * @brief Allocates the depth buffer and a triangle list of `triangle_budget`
+ * entries from `allocator` and starts an empty frame for `view_projection`.
+ *
+ * @return False when allocation fails; the buffer is then unusable and every
+ * test reports visible.
+ */
+bool8_t vkr_occlusion_buffer_init(VkrOcclusionBuffer *buffer,
+                                  VkrAllocator *allocator,
+                                  Mat4 view_projection,
+                                  uint32_t triangle_budget);
+
+/**
+ * @brief Clips and sets up every triangle of `source` under `model`.
+ *
+ * Back faces are dropped unless `double_sided`, since the GPU culls them and
+ * they hide nothing. The occluder is added whole or not at all.
+ *
+ * @return False when the occluder is over VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES
+ * or would overflow the triangle budget.
+ */
+bool8_t vkr_occlusion_add_occluder(VkrOcclusionBuffer *buffer, Mat4 model,
+                                   const VkrTriangleMeshSource *source,
+                                   bool8_t double_sided);
+
+/**
+ * @brief Rasterizes the added triangles and builds the tile depths.
+ *
+ * @param dispatch Runs one band per chunk; its job system may be NULL.
+ */
+void vkr_occlusion_rasterize(VkrOcclusionBuffer *buffer,
+                             VkrParallelFor *dispatch);
+
+/**
+ * @brief True when the local box [min_extents, max_extents] under `model` is
+ * hidden behind rasterized occluders. Safe to call from several threads.
+ */
+bool8_t vkr_occlusion_test_box(const VkrOcclusionBuffer *buffer, Mat4 model,
+                               Vec3 min_extents, Vec3 max_extents);
@@ -0,0 +1,177 @@
+/**
+ * @file vkr_pipeline_manifest.c
+ * @brief Content keys for pipeline descriptions and the manifest that records
+ * which of them the persisted pipeline cache already holds.
+ */
+
+#include "renderer/vkr_pipeline_manifest.h"
+
+#define VKR_PIPELINE_KEY_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+typedef struct VkrPipelineManifestHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t reserved;
+  uint64_t device_key;
+  /** Key over the entry array, to reject torn or edited files. */
+  uint64_t checksum;
+} VkrPipelineManifestHeader;
+
+vkr_internal INLINE uint64_t vkr_pipeline_key_mix(uint64_t key,
+                                                  uint64_t value) {
+  key = (key ^ value) * VKR_PIPELINE_KEY_MULTIPLIER;
+  return key ^ (key >> 32);
+}
+
+uint64_t vkr_pipeline_key_bytes(uint64_t key, const void *data,
+                                uint64_t size) {
+  const uint8_t *bytes = data;
+  uint64_t offset = 0u;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+    uint64_t word;
+    MemCopy(&word, bytes + offset, sizeof(word));
+    key = vkr_pipeline_key_mix(key, word);
+  }
+  if (offset < size) {
+    uint64_t tail = 0u;
+    MemCopy(&tail, bytes + offset, size - offset);
+    key = vkr_pipeline_key_mix(key, tail);
+  }
+  return vkr_pipeline_key_mix(key, size);
+}
+
+uint64_t vkr_pipeline_key_u32(uint64_t key, uint32_t value) {
+  return vkr_pipeline_key_mix(key, value);
+}
+
+uint64_t vkr_pipeline_key_string(uint64_t key, const char *value) {
+  return vkr_pipeline_key_bytes(key, value ? value : "",
+                                value ? string_length(value) : 0u);
+}
+
+uint64_t vkr_pipeline_code_key(const void *spirv, uint64_t size) {
+  return vkr_pipeline_key_bytes(VKR_PIPELINE_KEY_SEED, spirv, size);
+}
+
+uint64_t vkr_pipeline_name_id(const char *name) {
+  return vkr_pipeline_key_string(VKR_PIPELINE_KEY_SEED, name);
+}
+
+uint64_t vkr_pipeline_desc_key(const VkrPipelineDesc *desc) {
+  uint64_t key = vkr_pipeline_key_u32(VKR_PIPELINE_KEY_SEED, desc->kind);
+  const uint32_t stage_count = Min(desc->stage_count, VKR_PIPELINE_STAGE_MAX);
+  key = vkr_pipeline_key_u32(key, stage_count);
+  for (uint32_t i = 0u; i < stage_count; ++i) {
+    const VkrPipelineStageDesc *stage = &desc->stages[i];
+    key = vkr_pipeline_key_mix(key, stage->code_key);
+    key = vkr_pipeline_key_string(key, stage->entry);
+    key = vkr_pipeline_key_u32(key, stage->push_constant_size);
+  }
+  key = vkr_pipeline_key_u32(key, desc->layout.set_layout_count);
+  key = vkr_pipeline_key_u32(key, desc->layout.push_constant_size);
+  key = vkr_pipeline_key_u32(key, desc->layout.push_constant_stages);
+  return vkr_pipeline_key_bytes(key, desc->state,
+                                desc->state ? desc->state_size : 0u);
+}
+
+void vkr_pipeline_manifest_reset(VkrPipelineManifest *manifest,
+                                 uint64_t device_key) {
+  manifest->device_key = device_key;
+  manifest->entry_count = 0u;
+}
+
+const VkrPipelineManifestEntry *
+vkr_pipeline_manifest_find(const VkrPipelineManifest *manifest,
+                           uint64_t name_id) {
+  for (uint32_t i = 0u; i < manifest->entry_count; ++i) {
+    if (manifest->entries[i].name_id == name_id)
+      return &manifest->entries[i];
+  }
+  return NULL;
+}
+
+bool8_t vkr_pipeline_manifest_record(VkrPipelineManifest *manifest,
+                                     uint64_t name_id, uint64_t key,
+                                     uint64_t compile_ns) {
+  VkrPipelineManifestEntry *entry =
+      (VkrPipelineManifestEntry *)vkr_pipeline_manifest_find(manifest,
+                                                             name_id);
+  if (!entry) {
+    if (manifest->entry_count >= VKR_PIPELINE_MANIFEST_MAX_ENTRIES)
+      return false_v;
+    entry = &manifest->entries[manifest->entry_count++];
+  }
+  *entry = (VkrPipelineManifestEntry){
+      .name_id = name_id,
+      .key = key,
+      .compile_ns = compile_ns,
+  };
+  return true_v;
+}
+
+bool8_t vkr_pipeline_manifest_is_warm(const VkrPipelineManifest *manifest,
+                                      uint64_t device_key, uint64_t name_id,
+                                      uint64_t key) {
+  if (manifest->device_key == 0u || manifest->device_key != device_key)
+    return false_v;
+  const VkrPipelineManifestEntry *entry =
+      vkr_pipeline_manifest_find(manifest, name_id);
+  return entry && entry->key == key;
+}
+
+vkr_internal uint64_t
+vkr_pipeline_manifest_checksum(const VkrPipelineManifestEntry *entries,
+                               uint32_t entry_count) {
+  return vkr_pipeline_key_bytes(VKR_PIPELINE_KEY_SEED, entries,
+                                (uint64_t)entry_count * sizeof(*entries));
+}
+
+uint64_t vkr_pipeline_manifest_size(const VkrPipelineManifest *manifest) {
+  return sizeof(VkrPipelineManifestHeader) +
+         (uint64_t)manifest->entry_count * sizeof(VkrPipelineManifestEntry);
+}
+
+uint64_t vkr_pipeline_manifest_serialize(const VkrPipelineManifest *manifest,
+                                         void *buffer, uint64_t capacity) {
+  const uint64_t size = vkr_pipeline_manifest_size(manifest);
+  if (!buffer || capacity < size)
+    return 0u;
+  const VkrPipelineManifestHeader header = {
+      .magic = VKR_PIPELINE_MANIFEST_MAGIC,
+      .version = VKR_PIPELINE_MANIFEST_VERSION,
+      .entry_count = manifest->entry_count,
+      .device_key = manifest->device_key,
+      .checksum = vkr_pipeline_manifest_checksum(manifest->entries,
+                                                 manifest->entry_count),
+  };
+  uint8_t *bytes = buffer;
+  MemCopy(bytes, &header, sizeof(header));
+  MemCopy(bytes + sizeof(header), manifest->entries,
+          size - sizeof(header));
+  return size;
+}
+
+bool8_t vkr_pipeline_manifest_parse(const void *data, uint64_t size,
+                                    VkrPipelineManifest *out_manifest) {
+  vkr_pipeline_manifest_reset(out_manifest, 0u);
+  VkrPipelineManifestHeader header;
+  if (!data || size < sizeof(header))
+    return false_v;
+  MemCopy(&header, data, sizeof(header));
+  if (header.magic != VKR_PIPELINE_MANIFEST_MAGIC ||
+      header.version != VKR_PIPELINE_MANIFEST_VERSION ||
+      header.entry_count > VKR_PIPELINE_MANIFEST_MAX_ENTRIES ||
+      size != sizeof(header) + (uint64_t)header.entry_count *
+                                   sizeof(VkrPipelineManifestEntry))
+    return false_v;
+
+  MemCopy(out_manifest->entries, (const uint8_t *)data + sizeof(header),
+          size - sizeof(header));
+  if (vkr_pipeline_manifest_checksum(out_manifest->entries,
+                                     header.entry_count) != header.checksum)
+    return false_v;
+  out_manifest->device_key = header.device_key;
+  out_manifest->entry_count = header.entry_count;
+  return true_v;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file vkr_pipeline_manifest.h
+ * @brief Content keys for pipeline descriptions and the manifest that records
+ * which of them the persisted pipeline cache already holds.
+ *
+ * A driver pipeline cache is an opaque blob: it cannot say which pipelines it
+ * contains or whether they were built from the current shaders. The backend
+ * therefore keys every pipeline on what its compilation depends on (SPIR-V,
+ * entry points, the layout reflected from the shaders and the fixed-function
+ * state) and stores those keys next to the blob. On the next start a pipeline
+ * whose key is unchanged, on the same device and driver, is known to be warm
+ * and can be created from the cache on the calling thread; everything else is
+ * compiled in parallel. Nothing here touches a device, so keys and manifests
+ * are testable on their own.
+ */
+#pragma once
+
+#include "containers/str.h"
+#include "defines.h"
+
+#define VKR_PIPELINE_KEY_SEED 0xCBF29CE484222325ull
+#define VKR_PIPELINE_STAGE_MAX 2u
+#define VKR_PIPELINE_MANIFEST_MAX_ENTRIES 64u
+#define VKR_PIPELINE_MANIFEST_MAGIC 0x4D504B56u /* "VKPM" */
+#define VKR_PIPELINE_MANIFEST_VERSION 1u
+
+typedef enum VkrPipelineKind {
+  VKR_PIPELINE_KIND_GRAPHICS = 0,
+  VKR_PIPELINE_KIND_COMPUTE,
+} VkrPipelineKind;
+
+typedef struct VkrPipelineStageDesc {
+  /** vkr_pipeline_code_key() of the stage's SPIR-V module. */
+  uint64_t code_key;
+  const char *entry;
+  /** Push-constant block the entry point declares, from reflection. */
+  uint32_t push_constant_size;
+} VkrPipelineStageDesc;
+
+/** Pipeline layout as the backend creates it. */
+typedef struct VkrPipelineLayoutDesc {
+  uint32_t set_layout_count;
+  uint32_t push_constant_size;
+  uint32_t push_constant_stages;
+} VkrPipelineLayoutDesc;
+
+typedef struct VkrPipelineDesc {
+  const char *name;
+  VkrPipelineKind kind;
+  VkrPipelineStageDesc stages[VKR_PIPELINE_STAGE_MAX];
+  uint32_t stage_count;
+  VkrPipelineLayoutDesc layout;
+  /** Backend fixed-function state, hashed verbatim; must hold no padding. */
+  const void *state;
+  uint32_t state_size;
+} VkrPipelineDesc;
+
+typedef struct VkrPipelineManifestEntry {
+  uint64_t name_id;
+  uint64_t key;
+  /** Time the last cold compile of this key took. */
+  uint64_t compile_ns;
+} VkrPipelineManifestEntry;
+
+typedef struct VkrPipelineManifest {
+  /** Device, driver and cache format the recorded pipelines were built for. */
+  uint64_t device_key;
+  uint32_t entry_count;
+  VkrPipelineManifestEntry entries[VKR_PIPELINE_MANIFEST_MAX_ENTRIES];
+} VkrPipelineManifest;
+
+/** @brief Continues `key` over `size` bytes. */
+uint64_t vkr_pipeline_key_bytes(uint64_t key, const void *data, uint64_t size);
+
+uint64_t vkr_pipeline_key_u32(uint64_t key, uint32_t value);
+
+/** @brief Continues `key` over a string and its length; NULL hashes as "". */
+uint64_t vkr_pipeline_key_string(uint64_t key, const char *value);
+
+/** @brief Key of one SPIR-V module, hashed once and shared by its stages. */
+uint64_t vkr_pipeline_code_key(const void *spirv, uint64_t size);
+
+/** @brief Stable identity of a pipeline slot across runs. */
+uint64_t vkr_pipeline_name_id(const char *name);
+
+/**
+ * @brief Content key of a pipeline description.
+ *
+ * Covers everything compilation depends on; the name only identifies the slot
+ * and is not part of the key.
+ */
+uint64_t vkr_pipeline_desc_key(const VkrPipelineDesc *desc);
+
+/** @brief Empties `manifest` and binds it to `device_key`. */
+void vkr_pipeline_manifest_reset(VkrPipelineManifest *manifest,
+                                 uint64_t device_key);
+
+/** @return The entry recorded for `name_id`, or NULL. */
+const VkrPipelineManifestEntry *
+vkr_pipeline_manifest_find(const VkrPipelineManifest *manifest,
+                           uint64_t name_id);
+
+/**
+ * @brief Records `key` for `name_id`, replacing any earlier entry.
+ * @return False when the manifest is full.
+ */
+bool8_t vkr_pipeline_manifest_record(VkrPipelineManifest *manifest,
+                                     uint64_t name_id, uint64_t key,
+                                     uint64_t compile_ns);
+
+/**
+ * @brief True when `manifest` was written for `device_key` and records `key`
+ * for `name_id`, so the persisted cache should already hold the pipeline.
+ */
+bool8_t vkr_pipeline_manifest_is_warm(const VkrPipelineManifest *manifest,
+                                      uint64_t device_key, uint64_t name_id,
+                                      uint64_t key);
+
+/** @return Bytes vkr_pipeline_manifest_serialize() writes for `manifest`. */
+uint64_t vkr_pipeline_manifest_size(const VkrPipelineManifest *manifest);
+
+/**
+ * @brief Writes `manifest` in its file format.
+ * @return Bytes written, or 0 when `capacity` is too small.
+ */
+uint64_t vkr_pipeline_manifest_serialize(const VkrPipelineManifest *manifest,
+                                         void *buffer, uint64_t capacity);
+
+/**
+ * @brief Reads a manifest written by vkr_pipeline_manifest_serialize().
+ * @return False for truncated, corrupt or foreign data; `out_manifest` is
+ * then reset with a device key of 0.
+ */
+bool8_t vkr_pipeline_manifest_parse(const void *data, uint64_t size,
+                                    VkrPipelineManifest *out_manifest);
@@ -159,16 +159,41 @@ typedef struct VkrPreparedTextDraw {
 /**
  * @brief Payload for GPU-driven world stages and retained ordinary blend.
  */
+/**
+ * @brief Contiguous candidate rows that share geometry, submesh, material and
+ * state bucket.
+ *
+ * Runs index the candidate array they were built for and never overlap. A
+ * backend may issue one indirect command per run; rows still cull
+ * individually.
+ */
+typedef struct VkrWorldInstanceRun {
+  uint32_t first_candidate;
+  uint32_t instance_count;
+} VkrWorldInstanceRun;
+
 typedef struct VkrWorldPassPayload {
   const VkrWorldDrawCandidate *gpu_candidates;
   uint32_t gpu_candidate_count;
+  /** Optional instance runs over gpu_candidates, in row order. */
+  const VkrWorldInstanceRun *gpu_instance_runs;
+  uint32_t gpu_instance_run_count;
   /** Rows in gpu_candidates eligible for the camera opaque/cutout view. */
   uint32_t gpu_camera_opaque_candidate_count;
   /** Rows in gpu_candidates eligible for shadow-cascade views. */
   uint32_t gpu_shadow_candidate_count;
+  /** Changes whenever the camera-opaque rows of gpu_candidates may have
+   * changed; backends key occlusion history on it. 0 means unversioned and
+   * backends hash the rows instead. CPU occlusion culling moves rows in and
+   * out of the set without bumping it: history is only reused under an
+   * unchanged view-projection, for which that culling is deterministic. */
+  uint64_t opaque_set_version;
   /** Independent unculled transmissive stream consumed by Metal P12. */
   const VkrWorldDrawCandidate *transmission_gpu_candidates;
   uint32_t transmission_gpu_candidate_count;
+  /** Optional instance runs over transmission_gpu_candidates. */
+  const VkrWorldInstanceRun *transmission_instance_runs;
+  uint32_t transmission_instance_run_count;
   /** Camera-culled, back-to-front ordinary blend draws. */
   const VkrDrawItem *transparent_draws;
   uint32_t transparent_draw_count;
@@ -33,6 +33,7 @@ typedef enum VkrRendererBackendType {
   VKR_RENDERER_BACKEND_TYPE_VULKAN,
   VKR_RENDERER_BACKEND_TYPE_DX12, // Future
   VKR_RENDERER_BACKEND_TYPE_METAL,
+  VKR_RENDERER_BACKEND_TYPE_NULL, // Headless CPU benchmarking
   VKR_RENDERER_BACKEND_TYPE_COUNT
 } VkrRendererBackendType;
 
@@ -925,6 +926,14 @@ typedef struct VkrRendererBootMetrics {
   uint64_t target_ns;
   uint64_t systems_ns;
   uint64_t graph_ns;
+  /** Wall time to load shaders and create every backend pipeline. */
+  uint64_t pipelines_ns;
+  /** Sum and maximum of the pipeline compiles that missed the cache. */
+  uint64_t pipeline_compile_ns;
+  uint64_t pipeline_compile_max_ns;
+  uint32_t pipelines_compiled;
+  /** Pipelines created straight from the persisted pipeline cache. */
+  uint32_t pipelines_warm;
 } VkrRendererBootMetrics;
 
 typedef enum VkrBootProfile {
@@ -1016,6 +1025,8 @@ bool8_t vkr_renderer_subsystem_plan_includes(const VkrSubsystemPlan *plan,
 typedef struct VkrRendererBackendConfig {
   const char *application_name;
   VkrRendererBootMetrics *boot_metrics;
+  /** Optional; backends compile pipelines on it during initialization. */
+  VkrJobSystem *job_system;
   VkrPresentTargetConfig present_target;
   VkrPresentMode requested_present_mode;
   bool8_t capture_enabled;
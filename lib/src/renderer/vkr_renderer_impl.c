@@ -53,6 +53,15 @@ bool8_t vkr_renderer_impl_select(VkrRendererBackendType backend_type,
     };
     return true_v;
 
+  case VKR_RENDERER_BACKEND_TYPE_NULL:
+    *out_impl = (VkrRendererImpl){
+        .kind = VKR_RENDERER_IMPL_NULL,
+        .ops = strategies->null,
+        .caps = vkr_renderer_impl_default_caps(target_kind),
+        .initialization_supported = true_v,
+    };
+    return true_v;
+
   case VKR_RENDERER_BACKEND_TYPE_DX12:
   case VKR_RENDERER_BACKEND_TYPE_COUNT:
     return false_v;
@@ -5,6 +5,7 @@
 typedef enum VkrRendererImplKind {
   VKR_RENDERER_IMPL_METAL = 0,
   VKR_RENDERER_IMPL_VULKAN,
+  VKR_RENDERER_IMPL_NULL,
 } VkrRendererImplKind;
 
 /**
@@ -149,7 +150,10 @@ typedef struct VkrRendererImplPassTiming {
  * The byte counts are the work volume the durations describe, and they are not
  * optional. Candidate and instance bytes count rows actually written, so a
  * publication-boundary omission changes work volume instead of looking like a
- * faster pack.
+ * faster pack. `candidate_upload_bytes` is the part of those rows that reached
+ * GPU-visible memory: a backend that keeps rows resident across frames writes
+ * only rows that changed, and one that rewrites every row reports the full
+ * candidate and instance bytes.
  *
  * `geometry_table_build_ns` covers the geometry-row clear and rebuild. Vulkan
  * performs that as a separate capacity walk. Metal writes rows during candidate
@@ -165,6 +169,7 @@ typedef struct VkrPacketBuildMetrics {
   uint64_t geometry_table_build_ns;
   uint64_t candidate_row_bytes;
   uint64_t instance_row_bytes;
+  uint64_t candidate_upload_bytes;
   uint64_t geometry_row_bytes;
   bool8_t valid;
 } VkrPacketBuildMetrics;
@@ -252,6 +257,7 @@ typedef struct VkrRendererImplOps {
 typedef struct VkrRendererImplStrategies {
   const VkrRendererImplOps *metal;
   const VkrRendererImplOps *vulkan;
+  const VkrRendererImplOps *null;
 } VkrRendererImplStrategies;
 
 /** Coarse renderer implementation selected exactly once at initialization. */
@@ -265,7 +271,8 @@ typedef struct VkrRendererImpl {
 
 /**
  * Selects immutable implementation properties. Vulkan is the
- * production Windows strategy and remains unavailable elsewhere.
+ * production Windows strategy and remains unavailable elsewhere. The null
+ * strategy needs no device and initializes on every platform.
  */
 bool8_t vkr_renderer_impl_select(VkrRendererBackendType backend_type,
                                  VkrPresentTargetKind target_kind,
@@ -2,6 +2,7 @@
 
 #include "core/vkr_json_writer.h"
 #include "memory/vkr_allocator.h"
+#include "renderer/null/vkr_null_renderer.h"
 #include "renderer/vkr_render_graph.h"
 #include "renderer/vkr_renderer.h"
 #include "renderer/vulkan/vkr_vulkan_renderer.h"
@@ -347,6 +348,14 @@ bool8_t vkr_renderer_metrics_register(VkrRendererMetrics *renderer_metrics,
                    VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
   VKR_REGISTER_U64(world_max_batch_size, "draw.world.max_batch_size",
                    VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(ui_text_widgets, "draw.ui.text_widgets",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(ui_draw_calls_issued, "draw.ui.calls_issued",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(ui_widgets_rebuilt, "draw.ui.widgets_rebuilt",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(ui_rebuilt_bytes, "draw.ui.rebuilt_bytes",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_BYTES);
   VKR_REGISTER_U64_REQUIRED(lighting_point_selected, "lighting.point.selected",
                             VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
   VKR_REGISTER_U64_REQUIRED(lighting_point_dropped, "lighting.point.dropped",
@@ -372,6 +381,20 @@ bool8_t vkr_renderer_metrics_register(VkrRendererMetrics *renderer_metrics,
   VKR_REGISTER_U64(visibility_without_bounds,
                    "visibility.objects_without_bounds", VKR_METRIC_DOMAIN_DRAW,
                    VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(visibility_instance_runs_formed,
+                   "visibility.instance_runs.formed", VKR_METRIC_DOMAIN_DRAW,
+                   VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(visibility_instance_rows_saved,
+                   "visibility.instance_runs.rows_saved",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(visibility_culled_occlusion,
+                   "visibility.objects_culled_occlusion",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(visibility_occluders, "visibility.occlusion.occluders",
+                   VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(visibility_occluder_triangles,
+                   "visibility.occlusion.triangles", VKR_METRIC_DOMAIN_DRAW,
+                   VKR_METRIC_UNIT_COUNT);
   VKR_REGISTER_U64(visibility_candidate_count,
                    "visibility.gpu_candidates.count", VKR_METRIC_DOMAIN_DRAW,
                    VKR_METRIC_UNIT_COUNT);
@@ -535,10 +558,19 @@ bool8_t vkr_renderer_metrics_register(VkrRendererMetrics *renderer_metrics,
   VKR_REGISTER_PACKET_BUILD_NS(packet_geometry_table_build,
                                "cpu.packet_geometry_table_build");
 #undef VKR_REGISTER_PACKET_BUILD_NS
+  if (!vkr_renderer_metric_register(
+          metrics, "cpu.occlusion_raster", VKR_METRIC_DOMAIN_FRAME,
+          VKR_METRIC_KIND_DURATION, VKR_METRIC_UNIT_NANOSECONDS,
+          VKR_METRIC_SCALAR_U64, &ids->occlusion_raster)) {
+    return false_v;
+  }
   VKR_REGISTER_U64(packet_candidate_row_bytes, "packet.candidate_row_bytes",
                    VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_BYTES);
   VKR_REGISTER_U64(packet_instance_row_bytes, "packet.instance_row_bytes",
                    VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_BYTES);
+  VKR_REGISTER_U64(packet_candidate_upload_bytes,
+                   "packet.candidate_upload_bytes", VKR_METRIC_DOMAIN_DRAW,
+                   VKR_METRIC_UNIT_BYTES);
   VKR_REGISTER_U64(packet_geometry_row_bytes, "packet.geometry_row_bytes",
                    VKR_METRIC_DOMAIN_DRAW, VKR_METRIC_UNIT_BYTES);
 
@@ -553,7 +585,14 @@ bool8_t vkr_renderer_metrics_register(VkrRendererMetrics *renderer_metrics,
   VKR_REGISTER_BOOT(boot_systems, "boot.systems");
   VKR_REGISTER_BOOT(boot_graph, "boot.graph");
   VKR_REGISTER_BOOT(boot_scene, "boot.scene");
+  VKR_REGISTER_BOOT(boot_pipelines, "boot.pipelines");
+  VKR_REGISTER_BOOT(boot_pipeline_compile, "boot.pipeline_compile");
+  VKR_REGISTER_BOOT(boot_pipeline_compile_max, "boot.pipeline_compile_max");
 #undef VKR_REGISTER_BOOT
+  VKR_REGISTER_U64(boot_pipelines_compiled, "boot.pipelines_compiled",
+                   VKR_METRIC_DOMAIN_BOOT, VKR_METRIC_UNIT_COUNT);
+  VKR_REGISTER_U64(boot_pipelines_warm, "boot.pipelines_warm",
+                   VKR_METRIC_DOMAIN_BOOT, VKR_METRIC_UNIT_COUNT);
 
   VKR_REGISTER_U64(job_queue_depth, "job.queue_depth", VKR_METRIC_DOMAIN_JOB,
                    VKR_METRIC_UNIT_COUNT);
@@ -1064,12 +1103,15 @@ void vkr_renderer_metrics_collect(
                                 packet_build->geometry_table_build_ns);
     VKR_SET_U64(packet_candidate_row_bytes, packet_build->candidate_row_bytes);
     VKR_SET_U64(packet_instance_row_bytes, packet_build->instance_row_bytes);
+    VKR_SET_U64(packet_candidate_upload_bytes,
+                packet_build->candidate_upload_bytes);
     VKR_SET_U64(packet_geometry_row_bytes, packet_build->geometry_row_bytes);
   } else {
     const VkrMetricId packet_build_ids[] = {
         ids->packet_candidate_hash,       ids->packet_candidate_pack,
         ids->packet_geometry_table_build, ids->packet_candidate_row_bytes,
-        ids->packet_instance_row_bytes,   ids->packet_geometry_row_bytes,
+        ids->packet_instance_row_bytes,   ids->packet_candidate_upload_bytes,
+        ids->packet_geometry_row_bytes,
     };
     for (uint32_t i = 0u; i < ArrayCount(packet_build_ids); ++i) {
       vkr_metrics_mark(metrics, packet_build_ids[i],
@@ -1096,6 +1138,31 @@ void vkr_renderer_metrics_collect(
   VKR_SET_BOOT(boot_scene, renderer_metrics->boot_scene_ns);
 #undef VKR_SET_BOOT
 
+  /* A fully warm start compiles nothing, so zero compile time is a real
+     sample here; only a backend that never reported pipelines is missing. */
+  const VkrRendererBootMetrics *boot = &renderer->boot_metrics;
+  if (boot->pipelines_ns > 0) {
+    vkr_metrics_duration_add_ns(metrics, ids->boot_pipelines,
+                                boot->pipelines_ns);
+    vkr_metrics_duration_add_ns(metrics, ids->boot_pipeline_compile,
+                                boot->pipeline_compile_ns);
+    vkr_metrics_duration_add_ns(metrics, ids->boot_pipeline_compile_max,
+                                boot->pipeline_compile_max_ns);
+    VKR_SET_U64(boot_pipelines_compiled, boot->pipelines_compiled);
+    VKR_SET_U64(boot_pipelines_warm, boot->pipelines_warm);
+  } else {
+    const VkrMetricId pipeline_ids[] = {
+        ids->boot_pipelines,            ids->boot_pipeline_compile,
+        ids->boot_pipeline_compile_max, ids->boot_pipelines_compiled,
+        ids->boot_pipelines_warm,
+    };
+    for (uint32_t i = 0u; i < ArrayCount(pipeline_ids); ++i) {
+      vkr_metrics_mark(metrics, pipeline_ids[i],
+                       VKR_METRIC_AVAILABILITY_UNAVAILABLE,
+                       VKR_METRIC_REASON_NOT_READY);
+    }
+  }
+
   // Publishes a cumulative pull source as this frame's delta. `begin_frame`
   // zeroes counter slots, so a single add produces exactly the interval value.
 #define VKR_SET_DELTA(FIELD, BASELINE, VALUE)                                  \
@@ -1131,6 +1198,11 @@ void vkr_renderer_metrics_collect(
   VKR_SET_U64(world_indirect_calls_issued, world->indirect_calls_issued);
   VKR_SET_F64(world_avg_batch_size, world->avg_batch_size);
   VKR_SET_U64(world_max_batch_size, world->max_batch_size);
+  const VkrUiBatchMetrics *ui = &context->frame_metrics->ui;
+  VKR_SET_U64(ui_text_widgets, ui->text_widgets);
+  VKR_SET_U64(ui_draw_calls_issued, ui->draw_calls);
+  VKR_SET_U64(ui_widgets_rebuilt, ui->widgets_rebuilt);
+  VKR_SET_U64(ui_rebuilt_bytes, ui->rebuilt_bytes);
   VKR_SET_U64(lighting_point_selected,
               renderer->lighting_system.point_light_count);
   VKR_SET_U64(lighting_point_dropped,
@@ -1147,6 +1219,21 @@ void vkr_renderer_metrics_collect(
   VKR_SET_U64(visibility_objects_tested, visibility->objects_tested);
   VKR_SET_U64(visibility_culled_camera, visibility->objects_culled_camera);
   VKR_SET_U64(visibility_without_bounds, visibility->objects_without_bounds);
+  VKR_SET_U64(visibility_instance_runs_formed,
+              visibility->instance_runs_formed);
+  VKR_SET_U64(visibility_instance_rows_saved, visibility->instance_rows_saved);
+  VKR_SET_U64(visibility_culled_occlusion,
+              visibility->objects_culled_occlusion);
+  VKR_SET_U64(visibility_occluders, visibility->occluders_rasterized);
+  VKR_SET_U64(visibility_occluder_triangles, visibility->occluder_triangles);
+  if (visibility->occlusion_rasterized) {
+    vkr_metrics_duration_add_ns(metrics, ids->occlusion_raster,
+                                visibility->occlusion_raster_ns);
+  } else {
+    vkr_metrics_mark(metrics, ids->occlusion_raster,
+                     VKR_METRIC_AVAILABILITY_UNAVAILABLE,
+                     VKR_METRIC_REASON_NOT_SAMPLED);
+  }
   VKR_SET_U64(visibility_candidate_count, world->gpu_candidate_count);
   VKR_SET_U64(visibility_candidate_capacity, world->gpu_candidate_capacity);
   VKR_SET_U64(visibility_transmission_candidate_count,
@@ -1259,8 +1346,11 @@ void vkr_renderer_metrics_collect(
 
   VkrRenderGraphResourceStats rg = {0};
   const bool8_t rg_stats_valid =
-      renderer->impl.kind == VKR_RENDERER_IMPL_VULKAN &&
-      vkr_vulkan_renderer_graph_resource_stats(renderer->vulkan_renderer, &rg);
+      (renderer->impl.kind == VKR_RENDERER_IMPL_VULKAN &&
+       vkr_vulkan_renderer_graph_resource_stats(renderer->vulkan_renderer,
+                                                &rg)) ||
+      (renderer->impl.kind == VKR_RENDERER_IMPL_NULL &&
+       vkr_null_renderer_graph_resource_stats(renderer->null_renderer, &rg));
   if (rg_stats_valid) {
     VKR_SET_U64(rg_live_images, rg.live_image_textures);
     VKR_SET_U64(rg_peak_images, rg.peak_image_textures);
@@ -1400,9 +1490,12 @@ void vkr_renderer_metrics_collect(
 
   // Vulkan constructs its complete immutable pipeline set during
   // renderer initialization. No vkCreate*Pipelines call is reachable from a
-  // prepared frame, so the per-frame creation counter is valid and zero.
-  if (vkr_renderer_get_backend_type(context->renderer) ==
-      VKR_RENDERER_BACKEND_TYPE_VULKAN) {
+  // prepared frame, so the per-frame creation counter is valid and zero. The
+  // null backend creates no pipelines at all.
+  const VkrRendererBackendType backend_type =
+      vkr_renderer_get_backend_type(context->renderer);
+  if (backend_type == VKR_RENDERER_BACKEND_TYPE_VULKAN ||
+      backend_type == VKR_RENDERER_BACKEND_TYPE_NULL) {
     vkr_metrics_counter_add(metrics, ids->pipelines_created, 0u);
   } else {
     vkr_metrics_mark(metrics, ids->pipelines_created,
@@ -1500,6 +1593,12 @@ vkr_renderer_metrics_read_frame(const VkrRendererMetrics *renderer_metrics,
       world->avg_batch_size = (float32_t)avg_batch_size;
     }
 
+    VkrUiBatchMetrics *ui = &out_frame_metrics->ui;
+    VKR_READ_U32(ui->text_widgets, ids->ui_text_widgets);
+    VKR_READ_U32(ui->draw_calls, ids->ui_draw_calls_issued);
+    VKR_READ_U32(ui->widgets_rebuilt, ids->ui_widgets_rebuilt);
+    VKR_READ_U64(ui->rebuilt_bytes, ids->ui_rebuilt_bytes);
+
     VkrShadowMetrics *shadow = &out_frame_metrics->shadow;
     for (uint32_t i = 0; i < VKR_SHADOW_CASCADE_COUNT_MAX; ++i) {
       VKR_READ_U32(shadow->shadow_indirect_draws_opaque[i],
@@ -1518,6 +1617,16 @@ vkr_renderer_metrics_read_frame(const VkrRendererMetrics *renderer_metrics,
                  ids->visibility_culled_camera);
     VKR_READ_U32(out_visibility->objects_without_bounds,
                  ids->visibility_without_bounds);
+    VKR_READ_U32(out_visibility->instance_runs_formed,
+                 ids->visibility_instance_runs_formed);
+    VKR_READ_U32(out_visibility->instance_rows_saved,
+                 ids->visibility_instance_rows_saved);
+    VKR_READ_U32(out_visibility->objects_culled_occlusion,
+                 ids->visibility_culled_occlusion);
+    VKR_READ_U32(out_visibility->occluders_rasterized,
+                 ids->visibility_occluders);
+    VKR_READ_U32(out_visibility->occluder_triangles,
+                 ids->visibility_occluder_triangles);
   }
 
   if (out_rg_stats) {
@@ -1557,6 +1666,8 @@ vkr_internal const char *vkr_metric_kind_name(VkrMetricKind kind) {
     return "gauge";
   case VKR_METRIC_KIND_DURATION:
     return "duration";
+  case VKR_METRIC_KIND_HISTOGRAM:
+    return "histogram";
   default:
     return "unknown";
   }
@@ -1602,8 +1713,29 @@ vkr_internal bool8_t vkr_json_cstr(VkrJsonWriter *writer, const char *value) {
       string8_create_from_cstr((const uint8_t *)value, string_length(value)));
 }
 
+/** Percentile object, or null when the distribution is empty. */
+vkr_internal bool8_t vkr_renderer_metric_write_percentiles(
+    VkrJsonWriter *writer, const VkrMetricsFrame *frame, VkrMetricId id,
+    VkrMetricHistogramRange range) {
+  VkrMetricPercentiles percentiles = {0};
+  if (!vkr_metrics_frame_read_percentiles(frame, id, range, &percentiles)) {
+    return vkr_json_writer_null(writer);
+  }
+  return vkr_json_writer_begin_object(writer) &&
+         vkr_json_name(writer, "p50_ns") &&
+         vkr_json_writer_u64(writer, percentiles.p50_ns) &&
+         vkr_json_name(writer, "p90_ns") &&
+         vkr_json_writer_u64(writer, percentiles.p90_ns) &&
+         vkr_json_name(writer, "p99_ns") &&
+         vkr_json_writer_u64(writer, percentiles.p99_ns) &&
+         vkr_json_name(writer, "p999_ns") &&
+         vkr_json_writer_u64(writer, percentiles.p999_ns) &&
+         vkr_json_writer_end_object(writer);
+}
+
 vkr_internal bool8_t vkr_renderer_metric_write_sample(
-    VkrJsonWriter *writer, const VkrMetricCatalogEntry *entry,
+    VkrJsonWriter *writer, const VkrMetricsFrame *frame,
+    const VkrMetricCatalogEntry *entry, VkrMetricId id,
     const VkrMetricSample *sample) {
   if (!vkr_json_writer_begin_object(writer) || !vkr_json_name(writer, "name") ||
       !vkr_json_writer_string(
@@ -1627,6 +1759,26 @@ vkr_internal bool8_t vkr_renderer_metric_write_sample(
     if (!vkr_json_writer_null(writer)) {
       return false_v;
     }
+  } else if (entry->kind == VKR_METRIC_KIND_HISTOGRAM) {
+    const VkrMetricHistogramSample *histogram = &sample->value.histogram;
+    if (!vkr_json_writer_begin_object(writer) ||
+        !vkr_json_name(writer, "sum_ns") ||
+        !vkr_json_writer_u64(writer, histogram->sum_ns) ||
+        !vkr_json_name(writer, "count") ||
+        !vkr_json_writer_u64(writer, histogram->count) ||
+        !vkr_json_name(writer, "min_ns") ||
+        !vkr_json_writer_u64(writer, histogram->min_ns) ||
+        !vkr_json_name(writer, "max_ns") ||
+        !vkr_json_writer_u64(writer, histogram->max_ns) ||
+        !vkr_json_name(writer, "frame") ||
+        !vkr_renderer_metric_write_percentiles(
+            writer, frame, id, VKR_METRIC_HISTOGRAM_RANGE_FRAME) ||
+        !vkr_json_name(writer, "window") ||
+        !vkr_renderer_metric_write_percentiles(
+            writer, frame, id, VKR_METRIC_HISTOGRAM_RANGE_WINDOW) ||
+        !vkr_json_writer_end_object(writer)) {
+      return false_v;
+    }
   } else if (entry->kind == VKR_METRIC_KIND_DURATION) {
     if (!vkr_json_writer_begin_object(writer) ||
         !vkr_json_name(writer, "sum_ns") ||
@@ -1702,6 +1854,10 @@ bool8_t vkr_renderer_metrics_write_json(VkrRendererMetrics *renderer_metrics,
         vkr_json_name(writer, "event_subjects") &&
         vkr_json_writer_bool(
             writer, renderer_metrics->metrics->config.event_subjects) &&
+        vkr_json_name(writer, "histogram_export_interval") &&
+        vkr_json_writer_u64(
+            writer,
+            renderer_metrics->metrics->config.histogram_export_interval) &&
         vkr_json_writer_end_object(writer) &&
         vkr_json_name(writer, "cpu_frame_index") &&
         vkr_json_writer_u64(writer, snapshot.frame->cpu_frame_index) &&
@@ -1723,8 +1879,10 @@ bool8_t vkr_renderer_metrics_write_json(VkrRendererMetrics *renderer_metrics,
       vkr_metrics_get_catalog(renderer_metrics->metrics, &catalog_count);
   for (uint32_t i = 0;
        success && i < snapshot.frame->slot_count && i < catalog_count; ++i) {
-    success = vkr_renderer_metric_write_sample(writer, &catalog[i],
-                                               &snapshot.frame->samples[i]);
+    const VkrMetricId id =
+        ((VkrMetricId)snapshot.frame->registry_generation << 16u) | i;
+    success = vkr_renderer_metric_write_sample(
+        writer, snapshot.frame, &catalog[i], id, &snapshot.frame->samples[i]);
   }
   if (success) {
     success = vkr_json_writer_end_array(writer) &&
@@ -1815,6 +1973,8 @@ bool8_t vkr_renderer_metrics_write_json(VkrRendererMetrics *renderer_metrics,
         vkr_json_writer_u64(writer, event.duration_ns) &&
         vkr_json_name(writer, "bytes") &&
         vkr_json_writer_u64(writer, event.bytes) &&
+        vkr_json_name(writer, "percentile_bp") &&
+        vkr_json_writer_u64(writer, event.percentile_bp) &&
         vkr_json_name(writer, "thread_id") &&
         vkr_json_writer_u64(writer, event.thread_id) &&
         vkr_json_name(writer, "subject_truncated") &&
@@ -84,6 +84,10 @@ typedef struct VkrRendererMetricIds {
   VkrMetricId world_indirect_calls_issued;
   VkrMetricId world_avg_batch_size;
   VkrMetricId world_max_batch_size;
+  VkrMetricId ui_text_widgets;
+  VkrMetricId ui_draw_calls_issued;
+  VkrMetricId ui_widgets_rebuilt;
+  VkrMetricId ui_rebuilt_bytes;
   VkrMetricId lighting_point_selected;
   VkrMetricId lighting_point_dropped;
   VkrMetricId lighting_point_grid_cells;
@@ -94,6 +98,11 @@ typedef struct VkrRendererMetricIds {
   VkrMetricId visibility_objects_tested;
   VkrMetricId visibility_culled_camera;
   VkrMetricId visibility_without_bounds;
+  VkrMetricId visibility_instance_runs_formed;
+  VkrMetricId visibility_instance_rows_saved;
+  VkrMetricId visibility_culled_occlusion;
+  VkrMetricId visibility_occluders;
+  VkrMetricId visibility_occluder_triangles;
   VkrMetricId visibility_candidate_count;
   VkrMetricId visibility_candidate_capacity;
   VkrMetricId visibility_gpu_visible_count;
@@ -145,8 +154,10 @@ typedef struct VkrRendererMetricIds {
   VkrMetricId packet_candidate_hash;
   VkrMetricId packet_candidate_pack;
   VkrMetricId packet_geometry_table_build;
+  VkrMetricId occlusion_raster;
   VkrMetricId packet_candidate_row_bytes;
   VkrMetricId packet_instance_row_bytes;
+  VkrMetricId packet_candidate_upload_bytes;
   VkrMetricId packet_geometry_row_bytes;
 
   VkrMetricId upload_fence_waits;
@@ -162,6 +173,11 @@ typedef struct VkrRendererMetricIds {
   VkrMetricId boot_systems;
   VkrMetricId boot_graph;
   VkrMetricId boot_scene;
+  VkrMetricId boot_pipelines;
+  VkrMetricId boot_pipeline_compile;
+  VkrMetricId boot_pipeline_compile_max;
+  VkrMetricId boot_pipelines_compiled;
+  VkrMetricId boot_pipelines_warm;
 
   VkrMetricId job_queue_depth;
   VkrMetricId job_workers_busy;
@@ -0,0 +1,336 @@
+#include "renderer/vkr_row_table.h"
+
+#define VKR_ROW_TABLE_MIN_CAPACITY 64u
+
+vkr_internal void vkr_row_table_free_storage(VkrRowTable *table) {
+  const uint64_t row_bytes = (uint64_t)table->capacity * table->row_size;
+  if (table->resident)
+    vkr_allocator_free(table->allocator, table->resident, row_bytes,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (table->staged)
+    vkr_allocator_free(table->allocator, table->staged, row_bytes,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (table->ranges)
+    vkr_allocator_free(table->allocator, table->ranges,
+                       (uint64_t)table->capacity * sizeof(VkrRowTableRange),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  table->resident = NULL;
+  table->staged = NULL;
+  table->ranges = NULL;
+  table->capacity = 0u;
+}
+
+vkr_internal bool8_t vkr_row_table_grow(VkrRowTable *table,
+                                        uint32_t row_count) {
+  uint64_t capacity = VKR_ROW_TABLE_MIN_CAPACITY;
+  while (capacity < row_count)
+    capacity <<= 1u;
+  if (capacity > UINT32_MAX)
+    capacity = row_count;
+
+  const uint64_t row_bytes = capacity * table->row_size;
+  uint8_t *resident = vkr_allocator_alloc(table->allocator, row_bytes,
+                                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint8_t *staged = vkr_allocator_alloc(table->allocator, row_bytes,
+                                        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrRowTableRange *ranges =
+      vkr_allocator_alloc(table->allocator, capacity * sizeof(*ranges),
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!resident || !staged || !ranges) {
+    if (resident)
+      vkr_allocator_free(table->allocator, resident, row_bytes,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (staged)
+      vkr_allocator_free(table->allocator, staged, row_bytes,
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (ranges)
+      vkr_allocator_free(table->allocator, ranges, capacity * sizeof(*ranges),
+                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+
+  const uint32_t resident_count = table->resident_count;
+  if (resident_count)
+    MemCopy(resident, table->resident,
+            (uint64_t)resident_count * table->row_size);
+  vkr_row_table_free_storage(table);
+  table->resident = resident;
+  table->staged = staged;
+  table->ranges = ranges;
+  table->capacity = (uint32_t)capacity;
+  table->resident_count = resident_count;
+  return true_v;
+}
+
+bool8_t vkr_row_table_create(VkrRowTable *table, VkrAllocator *allocator,
+                             uint32_t row_size, uint32_t merge_gap) {
+  if (!table || !allocator || !row_size)
+    return false_v;
+  MemZero(table, sizeof(*table));
+  table->allocator = allocator;
+  table->row_size = row_size;
+  table->merge_gap = merge_gap;
+  return true_v;
+}
+
+void vkr_row_table_destroy(VkrRowTable *table) {
+  if (!table || !table->allocator)
+    return;
+  vkr_row_table_free_storage(table);
+  MemZero(table, sizeof(*table));
+}
+
+void *vkr_row_table_begin(VkrRowTable *table, uint32_t row_count) {
+  table->staged_count = 0u;
+  table->range_count = 0u;
+  if (!row_count ||
+      (row_count > table->capacity && !vkr_row_table_grow(table, row_count)))
+    return NULL;
+  table->staged_count = row_count;
+  return table->staged;
+}
+
+uint32_t vkr_row_table_commit(VkrRowTable *table, uint32_t row_count,
+                              const VkrRowTableRange **out_ranges) {
+  table->range_count = 0u;
+  if (out_ranges)
+    *out_ranges = table->ranges;
+  if (row_count > table->staged_count) {
+    table->staged_count = 0u;
+    return 0u;
+  }
+
+  const uint32_t row_size = table->row_size;
+  const uint32_t compared = Min(row_count, table->resident_count);
+  uint32_t range_count = 0u;
+  uint32_t dirty_rows = 0u;
+  for (uint32_t row = 0u; row < row_count; ++row) {
+    if (row < compared &&
+        MemCompare(table->staged + (uint64_t)row * row_size,
+                   table->resident + (uint64_t)row * row_size,
+                   row_size) == 0)
+      continue;
+    VkrRowTableRange *last =
+        range_count ? &table->ranges[range_count - 1u] : NULL;
+    const uint32_t last_end = last ? last->first_row + last->row_count : 0u;
+    if (last && row - last_end <= table->merge_gap) {
+      dirty_rows += row + 1u - last_end;
+      last->row_count = row + 1u - last->first_row;
+      continue;
+    }
+    table->ranges[range_count++] = (VkrRowTableRange){
+        .first_row = row,
+        .row_count = 1u,
+    };
+    dirty_rows++;
+  }
+
+  uint8_t *swap = table->resident;
+  table->resident = table->staged;
+  table->staged = swap;
+  table->resident_count = row_count;
+  table->staged_count = 0u;
+  table->range_count = range_count;
+  table->stats = (VkrRowTableStats){
+      .rows = row_count,
+      .dirty_rows = dirty_rows,
+      .ranges = range_count,
+      .upload_bytes = (uint64_t)dirty_rows * row_size,
+  };
+  return range_count;
+}
+
+const void *vkr_row_table_rows(const VkrRowTable *table) {
+  return table->resident;
+}
+
+void vkr_row_table_invalidate(VkrRowTable *table) {
+  table->resident_count = 0u;
+}
+
+vkr_internal uint32_t vkr_row_slot_map_hash(VkrRowSlotKey key) {
+  uint64_t hash = key.owner * 0x9E3779B97F4A7C15ull;
+  hash ^= key.part + 0x632BE59BD9B4E019ull + (hash << 6) + (hash >> 2);
+  hash ^= hash >> 31;
+  hash *= 0xBF58476D1CE4E5B9ull;
+  return (uint32_t)(hash ^ (hash >> 29));
+}
+
+vkr_internal void vkr_row_slot_map_free_storage(VkrRowSlotMap *map) {
+  if (map->keys)
+    vkr_allocator_free(map->allocator, map->keys,
+                       (uint64_t)map->capacity * sizeof(*map->keys),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (map->stamps)
+    vkr_allocator_free(map->allocator, map->stamps,
+                       (uint64_t)map->capacity * sizeof(*map->stamps),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (map->free_slots)
+    vkr_allocator_free(map->allocator, map->free_slots,
+                       (uint64_t)map->capacity * sizeof(*map->free_slots),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (map->buckets)
+    vkr_allocator_free(map->allocator, map->buckets,
+                       (uint64_t)map->bucket_count * sizeof(*map->buckets),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  map->keys = NULL;
+  map->stamps = NULL;
+  map->free_slots = NULL;
+  map->buckets = NULL;
+  map->capacity = 0u;
+  map->bucket_count = 0u;
+}
+
+vkr_internal void vkr_row_slot_map_insert(VkrRowSlotMap *map, uint32_t slot) {
+  const uint32_t mask = map->bucket_count - 1u;
+  uint32_t bucket = vkr_row_slot_map_hash(map->keys[slot]) & mask;
+  while (map->buckets[bucket])
+    bucket = (bucket + 1u) & mask;
+  map->buckets[bucket] = slot + 1u;
+}
+
+/** Backward-shift deletion, so probes never need tombstones. */
+vkr_internal void vkr_row_slot_map_remove(VkrRowSlotMap *map, uint32_t slot) {
+  const uint32_t mask = map->bucket_count - 1u;
+  uint32_t hole = vkr_row_slot_map_hash(map->keys[slot]) & mask;
+  while (map->buckets[hole] != slot + 1u)
+    hole = (hole + 1u) & mask;
+  for (uint32_t bucket = (hole + 1u) & mask; map->buckets[bucket];
+       bucket = (bucket + 1u) & mask) {
+    const uint32_t home =
+        vkr_row_slot_map_hash(map->keys[map->buckets[bucket] - 1u]) & mask;
+    if (((bucket - home) & mask) >= ((bucket - hole) & mask)) {
+      map->buckets[hole] = map->buckets[bucket];
+      hole = bucket;
+    }
+  }
+  map->buckets[hole] = 0u;
+}
+
+vkr_internal bool8_t vkr_row_slot_map_grow(VkrRowSlotMap *map,
+                                           uint32_t slot_count) {
+  uint64_t capacity = VKR_ROW_TABLE_MIN_CAPACITY;
+  while (capacity < slot_count)
+    capacity <<= 1u;
+  if (capacity > UINT32_MAX / 2u)
+    return false_v;
+  const uint64_t bucket_count = capacity * 2u;
+
+  VkrRowSlotMap grown = {
+      .allocator = map->allocator,
+      .capacity = (uint32_t)capacity,
+      .slot_count = map->slot_count,
+      .live_count = map->live_count,
+      .free_count = map->free_count,
+      .bucket_count = (uint32_t)bucket_count,
+      .frame = map->frame,
+  };
+  grown.keys = vkr_allocator_alloc(map->allocator,
+                                   capacity * sizeof(*grown.keys),
+                                   VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  grown.stamps = vkr_allocator_alloc(map->allocator,
+                                     capacity * sizeof(*grown.stamps),
+                                     VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  grown.free_slots = vkr_allocator_alloc(map->allocator,
+                                         capacity * sizeof(*grown.free_slots),
+                                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  grown.buckets = vkr_allocator_alloc(map->allocator,
+                                      bucket_count * sizeof(*grown.buckets),
+                                      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!grown.keys || !grown.stamps || !grown.free_slots || !grown.buckets) {
+    vkr_row_slot_map_free_storage(&grown);
+    return false_v;
+  }
+
+  if (map->slot_count) {
+    MemCopy(grown.keys, map->keys,
+            (uint64_t)map->slot_count * sizeof(*map->keys));
+    MemCopy(grown.stamps, map->stamps,
+            (uint64_t)map->slot_count * sizeof(*map->stamps));
+  }
+  if (map->free_count)
+    MemCopy(grown.free_slots, map->free_slots,
+            (uint64_t)map->free_count * sizeof(*map->free_slots));
+  MemZero(grown.buckets, bucket_count * sizeof(*grown.buckets));
+  for (uint32_t slot = 0u; slot < grown.slot_count; ++slot)
+    if (grown.stamps[slot])
+      vkr_row_slot_map_insert(&grown, slot);
+  vkr_row_slot_map_free_storage(map);
+  *map = grown;
+  return true_v;
+}
+
+bool8_t vkr_row_slot_map_create(VkrRowSlotMap *map, VkrAllocator *allocator) {
+  if (!map || !allocator)
+    return false_v;
+  MemZero(map, sizeof(*map));
+  map->allocator = allocator;
+  return true_v;
+}
+
+void vkr_row_slot_map_destroy(VkrRowSlotMap *map) {
+  if (!map || !map->allocator)
+    return;
+  vkr_row_slot_map_free_storage(map);
+  MemZero(map, sizeof(*map));
+}
+
+bool8_t vkr_row_slot_map_begin(VkrRowSlotMap *map, uint32_t max_rows) {
+  if (map->slot_count > VKR_ROW_TABLE_MIN_CAPACITY &&
+      map->live_count * 2u < map->slot_count)
+    vkr_row_slot_map_reset(map);
+  map->frame++;
+  const uint64_t slot_count = (uint64_t)map->slot_count + max_rows;
+  return slot_count <= map->capacity ||
+         (slot_count <= UINT32_MAX &&
+          vkr_row_slot_map_grow(map, (uint32_t)slot_count));
+}
+
+uint32_t vkr_row_slot_map_acquire(VkrRowSlotMap *map, VkrRowSlotKey key) {
+  const uint32_t mask = map->bucket_count - 1u;
+  uint32_t bucket = vkr_row_slot_map_hash(key) & mask;
+  for (; map->buckets[bucket]; bucket = (bucket + 1u) & mask) {
+    const uint32_t slot = map->buckets[bucket] - 1u;
+    if (map->stamps[slot] != map->frame &&
+        map->keys[slot].owner == key.owner &&
+        map->keys[slot].part == key.part) {
+      map->stamps[slot] = map->frame;
+      return slot;
+    }
+  }
+
+  const uint32_t slot = map->free_count ? map->free_slots[--map->free_count]
+                                        : map->slot_count++;
+  map->keys[slot] = key;
+  map->stamps[slot] = map->frame;
+  map->buckets[bucket] = slot + 1u;
+  return slot;
+}
+
+void vkr_row_slot_map_end(VkrRowSlotMap *map) {
+  uint32_t live_count = 0u;
+  for (uint32_t slot = 0u; slot < map->slot_count; ++slot) {
+    if (map->stamps[slot] == map->frame) {
+      live_count++;
+      continue;
+    }
+    if (!map->stamps[slot])
+      continue;
+    vkr_row_slot_map_remove(map, slot);
+    map->stamps[slot] = 0u;
+    map->free_slots[map->free_count++] = slot;
+  }
+  map->live_count = live_count;
+}
+
+bool8_t vkr_row_slot_map_live(const VkrRowSlotMap *map, uint32_t slot) {
+  return slot < map->slot_count && map->stamps[slot] == map->frame;
+}
+
+void vkr_row_slot_map_reset(VkrRowSlotMap *map) {
+  if (map->buckets)
+    MemZero(map->buckets, (uint64_t)map->bucket_count * sizeof(*map->buckets));
+  map->slot_count = 0u;
+  map->live_count = 0u;
+  map->free_count = 0u;
+}
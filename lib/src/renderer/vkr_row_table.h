@@ -0,0 +1,152 @@
+/**
+ * @file vkr_row_table.h
+ * @brief CPU mirror of a persistent GPU row table that encodes each frame's
+ * changes as dirty row ranges.
+ *
+ * World candidate and instance rows are rebuilt every frame, but in a mostly
+ * static scene nearly all of them come out identical to what the GPU already
+ * holds. A row table keeps the rows its destination currently holds. Each
+ * frame the backend packs the new rows into the table's staging array, and
+ * committing compares them with the resident rows and returns the ranges that
+ * changed. The backend writes only those ranges; the staged rows then become
+ * the resident ones.
+ *
+ * The table owns no GPU memory and never interprets row contents, so one
+ * table mirrors exactly one destination. A destination that loses its
+ * contents, for example because it was reallocated, must be invalidated so
+ * the next commit rewrites every row.
+ *
+ * Comparing by position only pays off when a row keeps its position. Rows
+ * that come out of a per-frame sort shift whenever one is inserted or removed
+ * ahead of them, so a row slot map gives each source row a slot that holds
+ * from frame to frame. Slots released by rows that disappear are reused by
+ * new ones, so an insert or removal dirties only the slots it touches.
+ */
+#pragma once
+
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+
+/** Rows [first_row, first_row + row_count) differ from the destination. */
+typedef struct VkrRowTableRange {
+  uint32_t first_row;
+  uint32_t row_count;
+} VkrRowTableRange;
+
+/** Counters for the last commit. */
+typedef struct VkrRowTableStats {
+  uint32_t rows;
+  /** Rows inside emitted ranges, including clean rows merged into a gap. */
+  uint32_t dirty_rows;
+  uint32_t ranges;
+  uint64_t upload_bytes;
+} VkrRowTableStats;
+
+typedef struct VkrRowTable {
+  VkrAllocator *allocator;
+  uint32_t row_size;
+  /** Clean rows between two dirty ranges that are rewritten to join them. */
+  uint32_t merge_gap;
+  uint32_t capacity;
+  /** Leading rows of `resident` that match the destination. */
+  uint32_t resident_count;
+  /** Rows handed out by the open begin; zero when none is open. */
+  uint32_t staged_count;
+  uint8_t *resident;
+  uint8_t *staged;
+  VkrRowTableRange *ranges;
+  uint32_t range_count;
+  VkrRowTableStats stats;
+} VkrRowTable;
+
+/** @brief Creates an empty table; row storage is allocated on first use. */
+bool8_t vkr_row_table_create(VkrRowTable *table, VkrAllocator *allocator,
+                             uint32_t row_size, uint32_t merge_gap);
+
+void vkr_row_table_destroy(VkrRowTable *table);
+
+/**
+ * @brief Returns `row_count` writable rows for this frame, growing storage as
+ * needed. Growth keeps the resident rows, so it does not dirty the table.
+ *
+ * @return NULL when storage cannot grow or `row_count` is zero.
+ */
+void *vkr_row_table_begin(VkrRowTable *table, uint32_t row_count);
+
+/**
+ * @brief Compares the first `row_count` staged rows with the resident rows
+ * and makes them resident.
+ *
+ * Rows past the previous resident count are always dirty. `row_count` may be
+ * smaller than the count passed to begin, for rows the caller chose to skip.
+ *
+ * @param out_ranges Receives the dirty ranges in row order, valid until the
+ * next begin.
+ * @return The number of dirty ranges.
+ */
+uint32_t vkr_row_table_commit(VkrRowTable *table, uint32_t row_count,
+                              const VkrRowTableRange **out_ranges);
+
+/** Resident rows, as the destination holds them after the last commit. */
+const void *vkr_row_table_rows(const VkrRowTable *table);
+
+/** Forgets the resident rows so the next commit rewrites every row. */
+void vkr_row_table_invalidate(VkrRowTable *table);
+
+/**
+ * Identifies one source row across frames. Keys only decide placement; a key
+ * that is reused by different contents keeps its slot and the row table diff
+ * still rewrites it.
+ */
+typedef struct VkrRowSlotKey {
+  uint64_t owner;
+  uint64_t part;
+} VkrRowSlotKey;
+
+typedef struct VkrRowSlotMap {
+  VkrAllocator *allocator;
+  uint32_t capacity;
+  /** Slots in use or on the free list; rows [0, slot_count) are staged. */
+  uint32_t slot_count;
+  /** Slots acquired by the last closed frame. */
+  uint32_t live_count;
+  uint32_t free_count;
+  uint32_t bucket_count;
+  uint64_t frame;
+  VkrRowSlotKey *keys;
+  /** Frame each slot was last acquired in; zero for a free slot. */
+  uint64_t *stamps;
+  uint32_t *free_slots;
+  /** Open addressing over slot + 1; zero marks an empty bucket. */
+  uint32_t *buckets;
+} VkrRowSlotMap;
+
+bool8_t vkr_row_slot_map_create(VkrRowSlotMap *map, VkrAllocator *allocator);
+
+void vkr_row_slot_map_destroy(VkrRowSlotMap *map);
+
+/**
+ * @brief Opens a frame that acquires at most `max_rows` slots.
+ *
+ * When fewer than half the slots were live last frame the map is compacted
+ * first: every slot is released, so the next commit is one positional
+ * rewrite and the rows that follow are dense again.
+ */
+bool8_t vkr_row_slot_map_begin(VkrRowSlotMap *map, uint32_t max_rows);
+
+/**
+ * @brief Returns the slot of `key`, reusing the one it held last frame.
+ *
+ * A key acquired n times in one frame holds n slots, and keeps them while it
+ * keeps being acquired n times.
+ */
+uint32_t vkr_row_slot_map_acquire(VkrRowSlotMap *map, VkrRowSlotKey key);
+
+/** Releases every slot the frame did not acquire. */
+void vkr_row_slot_map_end(VkrRowSlotMap *map);
+
+/** True when `slot` was acquired by the current frame. */
+bool8_t vkr_row_slot_map_live(const VkrRowSlotMap *map, uint32_t slot);
+
+/** Releases every slot, for a destination that is rebuilt from scratch. */
+void vkr_row_slot_map_reset(VkrRowSlotMap *map);
@@ -0,0 +1,583 @@
+#include "renderer/vkr_texture_convert.h"
+
+#include "math/vkr_simd.h"
+#include "renderer/vkr_ibl_math.h"
+
+#include <float.h>
+
+#if VKR_SIMD_ARM_NEON && defined(__aarch64__)
+#define VKR_TEXTURE_CONVERT_NEON 1
+#elif defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define VKR_TEXTURE_CONVERT_F16C 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define VKR_TEXTURE_CONVERT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(VKR_TEXTURE_CONVERT_NEON)
+#define VKR_TEXTURE_ANALYZE_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#define VKR_TEXTURE_ANALYZE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/** Pixels an HDR conversion stages as RGBA floats before narrowing. */
+#define VKR_TEXTURE_CONVERT_CHUNK 256u
+/** Largest finite half float. */
+#define VKR_TEXTURE_CONVERT_HALF_MAX 65504.0f
+/** sRGB inputs at or below this decode on the linear segment. */
+#define VKR_TEXTURE_CONVERT_SRGB_KNEE 0.04045f
+/**
+ * Pixels RGBA8 analysis counts in 32-bit lanes before folding the lane totals
+ * into the 64-bit counters.
+ */
+#define VKR_TEXTURE_ANALYZE_BLOCK (1u << 24)
+/** Pixels the normal-map likelihood samples. */
+#define VKR_TEXTURE_ANALYZE_NORMAL_SAMPLES 1024u
+/** Squared length of a unit normal in 8-bit SNORM-style units. */
+#define VKR_TEXTURE_ANALYZE_UNIT_LENGTH_SQ (255 * 255)
+// Treat alpha as a cutout mask when only a small fraction of transparent texels
+// have intermediate coverage (typical for foliage with anti-aliased edges).
+#define VKR_TEXTURE_ANALYZE_CUTOUT_RATIO 0.30f
+
+const char *vkr_texture_convert_half_path(void) {
+#if defined(VKR_TEXTURE_CONVERT_F16C)
+  return "f16c";
+#elif defined(VKR_TEXTURE_CONVERT_NEON)
+  return "neon";
+#elif defined(VKR_TEXTURE_CONVERT_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+#if defined(VKR_TEXTURE_CONVERT_SSE2)
+vkr_internal INLINE __m128i vkr_texture_convert_select_sse2(__m128i mask,
+                                                            __m128i a,
+                                                            __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Four floats to halves in the low 16 bits of each lane. Normal results round
+ * by adding the rounding bias plus the odd bit of the kept mantissa; results
+ * below the half normal range round through a float add of 0.5, which lines
+ * the half denormal grid up with the float mantissa.
+ */
+vkr_internal INLINE __m128i vkr_texture_convert_f32x4_to_f16_sse2(__m128 v) {
+  const __m128i bits = _mm_castps_si128(v);
+  const __m128i sign =
+      _mm_and_si128(bits, _mm_set1_epi32((int32_t)0x80000000u));
+  const __m128i magnitude = _mm_xor_si128(bits, sign);
+
+  const __m128i odd =
+      _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(1));
+  const __m128i normal = _mm_srli_epi32(
+      _mm_add_epi32(
+          _mm_add_epi32(magnitude, _mm_set1_epi32((int32_t)0xc8000fffu)),
+          odd),
+      13);
+  const __m128i denormal = _mm_sub_epi32(
+      _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude),
+                                  _mm_set1_ps(0.5f))),
+      _mm_set1_epi32(0x3f000000));
+  const __m128i is_nan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x7f800000));
+  const __m128i special = _mm_or_si128(
+      _mm_set1_epi32(0x7c00), _mm_and_si128(is_nan, _mm_set1_epi32(0x0200)));
+
+  __m128i half = vkr_texture_convert_select_sse2(
+      _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), magnitude), denormal,
+      normal);
+  half = vkr_texture_convert_select_sse2(
+      _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(0x477fffff)), special, half);
+  return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+}
+
+/** Four halves, zero-extended to 32-bit lanes, to floats. */
+vkr_internal INLINE __m128 vkr_texture_convert_f16x4_to_f32_sse2(__m128i h) {
+  const __m128i magnitude =
+      _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+  const __m128i exponent =
+      _mm_and_si128(magnitude, _mm_set1_epi32(0x0f800000));
+  const __m128i rebiased =
+      _mm_add_epi32(magnitude, _mm_set1_epi32(0x38000000));
+  const __m128i special = _mm_add_epi32(
+      rebiased, _mm_and_si128(_mm_cmpeq_epi32(exponent,
+                                              _mm_set1_epi32(0x0f800000)),
+                              _mm_set1_epi32(0x38000000)));
+  // Denormals: renormalize by adding the implicit bit and subtracting it back
+  // as a float.
+  const __m128i denormal = _mm_castps_si128(_mm_sub_ps(
+      _mm_castsi128_ps(_mm_add_epi32(rebiased, _mm_set1_epi32(0x00800000))),
+      _mm_castsi128_ps(_mm_set1_epi32(0x38800000))));
+  const __m128i bits = vkr_texture_convert_select_sse2(
+      _mm_cmpeq_epi32(exponent, _mm_setzero_si128()), denormal, special);
+  return _mm_castsi128_ps(_mm_or_si128(
+      bits, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+}
+#endif
+
+void vkr_texture_convert_f32_to_f16(const float32_t *src, uint16_t *dst,
+                                    uint64_t count) {
+  uint64_t i = 0u;
+#if defined(VKR_TEXTURE_CONVERT_F16C)
+  for (; i + 8u <= count; i += 8u) {
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                     _MM_FROUND_TO_NEAREST_INT));
+  }
+#elif defined(VKR_TEXTURE_CONVERT_NEON)
+  for (; i + 4u <= count; i += 4u) {
+    vst1_u16(dst + i,
+             vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+#elif defined(VKR_TEXTURE_CONVERT_SSE2)
+  // Bias both halves into signed range so the saturating pack keeps them.
+  const __m128i bias32 = _mm_set1_epi32(0x8000);
+  const __m128i bias16 = _mm_set1_epi16((int16_t)0x8000);
+  for (; i + 8u <= count; i += 8u) {
+    const __m128i lo = _mm_sub_epi32(
+        vkr_texture_convert_f32x4_to_f16_sse2(_mm_loadu_ps(src + i)), bias32);
+    const __m128i hi = _mm_sub_epi32(
+        vkr_texture_convert_f32x4_to_f16_sse2(_mm_loadu_ps(src + i + 4u)),
+        bias32);
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm_xor_si128(_mm_packs_epi32(lo, hi), bias16));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = vkr_float32_to_float16(src[i]);
+  }
+}
+
+void vkr_texture_convert_f16_to_f32(const uint16_t *src, float32_t *dst,
+                                    uint64_t count) {
+  uint64_t i = 0u;
+#if defined(VKR_TEXTURE_CONVERT_F16C)
+  for (; i + 8u <= count; i += 8u) {
+    _mm256_storeu_ps(dst + i,
+                     _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src +
+                                                                       i))));
+  }
+#elif defined(VKR_TEXTURE_CONVERT_NEON)
+  for (; i + 4u <= count; i += 4u) {
+    vst1q_f32(dst + i,
+              vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+#elif defined(VKR_TEXTURE_CONVERT_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8u <= count; i += 8u) {
+    const __m128i halves = _mm_loadu_si128((const __m128i *)(src + i));
+    _mm_storeu_ps(dst + i, vkr_texture_convert_f16x4_to_f32_sse2(
+                               _mm_unpacklo_epi16(halves, zero)));
+    _mm_storeu_ps(dst + i + 4u, vkr_texture_convert_f16x4_to_f32_sse2(
+                                    _mm_unpackhi_epi16(halves, zero)));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = vkr_float16_to_float32(src[i]);
+  }
+}
+
+vkr_internal INLINE uint32_t vkr_texture_convert_rgb_lane_count(uint32_t mask) {
+  return (mask & 1u) + ((mask >> 1u) & 1u) + ((mask >> 2u) & 1u);
+}
+
+bool8_t vkr_texture_convert_rgb32f_to_rgba16f(
+    const float32_t *rgb, uint16_t *rgba, uint64_t pixel_count,
+    VkrTextureHdrConvertStats *out_stats) {
+  VkrTextureHdrConvertStats stats = {
+      .clamped_count = 0u,
+      .observed_min = FLT_MAX,
+      .observed_max = -FLT_MAX,
+      .non_finite_sample = UINT64_MAX,
+  };
+  const VKR_SIMD_F32X4 zero = vkr_simd_set1_f32x4(0.0f);
+  const VKR_SIMD_F32X4 half_max =
+      vkr_simd_set1_f32x4(VKR_TEXTURE_CONVERT_HALF_MAX);
+  const VKR_SIMD_F32X4 lowest = vkr_simd_set1_f32x4(-FLT_MAX);
+  const VKR_SIMD_F32X4 highest = vkr_simd_set1_f32x4(FLT_MAX);
+  const VKR_SIMD_F32X4 one = vkr_simd_set1_f32x4(1.0f);
+  const VKR_SIMD_F32X4 lane = vkr_simd_set_f32x4(0.0f, 1.0f, 2.0f, 3.0f);
+  const VKR_SIMD_F32X4 alpha_lane = vkr_simd_set1_f32x4(3.0f);
+  VKR_SIMD_F32X4 observed_min = highest;
+  VKR_SIMD_F32X4 observed_max = lowest;
+  VKR_SIMD_ALIGN float32_t staged[VKR_TEXTURE_CONVERT_CHUNK * 4u];
+
+  bool8_t finite = true_v;
+  for (uint64_t first = 0u; first < pixel_count && finite;
+       first += VKR_TEXTURE_CONVERT_CHUNK) {
+    const uint64_t count = Min((uint64_t)VKR_TEXTURE_CONVERT_CHUNK,
+                               pixel_count - first);
+    for (uint64_t i = 0u; i < count; ++i) {
+      const uint64_t pixel = first + i;
+      const float32_t *sample = rgb + pixel * 3u;
+      // Lane 3 reads the next pixel's red, a real sample, so min and max may
+      // see it early; the last pixel repeats its own red instead.
+      const VKR_SIMD_F32X4 value =
+          pixel + 1u < pixel_count
+              ? vkr_simd_load_f32x4(sample)
+              : vkr_simd_set_f32x4(sample[0], sample[1], sample[2],
+                                   sample[0]);
+      const uint32_t finite_mask = vkr_simd_mask_ge_f32x4(value, lowest) &
+                                   vkr_simd_mask_ge_f32x4(highest, value);
+      if ((finite_mask & 0x7u) != 0x7u) {
+        uint32_t channel = 0u;
+        while (finite_mask & (1u << channel)) {
+          channel++;
+        }
+        stats.non_finite_sample = pixel * 3u + channel;
+        finite = false_v;
+        break;
+      }
+      observed_min = vkr_simd_min_f32x4(observed_min, value);
+      observed_max = vkr_simd_max_f32x4(observed_max, value);
+      const uint32_t in_range = vkr_simd_mask_ge_f32x4(value, zero) &
+                                vkr_simd_mask_ge_f32x4(half_max, value);
+      stats.clamped_count += 3u - vkr_texture_convert_rgb_lane_count(in_range);
+      const VKR_SIMD_F32X4 clamped = vkr_simd_min_f32x4(
+          vkr_simd_max_f32x4(value, zero), half_max);
+      vkr_simd_store_f32x4(
+          staged + i * 4u,
+          vkr_simd_select_ge_f32x4(lane, alpha_lane, one, clamped));
+    }
+    if (finite) {
+      vkr_texture_convert_f32_to_f16(staged, rgba + first * 4u, count * 4u);
+    }
+  }
+
+  if (pixel_count > 0u) {
+    for (uint32_t i = 0u; i < 4u; ++i) {
+      stats.observed_min = Min(stats.observed_min, observed_min.elements[i]);
+      stats.observed_max = Max(stats.observed_max, observed_max.elements[i]);
+    }
+  }
+  if (out_stats) {
+    *out_stats = stats;
+  }
+  return finite;
+}
+
+void vkr_texture_convert_rgbe_to_rgb32f(const uint8_t *rgbe, float32_t *rgb,
+                                        uint64_t pixel_count) {
+  for (uint64_t i = 0u; i < pixel_count; ++i) {
+    const uint8_t *in = rgbe + i * 4u;
+    const uint32_t exponent = in[3];
+    // 2^(e - 136) split into two normal powers of two, so every exponent
+    // rounds once, as ldexpf would, without a denormal scale factor.
+    const uint32_t lo_bits = ((exponent >> 1u) + 59u) << 23u;
+    const uint32_t hi_bits = (((exponent + 1u) >> 1u) + 59u) << 23u;
+    float32_t lo = 0.0f;
+    float32_t hi = 0.0f;
+    MemCopy(&lo, &lo_bits, sizeof(lo));
+    MemCopy(&hi, &hi_bits, sizeof(hi));
+    const float32_t scale = exponent != 0u ? lo : 0.0f;
+    float32_t *out = rgb + i * 3u;
+    out[0] = (float32_t)in[0] * scale * hi;
+    out[1] = (float32_t)in[1] * scale * hi;
+    out[2] = (float32_t)in[2] * scale * hi;
+  }
+}
+
+/** Exact sRGB decode of every 8-bit value, rounded to float. */
+static const float32_t s_texture_convert_srgb8_lut[256] = {
+    0.0f, 0.000303526991f, 0.000607053982f, 0.000910580973f, 0.00121410796f,
+    0.00151763496f, 0.00182116195f, 0.00212468882f, 0.00242821593f,
+    0.0027317428f, 0.00303526991f, 0.00334653584f, 0.00367650739f,
+    0.00402471703f, 0.00439144205f, 0.00477695325f, 0.00518151652f,
+    0.00560539169f, 0.00604883302f, 0.00651209056f, 0.00699541019f,
+    0.00749903219f, 0.00802319311f, 0.00856812578f, 0.00913405884f,
+    0.00972121768f, 0.010329823f, 0.0109600937f, 0.0116122449f, 0.012286488f,
+    0.0129830325f, 0.0137020834f, 0.0144438436f, 0.0152085144f, 0.0159962941f,
+    0.0168073755f, 0.0176419541f, 0.01850022f, 0.0193823613f, 0.0202885624f,
+    0.0212190095f, 0.0221738853f, 0.0231533665f, 0.0241576321f, 0.0251868591f,
+    0.0262412224f, 0.0273208916f, 0.02842604f, 0.0295568351f, 0.0307134446f,
+    0.0318960324f, 0.0331047662f, 0.0343398079f, 0.0356013142f, 0.0368894488f,
+    0.0382043719f, 0.0395462364f, 0.0409151986f, 0.0423114114f, 0.043735031f,
+    0.045186203f, 0.0466650873f, 0.0481718257f, 0.0497065671f, 0.0512694567f,
+    0.0528606474f, 0.054480277f, 0.0561284907f, 0.0578054301f, 0.0595112368f,
+    0.0612460524f, 0.0630100146f, 0.064803265f, 0.0666259378f, 0.0684781671f,
+    0.0703600943f, 0.0722718537f, 0.0742135718f, 0.0761853829f, 0.078187421f,
+    0.0802198201f, 0.0822827071f, 0.0843762085f, 0.0865004584f, 0.0886555836f,
+    0.0908417106f, 0.0930589661f, 0.0953074694f, 0.097587347f, 0.0998987257f,
+    0.102241732f, 0.104616486f, 0.107023105f, 0.10946171f, 0.111932427f,
+    0.114435375f, 0.116970666f, 0.119538426f, 0.122138776f, 0.124771819f,
+    0.127437681f, 0.130136475f, 0.13286832f, 0.135633335f, 0.138431609f,
+    0.141263291f, 0.144128472f, 0.147027269f, 0.149959788f, 0.152926147f,
+    0.155926466f, 0.158960834f, 0.162029371f, 0.165132195f, 0.168269396f,
+    0.171441108f, 0.174647406f, 0.177888423f, 0.18116425f, 0.18447499f,
+    0.187820777f, 0.191201687f, 0.194617838f, 0.198069319f, 0.20155625f,
+    0.205078736f, 0.208636865f, 0.212230757f, 0.215860501f, 0.219526201f,
+    0.223227963f, 0.226965874f, 0.230740055f, 0.23455058f, 0.238397568f,
+    0.242281124f, 0.246201321f, 0.25015828f, 0.254152089f, 0.258182853f,
+    0.262250662f, 0.266355604f, 0.270497799f, 0.274677306f, 0.278894275f,
+    0.283148736f, 0.287440836f, 0.291770637f, 0.296138257f, 0.300543785f,
+    0.304987311f, 0.309468925f, 0.313988715f, 0.318546772f, 0.323143214f,
+    0.327778101f, 0.332451522f, 0.337163627f, 0.341914415f, 0.346704066f,
+    0.351532608f, 0.356400132f, 0.361306787f, 0.366252601f, 0.371237695f,
+    0.376262128f, 0.38132602f, 0.386429429f, 0.391572475f, 0.396755219f,
+    0.401977777f, 0.407240212f, 0.412542611f, 0.417885065f, 0.423267663f,
+    0.428690493f, 0.434153646f, 0.439657182f, 0.445201188f, 0.450785786f,
+    0.456411034f, 0.462076992f, 0.467783809f, 0.473531485f, 0.479320168f,
+    0.48514995f, 0.491020858f, 0.496932983f, 0.502886474f, 0.50888133f,
+    0.514917672f, 0.520995557f, 0.527115107f, 0.533276379f, 0.539479494f,
+    0.545724452f, 0.55201143f, 0.558340371f, 0.564711511f, 0.571124852f,
+    0.577580452f, 0.584078431f, 0.590618849f, 0.597201765f, 0.603827357f,
+    0.610495567f, 0.617206573f, 0.623960376f, 0.630757153f, 0.637596846f,
+    0.644479692f, 0.651405632f, 0.658374846f, 0.665387273f, 0.672443151f,
+    0.679542482f, 0.686685324f, 0.693871737f, 0.701101899f, 0.708375752f,
+    0.715693474f, 0.723055124f, 0.730460763f, 0.73791039f, 0.745404184f,
+    0.752942204f, 0.760524511f, 0.768151164f, 0.775822222f, 0.783537805f,
+    0.791297913f, 0.799102724f, 0.806952238f, 0.814846575f, 0.822785735f,
+    0.830769897f, 0.838799f, 0.846873224f, 0.854992628f, 0.863157213f,
+    0.871367097f, 0.8796224f, 0.887923121f, 0.896269381f, 0.904661179f,
+    0.913098633f, 0.921581864f, 0.930110872f, 0.938685715f, 0.947306514f,
+    0.955973327f, 0.964686275f, 0.973445296f, 0.982250571f, 0.991102099f, 1.0f,
+};
+
+const float32_t *vkr_texture_convert_srgb8_lut(void) {
+  return s_texture_convert_srgb8_lut;
+}
+
+void vkr_texture_convert_srgb8_to_linear(const uint8_t *src, float32_t *dst,
+                                         uint64_t count) {
+  for (uint64_t i = 0u; i < count; ++i) {
+    dst[i] = s_texture_convert_srgb8_lut[src[i]];
+  }
+}
+
+/**
+ * Degree-6 fit of ((x + 0.055) / 1.055)^2.4 over [0.04045, 1], lowest order
+ * first; the maximum error is 6e-6.
+ */
+static const float32_t s_texture_convert_srgb_poly[7] = {
+    0.000910229050f, 0.0332310274f, 0.510791838f, 0.719153941f,
+    -0.438068777f,   0.229482144f,  -0.0555062629f,
+};
+
+vkr_internal INLINE VKR_SIMD_F32X4
+vkr_texture_convert_srgb_to_linear_f32x4(VKR_SIMD_F32X4 value) {
+  const VKR_SIMD_F32X4 x = vkr_simd_min_f32x4(
+      vkr_simd_max_f32x4(value, vkr_simd_set1_f32x4(0.0f)),
+      vkr_simd_set1_f32x4(1.0f));
+  VKR_SIMD_F32X4 curve = vkr_simd_set1_f32x4(s_texture_convert_srgb_poly[6]);
+  for (int32_t k = 5; k >= 0; --k) {
+    curve = vkr_simd_fma_f32x4(
+        vkr_simd_set1_f32x4(s_texture_convert_srgb_poly[k]), curve, x);
+  }
+  const VKR_SIMD_F32X4 segment =
+      vkr_simd_mul_f32x4(x, vkr_simd_set1_f32x4(1.0f / 12.92f));
+  return vkr_simd_select_ge_f32x4(
+      vkr_simd_set1_f32x4(VKR_TEXTURE_CONVERT_SRGB_KNEE), x, segment, curve);
+}
+
+void vkr_texture_convert_srgb_to_linear(const float32_t *src, float32_t *dst,
+                                        uint64_t count) {
+  uint64_t i = 0u;
+  for (; i + 4u <= count; i += 4u) {
+    vkr_simd_store_f32x4(dst + i, vkr_texture_convert_srgb_to_linear_f32x4(
+                                      vkr_simd_load_f32x4(src + i)));
+  }
+  if (i < count) {
+    VKR_SIMD_ALIGN float32_t tail[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    MemCopy(tail, src + i, (count - i) * sizeof(float32_t));
+    vkr_simd_store_f32x4(tail, vkr_texture_convert_srgb_to_linear_f32x4(
+                                   vkr_simd_load_f32x4(tail)));
+    MemCopy(dst + i, tail, (count - i) * sizeof(float32_t));
+  }
+}
+
+void vkr_texture_premultiply_rgba8(uint8_t *pixels, uint64_t pixel_count) {
+  for (uint64_t i = 0u; i < pixel_count; ++i) {
+    uint8_t *pixel = pixels + i * 4u;
+    const uint32_t alpha = pixel[3];
+    for (uint32_t c = 0u; c < 3u; ++c) {
+      // round(c * a / 255) without a divide.
+      const uint32_t product = (uint32_t)pixel[c] * alpha + 128u;
+      pixel[c] = (uint8_t)((product + (product >> 8u)) >> 8u);
+    }
+  }
+}
+
+void vkr_texture_premultiply_rgba32f(float32_t *pixels, uint64_t pixel_count) {
+  for (uint64_t i = 0u; i < pixel_count; ++i) {
+    float32_t *pixel = pixels + i * 4u;
+    const float32_t alpha = pixel[3];
+    vkr_simd_store_f32x4(
+        pixel, vkr_simd_mul_f32x4(vkr_simd_load_f32x4(pixel),
+                                  vkr_simd_set_f32x4(alpha, alpha, alpha,
+                                                     1.0f)));
+  }
+}
+
+vkr_internal INLINE void
+vkr_texture_analyze_rgba8_pixel(const uint8_t *pixel,
+                                VkrTextureRgba8Analysis *analysis) {
+  for (uint32_t c = 0u; c < 4u; ++c) {
+    analysis->channel_min[c] = Min(analysis->channel_min[c], pixel[c]);
+    analysis->channel_max[c] = Max(analysis->channel_max[c], pixel[c]);
+  }
+  const uint8_t alpha = pixel[3];
+  analysis->transparent_count += alpha < 255u ? 1u : 0u;
+  analysis->intermediate_count += (alpha > 0u && alpha < 255u) ? 1u : 0u;
+}
+
+/** RGB mapped to [-255, 255] lands within about 12% of unit length, +Z up. */
+vkr_internal INLINE bool8_t
+vkr_texture_analyze_is_unit_normal(const uint8_t *pixel) {
+  const int32_t x = 2 * (int32_t)pixel[0] - 255;
+  const int32_t y = 2 * (int32_t)pixel[1] - 255;
+  const int32_t z = 2 * (int32_t)pixel[2] - 255;
+  const int32_t length_sq = x * x + y * y + z * z;
+  return z > 0 && length_sq * 4 >= VKR_TEXTURE_ANALYZE_UNIT_LENGTH_SQ * 3 &&
+         length_sq * 4 <= VKR_TEXTURE_ANALYZE_UNIT_LENGTH_SQ * 5;
+}
+
+#if defined(VKR_TEXTURE_ANALYZE_SSE2)
+vkr_internal INLINE uint64_t vkr_texture_analyze_sum_u32x4_sse2(__m128i v) {
+  uint32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, v);
+  return (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+/**
+ * Four pixels per step: byte min/max cover every channel at once, and the
+ * alpha byte shifted down to a 32-bit lane feeds the counters, which subtract
+ * all-ones compare masks to count.
+ */
+vkr_internal uint64_t vkr_texture_analyze_rgba8_sse2(
+    const uint8_t *pixels, uint64_t pixel_count,
+    VkrTextureRgba8Analysis *analysis) {
+  const uint64_t vector_end = pixel_count & ~(uint64_t)3u;
+  const __m128i opaque = _mm_set1_epi32(255);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i lo = _mm_set1_epi8((char)0xff);
+  __m128i hi = zero;
+  uint64_t i = 0u;
+  while (i < vector_end) {
+    const uint64_t block_end = Min(vector_end, i + VKR_TEXTURE_ANALYZE_BLOCK);
+    __m128i transparent = zero;
+    __m128i intermediate = zero;
+    for (; i < block_end; i += 4u) {
+      const __m128i v = _mm_loadu_si128((const __m128i *)(pixels + i * 4u));
+      lo = _mm_min_epu8(lo, v);
+      hi = _mm_max_epu8(hi, v);
+      const __m128i alpha = _mm_srli_epi32(v, 24);
+      const __m128i below = _mm_cmplt_epi32(alpha, opaque);
+      transparent = _mm_sub_epi32(transparent, below);
+      intermediate = _mm_sub_epi32(
+          intermediate, _mm_and_si128(below, _mm_cmpgt_epi32(alpha, zero)));
+    }
+    analysis->transparent_count +=
+        vkr_texture_analyze_sum_u32x4_sse2(transparent);
+    analysis->intermediate_count +=
+        vkr_texture_analyze_sum_u32x4_sse2(intermediate);
+  }
+
+  uint8_t lo_bytes[16];
+  uint8_t hi_bytes[16];
+  _mm_storeu_si128((__m128i *)lo_bytes, lo);
+  _mm_storeu_si128((__m128i *)hi_bytes, hi);
+  for (uint32_t b = 0u; b < 16u; ++b) {
+    analysis->channel_min[b & 3u] =
+        Min(analysis->channel_min[b & 3u], lo_bytes[b]);
+    analysis->channel_max[b & 3u] =
+        Max(analysis->channel_max[b & 3u], hi_bytes[b]);
+  }
+  return vector_end;
+}
+#endif
+
+#if defined(VKR_TEXTURE_ANALYZE_NEON)
+/** Same shape as the SSE2 loop on NEON registers. */
+vkr_internal uint64_t vkr_texture_analyze_rgba8_neon(
+    const uint8_t *pixels, uint64_t pixel_count,
+    VkrTextureRgba8Analysis *analysis) {
+  const uint64_t vector_end = pixel_count & ~(uint64_t)3u;
+  const uint32x4_t opaque = vdupq_n_u32(255u);
+  const uint32x4_t zero = vdupq_n_u32(0u);
+  uint8x16_t lo = vdupq_n_u8(0xffu);
+  uint8x16_t hi = vdupq_n_u8(0u);
+  uint64_t i = 0u;
+  while (i < vector_end) {
+    const uint64_t block_end = Min(vector_end, i + VKR_TEXTURE_ANALYZE_BLOCK);
+    uint32x4_t transparent = zero;
+    uint32x4_t intermediate = zero;
+    for (; i < block_end; i += 4u) {
+      const uint8x16_t v = vld1q_u8(pixels + i * 4u);
+      lo = vminq_u8(lo, v);
+      hi = vmaxq_u8(hi, v);
+      const uint32x4_t alpha = vshrq_n_u32(vreinterpretq_u32_u8(v), 24);
+      const uint32x4_t below = vcltq_u32(alpha, opaque);
+      transparent = vsubq_u32(transparent, below);
+      intermediate = vsubq_u32(intermediate,
+                               vandq_u32(below, vcgtq_u32(alpha, zero)));
+    }
+    analysis->transparent_count += vaddvq_u32(transparent);
+    analysis->intermediate_count += vaddvq_u32(intermediate);
+  }
+
+  uint8_t lo_bytes[16];
+  uint8_t hi_bytes[16];
+  vst1q_u8(lo_bytes, lo);
+  vst1q_u8(hi_bytes, hi);
+  for (uint32_t b = 0u; b < 16u; ++b) {
+    analysis->channel_min[b & 3u] =
+        Min(analysis->channel_min[b & 3u], lo_bytes[b]);
+    analysis->channel_max[b & 3u] =
+        Max(analysis->channel_max[b & 3u], hi_bytes[b]);
+  }
+  return vector_end;
+}
+#endif
+
+void vkr_texture_analyze_rgba8(const uint8_t *pixels, uint64_t pixel_count,
+                               VkrTextureRgba8Analysis *out_analysis) {
+  MemZero(out_analysis, sizeof(*out_analysis));
+  if (!pixels || pixel_count == 0u) {
+    return;
+  }
+  for (uint32_t c = 0u; c < 4u; ++c) {
+    out_analysis->channel_min[c] = 255u;
+  }
+
+  uint64_t i = 0u;
+#if defined(VKR_TEXTURE_ANALYZE_SSE2)
+  i = vkr_texture_analyze_rgba8_sse2(pixels, pixel_count, out_analysis);
+#elif defined(VKR_TEXTURE_ANALYZE_NEON)
+  i = vkr_texture_analyze_rgba8_neon(pixels, pixel_count, out_analysis);
+#endif
+  for (; i < pixel_count; ++i) {
+    vkr_texture_analyze_rgba8_pixel(pixels + i * 4u, out_analysis);
+  }
+
+  const uint64_t samples =
+      Min(pixel_count, (uint64_t)VKR_TEXTURE_ANALYZE_NORMAL_SAMPLES);
+  const uint64_t stride = pixel_count / samples;
+  uint64_t normal_count = 0u;
+  for (uint64_t s = 0u; s < samples; ++s) {
+    normal_count +=
+        vkr_texture_analyze_is_unit_normal(pixels + s * stride * 4u) ? 1u : 0u;
+  }
+  out_analysis->normal_likelihood =
+      (float32_t)normal_count / (float32_t)samples;
+
+  if (out_analysis->transparent_count == 0u) {
+    out_analysis->alpha_class = VKR_TEXTURE_ALPHA_CLASS_OPAQUE;
+  } else {
+    const float32_t ratio = (float32_t)out_analysis->intermediate_count /
+                            (float32_t)out_analysis->transparent_count;
+    out_analysis->alpha_class = ratio <= VKR_TEXTURE_ANALYZE_CUTOUT_RATIO
+                                    ? VKR_TEXTURE_ALPHA_CLASS_CUTOUT
+                                    : VKR_TEXTURE_ALPHA_CLASS_BLENDED;
+  }
+
+  out_analysis->is_constant = true_v;
+  for (uint32_t c = 0u; c < 4u; ++c) {
+    if (out_analysis->channel_min[c] != out_analysis->channel_max[c]) {
+      out_analysis->is_constant = false_v;
+    }
+  }
+}
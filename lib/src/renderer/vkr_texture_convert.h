@@ -0,0 +1,118 @@
+/**
+ * @file vkr_texture_convert.h
+ * @brief Bulk pixel conversion kernels for texture decode and IBL data.
+ *
+ * Half-float conversion picks its path when the library is compiled, like
+ * vkr_simd.h does: F16C on x86 builds that have it, the AArch64 NEON
+ * conversions on ARM, an SSE2 bit-twiddling path on other x86 builds and the
+ * scalar vkr_float32_to_float16 / vkr_float16_to_float32 pair elsewhere.
+ * Every path rounds to nearest even and agrees bit for bit with the scalar
+ * pair, except that NaN payloads are only guaranteed to stay NaN.
+ *
+ * The remaining kernels work four lanes at a time through vkr_simd.h or are
+ * written as flat, branch-free loops the compiler vectorizes. RGBA8 analysis
+ * uses SSE2 on x86 and NEON on AArch64, with a scalar loop elsewhere.
+ */
+#pragma once
+
+#include "defines.h"
+
+/** Half-float path this build uses: "f16c", "neon", "sse2" or "scalar". */
+const char *vkr_texture_convert_half_path(void);
+
+/** Converts `count` floats to half floats. */
+void vkr_texture_convert_f32_to_f16(const float32_t *src, uint16_t *dst,
+                                    uint64_t count);
+
+/** Converts `count` half floats to floats. */
+void vkr_texture_convert_f16_to_f32(const uint16_t *src, float32_t *dst,
+                                    uint64_t count);
+
+/** What an HDR conversion saw in its source samples. */
+typedef struct VkrTextureHdrConvertStats {
+  /** Samples moved into [0, 65504]. */
+  uint64_t clamped_count;
+  float32_t observed_min;
+  float32_t observed_max;
+  /**
+   * Index into the RGB samples of the first non-finite one; UINT64_MAX when
+   * every sample is finite.
+   */
+  uint64_t non_finite_sample;
+} VkrTextureHdrConvertStats;
+
+/**
+ * @brief Expands RGB float radiance to RGBA half floats with an alpha of one,
+ * clamping every sample to the finite, non-negative half range.
+ *
+ * @return False at the first non-finite sample; `rgba` is then partially
+ * written and `non_finite_sample` names the sample.
+ */
+bool8_t vkr_texture_convert_rgb32f_to_rgba16f(
+    const float32_t *rgb, uint16_t *rgba, uint64_t pixel_count,
+    VkrTextureHdrConvertStats *out_stats);
+
+/**
+ * @brief Decodes Radiance RGBE pixels (shared exponent, bias 128) to RGB
+ * floats. An exponent of zero decodes to black.
+ */
+void vkr_texture_convert_rgbe_to_rgb32f(const uint8_t *rgbe, float32_t *rgb,
+                                        uint64_t pixel_count);
+
+/** @return The 256-entry sRGB-to-linear table for 8-bit channels. */
+const float32_t *vkr_texture_convert_srgb8_lut(void);
+
+/** Decodes `count` 8-bit sRGB channels through the lookup table. */
+void vkr_texture_convert_srgb8_to_linear(const uint8_t *src, float32_t *dst,
+                                         uint64_t count);
+
+/**
+ * @brief Decodes `count` sRGB floats, clamped to [0, 1], with a polynomial fit
+ * of the sRGB curve. Stays within 1e-5 of the exact transfer function.
+ */
+void vkr_texture_convert_srgb_to_linear(const float32_t *src, float32_t *dst,
+                                        uint64_t count);
+
+/** Multiplies color by alpha in place, rounding to nearest. */
+void vkr_texture_premultiply_rgba8(uint8_t *pixels, uint64_t pixel_count);
+
+/** Multiplies color by alpha in place. */
+void vkr_texture_premultiply_rgba32f(float32_t *pixels, uint64_t pixel_count);
+
+/** How a texture uses its alpha channel. */
+typedef enum VkrTextureAlphaClass {
+  /** Every alpha is 255. */
+  VKR_TEXTURE_ALPHA_CLASS_OPAQUE = 0,
+  /** Mostly 0 or 255; anti-aliased edges are few enough to alpha test. */
+  VKR_TEXTURE_ALPHA_CLASS_CUTOUT,
+  /** Enough intermediate alpha that the texture needs blending. */
+  VKR_TEXTURE_ALPHA_CLASS_BLENDED,
+} VkrTextureAlphaClass;
+
+/** What one pass over RGBA8 pixels found. */
+typedef struct VkrTextureRgba8Analysis {
+  uint8_t channel_min[4];
+  uint8_t channel_max[4];
+  /** Pixels with alpha below 255. */
+  uint64_t transparent_count;
+  /** Pixels with alpha strictly between 0 and 255. */
+  uint64_t intermediate_count;
+  /**
+   * Fraction of sampled pixels whose RGB decodes to a roughly unit-length
+   * tangent-space normal facing +Z.
+   */
+  float32_t normal_likelihood;
+  VkrTextureAlphaClass alpha_class;
+  /** Every pixel holds the same RGBA value. */
+  bool8_t is_constant;
+} VkrTextureRgba8Analysis;
+
+/**
+ * @brief Computes per-channel ranges, alpha class, normal-map likelihood and
+ * constant-color detection for RGBA8 pixels in a single pass.
+ *
+ * The normal-map likelihood looks at up to 1024 evenly spaced pixels; the rest
+ * reads every pixel. No pixels analyze as opaque, non-constant zeroes.
+ */
+void vkr_texture_analyze_rgba8(const uint8_t *pixels, uint64_t pixel_count,
+                               VkrTextureRgba8Analysis *out_analysis);
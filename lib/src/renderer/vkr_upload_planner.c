@@ -0,0 +1,318 @@
+#include "renderer/vkr_upload_planner.h"
+
+#include "containers/vkr_sort.h"
+
+vkr_internal uint64_t vkr_upload_align_up(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+vkr_internal uint32_t vkr_upload_write_hash(uint64_t destination,
+                                            uint64_t destination_offset,
+                                            uint64_t size) {
+  uint64_t hash = destination * 0x9E3779B97F4A7C15ull;
+  hash ^=
+      destination_offset + 0x7F4A7C159E3779B9ull + (hash << 6) + (hash >> 2);
+  hash ^= size + 0x94D049BB133111EBull + (hash << 6) + (hash >> 2);
+  return (uint32_t)(hash ^ (hash >> 32));
+}
+
+vkr_internal int32_t vkr_upload_compare_destination(const void *lhs,
+                                                    const void *rhs) {
+  const VkrUploadWrite *a = lhs;
+  const VkrUploadWrite *b = rhs;
+  if (a->destination != b->destination)
+    return a->destination < b->destination ? -1 : 1;
+  if (a->destination_offset != b->destination_offset)
+    return a->destination_offset < b->destination_offset ? -1 : 1;
+  return a->sequence < b->sequence ? -1 : (a->sequence > b->sequence);
+}
+
+vkr_internal int32_t vkr_upload_compare_sequence(const void *lhs,
+                                                 const void *rhs) {
+  const VkrUploadWrite *a = lhs;
+  const VkrUploadWrite *b = rhs;
+  return a->sequence < b->sequence ? -1 : (a->sequence > b->sequence);
+}
+
+vkr_internal int32_t vkr_upload_compare_wave(const void *lhs, const void *rhs) {
+  const VkrUploadWrite *a = lhs;
+  const VkrUploadWrite *b = rhs;
+  if (a->wave != b->wave)
+    return a->wave < b->wave ? -1 : 1;
+  return vkr_upload_compare_destination(lhs, rhs);
+}
+
+vkr_internal bool8_t vkr_upload_writes_overlap(const VkrUploadWrite *a,
+                                               const VkrUploadWrite *b) {
+  return a->destination_offset < b->destination_offset + b->size &&
+         b->destination_offset < a->destination_offset + a->size;
+}
+
+vkr_internal void vkr_upload_planner_reset_frame(VkrUploadPlanner *planner) {
+  MemZero(planner->write_table,
+          (uint64_t)planner->write_table_capacity * sizeof(uint32_t));
+  planner->write_count = 0u;
+  planner->next_sequence = 0u;
+  planner->used = 0u;
+  planner->slice = (VkrGpuRingSlice){0};
+  planner->frame_open = false_v;
+}
+
+bool8_t vkr_upload_planner_create(VkrUploadPlanner *planner,
+                                  VkrAllocator *allocator,
+                                  const VkrUploadPlannerConfig *config,
+                                  VkrGpuAddressPair staging) {
+  if (!planner || !allocator || !config || !config->frame_count ||
+      !config->max_writes || !staging.cpu_address ||
+      staging.size < config->staging_size ||
+      config->staging_size / config->frame_count == 0u ||
+      (config->alignment & (config->alignment - 1u)))
+    return false_v;
+  MemZero(planner, sizeof(*planner));
+  planner->allocator = allocator;
+  planner->config = *config;
+  if (!planner->config.alignment)
+    planner->config.alignment = 1u;
+  planner->staging = staging;
+
+  uint32_t table_capacity = 16u;
+  while (table_capacity < config->max_writes * 2u)
+    table_capacity <<= 1u;
+  planner->write_table_capacity = table_capacity;
+
+  const uint64_t slots_size =
+      vkr_gpu_submit_ring_storage_requirement(config->frame_count);
+  planner->ring_slots = vkr_allocator_alloc(allocator, slots_size,
+                                            VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  planner->writes = vkr_allocator_alloc(
+      allocator, (uint64_t)config->max_writes * sizeof(VkrUploadWrite),
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  planner->sorted = vkr_allocator_alloc(
+      allocator, (uint64_t)config->max_writes * sizeof(VkrUploadWrite),
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  planner->copies = vkr_allocator_alloc(
+      allocator, (uint64_t)config->max_writes * sizeof(VkrUploadCopy),
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  planner->write_table = vkr_allocator_alloc(
+      allocator, (uint64_t)table_capacity * sizeof(uint32_t),
+      VKR_ALLOCATOR_MEMORY_TAG_HASH_TABLE);
+  if (!planner->ring_slots || !planner->writes || !planner->sorted ||
+      !planner->copies || !planner->write_table ||
+      vkr_gpu_submit_ring_create(&planner->ring, config->staging_size,
+                                 config->frame_count, planner->ring_slots,
+                                 slots_size) != VKR_GPU_SUBMIT_RING_STATUS_OK) {
+    vkr_upload_planner_destroy(planner);
+    return false_v;
+  }
+  vkr_upload_planner_reset_frame(planner);
+  return true_v;
+}
+
+void vkr_upload_planner_destroy(VkrUploadPlanner *planner) {
+  if (!planner || !planner->allocator)
+    return;
+  const uint64_t write_bytes =
+      (uint64_t)planner->config.max_writes * sizeof(VkrUploadWrite);
+  if (planner->ring_slots)
+    vkr_allocator_free(
+        planner->allocator, planner->ring_slots,
+        vkr_gpu_submit_ring_storage_requirement(planner->config.frame_count),
+        VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  if (planner->writes)
+    vkr_allocator_free(planner->allocator, planner->writes, write_bytes,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (planner->sorted)
+    vkr_allocator_free(planner->allocator, planner->sorted, write_bytes,
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (planner->copies)
+    vkr_allocator_free(planner->allocator, planner->copies,
+                       (uint64_t)planner->config.max_writes *
+                           sizeof(VkrUploadCopy),
+                       VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (planner->write_table)
+    vkr_allocator_free(planner->allocator, planner->write_table,
+                       (uint64_t)planner->write_table_capacity *
+                           sizeof(uint32_t),
+                       VKR_ALLOCATOR_MEMORY_TAG_HASH_TABLE);
+  MemZero(planner, sizeof(*planner));
+}
+
+VkrUploadPlannerStatus
+vkr_upload_planner_begin_frame(VkrUploadPlanner *planner,
+                               uint64_t completed_submit_value) {
+  if (!planner || !planner->writes || planner->frame_open)
+    return VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT;
+  VkrGpuRingSlice slice = {0};
+  const VkrGpuSubmitRingStatus status = vkr_gpu_submit_ring_acquire(
+      &planner->ring, planner->ring.slot_size, completed_submit_value, &slice);
+  if (status == VKR_GPU_SUBMIT_RING_STATUS_BUSY) {
+    planner->busy_frames++;
+    return VKR_UPLOAD_PLANNER_STATUS_BUSY;
+  }
+  if (status != VKR_GPU_SUBMIT_RING_STATUS_OK)
+    return VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT;
+  vkr_upload_planner_reset_frame(planner);
+  MemZero(&planner->stats, sizeof(planner->stats));
+  planner->slice = slice;
+  planner->frame_open = true_v;
+  return VKR_UPLOAD_PLANNER_STATUS_OK;
+}
+
+uint64_t vkr_upload_planner_remaining(const VkrUploadPlanner *planner) {
+  if (!planner || !planner->frame_open ||
+      planner->write_count >= planner->config.max_writes)
+    return 0u;
+  const uint64_t start =
+      vkr_upload_align_up(planner->used, planner->config.alignment);
+  return start < planner->slice.size ? planner->slice.size - start : 0u;
+}
+
+VkrUploadPlannerStatus vkr_upload_planner_write(VkrUploadPlanner *planner,
+                                                uint64_t destination,
+                                                uint64_t destination_offset,
+                                                const void *data,
+                                                uint64_t size) {
+  if (!planner || !planner->frame_open || !data || !size)
+    return VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT;
+  uint8_t *slice_bytes =
+      (uint8_t *)planner->staging.cpu_address + planner->slice.offset;
+  const uint32_t mask = planner->write_table_capacity - 1u;
+  uint32_t slot =
+      vkr_upload_write_hash(destination, destination_offset, size) & mask;
+  while (planner->write_table[slot]) {
+    VkrUploadWrite *existing =
+        &planner->writes[planner->write_table[slot] - 1u];
+    if (existing->destination == destination &&
+        existing->destination_offset == destination_offset &&
+        existing->size == size) {
+      MemCopy(slice_bytes + existing->source_offset, data, size);
+      existing->sequence = planner->next_sequence++;
+      planner->stats.deduped++;
+      return VKR_UPLOAD_PLANNER_STATUS_OK;
+    }
+    slot = (slot + 1u) & mask;
+  }
+  if (size > vkr_upload_planner_remaining(planner)) {
+    planner->stats.overflows++;
+    return VKR_UPLOAD_PLANNER_STATUS_FULL;
+  }
+  const uint64_t source_offset =
+      vkr_upload_align_up(planner->used, planner->config.alignment);
+  MemCopy(slice_bytes + source_offset, data, size);
+  planner->writes[planner->write_count] = (VkrUploadWrite){
+      .destination = destination,
+      .destination_offset = destination_offset,
+      .source_offset = source_offset,
+      .size = size,
+      .sequence = planner->next_sequence++,
+  };
+  planner->write_table[slot] = ++planner->write_count;
+  planner->used = source_offset + size;
+  planner->stats.writes++;
+  planner->stats.staged_bytes += size;
+  return VKR_UPLOAD_PLANNER_STATUS_OK;
+}
+
+/**
+ * Gives each write in one destination's overlapping group the wave after the
+ * latest earlier write it overlaps, so later writes land last.
+ */
+vkr_internal uint32_t vkr_upload_assign_waves(VkrUploadWrite *group,
+                                              uint32_t count) {
+  vkr_sort(group, count, sizeof(*group), vkr_upload_compare_sequence);
+  uint32_t max_wave = 0u;
+  for (uint32_t i = 0u; i < count; ++i) {
+    uint32_t wave = 0u;
+    for (uint32_t j = 0u; j < i; ++j) {
+      if (vkr_upload_writes_overlap(&group[i], &group[j]))
+        wave = Max(wave, group[j].wave + 1u);
+    }
+    group[i].wave = wave;
+    max_wave = Max(max_wave, wave);
+  }
+  return max_wave;
+}
+
+uint32_t vkr_upload_planner_build(VkrUploadPlanner *planner,
+                                  const VkrUploadCopy **out_copies) {
+  if (out_copies)
+    *out_copies = NULL;
+  if (!planner || !out_copies || !planner->frame_open ||
+      !planner->write_count)
+    return 0u;
+  const uint32_t count = planner->write_count;
+  VkrUploadWrite *sorted = planner->sorted;
+  MemCopy(sorted, planner->writes, (uint64_t)count * sizeof(*sorted));
+  vkr_sort(sorted, count, sizeof(*sorted), vkr_upload_compare_destination);
+
+  uint32_t max_wave = 0u;
+  bool8_t any_overlap = false_v;
+  for (uint32_t begin = 0u; begin < count;) {
+    uint32_t end = begin + 1u;
+    bool8_t overlap = false_v;
+    uint64_t reach = sorted[begin].destination_offset + sorted[begin].size;
+    sorted[begin].wave = 0u;
+    while (end < count &&
+           sorted[end].destination == sorted[begin].destination) {
+      overlap |= sorted[end].destination_offset < reach;
+      reach = Max(reach, sorted[end].destination_offset + sorted[end].size);
+      sorted[end].wave = 0u;
+      end++;
+    }
+    if (overlap) {
+      max_wave = Max(max_wave, vkr_upload_assign_waves(&sorted[begin],
+                                                       end - begin));
+      any_overlap = true_v;
+    }
+    begin = end;
+  }
+  if (any_overlap)
+    vkr_sort(sorted, count, sizeof(*sorted), vkr_upload_compare_wave);
+
+  const uint64_t slice_offset = planner->slice.offset;
+  uint32_t copy_count = 0u;
+  for (uint32_t i = 0u; i < count; ++i) {
+    const VkrUploadWrite *write = &sorted[i];
+    if (copy_count) {
+      VkrUploadCopy *last = &planner->copies[copy_count - 1u];
+      if (last->wave == write->wave &&
+          last->destination == write->destination &&
+          last->destination_offset + last->size == write->destination_offset &&
+          last->source_offset + last->size ==
+              slice_offset + write->source_offset) {
+        last->size += write->size;
+        continue;
+      }
+    }
+    planner->copies[copy_count++] = (VkrUploadCopy){
+        .destination = write->destination,
+        .source_offset = slice_offset + write->source_offset,
+        .destination_offset = write->destination_offset,
+        .size = write->size,
+        .wave = write->wave,
+    };
+  }
+  planner->stats.copies = copy_count;
+  planner->stats.waves = max_wave + 1u;
+  *out_copies = planner->copies;
+  return copy_count;
+}
+
+VkrUploadPlannerStatus vkr_upload_planner_submit(VkrUploadPlanner *planner,
+                                                 uint64_t submit_value) {
+  if (!planner || !planner->frame_open)
+    return VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT;
+  if (vkr_gpu_submit_ring_submit(&planner->ring, planner->slice,
+                                 submit_value) !=
+      VKR_GPU_SUBMIT_RING_STATUS_OK)
+    return VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT;
+  vkr_upload_planner_reset_frame(planner);
+  return VKR_UPLOAD_PLANNER_STATUS_OK;
+}
+
+void vkr_upload_planner_cancel(VkrUploadPlanner *planner) {
+  if (!planner || !planner->frame_open)
+    return;
+  vkr_gpu_submit_ring_cancel(&planner->ring, planner->slice);
+  vkr_upload_planner_reset_frame(planner);
+}
@@ -0,0 +1,152 @@
+/**
+ * @file vkr_upload_planner.h
+ * @brief Coalesces a frame's buffer writes into one staging slice and a
+ * minimal list of copy regions.
+ *
+ * The planner owns no GPU memory. The backend hands it a persistently mapped
+ * staging allocation, which a vkr_gpu_submit_ring divides into one slice per
+ * frame in flight. Each frame the backend opens a slice, writes bytes destined
+ * for any number of buffers, builds the copy list and records it, then submits
+ * the slice against the timeline value that retires it.
+ *
+ * A write that repeats an earlier write's destination range in the same frame
+ * overwrites the staged bytes in place, so a material row or slot updated
+ * several times costs one copy. Writes that are adjacent in both destination
+ * and staging, which is what sequential writes produce, merge into a single
+ * region. Destinations are opaque 64-bit keys; the planner never interprets
+ * them.
+ *
+ * Copies are grouped into waves. Copies within a wave never overlap and may
+ * be recorded in any order or as one multi-region command. Wave n+1 exists
+ * only when a frame writes overlapping, non-identical ranges of one
+ * destination, and the backend must order it after wave n with a
+ * transfer-to-transfer barrier.
+ */
+#pragma once
+
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+#include "renderer/vkr_gpu_submit_ring.h"
+
+typedef enum VkrUploadPlannerStatus {
+  VKR_UPLOAD_PLANNER_STATUS_OK = 0,
+  VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT,
+  /** The next staging slice is still read by an in-flight submission. */
+  VKR_UPLOAD_PLANNER_STATUS_BUSY,
+  /** The frame's slice or write table cannot hold the write. */
+  VKR_UPLOAD_PLANNER_STATUS_FULL,
+} VkrUploadPlannerStatus;
+
+typedef struct VkrUploadPlannerConfig {
+  /** Bytes of the staging allocation the ring divides across frames. */
+  uint64_t staging_size;
+  /** Frames that may be in flight; each owns one slice. */
+  uint32_t frame_count;
+  /** Distinct writes admitted per frame. */
+  uint32_t max_writes;
+  /** Power-of-two alignment of staged source offsets; zero means 1. */
+  uint64_t alignment;
+} VkrUploadPlannerConfig;
+
+/** One copy region, from the staging allocation into `destination`. */
+typedef struct VkrUploadCopy {
+  uint64_t destination;
+  /** Offset from the start of the staging allocation, not the slice. */
+  uint64_t source_offset;
+  uint64_t destination_offset;
+  uint64_t size;
+  uint32_t wave;
+} VkrUploadCopy;
+
+typedef struct VkrUploadWrite {
+  uint64_t destination;
+  uint64_t destination_offset;
+  uint64_t source_offset;
+  uint64_t size;
+  uint32_t sequence;
+  uint32_t wave;
+} VkrUploadWrite;
+
+/** Counters for the open frame, or the last one when none is open. */
+typedef struct VkrUploadPlannerStats {
+  uint32_t writes;
+  /** Writes that replaced an identical range already staged this frame. */
+  uint32_t deduped;
+  uint32_t overflows;
+  uint32_t copies;
+  uint32_t waves;
+  uint64_t staged_bytes;
+} VkrUploadPlannerStats;
+
+typedef struct VkrUploadPlanner {
+  VkrAllocator *allocator;
+  VkrUploadPlannerConfig config;
+  VkrGpuAddressPair staging;
+  VkrGpuSubmitRing ring;
+  VkrGpuSubmitRingSlot *ring_slots;
+  VkrGpuRingSlice slice;
+  bool8_t frame_open;
+  uint64_t used;
+  uint32_t next_sequence;
+
+  VkrUploadWrite *writes;
+  uint32_t write_count;
+  /** Open-addressed write index + 1 per slot; zero is empty. */
+  uint32_t *write_table;
+  uint32_t write_table_capacity;
+  /** Scratch the copy list is built in; `max_writes` entries each. */
+  VkrUploadWrite *sorted;
+  VkrUploadCopy *copies;
+
+  VkrUploadPlannerStats stats;
+  /** Frames that could not open because their slice was still in flight. */
+  uint64_t busy_frames;
+} VkrUploadPlanner;
+
+/**
+ * @brief Creates a planner over `staging`, which must stay mapped and at
+ * least `config->staging_size` bytes for the planner's lifetime.
+ */
+bool8_t vkr_upload_planner_create(VkrUploadPlanner *planner,
+                                  VkrAllocator *allocator,
+                                  const VkrUploadPlannerConfig *config,
+                                  VkrGpuAddressPair staging);
+
+void vkr_upload_planner_destroy(VkrUploadPlanner *planner);
+
+/**
+ * @brief Opens the next frame's staging slice.
+ *
+ * `completed_submit_value` is the last timeline value the GPU finished; a
+ * slice submitted at a later value is still being read.
+ */
+VkrUploadPlannerStatus
+vkr_upload_planner_begin_frame(VkrUploadPlanner *planner,
+                               uint64_t completed_submit_value);
+
+/** Largest write the open frame can still stage; zero when none is open. */
+uint64_t vkr_upload_planner_remaining(const VkrUploadPlanner *planner);
+
+/** Stages `size` bytes of `data` for `destination` at `destination_offset`. */
+VkrUploadPlannerStatus vkr_upload_planner_write(VkrUploadPlanner *planner,
+                                                uint64_t destination,
+                                                uint64_t destination_offset,
+                                                const void *data,
+                                                uint64_t size);
+
+/**
+ * @brief Builds the open frame's copy list, ordered by wave, destination and
+ * destination offset.
+ *
+ * The list stays valid until the next write, submit or cancel.
+ * @return The number of copies in `*out_copies`.
+ */
+uint32_t vkr_upload_planner_build(VkrUploadPlanner *planner,
+                                  const VkrUploadCopy **out_copies);
+
+/** Hands the open slice to the GPU until `submit_value` completes. */
+VkrUploadPlannerStatus vkr_upload_planner_submit(VkrUploadPlanner *planner,
+                                                 uint64_t submit_value);
+
+/** Drops the open frame's writes and releases its slice unsubmitted. */
+void vkr_upload_planner_cancel(VkrUploadPlanner *planner);
@@ -48,3 +48,37 @@ void vkr_visibility_submesh_sphere(Mat4 model, Vec3 center, Vec3 min_extents,
   Vec3 half = vec3_scale(vec3_sub(max_extents, min_extents), 0.5f);
   *out_radius = vec3_length(half) * max_scale;
 }
+
+float32_t vkr_visibility_sphere_screen_area(Vec3 center, float32_t radius,
+                                            Vec3 eye,
+                                            float32_t projection_y_scale,
+                                            uint32_t viewport_width,
+                                            uint32_t viewport_height) {
+  const float32_t viewport_area =
+      (float32_t)viewport_width * (float32_t)viewport_height;
+  const Vec3 offset = vec3_sub(center, eye);
+  const float32_t distance_sq = vec3_dot(offset, offset);
+  const float32_t tangent_sq = distance_sq - radius * radius;
+  if (tangent_sq <= 0.0f)
+    return viewport_area;
+  // The silhouette's angular radius is radius / tangent length.
+  const float32_t pixel_radius = radius / vkr_sqrt_f32(tangent_sq) *
+                                 projection_y_scale *
+                                 (float32_t)viewport_height * 0.5f;
+  return vkr_min_f32(VKR_PI * pixel_radius * pixel_radius, viewport_area);
+}
+
+uint64_t vkr_opaque_set_version_update(VkrOpaqueSetVersion *state,
+                                       uint64_t mesh_version,
+                                       uint64_t material_version,
+                                       bool8_t picking) {
+  if (state->version == 0u || state->mesh_version != mesh_version ||
+      state->material_version != material_version ||
+      state->picking != picking) {
+    state->mesh_version = mesh_version;
+    state->material_version = material_version;
+    state->picking = picking;
+    state->version++;
+  }
+  return state->version;
+}
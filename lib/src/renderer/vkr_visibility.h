@@ -43,6 +43,18 @@ typedef struct VkrVisibilityStats {
   uint32_t objects_tested;
   uint32_t objects_culled_camera;
   uint32_t objects_without_bounds;
+  /** Candidate instance runs holding two or more rows. */
+  uint32_t instance_runs_formed;
+  /** Candidate rows folded into an earlier row of their instance run. */
+  uint32_t instance_rows_saved;
+  /** Rows dropped from the camera views by CPU occlusion culling. */
+  uint32_t objects_culled_occlusion;
+  /** Occluders and screen triangles in the CPU occlusion buffer. */
+  uint32_t occluders_rasterized;
+  uint32_t occluder_triangles;
+  /** Occluder selection and rasterization time, when it ran. */
+  uint64_t occlusion_raster_ns;
+  bool8_t occlusion_rasterized;
 } VkrVisibilityStats;
 
 /** One camera-visible ordinary-blend draw before back-to-front ordering. */
@@ -69,3 +81,37 @@ vkr_transparent_draw_emit(const VkrTransparentDrawCandidate *candidates,
 void vkr_visibility_submesh_sphere(Mat4 model, Vec3 center, Vec3 min_extents,
                                    Vec3 max_extents, Vec3 *out_center,
                                    float32_t *out_radius);
+
+/**
+ * @brief Pixels a world-space sphere covers on a perspective viewport.
+ *
+ * `projection_y_scale` is the projection's m11. A sphere around the eye
+ * covers the whole viewport; the result never exceeds it.
+ */
+float32_t vkr_visibility_sphere_screen_area(Vec3 center, float32_t radius,
+                                            Vec3 eye,
+                                            float32_t projection_y_scale,
+                                            uint32_t viewport_width,
+                                            uint32_t viewport_height);
+
+/**
+ * @brief Rolls frontend change counters into one camera-opaque set version.
+ *
+ * The inputs are the counters the candidate rows are built from: mesh-manager
+ * render state, material publication and whether the frame keeps original
+ * submeshes for picking instead of static clusters. The version is bumped
+ * only when one of them moved, so a static scene keeps its version, and it is
+ * never 0 after the first update.
+ */
+typedef struct VkrOpaqueSetVersion {
+  uint64_t mesh_version;
+  uint64_t material_version;
+  bool8_t picking;
+  uint64_t version;
+} VkrOpaqueSetVersion;
+
+/** Updates `state` from this frame's inputs and returns its version. */
+uint64_t vkr_opaque_set_version_update(VkrOpaqueSetVersion *state,
+                                       uint64_t mesh_version,
+                                       uint64_t material_version,
+                                       bool8_t picking);
@@ -0,0 +1,140 @@
+/**
+ * @file vkr_world_instancing.c
+ * @brief Automatic instancing over the world GPU candidate stream.
+ */
+
+#include "renderer/vkr_world_instancing.h"
+
+#define VKR_WORLD_INSTANCING_RADIX_BITS 8u
+#define VKR_WORLD_INSTANCING_RADIX_SIZE (1u << VKR_WORLD_INSTANCING_RADIX_BITS)
+/** The state bucket owns the top byte; the key hash fills the rest. */
+#define VKR_WORLD_INSTANCING_HASH_MASK 0x00FFFFFFFFFFFFFFull
+
+typedef struct VkrWorldInstancingKey {
+  uint64_t key;
+  uint32_t index;
+} VkrWorldInstancingKey;
+
+vkr_internal INLINE uint64_t vkr_world_instancing_mix(uint64_t hash,
+                                                      uint32_t value) {
+  hash ^= value;
+  hash *= 0x100000001B3ull;
+  return hash ^ (hash >> 29);
+}
+
+vkr_internal uint64_t
+vkr_world_instancing_key(const VkrWorldDrawCandidate *candidate) {
+  uint64_t hash = 0xCBF29CE484222325ull;
+  hash = vkr_world_instancing_mix(hash, candidate->geometry.id);
+  hash = vkr_world_instancing_mix(hash, candidate->geometry.generation);
+  hash = vkr_world_instancing_mix(hash, candidate->submesh_index);
+  hash = vkr_world_instancing_mix(hash, candidate->material.id);
+  hash = vkr_world_instancing_mix(hash, candidate->material.generation);
+  return ((uint64_t)(candidate->state_bucket & 0xFFu) << 56) |
+         (hash & VKR_WORLD_INSTANCING_HASH_MASK);
+}
+
+vkr_internal INLINE bool8_t
+vkr_world_instancing_same_run(const VkrWorldDrawCandidate *a,
+                              const VkrWorldDrawCandidate *b) {
+  return a->geometry.id == b->geometry.id &&
+         a->geometry.generation == b->geometry.generation &&
+         a->submesh_index == b->submesh_index &&
+         a->material.id == b->material.id &&
+         a->material.generation == b->material.generation &&
+         a->state_bucket == b->state_bucket;
+}
+
+/**
+ * Stable LSD radix sort of `keys` by `key`, ping-ponging through `temp`.
+ * Returns whichever buffer holds the sorted result. Byte positions on which
+ * every key agrees are skipped, which for a typical scene is most of them.
+ */
+vkr_internal VkrWorldInstancingKey *
+vkr_world_instancing_radix_sort(VkrWorldInstancingKey *keys,
+                                VkrWorldInstancingKey *temp, uint32_t count) {
+  uint32_t histogram[VKR_WORLD_INSTANCING_RADIX_SIZE];
+  for (uint32_t shift = 0u; shift < 64u;
+       shift += VKR_WORLD_INSTANCING_RADIX_BITS) {
+    MemZero(histogram, sizeof(histogram));
+    for (uint32_t i = 0u; i < count; ++i) {
+      histogram[(keys[i].key >> shift) & 0xFFu]++;
+    }
+    if (histogram[(keys[0].key >> shift) & 0xFFu] == count) {
+      continue;
+    }
+
+    uint32_t offset = 0u;
+    for (uint32_t b = 0u; b < VKR_WORLD_INSTANCING_RADIX_SIZE; ++b) {
+      const uint32_t bucket_count = histogram[b];
+      histogram[b] = offset;
+      offset += bucket_count;
+    }
+    for (uint32_t i = 0u; i < count; ++i) {
+      temp[histogram[(keys[i].key >> shift) & 0xFFu]++] = keys[i];
+    }
+
+    VkrWorldInstancingKey *swap = keys;
+    keys = temp;
+    temp = swap;
+  }
+  return keys;
+}
+
+bool8_t vkr_world_instancing_build(VkrAllocator *scratch,
+                                   VkrWorldDrawCandidate *candidates,
+                                   uint32_t count,
+                                   VkrWorldInstanceRun *out_runs,
+                                   uint32_t *out_run_count,
+                                   VkrWorldInstancingStats *out_stats) {
+  *out_run_count = 0u;
+  if (count == 0u) {
+    return true_v;
+  }
+
+  VkrWorldInstancingKey *keys =
+      vkr_allocator_alloc(scratch, sizeof(*keys) * (uint64_t)count * 2u,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrWorldDrawCandidate *sorted =
+      vkr_allocator_alloc(scratch, sizeof(*sorted) * (uint64_t)count,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!keys || !sorted) {
+    return false_v;
+  }
+
+  for (uint32_t i = 0u; i < count; ++i) {
+    keys[i] = (VkrWorldInstancingKey){
+        .key = vkr_world_instancing_key(&candidates[i]),
+        .index = i,
+    };
+  }
+  const VkrWorldInstancingKey *order =
+      vkr_world_instancing_radix_sort(keys, keys + count, count);
+  for (uint32_t i = 0u; i < count; ++i) {
+    sorted[i] = candidates[order[i].index];
+  }
+  MemCopy(candidates, sorted, sizeof(*candidates) * (uint64_t)count);
+
+  uint32_t run_count = 0u;
+  uint32_t runs_formed = 0u;
+  uint32_t first = 0u;
+  for (uint32_t i = 1u; i <= count; ++i) {
+    if (i < count &&
+        vkr_world_instancing_same_run(&candidates[first], &candidates[i])) {
+      continue;
+    }
+    out_runs[run_count++] = (VkrWorldInstanceRun){
+        .first_candidate = first,
+        .instance_count = i - first,
+    };
+    runs_formed += i - first > 1u ? 1u : 0u;
+    first = i;
+  }
+
+  *out_run_count = run_count;
+  if (out_stats) {
+    out_stats->runs_formed += runs_formed;
+    out_stats->rows_saved += count - run_count;
+  }
+  return true_v;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file vkr_world_instancing.h
+ * @brief Automatic instancing over the world GPU candidate stream.
+ *
+ * The frontend emits one candidate row per instance x submesh pair. Repeated
+ * props that share geometry, submesh, material and state bucket would bind
+ * identical draw state row after row, so this pass reorders the stream to
+ * make such rows contiguous and describes each group as an instance run. The
+ * rows keep their own instance record and bounds; a run only promises that
+ * its rows, and therefore their packed instance data, are adjacent, which is
+ * what a backend needs to issue one indirect command per run.
+ */
+#pragma once
+
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+#include "renderer/vkr_render_packet.h"
+
+/** Counters for one instancing pass. */
+typedef struct VkrWorldInstancingStats {
+  /** Runs holding two or more rows. */
+  uint32_t runs_formed;
+  /** Rows folded into an earlier row of their run. */
+  uint32_t rows_saved;
+} VkrWorldInstancingStats;
+
+/**
+ * @brief Groups `candidates` into instance runs in place.
+ *
+ * Rows are ordered by state bucket first, then by a hash of their
+ * (geometry, submesh, material) key, using a stable radix sort so rows of one
+ * run keep their emission order and the result is deterministic frame to
+ * frame. Hash collisions never merge different keys: runs are split on the
+ * full key.
+ *
+ * @param scratch Frame allocator for the sort keys and the reorder copy.
+ * @param out_runs Receives one run per distinct key; must hold `count` runs.
+ * @param out_run_count Number of runs written.
+ * @param out_stats Optional; accumulated into, not overwritten.
+ * @return False when scratch is exhausted; `candidates` are then untouched.
+ */
+bool8_t vkr_world_instancing_build(VkrAllocator *scratch,
+                                   VkrWorldDrawCandidate *candidates,
+                                   uint32_t count,
+                                   VkrWorldInstanceRun *out_runs,
+                                   uint32_t *out_run_count,
+                                   VkrWorldInstancingStats *out_stats);
@@ -0,0 +1,746 @@
+/**
+ * @file vkr_world_payload.c
+ * @brief Builds the world pass payload from the mesh manager.
+ */
+
+#include "renderer/vkr_world_payload.h"
+
+#include "core/vkr_metrics.h"
+#include "renderer/systems/vkr_picking_ids.h"
+#include "renderer/vkr_world_instancing.h"
+
+#include <stdlib.h>
+
+void vkr_world_payload_cluster_source(RendererFrontend *rf,
+                                      const VkrStaticBatchCluster *cluster,
+                                      VkrWorldPayloadSource *out_source) {
+  VkrMaterial *material = vkr_world_payload_material(rf, cluster->material);
+  *out_source = (VkrWorldPayloadSource){
+      .geometry = cluster->geometry,
+      .material = material ? (VkrMaterialHandle){.id = material->id,
+                                                 .generation =
+                                                     material->generation}
+                           : cluster->material,
+      .model = mat4_identity(),
+      .center = cluster->center,
+      .min_extents = cluster->min_extents,
+      .max_extents = cluster->max_extents,
+      .alpha = vkr_world_payload_alpha_routing(rf, material),
+      .bounds_valid = true_v,
+      .transmissive = vkr_world_payload_is_transmissive(rf, material),
+      .double_sided = material ? material->double_sided : false_v,
+      .shadow_caster = true_v,
+  };
+}
+
+/**
+ * Why a camera-view row was dropped on the CPU. Transmission rows are never
+ * culled here; they carry no camera-opaque flag to drop.
+ */
+typedef enum VkrWorldCameraCull {
+  VKR_WORLD_CAMERA_CULL_NONE = 0,
+  VKR_WORLD_CAMERA_CULL_FRUSTUM,
+  VKR_WORLD_CAMERA_CULL_OCCLUSION,
+} VkrWorldCameraCull;
+
+/**
+ * @brief Culls one opaque, cutout or blend row for the camera views.
+ *
+ * Blend rows bypass GPU classification, so they are frustum-tested here;
+ * opaque and cutout rows leave the frustum test to the backend. Either kind
+ * is dropped when the CPU occlusion buffer hides its bounds.
+ */
+vkr_internal VkrWorldCameraCull vkr_world_payload_camera_cull(
+    const VkrFrustum *frustum, const VkrOcclusionBuffer *occlusion,
+    bool8_t world_transparent, bool8_t bounds_valid, Mat4 model, Vec3 center,
+    Vec3 min_extents, Vec3 max_extents) {
+  if (!bounds_valid)
+    return VKR_WORLD_CAMERA_CULL_NONE;
+  if (world_transparent) {
+    Vec3 world_center = {0};
+    float32_t radius = 0.0f;
+    vkr_visibility_submesh_sphere(model, center, min_extents, max_extents,
+                                  &world_center, &radius);
+    if (!vkr_frustum_test_sphere(frustum, world_center, radius))
+      return VKR_WORLD_CAMERA_CULL_FRUSTUM;
+  }
+  if (occlusion->rasterized &&
+      vkr_occlusion_test_box(occlusion, model, min_extents, max_extents))
+    return VKR_WORLD_CAMERA_CULL_OCCLUSION;
+  return VKR_WORLD_CAMERA_CULL_NONE;
+}
+
+/** Orders occluders by descending score, then by instance and submesh. */
+vkr_internal int vkr_world_occluder_compare(const void *lhs,
+                                            const void *rhs) {
+  const VkrWorldOccluderCandidate *a = lhs;
+  const VkrWorldOccluderCandidate *b = rhs;
+  if (a->score != b->score)
+    return a->score > b->score ? -1 : 1;
+  if (a->instance_index != b->instance_index)
+    return a->instance_index < b->instance_index ? -1 : 1;
+  if (a->submesh_index != b->submesh_index)
+    return a->submesh_index < b->submesh_index ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Describes `submesh` as occluder geometry.
+ *
+ * Only assets that kept a CPU copy of their merged buffers for static
+ * batching can occlude, and only up to VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES
+ * triangles.
+ */
+vkr_internal bool8_t
+vkr_world_payload_occluder_source(const VkrMeshAsset *asset,
+                                  const VkrMeshAssetSubmesh *submesh,
+                                  VkrTriangleMeshSource *out_source) {
+  const VkrStaticBatchSource *source = asset->static_source;
+  if (!source || submesh->index_count < 3u ||
+      submesh->index_count / 3u > VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES ||
+      submesh->first_index > source->index_count ||
+      submesh->index_count > source->index_count - submesh->first_index)
+    return false_v;
+  *out_source = (VkrTriangleMeshSource){
+      .positions = source->vertices,
+      .position_stride = sizeof(VkrVertex3d),
+      .vertex_count = source->vertex_count,
+      .indices = source->indices,
+      .index_size = source->index_size,
+      .first_index = submesh->first_index,
+      .index_count = submesh->index_count,
+      .vertex_offset = submesh->vertex_offset,
+  };
+  return true_v;
+}
+
+/** Keeps the chunk's best VKR_WORLD_PAYLOAD_OCCLUDERS_PER_CHUNK occluders. */
+vkr_internal void
+vkr_world_payload_keep_occluder(VkrWorldInstanceChunk *chunk,
+                                VkrWorldOccluderCandidate candidate) {
+  uint32_t slot = chunk->occluder_count;
+  if (slot == VKR_WORLD_PAYLOAD_OCCLUDERS_PER_CHUNK) {
+    if (vkr_world_occluder_compare(&candidate, &chunk->occluders[slot - 1u]) >=
+        0)
+      return;
+    slot--;
+  } else {
+    chunk->occluder_count++;
+  }
+  while (slot > 0u &&
+         vkr_world_occluder_compare(&candidate, &chunk->occluders[slot - 1u]) <
+             0) {
+    chunk->occluders[slot] = chunk->occluders[slot - 1u];
+    slot--;
+  }
+  chunk->occluders[slot] = candidate;
+}
+
+void vkr_world_payload_nominate_chunk(void *context, uint32_t chunk_index,
+                                      uint32_t first, uint32_t count) {
+  VkrWorldInstancePass *pass = context;
+  RendererFrontend *rf = pass->rf;
+  VkrWorldInstanceChunk *chunk = &pass->chunks[chunk_index];
+  for (uint32_t i = first; i < first + count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible || !instance->bounds_valid ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    if (!asset->static_source)
+      continue;
+    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      VkrTriangleMeshSource source = {0};
+      if (alpha.world_transparent || alpha.shadow_alpha_tested ||
+          vkr_world_payload_is_transmissive(rf, material) ||
+          !vkr_world_payload_occluder_source(asset, submesh, &source))
+        continue;
+      Vec3 center = {0};
+      float32_t radius = 0.0f;
+      vkr_visibility_submesh_sphere(instance->model, submesh->center,
+                                    submesh->min_extents, submesh->max_extents,
+                                    &center, &radius);
+      if (!vkr_frustum_test_sphere(&pass->camera_frustum, center, radius))
+        continue;
+      const float32_t distance_squared = vkr_max_f32(
+          vec3_length_squared(vec3_sub(center, pass->view_position)), 1e-4f);
+      const float32_t score = radius * radius / distance_squared;
+      if (score < VKR_WORLD_PAYLOAD_OCCLUDER_MIN_SCORE)
+        continue;
+      vkr_world_payload_keep_occluder(
+          chunk, (VkrWorldOccluderCandidate){
+                     .score = score, .instance_index = i, .submesh_index = s});
+    }
+  }
+}
+
+void vkr_world_payload_classify_chunk(void *context, uint32_t chunk_index,
+                                      uint32_t first, uint32_t count) {
+  VkrWorldInstancePass *pass = context;
+  RendererFrontend *rf = pass->rf;
+  VkrWorldInstanceChunk *chunk = &pass->chunks[chunk_index];
+  uint32_t source_index = pass->emit.source_index + chunk->source_first;
+  for (uint32_t i = first; i < first + count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      if (vkr_world_payload_submesh_batched(instance, s, pass->picking))
+        continue;
+      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      chunk->objects_without_bounds += instance->bounds_valid ? 0u : 1u;
+      chunk->transmission_count += transmissive ? 1u : 0u;
+      pass->camera_visible[source_index] = true_v;
+      if (!transmissive) {
+        const VkrWorldCameraCull cull = vkr_world_payload_camera_cull(
+            &pass->camera_frustum, pass->occlusion, alpha.world_transparent,
+            instance->bounds_valid, instance->model, submesh->center,
+            submesh->min_extents, submesh->max_extents);
+        const uint32_t kept = cull == VKR_WORLD_CAMERA_CULL_NONE ? 1u : 0u;
+        pass->camera_visible[source_index] = (uint8_t)kept;
+        if (alpha.world_transparent)
+          chunk->transparent_count += kept;
+        else
+          chunk->camera_opaque_count += kept;
+        chunk->objects_culled_camera +=
+            cull == VKR_WORLD_CAMERA_CULL_FRUSTUM ? 1u : 0u;
+        chunk->objects_culled_occlusion +=
+            cull == VKR_WORLD_CAMERA_CULL_OCCLUSION ? 1u : 0u;
+      }
+      source_index++;
+    }
+  }
+}
+
+void vkr_world_payload_emit_chunk(void *context, uint32_t chunk_index,
+                                  uint32_t first, uint32_t count) {
+  VkrWorldInstancePass *pass = context;
+  RendererFrontend *rf = pass->rf;
+  VkrWorldInstanceChunk *chunk = &pass->chunks[chunk_index];
+  VkrWorldPayloadEmit emit = pass->emit;
+  emit.source_index += chunk->source_first;
+  emit.gpu_index += chunk->source_first;
+  emit.transmission_index += chunk->transmission_first;
+  emit.transparent_index += chunk->transparent_first;
+  emit.shadow_caster_count = 0u;
+  for (uint32_t i = first; i < first + count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    const uint32_t object_id =
+        instance->render_id ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE,
+                                                    instance->render_id)
+                            : 0u;
+    const bool8_t shadow_caster =
+        !instance->bounds_valid ||
+        vkr_shadow_system_is_caster_relevant(
+            &rf->shadow_system,
+            vkr_mesh_bounds_index_instance_key(&rf->mesh_manager.bounds_index,
+                                               instance_slot));
+    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      if (vkr_world_payload_submesh_batched(instance, s, pass->picking))
+        continue;
+      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrMaterialHandle draw_material =
+          material ? (VkrMaterialHandle){.id = material->id,
+                                         .generation = material->generation}
+                   : submesh->material;
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      const VkrWorldPayloadSource source = {
+          .mesh = {.id = instance_slot + 1u,
+                   .generation = instance->generation},
+          .geometry = submesh->geometry,
+          .material = draw_material,
+          .model = instance->model,
+          .center = submesh->center,
+          .min_extents = submesh->min_extents,
+          .max_extents = submesh->max_extents,
+          .alpha = alpha,
+          .submesh_index = s,
+          .object_id = object_id,
+          .bounds_valid = instance->bounds_valid,
+          .transmissive = transmissive,
+          .double_sided = material ? material->double_sided : false_v,
+          .shadow_caster = shadow_caster,
+      };
+      vkr_world_payload_emit_source(&emit, &source);
+    }
+  }
+  chunk->shadow_caster_count = emit.shadow_caster_count;
+}
+
+/**
+ * @brief Fills `out_occlusion` with this frame's largest opaque occluders.
+ *
+ * Instance chunks nominate their best candidates on the job system; the
+ * nominations are ranked and added until the triangle budget is spent, then
+ * rasterized in bands on the same dispatcher. Leaves the buffer unrasterized,
+ * so nothing tests occluded, when no occluder qualifies or scratch runs out.
+ */
+vkr_internal void vkr_world_payload_build_occlusion(
+    const VkrWorldPayloadBuildDesc *desc, VkrWorldInstancePass *pass,
+    uint32_t chunk_count, VkrOcclusionBuffer *out_occlusion,
+    VkrVisibilityStats *stats) {
+  RendererFrontend *rf = desc->rf;
+#if VKR_METRICS_ENABLED
+  const float64_t start = vkr_platform_get_absolute_time();
+#endif
+  vkr_parallel_for_run(desc->dispatch,
+                       vkr_mesh_manager_instance_count(&rf->mesh_manager),
+                       VKR_WORLD_PAYLOAD_INSTANCE_CHUNK,
+                       vkr_world_payload_nominate_chunk, pass);
+  uint32_t nominated = 0u;
+  for (uint32_t c = 0; c < chunk_count; ++c) {
+    nominated += pass->chunks[c].occluder_count;
+  }
+  if (nominated == 0u)
+    return;
+  VkrWorldOccluderCandidate *occluders = vkr_allocator_alloc(
+      desc->scratch, sizeof(*occluders) * (uint64_t)nominated,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!occluders ||
+      !vkr_occlusion_buffer_init(
+          out_occlusion, desc->scratch,
+          mat4_mul(rf->globals.projection, rf->globals.view),
+          desc->occlusion_triangle_budget))
+    return;
+  uint32_t occluder_count = 0u;
+  for (uint32_t c = 0; c < chunk_count; ++c) {
+    for (uint32_t o = 0; o < pass->chunks[c].occluder_count; ++o) {
+      occluders[occluder_count++] = pass->chunks[c].occluders[o];
+    }
+  }
+  qsort(occluders, occluder_count, sizeof(*occluders),
+        vkr_world_occluder_compare);
+
+  for (uint32_t o = 0; o < occluder_count &&
+                       out_occlusion->triangle_count <
+                           out_occlusion->triangle_capacity;
+       ++o) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, occluders[o].instance_index, &instance_slot);
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    VkrMeshAssetSubmesh *submesh =
+        &asset->submeshes.data[occluders[o].submesh_index];
+    VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+    VkrTriangleMeshSource source = {0};
+    if (vkr_world_payload_occluder_source(asset, submesh, &source))
+      vkr_occlusion_add_occluder(out_occlusion, instance->model, &source,
+                                 material ? material->double_sided : false_v);
+  }
+  vkr_occlusion_rasterize(out_occlusion, desc->dispatch);
+  stats->occluders_rasterized = out_occlusion->occluder_count;
+  stats->occluder_triangles = out_occlusion->triangle_count;
+  stats->occlusion_rasterized = out_occlusion->rasterized;
+#if VKR_METRICS_ENABLED
+  stats->occlusion_raster_ns = vkr_metrics_elapsed_ns(start);
+#endif
+}
+
+bool8_t vkr_world_payload_build(const VkrWorldPayloadBuildDesc *desc,
+                                VkrWorldPassPayload *out_payload,
+                                VkrVisibilityStats *out_stats) {
+  RendererFrontend *rf = desc->rf;
+  VkrAllocator *scratch = desc->scratch;
+  const bool8_t picking = desc->picking;
+  const Mat4 view = rf->globals.view;
+  const VkrFrustum camera_frustum =
+      vkr_frustum_from_view_projection(view, rf->globals.projection);
+  const uint32_t mesh_count = vkr_mesh_manager_count(&rf->mesh_manager);
+  const uint32_t live_instance_count =
+      vkr_mesh_manager_instance_count(&rf->mesh_manager);
+  const uint32_t cluster_capacity =
+      picking ? 0u
+              : vkr_mesh_manager_static_cluster_capacity(&rf->mesh_manager);
+  VkrVisibilityStats stats = {0};
+  uint64_t candidate_count_64 = 0u;
+  const uint32_t instance_chunk_count = vkr_parallel_for_chunk_count(
+      live_instance_count, VKR_WORLD_PAYLOAD_INSTANCE_CHUNK);
+  VkrWorldInstanceChunk *instance_chunks = NULL;
+  if (instance_chunk_count > 0u) {
+    instance_chunks = vkr_allocator_alloc(
+        scratch, sizeof(*instance_chunks) * (uint64_t)instance_chunk_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (!instance_chunks) {
+      *out_payload = (VkrWorldPassPayload){0};
+      return false_v;
+    }
+    MemZero(instance_chunks,
+            sizeof(*instance_chunks) * (uint64_t)instance_chunk_count);
+  }
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (mesh->visible && mesh->loading_state == VKR_MESH_LOADING_STATE_LOADED)
+      candidate_count_64 += vkr_mesh_manager_submesh_count(mesh);
+  }
+  for (uint32_t i = 0; i < live_instance_count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    uint64_t source_count = asset->submeshes.length;
+    if (!picking)
+      source_count -= instance->static_batched_count;
+    candidate_count_64 += source_count;
+    instance_chunks[i / VKR_WORLD_PAYLOAD_INSTANCE_CHUNK].source_count +=
+        (uint32_t)source_count;
+  }
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    if (vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c))
+      candidate_count_64++;
+  }
+
+  if (candidate_count_64 > VKR_GPU_DRAW_CANDIDATE_CAPACITY) {
+    *out_payload = (VkrWorldPassPayload){
+        .gpu_candidate_count = VKR_GPU_DRAW_CANDIDATE_CAPACITY + 1u,
+    };
+    stats.objects_tested = VKR_GPU_DRAW_CANDIDATE_CAPACITY + 1u;
+    if (out_stats)
+      *out_stats = stats;
+    return true_v;
+  }
+
+  const uint32_t gpu_candidate_count = (uint32_t)candidate_count_64;
+  uint8_t *camera_visible = NULL;
+  if (gpu_candidate_count > 0u) {
+    camera_visible = vkr_allocator_alloc(scratch, gpu_candidate_count,
+                                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (!camera_visible) {
+      *out_payload = (VkrWorldPassPayload){0};
+      return false_v;
+    }
+    MemZero(camera_visible, gpu_candidate_count);
+  }
+
+  VkrOcclusionBuffer occlusion = {0};
+  VkrWorldInstancePass instance_pass = {
+      .rf = rf,
+      .picking = picking,
+      .camera_frustum = camera_frustum,
+      .view_position = rf->globals.view_position,
+      .occlusion = &occlusion,
+      .camera_visible = camera_visible,
+      .chunks = instance_chunks,
+  };
+  if (!picking && desc->occlusion_triangle_budget > 0u)
+    vkr_world_payload_build_occlusion(desc, &instance_pass,
+                                      instance_chunk_count, &occlusion, &stats);
+
+  uint32_t gpu_camera_opaque_candidate_count = 0u;
+  uint32_t transmission_gpu_candidate_count = 0u;
+  uint32_t transparent_draw_count = 0u;
+  uint32_t source_index = 0u;
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      VkrSubMesh *submesh =
+          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      stats.objects_tested++;
+      stats.objects_without_bounds += mesh->bounds_valid ? 0u : 1u;
+      transmission_gpu_candidate_count += transmissive ? 1u : 0u;
+      camera_visible[source_index] = true_v;
+      if (!transmissive) {
+        const VkrWorldCameraCull cull = vkr_world_payload_camera_cull(
+            &camera_frustum, &occlusion, alpha.world_transparent,
+            mesh->bounds_valid, mesh->model, submesh->center,
+            submesh->min_extents, submesh->max_extents);
+        const uint32_t kept = cull == VKR_WORLD_CAMERA_CULL_NONE ? 1u : 0u;
+        camera_visible[source_index] = (uint8_t)kept;
+        if (alpha.world_transparent)
+          transparent_draw_count += kept;
+        else
+          gpu_camera_opaque_candidate_count += kept;
+        stats.objects_culled_camera +=
+            cull == VKR_WORLD_CAMERA_CULL_FRUSTUM ? 1u : 0u;
+        stats.objects_culled_occlusion +=
+            cull == VKR_WORLD_CAMERA_CULL_OCCLUSION ? 1u : 0u;
+      }
+      source_index++;
+    }
+  }
+
+  // Source offsets come from the counting pass, so chunks can mark transparent
+  // visibility before the other offsets are known.
+  uint32_t instance_source_count = 0u;
+  for (uint32_t c = 0; c < instance_chunk_count; ++c) {
+    instance_chunks[c].source_first = instance_source_count;
+    instance_source_count += instance_chunks[c].source_count;
+  }
+  instance_pass.emit = (VkrWorldPayloadEmit){
+      .source_index = source_index,
+  };
+  vkr_parallel_for_run(desc->dispatch, live_instance_count,
+                       VKR_WORLD_PAYLOAD_INSTANCE_CHUNK,
+                       vkr_world_payload_classify_chunk, &instance_pass);
+  uint32_t instance_transmission_count = 0u;
+  uint32_t instance_transparent_count = 0u;
+  for (uint32_t c = 0; c < instance_chunk_count; ++c) {
+    VkrWorldInstanceChunk *chunk = &instance_chunks[c];
+    chunk->transmission_first = instance_transmission_count;
+    chunk->transparent_first = instance_transparent_count;
+    instance_transmission_count += chunk->transmission_count;
+    instance_transparent_count += chunk->transparent_count;
+    gpu_camera_opaque_candidate_count += chunk->camera_opaque_count;
+    stats.objects_tested += chunk->source_count;
+    stats.objects_without_bounds += chunk->objects_without_bounds;
+    stats.objects_culled_camera += chunk->objects_culled_camera;
+    stats.objects_culled_occlusion += chunk->objects_culled_occlusion;
+  }
+  transmission_gpu_candidate_count += instance_transmission_count;
+  transparent_draw_count += instance_transparent_count;
+  source_index += instance_source_count;
+
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    const VkrStaticBatchCluster *cluster =
+        vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c);
+    if (!cluster)
+      continue;
+    VkrWorldPayloadSource source = {0};
+    vkr_world_payload_cluster_source(rf, cluster, &source);
+    stats.objects_tested++;
+    transmission_gpu_candidate_count += source.transmissive ? 1u : 0u;
+    camera_visible[source_index] = true_v;
+    if (!source.transmissive) {
+      const VkrWorldCameraCull cull = vkr_world_payload_camera_cull(
+          &camera_frustum, &occlusion, source.alpha.world_transparent,
+          source.bounds_valid, source.model, source.center,
+          source.min_extents, source.max_extents);
+      const uint32_t kept = cull == VKR_WORLD_CAMERA_CULL_NONE ? 1u : 0u;
+      camera_visible[source_index] = (uint8_t)kept;
+      if (source.alpha.world_transparent)
+        transparent_draw_count += kept;
+      else
+        gpu_camera_opaque_candidate_count += kept;
+      stats.objects_culled_camera +=
+          cull == VKR_WORLD_CAMERA_CULL_FRUSTUM ? 1u : 0u;
+      stats.objects_culled_occlusion +=
+          cull == VKR_WORLD_CAMERA_CULL_OCCLUSION ? 1u : 0u;
+    }
+    source_index++;
+  }
+
+  VkrWorldDrawCandidate *gpu_candidates = NULL;
+  VkrWorldDrawCandidate *transmission_gpu_candidates = NULL;
+  VkrTransparentDrawCandidate *transparent_candidates = NULL;
+  VkrDrawItem *transparent_draws = NULL;
+  VkrInstanceDataGPU *transparent_instances = NULL;
+  if (gpu_candidate_count > 0u)
+    gpu_candidates = vkr_allocator_alloc(
+        scratch, sizeof(*gpu_candidates) * (uint64_t)gpu_candidate_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transmission_gpu_candidate_count > 0u)
+    transmission_gpu_candidates =
+        vkr_allocator_alloc(scratch,
+                            sizeof(*transmission_gpu_candidates) *
+                                (uint64_t)transmission_gpu_candidate_count,
+                            VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transparent_draw_count > 0u) {
+    transparent_candidates = vkr_allocator_alloc(
+        scratch,
+        sizeof(*transparent_candidates) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    transparent_draws = vkr_allocator_alloc(
+        scratch, sizeof(*transparent_draws) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    transparent_instances = vkr_allocator_alloc(
+        scratch,
+        sizeof(*transparent_instances) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if ((gpu_candidate_count > 0u && !gpu_candidates) ||
+      (transmission_gpu_candidate_count > 0u && !transmission_gpu_candidates) ||
+      (transparent_draw_count > 0u &&
+       (!transparent_candidates || !transparent_draws ||
+        !transparent_instances))) {
+    *out_payload = (VkrWorldPassPayload){0};
+    return false_v;
+  }
+
+  VkrWorldPayloadEmit emit = {
+      .view = view,
+      .camera_visible = camera_visible,
+      .gpu_candidates = gpu_candidates,
+      .transmission_gpu_candidates = transmission_gpu_candidates,
+      .transparent_candidates = transparent_candidates,
+  };
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    const uint32_t object_id =
+        mesh->render_id
+            ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE, mesh->render_id)
+            : 0u;
+    // Rows without bounds are never indexed and must keep casting.
+    const bool8_t shadow_caster =
+        !mesh->bounds_valid ||
+        vkr_shadow_system_is_caster_relevant(
+            &rf->shadow_system,
+            vkr_mesh_bounds_index_mesh_key(&rf->mesh_manager.bounds_index,
+                                           mesh_slot));
+    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      VkrSubMesh *submesh =
+          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrMaterialHandle draw_material =
+          material ? (VkrMaterialHandle){.id = material->id,
+                                         .generation = material->generation}
+                   : submesh->material;
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      const VkrWorldPayloadSource source = {
+          .mesh = {.id = mesh_slot + 1u, .generation = 0u},
+          .geometry = submesh->geometry,
+          .material = draw_material,
+          .model = mesh->model,
+          .center = submesh->center,
+          .min_extents = submesh->min_extents,
+          .max_extents = submesh->max_extents,
+          .alpha = alpha,
+          .submesh_index = s,
+          .object_id = object_id,
+          .bounds_valid = mesh->bounds_valid,
+          .transmissive = transmissive,
+          .double_sided = material ? material->double_sided : false_v,
+          .shadow_caster = shadow_caster,
+      };
+      vkr_world_payload_emit_source(&emit, &source);
+    }
+  }
+
+  instance_pass.emit = emit;
+  vkr_parallel_for_run(desc->dispatch, live_instance_count,
+                       VKR_WORLD_PAYLOAD_INSTANCE_CHUNK,
+                       vkr_world_payload_emit_chunk, &instance_pass);
+  emit.source_index += instance_source_count;
+  emit.gpu_index += instance_source_count;
+  emit.transmission_index += instance_transmission_count;
+  emit.transparent_index += instance_transparent_count;
+  for (uint32_t c = 0; c < instance_chunk_count; ++c) {
+    emit.shadow_caster_count += instance_chunks[c].shadow_caster_count;
+  }
+
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    const VkrStaticBatchCluster *cluster =
+        vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c);
+    if (!cluster)
+      continue;
+    VkrWorldPayloadSource source = {0};
+    vkr_world_payload_cluster_source(rf, cluster, &source);
+    vkr_world_payload_emit_source(&emit, &source);
+  }
+
+  VkrWorldInstanceRun *gpu_instance_runs = NULL;
+  VkrWorldInstanceRun *transmission_instance_runs = NULL;
+  uint32_t gpu_instance_run_count = 0u;
+  uint32_t transmission_instance_run_count = 0u;
+  VkrWorldInstancingStats instancing = {0};
+  if (gpu_candidate_count > 0u)
+    gpu_instance_runs = vkr_allocator_alloc(
+        scratch, sizeof(*gpu_instance_runs) * (uint64_t)gpu_candidate_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transmission_gpu_candidate_count > 0u)
+    transmission_instance_runs =
+        vkr_allocator_alloc(scratch,
+                            sizeof(*transmission_instance_runs) *
+                                (uint64_t)transmission_gpu_candidate_count,
+                            VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if ((gpu_candidate_count > 0u && !gpu_instance_runs) ||
+      (transmission_gpu_candidate_count > 0u && !transmission_instance_runs) ||
+      !vkr_world_instancing_build(scratch, gpu_candidates, gpu_candidate_count,
+                                  gpu_instance_runs, &gpu_instance_run_count,
+                                  &instancing) ||
+      !vkr_world_instancing_build(
+          scratch, transmission_gpu_candidates,
+          transmission_gpu_candidate_count, transmission_instance_runs,
+          &transmission_instance_run_count, &instancing)) {
+    *out_payload = (VkrWorldPassPayload){0};
+    return false_v;
+  }
+  stats.instance_runs_formed = instancing.runs_formed;
+  stats.instance_rows_saved = instancing.rows_saved;
+
+  if (transparent_draw_count > 1u)
+    qsort(transparent_candidates, transparent_draw_count,
+          sizeof(*transparent_candidates), vkr_transparent_draw_depth_compare);
+  vkr_transparent_draw_emit(transparent_candidates, transparent_draw_count,
+                            transparent_draws, transparent_instances);
+
+  *out_payload = (VkrWorldPassPayload){
+      .gpu_candidates = gpu_candidates,
+      .gpu_candidate_count = gpu_candidate_count,
+      .gpu_instance_runs = gpu_instance_runs,
+      .gpu_instance_run_count = gpu_instance_run_count,
+      .gpu_camera_opaque_candidate_count = gpu_camera_opaque_candidate_count,
+      .gpu_shadow_candidate_count = emit.shadow_caster_count,
+      .opaque_set_version = vkr_opaque_set_version_update(
+          desc->opaque_set_version, rf->mesh_manager.render_version,
+          rf->material_system.publication_version, picking),
+      .transmission_gpu_candidates = transmission_gpu_candidates,
+      .transmission_gpu_candidate_count = transmission_gpu_candidate_count,
+      .transmission_instance_runs = transmission_instance_runs,
+      .transmission_instance_run_count = transmission_instance_run_count,
+      .transparent_draws = transparent_draws,
+      .transparent_draw_count = transparent_draw_count,
+      .instances = transparent_instances,
+      .instance_count = transparent_draw_count,
+  };
+  if (out_stats)
+    *out_stats = stats;
+  return true_v;
+}
@@ -0,0 +1,267 @@
+/**
+ * @file vkr_world_payload.h
+ * @brief Builds the world pass payload from the mesh manager.
+ *
+ * Every loaded mesh, mesh instance and static batch cluster becomes one
+ * candidate row per submesh. Standalone meshes and clusters are walked on the
+ * calling thread; mesh instances are classified and then emitted in fixed
+ * chunks through a VkrParallelFor, each chunk writing at offsets prefix-summed
+ * from the chunk counts, so the rows match a serial walk however the chunks
+ * were scheduled. The row helpers and chunk callbacks are exported so tools
+ * can drive the same code outside an application.
+ */
+#pragma once
+
+#include "core/vkr_parallel_for.h"
+#include "defines.h"
+#include "memory/vkr_allocator.h"
+#include "renderer/renderer_frontend.h"
+#include "renderer/vkr_occlusion.h"
+#include "renderer/vkr_render_packet.h"
+#include "renderer/vkr_visibility.h"
+
+/** Live mesh instances one world payload job classifies or emits. */
+#define VKR_WORLD_PAYLOAD_INSTANCE_CHUNK 256u
+/** Occluders each instance chunk nominates for the CPU occlusion buffer. */
+#define VKR_WORLD_PAYLOAD_OCCLUDERS_PER_CHUNK 8u
+/** Smallest squared radius-to-distance ratio worth rasterizing as occluder. */
+#define VKR_WORLD_PAYLOAD_OCCLUDER_MIN_SCORE 0.0025f
+
+vkr_internal inline VkrMaterial *
+vkr_world_payload_material(RendererFrontend *rf, VkrMaterialHandle handle) {
+  return vkr_material_system_get_live(&rf->material_system, handle);
+}
+
+vkr_internal inline VkrDrawAlphaRouting
+vkr_world_payload_alpha_routing(RendererFrontend *rf, VkrMaterial *material) {
+  return vkr_draw_alpha_routing(
+      vkr_material_system_material_alpha_mode(&rf->material_system, material));
+}
+
+vkr_internal inline bool8_t
+vkr_world_payload_is_transmissive(RendererFrontend *rf, VkrMaterial *material) {
+  return vkr_material_system_material_is_transmissive(&rf->material_system,
+                                                      material);
+}
+
+vkr_internal inline float32_t
+vkr_world_payload_transparent_depth(Mat4 view, Mat4 model, Vec3 local_center) {
+  Vec3 world_center = mat4_mul_vec3(model, local_center);
+  Vec4 view_pos = mat4_mul_vec4(
+      view, vec4_new(world_center.x, world_center.y, world_center.z, 1.0f));
+  float32_t depth = -view_pos.z;
+  return depth > 0.0f ? depth : 0.0f;
+}
+
+vkr_internal inline uint64_t vkr_world_payload_sort_key(float32_t distance,
+                                                        uint32_t tie_breaker) {
+  uint32_t distance_bits = 0;
+  MemCopy(&distance_bits, &distance, sizeof(distance_bits));
+  return ((uint64_t)distance_bits << 32) | (uint64_t)tie_breaker;
+}
+
+/** One submesh, cluster or mesh row before it becomes a candidate. */
+typedef struct VkrWorldPayloadSource {
+  VkrMeshHandle mesh;
+  VkrGeometryHandle geometry;
+  VkrMaterialHandle material;
+  Mat4 model;
+  Vec3 center;
+  Vec3 min_extents;
+  Vec3 max_extents;
+  VkrDrawAlphaRouting alpha;
+  uint32_t submesh_index;
+  uint32_t object_id;
+  bool8_t bounds_valid;
+  bool8_t transmissive;
+  bool8_t double_sided;
+  bool8_t shadow_caster;
+} VkrWorldPayloadSource;
+
+/** Output arrays and write cursors for emitting source rows. */
+typedef struct VkrWorldPayloadEmit {
+  Mat4 view;
+  /** Per source row: kept by the camera views after CPU culling. */
+  const uint8_t *camera_visible;
+  VkrWorldDrawCandidate *gpu_candidates;
+  VkrWorldDrawCandidate *transmission_gpu_candidates;
+  VkrTransparentDrawCandidate *transparent_candidates;
+  uint32_t source_index;
+  uint32_t gpu_index;
+  uint32_t transmission_index;
+  uint32_t transparent_index;
+  uint32_t shadow_caster_count;
+} VkrWorldPayloadEmit;
+
+vkr_internal inline void
+vkr_world_payload_emit_source(VkrWorldPayloadEmit *context,
+                              const VkrWorldPayloadSource *source) {
+  const Vec3 half_extents =
+      vec3_scale(vec3_sub(source->max_extents, source->min_extents), 0.5f);
+  const VkrWorldDrawCandidate candidate = {
+      .mesh = source->mesh,
+      .geometry = source->geometry,
+      .submesh_index = source->submesh_index,
+      .material = source->material,
+      .instance = {.model = source->model, .object_id = source->object_id},
+      .local_bounding_sphere = {source->center.x, source->center.y,
+                                source->center.z, vec3_length(half_extents)},
+      .state_bucket = vkr_world_draw_state_bucket(
+          source->alpha.shadow_alpha_tested ? VKR_MATERIAL_ALPHA_CUTOUT
+                                            : VKR_MATERIAL_ALPHA_OPAQUE,
+          source->double_sided),
+      .flags =
+          (source->bounds_valid ? VKR_WORLD_DRAW_CANDIDATE_BOUNDS_VALID : 0u) |
+          (!source->transmissive && !source->alpha.world_transparent &&
+                   context->camera_visible[context->source_index]
+               ? VKR_WORLD_DRAW_CANDIDATE_CAMERA_OPAQUE
+               : 0u) |
+          (source->shadow_caster ? VKR_WORLD_DRAW_CANDIDATE_SHADOW_CASTER
+                                 : 0u),
+  };
+  context->gpu_candidates[context->gpu_index++] = candidate;
+  context->shadow_caster_count += source->shadow_caster ? 1u : 0u;
+  if (source->transmissive)
+    context->transmission_gpu_candidates[context->transmission_index++] =
+        candidate;
+  if (!source->transmissive && source->alpha.world_transparent &&
+      context->camera_visible[context->source_index]) {
+    const float32_t depth = vkr_world_payload_transparent_depth(
+        context->view, source->model, source->center);
+    context->transparent_candidates[context->transparent_index++] =
+        (VkrTransparentDrawCandidate){
+            .model = source->model,
+            .mesh = source->mesh,
+            .geometry = source->geometry,
+            .material = source->material,
+            .submesh_index = source->submesh_index,
+            .object_id = source->object_id,
+            .sort_key =
+                vkr_world_payload_sort_key(depth, context->source_index + 1u),
+        };
+  }
+  context->source_index++;
+}
+
+/** True when submesh `s` of `instance` draws through a static batch. */
+vkr_internal inline bool8_t
+vkr_world_payload_submesh_batched(const VkrMeshInstance *instance, uint32_t s,
+                                  bool8_t picking) {
+  return !picking && instance->static_batched && instance->static_batched[s];
+}
+
+/**
+ * @brief Describes a static batch cluster as a world source.
+ *
+ * Cluster vertices are already in world space, so the source draws with an
+ * identity model and the cluster's world bounds. Members may come from many
+ * instances, so the cluster has no object id and always casts.
+ */
+void vkr_world_payload_cluster_source(RendererFrontend *rf,
+                                      const VkrStaticBatchCluster *cluster,
+                                      VkrWorldPayloadSource *out_source);
+
+/** An opaque submesh nominated as occluder, ranked by projected size. */
+typedef struct VkrWorldOccluderCandidate {
+  float32_t score;
+  uint32_t instance_index; /**< Live instance index. */
+  uint32_t submesh_index;
+} VkrWorldOccluderCandidate;
+
+/**
+ * Counts one chunk of the instance range produces. The `*_first` fields are
+ * prefix sums over earlier chunks, relative to the first instance source, so
+ * merged output keeps instance order however the chunks were scheduled.
+ */
+typedef struct VkrWorldInstanceChunk {
+  uint32_t source_first;
+  uint32_t source_count;
+  uint32_t camera_opaque_count;
+  uint32_t transmission_first;
+  uint32_t transmission_count;
+  uint32_t transparent_first;
+  uint32_t transparent_count;
+  uint32_t shadow_caster_count;
+  uint32_t objects_without_bounds;
+  uint32_t objects_culled_camera;
+  uint32_t objects_culled_occlusion;
+  /** Best first, in descending score, then instance and submesh order. */
+  VkrWorldOccluderCandidate occluders[VKR_WORLD_PAYLOAD_OCCLUDERS_PER_CHUNK];
+  uint32_t occluder_count;
+} VkrWorldInstanceChunk;
+
+/** Read-only frame state shared by every instance chunk. */
+typedef struct VkrWorldInstancePass {
+  RendererFrontend *rf;
+  bool8_t picking;
+  VkrFrustum camera_frustum;
+  Vec3 view_position;
+  const VkrOcclusionBuffer *occlusion;
+  uint8_t *camera_visible;
+  VkrWorldInstanceChunk *chunks;
+  /** Output arrays, with the indices where instance rows begin. */
+  VkrWorldPayloadEmit emit;
+} VkrWorldInstancePass;
+
+/**
+ * VkrParallelForFn over live instances: nominates the chunk's largest opaque
+ * submeshes in view as occluders. `context` is a VkrWorldInstancePass.
+ */
+void vkr_world_payload_nominate_chunk(void *context, uint32_t chunk_index,
+                                      uint32_t first, uint32_t count);
+
+/**
+ * VkrParallelForFn over live instances: counts the chunk's rows and marks
+ * which of them the camera views keep. Needs `source_count` and
+ * `source_first` of every chunk filled in.
+ */
+void vkr_world_payload_classify_chunk(void *context, uint32_t chunk_index,
+                                      uint32_t first, uint32_t count);
+
+/**
+ * VkrParallelForFn over live instances: writes the chunk's candidate rows at
+ * the offsets prefix-summed from the classify pass.
+ */
+void vkr_world_payload_emit_chunk(void *context, uint32_t chunk_index,
+                                  uint32_t first, uint32_t count);
+
+typedef struct VkrWorldPayloadBuildDesc {
+  RendererFrontend *rf;
+  /** Runs the instance chunks; a NULL job system keeps them on the caller. */
+  VkrParallelFor *dispatch;
+  /** Frame allocator for the payload arrays and per-chunk counts. */
+  VkrAllocator *scratch;
+  /** Occluder triangles the CPU occlusion buffer takes; 0 skips occlusion. */
+  uint32_t occlusion_triangle_budget;
+  bool8_t picking;
+  /** Rolled forward into the payload's `opaque_set_version`. */
+  VkrOpaqueSetVersion *opaque_set_version;
+} VkrWorldPayloadBuildDesc;
+
+/**
+ * @brief Builds the sole GPU-driven world source and retained blend list.
+ *
+ * Opaque, cutout, transmission, and shadow visibility remain unculled packet
+ * candidates; the selected backend owns their multi-view classification.
+ * Ordinary alpha blend is the only camera-culled and depth-sorted CPU list.
+ * The CPU reductions are flags: rows whose bounds overlap no cascade in the
+ * shadow system's caster lists drop the shadow-caster flag before upload.
+ *
+ * Outside picking frames, the largest opaque submeshes in view are also
+ * rasterized into a small CPU depth buffer (see vkr_occlusion.h). Opaque and
+ * cutout rows it hides drop the camera-opaque flag but keep casting shadows;
+ * hidden blend rows leave the blend list. Transmission rows are never tested.
+ *
+ * Candidate rows are then grouped into instance runs (see
+ * vkr_world_instancing.h), so their order differs from emission order.
+ *
+ * Static batch clusters replace the submeshes they bake, except on picking
+ * frames: those draw the original submeshes so each keeps its object id.
+ *
+ * @return False when scratch runs out. More candidates than
+ * VKR_GPU_DRAW_CANDIDATE_CAPACITY return true with an empty payload whose
+ * `gpu_candidate_count` is past the capacity, for the caller to reject.
+ */
+bool8_t vkr_world_payload_build(const VkrWorldPayloadBuildDesc *desc,
+                                VkrWorldPassPayload *out_payload,
+                                VkrVisibilityStats *out_stats);
@@ -107,9 +107,9 @@ bool8_t vkr_vk_record_deferred_upload(VkrVulkanRenderer *renderer,
       vkr_vk_deferred_buffer(renderer, pass, 1u);
   const uint32_t count = transmission ? slot->transmission_gpu_candidate_count
                                       : slot->gpu_candidate_count;
-  const uint64_t source_offset =
-      transmission ? slot->transmission_gpu_candidate_upload_offset
-                   : slot->gpu_candidate_upload_offset;
+  const VkrVulkanWorldRows *rows =
+      &slot->world_rows[transmission ? VKR_VULKAN_WORLD_ROWS_TRANSMISSION
+                                     : VKR_VULKAN_WORLD_ROWS_OPAQUE];
   if (!candidates || !state)
     return false_v;
   if (transmission)
@@ -118,11 +118,10 @@ bool8_t vkr_vk_record_deferred_upload(VkrVulkanRenderer *renderer,
     slot->gpu_compaction_state = state;
   if (count) {
     const VkBufferCopy copy = {
-        .srcOffset = source_offset,
         .size = (uint64_t)count * sizeof(VkrGpuCandidateDrawRow),
     };
-    vkCmdCopyBuffer(command, slot->frame_upload.handle,
-                    candidates->buffer.handle, 1u, &copy);
+    vkCmdCopyBuffer(command, rows->buffer.handle, candidates->buffer.handle,
+                    1u, &copy);
   }
   vkCmdFillBuffer(command, state->buffer.handle, 0u, VK_WHOLE_SIZE, 0u);
   return true_v;
@@ -922,6 +922,7 @@ vkr_internal bool8_t vkr_vk_try_candidate(VkrVulkanDevice *device,
   VkPhysicalDeviceVulkan13Features features13 = {
       .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES,
       .pNext = &features14,
+      .pipelineCreationCacheControl = VK_TRUE,
       .synchronization2 = VK_TRUE,
       .dynamicRendering = VK_TRUE,
       .maintenance4 = VK_TRUE,
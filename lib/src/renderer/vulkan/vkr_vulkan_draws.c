@@ -1,10 +1,11 @@
 #include "renderer/vulkan/vkr_vulkan_internal.h"
 
 vkr_internal bool8_t vkr_vk_pack_gpu_candidates(
-    VkrVulkanRenderer *renderer, VkrVulkanFrameSlot *slot,
+    VkrVulkanRenderer *renderer, VkrVulkanWorldRows *rows,
     const VkrWorldDrawCandidate *source, uint32_t count,
-    uint64_t *out_candidate_offset, uint64_t *out_instances_address,
-    uint32_t *out_packed_count);
+    const VkrWorldInstanceRun *runs, uint32_t run_count,
+    uint64_t *out_instances_address, uint32_t *out_packed_count,
+    uint64_t *out_upload_bytes);
 
 vkr_internal uint64_t vkr_vk_hash_bytes(uint64_t hash, const void *bytes,
                                         uint64_t size) {
@@ -43,6 +44,19 @@ vkr_internal uint64_t vkr_vk_candidate_epoch(
   return vkr_vk_hash_bytes(hash, &occluder_count, sizeof(occluder_count));
 }
 
+/**
+ * Producers that version their opaque set spare the per-frame candidate hash;
+ * unversioned packets keep the hashed epoch.
+ */
+vkr_internal uint64_t vkr_vk_world_epoch(const VkrWorldPassPayload *world) {
+  if (!world)
+    return 0u;
+  if (world->opaque_set_version != 0u)
+    return world->opaque_set_version;
+  return vkr_vk_candidate_epoch(world->gpu_candidates,
+                                world->gpu_candidate_count);
+}
+
 uint64_t vkr_vk_align_up(uint64_t value, uint64_t alignment) {
   return (value + alignment - 1u) & ~(alignment - 1u);
 }
@@ -231,8 +245,6 @@ bool8_t vkr_vk_prepare_packet_uploads(VkrVulkanRenderer *renderer,
   slot->gpu_candidate_instances = 0u;
   slot->transmission_gpu_candidate_instances = 0u;
   slot->gpu_geometry_rows = 0u;
-  slot->gpu_candidate_upload_offset = 0u;
-  slot->transmission_gpu_candidate_upload_offset = 0u;
   slot->gpu_candidate_count = 0u;
   slot->transmission_gpu_candidate_count = 0u;
   slot->gpu_world_epoch = 0u;
@@ -281,39 +293,43 @@ bool8_t vkr_vk_prepare_packet_uploads(VkrVulkanRenderer *renderer,
 #if VKR_METRICS_ENABLED
   const float64_t hash_start = vkr_platform_get_absolute_time();
 #endif
-  slot->gpu_world_epoch =
-      packet->world ? vkr_vk_candidate_epoch(packet->world->gpu_candidates,
-                                             packet->world->gpu_candidate_count)
-                    : 0u;
+  slot->gpu_world_epoch = vkr_vk_world_epoch(packet->world);
 #if VKR_METRICS_ENABLED
   slot->packet_build.candidate_hash_ns = vkr_metrics_elapsed_ns(hash_start);
 
   const float64_t pack_start = vkr_platform_get_absolute_time();
 #endif
+  uint64_t upload_bytes = 0u;
   const bool8_t packed =
       vkr_vk_pack_gpu_candidates(
-          renderer, slot, packet->world ? packet->world->gpu_candidates : NULL,
+          renderer, &slot->world_rows[VKR_VULKAN_WORLD_ROWS_OPAQUE],
+          packet->world ? packet->world->gpu_candidates : NULL,
           packet->world ? packet->world->gpu_candidate_count : 0u,
-          &slot->gpu_candidate_upload_offset, &slot->gpu_candidate_instances,
-          &slot->gpu_candidate_count) &&
+          packet->world ? packet->world->gpu_instance_runs : NULL,
+          packet->world ? packet->world->gpu_instance_run_count : 0u,
+          &slot->gpu_candidate_instances, &slot->gpu_candidate_count,
+          &upload_bytes) &&
       vkr_vk_pack_gpu_candidates(
-          renderer, slot,
+          renderer, &slot->world_rows[VKR_VULKAN_WORLD_ROWS_TRANSMISSION],
           packet->world ? packet->world->transmission_gpu_candidates : NULL,
           packet->world ? packet->world->transmission_gpu_candidate_count : 0u,
-          &slot->transmission_gpu_candidate_upload_offset,
+          packet->world ? packet->world->transmission_instance_runs : NULL,
+          packet->world ? packet->world->transmission_instance_run_count : 0u,
           &slot->transmission_gpu_candidate_instances,
-          &slot->transmission_gpu_candidate_count);
+          &slot->transmission_gpu_candidate_count, &upload_bytes);
 #if VKR_METRICS_ENABLED
   slot->packet_build.candidate_pack_ns = vkr_metrics_elapsed_ns(pack_start);
 #endif
   /* The gauges report actual row writes. A publication-boundary omission must
      change work volume or a timing drop could be mistaken for a faster pack. */
-  const uint64_t written_candidates = (uint64_t)slot->gpu_candidate_count +
-                                      slot->transmission_gpu_candidate_count;
+  const uint64_t written_candidates =
+      (uint64_t)slot->world_rows[VKR_VULKAN_WORLD_ROWS_OPAQUE].packed_count +
+      slot->world_rows[VKR_VULKAN_WORLD_ROWS_TRANSMISSION].packed_count;
   slot->packet_build.candidate_row_bytes =
       written_candidates * sizeof(VkrGpuCandidateDrawRow);
   slot->packet_build.instance_row_bytes =
       written_candidates * sizeof(VkrInstanceDataGPU);
+  slot->packet_build.candidate_upload_bytes = upload_bytes;
   slot->packet_build.valid = packed;
   return packed;
 }
@@ -341,67 +357,193 @@ vkr_vk_resolve_material(VkrVulkanRenderer *renderer, VkrMaterialHandle handle) {
              : NULL;
 }
 
+/**
+ * Grows the stream's buffer to hold `row_count` rows and writes the rows that
+ * changed since this slot last drew. A regrown buffer starts empty, so both
+ * tables are invalidated and every row is written once.
+ */
+vkr_internal bool8_t vkr_vk_commit_world_rows(VkrVulkanRenderer *renderer,
+                                              VkrVulkanWorldRows *rows,
+                                              uint32_t row_count,
+                                              uint64_t *out_upload_bytes) {
+  if (row_count > rows->capacity) {
+    uint32_t capacity =
+        Max(rows->capacity, (uint32_t)VKR_VULKAN_WORLD_ROW_MIN_CAPACITY);
+    while (capacity < row_count)
+      capacity <<= 1u;
+    capacity = Min(capacity, VKR_GPU_DRAW_CANDIDATE_CAPACITY);
+    const VkDeviceSize instance_offset =
+        vkr_vk_align_up((uint64_t)capacity * sizeof(VkrGpuCandidateDrawRow),
+                        _Alignof(VkrInstanceDataGPU));
+    vkr_vk_destroy_buffer(renderer, &rows->buffer);
+    rows->capacity = 0u;
+    vkr_row_table_invalidate(&rows->candidates);
+    vkr_row_table_invalidate(&rows->instances);
+    if (!vkr_vk_create_buffer(
+            renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD,
+            instance_offset + (uint64_t)capacity * sizeof(VkrInstanceDataGPU),
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            &rows->buffer)) {
+      log_error("Vulkan failed to grow world rows to %u candidates",
+                capacity);
+      return false_v;
+    }
+    rows->capacity = capacity;
+    rows->instance_offset = instance_offset;
+  }
+
+  VkrRowTable *tables[] = {&rows->candidates, &rows->instances};
+  const VkDeviceSize table_offsets[] = {0u, rows->instance_offset};
+  uint8_t *mapped = rows->buffer.allocation.mapped;
+  for (uint32_t t = 0u; t < ArrayCount(tables); ++t) {
+    VkrRowTable *table = tables[t];
+    const VkrRowTableRange *ranges = NULL;
+    const uint32_t range_count =
+        vkr_row_table_commit(table, row_count, &ranges);
+    if (!range_count)
+      continue;
+    const uint8_t *resident = vkr_row_table_rows(table);
+    for (uint32_t r = 0u; r < range_count; ++r) {
+      const uint64_t offset = (uint64_t)ranges[r].first_row * table->row_size;
+      MemCopy(mapped + table_offsets[t] + offset, resident + offset,
+              (uint64_t)ranges[r].row_count * table->row_size);
+    }
+    const VkrRowTableRange *last = &ranges[range_count - 1u];
+    const uint64_t first_byte = (uint64_t)ranges[0].first_row * table->row_size;
+    const uint64_t end_byte =
+        (uint64_t)(last->first_row + last->row_count) * table->row_size;
+    if (!vkr_vk_flush(renderer, &rows->buffer.allocation,
+                      table_offsets[t] + first_byte, end_byte - first_byte)) {
+      log_error("Vulkan failed to flush %llu world row bytes",
+                (unsigned long long)(end_byte - first_byte));
+      return false_v;
+    }
+    *out_upload_bytes += table->stats.upload_bytes;
+  }
+  return true_v;
+}
+
+/** Candidates keep their row while their instance and submesh persist. */
+vkr_internal uint32_t
+vkr_vk_world_row_slot(VkrRowSlotMap *slots,
+                      const VkrWorldDrawCandidate *candidate) {
+  return vkr_row_slot_map_acquire(
+      slots, (VkrRowSlotKey){
+                 .owner = (uint64_t)candidate->mesh.id |
+                          (uint64_t)candidate->mesh.generation << 32u,
+                 .part = (uint64_t)candidate->geometry.id |
+                         (uint64_t)candidate->submesh_index << 32u,
+             });
+}
+
+/** A row the cull rejects: no bucket and no pass flags. */
+vkr_internal void vkr_vk_clear_world_row(VkrGpuCandidateDrawRow *candidates,
+                                         VkrInstanceDataGPU *instances,
+                                         uint32_t slot) {
+  candidates[slot] = (VkrGpuCandidateDrawRow){
+      .instance_index = slot,
+      .state_bucket = UINT32_MAX,
+  };
+  instances[slot] = (VkrInstanceDataGPU){0};
+}
+
+/**
+ * Packs candidate rows into the slot's persistent world rows and writes only
+ * the rows that changed. Rows are walked by instance run: every row of a run
+ * shares geometry, submesh and material, so those resolve once per run.
+ * Without runs, each row is its own run.
+ *
+ * Each candidate lands in the row its instance and submesh held last frame,
+ * so the per-frame bucket sort does not shift rows and an insert or removal
+ * dirties only its own row. Rows left behind by removed candidates, and rows
+ * of candidates omitted at the publication boundary, are cleared to rows the
+ * cull rejects, which is why the cull walks every row up to the slot count.
+ */
 vkr_internal bool8_t vkr_vk_pack_gpu_candidates(
-    VkrVulkanRenderer *renderer, VkrVulkanFrameSlot *slot,
+    VkrVulkanRenderer *renderer, VkrVulkanWorldRows *rows,
     const VkrWorldDrawCandidate *source, uint32_t count,
-    uint64_t *out_candidate_offset, uint64_t *out_instances_address,
-    uint32_t *out_packed_count) {
+    const VkrWorldInstanceRun *runs, uint32_t run_count,
+    uint64_t *out_instances_address, uint32_t *out_packed_count,
+    uint64_t *out_upload_bytes) {
   *out_packed_count = 0u;
+  *out_instances_address = 0u;
+  rows->packed_count = 0u;
+  VkrRowSlotMap *slots = &rows->slots;
   if (!count) {
-    *out_candidate_offset = 0u;
-    *out_instances_address = 0u;
+    vkr_row_slot_map_reset(slots);
     return true_v;
   }
   if (!source || count > VKR_GPU_DRAW_CANDIDATE_CAPACITY)
     return false_v;
-  VkrGpuCandidateDrawRow *candidates = vkr_vk_frame_upload_allocate(
-      slot, (uint64_t)count * sizeof(*candidates),
-      _Alignof(VkrGpuCandidateDrawRow), NULL, out_candidate_offset);
-  VkrInstanceDataGPU *instances = vkr_vk_frame_upload_allocate(
-      slot, (uint64_t)count * sizeof(*instances), _Alignof(VkrInstanceDataGPU),
-      out_instances_address, NULL);
-  if (!candidates || !instances)
+  if ((uint64_t)slots->slot_count + count > VKR_GPU_DRAW_CANDIDATE_CAPACITY)
+    vkr_row_slot_map_reset(slots);
+  if (!vkr_row_slot_map_begin(slots, count)) {
+    log_error("Vulkan failed to place %u world candidate rows", count);
+    return false_v;
+  }
+  const uint32_t stage_count = slots->slot_count + count;
+  VkrGpuCandidateDrawRow *candidates =
+      vkr_row_table_begin(&rows->candidates, stage_count);
+  VkrInstanceDataGPU *instances =
+      vkr_row_table_begin(&rows->instances, stage_count);
+  if (!candidates || !instances) {
+    log_error("Vulkan failed to stage %u world candidate rows", count);
     return false_v;
+  }
   const uint64_t pending_submit = renderer->submit_value + 1u;
   uint32_t packed_count = 0u;
   uint32_t unpublished_geometry_count = 0u;
   uint32_t unpublished_material_count = 0u;
   uint32_t invalid_submesh_count = 0u;
-  for (uint32_t i = 0u; i < count; ++i) {
-    const VkrWorldDrawCandidate *candidate = &source[i];
+  const bool8_t by_run = runs && run_count > 0u;
+  const uint32_t walk_count = by_run ? run_count : count;
+  for (uint32_t r = 0u; r < walk_count; ++r) {
+    const uint32_t first = by_run ? runs[r].first_candidate : r;
+    const uint32_t row_count = by_run ? runs[r].instance_count : 1u;
+    const VkrWorldDrawCandidate *head = &source[first];
     VkrVulkanPublishedGeometry *geometry =
-        vkr_vk_resolve_geometry(renderer, candidate->geometry);
+        vkr_vk_resolve_geometry(renderer, head->geometry);
     VkrVulkanPublishedMaterial *material =
-        vkr_vk_resolve_material(renderer, candidate->material);
-    if (!geometry) {
-      unpublished_geometry_count++;
-      continue;
-    }
-    if (!material) {
-      unpublished_material_count++;
+        vkr_vk_resolve_material(renderer, head->material);
+    if (!geometry || !material) {
+      // Omitted rows keep their slot so they do not move once published.
+      for (uint32_t i = first; i < first + row_count; ++i)
+        vkr_vk_clear_world_row(candidates, instances,
+                               vkr_vk_world_row_slot(slots, &source[i]));
+      if (!geometry)
+        unpublished_geometry_count += row_count;
+      else
+        unpublished_material_count += row_count;
       continue;
     }
-    if (candidate->submesh_index >= geometry->submesh_count) {
-      invalid_submesh_count++;
+    if (head->submesh_index >= geometry->submesh_count) {
+      invalid_submesh_count += row_count;
       continue;
     }
     const VkrVulkanSubmeshRange *submesh =
-        &geometry->submeshes[candidate->submesh_index];
-    candidates[packed_count] = (VkrGpuCandidateDrawRow){
-        .geometry_index = candidate->geometry.id - 1u,
-        .material_index = material->slot.index,
-        .instance_index = packed_count,
-        .first_index = geometry->gpu_row.first_index + submesh->first_index,
-        .index_count = submesh->index_count,
-        .vertex_offset = submesh->vertex_offset,
-        .state_bucket = candidate->state_bucket,
-        .flags = candidate->flags,
-        .local_bounding_sphere = candidate->local_bounding_sphere,
-    };
-    instances[packed_count++] = candidate->instance;
+        &geometry->submeshes[head->submesh_index];
+    for (uint32_t i = first; i < first + row_count; ++i) {
+      const VkrWorldDrawCandidate *candidate = &source[i];
+      const uint32_t slot = vkr_vk_world_row_slot(slots, candidate);
+      candidates[slot] = (VkrGpuCandidateDrawRow){
+          .geometry_index = head->geometry.id - 1u,
+          .material_index = material->slot.index,
+          .instance_index = slot,
+          .first_index = geometry->gpu_row.first_index + submesh->first_index,
+          .index_count = submesh->index_count,
+          .vertex_offset = submesh->vertex_offset,
+          .state_bucket = candidate->state_bucket,
+          .flags = candidate->flags,
+          .local_bounding_sphere = candidate->local_bounding_sphere,
+      };
+      instances[slot] = candidate->instance;
+      packed_count++;
+    }
     geometry->last_use_submit_value =
         Max(geometry->last_use_submit_value, pending_submit);
   }
+  vkr_row_slot_map_end(slots);
   // A submesh index outside a resolved geometry is malformed candidate
   // structure and is rejected before recording, per the P21 retirement
   // contract. An unresolved geometry or material handle is the bounded
@@ -423,7 +565,15 @@ vkr_internal bool8_t vkr_vk_pack_gpu_candidates(
              unpublished_material_count);
     renderer->deferred_candidate_drop_logged = true_v;
   }
-  *out_packed_count = packed_count;
+  const uint32_t slot_count = slots->slot_count;
+  for (uint32_t slot = 0u; slot < slot_count; ++slot)
+    if (!vkr_row_slot_map_live(slots, slot))
+      vkr_vk_clear_world_row(candidates, instances, slot);
+  if (!vkr_vk_commit_world_rows(renderer, rows, slot_count, out_upload_bytes))
+    return false_v;
+  *out_instances_address = rows->buffer.address + rows->instance_offset;
+  *out_packed_count = slot_count;
+  rows->packed_count = packed_count;
   return true_v;
 }
 
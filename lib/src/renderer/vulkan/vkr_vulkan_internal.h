@@ -16,8 +16,11 @@
 #include "renderer/vkr_gpu_submit_ring.h"
 #include "renderer/vkr_ibl_math.h"
 #include "renderer/vkr_packet_constants.h"
+#include "renderer/vkr_pipeline_manifest.h"
 #include "renderer/vkr_render_graph_internal.h"
 #include "renderer/vkr_rg_json.h"
+#include "renderer/vkr_row_table.h"
+#include "renderer/vkr_upload_planner.h"
 #include "renderer/vulkan/vkr_vulkan_dependency.h"
 #include "renderer/vulkan/vkr_vulkan_memory.h"
 #include "renderer/vulkan/vkr_vulkan_wsi.h"
@@ -133,6 +136,9 @@ enum {
   VKR_VULKAN_TEXTURE_MIP_MAX = 16,
   VKR_VULKAN_PENDING_IBL_BAKE_MAX = 32,
   VKR_VULKAN_FRAME_UPLOAD_SIZE = 48u * 1024u * 1024u,
+  /** Clean world rows rewritten to join two dirty ranges into one write. */
+  VKR_VULKAN_WORLD_ROW_MERGE_GAP = 8,
+  VKR_VULKAN_WORLD_ROW_MIN_CAPACITY = 1024,
 };
 
 enum {
@@ -646,6 +652,33 @@ typedef struct VkrVulkanRetiredTargetSet {
   bool8_t occupied;
 } VkrVulkanRetiredTargetSet;
 
+/** World candidate stream index into VkrVulkanFrameSlot.world_rows. */
+typedef enum VkrVulkanWorldRowStream {
+  VKR_VULKAN_WORLD_ROWS_OPAQUE = 0,
+  VKR_VULKAN_WORLD_ROWS_TRANSMISSION,
+  VKR_VULKAN_WORLD_ROWS_COUNT,
+} VkrVulkanWorldRowStream;
+
+/**
+ * Persistent candidate and instance rows of one world stream for one frame
+ * slot. The buffer holds `capacity` candidate rows followed by `capacity`
+ * instance rows at `instance_offset`. A slot is only rewritten once its
+ * previous submission retired, so the tables mirror exactly what the buffer
+ * holds and each frame writes only the rows that changed since this slot's
+ * last frame.
+ */
+typedef struct VkrVulkanWorldRows {
+  VkrVulkanBuffer buffer;
+  VkDeviceSize instance_offset;
+  uint32_t capacity;
+  VkrRowTable candidates;
+  VkrRowTable instances;
+  /** Keeps each candidate in the row it held last frame. */
+  VkrRowSlotMap slots;
+  /** Rows of the last pack that carry a draw; the rest are cleared. */
+  uint32_t packed_count;
+} VkrVulkanWorldRows;
+
 typedef struct VkrVulkanFrameSlot {
   VkCommandPool command_pool;
   VkCommandBuffer command_buffer;
@@ -679,8 +712,7 @@ typedef struct VkrVulkanFrameSlot {
   uint64_t gpu_candidate_instances;
   uint64_t transmission_gpu_candidate_instances;
   uint64_t gpu_geometry_rows;
-  uint64_t gpu_candidate_upload_offset;
-  uint64_t transmission_gpu_candidate_upload_offset;
+  VkrVulkanWorldRows world_rows[VKR_VULKAN_WORLD_ROWS_COUNT];
   VkrVulkanGraphBufferInstance *gpu_compaction_state;
   VkrVulkanGraphBufferInstance *transmission_gpu_compaction_state;
   uint32_t gpu_candidate_count;
@@ -790,7 +822,8 @@ typedef struct VkrVulkanPendingTextureInitialization {
 } VkrVulkanPendingTextureInitialization;
 
 typedef struct VkrVulkanPendingBufferInitialization {
-  VkrVulkanBuffer staging;
+  /** Bytes staged in the open upload ring slice, starting at next_offset. */
+  VkDeviceSize staged_size;
   VkBuffer destination;
   uint8_t *upload_data;
   VkDeviceSize size;
@@ -907,6 +940,10 @@ struct VkrVulkanRenderer {
   VkrGpuSubmitRing command_ring;
   VkrGpuSubmitRingSlot command_ring_slots[VKR_VULKAN_FRAME_SLOT_COUNT];
   VkrGpuRingSlice active_command_slice;
+  /* Persistent host-visible staging for buffer publications, one ring slice
+     per frame slot. The planner coalesces each frame's chunks into it. */
+  VkrVulkanBuffer upload_ring;
+  VkrUploadPlanner upload_planner;
   VkrCaptureRing capture_ring;
   void *capture_storage;
   uint64_t capture_storage_size;
@@ -943,9 +980,6 @@ struct VkrVulkanRenderer {
   uint32_t pending_buffer_initialization_capacity;
   uint32_t retired_staging_buffer_capacity;
   uint32_t staging_buffer_count;
-  /* Which publication class claims the single bounded staging chunk next.
-     Buffers and textures alternate so neither starves the other. */
-  bool8_t stage_textures_first;
   void *sampled_image_slot_storage;
   void *storage_image_slot_storage;
   void *sampler_slot_storage;
@@ -966,6 +1000,12 @@ struct VkrVulkanRenderer {
   VkPipelineLayout pipeline_layout;
   VkPipelineCache pipeline_cache;
   char pipeline_cache_path[1024];
+  /** Keys of the pipelines the persisted cache holds, for the next start. */
+  VkrPipelineManifest pipeline_manifest;
+  /** Device, driver and cache format identity the manifest is bound to. */
+  uint64_t pipeline_device_key;
+  /** Pipelines were compiled, so the cache and manifest must be saved. */
+  bool8_t pipeline_cache_dirty;
   VkShaderModule packet_shaders[VKR_VULKAN_PACKET_SHADER_COUNT];
   VkPipeline packet_pipelines[VKR_VULKAN_PACKET_PIPELINE_COUNT];
   VkShaderModule ibl_shaders[VKR_VULKAN_IBL_PIPELINE_COUNT];
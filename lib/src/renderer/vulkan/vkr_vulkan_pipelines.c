@@ -1,10 +1,316 @@
 #include "renderer/vulkan/vkr_vulkan_internal.h"
 
+#define VKR_VULKAN_PIPELINE_CACHE_MAX_BYTES MB(64)
+#define VKR_VULKAN_PIPELINE_MANIFEST_MAX_BYTES KB(64)
+/** Room for the cache path plus a ".manifest.tmp" suffix. */
+#define VKR_VULKAN_PIPELINE_PATH_MAX 1040u
+#define VKR_VULKAN_PIPELINE_PUSH_STAGES                                        \
+  (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT |                 \
+   VK_SHADER_STAGE_COMPUTE_BIT)
+#define VKR_VULKAN_SHADER_SOURCE_COUNT                                         \
+  (VKR_VULKAN_PACKET_SHADER_COUNT + VKR_VULKAN_IBL_PIPELINE_COUNT +            \
+   VKR_VULKAN_DEFERRED_PIPELINE_COUNT)
+#define VKR_VULKAN_PIPELINE_BUILD_COUNT                                        \
+  (VKR_VULKAN_PACKET_PIPELINE_COUNT + VKR_VULKAN_IBL_PIPELINE_COUNT +          \
+   VKR_VULKAN_DEFERRED_PIPELINE_COUNT)
+
+/** Fixed-function state of a packet graphics pipeline, keyed verbatim. */
+typedef struct VkrVulkanPacketPipelineState {
+  uint32_t color_format;
+  uint32_t depth_format;
+  uint32_t depth_test;
+  uint32_t depth_write;
+  uint32_t blend;
+  uint32_t depth_bias;
+} VkrVulkanPacketPipelineState;
+
+typedef struct VkrVulkanPacketPipelineSpec {
+  const char *name;
+  VkrVulkanPacketShader vertex_shader;
+  /** VKR_VULKAN_PACKET_SHADER_COUNT builds a depth-only pipeline with no
+   * fragment stage, which is what a shadow cascade rendering opaque geometry
+   * should use. */
+  VkrVulkanPacketShader fragment_shader;
+  VkrVulkanPacketPipelineState state;
+} VkrVulkanPacketPipelineSpec;
+
+typedef struct VkrVulkanShaderSource {
+  const char *path;
+  const char *entry;
+  VkShaderModule *module;
+  uint64_t code_key;
+  uint32_t push_constant_size;
+} VkrVulkanShaderSource;
+
+typedef struct VkrVulkanPipelineBuild {
+  VkrPipelineDesc desc;
+  uint64_t name_id;
+  uint64_t key;
+  VkPipeline *pipeline;
+  /** Set for graphics pipelines. */
+  const VkrVulkanPacketPipelineSpec *graphics;
+  /** Set for compute pipelines. */
+  VkShaderModule compute_module;
+  uint64_t compile_ns;
+  VkResult result;
+  /** The manifest says the persisted cache holds this key. */
+  bool8_t warm;
+} VkrVulkanPipelineBuild;
+
+typedef struct VkrVulkanPipelineJob {
+  VkrVulkanRenderer *renderer;
+  VkrVulkanPipelineBuild *build;
+  /** One cache per job system worker, indexed by worker. */
+  const VkPipelineCache *worker_caches;
+} VkrVulkanPipelineJob;
+
+vkr_global const char
+    *const s_vk_packet_shader_paths[VKR_VULKAN_PACKET_SHADER_COUNT] = {
+        VKR_VULKAN_PACKET_WORLD_VERT_SPV,
+        VKR_VULKAN_PACKET_WORLD_FRAG_SPV,
+        VKR_VULKAN_PACKET_PICKING_FRAG_SPV,
+        VKR_VULKAN_PACKET_FULLSCREEN_VERT_SPV,
+        VKR_VULKAN_PACKET_FULLSCREEN_FRAG_SPV,
+        VKR_VULKAN_PACKET_TEXT_VERT_SPV,
+        VKR_VULKAN_PACKET_TEXT_FRAG_SPV,
+        VKR_VULKAN_PACKET_TEXT_PICKING_FRAG_SPV,
+        VKR_VULKAN_PACKET_VISIBILITY_VERT_SPV,
+        VKR_VULKAN_PACKET_VISIBILITY_FRAG_SPV,
+        VKR_VULKAN_PACKET_VISIBILITY_OPAQUE_FRAG_SPV,
+        VKR_VULKAN_PACKET_VISIBILITY_SHADOW_FRAG_SPV,
+};
+vkr_global const char
+    *const s_vk_packet_shader_entries[VKR_VULKAN_PACKET_SHADER_COUNT] = {
+        "world_vertex",
+        "world_fragment",
+        "picking_fragment",
+        "fullscreen_vertex",
+        "fullscreen_fragment",
+        "text_vertex",
+        "text_fragment",
+        "text_picking_fragment",
+        "vk_visibility_vertex",
+        "vk_visibility_fragment",
+        "vk_visibility_opaque_fragment",
+        "vk_visibility_shadow_fragment",
+};
+vkr_global const char
+    *const s_vk_ibl_shader_paths[VKR_VULKAN_IBL_PIPELINE_COUNT] = {
+        VKR_VULKAN_PACKET_IBL_EQUIRECT_COMP_SPV,
+        VKR_VULKAN_PACKET_IBL_IRRADIANCE_COMP_SPV,
+        VKR_VULKAN_PACKET_IBL_PREFILTER_COMP_SPV,
+};
+vkr_global const char
+    *const s_vk_ibl_shader_entries[VKR_VULKAN_IBL_PIPELINE_COUNT] = {
+        "ibl_equirect",
+        "ibl_irradiance",
+        "ibl_prefilter",
+};
+vkr_global const char
+    *const s_vk_deferred_shader_paths[VKR_VULKAN_DEFERRED_PIPELINE_COUNT] = {
+        VKR_VULKAN_PACKET_GPU_DRAW_CLASSIFY_COMP_SPV,
+        VKR_VULKAN_PACKET_GPU_DRAW_PREFIX_COMP_SPV,
+        VKR_VULKAN_PACKET_GPU_DRAW_ENCODE_COMP_SPV,
+        VKR_VULKAN_PACKET_GBUFFER_RESOLVE_COMP_SPV,
+        VKR_VULKAN_PACKET_DEFERRED_LIGHTING_COMP_SPV,
+        VKR_VULKAN_PACKET_HZB_BUILD_COMP_SPV,
+        VKR_VULKAN_PACKET_PICKING_RESOLVE_COMP_SPV,
+        VKR_VULKAN_PACKET_TRANSMISSION_SHADE_COMP_SPV,
+        VKR_VULKAN_PACKET_TRANSMISSION_COVERAGE_COMP_SPV,
+};
+vkr_global const char
+    *const s_vk_deferred_shader_entries[VKR_VULKAN_DEFERRED_PIPELINE_COUNT] = {
+        "vk_gpu_draw_classify",     "vk_gpu_draw_prefix",
+        "vk_gpu_draw_encode",       "vk_gbuffer_resolve",
+        "vk_deferred_lighting",     "vk_hzb_build",
+        "vk_picking_resolve",       "vk_transmission_shade",
+        "vk_transmission_coverage",
+};
+
+vkr_global const VkrVulkanPacketPipelineSpec
+    s_vk_packet_pipelines[VKR_VULKAN_PACKET_PIPELINE_COUNT] = {
+        [VKR_VULKAN_PACKET_PIPELINE_PICKING] =
+            {"picking",
+             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_PICKING_FRAGMENT,
+             {VK_FORMAT_R32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_WORLD_BLEND] =
+            {"world_blend",
+             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT,
+             {VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true_v,
+              false_v, true_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_FULLSCREEN_FINAL] =
+            {"fullscreen_final",
+             VKR_VULKAN_PACKET_SHADER_FULLSCREEN_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_FULLSCREEN_FRAGMENT,
+             {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_UNDEFINED, false_v, false_v,
+              false_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_UI] =
+            {"ui",
+             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT,
+             {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_UNDEFINED, false_v, false_v,
+              true_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_WORLD_TEXT] =
+            {"world_text",
+             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_TEXT_FRAGMENT,
+             {VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true_v,
+              false_v, true_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_PICKING_TEXT] =
+            {"picking_text",
+             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_TEXT_PICKING_FRAGMENT,
+             {VK_FORMAT_R32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_UI_TEXT] =
+            {"ui_text",
+             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_TEXT_FRAGMENT,
+             {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_UNDEFINED, false_v, false_v,
+              true_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_VISIBILITY] =
+            {"visibility",
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_FRAGMENT,
+             {VK_FORMAT_R32G32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_OPAQUE] =
+            {"visibility_opaque",
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_OPAQUE_FRAGMENT,
+             {VK_FORMAT_R32G32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, false_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_SHADOW] =
+            {"visibility_shadow",
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_SHADOW_FRAGMENT,
+             {VK_FORMAT_UNDEFINED, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, true_v}},
+        [VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_SHADOW_OPAQUE] =
+            {"visibility_shadow_opaque",
+             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
+             VKR_VULKAN_PACKET_SHADER_COUNT,
+             {VK_FORMAT_UNDEFINED, VK_FORMAT_D32_SFLOAT, true_v, true_v,
+              false_v, true_v}},
+};
+
+/** Reads a whole file of at most `max_size` bytes; false when absent. */
+vkr_internal bool8_t vkr_vk_read_file(VkrVulkanRenderer *renderer,
+                                      const char *path, uint64_t max_size,
+                                      void **out_data, size_t *out_size) {
+  *out_data = NULL;
+  *out_size = 0u;
+  FILE *file = fopen(path, "rb");
+  if (!file)
+    return false_v;
+  void *data = NULL;
+  size_t size = 0u;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    const long end = ftell(file);
+    if (end > 0 && (uint64_t)end <= max_size &&
+        fseek(file, 0, SEEK_SET) == 0) {
+      size = (size_t)end;
+      data = vkr_allocator_alloc(renderer->allocator, size,
+                                 VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+      if (data && fread(data, 1u, size, file) != size) {
+        vkr_allocator_free(renderer->allocator, data, size,
+                           VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+        data = NULL;
+      }
+    }
+  }
+  fclose(file);
+  if (!data)
+    return false_v;
+  *out_data = data;
+  *out_size = size;
+  return true_v;
+}
+
+/** Replaces `path` through a temporary file so a torn write never lands. */
+vkr_internal bool8_t vkr_vk_write_file(const char *path, const void *data,
+                                       size_t size) {
+  char temporary[VKR_VULKAN_PIPELINE_PATH_MAX];
+  const int written = snprintf(temporary, sizeof(temporary), "%s.tmp", path);
+  FILE *file = written > 0 && (size_t)written < sizeof(temporary)
+                   ? fopen(temporary, "wb")
+                   : NULL;
+  if (!file)
+    return false_v;
+  const bool8_t wrote = fwrite(data, 1u, size, file) == size;
+  const bool8_t closed = fclose(file) == 0;
+  const FilePath temporary_path = {
+      .path = string8_create_from_cstr((const uint8_t *)temporary,
+                                       string_length(temporary)),
+      .type = FILE_PATH_TYPE_ABSOLUTE,
+  };
+  const FilePath target_path = {
+      .path = string8_create_from_cstr((const uint8_t *)path,
+                                       string_length(path)),
+      .type = FILE_PATH_TYPE_ABSOLUTE,
+  };
+  if (wrote && closed &&
+      file_rename(&temporary_path, &target_path, true_v) == FILE_ERROR_NONE)
+    return true_v;
+  (void)file_remove(&temporary_path);
+  return false_v;
+}
+
+/** Identity of everything a driver pipeline cache blob is only valid for. */
+vkr_internal uint64_t
+vkr_vk_pipeline_device_key(const VkrVulkanRenderer *renderer) {
+  const VkPhysicalDeviceProperties *properties =
+      &vkr_vulkan_device_properties(renderer->device)->properties;
+  uint64_t key =
+      vkr_pipeline_key_u32(VKR_PIPELINE_KEY_SEED, properties->vendorID);
+  key = vkr_pipeline_key_u32(key, properties->deviceID);
+  key = vkr_pipeline_key_u32(key, properties->driverVersion);
+  return vkr_pipeline_key_bytes(key, properties->pipelineCacheUUID,
+                                VK_UUID_SIZE);
+}
+
 vkr_internal bool8_t
-vkr_vk_create_packet_pipelines(VkrVulkanRenderer *renderer);
-vkr_internal bool8_t vkr_vk_create_ibl_pipelines(VkrVulkanRenderer *renderer);
-vkr_internal bool8_t
-vkr_vk_create_deferred_pipelines(VkrVulkanRenderer *renderer);
+vkr_vk_pipeline_manifest_path(const VkrVulkanRenderer *renderer,
+                              char *out_path, size_t capacity) {
+  const int written = snprintf(out_path, capacity, "%s.manifest",
+                               renderer->pipeline_cache_path);
+  return written > 0 && (size_t)written < capacity;
+}
+
+vkr_internal void vkr_vk_pipeline_manifest_load(VkrVulkanRenderer *renderer) {
+  char path[VKR_VULKAN_PIPELINE_PATH_MAX];
+  void *data = NULL;
+  size_t size = 0u;
+  if (!vkr_vk_pipeline_manifest_path(renderer, path, sizeof(path)) ||
+      !vkr_vk_read_file(renderer, path, VKR_VULKAN_PIPELINE_MANIFEST_MAX_BYTES,
+                        &data, &size))
+    return;
+  if (!vkr_pipeline_manifest_parse(data, size, &renderer->pipeline_manifest))
+    log_warn("Ignoring invalid pipeline manifest %s", path);
+  vkr_allocator_free(renderer->allocator, data, size,
+                     VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+}
+
+vkr_internal void vkr_vk_pipeline_manifest_save(VkrVulkanRenderer *renderer) {
+  char path[VKR_VULKAN_PIPELINE_PATH_MAX];
+  const VkrPipelineManifest *manifest = &renderer->pipeline_manifest;
+  const uint64_t size = vkr_pipeline_manifest_size(manifest);
+  void *data = vkr_allocator_alloc(renderer->allocator, size,
+                                   VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  if (data && vkr_vk_pipeline_manifest_path(renderer, path, sizeof(path)) &&
+      vkr_pipeline_manifest_serialize(manifest, data, size) == size &&
+      vkr_vk_write_file(path, data, (size_t)size)) {
+    log_info("Saved pipeline manifest: %u pipelines -> %s",
+             manifest->entry_count, path);
+  }
+  if (data) {
+    vkr_allocator_free(renderer->allocator, data, size,
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+}
 
 bool8_t vkr_vk_pipeline_cache_initialize(VkrVulkanRenderer *renderer) {
   const char *path = getenv("VKR_PIPELINE_CACHE_PATH");
@@ -18,31 +324,23 @@ bool8_t vkr_vk_pipeline_cache_initialize(VkrVulkanRenderer *renderer) {
     MemCopy(renderer->pipeline_cache_path, path, path_length + 1u);
     log_info("Pipeline cache path: %s", renderer->pipeline_cache_path);
   }
+  renderer->pipeline_device_key = vkr_vk_pipeline_device_key(renderer);
+  vkr_pipeline_manifest_reset(&renderer->pipeline_manifest, 0u);
   void *initial_data = NULL;
   size_t initial_size = 0u;
   if (path_length) {
-    FILE *file = fopen(renderer->pipeline_cache_path, "rb");
-    if (file) {
-      if (fseek(file, 0, SEEK_END) == 0) {
-        const long end = ftell(file);
-        if (end > 0 && (uint64_t)end <= MB(64) &&
-            fseek(file, 0, SEEK_SET) == 0) {
-          initial_size = (size_t)end;
-          initial_data = vkr_allocator_alloc(renderer->allocator, initial_size,
-                                             VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
-          if (!initial_data ||
-              fread(initial_data, 1u, initial_size, file) != initial_size) {
-            if (initial_data) {
-              vkr_allocator_free(renderer->allocator, initial_data,
-                                 initial_size,
-                                 VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
-            }
-            initial_data = NULL;
-            initial_size = 0u;
-          }
-        }
-      }
-      fclose(file);
+    vkr_vk_pipeline_manifest_load(renderer);
+    const uint64_t manifest_device = renderer->pipeline_manifest.device_key;
+    if (manifest_device && manifest_device != renderer->pipeline_device_key) {
+      // The blob was written for another device or driver as well, so every
+      // pipeline would miss it; do not hand it to the driver at all.
+      log_info("Pipeline cache belongs to another device or driver; "
+               "starting empty");
+      vkr_pipeline_manifest_reset(&renderer->pipeline_manifest, 0u);
+    } else {
+      (void)vkr_vk_read_file(renderer, renderer->pipeline_cache_path,
+                             VKR_VULKAN_PIPELINE_CACHE_MAX_BYTES,
+                             &initial_data, &initial_size);
     }
   }
   VkPipelineCacheCreateInfo info = {
@@ -60,13 +358,16 @@ bool8_t vkr_vk_pipeline_cache_initialize(VkrVulkanRenderer *renderer) {
   if (result != VK_SUCCESS && initial_size) {
     info.initialDataSize = 0u;
     info.pInitialData = NULL;
+    initial_size = 0u;
+    vkr_pipeline_manifest_reset(&renderer->pipeline_manifest, 0u);
     result = vkCreatePipelineCache(vkr_vulkan_device_handle(renderer->device),
                                    &info, NULL, &renderer->pipeline_cache);
   }
   if (result != VK_SUCCESS)
     return false_v;
   if (initial_size)
-    log_info("Loaded pipeline cache data: %zu bytes", initial_size);
+    log_info("Loaded pipeline cache data: %zu bytes, %u known pipelines",
+             initial_size, renderer->pipeline_manifest.entry_count);
   log_info("Initialized Vulkan pipeline cache with %s data",
            initial_size ? "persisted" : "empty");
   return true_v;
@@ -76,7 +377,9 @@ void vkr_vk_pipeline_cache_shutdown(VkrVulkanRenderer *renderer) {
   if (!renderer->pipeline_cache)
     return;
   VkDevice device = vkr_vulkan_device_handle(renderer->device);
-  if (renderer->pipeline_cache_path[0]) {
+  if (renderer->pipeline_cache_path[0] && !renderer->pipeline_cache_dirty) {
+    log_info("Pipeline cache unchanged since load; not saving");
+  } else if (renderer->pipeline_cache_path[0]) {
     size_t size = 0u;
     if (vkGetPipelineCacheData(device, renderer->pipeline_cache, &size, NULL) ==
             VK_SUCCESS &&
@@ -84,36 +387,15 @@ void vkr_vk_pipeline_cache_shutdown(VkrVulkanRenderer *renderer) {
       const size_t allocation_size = size;
       void *data = vkr_allocator_alloc(renderer->allocator, allocation_size,
                                        VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
-      if (data && vkGetPipelineCacheData(device, renderer->pipeline_cache,
-                                         &size, data) == VK_SUCCESS) {
-        char temporary[sizeof(renderer->pipeline_cache_path) + 5u];
-        const int written = snprintf(temporary, sizeof(temporary), "%s.tmp",
-                                     renderer->pipeline_cache_path);
-        FILE *file = written > 0 && (size_t)written < sizeof(temporary)
-                         ? fopen(temporary, "wb")
-                         : NULL;
-        const bool8_t wrote = file && fwrite(data, 1u, size, file) == size;
-        const bool8_t closed = file && fclose(file) == 0;
-        if (wrote && closed) {
-          const FilePath temporary_path = {
-              .path = string8_create_from_cstr((const uint8_t *)temporary,
-                                               string_length(temporary)),
-              .type = FILE_PATH_TYPE_ABSOLUTE,
-          };
-          const FilePath cache_path = {
-              .path = string8_create_from_cstr(
-                  (const uint8_t *)renderer->pipeline_cache_path,
-                  string_length(renderer->pipeline_cache_path)),
-              .type = FILE_PATH_TYPE_ABSOLUTE,
-          };
-          if (file_rename(&temporary_path, &cache_path, true_v) ==
-              FILE_ERROR_NONE) {
-            log_info("Saved pipeline cache data: %zu bytes -> %s", size,
-                     renderer->pipeline_cache_path);
-          } else {
-            (void)file_remove(&temporary_path);
-          }
-        }
+      // The manifest only follows a blob that landed, so it never promises
+      // pipelines the cache on disk does not hold.
+      if (data &&
+          vkGetPipelineCacheData(device, renderer->pipeline_cache, &size,
+                                 data) == VK_SUCCESS &&
+          vkr_vk_write_file(renderer->pipeline_cache_path, data, size)) {
+        log_info("Saved pipeline cache data: %zu bytes -> %s", size,
+                 renderer->pipeline_cache_path);
+        vkr_vk_pipeline_manifest_save(renderer);
       }
       if (data) {
         vkr_allocator_free(renderer->allocator, data, allocation_size,
@@ -181,34 +463,17 @@ vkr_internal bool8_t vkr_vk_validate_reflected_gpu_abi(
   }
   return valid;
 }
-
+/** Checks the packet root ABI declared by the world fragment shader. */
 vkr_internal bool8_t
-vkr_vk_validate_packet_root_abi(VkrVulkanRenderer *renderer) {
-  FilePath shader_path =
-      file_path_create(VKR_VULKAN_PACKET_WORLD_FRAG_SPV, renderer->allocator,
-                       FILE_PATH_TYPE_ABSOLUTE);
-  uint8_t *bytes = NULL;
-  uint64_t size = 0u;
-  if (file_load_spirv_shader(&shader_path, renderer->allocator, &bytes,
-                             &size) != FILE_ERROR_NONE ||
-      size == 0u)
-    return false_v;
-  SpvReflectShaderModule module;
-  MemZero(&module, sizeof(module));
-  const SpvReflectResult created =
-      spvReflectCreateShaderModule((size_t)size, bytes, &module);
-  vkr_allocator_free(renderer->allocator, bytes, size,
-                     VKR_ALLOCATOR_MEMORY_TAG_FILE);
-  if (created != SPV_REFLECT_RESULT_SUCCESS)
-    return false_v;
+vkr_vk_validate_packet_root_abi(SpvReflectShaderModule *module) {
   uint32_t count = 0u;
   SpvReflectBlockVariable *blocks[1] = {0};
   bool8_t valid = spvReflectEnumerateEntryPointPushConstantBlocks(
-                      &module, "world_fragment", &count, NULL) ==
+                      module, "world_fragment", &count, NULL) ==
                       SPV_REFLECT_RESULT_SUCCESS &&
                   count == 1u &&
                   spvReflectEnumerateEntryPointPushConstantBlocks(
-                      &module, "world_fragment", &count, blocks) ==
+                      module, "world_fragment", &count, blocks) ==
                       SPV_REFLECT_RESULT_SUCCESS;
   valid &= blocks[0] && blocks[0]->size == sizeof(VkrVulkanPushConstants);
   SpvReflectBlockVariable *root =
@@ -310,116 +575,208 @@ vkr_vk_validate_packet_root_abi(VkrVulkanRenderer *renderer) {
         materials, "material_attenuation_color",
         offsetof(VkrVulkanMaterialGpuRow, material_attenuation_color), NULL);
   }
-  spvReflectDestroyShaderModule(&module);
   return valid;
 }
 
-vkr_internal bool8_t vkr_vk_create_shader_module(VkrVulkanRenderer *renderer,
-                                                 const char *path,
-                                                 VkShaderModule *out_module) {
-  FilePath shader_path =
-      file_path_create(path, renderer->allocator, FILE_PATH_TYPE_ABSOLUTE);
+/**
+ * Loads one SPIR-V module, keys its bytes and reflects the push-constant block
+ * its entry point declares. The world fragment module also carries the packet
+ * root ABI, which is validated from the same reflection.
+ */
+vkr_internal bool8_t vkr_vk_load_shader(VkrVulkanRenderer *renderer,
+                                        VkrVulkanShaderSource *source,
+                                        bool8_t validate_root_abi) {
+  FilePath shader_path = file_path_create(source->path, renderer->allocator,
+                                          FILE_PATH_TYPE_ABSOLUTE);
   uint8_t *bytes = NULL;
-  uint64_t size = 0;
+  uint64_t size = 0u;
   if (file_load_spirv_shader(&shader_path, renderer->allocator, &bytes,
                              &size) != FILE_ERROR_NONE ||
-      size == 0 || (size % sizeof(uint32_t)) != 0) {
+      size == 0u || (size % sizeof(uint32_t)) != 0u) {
+    if (bytes) {
+      vkr_allocator_free(renderer->allocator, bytes, size,
+                         VKR_ALLOCATOR_MEMORY_TAG_FILE);
+    }
+    log_error("Vulkan failed to load shader %s", source->path);
     return false_v;
   }
-  VkShaderModuleCreateInfo module_info = {
-      .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-      .codeSize = (size_t)size,
-      .pCode = (const uint32_t *)bytes,
-  };
-  const VkResult result = vkCreateShaderModule(vkr_vk_renderer_device(renderer),
-                                               &module_info, NULL, out_module);
+  source->code_key = vkr_pipeline_code_key(bytes, size);
+
+  SpvReflectShaderModule reflection;
+  MemZero(&reflection, sizeof(reflection));
+  bool8_t valid = spvReflectCreateShaderModule((size_t)size, bytes,
+                                               &reflection) ==
+                  SPV_REFLECT_RESULT_SUCCESS;
+  if (valid) {
+    uint32_t count = 0u;
+    SpvReflectBlockVariable *blocks[1] = {0};
+    if (spvReflectEnumerateEntryPointPushConstantBlocks(
+            &reflection, source->entry, &count, NULL) ==
+            SPV_REFLECT_RESULT_SUCCESS &&
+        count == 1u &&
+        spvReflectEnumerateEntryPointPushConstantBlocks(
+            &reflection, source->entry, &count, blocks) ==
+            SPV_REFLECT_RESULT_SUCCESS &&
+        blocks[0]) {
+      source->push_constant_size = blocks[0]->size;
+    }
+    if (validate_root_abi && !vkr_vk_validate_packet_root_abi(&reflection)) {
+      log_error("Vulkan packet root ABI does not match %s", source->path);
+      valid = false_v;
+    }
+    spvReflectDestroyShaderModule(&reflection);
+  }
+  if (valid) {
+    VkShaderModuleCreateInfo module_info = {
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = (size_t)size,
+        .pCode = (const uint32_t *)bytes,
+    };
+    valid = vkCreateShaderModule(vkr_vk_renderer_device(renderer),
+                                 &module_info, NULL,
+                                 source->module) == VK_SUCCESS;
+  }
   vkr_allocator_free(renderer->allocator, bytes, size,
                      VKR_ALLOCATOR_MEMORY_TAG_FILE);
-  return result == VK_SUCCESS;
+  return valid;
 }
 
-bool8_t vkr_vk_create_pipelines(VkrVulkanRenderer *renderer) {
-  if (!vkr_vk_validate_packet_root_abi(renderer)) {
-    return false_v;
+vkr_internal bool8_t vkr_vk_load_shaders(VkrVulkanRenderer *renderer,
+                                         VkrVulkanShaderSource *sources) {
+  uint32_t count = 0u;
+  for (uint32_t i = 0u; i < VKR_VULKAN_PACKET_SHADER_COUNT; ++i) {
+    sources[count++] = (VkrVulkanShaderSource){
+        .path = s_vk_packet_shader_paths[i],
+        .entry = s_vk_packet_shader_entries[i],
+        .module = &renderer->packet_shaders[i],
+    };
   }
-  const VkrVulkanDescriptorLayout *resource_layout =
-      vkr_vulkan_device_resource_layout(renderer->device);
-  const VkrVulkanDescriptorLayout *sampler_layout =
-      vkr_vulkan_device_sampler_layout(renderer->device);
-  VkDescriptorSetLayout layouts[] = {
-      resource_layout->handle,
-      sampler_layout->handle,
+  for (uint32_t i = 0u; i < VKR_VULKAN_IBL_PIPELINE_COUNT; ++i) {
+    sources[count++] = (VkrVulkanShaderSource){
+        .path = s_vk_ibl_shader_paths[i],
+        .entry = s_vk_ibl_shader_entries[i],
+        .module = &renderer->ibl_shaders[i],
+    };
+  }
+  for (uint32_t i = 0u; i < VKR_VULKAN_DEFERRED_PIPELINE_COUNT; ++i) {
+    sources[count++] = (VkrVulkanShaderSource){
+        .path = s_vk_deferred_shader_paths[i],
+        .entry = s_vk_deferred_shader_entries[i],
+        .module = &renderer->deferred_shaders[i],
+    };
+  }
+  for (uint32_t i = 0u; i < count; ++i) {
+    if (!vkr_vk_load_shader(renderer, &sources[i],
+                            i == VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT))
+      return false_v;
+  }
+  return true_v;
+}
+
+vkr_internal void vkr_vk_describe_stage(VkrPipelineDesc *desc,
+                                        const VkrVulkanShaderSource *source) {
+  desc->stages[desc->stage_count++] = (VkrPipelineStageDesc){
+      .code_key = source->code_key,
+      .entry = source->entry,
+      .push_constant_size = source->push_constant_size,
   };
-  VkPushConstantRange push_range = {
-      .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT |
-                    VK_SHADER_STAGE_COMPUTE_BIT,
-      .offset = 0u,
-      .size = sizeof(VkrVulkanPushConstants),
+}
+
+vkr_internal VkrVulkanPipelineBuild
+vkr_vk_describe_compute(VkPipeline *pipeline,
+                        const VkrVulkanShaderSource *source,
+                        VkrPipelineLayoutDesc layout) {
+  VkrVulkanPipelineBuild build = {
+      .desc = {.name = source->entry,
+               .kind = VKR_PIPELINE_KIND_COMPUTE,
+               .layout = layout},
+      .pipeline = pipeline,
+      .compute_module = *source->module,
   };
-  VkPipelineLayoutCreateInfo layout_info = {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-      .setLayoutCount = ArrayCount(layouts),
-      .pSetLayouts = layouts,
-      .pushConstantRangeCount = 1u,
-      .pPushConstantRanges = &push_range,
+  vkr_vk_describe_stage(&build.desc, source);
+  return build;
+}
+
+/** Describes and keys every pipeline, marking those the manifest knows. */
+vkr_internal uint32_t
+vkr_vk_describe_pipelines(VkrVulkanRenderer *renderer,
+                          const VkrVulkanShaderSource *sources,
+                          VkrVulkanPipelineBuild *builds) {
+  const VkrPipelineLayoutDesc layout = {
+      .set_layout_count = 2u,
+      .push_constant_size = sizeof(VkrVulkanPushConstants),
+      .push_constant_stages = VKR_VULKAN_PIPELINE_PUSH_STAGES,
   };
-  VkDevice device = vkr_vk_renderer_device(renderer);
-  if (vkCreatePipelineLayout(device, &layout_info, NULL,
-                             &renderer->pipeline_layout) != VK_SUCCESS) {
-    return false_v;
+  uint32_t count = 0u;
+  for (uint32_t i = 0u; i < VKR_VULKAN_PACKET_PIPELINE_COUNT; ++i) {
+    const VkrVulkanPacketPipelineSpec *spec = &s_vk_packet_pipelines[i];
+    VkrVulkanPipelineBuild *build = &builds[count++];
+    *build = (VkrVulkanPipelineBuild){
+        .desc = {.name = spec->name,
+                 .kind = VKR_PIPELINE_KIND_GRAPHICS,
+                 .layout = layout,
+                 .state = &spec->state,
+                 .state_size = sizeof(spec->state)},
+        .pipeline = &renderer->packet_pipelines[i],
+        .graphics = spec,
+    };
+    vkr_vk_describe_stage(&build->desc, &sources[spec->vertex_shader]);
+    if (spec->fragment_shader != VKR_VULKAN_PACKET_SHADER_COUNT)
+      vkr_vk_describe_stage(&build->desc, &sources[spec->fragment_shader]);
   }
-  return vkr_vk_create_packet_pipelines(renderer) &&
-         vkr_vk_create_ibl_pipelines(renderer) &&
-         vkr_vk_create_deferred_pipelines(renderer);
+  const VkrVulkanShaderSource *ibl_sources =
+      sources + VKR_VULKAN_PACKET_SHADER_COUNT;
+  for (uint32_t i = 0u; i < VKR_VULKAN_IBL_PIPELINE_COUNT; ++i) {
+    builds[count++] = vkr_vk_describe_compute(&renderer->ibl_pipelines[i],
+                                              &ibl_sources[i], layout);
+  }
+  const VkrVulkanShaderSource *deferred_sources =
+      ibl_sources + VKR_VULKAN_IBL_PIPELINE_COUNT;
+  for (uint32_t i = 0u; i < VKR_VULKAN_DEFERRED_PIPELINE_COUNT; ++i) {
+    builds[count++] = vkr_vk_describe_compute(
+        &renderer->deferred_pipelines[i], &deferred_sources[i], layout);
+  }
+
+  for (uint32_t i = 0u; i < count; ++i) {
+    VkrVulkanPipelineBuild *build = &builds[i];
+    build->name_id = vkr_pipeline_name_id(build->desc.name);
+    build->key = vkr_pipeline_desc_key(&build->desc);
+    build->warm = vkr_pipeline_manifest_is_warm(
+        &renderer->pipeline_manifest, renderer->pipeline_device_key,
+        build->name_id, build->key);
+  }
+  return count;
 }
 
-vkr_internal bool8_t vkr_vk_create_packet_pipeline(
-    VkrVulkanRenderer *renderer, VkrVulkanPacketPipeline pipeline,
-    VkrVulkanPacketShader vertex_shader, VkrVulkanPacketShader fragment_shader,
-    VkFormat color_format, VkFormat depth_format, bool8_t depth_test,
-    bool8_t depth_write, bool8_t blend_enabled, bool8_t depth_bias) {
-  // A fragment shader of VKR_VULKAN_PACKET_SHADER_COUNT builds a
-  // depth-only pipeline with no fragment stage, which is what a shadow cascade
-  // rendering opaque geometry should use.
-  const bool8_t depth_only = fragment_shader == VKR_VULKAN_PACKET_SHADER_COUNT;
+vkr_internal VkResult vkr_vk_create_graphics_pipeline(
+    VkrVulkanRenderer *renderer, const VkrVulkanPipelineBuild *build,
+    VkPipelineCache cache, VkPipelineCreateFlags flags) {
+  const VkrVulkanPacketPipelineSpec *spec = build->graphics;
+  const VkrVulkanPacketPipelineState *state = &spec->state;
+  const bool8_t depth_only =
+      spec->fragment_shader == VKR_VULKAN_PACKET_SHADER_COUNT;
+  const VkFormat color_format = (VkFormat)state->color_format;
+  const VkFormat depth_format = (VkFormat)state->depth_format;
+  const VkBool32 depth_test = state->depth_test;
+  const VkBool32 depth_write = state->depth_write;
+  const VkBool32 blend_enabled = state->blend;
+  const VkBool32 depth_bias = state->depth_bias;
   const VkPipelineShaderStageCreateInfo stages[] = {
       {
           .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
           .stage = VK_SHADER_STAGE_VERTEX_BIT,
-          .module = renderer->packet_shaders[vertex_shader],
-          .pName = vertex_shader == VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX
-                       ? "world_vertex"
-                   : vertex_shader == VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX
-                       ? "text_vertex"
-                   : vertex_shader == VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX
-                       ? "vk_visibility_vertex"
-                       : "fullscreen_vertex",
+          .module = renderer->packet_shaders[spec->vertex_shader],
+          .pName = s_vk_packet_shader_entries[spec->vertex_shader],
       },
       {
           .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
           .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-          .module = depth_only ? VK_NULL_HANDLE
-                               : renderer->packet_shaders[fragment_shader],
-          .pName =
-              depth_only ? ""
-              : fragment_shader == VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT
-                  ? "world_fragment"
-              : fragment_shader == VKR_VULKAN_PACKET_SHADER_PICKING_FRAGMENT
-                  ? "picking_fragment"
-              : fragment_shader == VKR_VULKAN_PACKET_SHADER_TEXT_FRAGMENT
-                  ? "text_fragment"
-              : fragment_shader ==
-                      VKR_VULKAN_PACKET_SHADER_TEXT_PICKING_FRAGMENT
-                  ? "text_picking_fragment"
-              : fragment_shader == VKR_VULKAN_PACKET_SHADER_VISIBILITY_FRAGMENT
-                  ? "vk_visibility_fragment"
-              : fragment_shader ==
-                      VKR_VULKAN_PACKET_SHADER_VISIBILITY_OPAQUE_FRAGMENT
-                  ? "vk_visibility_opaque_fragment"
-              : fragment_shader ==
-                      VKR_VULKAN_PACKET_SHADER_VISIBILITY_SHADOW_FRAGMENT
-                  ? "vk_visibility_shadow_fragment"
-                  : "fullscreen_fragment",
+          .module = depth_only
+                        ? VK_NULL_HANDLE
+                        : renderer->packet_shaders[spec->fragment_shader],
+          .pName = depth_only
+                       ? ""
+                       : s_vk_packet_shader_entries[spec->fragment_shader],
       },
   };
   const VkPipelineVertexInputStateCreateInfo vertex_input = {
@@ -490,7 +847,7 @@ vkr_internal bool8_t vkr_vk_create_packet_pipeline(
   const VkGraphicsPipelineCreateInfo create_info = {
       .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
       .pNext = &rendering,
-      .flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
+      .flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT | flags,
       .stageCount = depth_only ? 1u : (uint32_t)ArrayCount(stages),
       .pStages = stages,
       .pVertexInputState = &vertex_input,
@@ -504,173 +861,247 @@ vkr_internal bool8_t vkr_vk_create_packet_pipeline(
       .pDynamicState = &dynamic,
       .layout = renderer->pipeline_layout,
   };
-  return vkCreateGraphicsPipelines(
-             vkr_vk_renderer_device(renderer), renderer->pipeline_cache, 1u,
-             &create_info, NULL,
-             &renderer->packet_pipelines[pipeline]) == VK_SUCCESS;
+  return vkCreateGraphicsPipelines(vkr_vk_renderer_device(renderer), cache, 1u,
+                                   &create_info, NULL, build->pipeline);
 }
 
-vkr_internal bool8_t
-vkr_vk_create_packet_pipelines(VkrVulkanRenderer *renderer) {
-  vkr_local_persist const char *const paths[VKR_VULKAN_PACKET_SHADER_COUNT] = {
-      VKR_VULKAN_PACKET_WORLD_VERT_SPV,
-      VKR_VULKAN_PACKET_WORLD_FRAG_SPV,
-      VKR_VULKAN_PACKET_PICKING_FRAG_SPV,
-      VKR_VULKAN_PACKET_FULLSCREEN_VERT_SPV,
-      VKR_VULKAN_PACKET_FULLSCREEN_FRAG_SPV,
-      VKR_VULKAN_PACKET_TEXT_VERT_SPV,
-      VKR_VULKAN_PACKET_TEXT_FRAG_SPV,
-      VKR_VULKAN_PACKET_TEXT_PICKING_FRAG_SPV,
-      VKR_VULKAN_PACKET_VISIBILITY_VERT_SPV,
-      VKR_VULKAN_PACKET_VISIBILITY_FRAG_SPV,
-      VKR_VULKAN_PACKET_VISIBILITY_OPAQUE_FRAG_SPV,
-      VKR_VULKAN_PACKET_VISIBILITY_SHADOW_FRAG_SPV,
+vkr_internal VkResult vkr_vk_create_compute_pipeline(
+    VkrVulkanRenderer *renderer, const VkrVulkanPipelineBuild *build,
+    VkPipelineCache cache, VkPipelineCreateFlags flags) {
+  const VkComputePipelineCreateInfo info = {
+      .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT | flags,
+      .stage =
+          {
+              .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+              .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+              .module = build->compute_module,
+              .pName = build->desc.stages[0].entry,
+          },
+      .layout = renderer->pipeline_layout,
   };
-  for (uint32_t i = 0u; i < VKR_VULKAN_PACKET_SHADER_COUNT; ++i) {
-    if (!vkr_vk_create_shader_module(renderer, paths[i],
-                                     &renderer->packet_shaders[i]))
-      return false_v;
-  }
-  return vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_PICKING,
-             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_PICKING_FRAGMENT, VK_FORMAT_R32_UINT,
-             VK_FORMAT_D32_SFLOAT, true_v, true_v, false_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_WORLD_BLEND,
-             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT,
-             VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true_v,
-             false_v, true_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_FULLSCREEN_FINAL,
-             VKR_VULKAN_PACKET_SHADER_FULLSCREEN_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_FULLSCREEN_FRAGMENT,
-             VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_UNDEFINED, false_v, false_v,
-             false_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_UI,
-             VKR_VULKAN_PACKET_SHADER_WORLD_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_WORLD_FRAGMENT, VK_FORMAT_R8G8B8A8_UNORM,
-             VK_FORMAT_UNDEFINED, false_v, false_v, true_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_WORLD_TEXT,
-             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_TEXT_FRAGMENT,
-             VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_D32_SFLOAT, true_v,
-             false_v, true_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_PICKING_TEXT,
-             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_TEXT_PICKING_FRAGMENT, VK_FORMAT_R32_UINT,
-             VK_FORMAT_D32_SFLOAT, true_v, true_v, false_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_UI_TEXT,
-             VKR_VULKAN_PACKET_SHADER_TEXT_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_TEXT_FRAGMENT, VK_FORMAT_R8G8B8A8_UNORM,
-             VK_FORMAT_UNDEFINED, false_v, false_v, true_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_VISIBILITY,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_FRAGMENT,
-             VK_FORMAT_R32G32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
-             false_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_OPAQUE,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_OPAQUE_FRAGMENT,
-             VK_FORMAT_R32G32_UINT, VK_FORMAT_D32_SFLOAT, true_v, true_v,
-             false_v, false_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_SHADOW,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_SHADOW_FRAGMENT,
-             VK_FORMAT_UNDEFINED, VK_FORMAT_D32_SFLOAT, true_v, true_v, false_v,
-             true_v) &&
-         vkr_vk_create_packet_pipeline(
-             renderer, VKR_VULKAN_PACKET_PIPELINE_VISIBILITY_SHADOW_OPAQUE,
-             VKR_VULKAN_PACKET_SHADER_VISIBILITY_VERTEX,
-             VKR_VULKAN_PACKET_SHADER_COUNT, VK_FORMAT_UNDEFINED,
-             VK_FORMAT_D32_SFLOAT, true_v, true_v, false_v, true_v);
+  return vkCreateComputePipelines(vkr_vk_renderer_device(renderer), cache, 1u,
+                                  &info, NULL, build->pipeline);
 }
 
-vkr_internal bool8_t vkr_vk_create_ibl_pipelines(VkrVulkanRenderer *renderer) {
-  vkr_local_persist const char *const paths[VKR_VULKAN_IBL_PIPELINE_COUNT] = {
-      VKR_VULKAN_PACKET_IBL_EQUIRECT_COMP_SPV,
-      VKR_VULKAN_PACKET_IBL_IRRADIANCE_COMP_SPV,
-      VKR_VULKAN_PACKET_IBL_PREFILTER_COMP_SPV,
-  };
-  vkr_local_persist const char *const entries[VKR_VULKAN_IBL_PIPELINE_COUNT] = {
-      "ibl_equirect",
-      "ibl_irradiance",
-      "ibl_prefilter",
-  };
-  for (uint32_t i = 0u; i < VKR_VULKAN_IBL_PIPELINE_COUNT; ++i) {
-    if (!vkr_vk_create_shader_module(renderer, paths[i],
-                                     &renderer->ibl_shaders[i]))
-      return false_v;
-    const VkPipelineShaderStageCreateInfo stage = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_COMPUTE_BIT,
-        .module = renderer->ibl_shaders[i],
-        .pName = entries[i],
-    };
-    const VkComputePipelineCreateInfo info = {
-        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-        .flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
-        .stage = stage,
-        .layout = renderer->pipeline_layout,
-    };
-    if (vkCreateComputePipelines(vkr_vk_renderer_device(renderer),
-                                 renderer->pipeline_cache, 1u, &info, NULL,
-                                 &renderer->ibl_pipelines[i]) != VK_SUCCESS)
-      return false_v;
-  }
-  return true_v;
+vkr_internal void vkr_vk_compile_pipeline(VkrVulkanRenderer *renderer,
+                                          VkrVulkanPipelineBuild *build,
+                                          VkPipelineCache cache,
+                                          VkPipelineCreateFlags flags) {
+  const float64_t start = vkr_platform_get_absolute_time();
+  build->result =
+      build->graphics
+          ? vkr_vk_create_graphics_pipeline(renderer, build, cache, flags)
+          : vkr_vk_create_compute_pipeline(renderer, build, cache, flags);
+  build->compile_ns = vkr_metrics_elapsed_ns(start);
 }
 
+vkr_internal bool8_t vkr_vk_pipeline_job_run(VkrJobContext *ctx,
+                                             void *payload) {
+  VkrVulkanPipelineJob *job = payload;
+  vkr_vk_compile_pipeline(job->renderer, job->build,
+                          job->worker_caches[ctx->worker_index], 0u);
+  return job->build->result == VK_SUCCESS;
+}
+
+/**
+ * Compiles every pipeline that is not warm. With a job system each miss is a
+ * job, and each worker compiles into its own externally synchronized cache so
+ * no two compiles contend on one cache lock; those caches are merged into the
+ * renderer cache once all jobs finish.
+ */
 vkr_internal bool8_t
-vkr_vk_create_deferred_pipelines(VkrVulkanRenderer *renderer) {
-  vkr_local_persist const char
-      *const paths[VKR_VULKAN_DEFERRED_PIPELINE_COUNT] = {
-          VKR_VULKAN_PACKET_GPU_DRAW_CLASSIFY_COMP_SPV,
-          VKR_VULKAN_PACKET_GPU_DRAW_PREFIX_COMP_SPV,
-          VKR_VULKAN_PACKET_GPU_DRAW_ENCODE_COMP_SPV,
-          VKR_VULKAN_PACKET_GBUFFER_RESOLVE_COMP_SPV,
-          VKR_VULKAN_PACKET_DEFERRED_LIGHTING_COMP_SPV,
-          VKR_VULKAN_PACKET_HZB_BUILD_COMP_SPV,
-          VKR_VULKAN_PACKET_PICKING_RESOLVE_COMP_SPV,
-          VKR_VULKAN_PACKET_TRANSMISSION_SHADE_COMP_SPV,
-          VKR_VULKAN_PACKET_TRANSMISSION_COVERAGE_COMP_SPV,
-      };
-  vkr_local_persist const char
-      *const entries[VKR_VULKAN_DEFERRED_PIPELINE_COUNT] = {
-          "vk_gpu_draw_classify",     "vk_gpu_draw_prefix",
-          "vk_gpu_draw_encode",       "vk_gbuffer_resolve",
-          "vk_deferred_lighting",     "vk_hzb_build",
-          "vk_picking_resolve",       "vk_transmission_shade",
-          "vk_transmission_coverage",
-      };
-  for (uint32_t i = 0u; i < VKR_VULKAN_DEFERRED_PIPELINE_COUNT; ++i) {
-    if (!vkr_vk_create_shader_module(renderer, paths[i],
-                                     &renderer->deferred_shaders[i]))
-      return false_v;
-    const VkPipelineShaderStageCreateInfo stage = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_COMPUTE_BIT,
-        .module = renderer->deferred_shaders[i],
-        .pName = entries[i],
+vkr_vk_compile_cold_pipelines(VkrVulkanRenderer *renderer,
+                              VkrVulkanPipelineBuild *builds,
+                              uint32_t build_count, uint32_t cold_count) {
+  VkrJobSystem *job_system = renderer->config.job_system;
+  const uint32_t worker_count = job_system ? job_system->worker_count : 0u;
+  VkPipelineCache *worker_caches =
+      cold_count > 1u && worker_count
+          ? vkr_allocator_alloc(renderer->allocator,
+                                sizeof(*worker_caches) * worker_count,
+                                VKR_ALLOCATOR_MEMORY_TAG_RENDERER)
+          : NULL;
+  VkDevice device = vkr_vk_renderer_device(renderer);
+  uint32_t cache_count = 0u;
+  if (worker_caches) {
+    const VkPipelineCacheCreateInfo info = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .flags = VK_PIPELINE_CACHE_CREATE_EXTERNALLY_SYNCHRONIZED_BIT,
     };
-    const VkComputePipelineCreateInfo info = {
-        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-        .flags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT,
-        .stage = stage,
-        .layout = renderer->pipeline_layout,
+    while (cache_count < worker_count &&
+           vkCreatePipelineCache(device, &info, NULL,
+                                 &worker_caches[cache_count]) == VK_SUCCESS)
+      cache_count++;
+  }
+
+  VkrJobHandle handles[VKR_VULKAN_PIPELINE_BUILD_COUNT];
+  uint32_t submitted = 0u;
+  Bitset8 type_mask = bitset8_create();
+  bitset8_set(&type_mask, VKR_JOB_TYPE_GENERAL);
+  for (uint32_t i = 0u; i < build_count; ++i) {
+    VkrVulkanPipelineBuild *build = &builds[i];
+    if (build->warm)
+      continue;
+    const VkrVulkanPipelineJob job = {
+        .renderer = renderer,
+        .build = build,
+        .worker_caches = worker_caches,
     };
-    if (vkCreateComputePipelines(
-            vkr_vk_renderer_device(renderer), renderer->pipeline_cache, 1u,
-            &info, NULL, &renderer->deferred_pipelines[i]) != VK_SUCCESS)
-      return false_v;
+    const VkrJobDesc job_desc = {
+        .priority = VKR_JOB_PRIORITY_HIGH,
+        .type_mask = type_mask,
+        .run = vkr_vk_pipeline_job_run,
+        .payload = &job,
+        .payload_size = sizeof(job),
+    };
+    // The renderer cache is only touched by this thread while jobs run.
+    if (cache_count < worker_count || !worker_caches ||
+        !vkr_job_submit(job_system, &job_desc, &handles[submitted])) {
+      vkr_vk_compile_pipeline(renderer, build, renderer->pipeline_cache, 0u);
+      continue;
+    }
+    submitted++;
+  }
+  for (uint32_t i = 0u; i < submitted; ++i) {
+    vkr_job_wait(job_system, handles[i]);
+  }
+
+  if (cache_count &&
+      vkMergePipelineCaches(device, renderer->pipeline_cache, cache_count,
+                            worker_caches) != VK_SUCCESS) {
+    log_warn("Vulkan failed to merge worker pipeline caches; compiled "
+             "pipelines will not persist");
   }
+  for (uint32_t i = 0u; i < cache_count; ++i) {
+    vkDestroyPipelineCache(device, worker_caches[i], NULL);
+  }
+  if (worker_caches) {
+    vkr_allocator_free(renderer->allocator, worker_caches,
+                       sizeof(*worker_caches) * worker_count,
+                       VKR_ALLOCATOR_MEMORY_TAG_RENDERER);
+  }
+
+  bool8_t compiled = true_v;
+  for (uint32_t i = 0u; i < build_count; ++i) {
+    if (!builds[i].warm && builds[i].result != VK_SUCCESS) {
+      log_error("Vulkan failed to compile pipeline %s (%d)",
+                builds[i].desc.name, builds[i].result);
+      compiled = false_v;
+    }
+  }
+  return compiled;
+}
+
+/**
+ * Records the keys built this start so the next one can tell what the cache
+ * holds, and publishes the startup counters.
+ */
+vkr_internal void
+vkr_vk_record_pipeline_builds(VkrVulkanRenderer *renderer,
+                              const VkrVulkanPipelineBuild *builds,
+                              uint32_t build_count, float64_t start) {
+  const VkrPipelineManifest previous = renderer->pipeline_manifest;
+  VkrPipelineManifest *manifest = &renderer->pipeline_manifest;
+  vkr_pipeline_manifest_reset(manifest, renderer->pipeline_device_key);
+  uint32_t compiled = 0u;
+  uint64_t compile_ns = 0u;
+  uint64_t compile_max_ns = 0u;
+  for (uint32_t i = 0u; i < build_count; ++i) {
+    const VkrVulkanPipelineBuild *build = &builds[i];
+    uint64_t recorded_ns = build->compile_ns;
+    if (build->warm) {
+      const VkrPipelineManifestEntry *entry =
+          vkr_pipeline_manifest_find(&previous, build->name_id);
+      recorded_ns = entry ? entry->compile_ns : 0u;
+    } else {
+      compiled++;
+      compile_ns += build->compile_ns;
+      compile_max_ns = Max(compile_max_ns, build->compile_ns);
+      log_debug("Compiled pipeline %s in %.2f ms", build->desc.name,
+                (float64_t)build->compile_ns / 1000000.0);
+    }
+    if (!vkr_pipeline_manifest_record(manifest, build->name_id, build->key,
+                                      recorded_ns))
+      log_warn("Pipeline manifest is full; %s is not recorded",
+               build->desc.name);
+  }
+  renderer->pipeline_cache_dirty |= compiled > 0u;
+
+  const uint64_t pipelines_ns = vkr_metrics_elapsed_ns(start);
+  VkrRendererBootMetrics *boot_metrics = renderer->config.boot_metrics;
+  if (boot_metrics) {
+    boot_metrics->pipelines_ns = pipelines_ns;
+    boot_metrics->pipeline_compile_ns = compile_ns;
+    boot_metrics->pipeline_compile_max_ns = compile_max_ns;
+    boot_metrics->pipelines_compiled = compiled;
+    boot_metrics->pipelines_warm = build_count - compiled;
+  }
+  log_info("Created %u Vulkan pipelines in %.2f ms: %u from cache, %u "
+           "compiled (%.2f ms compile, slowest %.2f ms)",
+           build_count, (float64_t)pipelines_ns / 1000000.0,
+           build_count - compiled, compiled,
+           (float64_t)compile_ns / 1000000.0,
+           (float64_t)compile_max_ns / 1000000.0);
+}
+
+bool8_t vkr_vk_create_pipelines(VkrVulkanRenderer *renderer) {
+  const float64_t start = vkr_platform_get_absolute_time();
+  const VkrVulkanDescriptorLayout *resource_layout =
+      vkr_vulkan_device_resource_layout(renderer->device);
+  const VkrVulkanDescriptorLayout *sampler_layout =
+      vkr_vulkan_device_sampler_layout(renderer->device);
+  VkDescriptorSetLayout layouts[] = {
+      resource_layout->handle,
+      sampler_layout->handle,
+  };
+  VkPushConstantRange push_range = {
+      .stageFlags = VKR_VULKAN_PIPELINE_PUSH_STAGES,
+      .offset = 0u,
+      .size = sizeof(VkrVulkanPushConstants),
+  };
+  VkPipelineLayoutCreateInfo layout_info = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+      .setLayoutCount = ArrayCount(layouts),
+      .pSetLayouts = layouts,
+      .pushConstantRangeCount = 1u,
+      .pPushConstantRanges = &push_range,
+  };
+  VkDevice device = vkr_vk_renderer_device(renderer);
+  if (vkCreatePipelineLayout(device, &layout_info, NULL,
+                             &renderer->pipeline_layout) != VK_SUCCESS) {
+    return false_v;
+  }
+
+  VkrVulkanShaderSource sources[VKR_VULKAN_SHADER_SOURCE_COUNT];
+  VkrVulkanPipelineBuild builds[VKR_VULKAN_PIPELINE_BUILD_COUNT];
+  if (!vkr_vk_load_shaders(renderer, sources))
+    return false_v;
+  const uint32_t build_count =
+      vkr_vk_describe_pipelines(renderer, sources, builds);
+
+  // Warm pipelines come straight out of the renderer cache. The manifest can
+  // be stale if the driver evicted entries, so a warm create that would have
+  // to compile fails fast instead and joins the cold set.
+  uint32_t cold_count = 0u;
+  for (uint32_t i = 0u; i < build_count; ++i) {
+    VkrVulkanPipelineBuild *build = &builds[i];
+    if (build->warm) {
+      vkr_vk_compile_pipeline(
+          renderer, build, renderer->pipeline_cache,
+          VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT);
+      if (build->result == VK_PIPELINE_COMPILE_REQUIRED)
+        build->warm = false_v;
+      else if (build->result != VK_SUCCESS)
+        return false_v;
+    }
+    cold_count += build->warm ? 0u : 1u;
+  }
+  if (cold_count &&
+      !vkr_vk_compile_cold_pipelines(renderer, builds, build_count,
+                                     cold_count))
+    return false_v;
+
+  vkr_vk_record_pipeline_builds(renderer, builds, build_count, start);
   return true_v;
 }
@@ -314,10 +314,44 @@ vkr_internal bool8_t vkr_vk_upload_prepared_texture(
   return valid;
 }
 
+/** Planner destinations are opaque keys; a VkBuffer handle is 64 bits on
+ * every platform, whether it is a pointer or an integer. */
+vkr_internal uint64_t vkr_vk_upload_destination_key(VkBuffer buffer) {
+  uint64_t key = 0u;
+  MemCopy(&key, &buffer, sizeof(buffer));
+  return key;
+}
+
+vkr_internal VkBuffer vkr_vk_upload_destination_buffer(uint64_t key) {
+  VkBuffer buffer = VK_NULL_HANDLE;
+  MemCopy(&buffer, &key, sizeof(buffer));
+  return buffer;
+}
+
+vkr_internal void vkr_vk_cancel_buffer_batch(VkrVulkanRenderer *renderer) {
+  vkr_upload_planner_cancel(&renderer->upload_planner);
+  for (uint32_t i = 0u; i < renderer->pending_buffer_initialization_count;
+       ++i)
+    renderer->pending_buffer_initializations[i].staged_size = 0u;
+}
+
+/** Coalesces the next chunk of every pending buffer initialization into this
+ *
+ * frame's upload ring slice, so many small geometry publications share one
+ * flush and one copy command instead of a staging buffer each. A slice that
+ * is still in flight defers staging a frame; a slice opened by a frame that
+ * never submitted is kept and recorded as is. */
 vkr_internal bool8_t
 vkr_vk_stage_next_buffer_batch(VkrVulkanRenderer *renderer) {
-  if (renderer->staging_buffer_count)
+  VkrUploadPlanner *planner = &renderer->upload_planner;
+  if (planner->frame_open || !renderer->pending_buffer_initialization_count)
+    return true_v;
+  const VkrUploadPlannerStatus status =
+      vkr_upload_planner_begin_frame(planner, renderer->completed_value);
+  if (status == VKR_UPLOAD_PLANNER_STATUS_BUSY)
     return true_v;
+  if (status != VKR_UPLOAD_PLANNER_STATUS_OK)
+    return false_v;
   for (uint32_t i = 0u; i < renderer->pending_buffer_initialization_count;
        ++i) {
     VkrVulkanPendingBufferInitialization *initialization =
@@ -325,29 +359,34 @@ vkr_vk_stage_next_buffer_batch(VkrVulkanRenderer *renderer) {
     if (initialization->next_offset >= initialization->size)
       continue;
     const VkDeviceSize chunk_size =
-        Min((VkDeviceSize)renderer->config.upload_buffer_block_size,
+        Min((VkDeviceSize)vkr_upload_planner_remaining(planner),
             initialization->size - initialization->next_offset);
-    if (!vkr_vk_create_buffer(renderer, VKR_VULKAN_MEMORY_CLASS_STAGING,
-                              chunk_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              &initialization->staging)) {
-      log_error("Vulkan failed to create bounded %llu-byte buffer "
-                "staging chunk at offset %llu/%llu",
+    if (!chunk_size)
+      break;
+    if (vkr_upload_planner_write(
+            planner, vkr_vk_upload_destination_key(initialization->destination),
+            initialization->destination_offset + initialization->next_offset,
+            initialization->upload_data + initialization->next_offset,
+            chunk_size) != VKR_UPLOAD_PLANNER_STATUS_OK) {
+      log_error("Vulkan failed to stage %llu-byte buffer chunk at offset "
+                "%llu/%llu",
                 (unsigned long long)chunk_size,
                 (unsigned long long)initialization->next_offset,
                 (unsigned long long)initialization->size);
+      vkr_vk_cancel_buffer_batch(renderer);
       return false_v;
     }
-    MemCopy(initialization->staging.allocation.mapped,
-            initialization->upload_data + initialization->next_offset,
-            chunk_size);
-    if (!vkr_vk_flush(renderer, &initialization->staging.allocation, 0u,
-                      chunk_size)) {
-      vkr_vk_destroy_buffer(renderer, &initialization->staging);
-      return false_v;
-    }
-    renderer->staging_buffer_count++;
+    initialization->staged_size = chunk_size;
+  }
+  if (!planner->write_count) {
+    vkr_upload_planner_cancel(planner);
     return true_v;
   }
+  if (!vkr_vk_flush(renderer, &renderer->upload_ring.allocation,
+                    planner->slice.offset, planner->used)) {
+    vkr_vk_cancel_buffer_batch(renderer);
+    return false_v;
+  }
   return true_v;
 }
 
@@ -428,31 +467,13 @@ vkr_vk_stage_next_texture_batch(VkrVulkanRenderer *renderer) {
   return true_v;
 }
 
-/** Claims the single bounded host-visible staging chunk for one publication
+/** Stages this frame's buffer and texture publication work.
  *
- * class per frame, alternating between buffers and textures.
- *
- * Both classes share `staging_buffer_count`, and a chunk stays claimed until
- * the GPU completes its copy. Trying buffers first unconditionally therefore
- * starves textures outright rather than merely delaying them: a scene that
- * still has geometry to publish reclaims the slot every time it frees, so
- * material textures never leave `initialization_pending`, every draw whose
- * material references them is skipped, and the deferred resolve samples an
- * image that was never uploaded. Alternation preserves the memory bound and
- * the one-chunk-per-frame submit invariant while giving both classes
- * throughput. The flag only turns when a chunk is actually claimed, so a class
- * with nothing pending never costs the other one a frame. */
+ * Buffers stage through the persistent upload ring and textures through their
+ * single bounded staging chunk, so neither class waits on the other. */
 bool8_t vkr_vk_stage_next_publication_batch(VkrVulkanRenderer *renderer) {
-  const uint32_t claimed_before = renderer->staging_buffer_count;
-  const bool8_t textures_first = renderer->stage_textures_first;
-  const bool8_t staged = textures_first
-                             ? (vkr_vk_stage_next_texture_batch(renderer) &&
-                                vkr_vk_stage_next_buffer_batch(renderer))
-                             : (vkr_vk_stage_next_buffer_batch(renderer) &&
-                                vkr_vk_stage_next_texture_batch(renderer));
-  if (renderer->staging_buffer_count != claimed_before)
-    renderer->stage_textures_first = !textures_first;
-  return staged;
+  return vkr_vk_stage_next_buffer_batch(renderer) &&
+         vkr_vk_stage_next_texture_batch(renderer);
 }
 
 void vkr_vk_record_texture_initializations(VkrVulkanRenderer *renderer,
@@ -577,27 +598,55 @@ void vkr_vk_record_buffer_initializations(VkrVulkanRenderer *renderer,
     };
     vkCmdPipelineBarrier2(command, &dependency);
   }
-  for (uint32_t i = 0; i < renderer->pending_buffer_initialization_count; ++i) {
-    const VkrVulkanPendingBufferInitialization *initialization =
-        &renderer->pending_buffer_initializations[i];
-    if (!initialization->staging.handle)
-      continue;
-    const VkBufferCopy2 region = {
+  const VkrUploadCopy *copies = NULL;
+  const uint32_t copy_count =
+      vkr_upload_planner_build(&renderer->upload_planner, &copies);
+  VkBufferCopy2 regions[16];
+  uint32_t region_count = 0u;
+  for (uint32_t i = 0u; i < copy_count; ++i) {
+    const VkrUploadCopy *copy = &copies[i];
+    if (i && copy->wave != copies[i - 1u].wave) {
+      const VkMemoryBarrier2 barrier = {
+          .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+          .srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+          .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+          .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+          .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      };
+      const VkDependencyInfo dependency = {
+          .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+          .memoryBarrierCount = 1u,
+          .pMemoryBarriers = &barrier,
+      };
+      vkCmdPipelineBarrier2(command, &dependency);
+    }
+    regions[region_count++] = (VkBufferCopy2){
         .sType = VK_STRUCTURE_TYPE_BUFFER_COPY_2,
-        .dstOffset =
-            initialization->destination_offset + initialization->next_offset,
-        .size = initialization->staging.size,
+        .srcOffset = copy->source_offset,
+        .dstOffset = copy->destination_offset,
+        .size = copy->size,
     };
-    const VkCopyBufferInfo2 copy = {
+    /* Copies of one destination within a wave share a command. */
+    const VkrUploadCopy *next = i + 1u < copy_count ? &copies[i + 1u] : NULL;
+    if (next && next->destination == copy->destination &&
+        next->wave == copy->wave && region_count < ArrayCount(regions))
+      continue;
+    const VkCopyBufferInfo2 copy_info = {
         .sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2,
-        .srcBuffer = initialization->staging.handle,
-        .dstBuffer = initialization->destination,
-        .regionCount = 1u,
-        .pRegions = &region,
+        .srcBuffer = renderer->upload_ring.handle,
+        .dstBuffer = vkr_vk_upload_destination_buffer(copy->destination),
+        .regionCount = region_count,
+        .pRegions = regions,
     };
-    vkCmdCopyBuffer2(command, &copy);
-    if (initialization->next_offset + initialization->staging.size <
-        initialization->size)
+    vkCmdCopyBuffer2(command, &copy_info);
+    region_count = 0u;
+  }
+  for (uint32_t i = 0; i < renderer->pending_buffer_initialization_count; ++i) {
+    const VkrVulkanPendingBufferInitialization *initialization =
+        &renderer->pending_buffer_initializations[i];
+    if (!initialization->staged_size ||
+        initialization->next_offset + initialization->staged_size <
+            initialization->size)
       continue;
     const VkBufferMemoryBarrier2 barrier = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
@@ -665,7 +714,6 @@ vkr_vk_reserve_retired_geometry_megabuffer(VkrVulkanRenderer *renderer) {
 vkr_internal void vkr_vk_release_buffer_initialization(
     VkrVulkanRenderer *renderer,
     VkrVulkanPendingBufferInitialization *initialization) {
-  vkr_vk_destroy_buffer(renderer, &initialization->staging);
   if (initialization->upload_data)
     (void)vkr_dmemory_free(&renderer->publication_staging_memory,
                            initialization->upload_data, initialization->size);
@@ -699,23 +747,13 @@ bool8_t vkr_vk_commit_buffer_initializations(VkrVulkanRenderer *renderer,
     mega->copy_index_size = 0u;
     mega->copy_pending = false_v;
   }
-  VkrVulkanPendingBufferInitialization *submitted = NULL;
-  for (uint32_t i = 0u; i < renderer->pending_buffer_initialization_count;
-       ++i) {
-    VkrVulkanPendingBufferInitialization *initialization =
-        &renderer->pending_buffer_initializations[i];
-    if (!initialization->staging.handle)
-      continue;
-    if (submitted) {
-      log_error("Vulkan submitted more than one bounded staging "
-                "buffer in a frame");
-      return false_v;
-    }
-    submitted = initialization;
-  }
-  if (submitted && !vkr_vk_retire_submitted_staging(
-                       renderer, &submitted->staging, retire_value))
+  VkrUploadPlanner *planner = &renderer->upload_planner;
+  if (planner->frame_open &&
+      vkr_upload_planner_submit(planner, retire_value) !=
+          VKR_UPLOAD_PLANNER_STATUS_OK) {
+    log_error("Vulkan could not retire the submitted upload ring slice");
     return false_v;
+  }
 
   uint32_t write_index = 0u;
   const uint32_t pending_count = renderer->pending_buffer_initialization_count;
@@ -724,7 +762,7 @@ bool8_t vkr_vk_commit_buffer_initializations(VkrVulkanRenderer *renderer,
         &renderer->pending_buffer_initializations[read_index];
     VkrVulkanPublishedGeometry *geometry =
         &renderer->published_geometries[initialization->geometry_record_index];
-    if (!initialization->staging.handle) {
+    if (!initialization->staged_size) {
       if (write_index != read_index) {
         renderer->pending_buffer_initializations[write_index] = *initialization;
         MemZero(initialization, sizeof(*initialization));
@@ -732,8 +770,8 @@ bool8_t vkr_vk_commit_buffer_initializations(VkrVulkanRenderer *renderer,
       write_index++;
       continue;
     }
-    initialization->next_offset += initialization->staging.size;
-    MemZero(&initialization->staging, sizeof(initialization->staging));
+    initialization->next_offset += initialization->staged_size;
+    initialization->staged_size = 0u;
     geometry->last_use_submit_value =
         Max(geometry->last_use_submit_value, retire_value);
     if (initialization->next_offset == initialization->size) {
@@ -756,13 +794,12 @@ bool8_t vkr_vk_commit_buffer_initializations(VkrVulkanRenderer *renderer,
 }
 
 void vkr_vk_discard_buffer_initializations(VkrVulkanRenderer *renderer) {
+  vkr_upload_planner_cancel(&renderer->upload_planner);
   for (uint32_t i = 0; i < renderer->pending_buffer_initialization_count; ++i) {
     VkrVulkanPendingBufferInitialization *initialization =
         &renderer->pending_buffer_initializations[i];
     VkrVulkanPublishedGeometry *geometry =
         &renderer->published_geometries[initialization->geometry_record_index];
-    if (initialization->staging.handle && renderer->staging_buffer_count)
-      renderer->staging_buffer_count--;
     if (geometry->pending_initialization_count)
       geometry->pending_initialization_count--;
     vkr_vk_release_buffer_initialization(renderer, initialization);
@@ -773,6 +810,7 @@ void vkr_vk_discard_buffer_initializations(VkrVulkanRenderer *renderer) {
 vkr_internal void
 vkr_vk_discard_geometry_initializations(VkrVulkanRenderer *renderer,
                                         uint32_t geometry_record_index) {
+  bool8_t discarded_staged = false_v;
   uint32_t write_index = 0u;
   for (uint32_t read_index = 0;
        read_index < renderer->pending_buffer_initialization_count;
@@ -780,8 +818,7 @@ vkr_vk_discard_geometry_initializations(VkrVulkanRenderer *renderer,
     VkrVulkanPendingBufferInitialization *initialization =
         &renderer->pending_buffer_initializations[read_index];
     if (initialization->geometry_record_index == geometry_record_index) {
-      if (initialization->staging.handle && renderer->staging_buffer_count)
-        renderer->staging_buffer_count--;
+      discarded_staged |= initialization->staged_size != 0u;
       vkr_vk_release_buffer_initialization(renderer, initialization);
       continue;
     }
@@ -796,6 +833,10 @@ vkr_vk_discard_geometry_initializations(VkrVulkanRenderer *renderer,
   renderer->pending_buffer_initialization_count = write_index;
   renderer->published_geometries[geometry_record_index]
       .pending_initialization_count = 0u;
+  /* The open slice still holds copies into the discarded range; restage the
+     survivors next frame rather than record them. */
+  if (discarded_staged)
+    vkr_vk_cancel_buffer_batch(renderer);
 }
 
 bool8_t vkr_vk_commit_texture_initializations(VkrVulkanRenderer *renderer,
@@ -2457,6 +2498,31 @@ vkr_internal bool8_t vkr_vk_asset_bake_hdr_environment(
                                true_v);
 }
 
+/** The maps are finished, so unlike a queued bake no IBL references hold. */
+vkr_internal bool8_t vkr_vk_asset_attach_ibl_maps(void *state,
+                                                  VkrTextureHandle source,
+                                                  VkrTextureHandle irradiance,
+                                                  VkrTextureHandle prefilter) {
+  VkrVulkanRenderer *renderer = state;
+  VkrVulkanPublishedTexture *source_texture =
+      vkr_vk_published_texture(renderer, source, NULL);
+  const VkrVulkanPublishedTexture *irradiance_texture =
+      vkr_vk_published_texture(renderer, irradiance, NULL);
+  const VkrVulkanPublishedTexture *prefilter_texture =
+      vkr_vk_published_texture(renderer, prefilter, NULL);
+  if (!source_texture || !irradiance_texture || !prefilter_texture ||
+      source_texture->image.array_layers != 6u ||
+      irradiance_texture->image.array_layers != 6u ||
+      prefilter_texture->image.array_layers != 6u ||
+      irradiance_texture->image.mip_levels != 1u ||
+      irradiance_texture->image.format != VK_FORMAT_R16G16B16A16_SFLOAT ||
+      prefilter_texture->image.format != VK_FORMAT_R16G16B16A16_SFLOAT)
+    return false_v;
+  source_texture->ibl_irradiance = irradiance;
+  source_texture->ibl_prefilter = prefilter;
+  return true_v;
+}
+
 vkr_internal bool8_t vkr_vk_asset_publications_idle(void *state) {
   const VkrVulkanRenderer *renderer = state;
   return renderer && !renderer->pending_texture_initialization_count &&
@@ -2490,6 +2556,8 @@ void vkr_vulkan_renderer_get_asset_publisher(VkrVulkanRenderer *renderer,
                                   vkr_vk_asset_bake_ibl_cubemap,
                               .bake_hdr_environment =
                                   vkr_vk_asset_bake_hdr_environment,
+                              .attach_ibl_maps =
+                                  vkr_vk_asset_attach_ibl_maps,
                              .unpublish_texture =
                                  vkr_vk_asset_unpublish_texture,
                              .publish_material =
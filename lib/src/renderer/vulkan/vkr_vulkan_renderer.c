@@ -1517,6 +1517,8 @@ void vkr_vulkan_renderer_destroy(VkrVulkanRenderer *renderer) {
     vkr_vk_destroy_image(renderer, &renderer->sentinel_image);
     vkr_vk_destroy_buffer(renderer, &renderer->materials);
     vkr_vk_destroy_buffer(renderer, &renderer->upload);
+    vkr_upload_planner_destroy(&renderer->upload_planner);
+    vkr_vk_destroy_buffer(renderer, &renderer->upload_ring);
     vkr_vk_destroy_buffer(renderer, &renderer->sampler_descriptors);
     vkr_vk_destroy_buffer(renderer, &renderer->resource_descriptors);
     vkr_vulkan_memory_pool_destroy(renderer->memory_pool);
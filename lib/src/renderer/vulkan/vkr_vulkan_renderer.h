@@ -19,6 +19,10 @@ typedef struct VkrVulkanRenderer VkrVulkanRenderer;
 
 typedef struct VkrVulkanRendererConfig {
   VkrAllocator *allocator;
+  /** Optional; cache misses compile in parallel on it, else serially. */
+  VkrJobSystem *job_system;
+  /** Optional; receives the pipeline startup counters. */
+  VkrRendererBootMetrics *boot_metrics;
   const char *graph_path;
   VkrWindow *window;
   VkrPresentTargetKind target_kind;
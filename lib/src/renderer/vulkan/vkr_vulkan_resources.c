@@ -482,25 +482,45 @@ vkr_internal bool8_t vkr_vk_create_upload_buffers(VkrVulkanRenderer *renderer) {
       vkr_vulkan_device_resource_layout(renderer->device);
   const VkrVulkanDescriptorLayout *sampler_layout =
       vkr_vulkan_device_sampler_layout(renderer->device);
-  return vkr_vk_create_buffer(
-             renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD, resource_layout->size,
-             VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
-                 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-             &renderer->resource_descriptors) &&
-         vkr_vk_create_buffer(
-             renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD, sampler_layout->size,
-             VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
-                 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-             &renderer->sampler_descriptors) &&
-         vkr_vk_create_buffer(renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD,
-                              VKR_VULKAN_SENTINEL_UPLOAD_SIZE,
-                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                              &renderer->upload) &&
-         vkr_vk_create_buffer(
-             renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD,
-             (VkDeviceSize)renderer->config.material_slot_capacity *
-                 sizeof(VkrVulkanMaterialGpuRow),
-             VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, &renderer->materials);
+  if (!vkr_vk_create_buffer(
+          renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD, resource_layout->size,
+          VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+              VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+          &renderer->resource_descriptors) ||
+      !vkr_vk_create_buffer(
+          renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD, sampler_layout->size,
+          VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+              VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+          &renderer->sampler_descriptors) ||
+      !vkr_vk_create_buffer(renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD,
+                            VKR_VULKAN_SENTINEL_UPLOAD_SIZE,
+                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                            &renderer->upload) ||
+      !vkr_vk_create_buffer(
+          renderer, VKR_VULKAN_MEMORY_CLASS_UPLOAD,
+          (VkDeviceSize)renderer->config.material_slot_capacity *
+              sizeof(VkrVulkanMaterialGpuRow),
+          VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, &renderer->materials))
+    return false_v;
+  /* One staging block, split across frame slots, bounds buffer publication
+     to the same host-visible footprint the per-chunk path had. */
+  const VkDeviceSize ring_size = renderer->config.upload_buffer_block_size;
+  if (!vkr_vk_create_buffer(renderer, VKR_VULKAN_MEMORY_CLASS_STAGING,
+                            ring_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                            &renderer->upload_ring))
+    return false_v;
+  const VkrUploadPlannerConfig planner_config = {
+      .staging_size = ring_size,
+      .frame_count = VKR_VULKAN_FRAME_SLOT_COUNT,
+      .max_writes = renderer->config.publication_staging_capacity,
+      .alignment = 16u,
+  };
+  const VkrGpuAddressPair ring = {
+      .cpu_address = renderer->upload_ring.allocation.mapped,
+      .size = ring_size,
+  };
+  return vkr_upload_planner_create(&renderer->upload_planner,
+                                   renderer->allocator, &planner_config, ring);
 }
 
 void vkr_vk_destroy_image(VkrVulkanRenderer *renderer, VkrVulkanImage *image) {
@@ -720,6 +740,18 @@ vkr_internal bool8_t vkr_vk_create_frame_slots(VkrVulkanRenderer *renderer) {
                                &slot->capture_readback))) {
       return false_v;
     }
+    for (uint32_t stream = 0u; stream < VKR_VULKAN_WORLD_ROWS_COUNT;
+         ++stream) {
+      VkrVulkanWorldRows *rows = &slot->world_rows[stream];
+      if (!vkr_row_table_create(&rows->candidates, renderer->allocator,
+                                sizeof(VkrGpuCandidateDrawRow),
+                                VKR_VULKAN_WORLD_ROW_MERGE_GAP) ||
+          !vkr_row_table_create(&rows->instances, renderer->allocator,
+                                sizeof(VkrInstanceDataGPU),
+                                VKR_VULKAN_WORLD_ROW_MERGE_GAP) ||
+          !vkr_row_slot_map_create(&rows->slots, renderer->allocator))
+        return false_v;
+    }
   }
   return true_v;
 }
@@ -729,6 +761,14 @@ void vkr_vk_destroy_frame_slots(VkrVulkanRenderer *renderer) {
   for (uint32_t i = 0; i < VKR_VULKAN_FRAME_SLOT_COUNT; ++i) {
     VkrVulkanFrameSlot *slot = &renderer->frame_slots[i];
     vkr_vk_destroy_buffer(renderer, &slot->frame_upload);
+    for (uint32_t stream = 0u; stream < VKR_VULKAN_WORLD_ROWS_COUNT;
+         ++stream) {
+      VkrVulkanWorldRows *rows = &slot->world_rows[stream];
+      vkr_vk_destroy_buffer(renderer, &rows->buffer);
+      vkr_row_table_destroy(&rows->candidates);
+      vkr_row_table_destroy(&rows->instances);
+      vkr_row_slot_map_destroy(&rows->slots);
+    }
     vkr_vk_destroy_buffer(renderer, &slot->capture_readback);
     vkr_vk_destroy_buffer(renderer, &slot->readback);
     if (slot->timestamp_pool)
@@ -0,0 +1,470 @@
+#include "bvh_test.h"
+
+#include "math/vkr_bvh.h"
+#include "math/vkr_triangle_bvh.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/systems/vkr_mesh_bounds_index.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define BVH_TEST_PRIMITIVE_COUNT 257u
+
+typedef struct BvhTestHits {
+  uint8_t hit[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t count;
+} BvhTestHits;
+
+static bool8_t bvh_test_record_hit(uint32_t primitive, void *user_data) {
+  BvhTestHits *hits = (BvhTestHits *)user_data;
+  assert(primitive < BVH_TEST_PRIMITIVE_COUNT);
+  assert(!hits->hit[primitive]);
+  hits->hit[primitive] = 1;
+  hits->count++;
+  return true_v;
+}
+
+static bool8_t bvh_test_stop_after_first(uint32_t primitive, void *user_data) {
+  (void)primitive;
+  (*(uint32_t *)user_data)++;
+  return false_v;
+}
+
+/* Deterministic scatter so failures reproduce. */
+static float32_t bvh_test_random(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return (float32_t)(*state >> 8) / (float32_t)(1u << 24);
+}
+
+static void bvh_test_box_planes(VkrAabb box, VkrPlane out_planes[6]) {
+  out_planes[0] = (VkrPlane){vec3_new(1, 0, 0), -box.min.x};
+  out_planes[1] = (VkrPlane){vec3_new(-1, 0, 0), box.max.x};
+  out_planes[2] = (VkrPlane){vec3_new(0, 1, 0), -box.min.y};
+  out_planes[3] = (VkrPlane){vec3_new(0, -1, 0), box.max.y};
+  out_planes[4] = (VkrPlane){vec3_new(0, 0, 1), -box.min.z};
+  out_planes[5] = (VkrPlane){vec3_new(0, 0, -1), box.max.z};
+}
+
+static void test_bvh_query_matches_brute_force(void) {
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrAabb bounds[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t ids[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t state = 7u;
+  for (uint32_t i = 0; i < BVH_TEST_PRIMITIVE_COUNT; ++i) {
+    Vec3 center = vec3_new(bvh_test_random(&state) * 200.0f - 100.0f,
+                           bvh_test_random(&state) * 20.0f,
+                           bvh_test_random(&state) * 200.0f - 100.0f);
+    bounds[i] = vkr_aabb_from_sphere(center,
+                                     0.25f + bvh_test_random(&state) * 4.0f);
+    ids[i] = i;
+  }
+
+  VkrBvh bvh;
+  assert(vkr_bvh_create(&allocator, BVH_TEST_PRIMITIVE_COUNT, &bvh));
+  vkr_bvh_build(&bvh, bounds, ids, BVH_TEST_PRIMITIVE_COUNT);
+  assert(bvh.primitive_count == BVH_TEST_PRIMITIVE_COUNT);
+  assert(bvh.node_count > 1u);
+  assert(bvh.node_count < BVH_TEST_PRIMITIVE_COUNT * 2u);
+
+  for (uint32_t query = 0; query < 32u; ++query) {
+    Vec3 center = vec3_new(bvh_test_random(&state) * 200.0f - 100.0f,
+                           bvh_test_random(&state) * 20.0f,
+                           bvh_test_random(&state) * 200.0f - 100.0f);
+    VkrAabb region =
+        vkr_aabb_from_sphere(center, 1.0f + bvh_test_random(&state) * 30.0f);
+    VkrPlane planes[6];
+    bvh_test_box_planes(region, planes);
+
+    BvhTestHits hits = {0};
+    uint32_t visited = vkr_bvh_query_planes(&bvh, bounds, planes, 6u,
+                                            bvh_test_record_hit, &hits);
+    assert(visited == hits.count);
+    for (uint32_t i = 0; i < BVH_TEST_PRIMITIVE_COUNT; ++i) {
+      assert(hits.hit[i] == (vkr_aabb_test_planes(&bounds[i], planes, 6u)
+                                 ? 1u
+                                 : 0u));
+    }
+  }
+
+  uint32_t calls = 0;
+  assert(vkr_bvh_query_planes(&bvh, bounds, NULL, 0u,
+                              bvh_test_stop_after_first, &calls) == 1u);
+  assert(calls == 1u);
+
+  vkr_bvh_destroy(&bvh);
+  arena_destroy(arena);
+}
+
+static void test_bvh_refit_tracks_moved_primitive(void) {
+  Arena *arena = arena_create(KB(256), KB(256));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrAabb bounds[16];
+  uint32_t ids[16];
+  for (uint32_t i = 0; i < 16u; ++i) {
+    bounds[i] = vkr_aabb_from_sphere(vec3_new((float32_t)i * 4.0f, 0, 0), 1);
+    ids[i] = i;
+  }
+
+  VkrBvh bvh;
+  assert(vkr_bvh_create(&allocator, 16u, &bvh));
+  vkr_bvh_build(&bvh, bounds, ids, 16u);
+
+  VkrPlane planes[6];
+  bvh_test_box_planes(vkr_aabb_from_sphere(vec3_new(0, 50, 0), 2), planes);
+  BvhTestHits hits = {0};
+  assert(vkr_bvh_query_planes(&bvh, bounds, planes, 6u, bvh_test_record_hit,
+                              &hits) == 0u);
+
+  bounds[9] = vkr_aabb_from_sphere(vec3_new(0, 50, 0), 1);
+  vkr_bvh_refit(&bvh, bounds);
+  hits = (BvhTestHits){0};
+  assert(vkr_bvh_query_planes(&bvh, bounds, planes, 6u, bvh_test_record_hit,
+                              &hits) == 1u);
+  assert(hits.hit[9]);
+
+  vkr_bvh_destroy(&bvh);
+  arena_destroy(arena);
+}
+
+static void test_bvh_coincident_centroids_stay_bounded(void) {
+  Arena *arena = arena_create(KB(256), KB(256));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrAabb bounds[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t ids[BVH_TEST_PRIMITIVE_COUNT];
+  for (uint32_t i = 0; i < BVH_TEST_PRIMITIVE_COUNT; ++i) {
+    bounds[i] = vkr_aabb_from_sphere(vec3_new(3, 3, 3), 1);
+    ids[i] = i;
+  }
+
+  VkrBvh bvh;
+  assert(vkr_bvh_create(&allocator, BVH_TEST_PRIMITIVE_COUNT, &bvh));
+  vkr_bvh_build(&bvh, bounds, ids, BVH_TEST_PRIMITIVE_COUNT);
+  assert(bvh.node_count < BVH_TEST_PRIMITIVE_COUNT * 2u);
+
+  BvhTestHits hits = {0};
+  assert(vkr_bvh_query_planes(&bvh, bounds, NULL, 0u, bvh_test_record_hit,
+                              &hits) == BVH_TEST_PRIMITIVE_COUNT);
+
+  vkr_bvh_destroy(&bvh);
+  arena_destroy(arena);
+}
+
+static void test_mesh_bounds_index_tracks_membership(void) {
+  Arena *arena = arena_create(KB(256), KB(256));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrMeshBoundsIndex index;
+  assert(vkr_mesh_bounds_index_init(&index, &allocator, 8u, 8u));
+  const uint32_t instance_key = vkr_mesh_bounds_index_instance_key(&index, 3u);
+  const uint32_t mesh_key = vkr_mesh_bounds_index_mesh_key(&index, 3u);
+  assert(instance_key != mesh_key);
+
+  vkr_mesh_bounds_index_set(&index, instance_key, vec3_new(0, 0, 0), 1.0f);
+  vkr_mesh_bounds_index_set(&index, mesh_key, vec3_new(10, 0, 0), 1.0f);
+  assert(index.live_count == 2u);
+  assert(index.needs_rebuild);
+  vkr_mesh_bounds_index_commit(&index);
+  assert(!index.needs_rebuild && !index.needs_refit);
+
+  // Re-publishing identical bounds is the per-frame steady state and must not
+  // dirty the tree.
+  vkr_mesh_bounds_index_set(&index, instance_key, vec3_new(0, 0, 0), 1.0f);
+  assert(!index.needs_rebuild && !index.needs_refit);
+
+  vkr_mesh_bounds_index_set(&index, instance_key, vec3_new(0, 5, 0), 1.0f);
+  assert(index.needs_refit && !index.needs_rebuild);
+
+  VkrPlane planes[6];
+  bvh_test_box_planes(vkr_aabb_from_sphere(vec3_new(0, 5, 0), 0.5f), planes);
+  assert(vkr_mesh_bounds_index_query_planes(&index, planes, 6u, NULL, NULL) ==
+         1u);
+  assert(index.refits_since_build == 1u);
+
+  vkr_mesh_bounds_index_remove(&index, instance_key);
+  vkr_mesh_bounds_index_remove(&index, instance_key);
+  assert(index.live_count == 1u);
+  assert(!vkr_mesh_bounds_index_contains(&index, instance_key));
+  assert(vkr_mesh_bounds_index_contains(&index, mesh_key));
+  assert(index.live_keys[0] == mesh_key);
+  assert(vkr_mesh_bounds_index_query_planes(&index, planes, 6u, NULL, NULL) ==
+         0u);
+
+  vkr_mesh_bounds_index_shutdown(&index);
+  arena_destroy(arena);
+}
+
+static bool8_t bvh_test_ray_box(uint32_t primitive, const VkrRay *ray,
+                                 float32_t max_t, float32_t *out_t,
+                                 void *user_data) {
+  const VkrAabb *bounds = (const VkrAabb *)user_data;
+  return vkr_aabb_intersect_ray(&bounds[primitive], ray->origin,
+                                vkr_ray_inverse_direction(ray->direction),
+                                max_t, out_t);
+}
+
+static VkrRay bvh_test_random_ray(uint32_t *state) {
+  Vec3 origin = vec3_new(bvh_test_random(state) * 240.0f - 120.0f,
+                         40.0f + bvh_test_random(state) * 20.0f,
+                         bvh_test_random(state) * 240.0f - 120.0f);
+  Vec3 target = vec3_new(bvh_test_random(state) * 200.0f - 100.0f,
+                         bvh_test_random(state) * 20.0f,
+                         bvh_test_random(state) * 200.0f - 100.0f);
+  return (VkrRay){.origin = origin,
+                  .direction = vec3_normalize(vec3_sub(target, origin))};
+}
+
+static void test_bvh_ray_query_matches_brute_force(void) {
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrAabb bounds[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t ids[BVH_TEST_PRIMITIVE_COUNT];
+  uint32_t state = 11u;
+  for (uint32_t i = 0; i < BVH_TEST_PRIMITIVE_COUNT; ++i) {
+    Vec3 center = vec3_new(bvh_test_random(&state) * 200.0f - 100.0f,
+                           bvh_test_random(&state) * 20.0f,
+                           bvh_test_random(&state) * 200.0f - 100.0f);
+    bounds[i] = vkr_aabb_from_sphere(center,
+                                     0.5f + bvh_test_random(&state) * 6.0f);
+    ids[i] = i;
+  }
+
+  VkrBvh bvh;
+  assert(vkr_bvh_create(&allocator, BVH_TEST_PRIMITIVE_COUNT, &bvh));
+  vkr_bvh_build(&bvh, bounds, ids, BVH_TEST_PRIMITIVE_COUNT);
+
+  uint32_t hit_count = 0;
+  for (uint32_t query = 0; query < 256u; ++query) {
+    const VkrRay ray = bvh_test_random_ray(&state);
+    const Vec3 inv_direction = vkr_ray_inverse_direction(ray.direction);
+
+    float32_t expected_t = 1000.0f;
+    bool8_t expected = false_v;
+    for (uint32_t i = 0; i < BVH_TEST_PRIMITIVE_COUNT; ++i) {
+      float32_t t = 0.0f;
+      if (vkr_aabb_intersect_ray(&bounds[i], ray.origin, inv_direction,
+                                 expected_t, &t)) {
+        expected_t = t;
+        expected = true_v;
+      }
+    }
+
+    VkrBvhRayHit hit = {0};
+    const bool8_t found = vkr_bvh_query_ray(
+        &bvh, bounds, &ray, 1000.0f, bvh_test_ray_box, bounds, &hit);
+    assert(found == expected);
+    if (found) {
+      assert(hit.primitive < BVH_TEST_PRIMITIVE_COUNT);
+      assert(vkr_abs_f32(hit.t - expected_t) <= 1e-4f);
+      hit_count++;
+    }
+  }
+  // The scatter is dense enough that most rays should hit something.
+  assert(hit_count > 64u);
+
+  vkr_bvh_destroy(&bvh);
+  arena_destroy(arena);
+}
+
+/* Height-field grid of (cells + 1)^2 vertices and 2 * cells^2 triangles. */
+static void bvh_test_build_grid(uint32_t cells, float32_t spacing,
+                                Vec3 *vertices, uint32_t *indices) {
+  uint32_t state = 5u;
+  const uint32_t row = cells + 1u;
+  for (uint32_t z = 0; z < row; ++z) {
+    for (uint32_t x = 0; x < row; ++x) {
+      vertices[z * row + x] =
+          vec3_new((float32_t)x * spacing, bvh_test_random(&state) * spacing,
+                   (float32_t)z * spacing);
+    }
+  }
+  uint32_t cursor = 0;
+  for (uint32_t z = 0; z < cells; ++z) {
+    for (uint32_t x = 0; x < cells; ++x) {
+      const uint32_t v = z * row + x;
+      indices[cursor++] = v;
+      indices[cursor++] = v + row;
+      indices[cursor++] = v + 1u;
+      indices[cursor++] = v + 1u;
+      indices[cursor++] = v + row;
+      indices[cursor++] = v + row + 1u;
+    }
+  }
+}
+
+static void test_triangle_bvh_matches_brute_force(void) {
+  Arena *arena = arena_create(MB(8), MB(8));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  enum { CELLS = 24, ROW = CELLS + 1, INDEX_COUNT = CELLS * CELLS * 6 };
+  static Vec3 vertices[ROW * ROW];
+  static uint32_t indices[INDEX_COUNT];
+  bvh_test_build_grid(CELLS, 1.0f, vertices, indices);
+
+  // Two sources over one buffer: the second half of the index range, and a
+  // degenerate source that must be skipped.
+  const uint32_t half = INDEX_COUNT / 2u;
+  VkrTriangleMeshSource sources[3] = {
+      {.positions = vertices, .position_stride = sizeof(Vec3),
+       .vertex_count = ROW * ROW, .indices = indices,
+       .index_size = sizeof(uint32_t), .first_index = 0, .index_count = half},
+      {.positions = vertices, .position_stride = sizeof(Vec3),
+       .vertex_count = ROW * ROW, .indices = indices,
+       .index_size = sizeof(uint32_t), .first_index = half,
+       .index_count = INDEX_COUNT - half},
+      {.positions = NULL, .index_count = 3},
+  };
+
+  VkrTriangleBvh bvh;
+  assert(vkr_triangle_bvh_create(&allocator, sources, 3u, &bvh));
+  assert(bvh.triangle_count == CELLS * CELLS * 2u);
+  assert(vkr_triangle_bvh_memory_size(&bvh) >
+         sizeof(VkrTriangle) * bvh.triangle_count);
+
+  uint32_t state = 3u;
+  uint32_t hit_count = 0;
+  for (uint32_t query = 0; query < 256u; ++query) {
+    const VkrRay ray = {
+        .origin = vec3_new(bvh_test_random(&state) * 30.0f - 3.0f,
+                           5.0f + bvh_test_random(&state) * 5.0f,
+                           bvh_test_random(&state) * 30.0f - 3.0f),
+        .direction = vec3_new(bvh_test_random(&state) - 0.5f, -1.0f,
+                              bvh_test_random(&state) - 0.5f),
+    };
+
+    float32_t expected_t = 100.0f;
+    bool8_t expected = false_v;
+    for (uint32_t i = 0; i < bvh.triangle_count; ++i) {
+      float32_t t = 0.0f;
+      if (vkr_triangle_intersect_ray(&bvh.triangles[i], &ray, expected_t,
+                                     &t)) {
+        expected_t = t;
+        expected = true_v;
+      }
+    }
+
+    float32_t t = 0.0f;
+    uint32_t triangle = VKR_INVALID_ID;
+    const bool8_t found =
+        vkr_triangle_bvh_raycast(&bvh, &ray, 100.0f, &t, &triangle);
+    assert(found == expected);
+    if (found) {
+      assert(triangle < bvh.triangle_count);
+      assert(vkr_abs_f32(t - expected_t) <= 1e-4f);
+      hit_count++;
+    }
+  }
+  assert(hit_count > 128u);
+
+  // A ray pointing away from the surface.
+  VkrRay away = {.origin = vec3_new(5, 5, 5), .direction = vec3_new(0, 1, 0)};
+  assert(!vkr_triangle_bvh_raycast(&bvh, &away, 100.0f, NULL, NULL));
+
+  vkr_triangle_bvh_destroy(&bvh);
+  arena_destroy(arena);
+}
+
+static bool8_t bvh_test_ray_sphere_key(uint32_t key, const VkrRay *ray,
+                                       float32_t max_t, float32_t *out_t,
+                                       void *user_data) {
+  const VkrMeshBoundsIndex *index = (const VkrMeshBoundsIndex *)user_data;
+  const Vec4 sphere = index->spheres[key];
+  const Vec3 offset =
+      vec3_sub(ray->origin, vec3_new(sphere.x, sphere.y, sphere.z));
+  const float32_t b = vec3_dot(offset, ray->direction);
+  const float32_t c = vec3_dot(offset, offset) - sphere.w * sphere.w;
+  const float32_t discriminant = b * b - c;
+  if (discriminant < 0.0f) {
+    return false_v;
+  }
+  const float32_t t = -b - vkr_sqrt_f32(discriminant);
+  if (t < 0.0f || t >= max_t) {
+    return false_v;
+  }
+  *out_t = t;
+  return true_v;
+}
+
+static void test_mesh_bounds_index_ray_query(void) {
+  Arena *arena = arena_create(KB(256), KB(256));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrMeshBoundsIndex index;
+  assert(vkr_mesh_bounds_index_init(&index, &allocator, 8u, 8u));
+  for (uint32_t slot = 0; slot < 8u; ++slot) {
+    vkr_mesh_bounds_index_set(
+        &index, vkr_mesh_bounds_index_instance_key(&index, slot),
+        vec3_new((float32_t)slot * 10.0f, 0, 0), 1.0f);
+  }
+  const uint32_t mesh_key = vkr_mesh_bounds_index_mesh_key(&index, 2u);
+  vkr_mesh_bounds_index_set(&index, mesh_key, vec3_new(35, 0, 0), 1.0f);
+
+  // Ray down +x from x = 22 sees instance 3 (x = 30) first.
+  const VkrRay ray = {.origin = vec3_new(22, 0, 0),
+                      .direction = vec3_new(1, 0, 0)};
+  VkrBvhRayHit hit = {0};
+  assert(vkr_mesh_bounds_index_query_ray(&index, &ray, 100.0f,
+                                         bvh_test_ray_sphere_key, &index,
+                                         &hit));
+  assert(hit.primitive == vkr_mesh_bounds_index_instance_key(&index, 3u));
+  assert(vkr_abs_f32(hit.t - 7.0f) <= 1e-4f);
+
+  // Once it is gone, the legacy mesh at x = 35 is the closest.
+  vkr_mesh_bounds_index_remove(&index,
+                               vkr_mesh_bounds_index_instance_key(&index, 3u));
+  assert(vkr_mesh_bounds_index_query_ray(&index, &ray, 100.0f,
+                                         bvh_test_ray_sphere_key, &index,
+                                         &hit));
+  assert(hit.primitive == mesh_key);
+  assert(!vkr_mesh_bounds_index_key_is_instance(&index, hit.primitive));
+  assert(vkr_mesh_bounds_index_key_slot(&index, hit.primitive) == 2u);
+  assert(!vkr_mesh_bounds_index_query_ray(&index, &ray, 5.0f,
+                                          bvh_test_ray_sphere_key, &index,
+                                          &hit));
+
+  uint32_t near_origin = vkr_mesh_bounds_index_query_sphere(
+      &index, vec3_new(0, 0, 0), 12.0f, NULL, NULL);
+  assert(near_origin == 2u);
+
+  vkr_mesh_bounds_index_shutdown(&index);
+  arena_destroy(arena);
+}
+
+bool32_t run_bvh_tests(void) {
+  printf("--- Starting BVH Tests ---\n");
+  printf("  Running test_bvh_query_matches_brute_force...\n");
+  test_bvh_query_matches_brute_force();
+  printf("  test_bvh_query_matches_brute_force PASSED\n");
+  printf("  Running test_bvh_refit_tracks_moved_primitive...\n");
+  test_bvh_refit_tracks_moved_primitive();
+  printf("  test_bvh_refit_tracks_moved_primitive PASSED\n");
+  printf("  Running test_bvh_coincident_centroids_stay_bounded...\n");
+  test_bvh_coincident_centroids_stay_bounded();
+  printf("  test_bvh_coincident_centroids_stay_bounded PASSED\n");
+  printf("  Running test_mesh_bounds_index_tracks_membership...\n");
+  test_mesh_bounds_index_tracks_membership();
+  printf("  test_mesh_bounds_index_tracks_membership PASSED\n");
+  printf("  Running test_bvh_ray_query_matches_brute_force...\n");
+  test_bvh_ray_query_matches_brute_force();
+  printf("  test_bvh_ray_query_matches_brute_force PASSED\n");
+  printf("  Running test_triangle_bvh_matches_brute_force...\n");
+  test_triangle_bvh_matches_brute_force();
+  printf("  test_triangle_bvh_matches_brute_force PASSED\n");
+  printf("  Running test_mesh_bounds_index_ray_query...\n");
+  test_mesh_bounds_index_ray_query();
+  printf("  test_mesh_bounds_index_ray_query PASSED\n");
+  printf("--- BVH Tests Completed ---\n");
+  return true_v;
+}
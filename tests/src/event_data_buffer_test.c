@@ -202,6 +202,35 @@ void test_event_data_buffer_alloc_wrap_around(void) {
   printf("    test_event_data_buffer_alloc_wrap_around PASSED\n");
 }
 
+void test_event_data_buffer_free_across_wrap(void) {
+  printf("    Running test_event_data_buffer_free_across_wrap...\n");
+  setup_test();
+  VkrEventDataBuffer edb;
+  vkr_event_data_buffer_create(&allocator, 50, &edb);
+  void *ptr1, *ptr2, *ptr3;
+
+  // Blocks of 18 at [0, 18) and [18, 36); the third does not fit in the 14
+  // bytes left at the end, so it wraps to the start once the first is freed.
+  assert(vkr_event_data_buffer_alloc(&edb, 10, &ptr1));
+  assert(vkr_event_data_buffer_alloc(&edb, 10, &ptr2));
+  fill_test_data(ptr2, 10, 20);
+  assert(vkr_event_data_buffer_free(&edb, 10));
+  assert(vkr_event_data_buffer_alloc(&edb, 10, &ptr3));
+  assert(ptr3 == edb.buffer + sizeof(uint64_t));
+  fill_test_data(ptr3, 10, 30);
+
+  // Freeing the second block leaves head on the skipped tail; the next free
+  // must follow the wrap instead of reading the gap as a header.
+  assert(verify_test_data(ptr2, 10, 20));
+  assert(vkr_event_data_buffer_free(&edb, 10));
+  assert(verify_test_data(ptr3, 10, 30));
+  assert(vkr_event_data_buffer_free(&edb, 10));
+  assert(edb.fill == 0 && edb.head == 0 && edb.tail == 0);
+
+  teardown_test();
+  printf("    test_event_data_buffer_free_across_wrap PASSED\n");
+}
+
 void test_event_data_buffer_alloc_fragmented(void) {
   printf("    Running test_event_data_buffer_alloc_fragmented...\n");
   setup_test();
@@ -509,6 +538,7 @@ bool32_t run_event_data_buffer_tests(void) {
   test_event_data_buffer_alloc_zero_size();
   test_event_data_buffer_alloc_full();
   test_event_data_buffer_alloc_wrap_around();
+  test_event_data_buffer_free_across_wrap();
   test_event_data_buffer_alloc_fragmented();
   test_event_data_buffer_free_simple();
   test_event_data_buffer_free_empty_buffer();
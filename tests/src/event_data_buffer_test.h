@@ -11,6 +11,7 @@ void test_event_data_buffer_alloc_simple(void);
 void test_event_data_buffer_alloc_zero_size(void);
 void test_event_data_buffer_alloc_full(void);
 void test_event_data_buffer_alloc_wrap_around(void);
+void test_event_data_buffer_free_across_wrap(void);
 void test_event_data_buffer_alloc_fragmented(void);
 void test_event_data_buffer_free_simple(void);
 void test_event_data_buffer_free_empty_buffer(void);
@@ -227,7 +227,9 @@ static void test_event_manager_create_destroy(void) {
 
   assert(manager.arena != NULL && "Arena pointer should not be NULL");
   assert(manager.running == true && "Manager should be running");
-  assert(manager.queue.data != NULL && "Queue data should be initialized");
+  assert(manager.queue.slots != NULL && "Ring slots should be initialized");
+  assert(manager.mode == EVENT_DISPATCH_MODE_THREAD &&
+         "Default manager should dispatch on its worker thread");
 
   event_manager_destroy(&manager);
 
@@ -358,61 +360,48 @@ static void test_queue_full(void) {
   printf("  Running test_queue_full...\n");
   setup_suite();
 
+  // Manual mode has no consumer, so nothing drains the ring behind our back.
   EventManager manager;
-  event_manager_create(&manager);
-
-  // We need to fill the queue without processing events
-  // First, stop the event processor
-  vkr_mutex_lock(manager.mutex);
-  manager.running = false;
-  vkr_mutex_unlock(manager.mutex);
-  vkr_cond_signal(manager.cond);
-
-  // Wait for the thread to exit
-  vkr_thread_join(manager.thread);
-
-  // Now reinitialize queue and mutex manually without a thread
-  manager.running = false;
-  vkr_mutex_destroy(&manager.allocator, &manager.mutex);
-  vkr_cond_destroy(&manager.allocator, &manager.cond);
-  vkr_mutex_create(&manager.allocator, &manager.mutex);
-  vkr_cond_create(&manager.allocator, &manager.cond);
+  EventManagerConfig config = event_manager_config_default();
+  config.mode = EVENT_DISPATCH_MODE_MANUAL;
+  config.queue_capacity = 64;
+  assert(event_manager_create_with_config(&manager, &config));
+  processed_count = 0;
+  vkr_mutex_create(&test_allocator, &count_mutex);
+  event_manager_subscribe(&manager, EVENT_TYPE_KEY_PRESS, counting_callback,
+                          NULL);
 
   // Fill the queue
-  bool32_t queue_full = false;
+  uint32_t accepted = 0;
   for (uint32_t i = 0; i < 2000; i++) {
-    TestEventData *data =
-        arena_alloc(arena, sizeof(TestEventData), ARENA_MEMORY_TAG_UNKNOWN);
-    data->value = i;
-    data->processed = false;
-
+    TestEventData data = {.value = i, .processed = false};
     Event event = {.type = EVENT_TYPE_KEY_PRESS,
-                   .data = data,
+                   .data = &data,
                    .data_size = sizeof(TestEventData)};
-
-    bool32_t dispatch_result = false;
-    vkr_mutex_lock(manager.mutex);
-    dispatch_result = queue_enqueue_Event(&manager.queue, event);
-    vkr_mutex_unlock(manager.mutex);
-
-    if (!dispatch_result) {
-      queue_full = true;
+    if (!event_manager_dispatch(&manager, event)) {
       break;
     }
+    accepted++;
   }
 
-  assert(queue_full && "Queue should become full after many events");
+  assert(accepted == config.queue_capacity &&
+         "Queue should become full at its capacity");
+  assert(processed_count == 0 && "Manual mode must not dispatch on its own");
 
-  // Manually clean up resources
-  vkr_mutex_destroy(&manager.allocator, &manager.mutex);
-  vkr_cond_destroy(&manager.allocator, &manager.cond);
-
-  for (uint16_t i = 0; i < EVENT_TYPE_MAX; i++) {
-    if (manager.callbacks[i].data != NULL) {
-      vector_destroy_EventCallbackData(&manager.callbacks[i]);
-    }
-  }
+  // Draining frees every slot again.
+  assert(event_manager_pump(&manager) == accepted);
+  assert(processed_count == accepted);
+  TestEventData data = {.value = 0, .processed = false};
+  assert(event_manager_dispatch(&manager,
+                                (Event){.type = EVENT_TYPE_KEY_PRESS,
+                                        .data = &data,
+                                        .data_size = sizeof(TestEventData)}) &&
+         "Dispatch should succeed once the queue has drained");
 
+  event_manager_destroy(&manager);
+  assert(processed_count == accepted + 1 &&
+         "Destroy should dispatch events still queued in manual mode");
+  vkr_mutex_destroy(&test_allocator, &count_mutex);
   teardown_suite();
   printf("  test_queue_full PASSED\n");
 }
@@ -826,6 +815,172 @@ static void test_data_lifetime_original_freed(void) {
   printf("  test_data_lifetime_original_freed PASSED\n");
 }
 
+// --- Ring, batching and manual pump tests ---
+
+typedef struct LargeEventData {
+  uint32_t value;
+  uint8_t filler[200]; // Larger than EVENT_INLINE_PAYLOAD_SIZE
+} LargeEventData;
+
+static bool8_t mixed_order_callback(Event *event, UserData user_data) {
+  (void)user_data;
+  const uint32_t value = *(const uint32_t *)event->data;
+  if (event->data_size == sizeof(LargeEventData)) {
+    const LargeEventData *large = (const LargeEventData *)event->data;
+    for (uint32_t i = 0; i < sizeof(large->filler); ++i) {
+      assert(large->filler[i] == (uint8_t)value && "Large payload corrupted");
+    }
+  }
+  test_process_order[test_next_index++] = value;
+  return true;
+}
+
+static EventManager create_manual_manager(uint32_t capacity) {
+  EventManager manager;
+  EventManagerConfig config = event_manager_config_default();
+  config.mode = EVENT_DISPATCH_MODE_MANUAL;
+  config.queue_capacity = capacity;
+  assert(event_manager_create_with_config(&manager, &config));
+  return manager;
+}
+
+static void test_manual_pump_dispatches_in_order(void) {
+  printf("  Running test_manual_pump_dispatches_in_order...\n");
+  setup_suite();
+
+  EventManager manager = create_manual_manager(256);
+  const uint32_t EVENT_COUNT = 200; // Spans several batches.
+  test_process_order = arena_alloc(arena, sizeof(uint32_t) * EVENT_COUNT,
+                                   ARENA_MEMORY_TAG_UNKNOWN);
+  test_next_index = 0;
+  event_manager_subscribe(&manager, EVENT_TYPE_KEY_PRESS, mixed_order_callback,
+                          NULL);
+  event_manager_subscribe(&manager, EVENT_TYPE_MOUSE_MOVE,
+                          mixed_order_callback, NULL);
+
+  // Interleave types and inline/out-of-line payloads; delivery must follow
+  // dispatch order regardless.
+  for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+    if (i % 3 == 0) {
+      LargeEventData large = {.value = i};
+      MemSet(large.filler, (uint8_t)i, sizeof(large.filler));
+      assert(event_manager_dispatch(
+          &manager, (Event){.type = EVENT_TYPE_MOUSE_MOVE,
+                            .data = &large,
+                            .data_size = sizeof(LargeEventData)}));
+    } else {
+      TestEventData small = {.value = i, .processed = false};
+      assert(event_manager_dispatch(
+          &manager, (Event){.type = EVENT_TYPE_KEY_PRESS,
+                            .data = &small,
+                            .data_size = sizeof(TestEventData)}));
+    }
+  }
+
+  assert(test_next_index == 0 && "Nothing runs before the pump");
+  assert(event_manager_pump(&manager) == EVENT_COUNT);
+  assert(test_next_index == EVENT_COUNT);
+  for (uint32_t i = 0; i < EVENT_COUNT; i++) {
+    assert(test_process_order[i] == i &&
+           "Events should be processed in dispatch order");
+  }
+  assert(manager.event_data_buf.fill == 0 &&
+         "Out-of-line payloads should be released after dispatch");
+  assert(event_manager_pump(&manager) == 0);
+
+  event_manager_destroy(&manager);
+  teardown_suite();
+  printf("  test_manual_pump_dispatches_in_order PASSED\n");
+}
+
+static void test_unsubscribe_within_batch(void) {
+  printf("  Running test_unsubscribe_within_batch...\n");
+  setup_suite();
+
+  EventManager manager = create_manual_manager(64);
+  callback1_count = 0;
+  callback2_count = 0;
+  self_unsubscribe_manager = &manager;
+  event_manager_subscribe(&manager, EVENT_TYPE_KEY_PRESS,
+                          self_unsubscribe_callback, NULL);
+  event_manager_subscribe(&manager, EVENT_TYPE_KEY_PRESS, persistent_callback,
+                          NULL);
+
+  // All five events land in one batch, so the callback snapshot taken for the
+  // batch must be refreshed after the first callback unsubscribes itself.
+  for (uint32_t i = 0; i < 5; i++) {
+    assert(event_manager_dispatch(&manager,
+                                  (Event){.type = EVENT_TYPE_KEY_PRESS}));
+  }
+  assert(event_manager_pump(&manager) == 5);
+
+  assert(callback1_count == 1 &&
+         "Self-unsubscribing callback should only execute once");
+  assert(callback2_count == 5 &&
+         "Persistent callback should receive all events");
+
+  event_manager_destroy(&manager);
+  teardown_suite();
+  printf("  test_unsubscribe_within_batch PASSED\n");
+}
+
+typedef struct BulkEventData {
+  uint32_t value;
+  uint8_t filler[2044]; // 64 of these overflow the consumer scratch arena
+} BulkEventData;
+
+static bool8_t bulk_payload_callback(Event *event, UserData user_data) {
+  (void)user_data;
+  assert(event->data_size == sizeof(BulkEventData));
+  const BulkEventData *bulk = (const BulkEventData *)event->data;
+  for (uint32_t i = 0; i < sizeof(bulk->filler); ++i) {
+    assert(bulk->filler[i] == (uint8_t)(bulk->value * 7u + i) &&
+           "Bulk payload corrupted");
+  }
+  test_process_order[test_next_index++] = bulk->value;
+  return true;
+}
+
+static void test_full_batch_of_external_payloads(void) {
+  printf("  Running test_full_batch_of_external_payloads...\n");
+  setup_suite();
+
+  EventManager manager = create_manual_manager(EVENT_DISPATCH_BATCH_SIZE);
+  test_process_order = arena_alloc(
+      arena, sizeof(uint32_t) * EVENT_DISPATCH_BATCH_SIZE,
+      ARENA_MEMORY_TAG_UNKNOWN);
+  test_next_index = 0;
+  event_manager_subscribe(&manager, EVENT_TYPE_MOUSE_MOVE,
+                          bulk_payload_callback, NULL);
+
+  // A full batch of out-of-line payloads, 128 KB in total: the data buffer
+  // takes all of them, so none may be dropped on the consumer side.
+  for (uint32_t i = 0; i < EVENT_DISPATCH_BATCH_SIZE; i++) {
+    BulkEventData bulk = {.value = i};
+    for (uint32_t b = 0; b < sizeof(bulk.filler); ++b) {
+      bulk.filler[b] = (uint8_t)(i * 7u + b);
+    }
+    assert(event_manager_dispatch(
+        &manager, (Event){.type = EVENT_TYPE_MOUSE_MOVE,
+                          .data = &bulk,
+                          .data_size = sizeof(BulkEventData)}));
+  }
+
+  assert(event_manager_pump(&manager) == EVENT_DISPATCH_BATCH_SIZE);
+  assert(test_next_index == EVENT_DISPATCH_BATCH_SIZE &&
+         "Every large payload should be delivered");
+  for (uint32_t i = 0; i < EVENT_DISPATCH_BATCH_SIZE; i++) {
+    assert(test_process_order[i] == i &&
+           "Events should be processed in dispatch order");
+  }
+  assert(manager.event_data_buf.fill == 0 &&
+         "Out-of-line payloads should be released after dispatch");
+
+  event_manager_destroy(&manager);
+  teardown_suite();
+  printf("  test_full_batch_of_external_payloads PASSED\n");
+}
+
 // Run all event system tests
 bool32_t run_event_tests() {
   printf("--- Running Event System tests... ---\n");
@@ -842,6 +997,9 @@ bool32_t run_event_tests() {
   test_data_copying_original_integrity();
   test_dispatch_data_size_zero();
   test_data_lifetime_original_freed();
+  test_manual_pump_dispatches_in_order();
+  test_unsubscribe_within_batch();
+  test_full_batch_of_external_payloads();
   printf("--- Event System tests completed. ---\n");
   return true;
 }
@@ -123,6 +123,9 @@ static void test_harness_case_parser(void) {
   assert(vkr_harness_renderer_backend_resolve(&unpinned_renderer, "vulkan",
                                               &resolved_backend));
   assert(resolved_backend == VKR_RENDERER_BACKEND_TYPE_VULKAN);
+  assert(vkr_harness_renderer_backend_resolve(&unpinned_renderer, "null",
+                                              &resolved_backend));
+  assert(resolved_backend == VKR_RENDERER_BACKEND_TYPE_NULL);
   char invalid_backend[2048];
   snprintf(invalid_backend, sizeof(invalid_backend), "%s", metal_case);
   char *metal_value = strstr(invalid_backend, "\"metal\"");
@@ -1006,6 +1009,399 @@ static void test_harness_comparison_algorithms(void) {
   printf("  test_harness_comparison_algorithms PASSED\n");
 }
 
+/** A smooth gradient with a little texture, so every metric has structure. */
+static void harness_test_image(uint8_t *rgba, uint32_t width, uint32_t height,
+                               uint32_t seed) {
+  uint32_t state = seed;
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      state = state * 1664525u + 1013904223u;
+      uint8_t *pixel = rgba + ((uint64_t)y * width + x) * 4u;
+      pixel[0] = (uint8_t)((x * 255u) / Max(width - 1u, 1u));
+      pixel[1] = (uint8_t)((y * 255u) / Max(height - 1u, 1u));
+      pixel[2] = (uint8_t)(((x / 8u + y / 8u) % 2u) * 96u + (state >> 28u));
+      pixel[3] = 255u;
+    }
+  }
+}
+
+/** Perturbs every channel of every `stride`-th pixel by up to +-amplitude. */
+static void harness_test_image_noise(uint8_t *rgba, uint64_t pixel_count,
+                                     uint32_t stride, int32_t amplitude,
+                                     uint32_t seed) {
+  uint32_t state = seed;
+  for (uint64_t pixel = 0; pixel < pixel_count; pixel += stride) {
+    for (uint32_t c = 0; c < 3u; ++c) {
+      state = state * 1664525u + 1013904223u;
+      const int32_t delta =
+          (int32_t)(state >> 16u) % (2 * amplitude + 1) - amplitude;
+      const int32_t value = (int32_t)rgba[pixel * 4u + c] + delta;
+      rgba[pixel * 4u + c] = (uint8_t)Clamp(value, 0, 255);
+    }
+  }
+}
+
+static void harness_test_same_raw_result(VkrHarnessComparisonResult tiled,
+                                         VkrHarnessComparisonResult scalar) {
+  assert(tiled.outcome == scalar.outcome);
+  assert(tiled.failing_value_count == scalar.failing_value_count);
+  assert(tiled.failing_pixel_count == scalar.failing_pixel_count);
+  assert(tiled.value_count == scalar.value_count);
+  assert(tiled.max_absolute_error == scalar.max_absolute_error);
+  assert(fabs(tiled.mean_absolute_error - scalar.mean_absolute_error) < 1e-12);
+}
+
+static void test_harness_image_comparison(void) {
+  printf("  Running test_harness_image_comparison...\n");
+  Arena *arena = arena_create();
+  assert(arena);
+  /* Neither dimension is a multiple of the tile or the SIMD width. */
+  enum { kWidth = 101, kHeight = 70 };
+  const uint64_t pixels = (uint64_t)kWidth * kHeight;
+  uint8_t *baseline = malloc(pixels * 4u);
+  uint8_t *actual = malloc(pixels * 4u);
+  uint8_t *diff = malloc(pixels * 4u);
+  uint8_t *scalar_diff = malloc(pixels * 4u);
+  assert(baseline && actual && diff && scalar_diff);
+  harness_test_image(baseline, kWidth, kHeight, 7u);
+  memcpy(actual, baseline, pixels * 4u);
+  const VkrHarnessCompareConfig thresholds = {
+      .max_pixel_delta = 0.02,
+      .max_mean_absolute_error = 0.01,
+      .max_failed_pixel_ratio = 0.01,
+  };
+  VkrHarnessImageCompareDesc desc = {
+      .actual = actual,
+      .baseline = baseline,
+      .width = kWidth,
+      .height = kHeight,
+      .config = &thresholds,
+  };
+  VkrHarnessImageQuality quality = {0};
+  VkrHarnessComparisonResult result =
+      vkr_harness_compare_image_rgba8(&desc, arena, &quality);
+  assert(result.outcome == VKR_HARNESS_COMPARISON_PASS);
+  assert(quality.measured && !quality.identical);
+  assert(quality.psnr_db == VKR_HARNESS_PSNR_MAX_DB);
+  assert(fabs(quality.ssim - 1.0) < 1e-9 && fabs(quality.ms_ssim - 1.0) < 1e-9);
+  assert(quality.flip_mean == 0.0 && quality.flip_max == 0.0);
+  assert(quality.tiles_x == 4u && quality.tiles_y == 3u);
+
+  /* A uniform +10 on RGB is an MSE of exactly 100. */
+  for (uint64_t i = 0; i < pixels; ++i) {
+    for (uint32_t c = 0; c < 3u; ++c) {
+      actual[i * 4u + c] = (uint8_t)Min(baseline[i * 4u + c] + 10u, 255u);
+      baseline[i * 4u + c] = (uint8_t)Min(baseline[i * 4u + c], 245u);
+    }
+  }
+  result = vkr_harness_compare_image_rgba8(&desc, arena, &quality);
+  assert(fabs(quality.psnr_db - 10.0 * log10(255.0 * 255.0 / 100.0)) < 1e-6);
+  assert(quality.flip_mean > 0.0 && quality.flip_mean < 0.4);
+
+  harness_test_image(baseline, kWidth, kHeight, 7u);
+  memcpy(actual, baseline, pixels * 4u);
+  harness_test_image_noise(actual, pixels, 3u, 12, 99u);
+  actual[5u * 4u] = (uint8_t)(baseline[5u * 4u] ^ 0x80u);
+  desc.diff_rgba = diff;
+  result = vkr_harness_compare_image_rgba8(&desc, arena, &quality);
+  harness_test_same_raw_result(
+      result, vkr_harness_compare_rgba8(actual, baseline, pixels, &thresholds,
+                                        scalar_diff));
+  assert(result.outcome == VKR_HARNESS_COMPARISON_FAIL);
+  assert(memcmp(diff, scalar_diff, pixels * 4u) == 0);
+  assert(quality.psnr_db > 20.0 && quality.psnr_db < 50.0);
+  assert(quality.ssim < 1.0 && quality.ssim > 0.3);
+  assert(quality.ms_ssim < 1.0 && quality.ms_ssim > 0.0);
+  assert(quality.flip_mean > 0.0 && quality.flip_max <= 1.0);
+
+  /* Workers change neither statistics nor any bit of the outputs. */
+  uint8_t heatmap[4u * 3u * 4u];
+  uint8_t parallel_heatmap[sizeof(heatmap)];
+  desc.heatmap_rgba = heatmap;
+  const VkrHarnessComparisonResult inline_result =
+      vkr_harness_compare_image_rgba8(&desc, arena, &quality);
+  const VkrHarnessImageQuality inline_quality = quality;
+  VkrJobSystemConfig config = vkr_job_system_config_default();
+  config.worker_count = 3u;
+  VkrJobSystem jobs = {0};
+  assert(vkr_job_system_init(&config, &jobs));
+  desc.job_system = &jobs;
+  desc.heatmap_rgba = parallel_heatmap;
+  result = vkr_harness_compare_image_rgba8(&desc, arena, &quality);
+  assert(memcmp(&result, &inline_result, sizeof(result)) == 0);
+  assert(memcmp(&quality, &inline_quality, sizeof(quality)) == 0);
+  assert(memcmp(heatmap, parallel_heatmap, sizeof(heatmap)) == 0);
+
+  uint8_t *depth = malloc(pixels * 4u);
+  uint8_t *depth_baseline = malloc(pixels * 4u);
+  assert(depth && depth_baseline);
+  for (uint64_t i = 0; i < pixels; ++i) {
+    harness_test_write_f32_le(depth_baseline + i * 4u, (float32_t)i / pixels);
+    harness_test_write_f32_le(depth + i * 4u,
+                              (float32_t)i / pixels + (i % 7u ? 0.0f : 0.05f));
+  }
+  desc.actual = depth;
+  desc.baseline = depth_baseline;
+  harness_test_same_raw_result(
+      vkr_harness_compare_image_f32_le(&desc, arena),
+      vkr_harness_compare_f32_le(depth, depth_baseline, pixels, &thresholds,
+                                 scalar_diff));
+  assert(memcmp(diff, scalar_diff, pixels * 4u) == 0);
+  harness_test_write_f32_le(depth + 4000u * 4u, NAN);
+  assert(vkr_harness_compare_image_f32_le(&desc, arena).outcome ==
+         VKR_HARNESS_COMPARISON_INCOMPATIBLE);
+  vkr_job_system_shutdown(&jobs);
+
+  vkr_harness_image_quality_identical(kWidth, kHeight, &quality);
+  assert(quality.identical && quality.ssim == 1.0 && quality.tiles_y == 3u);
+  free(depth_baseline);
+  free(depth);
+  free(scalar_diff);
+  free(diff);
+  free(actual);
+  free(baseline);
+  arena_destroy(arena);
+  printf("  test_harness_image_comparison PASSED\n");
+}
+
+/**
+ * Several tiles in each direction, none of them full at the edges: the tiled
+ * comparison, with and without workers and perceptual metrics, must agree
+ * with the scalar loop on every statistic. Timings live in `vkr_bench`.
+ */
+static void test_harness_image_comparison_matches_scalar(void) {
+  printf("  Running test_harness_image_comparison_matches_scalar...\n");
+  Arena *arena = arena_create();
+  assert(arena);
+  enum { kWidth = 517, kHeight = 263 };
+  const uint64_t pixels = (uint64_t)kWidth * kHeight;
+  uint8_t *baseline = malloc(pixels * 4u);
+  uint8_t *actual = malloc(pixels * 4u);
+  uint32_t tiles_x = 0u, tiles_y = 0u;
+  vkr_harness_image_tiles(kWidth, kHeight, &tiles_x, &tiles_y);
+  uint8_t *heatmap = malloc((uint64_t)tiles_x * tiles_y * 4u);
+  assert(baseline && actual && heatmap);
+  harness_test_image(baseline, kWidth, kHeight, 3u);
+  memcpy(actual, baseline, pixels * 4u);
+  harness_test_image_noise(actual, pixels, 17u, 6, 5u);
+  const VkrHarnessCompareConfig thresholds = {
+      .max_pixel_delta = 0.02,
+      .max_mean_absolute_error = 0.01,
+      .max_failed_pixel_ratio = 0.01,
+  };
+  const VkrHarnessComparisonResult scalar =
+      vkr_harness_compare_rgba8(actual, baseline, pixels, &thresholds, NULL);
+  assert(scalar.failing_pixel_count > 0u);
+
+  VkrHarnessImageCompareDesc desc = {
+      .actual = actual,
+      .baseline = baseline,
+      .width = kWidth,
+      .height = kHeight,
+      .config = &thresholds,
+  };
+  harness_test_same_raw_result(
+      vkr_harness_compare_image_rgba8(&desc, arena, NULL), scalar);
+
+  VkrJobSystemConfig config = vkr_job_system_config_default();
+  config.worker_count = 3u;
+  VkrJobSystem jobs = {0};
+  assert(vkr_job_system_init(&config, &jobs));
+  desc.job_system = &jobs;
+  harness_test_same_raw_result(
+      vkr_harness_compare_image_rgba8(&desc, arena, NULL), scalar);
+
+  VkrHarnessImageQuality quality = {0};
+  desc.heatmap_rgba = heatmap;
+  harness_test_same_raw_result(
+      vkr_harness_compare_image_rgba8(&desc, arena, &quality), scalar);
+  assert(quality.measured && quality.tiles_x == tiles_x &&
+         quality.tiles_y == tiles_y);
+  assert(quality.psnr_db > 30.0 && quality.ssim < 1.0 &&
+         quality.flip_mean > 0.0);
+  vkr_job_system_shutdown(&jobs);
+
+  free(heatmap);
+  free(actual);
+  free(baseline);
+  arena_destroy(arena);
+  printf("  test_harness_image_comparison_matches_scalar PASSED\n");
+}
+
+/** Deterministic approximately normal noise: a centered sum of uniforms. */
+static float64_t harness_test_noise(uint64_t *state) {
+  float64_t sum = 0.0;
+  for (uint32_t i = 0; i < 12u; ++i) {
+    *state = *state * 6364136223846793005ull + 1442695040888963407ull;
+    sum += (float64_t)(*state >> 11u) / (float64_t)(1ull << 53u);
+  }
+  return sum - 6.0;
+}
+
+static void harness_test_fill(float64_t *values, uint64_t count,
+                              float64_t level, float64_t sigma,
+                              uint64_t seed) {
+  uint64_t state = seed;
+  for (uint64_t i = 0; i < count; ++i) {
+    values[i] = level + sigma * harness_test_noise(&state);
+  }
+}
+
+static VkrHarnessRegressionResult
+harness_test_regression(const float64_t *baseline, const float64_t *candidate,
+                        uint64_t count, const VkrHarnessRegressionConfig *config,
+                        Arena *arena) {
+  /* Two repetitions per side, so warmup is trimmed per repetition. */
+  const uint64_t lengths[] = {count / 2u, count - count / 2u};
+  const VkrHarnessSampleStream base = {
+      .values = baseline,
+      .repetition_lengths = lengths,
+      .repetition_count = ArrayCount(lengths),
+  };
+  const VkrHarnessSampleStream cand = {
+      .values = candidate,
+      .repetition_lengths = lengths,
+      .repetition_count = ArrayCount(lengths),
+  };
+  VkrHarnessRegressionResult result = {0};
+  assert(vkr_harness_regression_compare(&base, &cand, config, arena, &result));
+  return result;
+}
+
+static void test_harness_regression_primitives(void) {
+  printf("  Running test_harness_regression_primitives...\n");
+  Arena *arena = arena_create();
+  assert(arena);
+  float64_t series[512];
+  harness_test_fill(series, 200u, 10.0, 0.1, 1u);
+  for (uint32_t i = 0; i < 40u; ++i) {
+    series[i] += 8.0 * (float64_t)(40u - i) / 40.0;
+  }
+  const uint64_t warmup = vkr_harness_warmup_length(series, 200u, 5u);
+  assert(warmup >= 30u && warmup <= 50u);
+  harness_test_fill(series, 200u, 10.0, 0.1, 2u);
+  assert(vkr_harness_warmup_length(series, 200u, 5u) <= 20u);
+
+  float64_t scratch[512];
+  harness_test_fill(series, 100u, 10.0, 0.1, 3u);
+  series[10] = 100.0;
+  series[50] = -50.0;
+  series[99] = 40.0;
+  assert(vkr_harness_reject_outliers(series, 100u, 3.5, scratch) == 97u);
+  for (uint32_t i = 0; i < 97u; ++i) {
+    assert(series[i] > 9.0 && series[i] < 11.0);
+  }
+  for (uint32_t i = 0; i < 10u; ++i) {
+    series[i] = 4.0;
+  }
+  /* No spread at all: nothing can be called an outlier. */
+  assert(vkr_harness_reject_outliers(series, 10u, 3.5, scratch) == 10u);
+
+  uint64_t points[VKR_HARNESS_MAX_CHANGE_POINTS];
+  harness_test_fill(series, 512u, 10.0, 0.2, 4u);
+  assert(vkr_harness_change_points(series, 512u, 16u, 0.02, arena, points) ==
+         0u);
+  for (uint32_t i = 256u; i < 512u; ++i) {
+    series[i] += 2.0;
+  }
+  assert(vkr_harness_change_points(series, 512u, 16u, 0.02, arena, points) ==
+         1u);
+  assert(points[0] == 256u);
+
+  const float64_t low[] = {1.0, 2.0, 3.0, 4.0};
+  const float64_t high[] = {5.0, 6.0, 7.0, 8.0};
+  float64_t u = 0.0, z = 0.0, p = 0.0;
+  assert(vkr_harness_mann_whitney(low, 4u, high, 4u, arena, &u, &z, &p));
+  assert(u == 16.0 && z > 0.0 && p < 0.05);
+  assert(vkr_harness_mann_whitney(low, 4u, low, 4u, arena, &u, &z, &p));
+  assert(u == 8.0 && p == 1.0);
+  float64_t statistic = 0.0;
+  vkr_harness_kolmogorov_smirnov(low, 4u, high, 4u, &statistic, &p);
+  assert(statistic == 1.0);
+  vkr_harness_kolmogorov_smirnov(low, 4u, low, 4u, &statistic, &p);
+  assert(statistic == 0.0 && p == 1.0);
+  arena_destroy(arena);
+  printf("  test_harness_regression_primitives PASSED\n");
+}
+
+static void test_harness_regression_verdicts(void) {
+  printf("  Running test_harness_regression_verdicts...\n");
+  Arena *arena = arena_create();
+  assert(arena);
+  enum { kCount = 1200 };
+  float64_t *baseline = malloc(kCount * sizeof(*baseline));
+  float64_t *candidate = malloc(kCount * sizeof(*candidate));
+  assert(baseline && candidate);
+  VkrHarnessRegressionConfig config = vkr_harness_regression_config_default();
+  config.bootstrap_iterations = 500u;
+  harness_test_fill(baseline, kCount, 10.0, 0.2, 11u);
+
+  harness_test_fill(candidate, kCount, 10.0, 0.2, 12u);
+  VkrHarnessRegressionResult result =
+      harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_INCONCLUSIVE);
+  assert(strcmp(result.reason, "not_significant") == 0);
+  assert(result.p50_delta.lower <= 0.0 && result.p50_delta.upper >= 0.0);
+  assert(result.baseline.sample_count + result.baseline.warmup_trimmed ==
+         kCount);
+
+  harness_test_fill(candidate, kCount, 10.5, 0.2, 13u);
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_REGRESSED);
+  assert(strcmp(result.reason, "p50") == 0);
+  assert(result.relative_defined && result.p50_relative.estimate > 0.04 &&
+         result.p50_relative.estimate < 0.06);
+  assert(result.p50_delta.lower > 0.0 && result.cliffs_delta > 0.9);
+  /* The same samples read as throughput are an improvement. */
+  config.lower_is_better = false_v;
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_IMPROVED);
+  config.lower_is_better = true_v;
+
+  /* Significant but smaller than the minimum effect. */
+  harness_test_fill(candidate, kCount, 10.1, 0.2, 14u);
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_INCONCLUSIVE);
+  assert(result.mann_whitney_p < config.alpha);
+
+  /* Stalls in one frame of ten: the median holds, the tail does not. Outlier
+     rejection must not hide them from the p95 judgement. */
+  harness_test_fill(candidate, kCount, 10.0, 0.2, 15u);
+  for (uint32_t i = 5u; i < kCount; i += 10u) {
+    candidate[i] += 4.0;
+  }
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_REGRESSED);
+  assert(strcmp(result.reason, "p95") == 0);
+  assert(result.candidate.outliers_rejected >= kCount / 10u - 10u);
+
+  harness_test_fill(candidate, kCount, 9.0, 0.2, 16u);
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_IMPROVED);
+  const VkrHarnessRegressionResult first = result;
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.p50_delta.lower == first.p50_delta.lower &&
+         result.p95_delta.upper == first.p95_delta.upper);
+
+  /* A level shift inside the candidate stream is never judged. */
+  harness_test_fill(candidate, kCount, 10.0, 0.2, 17u);
+  for (uint32_t i = kCount / 4u; i < kCount / 2u; ++i) {
+    candidate[i] += 3.0;
+  }
+  result = harness_test_regression(baseline, candidate, kCount, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_INCONCLUSIVE);
+  assert(strcmp(result.reason, "stream.change_point") == 0);
+  assert(result.candidate.change_point_count > 0u);
+
+  result = harness_test_regression(baseline, candidate, 16u, &config, arena);
+  assert(result.verdict == VKR_HARNESS_REGRESSION_INCONCLUSIVE);
+  assert(strcmp(result.reason, "samples.insufficient") == 0);
+  free(candidate);
+  free(baseline);
+  arena_destroy(arena);
+  printf("  test_harness_regression_verdicts PASSED\n");
+}
+
 #if !defined(_WIN32)
 static bool8_t harness_remove_tree(const char *path) {
   struct stat status;
@@ -1181,6 +1577,10 @@ bool32_t run_harness_tests(void) {
   test_harness_capture_catalog_and_converters();
   test_harness_capture_replays();
   test_harness_comparison_algorithms();
+  test_harness_image_comparison();
+  test_harness_image_comparison_matches_scalar();
+  test_harness_regression_primitives();
+  test_harness_regression_verdicts();
   test_harness_guarded_baseline_accept();
   printf("--- Harness tests completed. ---\n");
   return true;
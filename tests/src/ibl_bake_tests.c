@@ -0,0 +1,337 @@
+#include "ibl_bake_tests.h"
+
+#include "core/vkr_job_system.h"
+#include "filesystem/filesystem.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+#include "platform/vkr_platform.h"
+#include "renderer/vkr_ibl_bake.h"
+#include "renderer/vkr_ibl_math.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#define IBL_BAKE_TEST_CACHE_PATH "tests/tmp/ibl_bake/probe.vkib"
+
+static bool32_t ibl_bake_test_near(Vec4 actual, Vec3 expected,
+                                   float32_t tolerance) {
+  return fabsf(actual.x - expected.x) <= tolerance &&
+                 fabsf(actual.y - expected.y) <= tolerance &&
+                 fabsf(actual.z - expected.z) <= tolerance
+             ? true_v
+             : false_v;
+}
+
+/** Fills mip 0 with `radiance(direction)` and builds the other mips. */
+static void ibl_bake_test_fill(VkrIblCube *cube,
+                               Vec3 (*radiance)(Vec3 direction)) {
+  const uint32_t size = cube->face_size;
+  for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+    Vec4 *texels = vkr_ibl_cube_face(cube, 0u, face);
+    for (uint32_t y = 0u; y < size; ++y) {
+      for (uint32_t x = 0u; x < size; ++x) {
+        const VkrIblDirection d = vkr_ibl_cube_face_uv_to_direction(
+            (VkrIblCubeFace)face,
+            (VkrIblUv){((float32_t)x + 0.5f) / (float32_t)size,
+                       ((float32_t)y + 0.5f) / (float32_t)size});
+        const Vec3 value = radiance(vec3_normalize(vec3_new(d.x, d.y, d.z)));
+        texels[y * size + x] = vec4_new(value.x, value.y, value.z, 1.0f);
+      }
+    }
+  }
+  vkr_ibl_bake_build_mips(cube);
+}
+
+/** Band-1 sky: exactly representable by SH9. */
+static Vec3 ibl_bake_test_sky(Vec3 direction) {
+  return vec3_new(1.0f + direction.y, 0.5f + 0.25f * direction.x,
+                  2.0f - direction.z);
+}
+
+static Vec3 ibl_bake_test_stripes(Vec3 direction) {
+  const float32_t band = direction.y > 0.3f ? 4.0f : 0.25f;
+  return vec3_new(band, 0.5f + 0.5f * direction.x, 1.0f);
+}
+
+/** Scalar transcription of the GPU ibl_prefilter pass for one texel. */
+static Vec3 ibl_bake_test_reference_prefilter(const VkrIblCube *source,
+                                              Vec3 normal, float32_t roughness,
+                                              uint32_t sample_count) {
+  const Vec3 up = fabsf(normal.z) < 0.999f ? vec3_new(0.0f, 0.0f, 1.0f)
+                                           : vec3_new(1.0f, 0.0f, 0.0f);
+  const Vec3 tangent = vec3_normalize(vec3_cross(up, normal));
+  const Vec3 bitangent = vec3_cross(normal, tangent);
+  const float32_t alpha = roughness * roughness;
+  Vec3 color = vec3_zero();
+  float32_t total_weight = 0.0f;
+  for (uint32_t i = 0u; i < sample_count; ++i) {
+    uint32_t bits = i;
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    const float32_t xi_x = (float32_t)i / (float32_t)sample_count;
+    const float32_t xi_y = (float32_t)bits * 2.3283064365386963e-10f;
+    const float32_t phi = 2.0f * VKR_PI * xi_x;
+    const float32_t cos_theta =
+        sqrtf((1.0f - xi_y) / (1.0f + (alpha * alpha - 1.0f) * xi_y));
+    const float32_t sin_theta = sqrtf(fmaxf(1.0f - cos_theta * cos_theta, 0));
+    const Vec3 half_vector = vec3_normalize(vec3_add(
+        vec3_add(vec3_scale(tangent, cosf(phi) * sin_theta),
+                 vec3_scale(bitangent, sinf(phi) * sin_theta)),
+        vec3_scale(normal, cos_theta)));
+    const Vec3 light = vec3_normalize(vec3_sub(
+        vec3_scale(half_vector, 2.0f * vec3_dot(normal, half_vector)),
+        normal));
+    const float32_t no_l = fmaxf(vec3_dot(normal, light), 0.0f);
+    if (no_l <= 0.0f) {
+      continue;
+    }
+    const float32_t no_h = fmaxf(vec3_dot(normal, half_vector), 1e-6f);
+    const float32_t lod = vkr_ibl_prefilter_source_lod(
+        no_h, no_h, roughness, sample_count, source->face_size,
+        source->mip_count);
+    const Vec4 texel = vkr_ibl_cube_sample(source, light, lod);
+    color = vec3_add(color, vec3_scale(vec3_new(texel.x, texel.y, texel.z),
+                                       no_l));
+    total_weight += no_l;
+  }
+  return vec3_scale(color, 1.0f / fmaxf(total_weight, 1e-4f));
+}
+
+static void test_ibl_bake_equirect_to_cube(void) {
+  printf("  Running test_ibl_bake_equirect_to_cube...\n");
+  Arena *arena = arena_create(MB(8), MB(8));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  // Each equirect texel stores its own direction, so every cube texel should
+  // come back holding (nearly) the direction it was resampled along.
+  const uint32_t width = 256u;
+  const uint32_t height = 128u;
+  float32_t *rgba = vkr_allocator_alloc(
+      &allocator, sizeof(float32_t) * 4u * width * height,
+      VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  for (uint32_t y = 0u; y < height; ++y) {
+    for (uint32_t x = 0u; x < width; ++x) {
+      const VkrIblDirection d = vkr_ibl_equirect_uv_to_direction(
+          (VkrIblUv){((float32_t)x + 0.5f) / (float32_t)width,
+                     ((float32_t)y + 0.5f) / (float32_t)height});
+      float32_t *texel = rgba + ((uint64_t)y * width + x) * 4u;
+      texel[0] = d.x;
+      texel[1] = d.y;
+      texel[2] = d.z;
+      texel[3] = 1.0f;
+    }
+  }
+
+  VkrIblCube cube;
+  assert(vkr_ibl_cube_create(&cube, &allocator, 16u, 99u));
+  assert(cube.mip_count == 5u);
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, NULL);
+  vkr_ibl_bake_equirect_to_cube(rgba, width, height, &cube, &dispatch);
+
+  for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+    const Vec4 *texels = vkr_ibl_cube_face(&cube, 0u, face);
+    for (uint32_t y = 0u; y < 16u; ++y) {
+      for (uint32_t x = 0u; x < 16u; ++x) {
+        const VkrIblDirection d = vkr_ibl_cube_face_uv_to_direction(
+            (VkrIblCubeFace)face, (VkrIblUv){((float32_t)x + 0.5f) / 16.0f,
+                                             ((float32_t)y + 0.5f) / 16.0f});
+        assert(ibl_bake_test_near(texels[y * 16u + x],
+                                  vec3_normalize(vec3_new(d.x, d.y, d.z)),
+                                  0.03f));
+      }
+    }
+  }
+  // The 1x1 mip averages each face toward its center direction.
+  for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+    const Vec4 texel = *vkr_ibl_cube_face(&cube, 4u, face);
+    const VkrIblDirection center = vkr_ibl_cube_face_uv_to_direction(
+        (VkrIblCubeFace)face, (VkrIblUv){0.5f, 0.5f});
+    assert(texel.x * center.x + texel.y * center.y + texel.z * center.z >
+           0.7f);
+  }
+
+  arena_destroy(arena);
+  printf("  test_ibl_bake_equirect_to_cube PASSED\n");
+}
+
+static void test_ibl_bake_sh9_irradiance(void) {
+  printf("  Running test_ibl_bake_sh9_irradiance...\n");
+  Arena *arena = arena_create(MB(4), MB(4));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrIblCube source;
+  assert(vkr_ibl_cube_create(&source, &allocator, 32u, 1u));
+  ibl_bake_test_fill(&source, ibl_bake_test_sky);
+  const VkrIblSh9 sh = vkr_ibl_bake_project_sh9(&source, 0u);
+
+  // For L(d) = a + b.d the cosine-weighted mean around n is a + (2/3) b.n.
+  static const Vec3 k_normals[] = {
+      {.x = 0.0f, .y = 1.0f, .z = 0.0f},  {.x = 0.0f, .y = -1.0f, .z = 0.0f},
+      {.x = 1.0f, .y = 0.0f, .z = 0.0f},  {.x = 0.0f, .y = 0.0f, .z = 1.0f},
+      {.x = 0.6f, .y = 0.0f, .z = -0.8f},
+  };
+  for (uint32_t i = 0u; i < ArrayCount(k_normals); ++i) {
+    const Vec3 n = k_normals[i];
+    const Vec3 expected =
+        vec3_new(1.0f + (2.0f / 3.0f) * n.y, 0.5f + (0.5f / 3.0f) * n.x,
+                 2.0f - (2.0f / 3.0f) * n.z);
+    const Vec3 actual = vkr_ibl_sh9_irradiance(&sh, n);
+    assert(ibl_bake_test_near(vec4_new(actual.x, actual.y, actual.z, 0.0f),
+                              expected, 0.01f));
+  }
+
+  VkrIblCube irradiance;
+  assert(vkr_ibl_cube_create(&irradiance, &allocator, 8u, 1u));
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, NULL);
+  vkr_ibl_bake_irradiance(&sh, &irradiance, &dispatch);
+  const Vec4 up = vkr_ibl_cube_sample(&irradiance, vec3_new(0.0f, 1.0f, 0.0f),
+                                      0.0f);
+  assert(fabsf(up.x - 5.0f / 3.0f) < 0.03f && up.w == 1.0f);
+
+  arena_destroy(arena);
+  printf("  test_ibl_bake_sh9_irradiance PASSED\n");
+}
+
+static void test_ibl_bake_prefilter_matches_gpu_pass(void) {
+  printf("  Running test_ibl_bake_prefilter_matches_gpu_pass...\n");
+  Arena *arena = arena_create(MB(8), MB(8));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrIblCube source;
+  assert(vkr_ibl_cube_create(&source, &allocator, 32u, 6u));
+  ibl_bake_test_fill(&source, ibl_bake_test_stripes);
+  VkrIblCube serial;
+  assert(vkr_ibl_cube_create(&serial, &allocator, 16u, 5u));
+  VkrParallelFor serial_dispatch;
+  vkr_parallel_for_init(&serial_dispatch, NULL);
+  assert(vkr_ibl_bake_prefilter(&source, &serial, 64u, &allocator,
+                                &serial_dispatch));
+
+  for (uint32_t mip = 0u; mip < serial.mip_count; ++mip) {
+    const float32_t roughness = (float32_t)mip / 4.0f;
+    const uint32_t size = 16u >> mip;
+    for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+      const Vec4 *texels = vkr_ibl_cube_face(&serial, mip, face);
+      for (uint32_t y = 0u; y < size; y += 3u) {
+        for (uint32_t x = 0u; x < size; x += 3u) {
+          const VkrIblDirection d = vkr_ibl_cube_face_uv_to_direction(
+              (VkrIblCubeFace)face,
+              (VkrIblUv){((float32_t)x + 0.5f) / (float32_t)size,
+                         ((float32_t)y + 0.5f) / (float32_t)size});
+          const Vec3 normal = vec3_normalize(vec3_new(d.x, d.y, d.z));
+          const Vec3 expected =
+              mip == 0u ? vec4_to_vec3(vkr_ibl_cube_sample(&source, normal,
+                                                           0.0f))
+                        : ibl_bake_test_reference_prefilter(&source, normal,
+                                                            roughness, 64u);
+          assert(ibl_bake_test_near(texels[y * size + x], expected, 1e-3f));
+          assert(texels[y * size + x].w == 1.0f);
+        }
+      }
+    }
+  }
+
+  // Rows split across workers produce the same texels.
+  VkrParallelFor dispatch;
+  VkrJobSystem system;
+  VkrJobSystemConfig cfg = vkr_job_system_config_default();
+  cfg.worker_count = Max(2u, Min(4u, vkr_platform_get_logical_core_count()));
+  cfg.max_jobs = 16;
+  cfg.queue_capacity = 16;
+  assert(vkr_job_system_init(&cfg, &system) && "Job system init failed");
+  vkr_parallel_for_init(&dispatch, &system);
+  VkrIblCube parallel;
+  assert(vkr_ibl_cube_create(&parallel, &allocator, 16u, 5u));
+  assert(vkr_ibl_bake_prefilter(&source, &parallel, 64u, &allocator,
+                                &dispatch));
+  assert(MemCompare(serial.texels, parallel.texels,
+                    sizeof(Vec4) * vkr_ibl_cube_texel_count(16u, 5u)) == 0);
+
+  vkr_parallel_for_wait_idle(&dispatch);
+  vkr_job_system_shutdown(&system);
+  arena_destroy(arena);
+  printf("  test_ibl_bake_prefilter_matches_gpu_pass PASSED\n");
+}
+
+static void test_ibl_bake_cache_round_trip(void) {
+  printf("  Running test_ibl_bake_cache_round_trip...\n");
+  Arena *arena = arena_create(MB(4), MB(4));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrIblCube irradiance;
+  VkrIblCube prefilter;
+  assert(vkr_ibl_cube_create(&irradiance, &allocator, 4u, 1u));
+  assert(vkr_ibl_cube_create(&prefilter, &allocator, 8u, 4u));
+  ibl_bake_test_fill(&irradiance, ibl_bake_test_sky);
+  ibl_bake_test_fill(&prefilter, ibl_bake_test_stripes);
+
+  const float32_t source[8] = {1.0f, 2.0f, 3.0f, 1.0f,
+                               4.0f, 5.0f, 6.0f, 1.0f};
+  const uint64_t key =
+      vkr_ibl_bake_key(source, 2u, 1u, &irradiance, &prefilter, 64u);
+  assert(key != vkr_ibl_bake_key(source, 2u, 1u, &irradiance, &prefilter,
+                                 128u));
+  const float32_t edited[8] = {1.0f, 2.0f, 3.0f, 1.0f,
+                               4.0f, 5.0f, 6.5f, 1.0f};
+  assert(key !=
+         vkr_ibl_bake_key(edited, 2u, 1u, &irradiance, &prefilter, 64u));
+
+  const String8 path = string8_lit(IBL_BAKE_TEST_CACHE_PATH);
+  assert(vkr_ibl_bake_cache_write(&allocator, path, key, &irradiance,
+                                  &prefilter));
+
+  VkrIblCube irradiance_read;
+  VkrIblCube prefilter_read;
+  assert(vkr_ibl_cube_create(&irradiance_read, &allocator, 4u, 1u));
+  assert(vkr_ibl_cube_create(&prefilter_read, &allocator, 8u, 4u));
+  assert(vkr_ibl_bake_cache_read(&allocator, path, key, &irradiance_read,
+                                 &prefilter_read));
+  const uint64_t prefilter_texels = vkr_ibl_cube_texel_count(8u, 4u);
+  for (uint64_t i = 0u; i < prefilter_texels; ++i) {
+    for (uint32_t c = 0u; c < 4u; ++c) {
+      const float32_t stored = vkr_float16_to_float32(
+          vkr_float32_to_float16(prefilter.texels[i].elements[c]));
+      assert(prefilter_read.texels[i].elements[c] == stored);
+    }
+  }
+  assert(irradiance_read.texels[5].y ==
+         vkr_float16_to_float32(
+             vkr_float32_to_float16(irradiance.texels[5].y)));
+
+  // Another key, or cubes of another shape, miss.
+  assert(!vkr_ibl_bake_cache_read(&allocator, path, key + 1u,
+                                  &irradiance_read, &prefilter_read));
+  VkrIblCube prefilter_short;
+  assert(vkr_ibl_cube_create(&prefilter_short, &allocator, 8u, 3u));
+  assert(!vkr_ibl_bake_cache_read(&allocator, path, key, &irradiance_read,
+                                  &prefilter_short));
+  assert(!vkr_ibl_bake_cache_read(&allocator,
+                                  string8_lit("tests/tmp/ibl_bake/none.vkib"),
+                                  key, &irradiance_read, &prefilter_read));
+
+  FilePath file_path = file_path_create(IBL_BAKE_TEST_CACHE_PATH, &allocator,
+                                        FILE_PATH_TYPE_RELATIVE);
+  file_remove(&file_path);
+  arena_destroy(arena);
+  printf("  test_ibl_bake_cache_round_trip PASSED\n");
+}
+
+bool32_t run_ibl_bake_tests(void) {
+  printf("--- Running IBL bake tests... ---\n");
+  test_ibl_bake_equirect_to_cube();
+  test_ibl_bake_sh9_irradiance();
+  test_ibl_bake_prefilter_matches_gpu_pass();
+  test_ibl_bake_cache_round_trip();
+  printf("--- IBL bake tests completed. ---\n");
+  return true_v;
+}
@@ -1,5 +1,6 @@
 #include "ibl_math_tests.h"
 
+#include "renderer/systems/vkr_scene_system.h"
 #include "renderer/systems/vkr_world_resources.h"
 #include "renderer/vkr_ibl_math.h"
 
@@ -216,6 +217,31 @@ static bool32_t test_ibl_cube_face_convention(void) {
   return true_v;
 }
 
+static bool32_t test_ibl_cube_face_inverse_round_trip(void) {
+  printf("  Running test_ibl_cube_face_inverse_round_trip...\n");
+  for (uint32_t face = 0u; face < VKR_IBL_CUBE_FACE_COUNT; ++face) {
+    for (uint32_t i = 0u; i < 7u; ++i) {
+      for (uint32_t j = 0u; j < 7u; ++j) {
+        // Texel centers stay off the edges, where two faces tie.
+        const VkrIblUv uv = {((float32_t)i + 0.5f) / 7.0f,
+                             ((float32_t)j + 0.5f) / 7.0f};
+        VkrIblDirection direction =
+            vkr_ibl_cube_face_uv_to_direction((VkrIblCubeFace)face, uv);
+        direction.x *= 3.0f;
+        direction.y *= 3.0f;
+        direction.z *= 3.0f;
+        VkrIblUv round_trip = {0};
+        assert(vkr_ibl_direction_to_cube_face_uv(direction, &round_trip) ==
+               (VkrIblCubeFace)face);
+        assert(vkr_test_float_near(round_trip.u, uv.u, 1e-6f));
+        assert(vkr_test_float_near(round_trip.v, uv.v, 1e-6f));
+      }
+    }
+  }
+  printf("  test_ibl_cube_face_inverse_round_trip PASSED\n");
+  return true_v;
+}
+
 static bool32_t test_ibl_prefilter_source_lod(void) {
   printf("  Running test_ibl_prefilter_source_lod...\n");
   assert(vkr_ibl_prefilter_source_lod(1.0f, 1.0f, 0.0f, 1024u, 1024u, 11u) ==
@@ -260,6 +286,78 @@ static bool32_t test_local_probe_fragment_influence_and_draw_visibility(void) {
   return true_v;
 }
 
+static bool32_t test_local_probe_index_matches_brute_force(void) {
+  printf("  Running test_local_probe_index_matches_brute_force...\n");
+  static VkrScene scene;
+  MemZero(&scene, sizeof(scene));
+  scene.reflection_probe_count = VKR_SCENE_REFLECTION_PROBE_MAX;
+  for (uint32_t i = 0; i < scene.reflection_probe_count; ++i) {
+    VkrSceneReflectionProbe *probe = &scene.reflection_probes[i];
+    probe->enabled = (i % 5u) != 3u;
+    probe->bake_state = (i % 7u) == 2u
+                            ? VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_PENDING
+                            : VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY;
+    // Probes 0 and 1 share a center so the tie order is exercised.
+    float32_t x = i == 1u ? 0.0f : (float32_t)(i % 4u) * 6.0f;
+    float32_t z = i == 1u ? 0.0f : (float32_t)(i / 4u) * 6.0f;
+    probe->center = vec3_new(x, 1.0f, z);
+    probe->extents = vec3_new(2.0f + (float32_t)(i % 3u), 2.0f, 2.5f);
+    probe->blend_distance = 0.5f * (float32_t)(i % 4u);
+  }
+
+  VkrWorldProbeIndex index;
+  vkr_world_resources_build_probe_index(&scene, &index);
+  uint32_t selectable = 0;
+  for (uint32_t i = 0; i < scene.reflection_probe_count; ++i) {
+    selectable += (i % 5u) != 3u && (i % 7u) != 2u;
+  }
+  assert(index.count == selectable);
+
+  uint32_t found[VKR_WORLD_PROBE_INDEX_CAPACITY];
+  uint32_t found_count = vkr_world_resources_query_probe_index(
+      &index, vec3_new(0.0f, 1.0f, 0.0f), 0.0f, found);
+  assert(found_count >= 2u && found[0] == 0u && found[1] == 1u);
+
+  for (uint32_t q = 0; q < 256u; ++q) {
+    Vec3 point = vec3_new((float32_t)(q % 16u) * 1.5f - 3.0f,
+                          (float32_t)(q % 3u) * 2.0f,
+                          (float32_t)(q / 16u) * 1.5f - 3.0f);
+    float32_t radius = (float32_t)(q % 4u) * 0.75f;
+    found_count =
+        vkr_world_resources_query_probe_index(&index, point, radius, found);
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < scene.reflection_probe_count; ++i) {
+      const VkrSceneReflectionProbe *probe = &scene.reflection_probes[i];
+      bool8_t selectable_probe =
+          probe->enabled &&
+          probe->bake_state == VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY;
+      bool8_t hit = selectable_probe &&
+                    vkr_world_resources_probe_intersects_sphere(
+                        probe->center, probe->extents, probe->blend_distance,
+                        point, radius);
+      bool8_t listed = false_v;
+      for (uint32_t f = 0; f < found_count; ++f) {
+        listed |= found[f] == i;
+      }
+      assert(hit == listed);
+      expected += hit;
+    }
+    assert(found_count == expected);
+
+    for (uint32_t f = 1; f < found_count; ++f) {
+      float32_t previous = vec3_length_squared(
+          vec3_sub(point, scene.reflection_probes[found[f - 1]].center));
+      float32_t current = vec3_length_squared(
+          vec3_sub(point, scene.reflection_probes[found[f]].center));
+      assert(previous < current ||
+             (previous == current && found[f - 1] < found[f]));
+    }
+  }
+  printf("  test_local_probe_index_matches_brute_force PASSED\n");
+  return true_v;
+}
+
 bool32_t run_ibl_math_tests(void) {
   printf("--- Starting HDR IBL Math Tests ---\n");
   bool32_t passed = true_v;
@@ -267,8 +365,10 @@ bool32_t run_ibl_math_tests(void) {
   passed &= test_ibl_cubemap_size_derivation();
   passed &= test_ibl_equirect_cardinal_mapping();
   passed &= test_ibl_cube_face_convention();
+  passed &= test_ibl_cube_face_inverse_round_trip();
   passed &= test_ibl_prefilter_source_lod();
   passed &= test_local_probe_fragment_influence_and_draw_visibility();
+  passed &= test_local_probe_index_matches_brute_force();
   printf("--- HDR IBL Math Tests Completed ---\n");
   return passed;
 }
@@ -0,0 +1,283 @@
+#include "logger_test.h"
+
+#include "core/logger.h"
+#include "core/vkr_threads.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define LOGGER_TEST_LINE_CAPACITY 512u
+
+/* Sink calls are serialized by the logger, so the capture needs no lock. */
+typedef struct LoggerCapture {
+  uint32_t line_count;
+  char last_line[LOGGER_TEST_LINE_CAPACITY];
+  uint32_t next_sequence[8];
+  bool8_t ordered;
+} LoggerCapture;
+
+static void logger_capture_sink(LogLevel level, const char *line,
+                                uint64_t length, void *user_data) {
+  (void)level;
+  LoggerCapture *capture = (LoggerCapture *)user_data;
+  capture->line_count++;
+  const uint64_t copy = length < LOGGER_TEST_LINE_CAPACITY - 1u
+                            ? length
+                            : LOGGER_TEST_LINE_CAPACITY - 1u;
+  memcpy(capture->last_line, line, copy);
+  capture->last_line[copy] = '\0';
+
+  uint32_t thread = 0;
+  uint32_t sequence = 0;
+  const char *body = strstr(line, "ordered ");
+  if (body && sscanf(body, "ordered %u %u", &thread, &sequence) == 2 &&
+      thread < 8u) {
+    if (capture->next_sequence[thread] != sequence) {
+      capture->ordered = false_v;
+    }
+    capture->next_sequence[thread] = sequence + 1u;
+  }
+}
+
+typedef struct LoggerFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+} LoggerFixture;
+
+static LoggerFixture logger_fixture_create(void) {
+  LoggerFixture fixture = {0};
+  fixture.arena = arena_create(MB(8), MB(8));
+  fixture.allocator = (VkrAllocator){.ctx = fixture.arena};
+  assert(vkr_allocator_arena(&fixture.allocator));
+  return fixture;
+}
+
+static void logger_fixture_destroy(LoggerFixture *fixture) {
+  log_set_sink(NULL, NULL);
+  arena_destroy(fixture->arena);
+}
+
+static void test_logger_sync_mode_uses_sink(void) {
+  printf("  Running test_logger_sync_mode_uses_sink...\n");
+  LoggerCapture capture = {.ordered = true_v};
+  log_set_sink(logger_capture_sink, &capture);
+
+  assert(!log_async_is_active());
+  log_info("sync %d %s", 42, "value");
+  assert(capture.line_count == 1u);
+  assert(strstr(capture.last_line, "[INFO]: ") == capture.last_line);
+  assert(strstr(capture.last_line, "logger_test.c:"));
+  assert(strstr(capture.last_line, ") sync 42 value\n"));
+
+  log_flush(); // No-op without async mode.
+  log_set_sink(NULL, NULL);
+  printf("  test_logger_sync_mode_uses_sink PASSED\n");
+}
+
+static void test_logger_async_formats_deferred_arguments(void) {
+  printf("  Running test_logger_async_formats_deferred_arguments...\n");
+  LoggerFixture fixture = logger_fixture_create();
+  LoggerCapture capture = {.ordered = true_v};
+  log_set_sink(logger_capture_sink, &capture);
+
+  LogAsyncConfig config = log_async_config_default();
+  config.max_threads = 4;
+  assert(log_async_start(&fixture.allocator, &config));
+  assert(log_async_is_active());
+
+  char name[16];
+  snprintf(name, sizeof(name), "%s", "original");
+  const char *view = "length-limited";
+  void *pointer = (void *)(uintptr_t)0x1234u;
+  log_warn("i=%d u=%u ll=%lld llu=%llu z=%zu x=%#06x c=%c f=%.3f e=%g "
+           "s=%s w=[%8s] v=%.*s p=%p pct=%% star=[%*d]",
+           -7, 4000000000u, -9000000000ll, 18000000000000000000ull,
+           (size_t)123456, 0xbeef, 'Q', 3.14159, 1e-9, name, "ab", 6, view,
+           pointer, 5, 12);
+  // Strings are copied at enqueue; later changes must not leak into the line.
+  snprintf(name, sizeof(name), "%s", "mutated");
+
+  char expected[LOGGER_TEST_LINE_CAPACITY];
+  snprintf(expected, sizeof(expected),
+           "i=%d u=%u ll=%lld llu=%llu z=%zu x=%#06x c=%c f=%.3f e=%g "
+           "s=%s w=[%8s] v=%.*s p=%p pct=%% star=[%*d]\n",
+           -7, 4000000000u, -9000000000ll, 18000000000000000000ull,
+           (size_t)123456, 0xbeef, 'Q', 3.14159, 1e-9, "original", "ab", 6,
+           view, pointer, 5, 12);
+
+  log_flush();
+  assert(capture.line_count == 1u);
+  assert(strstr(capture.last_line, "[WARN]: ") == capture.last_line);
+  assert(strstr(capture.last_line, expected));
+
+  // Too large for one record: written synchronously, not dropped.
+  char large[3000];
+  memset(large, 'a', sizeof(large) - 1u);
+  large[sizeof(large) - 1u] = '\0';
+  log_info("large %s", large);
+  assert(capture.line_count == 2u);
+
+  log_async_stop();
+  assert(!log_async_is_active());
+  LogAsyncStats stats = log_async_get_stats();
+  assert(stats.enqueued == 1u);
+  assert(stats.written == 1u);
+  assert(stats.synchronous == 1u);
+  assert(stats.dropped_full == 0u);
+
+  logger_fixture_destroy(&fixture);
+  printf("  test_logger_async_formats_deferred_arguments PASSED\n");
+}
+
+static void logger_test_limited_site(uint32_t i) {
+  log_warn("limited %u", i);
+}
+
+/* Returns just after the current rate-limit window ends. */
+static void logger_wait_for_window(uint32_t window_ms) {
+  const uint64_t start =
+      (uint64_t)(vkr_platform_get_absolute_time() * 1000.0 / window_ms);
+  while ((uint64_t)(vkr_platform_get_absolute_time() * 1000.0 / window_ms) ==
+         start) {
+    vkr_platform_sleep(1);
+  }
+}
+
+static void test_logger_rate_limits_per_site(void) {
+  printf("  Running test_logger_rate_limits_per_site...\n");
+  LoggerFixture fixture = logger_fixture_create();
+  LoggerCapture capture = {.ordered = true_v};
+  log_set_sink(logger_capture_sink, &capture);
+
+  LogAsyncConfig config = log_async_config_default();
+  config.max_threads = 4;
+  config.site_rate_limit = 3;
+  config.rate_limit_window_ms = 200;
+  assert(log_async_start(&fixture.allocator, &config));
+
+  logger_wait_for_window(config.rate_limit_window_ms);
+  for (uint32_t i = 0; i < 10u; ++i) {
+    logger_test_limited_site(i);
+  }
+  // A different site has its own budget.
+  log_warn("other site");
+  log_flush();
+  assert(capture.line_count == 4u);
+  assert(log_async_get_stats().dropped_rate_limited == 7u);
+
+  logger_wait_for_window(config.rate_limit_window_ms);
+  logger_test_limited_site(10u);
+  log_flush();
+  assert(capture.line_count == 5u);
+  assert(strstr(capture.last_line,
+                "limited 10 (7 similar messages suppressed)\n"));
+
+  log_async_stop();
+  logger_fixture_destroy(&fixture);
+  printf("  test_logger_rate_limits_per_site PASSED\n");
+}
+
+typedef struct LoggerThreadContext {
+  uint32_t thread_index;
+  uint32_t count;
+} LoggerThreadContext;
+
+static void *logger_ordered_thread(void *arg) {
+  LoggerThreadContext *context = (LoggerThreadContext *)arg;
+  for (uint32_t i = 0; i < context->count; ++i) {
+    log_debug("ordered %u %u", context->thread_index, i);
+  }
+  return NULL;
+}
+
+static void test_logger_async_preserves_per_thread_order(void) {
+  printf("  Running test_logger_async_preserves_per_thread_order...\n");
+  LoggerFixture fixture = logger_fixture_create();
+  LoggerCapture capture = {.ordered = true_v};
+  log_set_sink(logger_capture_sink, &capture);
+
+  LogAsyncConfig config = log_async_config_default();
+  config.max_threads = 8;
+  config.site_rate_limit = 0;
+  assert(log_async_start(&fixture.allocator, &config));
+
+  enum { THREAD_COUNT = 4, MESSAGES = 500 };
+  VkrThread threads[THREAD_COUNT] = {0};
+  LoggerThreadContext contexts[THREAD_COUNT] = {0};
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    contexts[i] = (LoggerThreadContext){.thread_index = i, .count = MESSAGES};
+    assert(vkr_thread_create(&fixture.allocator, &threads[i],
+                             logger_ordered_thread, &contexts[i]));
+  }
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_join(threads[i]));
+    assert(vkr_thread_destroy(&fixture.allocator, &threads[i]));
+  }
+
+  log_async_stop();
+  assert(capture.line_count == THREAD_COUNT * MESSAGES);
+  assert(capture.ordered);
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(capture.next_sequence[i] == MESSAGES);
+  }
+
+  logger_fixture_destroy(&fixture);
+  printf("  test_logger_async_preserves_per_thread_order PASSED\n");
+}
+
+/*
+ * Stopping async mode while producers are still logging must neither lose
+ * their queued records nor let a later synchronous line overtake them.
+ */
+static void test_logger_async_stop_while_logging(void) {
+  printf("  Running test_logger_async_stop_while_logging...\n");
+  LoggerFixture fixture = logger_fixture_create();
+  LoggerCapture capture = {.ordered = true_v};
+  log_set_sink(logger_capture_sink, &capture);
+
+  LogAsyncConfig config = log_async_config_default();
+  config.max_threads = 8;
+  config.ring_size = (uint32_t)MB(1);
+  config.site_rate_limit = 0;
+  assert(log_async_start(&fixture.allocator, &config));
+
+  enum { THREAD_COUNT = 4, MESSAGES = 4000 };
+  VkrThread threads[THREAD_COUNT] = {0};
+  LoggerThreadContext contexts[THREAD_COUNT] = {0};
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    contexts[i] = (LoggerThreadContext){.thread_index = i, .count = MESSAGES};
+    assert(vkr_thread_create(&fixture.allocator, &threads[i],
+                             logger_ordered_thread, &contexts[i]));
+  }
+  while (log_async_get_stats().enqueued < THREAD_COUNT * 100u) {
+    vkr_thread_sleep(0);
+  }
+  log_async_stop();
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_join(threads[i]));
+    assert(vkr_thread_destroy(&fixture.allocator, &threads[i]));
+  }
+
+  assert(log_async_get_stats().dropped_full == 0);
+  assert(capture.line_count == THREAD_COUNT * MESSAGES);
+  assert(capture.ordered);
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(capture.next_sequence[i] == MESSAGES);
+  }
+
+  logger_fixture_destroy(&fixture);
+  printf("  test_logger_async_stop_while_logging PASSED\n");
+}
+
+bool32_t run_logger_tests(void) {
+  printf("--- Starting Logger Tests ---\n");
+  test_logger_sync_mode_uses_sink();
+  test_logger_async_formats_deferred_arguments();
+  test_logger_rate_limits_per_site();
+  test_logger_async_preserves_per_thread_order();
+  test_logger_async_stop_while_logging();
+  printf("--- Logger Tests Completed ---\n");
+  return true_v;
+}
@@ -15,6 +15,13 @@ typedef struct MetricsThreadContext {
   uint32_t thread_index;
 } MetricsThreadContext;
 
+typedef struct MetricsHistogramThreadContext {
+  VkrMetrics *metrics;
+  VkrMetricId histogram;
+  uint32_t iterations;
+  uint64_t value;
+} MetricsHistogramThreadContext;
+
 typedef struct MetricsEventThreadContext {
   VkrMetrics *metrics;
   VkrMetricId source;
@@ -61,8 +68,10 @@ static VkrMetricDescription metrics_desc(const char *name, VkrMetricKind kind,
           string8_create_from_cstr((const uint8_t *)name, string_length(name)),
       .domain = VKR_METRIC_DOMAIN_FRAME,
       .kind = kind,
-      .unit = kind == VKR_METRIC_KIND_DURATION ? VKR_METRIC_UNIT_NANOSECONDS
-                                               : VKR_METRIC_UNIT_COUNT,
+      .unit = kind == VKR_METRIC_KIND_DURATION ||
+                      kind == VKR_METRIC_KIND_HISTOGRAM
+                  ? VKR_METRIC_UNIT_NANOSECONDS
+                  : VKR_METRIC_UNIT_COUNT,
       .scalar = scalar,
       .writer = writer,
       .required_when_enabled = true_v,
@@ -80,6 +89,14 @@ static void *metrics_counter_thread(void *data) {
   return NULL;
 }
 
+static void *metrics_histogram_thread(void *data) {
+  MetricsHistogramThreadContext *ctx = data;
+  for (uint32_t i = 0; i < ctx->iterations; ++i) {
+    vkr_metrics_histogram_record_ns(ctx->metrics, ctx->histogram, ctx->value);
+  }
+  return NULL;
+}
+
 static void *metrics_event_thread(void *data) {
   MetricsEventThreadContext *ctx = data;
   for (uint32_t i = 0; i < ctx->count; ++i) {
@@ -721,6 +738,301 @@ static void test_renderer_owner_metric_catalog(void) {
   printf("  test_renderer_owner_metric_catalog PASSED\n");
 }
 
+static void test_metrics_histogram_buckets(void) {
+  printf("  Running test_metrics_histogram_buckets...\n");
+
+  for (uint64_t value = 0; value < VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+       ++value) {
+    assert(vkr_metric_histogram_bucket(value) == value);
+  }
+  assert(vkr_metric_histogram_bucket(32u) == 32u);
+  assert(vkr_metric_histogram_bucket(63u) == 63u);
+  assert(vkr_metric_histogram_bucket(64u) == 64u);
+  assert(vkr_metric_histogram_bucket(65u) == 64u);
+  assert(vkr_metric_histogram_bucket(UINT64_MAX) ==
+         VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u);
+  assert(vkr_metric_histogram_bucket(
+             1ull << (VKR_METRIC_HISTOGRAM_MAX_EXPONENT + 1u)) ==
+         VKR_METRIC_HISTOGRAM_BUCKET_COUNT - 1u);
+
+  // Buckets tile the range without gaps, and no bucket is wider than 1/32 of
+  // its lowest value.
+  for (uint32_t bucket = 0; bucket + 1u < VKR_METRIC_HISTOGRAM_BUCKET_COUNT;
+       ++bucket) {
+    const uint64_t lowest = vkr_metric_histogram_bucket_lowest(bucket);
+    const uint64_t highest = vkr_metric_histogram_bucket_highest(bucket);
+    assert(vkr_metric_histogram_bucket(lowest) == bucket);
+    assert(vkr_metric_histogram_bucket(highest) == bucket);
+    assert(vkr_metric_histogram_bucket_lowest(bucket + 1u) == highest + 1u);
+    assert((highest - lowest) * VKR_METRIC_HISTOGRAM_SUB_BUCKET_COUNT <=
+           lowest);
+  }
+
+  printf("  test_metrics_histogram_buckets PASSED\n");
+}
+
+static void test_metrics_histogram_percentiles(void) {
+  printf("  Running test_metrics_histogram_percentiles...\n");
+
+  MetricsFixture fixture = metrics_fixture_create();
+  VkrMetrics *metrics = fixture.metrics;
+  VkrMetricId histogram = VKR_METRIC_ID_INVALID;
+  VkrMetricId duration = VKR_METRIC_ID_INVALID;
+  VkrMetricDescription description =
+      metrics_desc("frame.wall.histogram", VKR_METRIC_KIND_HISTOGRAM,
+                   VKR_METRIC_SCALAR_U64, VKR_METRIC_WRITER_RENDER_THREAD);
+  description.histogram_half_life_frames = 1u;
+  assert(vkr_metrics_register(metrics, &description, &histogram));
+  description =
+      metrics_desc("frame.wall", VKR_METRIC_KIND_DURATION,
+                   VKR_METRIC_SCALAR_U64, VKR_METRIC_WRITER_RENDER_THREAD);
+  assert(vkr_metrics_register(metrics, &description, &duration));
+  VkrMetricId rejected = VKR_METRIC_ID_INVALID;
+  description =
+      metrics_desc("frame.bytes.histogram", VKR_METRIC_KIND_HISTOGRAM,
+                   VKR_METRIC_SCALAR_U64, VKR_METRIC_WRITER_RENDER_THREAD);
+  description.unit = VKR_METRIC_UNIT_BYTES;
+  assert(!vkr_metrics_register(metrics, &description, &rejected));
+  assert(vkr_metrics_seal(metrics));
+
+  vkr_metrics_begin_frame(metrics, 1u, 1u);
+  for (uint64_t value = 1; value <= 1000u; ++value) {
+    vkr_metrics_histogram_record_ns(metrics, histogram, value * 1000u);
+  }
+  vkr_metrics_duration_add_ns(metrics, duration, 5u);
+  assert(vkr_metrics_end_frame(metrics));
+
+  VkrMetricsSnapshotView view = {0};
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  VkrMetricHistogramSample sample = {0};
+  assert(vkr_metrics_frame_read_histogram(view.frame, histogram, &sample));
+  assert(sample.count == 1000u && sample.min_ns == 1000u &&
+         sample.max_ns == 1000000u && sample.sum_ns == 500500000u);
+  uint64_t u64_value = 0;
+  assert(!vkr_metrics_frame_read_u64(view.frame, histogram, &u64_value));
+  assert(!vkr_metrics_frame_read_histogram(view.frame, duration, &sample));
+  assert(!vkr_metrics_frame_read_percentile_ns(
+      view.frame, duration, VKR_METRIC_HISTOGRAM_RANGE_FRAME, 50.0,
+      &u64_value));
+
+  // Bucket-highest values: never below the exact rank, at most ~3% above.
+  VkrMetricPercentiles percentiles = {0};
+  assert(vkr_metrics_frame_read_percentiles(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, &percentiles));
+  assert(percentiles.p50_ns >= 500000u && percentiles.p50_ns <= 516000u);
+  assert(percentiles.p90_ns >= 900000u && percentiles.p90_ns <= 929000u);
+  assert(percentiles.p99_ns >= 990000u && percentiles.p99_ns <= 1000000u);
+  assert(percentiles.p999_ns == 1000000u);
+  assert(vkr_metrics_frame_read_percentile_ns(
+             view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, 0.0,
+             &u64_value) &&
+         vkr_metric_histogram_bucket(u64_value) ==
+             vkr_metric_histogram_bucket(1000u));
+  assert(vkr_metrics_frame_read_percentile_ns(
+             view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, 100.0,
+             &u64_value) &&
+         u64_value == 1000000u);
+  // After one frame the window holds exactly that frame.
+  VkrMetricPercentiles window = {0};
+  assert(vkr_metrics_frame_read_percentiles(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_WINDOW, &window));
+  assert(window.p50_ns == percentiles.p50_ns &&
+         window.p99_ns == percentiles.p99_ns);
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  // An unsampled frame has no frame distribution, but the window keeps the
+  // decayed history.
+  vkr_metrics_begin_frame(metrics, 2u, 2u);
+  assert(vkr_metrics_end_frame(metrics));
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  assert(vkr_metrics_frame_get(view.frame, histogram)->availability ==
+         VKR_METRIC_AVAILABILITY_UNAVAILABLE);
+  assert(!vkr_metrics_frame_read_percentiles(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, &percentiles));
+  assert(vkr_metrics_frame_read_percentiles(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_WINDOW, &window));
+  assert(window.p50_ns >= 500000u && window.p50_ns <= 516000u);
+  assert(view.frame->histogram_windows[0].total > 499.0 &&
+         view.frame->histogram_windows[0].total < 501.0);
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  // With a one-frame half-life, three frames of fast values outweigh the old
+  // slow frame (weight 1/8 of its 1000 samples) at the median.
+  for (uint64_t frame = 3; frame < 6u; ++frame) {
+    vkr_metrics_begin_frame(metrics, frame, frame);
+    for (uint32_t i = 0; i < 1000u; ++i) {
+      vkr_metrics_histogram_record_ns(metrics, histogram, 10u);
+    }
+    assert(vkr_metrics_end_frame(metrics));
+  }
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  assert(vkr_metrics_frame_read_percentiles(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_WINDOW, &window));
+  assert(window.p50_ns == 10u && window.p90_ns == 10u);
+  assert(window.p999_ns > 10u);
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  metrics_fixture_destroy(&fixture);
+  printf("  test_metrics_histogram_percentiles PASSED\n");
+}
+
+static void test_metrics_histogram_concurrent(void) {
+  printf("  Running test_metrics_histogram_concurrent...\n");
+
+  MetricsFixture fixture = metrics_fixture_create();
+  VkrMetrics *metrics = fixture.metrics;
+  VkrMetricId histogram = VKR_METRIC_ID_INVALID;
+  VkrMetricDescription description =
+      metrics_desc("job.latency", VKR_METRIC_KIND_HISTOGRAM,
+                   VKR_METRIC_SCALAR_U64, VKR_METRIC_WRITER_CONCURRENT);
+  assert(vkr_metrics_register(metrics, &description, &histogram));
+  assert(vkr_metrics_seal(metrics));
+
+  enum { THREAD_COUNT = 6, ITERATIONS = 20000 };
+  VkrThread threads[THREAD_COUNT] = {0};
+  MetricsHistogramThreadContext contexts[THREAD_COUNT] = {0};
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    contexts[i] = (MetricsHistogramThreadContext){
+        .metrics = metrics,
+        .histogram = histogram,
+        .iterations = ITERATIONS,
+        .value = 100u * (i + 1u),
+    };
+    assert(vkr_thread_create(&fixture.allocator, &threads[i],
+                             metrics_histogram_thread, &contexts[i]));
+  }
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_join(threads[i]));
+    assert(vkr_thread_destroy(&fixture.allocator, &threads[i]));
+  }
+
+  vkr_metrics_begin_frame(metrics, 1u, 1u);
+  assert(vkr_metrics_end_frame(metrics));
+  VkrMetricsSnapshotView view = {0};
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  VkrMetricHistogramSample sample = {0};
+  assert(vkr_metrics_frame_read_histogram(view.frame, histogram, &sample));
+  assert(sample.count == THREAD_COUNT * ITERATIONS);
+  assert(sample.sum_ns == 100u * ITERATIONS * (THREAD_COUNT *
+                                               (THREAD_COUNT + 1u) / 2u));
+  assert(sample.min_ns == 100u && sample.max_ns == 100u * THREAD_COUNT);
+  uint64_t p50 = 0;
+  assert(vkr_metrics_frame_read_percentile_ns(
+             view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, 50.0,
+             &p50) &&
+         vkr_metric_histogram_bucket(p50) == vkr_metric_histogram_bucket(300u));
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  // Shards are differenced: a quiet frame is a valid empty histogram.
+  vkr_metrics_begin_frame(metrics, 2u, 2u);
+  assert(vkr_metrics_end_frame(metrics));
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  assert(vkr_metrics_frame_read_histogram(view.frame, histogram, &sample));
+  assert(sample.count == 0 && sample.sum_ns == 0 && sample.min_ns == 0 &&
+         sample.max_ns == 0);
+  assert(!vkr_metrics_frame_read_percentile_ns(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_FRAME, 50.0, &p50));
+  assert(vkr_metrics_frame_read_percentile_ns(
+      view.frame, histogram, VKR_METRIC_HISTOGRAM_RANGE_WINDOW, 50.0, &p50));
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  // A dropped publication still feeds the window but not the next frame.
+  VkrMetricsSnapshotView views[VKR_METRICS_SNAPSHOT_BUFFER_COUNT] = {0};
+  for (uint32_t i = 0; i < VKR_METRICS_SNAPSHOT_BUFFER_COUNT; ++i) {
+    vkr_metrics_begin_frame(metrics, 3u + i, 3u + i);
+    assert(vkr_metrics_end_frame(metrics));
+    assert(vkr_metrics_snapshot_acquire(metrics, &views[i]));
+  }
+  const float64_t total_before = views[VKR_METRICS_SNAPSHOT_BUFFER_COUNT - 1u]
+                                     .frame->histogram_windows[0]
+                                     .total;
+  vkr_metrics_begin_frame(metrics, 10u, 10u);
+  vkr_metrics_histogram_record_ns(metrics, histogram, 7u);
+  assert(!vkr_metrics_end_frame(metrics));
+  for (uint32_t i = 0; i < VKR_METRICS_SNAPSHOT_BUFFER_COUNT; ++i) {
+    vkr_metrics_snapshot_release(metrics, &views[i]);
+  }
+  vkr_metrics_begin_frame(metrics, 11u, 11u);
+  assert(vkr_metrics_end_frame(metrics));
+  assert(vkr_metrics_snapshot_acquire(metrics, &view));
+  assert(vkr_metrics_frame_read_histogram(view.frame, histogram, &sample));
+  assert(sample.count == 0);
+  const VkrMetricHistogramWindow *window = &view.frame->histogram_windows[0];
+  assert(window->counts[vkr_metric_histogram_bucket(7u)] > 0.9f);
+  assert(window->total < total_before + 1.0);
+  vkr_metrics_snapshot_release(metrics, &view);
+
+  metrics_fixture_destroy(&fixture);
+  printf("  test_metrics_histogram_concurrent PASSED\n");
+}
+
+static void test_metrics_histogram_export(void) {
+  printf("  Running test_metrics_histogram_export...\n");
+
+  MetricsFixture fixture = metrics_fixture_create();
+  VkrMetrics *metrics = fixture.metrics;
+  metrics->config.event_subjects = true_v;
+  metrics->config.histogram_export_interval = 2u;
+  VkrMetricId histograms[VKR_METRICS_MAX_HISTOGRAMS] = {0};
+  for (uint32_t i = 0; i < VKR_METRICS_MAX_HISTOGRAMS; ++i) {
+    char name[32];
+    snprintf(name, sizeof(name), "frame.histogram%u", i);
+    const VkrMetricDescription description =
+        metrics_desc(name, VKR_METRIC_KIND_HISTOGRAM, VKR_METRIC_SCALAR_U64,
+                     VKR_METRIC_WRITER_RENDER_THREAD);
+    assert(vkr_metrics_register(metrics, &description, &histograms[i]));
+  }
+  // The pool is fixed; exhausting it fails registration like the catalog.
+  VkrMetricId extra = VKR_METRIC_ID_INVALID;
+  const VkrMetricDescription overflow =
+      metrics_desc("frame.histogram_extra", VKR_METRIC_KIND_HISTOGRAM,
+                   VKR_METRIC_SCALAR_U64, VKR_METRIC_WRITER_RENDER_THREAD);
+  assert(!vkr_metrics_register(metrics, &overflow, &extra));
+  assert(extra == VKR_METRIC_ID_INVALID);
+  assert(vkr_metrics_seal(metrics));
+
+  // Only the first histogram is ever sampled; the empty ones export nothing.
+  for (uint64_t frame = 1; frame <= 2u; ++frame) {
+    vkr_metrics_begin_frame(metrics, frame, frame);
+    for (uint64_t value = 1; value <= 100u; ++value) {
+      vkr_metrics_histogram_record_ns(metrics, histograms[0], value);
+    }
+    assert(vkr_metrics_end_frame(metrics));
+    VkrMetricEvent event = {0};
+    if (frame == 1u) {
+      assert(!vkr_metrics_event_peek(metrics, 0, &event));
+    }
+  }
+
+  static const uint16_t expected_bp[] = {5000u, 9000u, 9900u, 9990u};
+  static const char *expected_subject[] = {"p50", "p90", "p99", "p99.9"};
+  uint64_t previous = 0;
+  for (uint32_t i = 0; i < ArrayCount(expected_bp); ++i) {
+    VkrMetricEvent event = {0};
+    assert(vkr_metrics_event_pop(metrics, &event));
+    assert(event.source == histograms[0]);
+    assert(event.percentile_bp == expected_bp[i]);
+    assert(strcmp(event.subject, expected_subject[i]) == 0);
+    assert(event.status == VKR_METRIC_EVENT_STATUS_SUCCESS);
+    // Two equal frames decayed by the default half-life: ~200 samples.
+    assert(event.bytes >= 190u && event.bytes <= 200u);
+    // Values 1..100 in equal weights: each percentile lands within one
+    // bucket of its exact rank.
+    const uint64_t exact = Max(1u, (expected_bp[i] + 99u) / 100u);
+    assert(event.duration_ns >= previous &&
+           vkr_metric_histogram_bucket(event.duration_ns) + 1u >=
+               vkr_metric_histogram_bucket(exact) &&
+           vkr_metric_histogram_bucket(event.duration_ns) <=
+               vkr_metric_histogram_bucket(exact) + 1u);
+    previous = event.duration_ns;
+  }
+  VkrMetricEvent event = {0};
+  assert(!vkr_metrics_event_pop(metrics, &event));
+
+  metrics_fixture_destroy(&fixture);
+  printf("  test_metrics_histogram_export PASSED\n");
+}
+
 static void test_renderer_cumulative_delta(void) {
   printf("  Running test_renderer_cumulative_delta...\n");
 
@@ -778,6 +1090,10 @@ bool32_t run_metrics_tests(void) {
   test_metrics_event_record_status();
   test_metrics_event_ring_mpsc();
   test_metrics_registry_generation();
+  test_metrics_histogram_buckets();
+  test_metrics_histogram_percentiles();
+  test_metrics_histogram_concurrent();
+  test_metrics_histogram_export();
   test_renderer_owner_metric_catalog();
   test_renderer_cumulative_delta();
   test_renderer_pass_sample_publication();
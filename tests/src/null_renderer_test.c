@@ -0,0 +1,308 @@
+#include "null_renderer_test.h"
+
+#include "renderer/systems/vkr_geometry_system.h"
+#include "renderer/systems/vkr_texture_system.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+static VkrNullRendererConfig null_test_config(VkrAllocator *allocator) {
+  return (VkrNullRendererConfig){
+      .allocator = allocator,
+      .graph_path = "assets/render_graphs/main.rendergraph.json",
+      .width = 1280u,
+      .height = 720u,
+      .image_count = 3u,
+      .geometry_capacity = 16u,
+      .texture_capacity = 16u,
+      .material_capacity = 16u,
+      .retirement_capacity = 8u,
+      .gpu_latency_frames = 2u,
+  };
+}
+
+static VkrRenderGraphFrameInfo null_test_frame(uint32_t frame_index) {
+  return (VkrRenderGraphFrameInfo){
+      .frame_index = frame_index,
+      .delta_time = 1.0 / 60.0,
+      .target_color_format = VKR_TEXTURE_FORMAT_R8G8B8A8_SRGB,
+      .target_depth_format = VKR_TEXTURE_FORMAT_D32_SFLOAT,
+      .shadow_depth_format = VKR_TEXTURE_FORMAT_D32_SFLOAT,
+      .shadow_map_size = 1024u,
+      .shadow_map_layer_count = 1u,
+  };
+}
+
+static void null_test_submit(VkrNullRenderer *renderer, uint32_t frame_index,
+                             VkrNullResult *out_result) {
+  VkrFrameSetup setup = {0};
+  const VkrRenderGraphFrameInfo frame = null_test_frame(frame_index);
+  assert(vkr_null_renderer_prepare_frame(renderer, &frame, &setup));
+  assert(setup.image_index ==
+         vkr_null_renderer_submit_value(renderer) % 3u);
+  const VkrRenderPacket packet = {.frame = {.frame_index = frame_index}};
+  assert(vkr_null_renderer_submit_packet(renderer, &packet, out_result));
+}
+
+static void test_null_renderer_rejects_invalid_config(void) {
+  printf("  Running test_null_renderer_rejects_invalid_config...\n");
+  Arena *arena = arena_create(MB(16), MB(2));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrNullRendererConfig config = null_test_config(&allocator);
+  config.gpu_latency_frames = VKR_NULL_FRAME_SLOT_COUNT;
+  VkrNullRenderer *renderer = (VkrNullRenderer *)&config;
+  assert(!vkr_null_renderer_create(&config, &renderer));
+  assert(renderer == NULL);
+
+  config = null_test_config(&allocator);
+  config.graph_path = "assets/render_graphs/missing.rendergraph.json";
+  assert(!vkr_null_renderer_create(&config, &renderer));
+  assert(renderer == NULL);
+
+  arena_destroy(arena);
+  printf("  test_null_renderer_rejects_invalid_config PASSED\n");
+}
+
+static void test_null_renderer_walks_authored_graph(void) {
+  printf("  Running test_null_renderer_walks_authored_graph...\n");
+  Arena *arena = arena_create(MB(16), MB(2));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  const VkrNullRendererConfig config = null_test_config(&allocator);
+  VkrNullRenderer *renderer = NULL;
+  assert(vkr_null_renderer_create(&config, &renderer));
+
+  VkrNullResult result = {0};
+  null_test_submit(renderer, 1u, &result);
+  assert(result.submit_value == 1u);
+  assert(result.source_frame_index == 1u);
+  assert(result.executed_pass_count > 0u);
+  assert(result.pass_timing_count == result.executed_pass_count);
+  assert(result.image_barrier_count > 0u);
+  for (uint32_t i = 0u; i < result.pass_timing_count; ++i) {
+    assert(result.pass_timings[i].name[0] != '\0');
+    assert(!result.pass_timings[i].valid);
+    assert(result.pass_timings[i].cpu_ms >= 0.0);
+  }
+
+  // Two frames of latency: nothing completes until the third submit.
+  VkrNullResult polled = {0};
+  assert(!vkr_null_renderer_poll_result(renderer, 0u, &polled));
+  null_test_submit(renderer, 2u, &result);
+  assert(vkr_null_renderer_completed_value(renderer) == 0u);
+  null_test_submit(renderer, 3u, &result);
+  assert(vkr_null_renderer_completed_value(renderer) == 1u);
+  assert(vkr_null_renderer_poll_result(renderer, 0u, &polled));
+  assert(polled.submit_value == 1u && polled.source_frame_index == 1u);
+  assert(!vkr_null_renderer_poll_result(renderer, 1u, &polled));
+  assert(vkr_null_renderer_frame_slot(renderer) == 2u);
+
+  assert(vkr_null_renderer_wait_idle(renderer));
+  assert(vkr_null_renderer_completed_value(renderer) == 3u);
+  assert(vkr_null_renderer_poll_result(renderer, 1u, &polled));
+  assert(polled.submit_value == 3u);
+
+  VkrRenderGraphResourceStats stats = {0};
+  assert(vkr_null_renderer_graph_resource_stats(renderer, &stats));
+  assert(stats.live_image_textures > 0u);
+  assert(stats.live_image_bytes >= 1280ull * 720ull * 4ull);
+  assert(stats.peak_image_bytes >= stats.live_image_bytes);
+
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.graph_builds == 3u);
+  assert(metrics.passes_executed == 3u * result.executed_pass_count);
+
+  // A cancelled frame leaves the fence untouched and the next frame valid.
+  VkrFrameSetup setup = {0};
+  const VkrRenderGraphFrameInfo frame = null_test_frame(4u);
+  assert(vkr_null_renderer_prepare_frame(renderer, &frame, &setup));
+  assert(!vkr_null_renderer_prepare_frame(renderer, &frame, &setup));
+  assert(setup.window_width == 1280u && setup.window_height == 720u);
+  vkr_null_renderer_cancel_frame(renderer);
+  assert(vkr_null_renderer_submit_value(renderer) == 3u);
+  assert(vkr_null_renderer_resize(renderer, 640u, 360u, 3u));
+  assert(vkr_null_renderer_prepare_frame(renderer, &frame, &setup));
+  assert(setup.window_width == 640u && setup.window_height == 360u);
+  vkr_null_renderer_cancel_frame(renderer);
+  null_test_submit(renderer, 4u, &result);
+  assert(vkr_null_renderer_submit_value(renderer) == 4u);
+
+  vkr_null_renderer_destroy(renderer);
+  arena_destroy(arena);
+  printf("  test_null_renderer_walks_authored_graph PASSED\n");
+}
+
+static void test_null_renderer_publication_accounting(void) {
+  printf("  Running test_null_renderer_publication_accounting...\n");
+  Arena *arena = arena_create(MB(16), MB(2));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  const VkrNullRendererConfig config = null_test_config(&allocator);
+  VkrNullRenderer *renderer = NULL;
+  assert(vkr_null_renderer_create(&config, &renderer));
+  VkrAssetPublisher publisher = {0};
+  vkr_null_renderer_get_asset_publisher(renderer, &publisher);
+  assert(publisher.state == renderer);
+
+  float32_t vertices[32] = {0};
+  uint16_t indices[6] = {0, 1, 2, 2, 1, 3};
+  const VkrGeometryConfig geometry = {
+      .vertex_size = 32u,
+      .vertex_count = 4u,
+      .vertices = vertices,
+      .index_size = sizeof(uint16_t),
+      .index_count = 6u,
+      .indices = indices,
+  };
+  const uint64_t geometry_bytes = 4u * 32u + 6u * sizeof(uint32_t);
+  const VkrGeometryHandle mesh = {.id = 1u, .generation = 7u};
+  assert(publisher.publish_geometry(publisher.state, mesh, &geometry));
+  assert(publisher.publish_geometry(publisher.state, mesh, &geometry));
+  assert(!publisher.publish_geometry(
+      publisher.state, (VkrGeometryHandle){.id = 1u, .generation = 8u},
+      &geometry));
+  assert(!publisher.publish_geometry(
+      publisher.state, (VkrGeometryHandle){.id = 17u, .generation = 1u},
+      &geometry));
+
+  uint8_t pixels[4u * 4u * 4u] = {0};
+  const VkrTexturePreparedLoad texture = {
+      .description = {.id = 2u,
+                      .width = 4u,
+                      .height = 4u,
+                      .generation = 3u,
+                      .channels = 4u,
+                      .type = VKR_TEXTURE_TYPE_2D,
+                      .format = VKR_TEXTURE_FORMAT_R8G8B8A8_UNORM},
+      .upload_data = pixels,
+      .upload_data_size = sizeof(pixels),
+      .upload_mip_levels = 1u,
+      .upload_array_layers = 1u,
+  };
+  const VkrTextureHandle source = {.id = 2u, .generation = 3u};
+  assert(publisher.publish_texture(publisher.state, source, &texture));
+  assert(publisher.update_texture_sampler(publisher.state, source,
+                                          &texture.description));
+
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.geometry_publications == 2u);
+  assert(metrics.geometry_upload_bytes == 2u * geometry_bytes);
+  assert(metrics.texture_upload_bytes == sizeof(pixels));
+  assert(metrics.sampler_updates == 1u);
+  assert(metrics.memory.live_allocations == 2u);
+  assert(metrics.memory.live_requested_bytes ==
+         geometry_bytes + sizeof(pixels));
+  assert(metrics.memory.classes[VKR_RENDERER_IMPL_MEMORY_CLASS_BUFFER]
+             .live_requested_bytes == geometry_bytes);
+  assert(metrics.memory.stale_handle_failures == 1u);
+
+  // A queued bake holds publications busy until the next submit.
+  assert(publisher.publications_idle(publisher.state));
+  assert(publisher.bake_ibl_cubemap(publisher.state, source, source, source));
+  assert(!publisher.bake_ibl_cubemap(
+      publisher.state, source, source,
+      (VkrTextureHandle){.id = 5u, .generation = 1u}));
+  assert(!publisher.publications_idle(publisher.state));
+
+  const VkrMaterial material = {.id = 3u, .generation = 1u};
+  const VkrMaterialHandle material_handle = {.id = 3u, .generation = 1u};
+  assert(publisher.publish_material(publisher.state, material_handle,
+                                    &material));
+  assert(publisher.publish_material(publisher.state, material_handle,
+                                    &material));
+  assert(!publisher.publish_material(
+      publisher.state, (VkrMaterialHandle){.id = 4u, .generation = 1u},
+      &material));
+
+  // Unpublished resources stay resident until their last submit completes.
+  assert(publisher.unpublish_geometry(publisher.state, mesh));
+  assert(!publisher.unpublish_geometry(publisher.state, mesh));
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.memory.retired_allocations == 1u);
+  assert(metrics.memory.retired_requested_bytes == geometry_bytes);
+  assert(metrics.materials.rows_live == 1u);
+  assert(metrics.materials.rows_replaced == 1u);
+  assert(metrics.materials.rows_retired == 1u);
+  assert(metrics.retirements_pending == 2u);
+
+  VkrNullResult result = {0};
+  null_test_submit(renderer, 1u, &result);
+  assert(publisher.publications_idle(publisher.state));
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.ibl_bakes == 1u);
+  assert(metrics.retirements_pending == 2u);
+
+  assert(vkr_null_renderer_wait_idle(renderer));
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.retirements_pending == 0u);
+  assert(metrics.memory.retired_allocations == 0u);
+  assert(metrics.memory.retired_requested_bytes == 0u);
+  assert(metrics.memory.retirements_collected == 1u);
+  assert(metrics.materials.rows_collected == 1u);
+  assert(metrics.memory.live_requested_bytes == sizeof(pixels));
+  assert(metrics.memory.peak_requested_bytes ==
+         geometry_bytes + sizeof(pixels));
+  assert(metrics.memory.slot_tables[VKR_RENDERER_IMPL_SLOT_TABLE_MATERIAL]
+             .live == 1u);
+
+  vkr_null_renderer_destroy(renderer);
+  arena_destroy(arena);
+  printf("  test_null_renderer_publication_accounting PASSED\n");
+}
+
+static void test_null_renderer_retirement_capacity(void) {
+  printf("  Running test_null_renderer_retirement_capacity...\n");
+  Arena *arena = arena_create(MB(16), MB(2));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrNullRendererConfig config = null_test_config(&allocator);
+  config.retirement_capacity = 1u;
+  VkrNullRenderer *renderer = NULL;
+  assert(vkr_null_renderer_create(&config, &renderer));
+  VkrAssetPublisher publisher = {0};
+  vkr_null_renderer_get_asset_publisher(renderer, &publisher);
+
+  const VkrMaterial first = {.id = 1u, .generation = 1u};
+  const VkrMaterial second = {.id = 2u, .generation = 1u};
+  const VkrMaterialHandle first_handle = {.id = 1u, .generation = 1u};
+  const VkrMaterialHandle second_handle = {.id = 2u, .generation = 1u};
+  assert(publisher.publish_material(publisher.state, first_handle, &first));
+  assert(publisher.publish_material(publisher.state, second_handle, &second));
+  // Once a submit may reference the rows, unpublishing has to wait for it.
+  VkrNullResult result = {0};
+  null_test_submit(renderer, 1u, &result);
+  assert(publisher.unpublish_material(publisher.state, first_handle));
+  assert(!publisher.unpublish_material(publisher.state, second_handle));
+
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.materials.retirement_capacity_failures == 1u);
+  assert(metrics.materials.rows_live == 1u);
+  assert(vkr_null_renderer_wait_idle(renderer));
+  assert(publisher.unpublish_material(publisher.state, second_handle));
+  vkr_null_renderer_metrics(renderer, &metrics);
+  assert(metrics.retirements_pending == 0u);
+  assert(metrics.materials.rows_live == 0u);
+  assert(metrics.materials.rows_collected == 2u);
+
+  vkr_null_renderer_destroy(renderer);
+  arena_destroy(arena);
+  printf("  test_null_renderer_retirement_capacity PASSED\n");
+}
+
+bool32_t run_null_renderer_tests() {
+  printf("--- Running null renderer tests... ---\n");
+  test_null_renderer_rejects_invalid_config();
+  test_null_renderer_walks_authored_graph();
+  test_null_renderer_publication_accounting();
+  test_null_renderer_retirement_capacity();
+  printf("--- Null renderer tests completed. ---\n");
+  return true_v;
+}
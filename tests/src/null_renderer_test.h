@@ -0,0 +1,10 @@
+#pragma once
+
+#include "containers/str.h"
+#include "core/logger.h"
+#include "memory/vkr_arena_allocator.h"
+#include "platform/vkr_platform.h"
+#include "renderer/null/vkr_null_renderer.h"
+#include "vkr_pch.h"
+
+bool32_t run_null_renderer_tests();
@@ -0,0 +1,243 @@
+#include "occlusion_test.h"
+
+#include "core/vkr_job_system.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+#include "platform/vkr_platform.h"
+#include "renderer/vkr_occlusion.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+/* Camera at the origin looking down -Z, like the renderer's default. */
+static Mat4 occlusion_test_view_projection(void) {
+  const Mat4 projection =
+      mat4_perspective(vkr_to_radians(60.0f), 2.0f, 0.1f, 1000.0f);
+  const Mat4 view = mat4_look_at(vec3_new(0.0f, 0.0f, 0.0f),
+                                 vec3_new(0.0f, 0.0f, -1.0f),
+                                 vec3_new(0.0f, 1.0f, 0.0f));
+  return mat4_mul(projection, view);
+}
+
+static const float32_t occlusion_test_quad_positions[4][3] = {
+    {-1.0f, -1.0f, 0.0f},
+    {1.0f, -1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {-1.0f, 1.0f, 0.0f},
+};
+/* Counter-clockwise seen from +Z, so front-facing toward the camera. */
+static const uint16_t occlusion_test_quad_front[6] = {0, 1, 2, 0, 2, 3};
+static const uint16_t occlusion_test_quad_back[6] = {0, 2, 1, 0, 3, 2};
+
+static VkrTriangleMeshSource occlusion_test_quad(const uint16_t *indices) {
+  return (VkrTriangleMeshSource){
+      .positions = occlusion_test_quad_positions,
+      .position_stride = sizeof(occlusion_test_quad_positions[0]),
+      .vertex_count = 4u,
+      .indices = indices,
+      .index_size = sizeof(uint16_t),
+      .index_count = 6u,
+  };
+}
+
+/* A quad of half-extent `half` centered at `center`, facing +Z. */
+static Mat4 occlusion_test_quad_model(Vec3 center, float32_t half) {
+  return mat4_mul(mat4_translate(center),
+                  mat4_scale(vec3_new(half, half, 1.0f)));
+}
+
+static bool8_t occlusion_test_box(const VkrOcclusionBuffer *buffer,
+                                  Vec3 center, float32_t half) {
+  const Vec3 extent = vec3_new(half, half, half);
+  return vkr_occlusion_test_box(buffer, mat4_identity(),
+                                vec3_sub(center, extent),
+                                vec3_add(center, extent));
+}
+
+static void test_occlusion_front_occluder(void) {
+  printf("  Running test_occlusion_front_occluder...\n");
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrOcclusionBuffer buffer;
+  assert(vkr_occlusion_buffer_init(&buffer, &allocator,
+                                   occlusion_test_view_projection(), 64u));
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, NULL);
+
+  // Nothing rasterized yet: everything is visible.
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -20.0f), 1.0f));
+
+  const VkrTriangleMeshSource quad =
+      occlusion_test_quad(occlusion_test_quad_front);
+  assert(vkr_occlusion_add_occluder(
+      &buffer, occlusion_test_quad_model(vec3_new(0.0f, 0.0f, -10.0f), 5.0f),
+      &quad, false_v));
+  assert(buffer.triangle_count == 2u && buffer.occluder_count == 1u);
+  vkr_occlusion_rasterize(&buffer, &dispatch);
+  assert(buffer.rasterized);
+
+  // Behind the wall.
+  assert(occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -20.0f), 1.0f));
+  assert(occlusion_test_box(&buffer, vec3_new(1.0f, -1.0f, -60.0f), 3.0f));
+  // In front of it, poking out past its edge, or beside it.
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -5.0f), 1.0f));
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -20.0f), 9.0f));
+  assert(!occlusion_test_box(&buffer, vec3_new(20.0f, 0.0f, -20.0f), 1.0f));
+  // Straddling the wall's depth.
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -10.0f), 1.0f));
+  // Crossing the near plane, and entirely behind the camera.
+  assert(!vkr_occlusion_test_box(&buffer, mat4_identity(),
+                                 vec3_new(-1.0f, -1.0f, -20.0f),
+                                 vec3_new(1.0f, 1.0f, 1.0f)));
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, 20.0f), 1.0f));
+
+  arena_destroy(arena);
+  printf("  test_occlusion_front_occluder PASSED\n");
+}
+
+static void test_occlusion_back_faces(void) {
+  printf("  Running test_occlusion_back_faces...\n");
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, NULL);
+  const Mat4 model =
+      occlusion_test_quad_model(vec3_new(0.0f, 0.0f, -10.0f), 5.0f);
+  const VkrTriangleMeshSource back =
+      occlusion_test_quad(occlusion_test_quad_back);
+
+  // The GPU culls a single-sided back face, so it hides nothing.
+  VkrOcclusionBuffer buffer;
+  assert(vkr_occlusion_buffer_init(&buffer, &allocator,
+                                   occlusion_test_view_projection(), 64u));
+  assert(vkr_occlusion_add_occluder(&buffer, model, &back, false_v));
+  assert(buffer.triangle_count == 0u);
+  vkr_occlusion_rasterize(&buffer, &dispatch);
+  assert(!buffer.rasterized);
+  assert(!occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -20.0f), 1.0f));
+
+  assert(vkr_occlusion_buffer_init(&buffer, &allocator,
+                                   occlusion_test_view_projection(), 64u));
+  assert(vkr_occlusion_add_occluder(&buffer, model, &back, true_v));
+  assert(buffer.triangle_count == 2u);
+  vkr_occlusion_rasterize(&buffer, &dispatch);
+  assert(occlusion_test_box(&buffer, vec3_new(0.0f, 0.0f, -20.0f), 1.0f));
+
+  arena_destroy(arena);
+  printf("  test_occlusion_back_faces PASSED\n");
+}
+
+static void test_occlusion_budget(void) {
+  printf("  Running test_occlusion_budget...\n");
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+  const VkrTriangleMeshSource quad =
+      occlusion_test_quad(occlusion_test_quad_front);
+
+  VkrOcclusionBuffer buffer;
+  assert(vkr_occlusion_buffer_init(&buffer, &allocator,
+                                   occlusion_test_view_projection(), 3u));
+  assert(vkr_occlusion_add_occluder(
+      &buffer, occlusion_test_quad_model(vec3_new(0.0f, 0.0f, -10.0f), 5.0f),
+      &quad, false_v));
+  // The second quad does not fit whole, so none of it is kept.
+  assert(!vkr_occlusion_add_occluder(
+      &buffer, occlusion_test_quad_model(vec3_new(0.0f, 0.0f, -30.0f), 5.0f),
+      &quad, false_v));
+  assert(buffer.triangle_count == 2u && buffer.occluder_count == 1u);
+
+  // Off-screen triangles are clipped away and cost nothing.
+  assert(vkr_occlusion_add_occluder(
+      &buffer, occlusion_test_quad_model(vec3_new(0.0f, 0.0f, 10.0f), 5.0f),
+      &quad, false_v));
+  assert(buffer.triangle_count == 2u && buffer.occluder_count == 2u);
+
+  VkrTriangleMeshSource dense = quad;
+  dense.index_count = (VKR_OCCLUSION_OCCLUDER_MAX_TRIANGLES + 1u) * 3u;
+  assert(!vkr_occlusion_add_occluder(&buffer, mat4_identity(), &dense,
+                                     false_v));
+
+  arena_destroy(arena);
+  printf("  test_occlusion_budget PASSED\n");
+}
+
+/* Deterministic scatter so failures reproduce. */
+static float32_t occlusion_test_random(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return (float32_t)(*state >> 8) / (float32_t)(1u << 24);
+}
+
+static void occlusion_test_scatter(VkrOcclusionBuffer *buffer) {
+  const VkrTriangleMeshSource quad =
+      occlusion_test_quad(occlusion_test_quad_front);
+  uint32_t state = 11u;
+  for (uint32_t i = 0; i < 200u; ++i) {
+    const Vec3 center =
+        vec3_new(occlusion_test_random(&state) * 80.0f - 40.0f,
+                 occlusion_test_random(&state) * 40.0f - 20.0f,
+                 -5.0f - occlusion_test_random(&state) * 60.0f);
+    const float32_t half = 0.5f + occlusion_test_random(&state) * 4.0f;
+    assert(vkr_occlusion_add_occluder(
+        buffer, occlusion_test_quad_model(center, half), &quad, true_v));
+  }
+}
+
+static void test_occlusion_parallel_matches_serial(void) {
+  printf("  Running test_occlusion_parallel_matches_serial...\n");
+  Arena *arena = arena_create(MB(4), MB(4));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrOcclusionBuffer serial;
+  assert(vkr_occlusion_buffer_init(&serial, &allocator,
+                                   occlusion_test_view_projection(),
+                                   VKR_OCCLUSION_DEFAULT_TRIANGLE_BUDGET));
+  occlusion_test_scatter(&serial);
+  VkrParallelFor serial_dispatch;
+  vkr_parallel_for_init(&serial_dispatch, NULL);
+  vkr_occlusion_rasterize(&serial, &serial_dispatch);
+  assert(serial.rasterized && serial.triangle_count > 0u);
+
+  // The dispatcher outlives the job system; see vkr_parallel_for.h.
+  VkrParallelFor dispatch;
+  VkrJobSystem system;
+  VkrJobSystemConfig cfg = vkr_job_system_config_default();
+  cfg.worker_count = Max(2u, Min(4u, vkr_platform_get_logical_core_count()));
+  cfg.max_jobs = 16;
+  cfg.queue_capacity = 16;
+  assert(vkr_job_system_init(&cfg, &system) && "Job system init failed");
+  vkr_parallel_for_init(&dispatch, &system);
+
+  VkrOcclusionBuffer parallel;
+  assert(vkr_occlusion_buffer_init(&parallel, &allocator,
+                                   occlusion_test_view_projection(),
+                                   VKR_OCCLUSION_DEFAULT_TRIANGLE_BUDGET));
+  occlusion_test_scatter(&parallel);
+  for (uint32_t round = 0; round < 4u; ++round) {
+    vkr_occlusion_rasterize(&parallel, &dispatch);
+    assert(MemCompare(serial.depth, parallel.depth,
+                      sizeof(*serial.depth) * VKR_OCCLUSION_WIDTH *
+                          VKR_OCCLUSION_HEIGHT) == 0);
+    assert(MemCompare(serial.tile_max, parallel.tile_max,
+                      sizeof(serial.tile_max)) == 0);
+  }
+
+  vkr_parallel_for_wait_idle(&dispatch);
+  vkr_job_system_shutdown(&system);
+  arena_destroy(arena);
+  printf("  test_occlusion_parallel_matches_serial PASSED\n");
+}
+
+bool32_t run_occlusion_tests(void) {
+  printf("--- Running occlusion tests... ---\n");
+  test_occlusion_front_occluder();
+  test_occlusion_back_faces();
+  test_occlusion_budget();
+  test_occlusion_parallel_matches_serial();
+  printf("--- Occlusion tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "defines.h"
+
+bool32_t run_occlusion_tests(void);
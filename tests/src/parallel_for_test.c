@@ -0,0 +1,156 @@
+#include "parallel_for_test.h"
+
+#include <stdatomic.h>
+
+#define PARALLEL_FOR_TEST_MAX_CHUNKS 512u
+
+typedef struct ParallelForTestState {
+  atomic_uint chunk_runs[PARALLEL_FOR_TEST_MAX_CHUNKS];
+  uint32_t chunk_first[PARALLEL_FOR_TEST_MAX_CHUNKS];
+  uint32_t chunk_count[PARALLEL_FOR_TEST_MAX_CHUNKS];
+  /** Odd items each chunk keeps, merged afterwards in chunk order. */
+  uint32_t chunk_kept[PARALLEL_FOR_TEST_MAX_CHUNKS];
+  const uint32_t *items;
+} ParallelForTestState;
+
+static void parallel_for_test_chunk(void *context, uint32_t chunk_index,
+                                    uint32_t first, uint32_t count) {
+  ParallelForTestState *state = context;
+  atomic_fetch_add_explicit(&state->chunk_runs[chunk_index], 1u,
+                            memory_order_relaxed);
+  state->chunk_first[chunk_index] = first;
+  state->chunk_count[chunk_index] = count;
+  uint32_t kept = 0u;
+  for (uint32_t i = first; i < first + count; ++i) {
+    kept += state->items[i] & 1u;
+  }
+  state->chunk_kept[chunk_index] = kept;
+}
+
+static void parallel_for_test_reset(ParallelForTestState *state,
+                                    const uint32_t *items) {
+  for (uint32_t i = 0; i < PARALLEL_FOR_TEST_MAX_CHUNKS; ++i) {
+    atomic_store_explicit(&state->chunk_runs[i], 0u, memory_order_relaxed);
+  }
+  MemZero(state->chunk_first, sizeof(state->chunk_first));
+  MemZero(state->chunk_count, sizeof(state->chunk_count));
+  MemZero(state->chunk_kept, sizeof(state->chunk_kept));
+  state->items = items;
+}
+
+/** Every chunk ran once, the ranges tile the items and the merge is exact. */
+static void parallel_for_test_check(const ParallelForTestState *state,
+                                    const VkrParallelForStats *stats,
+                                    const uint32_t *items, uint32_t item_count,
+                                    uint32_t chunk_size) {
+  assert(stats->chunks ==
+         vkr_parallel_for_chunk_count(item_count, chunk_size));
+  uint32_t next = 0u;
+  uint32_t kept = 0u;
+  for (uint32_t c = 0; c < stats->chunks; ++c) {
+    assert(atomic_load_explicit(&state->chunk_runs[c],
+                                memory_order_relaxed) == 1u);
+    assert(state->chunk_first[c] == next);
+    assert(state->chunk_count[c] > 0u &&
+           state->chunk_count[c] <= chunk_size);
+    next += state->chunk_count[c];
+    kept += state->chunk_kept[c];
+  }
+  assert(next == item_count);
+  assert(atomic_load_explicit(&state->chunk_runs[stats->chunks],
+                              memory_order_relaxed) == 0u);
+
+  uint32_t expected = 0u;
+  for (uint32_t i = 0; i < item_count; ++i) {
+    expected += items[i] & 1u;
+  }
+  assert(kept == expected);
+}
+
+static void test_parallel_for_chunking(void) {
+  printf("  Running test_parallel_for_chunking...\n");
+  assert(vkr_parallel_for_chunk_count(0u, 64u) == 0u);
+  assert(vkr_parallel_for_chunk_count(1u, 64u) == 1u);
+  assert(vkr_parallel_for_chunk_count(64u, 64u) == 1u);
+  assert(vkr_parallel_for_chunk_count(65u, 64u) == 2u);
+  assert(vkr_parallel_for_chunk_count(10u, 0u) == 0u);
+  assert(vkr_parallel_for_chunk_count(UINT32_MAX, 1u) == UINT32_MAX);
+  printf("  test_parallel_for_chunking PASSED\n");
+}
+
+static void test_parallel_for_caller_only(void) {
+  printf("  Running test_parallel_for_caller_only...\n");
+  static uint32_t items[1000];
+  for (uint32_t i = 0; i < ArrayCount(items); ++i) {
+    items[i] = i * 2654435761u;
+  }
+  static ParallelForTestState state;
+  VkrParallelFor dispatch;
+  vkr_parallel_for_init(&dispatch, NULL);
+
+  parallel_for_test_reset(&state, items);
+  VkrParallelForStats stats = vkr_parallel_for_run(
+      &dispatch, ArrayCount(items), 64u, parallel_for_test_chunk, &state);
+  assert(stats.chunks == 16u);
+  assert(stats.caller_chunks == 16u && stats.helpers_submitted == 0u);
+  parallel_for_test_check(&state, &stats, items, ArrayCount(items), 64u);
+
+  parallel_for_test_reset(&state, items);
+  stats = vkr_parallel_for_run(&dispatch, 0u, 64u, parallel_for_test_chunk,
+                               &state);
+  assert(stats.chunks == 0u && stats.caller_chunks == 0u);
+  assert(atomic_load_explicit(&state.chunk_runs[0], memory_order_relaxed) ==
+         0u);
+  printf("  test_parallel_for_caller_only PASSED\n");
+}
+
+static void test_parallel_for_with_helpers(void) {
+  printf("  Running test_parallel_for_with_helpers...\n");
+  static uint32_t items[4096];
+  for (uint32_t i = 0; i < ArrayCount(items); ++i) {
+    items[i] = (i * 7919u) ^ (i >> 3);
+  }
+  static ParallelForTestState state;
+  // Helpers that are still queued when the job system stops only reference
+  // the dispatcher, which therefore outlives the job system here.
+  VkrParallelFor dispatch;
+  VkrJobSystem system;
+  VkrJobSystemConfig cfg = vkr_job_system_config_default();
+  cfg.worker_count = Max(2u, Min(4u, vkr_platform_get_logical_core_count()));
+  cfg.max_jobs = 16;
+  cfg.queue_capacity = 16;
+  assert(vkr_job_system_init(&cfg, &system) && "Job system init failed");
+  vkr_parallel_for_init(&dispatch, &system);
+
+  // Repeated dispatches of varying shape let helpers from one dispatch start
+  // during the next; each must still run every chunk exactly once.
+  uint32_t helpers = 0u;
+  for (uint32_t round = 0; round < 200u; ++round) {
+    const uint32_t item_count = 1u + (round * 389u) % ArrayCount(items);
+    const uint32_t chunk_size = 16u + (round % 5u) * 8u;
+    parallel_for_test_reset(&state, items);
+    const VkrParallelForStats stats = vkr_parallel_for_run(
+        &dispatch, item_count, chunk_size, parallel_for_test_chunk, &state);
+    assert(stats.chunks <= PARALLEL_FOR_TEST_MAX_CHUNKS - 1u);
+    assert(stats.helpers_submitted <= cfg.worker_count);
+    assert(stats.caller_chunks <= stats.chunks);
+    parallel_for_test_check(&state, &stats, items, item_count, chunk_size);
+    helpers += stats.helpers_submitted;
+  }
+  assert(helpers > 0u);
+
+  vkr_parallel_for_wait_idle(&dispatch);
+  assert(atomic_load_explicit(&dispatch.helpers_pending,
+                              memory_order_relaxed) == 0u);
+  vkr_job_system_shutdown(&system);
+  printf("  test_parallel_for_with_helpers PASSED\n");
+}
+
+bool32_t run_parallel_for_tests(void) {
+  printf("--- Running parallel for tests... ---\n");
+  test_parallel_for_chunking();
+  test_parallel_for_caller_only();
+  test_parallel_for_with_helpers();
+  printf("--- Parallel for tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "core/vkr_parallel_for.h"
+#include "platform/vkr_platform.h"
+#include "vkr_pch.h"
+
+bool32_t run_parallel_for_tests(void);
@@ -0,0 +1,200 @@
+#include "pipeline_manifest_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define PIPELINE_MANIFEST_TEST_DEVICE 0x1234ull
+
+typedef struct PipelineManifestTestState {
+  uint32_t color_format;
+  uint32_t depth_format;
+  uint32_t flags;
+} PipelineManifestTestState;
+
+static const uint32_t pipeline_manifest_test_vertex[] = {
+    0x07230203u, 0x00010600u, 0u, 32u, 0u, 0x00020011u, 1u,
+};
+static const uint32_t pipeline_manifest_test_fragment[] = {
+    0x07230203u, 0x00010600u, 0u, 48u, 0u, 0x00020011u, 1u, 0x0003000Eu,
+};
+
+static VkrPipelineDesc
+pipeline_manifest_test_desc(const PipelineManifestTestState *state) {
+  return (VkrPipelineDesc){
+      .name = "world_blend",
+      .kind = VKR_PIPELINE_KIND_GRAPHICS,
+      .stages =
+          {
+              {
+                  .code_key = vkr_pipeline_code_key(
+                      pipeline_manifest_test_vertex,
+                      sizeof(pipeline_manifest_test_vertex)),
+                  .entry = "world_vertex",
+                  .push_constant_size = 128u,
+              },
+              {
+                  .code_key = vkr_pipeline_code_key(
+                      pipeline_manifest_test_fragment,
+                      sizeof(pipeline_manifest_test_fragment)),
+                  .entry = "world_fragment",
+                  .push_constant_size = 128u,
+              },
+          },
+      .stage_count = 2u,
+      .layout = {.set_layout_count = 2u,
+                 .push_constant_size = 128u,
+                 .push_constant_stages = 0x31u},
+      .state = state,
+      .state_size = sizeof(*state),
+  };
+}
+
+static void test_pipeline_key_tracks_inputs(void) {
+  printf("  Running test_pipeline_key_tracks_inputs...\n");
+  const PipelineManifestTestState state = {97u, 126u, 1u};
+  const VkrPipelineDesc base = pipeline_manifest_test_desc(&state);
+  const uint64_t key = vkr_pipeline_desc_key(&base);
+  assert(key == vkr_pipeline_desc_key(&base));
+
+  // The name identifies the slot, not the compiled result.
+  VkrPipelineDesc desc = base;
+  desc.name = "ui";
+  assert(vkr_pipeline_desc_key(&desc) == key);
+
+  uint32_t edited[ArrayCount(pipeline_manifest_test_fragment)];
+  MemCopy(edited, pipeline_manifest_test_fragment, sizeof(edited));
+  edited[3] = 49u;
+  desc = base;
+  desc.stages[1].code_key = vkr_pipeline_code_key(edited, sizeof(edited));
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  desc = base;
+  desc.stages[1].entry = "picking_fragment";
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  desc = base;
+  desc.stages[0].push_constant_size = 112u;
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  desc = base;
+  desc.layout.set_layout_count = 3u;
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  const PipelineManifestTestState blended = {97u, 126u, 3u};
+  desc = pipeline_manifest_test_desc(&blended);
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  // A depth-only variant drops the fragment stage.
+  desc = base;
+  desc.stage_count = 1u;
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  desc = base;
+  desc.kind = VKR_PIPELINE_KIND_COMPUTE;
+  assert(vkr_pipeline_desc_key(&desc) != key);
+
+  // Tail bytes and length both count.
+  const uint8_t bytes[9] = {1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 0u};
+  assert(vkr_pipeline_code_key(bytes, 8u) != vkr_pipeline_code_key(bytes, 9u));
+  assert(vkr_pipeline_name_id("ibl_equirect") !=
+         vkr_pipeline_name_id("ibl_irradiance"));
+  printf("  test_pipeline_key_tracks_inputs PASSED\n");
+}
+
+static void test_pipeline_manifest_warm_lookup(void) {
+  printf("  Running test_pipeline_manifest_warm_lookup...\n");
+  VkrPipelineManifest manifest;
+  vkr_pipeline_manifest_reset(&manifest, PIPELINE_MANIFEST_TEST_DEVICE);
+  const uint64_t world = vkr_pipeline_name_id("world_blend");
+  const uint64_t hzb = vkr_pipeline_name_id("vk_hzb_build");
+  assert(vkr_pipeline_manifest_record(&manifest, world, 11u, 5000u));
+  assert(vkr_pipeline_manifest_record(&manifest, hzb, 22u, 700u));
+
+  assert(vkr_pipeline_manifest_is_warm(&manifest,
+                                       PIPELINE_MANIFEST_TEST_DEVICE, world,
+                                       11u));
+  // A changed key, an unknown slot or another driver all compile cold.
+  assert(!vkr_pipeline_manifest_is_warm(&manifest,
+                                        PIPELINE_MANIFEST_TEST_DEVICE, world,
+                                        12u));
+  assert(!vkr_pipeline_manifest_is_warm(
+      &manifest, PIPELINE_MANIFEST_TEST_DEVICE,
+      vkr_pipeline_name_id("picking"), 11u));
+  assert(!vkr_pipeline_manifest_is_warm(&manifest, 0x9999ull, world, 11u));
+
+  // Re-recording a slot replaces it in place.
+  assert(vkr_pipeline_manifest_record(&manifest, world, 12u, 4000u));
+  assert(manifest.entry_count == 2u);
+  assert(vkr_pipeline_manifest_find(&manifest, world)->key == 12u);
+  assert(vkr_pipeline_manifest_find(&manifest, world)->compile_ns == 4000u);
+
+  VkrPipelineManifest unbound;
+  vkr_pipeline_manifest_reset(&unbound, 0u);
+  assert(vkr_pipeline_manifest_record(&unbound, world, 11u, 0u));
+  assert(!vkr_pipeline_manifest_is_warm(&unbound, 0u, world, 11u));
+
+  for (uint32_t i = manifest.entry_count;
+       i < VKR_PIPELINE_MANIFEST_MAX_ENTRIES; ++i) {
+    assert(vkr_pipeline_manifest_record(&manifest, 100u + i, i, 0u));
+  }
+  assert(!vkr_pipeline_manifest_record(&manifest, 1u, 1u, 0u));
+  assert(vkr_pipeline_manifest_record(&manifest, hzb, 23u, 0u));
+  printf("  test_pipeline_manifest_warm_lookup PASSED\n");
+}
+
+static void test_pipeline_manifest_round_trip(void) {
+  printf("  Running test_pipeline_manifest_round_trip...\n");
+  VkrPipelineManifest manifest;
+  vkr_pipeline_manifest_reset(&manifest, PIPELINE_MANIFEST_TEST_DEVICE);
+  for (uint32_t i = 0u; i < 5u; ++i) {
+    assert(vkr_pipeline_manifest_record(&manifest, 10u + i, 0xABC0u + i,
+                                        1000u * i));
+  }
+
+  uint8_t buffer[4096];
+  const uint64_t size = vkr_pipeline_manifest_size(&manifest);
+  assert(size <= sizeof(buffer));
+  assert(vkr_pipeline_manifest_serialize(&manifest, buffer, size - 1u) == 0u);
+  assert(vkr_pipeline_manifest_serialize(&manifest, buffer, sizeof(buffer)) ==
+         size);
+
+  VkrPipelineManifest parsed;
+  assert(vkr_pipeline_manifest_parse(buffer, size, &parsed));
+  assert(parsed.device_key == PIPELINE_MANIFEST_TEST_DEVICE);
+  assert(parsed.entry_count == 5u);
+  assert(MemCompare(parsed.entries, manifest.entries,
+                    5u * sizeof(manifest.entries[0])) == 0);
+  assert(vkr_pipeline_manifest_is_warm(&parsed, PIPELINE_MANIFEST_TEST_DEVICE,
+                                       12u, 0xABC2u));
+
+  // Truncated, corrupted and foreign files are rejected and leave an empty,
+  // unbound manifest so every pipeline compiles cold.
+  assert(!vkr_pipeline_manifest_parse(buffer, size - 1u, &parsed));
+  assert(parsed.entry_count == 0u && parsed.device_key == 0u);
+  buffer[size - 1u] ^= 0x5Au;
+  assert(!vkr_pipeline_manifest_parse(buffer, size, &parsed));
+  buffer[size - 1u] ^= 0x5Au;
+  assert(vkr_pipeline_manifest_parse(buffer, size, &parsed));
+  buffer[0] ^= 0xFFu;
+  assert(!vkr_pipeline_manifest_parse(buffer, size, &parsed));
+  assert(!vkr_pipeline_manifest_parse(NULL, 0u, &parsed));
+
+  VkrPipelineManifest empty;
+  vkr_pipeline_manifest_reset(&empty, PIPELINE_MANIFEST_TEST_DEVICE);
+  const uint64_t empty_size =
+      vkr_pipeline_manifest_serialize(&empty, buffer, sizeof(buffer));
+  assert(empty_size > 0u);
+  assert(vkr_pipeline_manifest_parse(buffer, empty_size, &parsed));
+  assert(parsed.entry_count == 0u);
+  assert(parsed.device_key == PIPELINE_MANIFEST_TEST_DEVICE);
+  printf("  test_pipeline_manifest_round_trip PASSED\n");
+}
+
+bool32_t run_pipeline_manifest_tests() {
+  printf("--- Running pipeline manifest tests... ---\n");
+  test_pipeline_key_tracks_inputs();
+  test_pipeline_manifest_warm_lookup();
+  test_pipeline_manifest_round_trip();
+  printf("--- Pipeline manifest tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "core/logger.h"
+#include "renderer/vkr_pipeline_manifest.h"
+#include "vkr_pch.h"
+
+bool32_t run_pipeline_manifest_tests();
@@ -59,10 +59,27 @@ static void test_vulkan_platform_availability(void) {
   printf("  test_vulkan_platform_availability PASSED\n");
 }
 
+static void test_null_available_on_every_platform(void) {
+  printf("  Running test_null_available_on_every_platform...\n");
+  VkrRendererImpl impl = {0};
+  const VkrRendererImplOps null_ops = {0};
+  const VkrRendererImplStrategies strategies = {.null = &null_ops};
+  assert(vkr_renderer_impl_select(VKR_RENDERER_BACKEND_TYPE_NULL,
+                                  VKR_PRESENT_TARGET_OFFSCREEN, &strategies,
+                                  &impl));
+  assert(impl.kind == VKR_RENDERER_IMPL_NULL);
+  assert(impl.ops == &null_ops);
+  assert(impl.initialization_supported);
+  assert(impl.caps.present_target_kind == VKR_PRESENT_TARGET_OFFSCREEN);
+  assert(impl.caps.frame_in_flight_count == 3u);
+  printf("  test_null_available_on_every_platform PASSED\n");
+}
+
 bool32_t run_renderer_impl_tests(void) {
   printf("--- Running renderer implementation tests... ---\n");
   test_renderer_impl_capability_partition();
   test_vulkan_platform_availability();
+  test_null_available_on_every_platform();
   printf("--- Renderer implementation tests completed. ---\n");
   return true_v;
 }
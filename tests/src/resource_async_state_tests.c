@@ -2,6 +2,9 @@
 
 #include "memory/vkr_arena_allocator.h"
 #include "renderer/renderer_frontend.h"
+#include "renderer/systems/vkr_geometry_system.h"
+#include "renderer/systems/vkr_material_system.h"
+#include "renderer/systems/vkr_mesh_manager.h"
 #include "renderer/systems/vkr_resource_system.h"
 
 #include <assert.h>
@@ -49,8 +52,10 @@ typedef struct ResourceAsyncBudgetContext {
   atomic_uint prepare_calls;
   atomic_uint finalize_calls;
   atomic_uint release_calls;
+  atomic_uint unload_calls;
   uint32_t finalize_ops;
   uint64_t finalize_bytes;
+  uint32_t finalize_spin_us;
   atomic_uint token_counter;
 } ResourceAsyncBudgetContext;
 
@@ -58,6 +63,15 @@ typedef struct ResourceAsyncBudgetPayload {
   uint32_t token;
 } ResourceAsyncBudgetPayload;
 
+typedef struct ResourceAsyncMeshFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrAssetPublisher publisher;
+  VkrGeometrySystem geometry_system;
+  VkrMaterialSystem material_system;
+  VkrMeshManager manager;
+} ResourceAsyncMeshFixture;
+
 typedef struct ResourceAsyncSceneContext {
   atomic_uint prepare_calls;
   atomic_uint finalize_calls;
@@ -441,6 +455,12 @@ static bool8_t resource_async_budget_finalize(VkrResourceLoader *self,
   ResourceAsyncBudgetPayload *budget_payload =
       (ResourceAsyncBudgetPayload *)payload;
   atomic_fetch_add_explicit(&ctx->finalize_calls, 1u, memory_order_relaxed);
+  if (ctx->finalize_spin_us > 0) {
+    const float64_t until = vkr_platform_get_absolute_time() +
+                            (float64_t)ctx->finalize_spin_us * 0.000001;
+    while (vkr_platform_get_absolute_time() < until) {
+    }
+  }
 
   out_handle->type = VKR_RESOURCE_TYPE_SCENE;
   out_handle->as.scene = (VkrSceneHandle)(uintptr_t)budget_payload->token;
@@ -479,9 +499,93 @@ static void resource_async_budget_release_payload(VkrResourceLoader *self,
 static void resource_async_budget_unload(VkrResourceLoader *self,
                                          const VkrResourceHandleInfo *handle,
                                          String8 name) {
-  (void)self;
   (void)handle;
   (void)name;
+  assert(self != NULL);
+  ResourceAsyncBudgetContext *ctx =
+      (ResourceAsyncBudgetContext *)self->resource_system;
+  atomic_fetch_add_explicit(&ctx->unload_calls, 1u, memory_order_relaxed);
+}
+
+static bool8_t resource_async_stream_can_load(VkrResourceLoader *self,
+                                              String8 name) {
+  (void)self;
+  if (!name.str || name.length == 0) {
+    return false_v;
+  }
+  return string8_contains_cstr(&name, ".stream.mock");
+}
+
+/** Budget-loader finalize that hands back a (never dereferenced) mesh. */
+static bool8_t resource_async_stream_finalize(VkrResourceLoader *self,
+                                              String8 name, void *payload,
+                                              VkrResourceHandleInfo *out_handle,
+                                              VkrRendererError *out_error) {
+  (void)name;
+  assert(self != NULL);
+  assert(payload != NULL);
+  assert(out_handle != NULL);
+  assert(out_error != NULL);
+
+  ResourceAsyncBudgetContext *ctx =
+      (ResourceAsyncBudgetContext *)self->resource_system;
+  ResourceAsyncBudgetPayload *budget_payload =
+      (ResourceAsyncBudgetPayload *)payload;
+  atomic_fetch_add_explicit(&ctx->finalize_calls, 1u, memory_order_relaxed);
+
+  out_handle->type = VKR_RESOURCE_TYPE_MESH;
+  out_handle->as.mesh = (VkrMeshLoaderResult *)(uintptr_t)budget_payload->token;
+  *out_error = VKR_RENDERER_ERROR_NONE;
+  return true_v;
+}
+
+static bool8_t
+resource_async_mesh_publish_geometry(void *state, VkrGeometryHandle handle,
+                                     const VkrGeometryConfig *config) {
+  (void)state;
+  (void)handle;
+  (void)config;
+  return true_v;
+}
+
+static bool8_t
+resource_async_mesh_unpublish_geometry(void *state, VkrGeometryHandle handle) {
+  (void)state;
+  (void)handle;
+  return true_v;
+}
+
+static void
+resource_async_mesh_fixture_init(ResourceAsyncMeshFixture *fixture) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+
+  fixture->publisher = (VkrAssetPublisher){
+      .publish_geometry = resource_async_mesh_publish_geometry,
+      .unpublish_geometry = resource_async_mesh_unpublish_geometry,
+  };
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  const VkrGeometrySystemConfig geometry_config = {
+      .max_geometries = 16u,
+      .asset_publisher = &fixture->publisher,
+  };
+  assert(vkr_geometry_system_init(&fixture->geometry_system, &geometry_config,
+                                  &error));
+  fixture->material_system.materials =
+      array_create_VkrMaterial(&fixture->allocator, 1u);
+
+  const VkrMeshManagerConfig config = {.max_mesh_count = 8u};
+  assert(vkr_mesh_manager_init(&fixture->manager, &fixture->geometry_system,
+                               &fixture->material_system, &config));
+}
+
+static void
+resource_async_mesh_fixture_shutdown(ResourceAsyncMeshFixture *fixture) {
+  vkr_mesh_manager_shutdown(&fixture->manager);
+  vkr_geometry_system_shutdown(&fixture->geometry_system);
+  arena_destroy(fixture->arena);
 }
 
 static bool8_t resource_async_scene_can_load(VkrResourceLoader *self,
@@ -1201,6 +1305,450 @@ static void test_resource_async_gpu_budget_throttles_finalize(
   printf("  test_resource_async_gpu_budget_throttles_finalize PASSED\n");
 }
 
+static bool8_t
+resource_async_wait_all_pending_gpu(const VkrResourceHandleInfo *handles,
+                                    uint32_t count) {
+  for (uint32_t attempt = 0; attempt < 400; ++attempt) {
+    vkr_resource_system_pump(NULL);
+    bool8_t all_pending_gpu = true_v;
+    for (uint32_t i = 0; i < count; ++i) {
+      VkrRendererError err = VKR_RENDERER_ERROR_NONE;
+      VkrResourceLoadState state =
+          vkr_resource_system_get_state(&handles[i], &err);
+      assert(state != VKR_RESOURCE_LOAD_STATE_FAILED);
+      if (state != VKR_RESOURCE_LOAD_STATE_PENDING_GPU) {
+        all_pending_gpu = false_v;
+      }
+    }
+    if (all_pending_gpu) {
+      return true_v;
+    }
+    vkr_platform_sleep(2);
+  }
+  return false_v;
+}
+
+static void test_resource_async_priority_orders_finalize(
+    VkrAllocator *allocator, RendererFrontend *renderer,
+    ResourceAsyncMockBackendState *backend_state) {
+  printf("  Running test_resource_async_priority_orders_finalize...\n");
+
+  const String8 paths[3] = {
+      string8_lit("tests/assets/far.budget.mock"),
+      string8_lit("tests/assets/near.budget.mock"),
+      string8_lit("tests/assets/mid.budget.mock"),
+  };
+  const VkrResourceStreamingHint hints[3] = {
+      {.screen_coverage = 0.01f, .camera_distance = 400.0f},
+      {.screen_coverage = 0.50f, .camera_distance = 2.0f},
+      {.screen_coverage = 0.10f, .camera_distance = 40.0f},
+  };
+  VkrResourceHandleInfo handles[3] = {0};
+
+  renderer->frame_active = false_v;
+  for (uint32_t i = 0; i < 3; ++i) {
+    VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+    assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, paths[i],
+                                    allocator, &handles[i], &error) == true_v);
+    vkr_resource_system_update_streaming(&handles[i], &hints[i]);
+  }
+  assert(resource_async_wait_all_pending_gpu(handles, 3) == true_v);
+
+  renderer->frame_active = true_v;
+  backend_state->submit_serial = 90;
+  backend_state->completed_submit_serial = 128;
+
+  // One upload op per pump: the order of READY transitions is the order the
+  // scheduler served the requests in.
+  const VkrResourceAsyncBudget one_op_budget = {
+      .max_finalize_requests = 8,
+      .max_gpu_upload_ops = 1,
+      .max_gpu_upload_bytes = 1024u,
+  };
+  const uint32_t expected_order[3] = {1u, 2u, 0u};
+  for (uint32_t step = 0; step < 3; ++step) {
+    vkr_resource_system_pump(&one_op_budget);
+    for (uint32_t i = 0; i < 3; ++i) {
+      bool8_t served = false_v;
+      for (uint32_t k = 0; k <= step; ++k) {
+        served = served || expected_order[k] == i;
+      }
+      assert(vkr_resource_system_is_ready(&handles[i]) == served);
+    }
+  }
+
+  for (uint32_t i = 0; i < 3; ++i) {
+    vkr_resource_system_unload(&handles[i], paths[i]);
+  }
+  renderer->frame_active = false_v;
+
+  printf("  test_resource_async_priority_orders_finalize PASSED\n");
+}
+
+/**
+ * Pending mesh assets are ranked by the camera the mesh manager is handed,
+ * not by request order: the near instance first, then the far one, then the
+ * asset whose only instance is hidden.
+ */
+static void test_resource_async_mesh_manager_hints_order_finalize(
+    VkrAllocator *allocator, RendererFrontend *renderer,
+    ResourceAsyncMockBackendState *backend_state,
+    ResourceAsyncBudgetContext *ctx) {
+  (void)allocator;
+  printf(
+      "  Running test_resource_async_mesh_manager_hints_order_finalize...\n");
+
+  ResourceAsyncMeshFixture fixture;
+  resource_async_mesh_fixture_init(&fixture);
+  VkrMeshManager *manager = &fixture.manager;
+
+  const String8 paths[3] = {
+      string8_lit("tests/assets/far.stream.mock"),
+      string8_lit("tests/assets/near.stream.mock"),
+      string8_lit("tests/assets/hidden.stream.mock"),
+  };
+  const Vec3 positions[3] = {vec3_new(0.0f, 0.0f, -300.0f),
+                             vec3_new(0.0f, 0.0f, -4.0f),
+                             vec3_new(0.0f, 0.0f, -10.0f)};
+  VkrMeshAssetHandle assets[3] = {0};
+  VkrMeshInstanceHandle instances[3] = {0};
+  VkrResourceHandleInfo handles[3] = {0};
+
+  renderer->frame_active = false_v;
+  for (uint32_t i = 0; i < 3; ++i) {
+    VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+    assets[i] = vkr_mesh_manager_acquire_asset(
+        manager, paths[i], VKR_PIPELINE_DOMAIN_WORLD, (String8){0}, &error);
+    assert(assets[i].id != 0);
+    instances[i] = vkr_mesh_manager_create_instance(
+        manager, assets[i], mat4_translate(positions[i]), i + 1u, i != 2u,
+        &error);
+    assert(instances[i].id != 0);
+    handles[i] = (VkrResourceHandleInfo){
+        .type = VKR_RESOURCE_TYPE_MESH,
+        .request_id =
+            vkr_mesh_manager_get_live_asset(manager, assets[i])
+                ->pending_request_id,
+    };
+    assert(handles[i].request_id != 0);
+  }
+  assert(resource_async_wait_all_pending_gpu(handles, 3) == true_v);
+
+  const Mat4 projection =
+      mat4_perspective(vkr_to_radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+  vkr_mesh_manager_update_streaming(manager, vec3_zero(), &projection);
+
+  renderer->frame_active = true_v;
+  backend_state->submit_serial = 100;
+  backend_state->completed_submit_serial = 128;
+  const VkrResourceAsyncBudget one_op_budget = {
+      .max_finalize_requests = 8,
+      .max_gpu_upload_ops = 1,
+      .max_gpu_upload_bytes = 1024u,
+  };
+  const uint32_t expected_order[3] = {1u, 0u, 2u};
+  for (uint32_t step = 0; step < 3; ++step) {
+    vkr_resource_system_pump(&one_op_budget);
+    for (uint32_t i = 0; i < 3; ++i) {
+      bool8_t served = false_v;
+      for (uint32_t k = 0; k <= step; ++k) {
+        served = served || expected_order[k] == i;
+      }
+      assert(vkr_resource_system_is_ready(&handles[i]) == served);
+    }
+  }
+
+  // The fake results are never built into assets; dropping the last holder
+  // unloads the requests straight from the resource system.
+  const uint32_t unload_before =
+      atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed);
+  for (uint32_t i = 0; i < 3; ++i) {
+    assert(vkr_mesh_manager_destroy_instance(manager, instances[i]));
+    vkr_mesh_manager_release_asset(manager, assets[i]);
+  }
+  assert(atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed) ==
+         unload_before + 3u);
+  renderer->frame_active = false_v;
+  resource_async_mesh_fixture_shutdown(&fixture);
+
+  printf("  test_resource_async_mesh_manager_hints_order_finalize PASSED\n");
+}
+
+/**
+ * Dependencies a hinted mesh loads while preparing take its hint. Mesh results
+ * are never cached, but the dependency they drop on unload is, until the
+ * resident budget is lowered.
+ */
+static void test_resource_async_dependency_inherits_hint(
+    VkrAllocator *allocator, RendererFrontend *renderer,
+    ResourceAsyncDependencyContext *ctx) {
+  printf("  Running test_resource_async_dependency_inherits_hint...\n");
+
+  const String8 root_path = string8_lit("tests/assets/inherit_root.mock");
+  const String8 dep_path = string8_lit("tests/assets/dep_ok.mock");
+  vkr_resource_system_set_streaming_config(
+      &(VkrResourceStreamingConfig){.max_resident_bytes = MB(64)});
+
+  VkrResourceHandleInfo root = {0};
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  renderer->frame_active = true_v;
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_MESH, root_path, allocator,
+                                  &root, &error) == true_v);
+  const VkrResourceStreamingHint hint = {.screen_coverage = 0.3f,
+                                         .camera_distance = 6.0f};
+  vkr_resource_system_update_streaming(&root, &hint);
+  assert(resource_async_wait_for_state(&root, VKR_RESOURCE_LOAD_STATE_READY,
+                                       NULL) == true_v);
+
+  const uint32_t root_unload_before =
+      atomic_load_explicit(&ctx->root_unload_calls, memory_order_relaxed);
+  const uint32_t dep_unload_before =
+      atomic_load_explicit(&ctx->dep_unload_calls, memory_order_relaxed);
+  const uint32_t dep_prepare_before =
+      atomic_load_explicit(&ctx->dep_prepare_calls, memory_order_relaxed);
+  vkr_resource_system_unload(&root, root_path);
+  assert(atomic_load_explicit(&ctx->root_unload_calls, memory_order_relaxed) ==
+         root_unload_before + 1u);
+  assert(atomic_load_explicit(&ctx->dep_unload_calls, memory_order_relaxed) ==
+         dep_unload_before);
+
+  // The cached dependency serves the next load of its key without a reload.
+  VkrResourceHandleInfo dep = {0};
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_MATERIAL, dep_path,
+                                  allocator, &dep, &error) == true_v);
+  assert(vkr_resource_system_is_ready(&dep) == true_v);
+  assert(atomic_load_explicit(&ctx->dep_prepare_calls, memory_order_relaxed) ==
+         dep_prepare_before);
+  vkr_resource_system_unload(&dep, dep_path);
+  assert(atomic_load_explicit(&ctx->dep_unload_calls, memory_order_relaxed) ==
+         dep_unload_before);
+
+  vkr_resource_system_set_streaming_config(&(VkrResourceStreamingConfig){0});
+  assert(atomic_load_explicit(&ctx->dep_unload_calls, memory_order_relaxed) ==
+         dep_unload_before + 1u);
+  VkrRendererError state_error = VKR_RENDERER_ERROR_NONE;
+  assert(vkr_resource_system_get_state(&dep, &state_error) ==
+         VKR_RESOURCE_LOAD_STATE_INVALID);
+  renderer->frame_active = false_v;
+
+  printf("  test_resource_async_dependency_inherits_hint PASSED\n");
+}
+
+static void test_resource_async_in_flight_cap_defers_and_cancels(
+    VkrAllocator *allocator, ResourceAsyncSceneContext *ctx) {
+  printf("  Running test_resource_async_in_flight_cap_defers_and_cancels...\n");
+
+  const VkrResourceStreamingConfig capped = {.max_cpu_jobs_in_flight = 1};
+  vkr_resource_system_set_streaming_config(&capped);
+
+  String8 path_a = string8_lit("tests/assets/capped_a.scene.mock");
+  String8 path_b = string8_lit("tests/assets/capped_b.scene.mock");
+  VkrResourceHandleInfo handle_a = {0};
+  VkrResourceHandleInfo handle_b = {0};
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+
+  const uint32_t prepare_before =
+      atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed);
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, path_a, allocator,
+                                  &handle_a, &error) == true_v);
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, path_b, allocator,
+                                  &handle_b, &error) == true_v);
+
+  // The second request is held back by the cap, so canceling it is free.
+  vkr_resource_system_cancel(&handle_b);
+  VkrRendererError state_error = VKR_RENDERER_ERROR_NONE;
+  assert(vkr_resource_system_get_state(&handle_b, &state_error) ==
+         VKR_RESOURCE_LOAD_STATE_CANCELED);
+
+  assert(resource_async_wait_for_state(
+             &handle_a, VKR_RESOURCE_LOAD_STATE_PENDING_GPU, NULL) == true_v);
+  for (uint32_t i = 0; i < 8; ++i) {
+    vkr_resource_system_pump(NULL);
+  }
+  assert(vkr_resource_system_get_state(&handle_b, &state_error) ==
+         VKR_RESOURCE_LOAD_STATE_CANCELED);
+  assert(atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed) ==
+         prepare_before + 1u);
+
+  vkr_resource_system_unload(&handle_b, path_b);
+  vkr_resource_system_unload(&handle_a, path_a);
+  assert(resource_async_wait_for_state(&handle_a,
+                                       VKR_RESOURCE_LOAD_STATE_INVALID,
+                                       NULL) == true_v);
+  vkr_resource_system_set_streaming_config(&(VkrResourceStreamingConfig){0});
+
+  printf("  test_resource_async_in_flight_cap_defers_and_cancels PASSED\n");
+}
+
+static void test_resource_async_resident_budget_evicts_lru(
+    VkrAllocator *allocator, RendererFrontend *renderer,
+    ResourceAsyncMockBackendState *backend_state,
+    ResourceAsyncBudgetContext *ctx) {
+  printf("  Running test_resource_async_resident_budget_evicts_lru...\n");
+
+  const String8 paths[3] = {
+      string8_lit("tests/assets/lru_0.budget.mock"),
+      string8_lit("tests/assets/lru_1.budget.mock"),
+      string8_lit("tests/assets/lru_2.budget.mock"),
+  };
+  const VkrResourceStreamingHint hint = {.screen_coverage = 0.25f,
+                                         .camera_distance = 10.0f};
+  VkrResourceHandleInfo handles[3] = {0};
+  const uint64_t resident_before = vkr_resource_system_get_resident_bytes();
+
+  const VkrResourceStreamingConfig budget = {
+      .max_resident_bytes = resident_before + 2u * ctx->finalize_bytes};
+  vkr_resource_system_set_streaming_config(&budget);
+
+  renderer->frame_active = true_v;
+  backend_state->submit_serial = 140;
+  backend_state->completed_submit_serial = 256;
+  for (uint32_t i = 0; i < 3; ++i) {
+    VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+    assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, paths[i],
+                                    allocator, &handles[i], &error) == true_v);
+  }
+
+  // Everything hinted every frame stays resident even over budget.
+  bool8_t all_ready = false_v;
+  for (uint32_t attempt = 0; attempt < 400 && !all_ready; ++attempt) {
+    for (uint32_t i = 0; i < 3; ++i) {
+      vkr_resource_system_update_streaming(&handles[i], &hint);
+    }
+    vkr_resource_system_pump(NULL);
+    all_ready = true_v;
+    for (uint32_t i = 0; i < 3; ++i) {
+      all_ready = all_ready && vkr_resource_system_is_ready(&handles[i]);
+    }
+    if (!all_ready) {
+      vkr_platform_sleep(2);
+    }
+  }
+  assert(all_ready == true_v);
+  assert(vkr_resource_system_get_resident_bytes() ==
+         resident_before + 3u * ctx->finalize_bytes);
+
+  // Released holders leave both cached; the one dropped from view first is
+  // the least recently used and the only one evicted.
+  const uint32_t unload_before =
+      atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed);
+  vkr_resource_system_unload(&handles[0], paths[0]);
+  vkr_resource_system_unload(&handles[1], paths[1]);
+  assert(atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed) ==
+         unload_before);
+  vkr_resource_system_update_streaming(&handles[1], &hint);
+  vkr_resource_system_update_streaming(&handles[2], &hint);
+  vkr_resource_system_pump(NULL);
+  VkrRendererError state_error = VKR_RENDERER_ERROR_NONE;
+  assert(vkr_resource_system_get_state(&handles[0], &state_error) ==
+         VKR_RESOURCE_LOAD_STATE_INVALID);
+  assert(vkr_resource_system_is_ready(&handles[1]) == true_v);
+  assert(vkr_resource_system_is_ready(&handles[2]) == true_v);
+  assert(atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed) ==
+         unload_before + 1u);
+  assert(vkr_resource_system_get_resident_bytes() == budget.max_resident_bytes);
+
+  // Held resources are never evicted, even once out of view and over budget.
+  const VkrResourceStreamingConfig tight = {.max_resident_bytes =
+                                                 resident_before + 1u};
+  vkr_resource_system_set_streaming_config(&tight);
+  for (uint32_t i = 0; i < 2; ++i) {
+    vkr_resource_system_pump(NULL);
+  }
+  assert(vkr_resource_system_is_ready(&handles[2]) == true_v);
+  assert(atomic_load_explicit(&ctx->unload_calls, memory_order_relaxed) ==
+         unload_before + 2u);
+  vkr_resource_system_set_streaming_config(&budget);
+
+  // A cached key loads again from scratch once evicted.
+  const uint32_t prepare_before =
+      atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed);
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, paths[1], allocator,
+                                  &handles[1], &error) == true_v);
+  bool8_t reloaded = false_v;
+  for (uint32_t attempt = 0; attempt < 400 && !reloaded; ++attempt) {
+    vkr_resource_system_pump(NULL);
+    reloaded = vkr_resource_system_is_ready(&handles[1]);
+    if (!reloaded) {
+      vkr_platform_sleep(2);
+    }
+  }
+  assert(reloaded == true_v);
+  assert(atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed) ==
+         prepare_before + 1u);
+
+  // While cached, the next load of the key is served without a reload.
+  vkr_resource_system_update_streaming(&handles[1], &hint);
+  vkr_resource_system_unload(&handles[1], paths[1]);
+  vkr_resource_system_pump(NULL);
+  assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, paths[1], allocator,
+                                  &handles[1], &error) == true_v);
+  assert(vkr_resource_system_is_ready(&handles[1]) == true_v);
+  assert(atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed) ==
+         prepare_before + 1u);
+
+  vkr_resource_system_unload(&handles[1], paths[1]);
+  vkr_resource_system_unload(&handles[2], paths[2]);
+  vkr_resource_system_set_streaming_config(&(VkrResourceStreamingConfig){0});
+  assert(vkr_resource_system_get_resident_bytes() == resident_before);
+  renderer->frame_active = false_v;
+
+  printf("  test_resource_async_resident_budget_evicts_lru PASSED\n");
+}
+
+static void test_resource_async_finalize_time_budget_adapts(
+    VkrAllocator *allocator, RendererFrontend *renderer,
+    ResourceAsyncMockBackendState *backend_state,
+    ResourceAsyncBudgetContext *ctx) {
+  printf("  Running test_resource_async_finalize_time_budget_adapts...\n");
+
+  const String8 paths[3] = {
+      string8_lit("tests/assets/time_0.budget.mock"),
+      string8_lit("tests/assets/time_1.budget.mock"),
+      string8_lit("tests/assets/time_2.budget.mock"),
+  };
+  VkrResourceHandleInfo handles[3] = {0};
+
+  renderer->frame_active = false_v;
+  for (uint32_t i = 0; i < 3; ++i) {
+    VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+    assert(vkr_resource_system_load(VKR_RESOURCE_TYPE_SCENE, paths[i],
+                                    allocator, &handles[i], &error) == true_v);
+  }
+  assert(resource_async_wait_all_pending_gpu(handles, 3) == true_v);
+
+  renderer->frame_active = true_v;
+  backend_state->submit_serial = 300;
+  backend_state->completed_submit_serial = 512;
+  ctx->finalize_spin_us = 200u;
+
+  // Op and byte limits admit everything; only the learned finalize time
+  // holds each pump to its one guaranteed finalize.
+  const VkrResourceAsyncBudget time_budget = {
+      .max_finalize_requests = 8,
+      .max_gpu_upload_ops = 64,
+      .max_gpu_upload_bytes = MB(64),
+      .max_finalize_ns = 1u,
+  };
+  for (uint32_t step = 1; step <= 3; ++step) {
+    vkr_resource_system_pump(&time_budget);
+    uint32_t ready = 0;
+    for (uint32_t i = 0; i < 3; ++i) {
+      ready += vkr_resource_system_is_ready(&handles[i]) ? 1u : 0u;
+    }
+    assert(ready == step);
+  }
+
+  ctx->finalize_spin_us = 0;
+  for (uint32_t i = 0; i < 3; ++i) {
+    vkr_resource_system_unload(&handles[i], paths[i]);
+  }
+  renderer->frame_active = false_v;
+
+  printf("  test_resource_async_finalize_time_budget_adapts PASSED\n");
+}
+
 static void
 test_scene_async_load_smoke(VkrAllocator *allocator, RendererFrontend *renderer,
                             ResourceAsyncMockBackendState *backend_state,
@@ -1276,6 +1824,8 @@ test_scene_reload_async_cancel(VkrAllocator *allocator,
   VkrResourceHandleInfo first = {0};
   VkrRendererError first_error = VKR_RENDERER_ERROR_NONE;
 
+  const uint32_t prepare_before =
+      atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed);
   const uint32_t release_before =
       atomic_load_explicit(&ctx->release_calls, memory_order_relaxed);
 
@@ -1334,9 +1884,14 @@ test_scene_reload_async_cancel(VkrAllocator *allocator,
   vkr_resource_system_unload(&reloaded, path);
   renderer->frame_active = false_v;
 
+  // The canceled request may skip its prepare if the job had not started;
+  // either way every payload that was prepared is released exactly once.
+  const uint32_t prepare_after =
+      atomic_load_explicit(&ctx->prepare_calls, memory_order_relaxed);
   const uint32_t release_after =
       atomic_load_explicit(&ctx->release_calls, memory_order_relaxed);
-  assert(release_after >= release_before + 2u);
+  assert(prepare_after >= prepare_before + 1u);
+  assert(release_after - release_before == prepare_after - prepare_before);
 
   printf("  test_scene_reload_async_cancel PASSED\n");
 }
@@ -1381,8 +1936,27 @@ bool32_t run_resource_async_state_tests(void) {
   assert(vkr_resource_system_register_loader(&dependency_ctx,
                                              dependency_loader) == true_v);
 
+  ResourceAsyncBudgetContext stream_ctx = {
+      .finalize_ops = 1,
+      .finalize_bytes = 1024u,
+  };
+  VkrResourceLoader stream_loader = {
+      .type = VKR_RESOURCE_TYPE_MESH,
+      .streaming_uncached = true_v,
+      .can_load = resource_async_stream_can_load,
+      .prepare_async = resource_async_budget_prepare,
+      .finalize_async = resource_async_stream_finalize,
+      .estimate_async_finalize_cost = resource_async_budget_estimate_cost,
+      .release_async_payload = resource_async_budget_release_payload,
+      .unload = resource_async_budget_unload,
+  };
+  assert(vkr_resource_system_register_loader(&stream_ctx, stream_loader) ==
+         true_v);
+
+  // Stands in for the mesh loader, whose results are never cached.
   VkrResourceLoader root_loader = {
       .type = VKR_RESOURCE_TYPE_MESH,
+      .streaming_uncached = true_v,
       .can_load = resource_async_root_can_load,
       .prepare_async = resource_async_root_prepare,
       .finalize_async = resource_async_root_finalize,
@@ -1396,8 +1970,10 @@ bool32_t run_resource_async_state_tests(void) {
       .prepare_calls = 0,
       .finalize_calls = 0,
       .release_calls = 0,
+      .unload_calls = 0,
       .finalize_ops = 1,
       .finalize_bytes = 2048u,
+      .finalize_spin_us = 0,
       .token_counter = 0,
   };
   VkrResourceLoader budget_loader = {
@@ -1449,6 +2025,18 @@ bool32_t run_resource_async_state_tests(void) {
       &allocator, &renderer, &backend_state);
   test_resource_async_gpu_budget_throttles_finalize(
       &allocator, &renderer, &backend_state, &budget_ctx);
+  test_resource_async_priority_orders_finalize(&allocator, &renderer,
+                                               &backend_state);
+  test_resource_async_mesh_manager_hints_order_finalize(
+      &allocator, &renderer, &backend_state, &stream_ctx);
+  test_resource_async_dependency_inherits_hint(&allocator, &renderer,
+                                               &dependency_ctx);
+  test_resource_async_in_flight_cap_defers_and_cancels(&allocator,
+                                                       &scene_ctx);
+  test_resource_async_resident_budget_evicts_lru(&allocator, &renderer,
+                                                 &backend_state, &budget_ctx);
+  test_resource_async_finalize_time_budget_adapts(&allocator, &renderer,
+                                                  &backend_state, &budget_ctx);
   test_scene_async_load_smoke(&allocator, &renderer, &backend_state,
                               &scene_ctx);
   test_scene_reload_async_cancel(&allocator, &renderer, &backend_state,
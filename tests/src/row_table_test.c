@@ -0,0 +1,272 @@
+#include "row_table_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define ROW_TABLE_TEST_ROWS 256u
+
+typedef struct RowTableTestRow {
+  uint32_t id;
+  float32_t value[3];
+} RowTableTestRow;
+
+typedef struct RowTableTestFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrRowTable table;
+  /** What the GPU destination would hold after replaying every commit. */
+  RowTableTestRow destination[ROW_TABLE_TEST_ROWS];
+} RowTableTestFixture;
+
+static void row_table_test_fixture_init(RowTableTestFixture *fixture,
+                                        uint32_t merge_gap) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+  assert(vkr_row_table_create(&fixture->table, &fixture->allocator,
+                              sizeof(RowTableTestRow), merge_gap));
+}
+
+static void row_table_test_fixture_shutdown(RowTableTestFixture *fixture) {
+  vkr_row_table_destroy(&fixture->table);
+  arena_destroy(fixture->arena);
+}
+
+/**
+ * Stages `rows`, commits them and replays the dirty ranges into the fixture
+ * destination, which must then match `rows` exactly.
+ */
+static uint32_t row_table_test_commit(RowTableTestFixture *fixture,
+                                      const RowTableTestRow *rows,
+                                      uint32_t count) {
+  RowTableTestRow *staged = vkr_row_table_begin(&fixture->table, count);
+  assert(staged);
+  MemCopy(staged, rows, (uint64_t)count * sizeof(*rows));
+  const VkrRowTableRange *ranges = NULL;
+  const uint32_t range_count =
+      vkr_row_table_commit(&fixture->table, count, &ranges);
+  const RowTableTestRow *resident = vkr_row_table_rows(&fixture->table);
+  uint32_t previous_end = 0u;
+  for (uint32_t r = 0u; r < range_count; ++r) {
+    assert(r == 0u || ranges[r].first_row > previous_end);
+    assert(ranges[r].row_count > 0u);
+    assert(ranges[r].first_row + ranges[r].row_count <= count);
+    MemCopy(&fixture->destination[ranges[r].first_row],
+            &resident[ranges[r].first_row],
+            (uint64_t)ranges[r].row_count * sizeof(*resident));
+    previous_end = ranges[r].first_row + ranges[r].row_count;
+  }
+  assert(MemCompare(fixture->destination, rows,
+                    (uint64_t)count * sizeof(*rows)) == 0);
+  assert(fixture->table.stats.rows == count);
+  assert(fixture->table.stats.upload_bytes ==
+         (uint64_t)fixture->table.stats.dirty_rows * sizeof(*rows));
+  return range_count;
+}
+
+static void row_table_test_fill(RowTableTestRow *rows, uint32_t count) {
+  for (uint32_t i = 0u; i < count; ++i) {
+    rows[i] = (RowTableTestRow){
+        .id = i,
+        .value = {(float32_t)i, 0.5f, -1.0f},
+    };
+  }
+}
+
+static void test_row_table_static_rows_upload_once(void) {
+  printf("  Running test_row_table_static_rows_upload_once...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 0u);
+  RowTableTestRow rows[32];
+  row_table_test_fill(rows, 32u);
+
+  assert(row_table_test_commit(&fixture, rows, 32u) == 1u);
+  assert(fixture.table.stats.dirty_rows == 32u);
+  for (uint32_t frame = 0u; frame < 3u; ++frame) {
+    assert(row_table_test_commit(&fixture, rows, 32u) == 0u);
+    assert(fixture.table.stats.upload_bytes == 0u);
+  }
+
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_table_static_rows_upload_once PASSED\n");
+}
+
+static void test_row_table_merges_close_ranges(void) {
+  printf("  Running test_row_table_merges_close_ranges...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 2u);
+  RowTableTestRow rows[64];
+  row_table_test_fill(rows, 64u);
+  row_table_test_commit(&fixture, rows, 64u);
+
+  // Rows 3 and 6 leave a two-row gap and join; row 20 stands alone.
+  rows[3].value[1] = 7.0f;
+  rows[6].value[1] = 7.0f;
+  rows[20].id = 99u;
+  assert(row_table_test_commit(&fixture, rows, 64u) == 2u);
+  assert(fixture.table.ranges[0].first_row == 3u);
+  assert(fixture.table.ranges[0].row_count == 4u);
+  assert(fixture.table.ranges[1].first_row == 20u);
+  assert(fixture.table.ranges[1].row_count == 1u);
+  assert(fixture.table.stats.dirty_rows == 5u);
+
+  // Rows 30 and 40 are too far apart to merge.
+  rows[30].id = 1000u;
+  rows[40].id = 1001u;
+  assert(row_table_test_commit(&fixture, rows, 64u) == 2u);
+  assert(fixture.table.stats.dirty_rows == 2u);
+
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_table_merges_close_ranges PASSED\n");
+}
+
+static void test_row_table_growth_and_shrink(void) {
+  printf("  Running test_row_table_growth_and_shrink...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 0u);
+  RowTableTestRow rows[ROW_TABLE_TEST_ROWS];
+  row_table_test_fill(rows, ROW_TABLE_TEST_ROWS);
+
+  row_table_test_commit(&fixture, rows, 10u);
+  // Growing past the initial capacity keeps the resident rows.
+  assert(row_table_test_commit(&fixture, rows, ROW_TABLE_TEST_ROWS) == 1u);
+  assert(fixture.table.ranges[0].first_row == 10u);
+  assert(fixture.table.stats.dirty_rows == ROW_TABLE_TEST_ROWS - 10u);
+
+  // Rows dropped by a shrink are rewritten when they come back.
+  assert(row_table_test_commit(&fixture, rows, 100u) == 0u);
+  assert(row_table_test_commit(&fixture, rows, 120u) == 1u);
+  assert(fixture.table.ranges[0].first_row == 100u);
+  assert(fixture.table.ranges[0].row_count == 20u);
+
+  // Committing fewer rows than were staged keeps only the committed ones.
+  RowTableTestRow *staged = vkr_row_table_begin(&fixture.table, 120u);
+  assert(staged);
+  MemCopy(staged, rows, 120u * sizeof(*rows));
+  assert(vkr_row_table_commit(&fixture.table, 80u, NULL) == 0u);
+  assert(fixture.table.resident_count == 80u);
+  assert(vkr_row_table_commit(&fixture.table, 1u, NULL) == 0u);
+  assert(fixture.table.resident_count == 80u);
+
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_table_growth_and_shrink PASSED\n");
+}
+
+static void test_row_table_invalidate_rewrites_all(void) {
+  printf("  Running test_row_table_invalidate_rewrites_all...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 0u);
+  RowTableTestRow rows[16];
+  row_table_test_fill(rows, 16u);
+  row_table_test_commit(&fixture, rows, 16u);
+
+  vkr_row_table_invalidate(&fixture.table);
+  MemZero(fixture.destination, sizeof(fixture.destination));
+  assert(row_table_test_commit(&fixture, rows, 16u) == 1u);
+  assert(fixture.table.stats.dirty_rows == 16u);
+  assert(vkr_row_table_begin(&fixture.table, 0u) == NULL);
+
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_table_invalidate_rewrites_all PASSED\n");
+}
+
+/**
+ * Places one row per key through `slots` and commits them; slots no key took
+ * this frame are staged as empty rows. Returns the dirty range count.
+ */
+static uint32_t row_table_test_commit_keyed(RowTableTestFixture *fixture,
+                                            VkrRowSlotMap *slots,
+                                            const uint32_t *keys,
+                                            uint32_t count) {
+  assert(vkr_row_slot_map_begin(slots, count));
+  RowTableTestRow rows[ROW_TABLE_TEST_ROWS];
+  for (uint32_t i = 0u; i < count; ++i) {
+    const uint32_t slot = vkr_row_slot_map_acquire(
+        slots, (VkrRowSlotKey){.owner = keys[i], .part = 1u});
+    assert(slot < ROW_TABLE_TEST_ROWS);
+    rows[slot] = (RowTableTestRow){.id = keys[i], .value = {1.0f}};
+  }
+  vkr_row_slot_map_end(slots);
+  for (uint32_t slot = 0u; slot < slots->slot_count; ++slot)
+    if (!vkr_row_slot_map_live(slots, slot))
+      rows[slot] = (RowTableTestRow){.id = UINT32_MAX};
+  return row_table_test_commit(fixture, rows, slots->slot_count);
+}
+
+static void test_row_slot_map_keeps_rows_in_place(void) {
+  printf("  Running test_row_slot_map_keeps_rows_in_place...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 0u);
+  VkrRowSlotMap slots;
+  assert(vkr_row_slot_map_create(&slots, &fixture.allocator));
+  uint32_t keys[200];
+  for (uint32_t i = 0u; i < 200u; ++i)
+    keys[i] = i * 7u;
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 200u) == 1u);
+
+  // Reordering the source moves no row.
+  for (uint32_t i = 0u; i < 100u; ++i) {
+    const uint32_t swap = keys[i];
+    keys[i] = keys[199u - i];
+    keys[199u - i] = swap;
+  }
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 200u) == 0u);
+
+  // A removal ahead of every other row dirties only its own slot, and the
+  // row inserted next takes that slot over.
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys + 1u, 199u) ==
+         1u);
+  assert(fixture.table.stats.dirty_rows == 1u);
+  assert(slots.free_count == 1u);
+  keys[0] = 5000u;
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 200u) == 1u);
+  assert(fixture.table.stats.dirty_rows == 1u);
+  assert(slots.slot_count == 200u);
+  assert(fixture.destination[fixture.table.ranges[0].first_row].id == 5000u);
+
+  vkr_row_slot_map_destroy(&slots);
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_slot_map_keeps_rows_in_place PASSED\n");
+}
+
+static void test_row_slot_map_duplicates_and_compaction(void) {
+  printf("  Running test_row_slot_map_duplicates_and_compaction...\n");
+  RowTableTestFixture fixture;
+  row_table_test_fixture_init(&fixture, 0u);
+  VkrRowSlotMap slots;
+  assert(vkr_row_slot_map_create(&slots, &fixture.allocator));
+
+  // A key drawn twice holds two slots and keeps both.
+  uint32_t keys[ROW_TABLE_TEST_ROWS];
+  for (uint32_t i = 0u; i < 150u; ++i)
+    keys[i] = i;
+  keys[150] = 3u;
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 151u) == 1u);
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 151u) == 0u);
+  assert(slots.live_count == 151u);
+
+  // Dropping most rows leaves holes until the next frame compacts them.
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 40u) > 0u);
+  assert(slots.slot_count == 151u);
+  assert(slots.live_count == 40u);
+  row_table_test_commit_keyed(&fixture, &slots, keys, 40u);
+  assert(slots.slot_count == 40u);
+  assert(row_table_test_commit_keyed(&fixture, &slots, keys, 40u) == 0u);
+
+  vkr_row_slot_map_destroy(&slots);
+  row_table_test_fixture_shutdown(&fixture);
+  printf("  test_row_slot_map_duplicates_and_compaction PASSED\n");
+}
+
+bool32_t run_row_table_tests() {
+  printf("--- Running row table tests... ---\n");
+  test_row_table_static_rows_upload_once();
+  test_row_table_merges_close_ranges();
+  test_row_table_growth_and_shrink();
+  test_row_table_invalidate_rewrites_all();
+  test_row_slot_map_keeps_rows_in_place();
+  test_row_slot_map_duplicates_and_compaction();
+  printf("--- Row table tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "core/logger.h"
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/vkr_row_table.h"
+#include "vkr_pch.h"
+
+bool32_t run_row_table_tests();
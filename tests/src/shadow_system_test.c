@@ -1,6 +1,8 @@
 #include "shadow_system_test.h"
 
 #include "math/vkr_math.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
 #include "renderer/renderer_frontend.h"
 #include "renderer/systems/vkr_camera.h"
 #include "renderer/systems/vkr_shadow_system.h"
@@ -386,6 +388,105 @@ static void test_shadow_raster_bias_packet_validation(void) {
                 "packet.shadow.config_override.depth_bias_clamp") == 0);
 }
 
+static void test_indexed_caster_fit_only_reads_overlapping_casters(void) {
+  Arena *arena = arena_create(KB(256), KB(256));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrMeshBoundsIndex index;
+  assert(vkr_mesh_bounds_index_init(&index, &allocator, 4u, 4u));
+  // One small caster under the rectangle and one tall caster well outside
+  // it. The scene AABB of the two spans both; the indexed fit must not.
+  vkr_mesh_bounds_index_set(&index, 0u, vec3_new(0.0f, 10.0f, 0.0f), 1.0f);
+  vkr_mesh_bounds_index_set(&index, 1u, vec3_new(100.0f, 40.0f, 0.0f), 1.0f);
+
+  const Mat4 light_view = mat4_look_at(vec3_new(0.0f, 50.0f, 0.0f),
+                                       vec3_zero(), vec3_new(0.0f, 0.0f, -1.0f));
+  float32_t min_z = 0.0f;
+  float32_t max_z = 0.0f;
+  assert(vkr_shadow_fit_indexed_caster_z(&light_view, &index, -5.0f, 5.0f,
+                                         -5.0f, 5.0f, &min_z, &max_z));
+  assert(fabsf(min_z - -41.0f) < 1e-3f);
+  assert(fabsf(max_z - -39.0f) < 1e-3f);
+
+  const VkrShadowSceneBounds scene = {
+      .min = vec3_new(-1.0f, 9.0f, -1.0f),
+      .max = vec3_new(101.0f, 41.0f, 1.0f),
+      .use_scene_bounds = true_v,
+  };
+  float32_t scene_min_z = 0.0f;
+  float32_t scene_max_z = 0.0f;
+  assert(vkr_shadow_fit_relevant_caster_z(&light_view, &scene, -5.0f, 5.0f,
+                                          -5.0f, 5.0f, &scene_min_z,
+                                          &scene_max_z));
+  assert(scene_max_z > max_z + 20.0f);
+
+  assert(!vkr_shadow_fit_indexed_caster_z(&light_view, &index, 200.0f, 210.0f,
+                                          200.0f, 210.0f, &min_z, &max_z));
+
+  vkr_mesh_bounds_index_shutdown(&index);
+  arena_destroy(arena);
+}
+
+static void test_caster_lists_cull_per_cascade(void) {
+  Arena *arena = arena_create(MB(1), MB(1));
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrMeshBoundsIndex index;
+  assert(vkr_mesh_bounds_index_init(&index, &allocator, 4u, 4u));
+  const uint32_t near_key = vkr_mesh_bounds_index_instance_key(&index, 0u);
+  const uint32_t far_key = vkr_mesh_bounds_index_instance_key(&index, 1u);
+  vkr_mesh_bounds_index_set(&index, near_key, vec3_new(0.0f, 1.0f, -10.0f),
+                            1.0f);
+  vkr_mesh_bounds_index_set(&index, far_key, vec3_new(5000.0f, 1.0f, 0.0f),
+                            1.0f);
+
+  VkrShadowSystem system = {0};
+  const VkrShadowConfig config = VKR_SHADOW_CONFIG_DEFAULT;
+  assert(vkr_shadow_system_init(&system, test_frontend(), &config));
+  assert(vkr_shadow_system_set_caster_index(&system, &allocator, &index));
+  // Nothing is filtered before the first update has produced lists.
+  assert(vkr_shadow_system_is_caster_relevant(&system, far_key));
+
+  const VkrCamera camera = test_camera();
+  const Vec3 light = vec3_normalize(vec3_new(-0.4f, -1.0f, -0.3f));
+  vkr_shadow_system_update(&system, &camera, true_v, light);
+
+  assert(vkr_shadow_system_is_caster_relevant(&system, near_key));
+  assert(!vkr_shadow_system_is_caster_relevant(&system, far_key));
+
+  uint32_t count = 0;
+  const uint32_t *casters =
+      vkr_shadow_system_get_cascade_casters(&system, 0u, &count);
+  assert(casters != NULL && count == 1u && casters[0] == near_key);
+  for (uint32_t cascade = 0; cascade < config.cascade_count; ++cascade) {
+    casters = vkr_shadow_system_get_cascade_casters(&system, cascade, &count);
+    for (uint32_t i = 0; i < count; ++i) {
+      assert(casters[i] != far_key);
+    }
+  }
+
+  // Moving the far caster next to the camera must reach the lists on the next
+  // update through a refit alone.
+  vkr_mesh_bounds_index_set(&index, far_key, vec3_new(2.0f, 1.0f, -12.0f),
+                            1.0f);
+  vkr_shadow_system_update(&system, &camera, true_v, light);
+  assert(vkr_shadow_system_is_caster_relevant(&system, far_key));
+
+  // With the light off there are no lists, so nothing may be filtered.
+  vkr_mesh_bounds_index_set(&index, far_key, vec3_new(5000.0f, 1.0f, 0.0f),
+                            1.0f);
+  vkr_shadow_system_update(&system, &camera, false_v, light);
+  assert(vkr_shadow_system_is_caster_relevant(&system, far_key));
+  assert(vkr_shadow_system_get_cascade_casters(&system, 0u, &count) == NULL);
+  assert(count == 0u);
+
+  vkr_shadow_system_shutdown(&system, test_frontend());
+  vkr_mesh_bounds_index_shutdown(&index);
+  arena_destroy(arena);
+}
+
 bool32_t run_shadow_system_tests(void) {
   printf("--- Starting Shadow System Tests ---\n");
   printf("  Running test_growth_is_never_deadbanded...\n");
@@ -433,6 +534,12 @@ bool32_t run_shadow_system_tests(void) {
   printf("  Running test_shadow_raster_bias_packet_validation...\n");
   test_shadow_raster_bias_packet_validation();
   printf("  test_shadow_raster_bias_packet_validation PASSED\n");
+  printf("  Running test_indexed_caster_fit_only_reads_overlapping_casters...\n");
+  test_indexed_caster_fit_only_reads_overlapping_casters();
+  printf("  test_indexed_caster_fit_only_reads_overlapping_casters PASSED\n");
+  printf("  Running test_caster_lists_cull_per_cascade...\n");
+  test_caster_lists_cull_per_cascade();
+  printf("  test_caster_lists_cull_per_cascade PASSED\n");
   printf("--- Shadow System Tests Completed ---\n");
   return true_v;
 }
@@ -519,6 +519,33 @@ static void test_simd_compare(void) {
   printf("  test_simd_compare PASSED\n");
 }
 
+static void test_simd_lane_masks(void) {
+  printf("  Running test_simd_lane_masks...\n");
+
+  VKR_SIMD_F32X4 a = vkr_simd_set_f32x4(1.0f, 2.0f, -3.0f, 4.0f);
+  VKR_SIMD_F32X4 b = vkr_simd_set_f32x4(1.0f, 3.0f, -4.0f, 5.0f);
+  assert(vkr_simd_mask_ge_f32x4(a, b) == 0x5u && "Mask should mark a >= b");
+  assert(vkr_simd_mask_ge_f32x4(b, a) == 0xBu && "Mask should mark b >= a");
+
+  VKR_SIMD_F32X4 x = vkr_simd_set1_f32x4(10.0f);
+  VKR_SIMD_F32X4 y = vkr_simd_set1_f32x4(20.0f);
+  assert(simd_vector_equals(vkr_simd_select_ge_f32x4(a, b, x, y),
+                            vkr_simd_set_f32x4(10.0f, 20.0f, 10.0f, 20.0f),
+                            1e-6f) &&
+         "Select should take x where a >= b");
+
+  const float32_t nan = NAN;
+  VKR_SIMD_F32X4 with_nan = vkr_simd_set_f32x4(nan, 0.0f, 0.0f, nan);
+  VKR_SIMD_F32X4 zero = vkr_simd_set1_f32x4(0.0f);
+  assert(vkr_simd_mask_ge_f32x4(with_nan, zero) == 0x6u &&
+         "NaN lanes should compare false");
+  VKR_SIMD_F32X4 picked = vkr_simd_select_ge_f32x4(with_nan, zero, x, y);
+  assert(picked.x == 20.0f && picked.y == 10.0f && picked.w == 20.0f &&
+         "NaN lanes should select y");
+
+  printf("  test_simd_lane_masks PASSED\n");
+}
+
 static void test_simd_shuffle(void) {
   printf("  Running test_simd_shuffle...\n");
 
@@ -775,6 +802,7 @@ bool32_t run_simd_tests(void) {
   test_simd_fma();
   test_simd_dot_products();
   test_simd_compare();
+  test_simd_lane_masks();
   test_simd_shuffle();
   test_simd_scatter_gather();
   test_simd_scatter_gather_edge_cases();
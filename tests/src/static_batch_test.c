@@ -0,0 +1,188 @@
+#include "static_batch_test.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#define STATIC_BATCH_TEST_QUADS 3u
+#define STATIC_BATCH_TEST_EPSILON 1e-4f
+
+/** Three unit quads in the z = 0 plane, each with its own four vertices. */
+typedef struct StaticBatchTestMesh {
+  VkrVertex3d vertices[STATIC_BATCH_TEST_QUADS * 4u];
+  uint16_t indices[STATIC_BATCH_TEST_QUADS * 6u];
+  VkrStaticBatchSource source;
+} StaticBatchTestMesh;
+
+static void static_batch_test_mesh_init(StaticBatchTestMesh *mesh) {
+  MemZero(mesh, sizeof(*mesh));
+  for (uint32_t q = 0u; q < STATIC_BATCH_TEST_QUADS; ++q) {
+    for (uint32_t v = 0u; v < 4u; ++v) {
+      mesh->vertices[q * 4u + v] = (VkrVertex3d){
+          .position = vkr_vertex_pack_vec3(
+              vec3_new((float32_t)(v & 1u), (float32_t)(v >> 1), 0.0f)),
+          .normal = vkr_vertex_pack_vec3(vec3_new(0.0f, 0.0f, 1.0f)),
+          .tangent = vec4_new(1.0f, 0.0f, 0.0f, 1.0f),
+      };
+    }
+    const uint16_t base = (uint16_t)(q * 4u);
+    const uint16_t quad[6] = {base,      (uint16_t)(base + 1u),
+                              (uint16_t)(base + 2u), (uint16_t)(base + 2u),
+                              (uint16_t)(base + 1u), (uint16_t)(base + 3u)};
+    MemCopy(&mesh->indices[q * 6u], quad, sizeof(quad));
+  }
+  mesh->source = (VkrStaticBatchSource){
+      .vertices = mesh->vertices,
+      .vertex_count = STATIC_BATCH_TEST_QUADS * 4u,
+      .indices = mesh->indices,
+      .index_size = sizeof(uint16_t),
+      .index_count = STATIC_BATCH_TEST_QUADS * 6u,
+  };
+}
+
+static VkrStaticBatchItem
+static_batch_test_item(const StaticBatchTestMesh *mesh, uint32_t quad,
+                       uint32_t material_id, Vec3 translation,
+                       uint32_t user_data) {
+  return (VkrStaticBatchItem){
+      .source = &mesh->source,
+      .first_index = quad * 6u,
+      .index_count = 6u,
+      .model = mat4_translate(translation),
+      .material = {.id = material_id, .generation = 1u},
+      .world_center = vec3_add(translation, vec3_new(0.5f, 0.5f, 0.0f)),
+      .user_data = user_data,
+  };
+}
+
+static bool8_t static_batch_test_near(float32_t a, float32_t b) {
+  return fabsf(a - b) <= STATIC_BATCH_TEST_EPSILON;
+}
+
+static void test_static_batch_plan_groups_by_material_and_cell(void) {
+  printf("  Running test_static_batch_plan_groups_by_material_and_cell...\n");
+  StaticBatchTestMesh mesh;
+  static_batch_test_mesh_init(&mesh);
+
+  VkrStaticBatchItem items[6] = {
+      static_batch_test_item(&mesh, 0u, 2u, vec3_new(0.0f, 0.0f, 0.0f), 0u),
+      static_batch_test_item(&mesh, 1u, 1u, vec3_new(2.0f, 0.0f, 0.0f), 1u),
+      static_batch_test_item(&mesh, 2u, 2u, vec3_new(4.0f, 0.0f, 0.0f), 2u),
+      // Same material as items 1 and 3, but in a far cell: left alone.
+      static_batch_test_item(&mesh, 0u, 1u, vec3_new(100.0f, 0.0f, 0.0f), 3u),
+      static_batch_test_item(&mesh, 1u, 1u, vec3_new(6.0f, 0.0f, 0.0f), 4u),
+      // Indices past the end of the source are never batched.
+      static_batch_test_item(&mesh, 3u, 1u, vec3_new(8.0f, 0.0f, 0.0f), 5u),
+  };
+
+  VkrStaticBatchRun runs[6] = {0};
+  const uint32_t run_count = vkr_static_batch_plan(items, 6u, 32.0f, 0u, runs,
+                                                   ArrayCount(runs));
+  assert(run_count == 2u);
+
+  // Material 1 sorts first; within a run, items keep their caller order.
+  assert(runs[0].item_count == 2u);
+  assert(items[runs[0].first_item].user_data == 1u);
+  assert(items[runs[0].first_item + 1u].user_data == 4u);
+  assert(runs[1].item_count == 2u);
+  assert(items[runs[1].first_item].user_data == 0u);
+  assert(items[runs[1].first_item + 1u].user_data == 2u);
+  for (uint32_t r = 0u; r < run_count; ++r) {
+    assert(runs[r].vertex_count == 8u);
+    assert(runs[r].index_count == 12u);
+  }
+
+  // The invalid item sorts last.
+  assert(!items[5].valid && items[5].user_data == 5u);
+
+  printf("  test_static_batch_plan_groups_by_material_and_cell PASSED\n");
+}
+
+static void test_static_batch_plan_splits_at_vertex_cap(void) {
+  printf("  Running test_static_batch_plan_splits_at_vertex_cap...\n");
+  StaticBatchTestMesh mesh;
+  static_batch_test_mesh_init(&mesh);
+
+  VkrStaticBatchItem items[5];
+  for (uint32_t i = 0u; i < ArrayCount(items); ++i) {
+    items[i] = static_batch_test_item(
+        &mesh, i % STATIC_BATCH_TEST_QUADS, 1u,
+        vec3_new((float32_t)i * 2.0f, 0.0f, 0.0f), i);
+  }
+
+  // Eight vertices fit two quads: the fifth item is left over on its own.
+  VkrStaticBatchRun runs[5] = {0};
+  const uint32_t run_count =
+      vkr_static_batch_plan(items, 5u, 32.0f, 8u, runs, ArrayCount(runs));
+  assert(run_count == 2u);
+  for (uint32_t r = 0u; r < run_count; ++r) {
+    assert(runs[r].item_count == 2u);
+    assert(runs[r].vertex_count == 8u);
+  }
+  assert(runs[1].first_item == 2u);
+
+  // Run capacity bounds the output.
+  assert(vkr_static_batch_plan(items, 5u, 32.0f, 8u, runs, 1u) == 1u);
+
+  printf("  test_static_batch_plan_splits_at_vertex_cap PASSED\n");
+}
+
+static void test_static_batch_merge_bakes_world_space(void) {
+  printf("  Running test_static_batch_merge_bakes_world_space...\n");
+  StaticBatchTestMesh mesh;
+  static_batch_test_mesh_init(&mesh);
+
+  VkrStaticBatchItem items[2] = {
+      static_batch_test_item(&mesh, 1u, 1u, vec3_new(10.0f, 0.0f, 0.0f), 0u),
+      static_batch_test_item(&mesh, 2u, 1u, vec3_new(12.0f, 0.0f, 0.0f), 1u),
+  };
+  // Mirror the second item across x: winding and handedness must flip.
+  items[1].model = mat4_mul(mat4_translate(vec3_new(12.0f, 0.0f, 0.0f)),
+                            mat4_scale(vec3_new(-1.0f, 2.0f, 1.0f)));
+
+  VkrStaticBatchRun run = {0};
+  assert(vkr_static_batch_plan(items, 2u, 32.0f, 0u, &run, 1u) == 1u);
+  assert(items[0].vertex_first == 4u && items[1].vertex_first == 8u);
+
+  VkrVertex3d vertices[8];
+  uint32_t indices[12];
+  VkrAabb bounds = {0};
+  vkr_static_batch_merge(items, &run, vertices, indices, &bounds);
+
+  // Indices are rebased onto each item's slot in the batch.
+  const uint32_t expected[12] = {0u, 1u, 2u, 2u, 1u, 3u,
+                                 4u, 6u, 5u, 6u, 7u, 5u};
+  for (uint32_t i = 0u; i < 12u; ++i) {
+    assert(indices[i] == expected[i]);
+  }
+
+  const Vec3 first = vkr_vertex_unpack_vec3(vertices[3].position);
+  assert(static_batch_test_near(first.x, 11.0f));
+  assert(static_batch_test_near(first.y, 1.0f));
+  const Vec3 mirrored = vkr_vertex_unpack_vec3(vertices[7].position);
+  assert(static_batch_test_near(mirrored.x, 11.0f));
+  assert(static_batch_test_near(mirrored.y, 2.0f));
+
+  // Normals stay unit length; the mirrored tangent points the other way.
+  const Vec3 normal = vkr_vertex_unpack_vec3(vertices[5].normal);
+  assert(static_batch_test_near(normal.z, 1.0f));
+  assert(static_batch_test_near(vertices[5].tangent.x, -1.0f));
+  assert(vertices[5].tangent.w == -1.0f);
+  assert(vertices[0].tangent.w == 1.0f);
+
+  assert(static_batch_test_near(bounds.min.x, 10.0f));
+  assert(static_batch_test_near(bounds.max.x, 12.0f));
+  assert(static_batch_test_near(bounds.min.y, 0.0f));
+  assert(static_batch_test_near(bounds.max.y, 2.0f));
+
+  printf("  test_static_batch_merge_bakes_world_space PASSED\n");
+}
+
+bool32_t run_static_batch_tests() {
+  printf("--- Running static batch tests... ---\n");
+  test_static_batch_plan_groups_by_material_and_cell();
+  test_static_batch_plan_splits_at_vertex_cap();
+  test_static_batch_merge_bakes_world_space();
+  printf("--- Static batch tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "renderer/systems/vkr_static_batch.h"
+#include "vkr_pch.h"
+
+bool32_t run_static_batch_tests();
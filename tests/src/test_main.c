@@ -17,8 +17,12 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_atomic_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_logger_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_metrics_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_trace_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_arena_tests();
   printf("\n"); // Add spacing
   all_passed &= run_array_tests();
@@ -35,6 +39,8 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_job_system_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_parallel_for_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_input_tests();
   printf("\n"); // Add spacing
   all_passed &= run_json_tests();
@@ -63,6 +69,8 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_text_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_texture_convert_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_texture_format_tests();
   printf("\n"); // Add spacing
   all_passed &= run_texture_hdr_tests();
@@ -71,6 +79,8 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_ibl_math_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_ibl_bake_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_lighting_system_tests();
   printf("\n"); // Add spacing
   all_passed &= run_texture_vkt_tests();
@@ -78,6 +88,22 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_renderer_impl_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_null_renderer_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_texture_streaming_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_upload_planner_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_ui_batcher_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_static_batch_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_world_instancing_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_row_table_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_pipeline_manifest_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_vulkan_tests();
   printf("\n"); // Add spacing
   all_passed &= run_packet_constants_tests();
@@ -86,6 +112,10 @@ int main(int argc, char **argv) {
   printf("\n"); // Add spacing
   all_passed &= run_visibility_tests();
   printf("\n"); // Add spacing
+  all_passed &= run_bvh_tests();
+  printf("\n"); // Add spacing
+  all_passed &= run_occlusion_tests();
+  printf("\n"); // Add spacing
   all_passed &= run_shadow_system_tests();
   printf("\n"); // Add spacing
   all_passed &= run_render_graph_barrier_tests();
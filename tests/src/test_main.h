@@ -5,6 +5,7 @@
 #include "array_test.h"
 #include "atomic_test.h"
 #include "bitset_test.h"
+#include "bvh_test.h"
 #include "clock_test.h"
 #include "dmemory_test.h"
 #include "entity_test.h"
@@ -15,12 +16,14 @@
 #include "gltf_importer_tests.h"
 #include "harness_test.h"
 #include "hashtable_test.h"
+#include "ibl_bake_tests.h"
 #include "ibl_math_tests.h"
 #include "input_test.h"
 #include "job_system_test.h"
 #include "json_test.h"
 #include "json_writer_test.h"
 #include "lighting_system_tests.h"
+#include "logger_test.h"
 #include "mat_test.h"
 #include "material_pbr_tests.h"
 #include "math_test.h"
@@ -29,26 +32,38 @@
 #include "metal_memory_test.h"
 #include "metal_packet_abi_test.h"
 #include "metrics_test.h"
+#include "null_renderer_test.h"
+#include "occlusion_test.h"
 #include "packet_constants_test.h"
+#include "parallel_for_test.h"
 #include "picking_state_test.h"
+#include "pipeline_manifest_test.h"
 #include "pool_test.h"
 #include "quat_test.h"
 #include "queue_test.h"
 #include "render_graph_barrier_test.h"
 #include "renderer_impl_test.h"
 #include "resource_async_state_tests.h"
+#include "row_table_test.h"
 #include "scene_loader_tests.h"
 #include "shadow_system_test.h"
 #include "simd_test.h"
+#include "static_batch_test.h"
 #include "string_test.h"
 #include "text_test.h"
+#include "texture_convert_tests.h"
 #include "texture_format_tests.h"
 #include "texture_hdr_tests.h"
 #include "texture_lifetime_test.h"
+#include "texture_streaming_test.h"
 #include "texture_vkt_tests.h"
 #include "threads_test.h"
+#include "trace_test.h"
 #include "transform_test.h"
+#include "ui_batcher_test.h"
+#include "upload_planner_test.h"
 #include "vec_test.h"
 #include "vector_test.h"
 #include "visibility_test.h"
 #include "vulkan_test.h"
+#include "world_instancing_test.h"
@@ -0,0 +1,411 @@
+#include "texture_convert_tests.h"
+
+#include "renderer/vkr_ibl_math.h"
+#include "renderer/vkr_texture_convert.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint32_t texture_convert_test_next(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state;
+}
+
+static float32_t texture_convert_test_float(uint32_t bits) {
+  float32_t value = 0.0f;
+  MemCopy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static uint32_t texture_convert_test_bits(float32_t value) {
+  uint32_t bits = 0u;
+  MemCopy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static bool32_t texture_convert_test_half_is_nan(uint16_t half) {
+  return (half & 0x7c00u) == 0x7c00u && (half & 0x03ffu) != 0u;
+}
+
+static void test_texture_convert_half_matches_scalar(void) {
+  printf("  Running test_texture_convert_half_matches_scalar (%s)...\n",
+         vkr_texture_convert_half_path());
+
+  // Every half decodes like the scalar path and encodes back to itself.
+  uint16_t *halves = malloc(sizeof(uint16_t) * 65536u);
+  float32_t *floats = malloc(sizeof(float32_t) * 65536u);
+  uint16_t *round_trip = malloc(sizeof(uint16_t) * 65536u);
+  assert(halves && floats && round_trip);
+  for (uint32_t i = 0u; i < 65536u; ++i) {
+    halves[i] = (uint16_t)i;
+  }
+  vkr_texture_convert_f16_to_f32(halves, floats, 65536u);
+  vkr_texture_convert_f32_to_f16(floats, round_trip, 65536u);
+  for (uint32_t i = 0u; i < 65536u; ++i) {
+    if (texture_convert_test_half_is_nan(halves[i])) {
+      assert(isnan(floats[i]));
+      assert(texture_convert_test_half_is_nan(round_trip[i]));
+      continue;
+    }
+    assert(texture_convert_test_bits(floats[i]) ==
+           texture_convert_test_bits(vkr_float16_to_float32(halves[i])));
+    assert(round_trip[i] == halves[i]);
+  }
+
+  // Ties, the denormal and overflow boundaries and random bit patterns round
+  // like the scalar path. An odd count exercises the scalar tail.
+  const uint32_t count = 40001u;
+  float32_t *values = malloc(sizeof(float32_t) * count);
+  uint16_t *bulk = malloc(sizeof(uint16_t) * count);
+  assert(values && bulk);
+  static const float32_t k_edges[] = {
+      0.0f,        -0.0f,         1.0f,        65504.0f,      65519.99f,
+      65520.0f,    -65520.0f,     1e-8f,       2.9802322e-8f, 5.9604645e-8f,
+      6.1035156e-5f, 6.1032e-5f,  1.00048828f, 1.00146484f,   3.4e38f,
+      INFINITY,    -INFINITY,     NAN,
+  };
+  uint32_t state = 0x9e3779b9u;
+  for (uint32_t i = 0u; i < count; ++i) {
+    if (i < ArrayCount(k_edges)) {
+      values[i] = k_edges[i];
+    } else if (i % 2u == 0u) {
+      // Concentrate on the half range, including exact ties (low 13 bits set
+      // to 0x1000).
+      const uint32_t bits = 0x33000000u + texture_convert_test_next(&state) %
+                                              (0x47800000u - 0x33000000u);
+      values[i] = texture_convert_test_float(
+          (i % 6u == 0u ? (bits & ~0x1fffu) | 0x1000u : bits) |
+          (i % 4u == 0u ? 0x80000000u : 0u));
+    } else {
+      values[i] =
+          texture_convert_test_float(texture_convert_test_next(&state));
+    }
+  }
+  vkr_texture_convert_f32_to_f16(values, bulk, count);
+  for (uint32_t i = 0u; i < count; ++i) {
+    if (isnan(values[i])) {
+      assert(texture_convert_test_half_is_nan(bulk[i]));
+    } else {
+      assert(bulk[i] == vkr_float32_to_float16(values[i]));
+    }
+  }
+
+  free(values);
+  free(bulk);
+  free(halves);
+  free(floats);
+  free(round_trip);
+  printf("  test_texture_convert_half_matches_scalar PASSED\n");
+}
+
+static void test_texture_convert_hdr_rgb_to_rgba16f(void) {
+  printf("  Running test_texture_convert_hdr_rgb_to_rgba16f...\n");
+  // Spans two staging chunks and ends mid-chunk.
+  const uint64_t pixel_count = 601u;
+  float32_t *rgb = malloc(sizeof(float32_t) * 3u * pixel_count);
+  uint16_t *rgba = malloc(sizeof(uint16_t) * 4u * pixel_count);
+  assert(rgb && rgba);
+  uint32_t state = 7u;
+  uint64_t expected_clamped = 0u;
+  float32_t expected_min = FLT_MAX;
+  float32_t expected_max = -FLT_MAX;
+  for (uint64_t i = 0u; i < pixel_count * 3u; ++i) {
+    const float32_t unit =
+        (float32_t)(texture_convert_test_next(&state) >> 8u) / 16777216.0f;
+    float32_t value = unit * 8.0f;
+    if (i % 97u == 5u) {
+      value = -0.25f - unit;
+    } else if (i % 89u == 3u) {
+      value = 70000.0f + unit;
+    }
+    rgb[i] = value;
+    expected_min = Min(expected_min, value);
+    expected_max = Max(expected_max, value);
+    expected_clamped += (value < 0.0f || value > 65504.0f) ? 1u : 0u;
+  }
+
+  VkrTextureHdrConvertStats stats = {0};
+  assert(vkr_texture_convert_rgb32f_to_rgba16f(rgb, rgba, pixel_count,
+                                               &stats));
+  assert(stats.non_finite_sample == UINT64_MAX);
+  assert(stats.clamped_count == expected_clamped && expected_clamped > 0u);
+  assert(stats.observed_min == expected_min);
+  assert(stats.observed_max == expected_max);
+  for (uint64_t pixel = 0u; pixel < pixel_count; ++pixel) {
+    for (uint32_t c = 0u; c < 3u; ++c) {
+      const float32_t value = Clamp(rgb[pixel * 3u + c], 0.0f, 65504.0f);
+      assert(rgba[pixel * 4u + c] == vkr_float32_to_float16(value));
+    }
+    assert(rgba[pixel * 4u + 3u] == 0x3c00u);
+  }
+
+  // A single pixel takes the last-pixel load alone.
+  const float32_t single[3] = {0.5f, 2.0f, 100000.0f};
+  assert(vkr_texture_convert_rgb32f_to_rgba16f(single, rgba, 1u, &stats));
+  assert(stats.clamped_count == 1u && stats.observed_min == 0.5f &&
+         stats.observed_max == 100000.0f);
+  assert(rgba[0] == 0x3800u && rgba[1] == 0x4000u && rgba[2] == 0x7bffu &&
+         rgba[3] == 0x3c00u);
+
+  // Non-finite samples fail and name the sample, in any channel.
+  rgb[300u * 3u + 2u] = INFINITY;
+  assert(!vkr_texture_convert_rgb32f_to_rgba16f(rgb, rgba, pixel_count,
+                                                &stats));
+  assert(stats.non_finite_sample == 300u * 3u + 2u);
+  rgb[3u * 3u + 1u] = NAN;
+  assert(!vkr_texture_convert_rgb32f_to_rgba16f(rgb, rgba, pixel_count,
+                                                &stats));
+  assert(stats.non_finite_sample == 3u * 3u + 1u);
+  rgb[300u * 3u + 2u] = 1.0f;
+  rgb[(pixel_count - 1u) * 3u] = -INFINITY;
+  assert(!vkr_texture_convert_rgb32f_to_rgba16f(
+      rgb + 4u * 3u, rgba, pixel_count - 4u, &stats));
+  assert(stats.non_finite_sample == (pixel_count - 5u) * 3u);
+
+  free(rgb);
+  free(rgba);
+  printf("  test_texture_convert_hdr_rgb_to_rgba16f PASSED\n");
+}
+
+static void test_texture_convert_rgbe_matches_ldexp(void) {
+  printf("  Running test_texture_convert_rgbe_matches_ldexp...\n");
+  static const uint8_t k_mantissas[] = {0u, 1u, 77u, 128u, 200u, 255u};
+  uint8_t rgbe[256u * 4u];
+  float32_t rgb[256u * 3u];
+  for (uint32_t m = 0u; m < ArrayCount(k_mantissas); ++m) {
+    for (uint32_t e = 0u; e < 256u; ++e) {
+      rgbe[e * 4u + 0u] = k_mantissas[m];
+      rgbe[e * 4u + 1u] = (uint8_t)(255u - k_mantissas[m]);
+      rgbe[e * 4u + 2u] = (uint8_t)(e & 0xffu);
+      rgbe[e * 4u + 3u] = (uint8_t)e;
+    }
+    vkr_texture_convert_rgbe_to_rgb32f(rgbe, rgb, 256u);
+    for (uint32_t e = 0u; e < 256u; ++e) {
+      const float32_t scale = e == 0u ? 0.0f : ldexpf(1.0f, (int32_t)e - 136);
+      for (uint32_t c = 0u; c < 3u; ++c) {
+        const float32_t expected = (float32_t)rgbe[e * 4u + c] * scale;
+        assert(texture_convert_test_bits(rgb[e * 3u + c]) ==
+               texture_convert_test_bits(expected));
+      }
+    }
+  }
+  printf("  test_texture_convert_rgbe_matches_ldexp PASSED\n");
+}
+
+static float64_t texture_convert_test_srgb(float64_t value) {
+  value = value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value);
+  return value <= 0.04045 ? value / 12.92 : pow((value + 0.055) / 1.055, 2.4);
+}
+
+static void test_texture_convert_srgb_to_linear(void) {
+  printf("  Running test_texture_convert_srgb_to_linear...\n");
+  uint8_t bytes[256];
+  float32_t decoded[256];
+  for (uint32_t i = 0u; i < 256u; ++i) {
+    bytes[i] = (uint8_t)i;
+  }
+  vkr_texture_convert_srgb8_to_linear(bytes, decoded, 256u);
+  const float32_t *lut = vkr_texture_convert_srgb8_lut();
+  for (uint32_t i = 0u; i < 256u; ++i) {
+    assert(decoded[i] == lut[i]);
+    assert(decoded[i] ==
+           (float32_t)texture_convert_test_srgb((float64_t)i / 255.0));
+  }
+  assert(decoded[0] == 0.0f && decoded[255] == 1.0f);
+
+  // The polynomial tracks the exact curve on both segments, clamps out of
+  // range input and handles a count that is not a multiple of four.
+  const uint32_t count = 10003u;
+  float32_t *src = malloc(sizeof(float32_t) * count);
+  float32_t *dst = malloc(sizeof(float32_t) * count);
+  assert(src && dst);
+  for (uint32_t i = 0u; i < count; ++i) {
+    src[i] = (float32_t)i / (float32_t)(count - 3u);
+  }
+  src[count - 2u] = -0.5f;
+  src[count - 1u] = 3.0f;
+  vkr_texture_convert_srgb_to_linear(src, dst, count);
+  float64_t max_error = 0.0;
+  for (uint32_t i = 0u; i < count; ++i) {
+    const float64_t error =
+        fabs((float64_t)dst[i] - texture_convert_test_srgb(src[i]));
+    max_error = error > max_error ? error : max_error;
+  }
+  assert(max_error < 1e-5);
+  assert(dst[count - 2u] == 0.0f);
+  assert(fabsf(dst[count - 1u] - 1.0f) < 1e-5f);
+
+  free(src);
+  free(dst);
+  printf("  test_texture_convert_srgb_to_linear PASSED\n");
+}
+
+static void test_texture_convert_premultiply(void) {
+  printf("  Running test_texture_convert_premultiply...\n");
+  uint8_t *pixels = malloc(256u * 256u * 4u);
+  assert(pixels);
+  for (uint32_t a = 0u; a < 256u; ++a) {
+    for (uint32_t c = 0u; c < 256u; ++c) {
+      uint8_t *pixel = pixels + (a * 256u + c) * 4u;
+      pixel[0] = (uint8_t)c;
+      pixel[1] = (uint8_t)(255u - c);
+      pixel[2] = (uint8_t)(c / 2u);
+      pixel[3] = (uint8_t)a;
+    }
+  }
+  vkr_texture_premultiply_rgba8(pixels, 256u * 256u);
+  for (uint32_t a = 0u; a < 256u; ++a) {
+    for (uint32_t c = 0u; c < 256u; ++c) {
+      const uint8_t *pixel = pixels + (a * 256u + c) * 4u;
+      assert(pixel[0] == (uint8_t)((c * a * 2u + 255u) / 510u));
+      assert(pixel[1] == (uint8_t)(((255u - c) * a * 2u + 255u) / 510u));
+      assert(pixel[3] == a);
+    }
+  }
+  free(pixels);
+
+  float32_t colors[8] = {1.0f, 0.5f, 0.25f, 0.5f, 2.0f, 4.0f, 8.0f, 0.0f};
+  vkr_texture_premultiply_rgba32f(colors, 2u);
+  assert(colors[0] == 0.5f && colors[1] == 0.25f && colors[2] == 0.125f &&
+         colors[3] == 0.5f);
+  assert(colors[4] == 0.0f && colors[5] == 0.0f && colors[6] == 0.0f &&
+         colors[7] == 0.0f);
+  printf("  test_texture_convert_premultiply PASSED\n");
+}
+
+static void test_texture_convert_analyze_matches_reference(void) {
+  printf("  Running test_texture_convert_analyze_matches_reference...\n");
+  const uint64_t counts[] = {1u, 3u, 4u, 7u, 16u, 37u, 4099u};
+  uint8_t *pixels = malloc(4099u * 4u);
+  assert(pixels);
+  uint32_t seed = 11u;
+  for (uint32_t t = 0u; t < ArrayCount(counts); ++t) {
+    const uint64_t count = counts[t];
+    uint8_t ref_min[4] = {255u, 255u, 255u, 255u};
+    uint8_t ref_max[4] = {0u, 0u, 0u, 0u};
+    uint64_t ref_transparent = 0u;
+    uint64_t ref_intermediate = 0u;
+    for (uint64_t i = 0u; i < count; ++i) {
+      uint8_t *pixel = pixels + i * 4u;
+      const uint32_t bits = texture_convert_test_next(&seed);
+      pixel[0] = (uint8_t)(32u + (bits >> 8u) % 150u);
+      pixel[1] = (uint8_t)(bits >> 16u);
+      pixel[2] = (uint8_t)(200u + (bits >> 24u) % 40u);
+      // Mostly opaque, with hard and soft alpha mixed in.
+      const uint32_t alpha_pick = (bits >> 4u) % 8u;
+      pixel[3] = alpha_pick == 0u   ? 0u
+                 : alpha_pick == 1u ? (uint8_t)(1u + (bits >> 12u) % 254u)
+                                    : 255u;
+      for (uint32_t c = 0u; c < 4u; ++c) {
+        ref_min[c] = Min(ref_min[c], pixel[c]);
+        ref_max[c] = Max(ref_max[c], pixel[c]);
+      }
+      ref_transparent += pixel[3] < 255u ? 1u : 0u;
+      ref_intermediate += (pixel[3] > 0u && pixel[3] < 255u) ? 1u : 0u;
+    }
+
+    VkrTextureRgba8Analysis analysis = {0};
+    vkr_texture_analyze_rgba8(pixels, count, &analysis);
+    assert(MemCompare(analysis.channel_min, ref_min, sizeof(ref_min)) == 0);
+    assert(MemCompare(analysis.channel_max, ref_max, sizeof(ref_max)) == 0);
+    assert(analysis.transparent_count == ref_transparent);
+    assert(analysis.intermediate_count == ref_intermediate);
+    assert(analysis.is_constant == (count == 1u));
+  }
+  free(pixels);
+
+  const uint8_t unused[4] = {1u, 2u, 3u, 4u};
+  VkrTextureRgba8Analysis empty = {0};
+  vkr_texture_analyze_rgba8(unused, 0u, &empty);
+  assert(empty.alpha_class == VKR_TEXTURE_ALPHA_CLASS_OPAQUE);
+  assert(!empty.is_constant && empty.normal_likelihood == 0.0f);
+  printf("  test_texture_convert_analyze_matches_reference PASSED\n");
+}
+
+static void test_texture_convert_analyze_classifies(void) {
+  printf("  Running test_texture_convert_analyze_classifies...\n");
+  enum { PIXELS = 1000 };
+  uint8_t *pixels = malloc(PIXELS * 4u);
+  assert(pixels);
+
+  // A flat normal map is constant, opaque and all normals.
+  for (uint32_t i = 0u; i < PIXELS; ++i) {
+    uint8_t *pixel = pixels + i * 4u;
+    pixel[0] = 128u;
+    pixel[1] = 128u;
+    pixel[2] = 255u;
+    pixel[3] = 255u;
+  }
+  VkrTextureRgba8Analysis analysis = {0};
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(analysis.is_constant);
+  assert(analysis.alpha_class == VKR_TEXTURE_ALPHA_CLASS_OPAQUE);
+  assert(analysis.normal_likelihood == 1.0f);
+
+  // One differing texel breaks constancy in the vector body and in the tail.
+  pixels[10u * 4u + 1u] = 129u;
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(!analysis.is_constant);
+  pixels[10u * 4u + 1u] = 128u;
+  pixels[(PIXELS - 1u) * 4u + 3u] = 254u;
+  vkr_texture_analyze_rgba8(pixels, PIXELS - 1u, &analysis);
+  assert(analysis.is_constant);
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(!analysis.is_constant);
+
+  // Varied unit normals still read as a normal map; noise does not.
+  uint32_t seed = 5u;
+  for (uint32_t i = 0u; i < PIXELS; ++i) {
+    const float32_t x =
+        (float32_t)(texture_convert_test_next(&seed) >> 8u) / 16777216.0f -
+        0.5f;
+    const float32_t y =
+        (float32_t)(texture_convert_test_next(&seed) >> 8u) / 16777216.0f -
+        0.5f;
+    const float32_t z = sqrtf(1.0f - x * x - y * y);
+    uint8_t *pixel = pixels + i * 4u;
+    pixel[0] = (uint8_t)((x * 0.5f + 0.5f) * 255.0f + 0.5f);
+    pixel[1] = (uint8_t)((y * 0.5f + 0.5f) * 255.0f + 0.5f);
+    pixel[2] = (uint8_t)((z * 0.5f + 0.5f) * 255.0f + 0.5f);
+    pixel[3] = 255u;
+  }
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(analysis.normal_likelihood == 1.0f);
+  for (uint32_t i = 0u; i < PIXELS * 4u; ++i) {
+    pixels[i] = (uint8_t)(texture_convert_test_next(&seed) >> 24u);
+  }
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(analysis.normal_likelihood < 0.5f);
+
+  // Foliage-style alpha: mostly hard edges is a cutout, soft is blended.
+  for (uint32_t i = 0u; i < PIXELS; ++i) {
+    pixels[i * 4u + 3u] = i < 400u ? 0u : (i < 450u ? 128u : 255u);
+  }
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(analysis.alpha_class == VKR_TEXTURE_ALPHA_CLASS_CUTOUT);
+  for (uint32_t i = 0u; i < PIXELS; ++i) {
+    pixels[i * 4u + 3u] = i < 400u ? 64u : 255u;
+  }
+  vkr_texture_analyze_rgba8(pixels, PIXELS, &analysis);
+  assert(analysis.alpha_class == VKR_TEXTURE_ALPHA_CLASS_BLENDED);
+  assert(analysis.transparent_count == 400u);
+  assert(analysis.intermediate_count == 400u);
+  free(pixels);
+  printf("  test_texture_convert_analyze_classifies PASSED\n");
+}
+
+bool32_t run_texture_convert_tests(void) {
+  printf("--- Starting Texture Convert Tests ---\n");
+  test_texture_convert_half_matches_scalar();
+  test_texture_convert_hdr_rgb_to_rgba16f();
+  test_texture_convert_rgbe_matches_ldexp();
+  test_texture_convert_srgb_to_linear();
+  test_texture_convert_premultiply();
+  test_texture_convert_analyze_matches_reference();
+  test_texture_convert_analyze_classifies();
+  printf("--- Texture Convert Tests Completed ---\n");
+  return true_v;
+}
@@ -3,10 +3,161 @@
 #include "filesystem/filesystem.h"
 #include "memory/vkr_arena_allocator.h"
 #include "renderer/systems/vkr_texture_system.h"
+#include "renderer/vkr_texture_convert.h"
 
 #include <assert.h>
+#include <stb_image.h>
 #include <stb_image_write.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_HDR_PARSER_PATH "build/test_hdr_parser.hdr"
+#define TEST_HDR_PARSER_WIDTH 16u
+#define TEST_HDR_PARSER_HEIGHT 8u
+#define TEST_HDR_PARSER_CAPACITY 1024u
+#define TEST_HDR_PARSER_FORMAT "FORMAT=32-bit_rle_rgbe\n"
+
+/** RGBE byte at (x, y): each row is a run of 8 texels, then 8 distinct ones. */
+static uint8_t test_hdr_parser_texel(uint32_t x, uint32_t y, uint32_t channel) {
+  if (channel == 3u) {
+    return (uint8_t)(120u + (x < 8u ? y : x + y) % 16u);
+  }
+  return (uint8_t)(x < 8u ? 32u + y * 8u + channel
+                          : 17u * x + 31u * y + 71u * channel);
+}
+
+/**
+ * Writes a 16x8 Radiance file into `out`. RLE scanlines encode each channel
+ * as one run and one literal and declare `scanline_width` in their header;
+ * flat scanlines never open with the 2, 2 marker.
+ */
+static uint64_t test_hdr_parser_build(uint8_t *out, bool8_t rle,
+                                      const char *format_line,
+                                      uint32_t scanline_width,
+                                      uint64_t *out_header_size) {
+  const int header_size =
+      snprintf((char *)out, TEST_HDR_PARSER_CAPACITY,
+               "#?RADIANCE\n# parser test\n%sEXPOSURE=1.0\n\n-Y %u +X %u\n",
+               format_line, TEST_HDR_PARSER_HEIGHT, TEST_HDR_PARSER_WIDTH);
+  assert(header_size > 0);
+  uint64_t size = (uint64_t)header_size;
+  for (uint32_t y = 0u; y < TEST_HDR_PARSER_HEIGHT; ++y) {
+    if (!rle) {
+      for (uint32_t x = 0u; x < TEST_HDR_PARSER_WIDTH; ++x) {
+        for (uint32_t channel = 0u; channel < 4u; ++channel) {
+          out[size++] = test_hdr_parser_texel(x, y, channel);
+        }
+      }
+      continue;
+    }
+    out[size++] = 2u;
+    out[size++] = 2u;
+    out[size++] = (uint8_t)(scanline_width >> 8u);
+    out[size++] = (uint8_t)(scanline_width & 0xffu);
+    for (uint32_t channel = 0u; channel < 4u; ++channel) {
+      out[size++] = 128u + 8u;
+      out[size++] = test_hdr_parser_texel(0u, y, channel);
+      out[size++] = 8u;
+      for (uint32_t x = 8u; x < TEST_HDR_PARSER_WIDTH; ++x) {
+        out[size++] = test_hdr_parser_texel(x, y, channel);
+      }
+    }
+  }
+  assert(size <= TEST_HDR_PARSER_CAPACITY);
+  if (out_header_size) {
+    *out_header_size = (uint64_t)header_size;
+  }
+  return size;
+}
+
+/** Writes `bytes` to the parser test file and prepares it as a texture. */
+static bool8_t test_hdr_parser_prepare(const uint8_t *bytes, uint64_t size,
+                                       VkrAllocator *allocator,
+                                       VkrTexturePreparedLoad *out_prepared,
+                                       VkrRendererError *out_error) {
+  FILE *file = fopen(TEST_HDR_PARSER_PATH, "wb");
+  assert(file != NULL);
+  assert(fwrite(bytes, 1u, (size_t)size, file) == (size_t)size);
+  assert(fclose(file) == 0);
+
+  VkrTextureSystem system = {0};
+  system.strict_vkt_only_mode = true_v;
+  system.allow_source_fallback = false_v;
+  const bool8_t prepared = vkr_texture_system_prepare_load_from_file(
+      &system, string8_lit(TEST_HDR_PARSER_PATH), VKR_TEXTURE_RGBA_CHANNELS,
+      allocator, out_prepared, out_error);
+
+  const FilePath file_path = {
+      .path = string8_lit(TEST_HDR_PARSER_PATH),
+      .type = FILE_PATH_TYPE_RELATIVE,
+  };
+  assert(file_remove(&file_path) == FILE_ERROR_NONE);
+  return prepared;
+}
+
+/** Decodes `bytes` and checks the halves against stb_image's floats. */
+static void test_hdr_parser_expect_stb_match(const uint8_t *bytes,
+                                             uint64_t size) {
+  Arena *arena = arena_create(MB(1), MB(1));
+  assert(arena != NULL);
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrTexturePreparedLoad prepared = {0};
+  VkrRendererError error = VKR_RENDERER_ERROR_UNKNOWN;
+  assert(test_hdr_parser_prepare(bytes, size, &allocator, &prepared, &error));
+  assert(error == VKR_RENDERER_ERROR_NONE);
+  assert(prepared.description.width == TEST_HDR_PARSER_WIDTH);
+  assert(prepared.description.height == TEST_HDR_PARSER_HEIGHT);
+  assert(prepared.description.format == VKR_TEXTURE_FORMAT_R16G16B16A16_SFLOAT);
+
+  int32_t width = 0;
+  int32_t height = 0;
+  int32_t channels = 0;
+  stbi_set_flip_vertically_on_load_thread(0);
+  float32_t *expected_rgb =
+      stbi_loadf_from_memory(bytes, (int)size, &width, &height, &channels,
+                             (int)VKR_TEXTURE_RGB_CHANNELS);
+  assert(expected_rgb != NULL);
+  assert(width == (int32_t)TEST_HDR_PARSER_WIDTH);
+  assert(height == (int32_t)TEST_HDR_PARSER_HEIGHT);
+
+  const uint64_t pixel_count = (uint64_t)width * (uint64_t)height;
+  const uint64_t expected_size =
+      pixel_count * VKR_TEXTURE_RGBA_CHANNELS * sizeof(uint16_t);
+  uint16_t *expected_rgba16 = (uint16_t *)malloc((size_t)expected_size);
+  assert(expected_rgba16 != NULL);
+  VkrTextureHdrConvertStats stats = {0};
+  vkr_texture_convert_rgb32f_to_rgba16f(expected_rgb, expected_rgba16,
+                                        pixel_count, &stats);
+  assert(prepared.upload_data_size == expected_size);
+  assert(memcmp(prepared.upload_data, expected_rgba16,
+                (size_t)expected_size) == 0);
+
+  free(expected_rgba16);
+  stbi_image_free(expected_rgb);
+  vkr_texture_system_release_prepared_load(&prepared);
+  arena_destroy(arena);
+}
+
+/** Checks that `bytes` pass the HDR probe but fail to decode. */
+static void test_hdr_parser_expect_rejected(const uint8_t *bytes,
+                                            uint64_t size) {
+  Arena *arena = arena_create(MB(1), MB(1));
+  assert(arena != NULL);
+  VkrAllocator allocator = {.ctx = arena};
+  assert(vkr_allocator_arena(&allocator));
+
+  VkrTexturePreparedLoad prepared = {0};
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  assert(!test_hdr_parser_prepare(bytes, size, &allocator, &prepared, &error));
+  assert(error == VKR_RENDERER_ERROR_RESOURCE_CREATION_FAILED);
+  assert(prepared.upload_data == NULL);
+  assert(prepared.upload_regions == NULL);
+
+  arena_destroy(arena);
+}
 
 static void test_hdr_prepared_load_content_probe_orientation_and_cleanup(void) {
   printf("  Running "
@@ -103,10 +254,113 @@ static void test_hdr_prepared_load_rejects_non_2_to_1_extent(void) {
   printf("  test_hdr_prepared_load_rejects_non_2_to_1_extent PASSED\n");
 }
 
+static void test_hdr_parser_flat_scanlines_match_stb(void) {
+  printf("  Running test_hdr_parser_flat_scanlines_match_stb...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  const uint64_t size = test_hdr_parser_build(
+      bytes, false_v, TEST_HDR_PARSER_FORMAT, TEST_HDR_PARSER_WIDTH, NULL);
+  test_hdr_parser_expect_stb_match(bytes, size);
+  printf("  test_hdr_parser_flat_scanlines_match_stb PASSED\n");
+}
+
+static void test_hdr_parser_rle_scanlines_match_stb(void) {
+  printf("  Running test_hdr_parser_rle_scanlines_match_stb...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  const uint64_t size = test_hdr_parser_build(
+      bytes, true_v, TEST_HDR_PARSER_FORMAT, TEST_HDR_PARSER_WIDTH, NULL);
+  test_hdr_parser_expect_stb_match(bytes, size);
+  printf("  test_hdr_parser_rle_scanlines_match_stb PASSED\n");
+}
+
+static void test_hdr_parser_rejects_truncated_header(void) {
+  printf("  Running test_hdr_parser_rejects_truncated_header...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  uint64_t header_size = 0u;
+  test_hdr_parser_build(bytes, true_v, TEST_HDR_PARSER_FORMAT,
+                        TEST_HDR_PARSER_WIDTH, &header_size);
+
+  // Ends before the blank line that closes the variables.
+  const char *blank_line = strstr((const char *)bytes, "\n\n");
+  assert(blank_line != NULL);
+  test_hdr_parser_expect_rejected(
+      bytes, (uint64_t)(blank_line - (const char *)bytes) + 1u);
+  // Ends inside the resolution line.
+  test_hdr_parser_expect_rejected(bytes, header_size - 1u);
+  printf("  test_hdr_parser_rejects_truncated_header PASSED\n");
+}
+
+static void test_hdr_parser_rejects_truncated_scanline(void) {
+  printf("  Running test_hdr_parser_rejects_truncated_scanline...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  uint64_t size = test_hdr_parser_build(
+      bytes, false_v, TEST_HDR_PARSER_FORMAT, TEST_HDR_PARSER_WIDTH, NULL);
+  test_hdr_parser_expect_rejected(bytes, size - 1u);
+
+  size = test_hdr_parser_build(bytes, true_v, TEST_HDR_PARSER_FORMAT,
+                               TEST_HDR_PARSER_WIDTH, NULL);
+  // Ends inside the last literal, then right after the last run's count.
+  test_hdr_parser_expect_rejected(bytes, size - 1u);
+  test_hdr_parser_expect_rejected(bytes, size - 10u);
+  printf("  test_hdr_parser_rejects_truncated_scanline PASSED\n");
+}
+
+static void test_hdr_parser_rejects_run_overflow(void) {
+  printf("  Running test_hdr_parser_rejects_run_overflow...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  uint64_t header_size = 0u;
+  const uint64_t size =
+      test_hdr_parser_build(bytes, true_v, TEST_HDR_PARSER_FORMAT,
+                            TEST_HDR_PARSER_WIDTH, &header_size);
+  const uint64_t first_run = header_size + 4u;
+  const uint64_t first_literal = first_run + 2u;
+
+  // A run past the end of the scanline.
+  bytes[first_run] = 128u + TEST_HDR_PARSER_WIDTH + 1u;
+  test_hdr_parser_expect_rejected(bytes, size);
+
+  // A literal that starts inside the scanline but ends past it.
+  bytes[first_run] = 128u + 9u;
+  test_hdr_parser_expect_rejected(bytes, size);
+
+  // A zero-length run.
+  bytes[first_run] = 128u + 8u;
+  bytes[first_literal] = 0u;
+  test_hdr_parser_expect_rejected(bytes, size);
+  printf("  test_hdr_parser_rejects_run_overflow PASSED\n");
+}
+
+static void test_hdr_parser_rejects_scanline_width_mismatch(void) {
+  printf("  Running test_hdr_parser_rejects_scanline_width_mismatch...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  uint64_t size = test_hdr_parser_build(bytes, true_v, TEST_HDR_PARSER_FORMAT,
+                                        TEST_HDR_PARSER_WIDTH - 1u, NULL);
+  test_hdr_parser_expect_rejected(bytes, size);
+  size = test_hdr_parser_build(bytes, true_v, TEST_HDR_PARSER_FORMAT,
+                               TEST_HDR_PARSER_WIDTH + 1u, NULL);
+  test_hdr_parser_expect_rejected(bytes, size);
+  printf("  test_hdr_parser_rejects_scanline_width_mismatch PASSED\n");
+}
+
+static void test_hdr_parser_rejects_missing_format(void) {
+  printf("  Running test_hdr_parser_rejects_missing_format...\n");
+  uint8_t bytes[TEST_HDR_PARSER_CAPACITY];
+  const uint64_t size =
+      test_hdr_parser_build(bytes, true_v, "", TEST_HDR_PARSER_WIDTH, NULL);
+  test_hdr_parser_expect_rejected(bytes, size);
+  printf("  test_hdr_parser_rejects_missing_format PASSED\n");
+}
+
 bool32_t run_texture_hdr_tests(void) {
   printf("--- Starting HDR Texture Tests ---\n");
   test_hdr_prepared_load_content_probe_orientation_and_cleanup();
   test_hdr_prepared_load_rejects_non_2_to_1_extent();
+  test_hdr_parser_flat_scanlines_match_stb();
+  test_hdr_parser_rle_scanlines_match_stb();
+  test_hdr_parser_rejects_truncated_header();
+  test_hdr_parser_rejects_truncated_scanline();
+  test_hdr_parser_rejects_run_overflow();
+  test_hdr_parser_rejects_scanline_width_mismatch();
+  test_hdr_parser_rejects_missing_format();
   printf("--- HDR Texture Tests Completed ---\n");
   return true_v;
 }
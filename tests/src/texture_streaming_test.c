@@ -0,0 +1,358 @@
+#include "texture_streaming_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define STREAMING_TEST_MIPS 4u
+#define STREAMING_TEST_BYTES 340u
+
+/** Bytes resident with each mip as the top of an 8x8 RGBA8 chain. */
+static const uint64_t streaming_test_chain_bytes[STREAMING_TEST_MIPS] = {
+    340u, 84u, 20u, 4u};
+
+typedef struct StreamingTestFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrNullRenderer *renderer;
+  VkrAssetPublisher null_publisher;
+  /** Forwards to the null publisher unless `fail_publishes` is set. */
+  VkrAssetPublisher publisher;
+  bool8_t fail_publishes;
+  uint8_t pixels[STREAMING_TEST_BYTES];
+  VkrTextureUploadRegion regions[STREAMING_TEST_MIPS];
+} StreamingTestFixture;
+
+static bool8_t streaming_test_publish_texture(
+    void *state, VkrTextureHandle handle,
+    const struct VkrTexturePreparedLoad *texture) {
+  StreamingTestFixture *fixture = state;
+  if (fixture->fail_publishes)
+    return false_v;
+  return fixture->null_publisher.publish_texture(fixture->null_publisher.state,
+                                                 handle, texture);
+}
+
+static void streaming_test_fixture_init(StreamingTestFixture *fixture) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(16), MB(2));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+  const VkrNullRendererConfig config = {
+      .allocator = &fixture->allocator,
+      .graph_path = "assets/render_graphs/main.rendergraph.json",
+      .width = 320u,
+      .height = 180u,
+      .image_count = 3u,
+      .geometry_capacity = 4u,
+      .texture_capacity = 16u,
+      .material_capacity = 4u,
+      .retirement_capacity = 16u,
+      .gpu_latency_frames = 0u,
+  };
+  assert(vkr_null_renderer_create(&config, &fixture->renderer));
+  vkr_null_renderer_get_asset_publisher(fixture->renderer,
+                                        &fixture->null_publisher);
+  fixture->publisher = fixture->null_publisher;
+  fixture->publisher.state = fixture;
+  fixture->publisher.publish_texture = streaming_test_publish_texture;
+
+  uint64_t offset = 0u;
+  for (uint32_t mip = 0u; mip < STREAMING_TEST_MIPS; ++mip) {
+    const uint32_t extent = 8u >> mip;
+    const uint64_t size = (uint64_t)extent * extent * 4u;
+    fixture->regions[mip] = (VkrTextureUploadRegion){
+        .mip_level = mip,
+        .width = extent,
+        .height = extent,
+        .depth = 1u,
+        .byte_offset = offset,
+        .byte_size = size,
+    };
+    MemSet(fixture->pixels + offset, (int32_t)(mip + 1u), size);
+    offset += size;
+  }
+  assert(offset == STREAMING_TEST_BYTES);
+}
+
+static void streaming_test_fixture_shutdown(StreamingTestFixture *fixture) {
+  vkr_null_renderer_destroy(fixture->renderer);
+  arena_destroy(fixture->arena);
+}
+
+static VkrTexturePreparedLoad
+streaming_test_prepared(StreamingTestFixture *fixture) {
+  return (VkrTexturePreparedLoad){
+      .description = {.width = 8u,
+                      .height = 8u,
+                      .channels = 4u,
+                      .type = VKR_TEXTURE_TYPE_2D,
+                      .format = VKR_TEXTURE_FORMAT_R8G8B8A8_UNORM},
+      .upload_data = fixture->pixels,
+      .upload_data_size = STREAMING_TEST_BYTES,
+      .upload_regions = fixture->regions,
+      .upload_region_count = STREAMING_TEST_MIPS,
+      .upload_mip_levels = STREAMING_TEST_MIPS,
+      .upload_array_layers = 1u,
+  };
+}
+
+static uint64_t streaming_test_live_texture_bytes(
+    const StreamingTestFixture *fixture) {
+  VkrNullRendererMetrics metrics = {0};
+  vkr_null_renderer_metrics(fixture->renderer, &metrics);
+  return metrics.memory.classes[VKR_RENDERER_IMPL_MEMORY_CLASS_TEXTURE]
+      .live_requested_bytes;
+}
+
+static void test_texture_streaming_mip_for_density(void) {
+  printf("  Running test_texture_streaming_mip_for_density...\n");
+  assert(vkr_texture_streaming_mip_for_density(0.0f) == 0u);
+  assert(vkr_texture_streaming_mip_for_density(0.25f) == 0u);
+  assert(vkr_texture_streaming_mip_for_density(1.0f) == 0u);
+  assert(vkr_texture_streaming_mip_for_density(1.99f) == 0u);
+  assert(vkr_texture_streaming_mip_for_density(2.0f) == 1u);
+  assert(vkr_texture_streaming_mip_for_density(4.5f) == 2u);
+  assert(vkr_texture_streaming_mip_for_density(1024.0f) == 10u);
+  assert(vkr_texture_streaming_mip_for_density(1.0e30f) ==
+         VKR_TEXTURE_STREAMING_MAX_MIPS - 1u);
+  const float32_t nan = 0.0f / 0.0f;
+  assert(vkr_texture_streaming_mip_for_density(nan) == 0u);
+  printf("  test_texture_streaming_mip_for_density PASSED\n");
+}
+
+static void test_texture_streaming_tail_upgrade_and_drop(void) {
+  printf("  Running test_texture_streaming_tail_upgrade_and_drop...\n");
+  StreamingTestFixture fixture;
+  streaming_test_fixture_init(&fixture);
+  const VkrTextureStreamingConfig config = {
+      .capacity = 16u,
+      .tail_mip_count = 1u,
+      .idle_frames_before_drop = 2u,
+  };
+  VkrTextureStreaming streaming;
+  assert(vkr_texture_streaming_init(&streaming, &fixture.allocator,
+                                    &fixture.publisher, &config));
+
+  // Registration publishes only the 1x1 tail.
+  const VkrTexturePreparedLoad prepared = streaming_test_prepared(&fixture);
+  const VkrTextureHandle handle = {.id = 1u, .generation = 1u};
+  assert(vkr_texture_streaming_register(&streaming, handle, &prepared));
+  assert(!vkr_texture_streaming_register(&streaming, handle, &prepared));
+  VkrTextureResidency residency = {0};
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_RESIDENT);
+  assert(residency.mip_count == STREAMING_TEST_MIPS);
+  assert(residency.resident_mip == 3u);
+  assert(streaming.resident_bytes == streaming_test_chain_bytes[3]);
+  assert(streaming_test_live_texture_bytes(&fixture) ==
+         streaming_test_chain_bytes[3]);
+
+  // 64 texels over 16 pixels is two texels per pixel: mip 1.
+  vkr_texture_streaming_request_uv_density(&streaming, handle, 1.0f, 16.0f);
+  vkr_texture_streaming_request_uv_density(&streaming, handle, 1.0f, 0.0f);
+  VkrTextureStreamingStats stats = {0};
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 1u && stats.downgrades == 0u);
+  assert(stats.upload_bytes == streaming_test_chain_bytes[1]);
+  assert(stats.resident_bytes == streaming_test_chain_bytes[1]);
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.resident_mip == 1u && residency.desired_mip == 1u);
+  assert(residency.resident_bytes == streaming_test_chain_bytes[1]);
+  // The republish retired the tail image.
+  assert(vkr_null_renderer_wait_idle(fixture.renderer));
+  assert(streaming_test_live_texture_bytes(&fixture) ==
+         streaming_test_chain_bytes[1]);
+
+  // The finest request of the frame wins.
+  vkr_texture_streaming_request_uv_density(&streaming, handle, 1.0f, 64.0f);
+  vkr_texture_streaming_request_mip(&streaming, handle, 2u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 1u);
+  assert(streaming.resident_bytes == streaming_test_chain_bytes[0]);
+
+  // One idle update keeps the detail; the second drops back to the tail.
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 0u && stats.downgrades == 0u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.downgrades == 1u);
+  assert(stats.resident_bytes == streaming_test_chain_bytes[3]);
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.resident_mip == 3u);
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_RESIDENT);
+
+  // Unregistering drops the CPU chain but leaves the image to its owner.
+  assert(vkr_texture_streaming_unregister(&streaming, handle));
+  assert(!vkr_texture_streaming_unregister(&streaming, handle));
+  assert(!vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_UNTRACKED);
+  assert(streaming.resident_bytes == 0u);
+  assert(vkr_null_renderer_wait_idle(fixture.renderer));
+  assert(streaming_test_live_texture_bytes(&fixture) ==
+         streaming_test_chain_bytes[3]);
+
+  vkr_texture_streaming_shutdown(&streaming);
+  streaming_test_fixture_shutdown(&fixture);
+  printf("  test_texture_streaming_tail_upgrade_and_drop PASSED\n");
+}
+
+static void test_texture_streaming_budgets(void) {
+  printf("  Running test_texture_streaming_budgets...\n");
+  StreamingTestFixture fixture;
+  streaming_test_fixture_init(&fixture);
+  const VkrTexturePreparedLoad prepared = streaming_test_prepared(&fixture);
+  const VkrTextureHandle first = {.id = 1u, .generation = 1u};
+  const VkrTextureHandle second = {.id = 2u, .generation = 1u};
+
+  // Room for one full chain and the other texture at mip 2.
+  VkrTextureStreamingConfig config = {
+      .capacity = 16u,
+      .tail_mip_count = 1u,
+      .resident_budget_bytes =
+          streaming_test_chain_bytes[0] + streaming_test_chain_bytes[2],
+      .idle_frames_before_drop = 8u,
+  };
+  VkrTextureStreaming streaming;
+  assert(vkr_texture_streaming_init(&streaming, &fixture.allocator,
+                                    &fixture.publisher, &config));
+  assert(vkr_texture_streaming_register(&streaming, first, &prepared));
+  assert(vkr_texture_streaming_register(&streaming, second, &prepared));
+  vkr_texture_streaming_request_mip(&streaming, first, 0u);
+  vkr_texture_streaming_request_mip(&streaming, second, 0u);
+  VkrTextureStreamingStats stats = {0};
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 2u && stats.deferred == 0u);
+  assert(stats.resident_bytes <= config.resident_budget_bytes);
+  VkrTextureResidency residency = {0};
+  assert(vkr_texture_streaming_get_residency(&streaming, first, &residency));
+  assert(residency.resident_mip == 0u);
+  assert(vkr_texture_streaming_get_residency(&streaming, second, &residency));
+  assert(residency.resident_mip == 2u && residency.desired_mip == 0u);
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_UPGRADE_PENDING);
+
+  // Once the first texture leaves view, the second takes its budget.
+  vkr_texture_streaming_request_mip(&streaming, second, 0u);
+  vkr_texture_streaming_request_mip(&streaming, first, 3u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.downgrades == 1u && stats.upgrades == 1u);
+  assert(vkr_texture_streaming_get_residency(&streaming, second, &residency));
+  assert(residency.resident_mip == 0u);
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_RESIDENT);
+  vkr_texture_streaming_shutdown(&streaming);
+
+  // The upload budget admits the most starved texture first and always at
+  // least one transition, then defers the rest to the next update.
+  config.resident_budget_bytes = 0u;
+  config.upload_budget_bytes = 100u;
+  assert(vkr_texture_streaming_init(&streaming, &fixture.allocator,
+                                    &fixture.publisher, &config));
+  const VkrTextureHandle third = {.id = 3u, .generation = 1u};
+  const VkrTextureHandle fourth = {.id = 4u, .generation = 1u};
+  assert(vkr_texture_streaming_register(&streaming, third, &prepared));
+  assert(vkr_texture_streaming_register(&streaming, fourth, &prepared));
+  vkr_texture_streaming_request_mip(&streaming, third, 2u);
+  vkr_texture_streaming_request_mip(&streaming, fourth, 0u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 1u && stats.deferred == 1u);
+  assert(stats.upload_bytes == streaming_test_chain_bytes[0]);
+  assert(vkr_texture_streaming_get_residency(&streaming, fourth, &residency));
+  assert(residency.resident_mip == 0u);
+  assert(vkr_texture_streaming_get_residency(&streaming, third, &residency));
+  assert(residency.resident_mip == 3u);
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_UPGRADE_PENDING);
+
+  vkr_texture_streaming_request_mip(&streaming, third, 2u);
+  vkr_texture_streaming_request_mip(&streaming, fourth, 0u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 1u && stats.deferred == 0u);
+  assert(vkr_texture_streaming_get_residency(&streaming, third, &residency));
+  assert(residency.resident_mip == 2u);
+
+  vkr_texture_streaming_shutdown(&streaming);
+  streaming_test_fixture_shutdown(&fixture);
+  printf("  test_texture_streaming_budgets PASSED\n");
+}
+
+static void test_texture_streaming_feedback_and_failures(void) {
+  printf("  Running test_texture_streaming_feedback_and_failures...\n");
+  StreamingTestFixture fixture;
+  streaming_test_fixture_init(&fixture);
+  const VkrTextureStreamingConfig config = {
+      .capacity = 32u,
+      .tail_mip_count = 2u,
+      .idle_frames_before_drop = 8u,
+  };
+  VkrTextureStreaming streaming;
+  assert(vkr_texture_streaming_init(&streaming, &fixture.allocator,
+                                    &fixture.publisher, &config));
+
+  // Single-mip payloads, cube maps and ids the publisher rejects are not
+  // retained.
+  VkrTexturePreparedLoad prepared = streaming_test_prepared(&fixture);
+  prepared.upload_mip_levels = 1u;
+  assert(!vkr_texture_streaming_accepts(&prepared));
+  prepared = streaming_test_prepared(&fixture);
+  prepared.description.type = VKR_TEXTURE_TYPE_CUBE_MAP;
+  assert(!vkr_texture_streaming_accepts(&prepared));
+  prepared = streaming_test_prepared(&fixture);
+  const VkrTextureHandle rejected = {.id = 20u, .generation = 1u};
+  assert(!vkr_texture_streaming_register(&streaming, rejected, &prepared));
+  VkrTextureResidency residency = {0};
+  assert(!vkr_texture_streaming_get_residency(&streaming, rejected,
+                                              &residency));
+  assert(streaming.resident_bytes == 0u);
+
+  // A two-mip tail starts at mip 2; feedback names textures by id only.
+  const VkrTextureHandle handle = {.id = 5u, .generation = 9u};
+  assert(vkr_texture_streaming_register(&streaming, handle, &prepared));
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.resident_mip == 2u);
+  const VkrTextureStreamingFeedback feedback[] = {
+      {.texture_id = 5u, .mip_level = 1u},
+      {.texture_id = 6u, .mip_level = 0u},
+      {.texture_id = 0u, .mip_level = 0u},
+      {.texture_id = 5u, .mip_level = 3u},
+  };
+  assert(vkr_texture_streaming_apply_feedback(&streaming, feedback,
+                                              ArrayCount(feedback)) == 2u);
+  VkrTextureStreamingStats stats = {0};
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.upgrades == 1u);
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.resident_mip == 1u);
+
+  // A rejected transition keeps the old image and is not retried until the
+  // desired mip changes.
+  fixture.fail_publishes = true_v;
+  vkr_texture_streaming_request_mip(&streaming, handle, 0u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.failures == 1u && stats.upgrades == 0u);
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_FAILED);
+  assert(residency.resident_mip == 1u);
+  assert(streaming.resident_bytes == streaming_test_chain_bytes[1]);
+  vkr_texture_streaming_request_mip(&streaming, handle, 0u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.failures == 0u && stats.upgrades == 0u);
+
+  fixture.fail_publishes = false_v;
+  vkr_texture_streaming_request_mip(&streaming, handle, 2u);
+  vkr_texture_streaming_update(&streaming, &stats);
+  assert(stats.downgrades == 1u);
+  assert(vkr_texture_streaming_get_residency(&streaming, handle, &residency));
+  assert(residency.state == VKR_TEXTURE_RESIDENCY_RESIDENT);
+  assert(residency.resident_mip == 2u);
+
+  vkr_texture_streaming_shutdown(&streaming);
+  streaming_test_fixture_shutdown(&fixture);
+  printf("  test_texture_streaming_feedback_and_failures PASSED\n");
+}
+
+bool32_t run_texture_streaming_tests() {
+  printf("--- Running texture streaming tests... ---\n");
+  test_texture_streaming_mip_for_density();
+  test_texture_streaming_tail_upgrade_and_drop();
+  test_texture_streaming_budgets();
+  test_texture_streaming_feedback_and_failures();
+  printf("--- Texture streaming tests completed. ---\n");
+  return true_v;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "core/logger.h"
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/null/vkr_null_renderer.h"
+#include "renderer/systems/vkr_texture_streaming.h"
+#include "vkr_pch.h"
+
+bool32_t run_texture_streaming_tests();
@@ -0,0 +1,400 @@
+#include "trace_test.h"
+
+#include "core/vkr_threads.h"
+#include "core/vkr_trace.h"
+#include "memory/arena.h"
+#include "memory/vkr_arena_allocator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_TEST_OUTPUT_CAPACITY (64u * 1024u)
+
+typedef struct TraceFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+} TraceFixture;
+
+typedef struct TraceMemorySink {
+  uint8_t data[TRACE_TEST_OUTPUT_CAPACITY];
+  uint64_t length;
+} TraceMemorySink;
+
+static bool8_t trace_memory_sink_write(void *context, const uint8_t *data,
+                                       uint64_t length) {
+  TraceMemorySink *sink = context;
+  if (sink->length + length >= sizeof(sink->data)) {
+    return false_v;
+  }
+  memcpy(sink->data + sink->length, data, length);
+  sink->length += length;
+  sink->data[sink->length] = '\0';
+  return true_v;
+}
+
+/* The trace system keeps the allocator pointer, so the fixture stays put. */
+static void trace_fixture_init(TraceFixture *fixture, uint32_t max_threads,
+                               uint32_t records_per_thread) {
+  fixture->arena = arena_create(MB(4), MB(4));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+  const VkrTraceConfig config = {.max_threads = max_threads,
+                                 .records_per_thread = records_per_thread};
+  assert(vkr_trace_init(&fixture->allocator, &config));
+}
+
+static void trace_fixture_destroy(TraceFixture *fixture) {
+  vkr_trace_shutdown();
+  arena_destroy(fixture->arena);
+}
+
+static uint32_t trace_count_occurrences(const char *text, const char *needle) {
+  uint32_t count = 0;
+  const uint64_t length = strlen(needle);
+  for (const char *at = strstr(text, needle); at;
+       at = strstr(at + length, needle)) {
+    count++;
+  }
+  return count;
+}
+
+static void trace_write_chrome(TraceMemorySink *sink) {
+  VkrJsonWriter writer;
+  sink->length = 0;
+  vkr_json_writer_init(&writer, trace_memory_sink_write, sink);
+  assert(vkr_trace_write_chrome_json(&writer));
+  assert(vkr_json_writer_complete(&writer));
+}
+
+static void test_trace_records_nested_spans(void) {
+  printf("  Running test_trace_records_nested_spans...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 4u, 64u);
+
+  VKR_TRACE_INSTANT("before.capture");
+  assert(vkr_trace_capture_start());
+  assert(!vkr_trace_capture_start());
+  // Closes a span opened before the capture; neither kept nor a drop.
+  VKR_TRACE_END("opened.earlier");
+  VKR_TRACE_THREAD_NAME("test.main");
+  VKR_TRACE_SCOPE("outer") {
+    VKR_TRACE_INSTANT("mark");
+    VKR_TRACE_SCOPE("inner") { VKR_TRACE_COUNTER("queue.depth", 3u); }
+  }
+  VKR_TRACE_FRAME(42u);
+  vkr_trace_capture_stop();
+  VKR_TRACE_INSTANT("after.capture");
+
+  const VkrTraceStats stats = vkr_trace_get_stats();
+  assert(stats.recorded == 7u);
+  assert(stats.dropped == 0u);
+  assert(stats.threads == 1u);
+
+  static TraceMemorySink sink;
+  trace_write_chrome(&sink);
+  const char *json = (const char *)sink.data;
+  assert(trace_count_occurrences(json, "\"ph\":\"B\"") == 2u);
+  assert(trace_count_occurrences(json, "\"ph\":\"E\"") == 2u);
+  assert(trace_count_occurrences(json, "\"ph\":\"C\"") == 1u);
+  assert(strstr(json, "\"test.main\"") != NULL);
+  assert(strstr(json, "\"frame\":42") != NULL);
+  assert(strstr(json, "before.capture") == NULL);
+  assert(strstr(json, "after.capture") == NULL);
+  assert(strstr(json, "opened.earlier") == NULL);
+
+  // A new capture discards the previous one.
+  assert(vkr_trace_capture_start());
+  VKR_TRACE_INSTANT("second");
+  vkr_trace_capture_stop();
+  assert(vkr_trace_get_stats().recorded == 1u);
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_records_nested_spans PASSED\n");
+}
+
+static void test_trace_full_buffer_keeps_spans_balanced(void) {
+  printf("  Running test_trace_full_buffer_keeps_spans_balanced...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 2u, 8u);
+
+  assert(vkr_trace_capture_start());
+  VKR_TRACE_SCOPE("outer") {
+    for (uint32_t i = 0; i < 10u; ++i) {
+      VKR_TRACE_INSTANT("fill");
+    }
+    // No room for this span and its END, so both are dropped together.
+    VKR_TRACE_SCOPE("inner") { VKR_TRACE_INSTANT("dropped"); }
+  }
+  vkr_trace_capture_stop();
+
+  const VkrTraceStats stats = vkr_trace_get_stats();
+  assert(stats.recorded == 8u);
+  assert(stats.dropped == 7u);
+
+  static TraceMemorySink sink;
+  trace_write_chrome(&sink);
+  const char *json = (const char *)sink.data;
+  assert(trace_count_occurrences(json, "\"ph\":\"B\"") == 1u);
+  assert(trace_count_occurrences(json, "\"ph\":\"E\"") == 1u);
+  assert(strstr(json, "\"inner\"") == NULL);
+  assert(strstr(json, "\"dropped\":7") != NULL);
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_full_buffer_keeps_spans_balanced PASSED\n");
+}
+
+static void test_trace_closes_open_spans_on_export(void) {
+  printf("  Running test_trace_closes_open_spans_on_export...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 2u, 32u);
+
+  assert(vkr_trace_capture_start());
+  VKR_TRACE_BEGIN("unterminated");
+  VKR_TRACE_BEGIN("nested");
+  vkr_trace_capture_stop();
+  // The END lands after the capture and must not disturb the next one.
+  VKR_TRACE_END("nested");
+  VKR_TRACE_END("unterminated");
+
+  static TraceMemorySink sink;
+  trace_write_chrome(&sink);
+  const char *json = (const char *)sink.data;
+  assert(trace_count_occurrences(json, "\"ph\":\"B\"") == 2u);
+  assert(trace_count_occurrences(json, "\"ph\":\"E\"") == 2u);
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_closes_open_spans_on_export PASSED\n");
+}
+
+typedef struct TraceThreadContext {
+  uint32_t spans;
+  uint32_t index;
+} TraceThreadContext;
+
+static void *trace_span_thread(void *arg) {
+  TraceThreadContext *context = (TraceThreadContext *)arg;
+  VKR_TRACE_THREAD_NAME("test.worker");
+  for (uint32_t i = 0; i < context->spans; ++i) {
+    VKR_TRACE_SCOPE("work") {
+      VKR_TRACE_FLOW_STEP("job", vkr_trace_flow_id(i + 1u, context->index));
+    }
+  }
+  return NULL;
+}
+
+static void test_trace_per_thread_buffers(void) {
+  printf("  Running test_trace_per_thread_buffers...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 8u, 4096u);
+
+  assert(vkr_trace_capture_start());
+  enum { THREAD_COUNT = 4, SPANS = 500 };
+  VkrThread threads[THREAD_COUNT] = {0};
+  TraceThreadContext contexts[THREAD_COUNT] = {0};
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    contexts[i] = (TraceThreadContext){.spans = SPANS, .index = i + 1u};
+    assert(vkr_thread_create(&fixture.allocator, &threads[i],
+                             trace_span_thread, &contexts[i]));
+  }
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_join(threads[i]));
+    assert(vkr_thread_destroy(&fixture.allocator, &threads[i]));
+  }
+  vkr_trace_capture_stop();
+
+  const VkrTraceStats stats = vkr_trace_get_stats();
+  assert(stats.threads == THREAD_COUNT);
+  assert(stats.recorded == THREAD_COUNT * SPANS * 3u);
+  assert(stats.dropped == 0u);
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_per_thread_buffers PASSED\n");
+}
+
+static void *trace_busy_thread(void *arg) {
+  VkrAtomicBool *running = (VkrAtomicBool *)arg;
+  while (vkr_atomic_bool_load(running, VKR_MEMORY_ORDER_ACQUIRE)) {
+    VKR_TRACE_SCOPE("busy") { VKR_TRACE_COUNTER("spin", 1u); }
+  }
+  return NULL;
+}
+
+static void test_trace_stop_while_recording(void) {
+  printf("  Running test_trace_stop_while_recording...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 4u, 128u);
+
+  VkrAtomicBool running;
+  vkr_atomic_bool_store(&running, true_v, VKR_MEMORY_ORDER_RELEASE);
+  enum { THREAD_COUNT = 2 };
+  VkrThread threads[THREAD_COUNT] = {0};
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_create(&fixture.allocator, &threads[i],
+                             trace_busy_thread, &running));
+  }
+  for (uint32_t round = 0; round < 20u; ++round) {
+    assert(vkr_trace_capture_start());
+    vkr_thread_sleep(1);
+    vkr_trace_capture_stop();
+    // Stable after stop even though the writers keep going.
+    const VkrTraceStats first = vkr_trace_get_stats();
+    vkr_thread_sleep(1);
+    const VkrTraceStats second = vkr_trace_get_stats();
+    assert(first.recorded == second.recorded);
+    assert(first.dropped == second.dropped);
+    static TraceMemorySink sink;
+    trace_write_chrome(&sink);
+    const char *json = (const char *)sink.data;
+    assert(trace_count_occurrences(json, "\"ph\":\"B\"") ==
+           trace_count_occurrences(json, "\"ph\":\"E\""));
+  }
+  vkr_atomic_bool_store(&running, false_v, VKR_MEMORY_ORDER_RELEASE);
+  for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+    assert(vkr_thread_join(threads[i]));
+    assert(vkr_thread_destroy(&fixture.allocator, &threads[i]));
+  }
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_stop_while_recording PASSED\n");
+}
+
+typedef struct TraceProtoReader {
+  const uint8_t *data;
+  uint64_t length;
+  uint64_t offset;
+} TraceProtoReader;
+
+static uint64_t trace_proto_varint(TraceProtoReader *reader) {
+  uint64_t value = 0;
+  for (uint32_t shift = 0; reader->offset < reader->length; shift += 7u) {
+    const uint8_t byte = reader->data[reader->offset++];
+    value |= (uint64_t)(byte & 0x7fu) << shift;
+    if (!(byte & 0x80u)) {
+      break;
+    }
+  }
+  return value;
+}
+
+/** Reads one field header; length-delimited payloads land in `out_payload`. */
+static bool8_t trace_proto_next(TraceProtoReader *reader, uint32_t *out_field,
+                                uint64_t *out_value,
+                                TraceProtoReader *out_payload) {
+  if (reader->offset >= reader->length) {
+    return false_v;
+  }
+  const uint64_t tag = trace_proto_varint(reader);
+  *out_field = (uint32_t)(tag >> 3u);
+  switch (tag & 7u) {
+  case 0u:
+    *out_value = trace_proto_varint(reader);
+    break;
+  case 1u:
+    *out_value = 0;
+    for (uint32_t i = 0; i < 8u; ++i) {
+      *out_value |= (uint64_t)reader->data[reader->offset + i] << (8u * i);
+    }
+    reader->offset += 8u;
+    break;
+  case 2u: {
+    const uint64_t length = trace_proto_varint(reader);
+    *out_payload = (TraceProtoReader){
+        .data = reader->data + reader->offset, .length = length};
+    reader->offset += length;
+    break;
+  }
+  default:
+    assert(false && "Unexpected wire type");
+  }
+  assert(reader->offset <= reader->length);
+  return true_v;
+}
+
+static void test_trace_perfetto_encoding(void) {
+  printf("  Running test_trace_perfetto_encoding...\n");
+  TraceFixture fixture = {0};
+  trace_fixture_init(&fixture, 2u, 32u);
+
+  const uint64_t flow = vkr_trace_flow_id(7u, 3u);
+  assert(vkr_trace_capture_start());
+  VKR_TRACE_SCOPE("slice") {
+    VKR_TRACE_COUNTER("depth", 5u);
+    VKR_TRACE_FLOW_BEGIN("job", flow);
+    VKR_TRACE_FLOW_END("job", flow);
+  }
+  vkr_trace_capture_stop();
+
+  static TraceMemorySink sink;
+  assert(vkr_trace_write_perfetto(trace_memory_sink_write, &sink));
+
+  TraceProtoReader trace = {.data = sink.data, .length = sink.length};
+  uint32_t descriptors = 0;
+  uint32_t counter_descriptors = 0;
+  uint32_t event_types[8] = {0};
+  uint32_t event_count = 0;
+  uint64_t counter_value = 0;
+  uint64_t flow_ids = 0;
+  uint64_t terminating_flow_ids = 0;
+  uint32_t field = 0;
+  uint64_t value = 0;
+  TraceProtoReader packet = {0};
+  while (trace_proto_next(&trace, &field, &value, &packet)) {
+    assert(field == 1u);
+    TraceProtoReader message = {0};
+    uint64_t sequence_id = 0;
+    while (trace_proto_next(&packet, &field, &value, &message)) {
+      if (field == 10u) {
+        sequence_id = value;
+      } else if (field == 60u) {
+        descriptors++;
+        TraceProtoReader inner = {0};
+        while (trace_proto_next(&message, &field, &value, &inner)) {
+          counter_descriptors += field == 8u;
+        }
+      } else if (field == 11u) {
+        assert(event_count < ArrayCount(event_types));
+        TraceProtoReader inner = {0};
+        while (trace_proto_next(&message, &field, &value, &inner)) {
+          if (field == 9u) {
+            event_types[event_count] = (uint32_t)value;
+          } else if (field == 30u) {
+            counter_value = value;
+          } else if (field == 47u) {
+            flow_ids = value;
+          } else if (field == 48u) {
+            terminating_flow_ids = value;
+          }
+        }
+        event_count++;
+      }
+    }
+    assert(sequence_id == 1u);
+  }
+
+  // Process, thread and counter tracks.
+  assert(descriptors == 3u);
+  assert(counter_descriptors == 1u);
+  assert(event_count == 5u);
+  // SLICE_BEGIN, COUNTER, INSTANT (flow), INSTANT (flow), SLICE_END.
+  assert(event_types[0] == 1u && event_types[1] == 4u &&
+         event_types[2] == 3u && event_types[3] == 3u &&
+         event_types[4] == 2u);
+  assert(counter_value == 5u);
+  assert(flow_ids == flow);
+  assert(terminating_flow_ids == flow);
+
+  trace_fixture_destroy(&fixture);
+  printf("  test_trace_perfetto_encoding PASSED\n");
+}
+
+bool32_t run_trace_tests(void) {
+  printf("--- Starting Trace Tests ---\n");
+  test_trace_records_nested_spans();
+  test_trace_full_buffer_keeps_spans_balanced();
+  test_trace_closes_open_spans_on_export();
+  test_trace_per_thread_buffers();
+  test_trace_stop_while_recording();
+  test_trace_perfetto_encoding();
+  printf("--- Trace Tests Completed ---\n");
+  return true;
+}
@@ -0,0 +1,211 @@
+#include "ui_batcher_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define UI_BATCHER_TEST_WIDGETS 4u
+#define UI_BATCHER_TEST_QUADS 4u
+
+typedef struct UiBatcherTestWidget {
+  VkrTextVertex vertices[UI_BATCHER_TEST_QUADS * 4u];
+  uint32_t indices[UI_BATCHER_TEST_QUADS * 6u];
+} UiBatcherTestWidget;
+
+typedef struct UiBatcherTestFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrUiBatcher batcher;
+  UiBatcherTestWidget geometry[UI_BATCHER_TEST_WIDGETS];
+  VkrPreparedTextDraw widgets[UI_BATCHER_TEST_WIDGETS];
+  VkrPreparedTextDraw draws[UI_BATCHER_TEST_WIDGETS];
+} UiBatcherTestFixture;
+
+/** Shapes `quads` unit quads for widget `i`, translated to (x, 0). */
+static void ui_batcher_test_set_widget(UiBatcherTestFixture *fixture,
+                                       uint32_t i, uint32_t quads,
+                                       uint32_t atlas_id, float32_t x) {
+  UiBatcherTestWidget *geometry = &fixture->geometry[i];
+  for (uint32_t q = 0u; q < quads; ++q) {
+    for (uint32_t v = 0u; v < 4u; ++v) {
+      geometry->vertices[q * 4u + v] = (VkrTextVertex){
+          .position = vec2_new((float32_t)(q + (v & 1u)), (float32_t)(v >> 1)),
+          .texcoord = vec2_new(0.0f, 0.0f),
+          .color = vec4_new(1.0f, 1.0f, 1.0f, 1.0f),
+      };
+    }
+    const uint32_t base = q * 4u;
+    const uint32_t quad[6] = {base + 2u, base + 1u, base,
+                              base + 3u, base,      base + 1u};
+    MemCopy(&geometry->indices[q * 6u], quad, sizeof(quad));
+  }
+  const uint32_t revision = fixture->widgets[i].revision + 1u;
+  fixture->widgets[i] = (VkrPreparedTextDraw){
+      .vertices = geometry->vertices,
+      .vertex_count = quads * 4u,
+      .indices = geometry->indices,
+      .index_count = quads * 6u,
+      .max_index = quads * 4u - 1u,
+      .atlas = {.id = atlas_id, .generation = 1u},
+      .model = mat4_translate(vec3_new(x, 0.0f, 0.0f)),
+      .screen_px_range = 2.0f,
+      .font_mode = 1u,
+      .object_id = 100u + i,
+      .revision = revision,
+  };
+}
+
+static void ui_batcher_test_fixture_init(UiBatcherTestFixture *fixture) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+  assert(vkr_ui_batcher_create(&fixture->batcher, &fixture->allocator,
+                               UI_BATCHER_TEST_WIDGETS));
+  ui_batcher_test_set_widget(fixture, 0u, 2u, 1u, 0.0f);
+  ui_batcher_test_set_widget(fixture, 1u, 3u, 1u, 100.0f);
+  ui_batcher_test_set_widget(fixture, 2u, 1u, 2u, 200.0f);
+}
+
+static void ui_batcher_test_fixture_shutdown(UiBatcherTestFixture *fixture) {
+  vkr_ui_batcher_destroy(&fixture->batcher);
+  arena_destroy(fixture->arena);
+}
+
+static uint32_t ui_batcher_test_build(UiBatcherTestFixture *fixture,
+                                      uint32_t widget_count, bool8_t batched,
+                                      VkrUiBatchMetrics *metrics) {
+  return vkr_ui_batcher_build(&fixture->batcher, fixture->widgets,
+                              widget_count, batched, fixture->draws,
+                              UI_BATCHER_TEST_WIDGETS, metrics);
+}
+
+/**
+ * Checks that `draw` reproduces widget `i`'s triangles in screen space
+ * starting at `first_index` of the draw.
+ */
+static void ui_batcher_test_expect_widget(const UiBatcherTestFixture *fixture,
+                                          const VkrPreparedTextDraw *draw,
+                                          uint32_t first_index, uint32_t i) {
+  const VkrPreparedTextDraw *widget = &fixture->widgets[i];
+  const float32_t x = widget->model.cols[3].x;
+  for (uint32_t j = 0u; j < widget->index_count; ++j) {
+    const uint32_t index = draw->indices[first_index + j];
+    assert(index <= draw->max_index);
+    const VkrTextVertex *expected = &widget->vertices[widget->indices[j]];
+    const VkrTextVertex *actual = &draw->vertices[index];
+    assert(actual->position.x == expected->position.x + x);
+    assert(actual->position.y == expected->position.y);
+  }
+}
+
+static void test_ui_batcher_merges_shared_atlas(void) {
+  printf("  Running test_ui_batcher_merges_shared_atlas...\n");
+  UiBatcherTestFixture fixture;
+  ui_batcher_test_fixture_init(&fixture);
+
+  VkrUiBatchMetrics metrics = {0};
+  assert(ui_batcher_test_build(&fixture, 3u, true_v, &metrics) == 2u);
+  assert(metrics.text_widgets == 3u);
+  assert(metrics.widgets_rebuilt == 3u);
+  assert(metrics.draw_calls == 2u);
+
+  // Widgets 0 and 1 share an atlas and collapse into one identity-model draw.
+  const VkrPreparedTextDraw *batch = &fixture.draws[0];
+  assert(batch->vertex_count == 20u);
+  assert(batch->index_count == 30u);
+  assert(batch->max_index == 19u);
+  assert(batch->atlas.id == 1u);
+  assert(batch->object_id == 100u);
+  assert(batch->model.cols[0].x == 1.0f && batch->model.cols[3].x == 0.0f);
+  ui_batcher_test_expect_widget(&fixture, batch, 0u, 0u);
+  ui_batcher_test_expect_widget(&fixture, batch, 12u, 1u);
+  assert(fixture.draws[1].atlas.id == 2u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[1], 0u, 2u);
+
+  // An unchanged frame rewrites nothing and hands back the same draws.
+  const uint32_t revision = batch->revision;
+  assert(ui_batcher_test_build(&fixture, 3u, true_v, &metrics) == 2u);
+  assert(metrics.widgets_rebuilt == 0u);
+  assert(metrics.rebuilt_bytes == 0u);
+  assert(fixture.draws[0].revision == revision);
+
+  // Picking frames get one draw per widget with its own object id.
+  assert(ui_batcher_test_build(&fixture, 3u, false_v, &metrics) == 3u);
+  assert(metrics.widgets_rebuilt == 0u);
+  for (uint32_t i = 0u; i < 3u; ++i) {
+    assert(fixture.draws[i].object_id == 100u + i);
+    assert(fixture.draws[i].index_count == fixture.widgets[i].index_count);
+    ui_batcher_test_expect_widget(&fixture, &fixture.draws[i], 0u, i);
+  }
+
+  ui_batcher_test_fixture_shutdown(&fixture);
+  printf("  test_ui_batcher_merges_shared_atlas PASSED\n");
+}
+
+static void test_ui_batcher_rebuilds_dirty_ranges(void) {
+  printf("  Running test_ui_batcher_rebuilds_dirty_ranges...\n");
+  UiBatcherTestFixture fixture;
+  ui_batcher_test_fixture_init(&fixture);
+  VkrUiBatchMetrics metrics = {0};
+  assert(ui_batcher_test_build(&fixture, 3u, true_v, &metrics) == 2u);
+
+  // Same-size edit: only the edited widget's bytes are rewritten.
+  ui_batcher_test_set_widget(&fixture, 1u, 3u, 1u, 150.0f);
+  assert(ui_batcher_test_build(&fixture, 3u, true_v, &metrics) == 2u);
+  assert(metrics.widgets_rebuilt == 1u);
+  assert(metrics.rebuilt_bytes ==
+         sizeof(VkrTextVertex) * 12u + sizeof(uint32_t) * 18u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[0], 12u, 1u);
+
+  // Growing widget 0 shifts everything behind it; the shifted widgets are
+  // moved, not rebuilt, but widget 1's batch-relative indices change.
+  ui_batcher_test_set_widget(&fixture, 0u, 4u, 1u, 0.0f);
+  assert(ui_batcher_test_build(&fixture, 3u, true_v, &metrics) == 2u);
+  assert(metrics.widgets_rebuilt == 1u);
+  assert(metrics.rebuilt_bytes == sizeof(VkrTextVertex) * 16u +
+                                      sizeof(uint32_t) * 24u +
+                                      sizeof(uint32_t) * 18u);
+  assert(fixture.draws[0].vertex_count == 28u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[0], 0u, 0u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[0], 24u, 1u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[1], 0u, 2u);
+
+  // Dropping the last widget keeps the others intact.
+  assert(ui_batcher_test_build(&fixture, 2u, true_v, &metrics) == 1u);
+  assert(metrics.widgets_rebuilt == 0u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[0], 24u, 1u);
+
+  ui_batcher_test_fixture_shutdown(&fixture);
+  printf("  test_ui_batcher_rebuilds_dirty_ranges PASSED\n");
+}
+
+static void test_ui_batcher_passes_through_projected_widgets(void) {
+  printf("  Running test_ui_batcher_passes_through_projected_widgets...\n");
+  UiBatcherTestFixture fixture;
+  ui_batcher_test_fixture_init(&fixture);
+  ui_batcher_test_set_widget(&fixture, 2u, 1u, 1u, 200.0f);
+  ui_batcher_test_set_widget(&fixture, 3u, 1u, 1u, 300.0f);
+  // A widget lifted off the z = 0 plane cannot be flattened into the arena.
+  fixture.widgets[1].model.cols[3].z = 0.5f;
+
+  VkrUiBatchMetrics metrics = {0};
+  assert(ui_batcher_test_build(&fixture, 4u, true_v, &metrics) == 3u);
+  assert(metrics.widgets_rebuilt == 3u);
+  assert(fixture.draws[0].vertex_count == 8u);
+  assert(fixture.draws[1].vertices == fixture.widgets[1].vertices);
+  assert(fixture.draws[1].model.cols[3].z == 0.5f);
+  assert(fixture.draws[2].vertex_count == 8u);
+  ui_batcher_test_expect_widget(&fixture, &fixture.draws[2], 6u, 3u);
+
+  ui_batcher_test_fixture_shutdown(&fixture);
+  printf("  test_ui_batcher_passes_through_projected_widgets PASSED\n");
+}
+
+bool32_t run_ui_batcher_tests() {
+  printf("--- Running UI batcher tests... ---\n");
+  test_ui_batcher_merges_shared_atlas();
+  test_ui_batcher_rebuilds_dirty_ranges();
+  test_ui_batcher_passes_through_projected_widgets();
+  printf("--- UI batcher tests completed. ---\n");
+  return true_v;
+}
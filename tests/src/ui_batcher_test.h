@@ -0,0 +1,9 @@
+#pragma once
+
+#include "core/logger.h"
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/systems/vkr_ui_batcher.h"
+#include "renderer/vkr_render_packet.h"
+#include "vkr_pch.h"
+
+bool32_t run_ui_batcher_tests();
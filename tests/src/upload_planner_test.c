@@ -0,0 +1,225 @@
+#include "upload_planner_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define PLANNER_TEST_STAGING 1024u
+#define PLANNER_TEST_FRAMES 2u
+#define PLANNER_TEST_SLICE (PLANNER_TEST_STAGING / PLANNER_TEST_FRAMES)
+
+typedef struct PlannerTestFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  uint8_t staging[PLANNER_TEST_STAGING];
+  VkrUploadPlanner planner;
+} PlannerTestFixture;
+
+static void planner_test_fixture_init(PlannerTestFixture *fixture,
+                                      uint32_t max_writes,
+                                      uint64_t alignment) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+  const VkrUploadPlannerConfig config = {
+      .staging_size = PLANNER_TEST_STAGING,
+      .frame_count = PLANNER_TEST_FRAMES,
+      .max_writes = max_writes,
+      .alignment = alignment,
+  };
+  const VkrGpuAddressPair staging = {
+      .cpu_address = fixture->staging,
+      .gpu_address = 0x10000u,
+      .size = sizeof(fixture->staging),
+  };
+  assert(vkr_upload_planner_create(&fixture->planner, &fixture->allocator,
+                                   &config, staging));
+}
+
+static void planner_test_fixture_shutdown(PlannerTestFixture *fixture) {
+  vkr_upload_planner_destroy(&fixture->planner);
+  arena_destroy(fixture->arena);
+}
+
+/** Fills `size` bytes with `value` and stages them. */
+static VkrUploadPlannerStatus planner_test_write(VkrUploadPlanner *planner,
+                                                 uint64_t destination,
+                                                 uint64_t offset,
+                                                 uint64_t size,
+                                                 uint8_t value) {
+  uint8_t bytes[PLANNER_TEST_SLICE];
+  assert(size <= sizeof(bytes));
+  MemSet(bytes, value, size);
+  return vkr_upload_planner_write(planner, destination, offset, bytes, size);
+}
+
+/** Replays `copies` from staging into `destinations`, indexed by key. */
+static void planner_test_replay(const PlannerTestFixture *fixture,
+                                const VkrUploadCopy *copies, uint32_t count,
+                                uint8_t destinations[][64]) {
+  for (uint32_t i = 0u; i < count; ++i) {
+    assert(i == 0u || copies[i - 1u].wave <= copies[i].wave);
+    assert(copies[i].destination_offset + copies[i].size <= 64u);
+    MemCopy(destinations[copies[i].destination] + copies[i].destination_offset,
+            fixture->staging + copies[i].source_offset, copies[i].size);
+  }
+}
+
+static void test_upload_planner_merges_adjacent_ranges(void) {
+  printf("  Running test_upload_planner_merges_adjacent_ranges...\n");
+  PlannerTestFixture fixture;
+  planner_test_fixture_init(&fixture, 16u, 16u);
+  VkrUploadPlanner *planner = &fixture.planner;
+  assert(vkr_upload_planner_begin_frame(planner, 0u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  // Three sequential rows of destination 1 become one region; destination 0
+  // sorts first, and its gapped write stays separate.
+  assert(planner_test_write(planner, 1u, 0u, 16u, 0xA1) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 1u, 16u, 16u, 0xA2) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 0u, 0u, 8u, 0xB1) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 1u, 32u, 16u, 0xA3) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 0u, 32u, 8u, 0xB2) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  const VkrUploadCopy *copies = NULL;
+  const uint32_t count = vkr_upload_planner_build(planner, &copies);
+  // Destination 1's third row was staged after destination 0's first write,
+  // so only its first two rows are adjacent in staging.
+  assert(count == 4u);
+  assert(copies[0].destination == 0u && copies[0].destination_offset == 0u);
+  assert(copies[1].destination == 0u && copies[1].destination_offset == 32u);
+  assert(copies[2].destination == 1u && copies[2].destination_offset == 0u);
+  assert(copies[2].size == 32u && copies[2].source_offset == 0u);
+  assert(copies[3].destination == 1u && copies[3].destination_offset == 32u);
+  assert(copies[3].size == 16u);
+  for (uint32_t i = 0u; i < count; ++i) {
+    assert(copies[i].wave == 0u);
+    assert(copies[i].source_offset % 16u == 0u);
+  }
+  assert(planner->stats.writes == 5u && planner->stats.copies == 4u);
+  assert(planner->stats.waves == 1u);
+
+  uint8_t destinations[2][64] = {{0}};
+  planner_test_replay(&fixture, copies, count, destinations);
+  assert(destinations[1][0] == 0xA1 && destinations[1][31] == 0xA2);
+  assert(destinations[1][47] == 0xA3 && destinations[0][39] == 0xB2);
+
+  planner_test_fixture_shutdown(&fixture);
+  printf("  test_upload_planner_merges_adjacent_ranges PASSED\n");
+}
+
+static void test_upload_planner_dedups_repeated_rows(void) {
+  printf("  Running test_upload_planner_dedups_repeated_rows...\n");
+  PlannerTestFixture fixture;
+  planner_test_fixture_init(&fixture, 8u, 4u);
+  VkrUploadPlanner *planner = &fixture.planner;
+  assert(vkr_upload_planner_begin_frame(planner, 0u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  // The same material row written three times costs one staged copy.
+  for (uint8_t value = 1u; value <= 3u; ++value)
+    assert(planner_test_write(planner, 2u, 16u, 16u, value) ==
+           VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner->stats.writes == 1u && planner->stats.deduped == 2u);
+  assert(planner->stats.staged_bytes == 16u);
+
+  const VkrUploadCopy *copies = NULL;
+  assert(vkr_upload_planner_build(planner, &copies) == 1u);
+  assert(copies[0].size == 16u);
+  assert(fixture.staging[copies[0].source_offset] == 3u);
+
+  // An overlapping but different range must land after the row it covers,
+  // and the row's later rewrite must land after that.
+  assert(planner_test_write(planner, 2u, 24u, 16u, 4u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 2u, 16u, 16u, 5u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  const uint32_t count = vkr_upload_planner_build(planner, &copies);
+  assert(count == 2u);
+  assert(copies[0].destination_offset == 24u && copies[0].wave == 0u);
+  assert(copies[1].destination_offset == 16u && copies[1].wave == 1u);
+  assert(planner->stats.waves == 2u);
+
+  uint8_t destinations[3][64] = {{0}};
+  planner_test_replay(&fixture, copies, count, destinations);
+  assert(destinations[2][16] == 5u && destinations[2][31] == 5u);
+  assert(destinations[2][32] == 4u && destinations[2][39] == 4u);
+
+  planner_test_fixture_shutdown(&fixture);
+  printf("  test_upload_planner_dedups_repeated_rows PASSED\n");
+}
+
+static void test_upload_planner_ring_and_overflow(void) {
+  printf("  Running test_upload_planner_ring_and_overflow...\n");
+  PlannerTestFixture fixture;
+  planner_test_fixture_init(&fixture, 4u, 64u);
+  VkrUploadPlanner *planner = &fixture.planner;
+  assert(vkr_upload_planner_remaining(planner) == 0u);
+  assert(planner_test_write(planner, 0u, 0u, 4u, 1u) ==
+         VKR_UPLOAD_PLANNER_STATUS_INVALID_ARGUMENT);
+
+  assert(vkr_upload_planner_begin_frame(planner, 0u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(vkr_upload_planner_remaining(planner) == PLANNER_TEST_SLICE);
+  assert(planner_test_write(planner, 0u, 0u, 200u, 1u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  // 200 bytes round up to 256 before the next write starts.
+  assert(vkr_upload_planner_remaining(planner) == PLANNER_TEST_SLICE - 256u);
+  assert(planner_test_write(planner, 0u, 256u, 300u, 2u) ==
+         VKR_UPLOAD_PLANNER_STATUS_FULL);
+  assert(planner->stats.overflows == 1u);
+  assert(vkr_upload_planner_submit(planner, 5u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  // The second slice starts half way into staging.
+  const VkrUploadCopy *copies = NULL;
+  assert(vkr_upload_planner_begin_frame(planner, 0u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 7u, 0u, 8u, 3u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(vkr_upload_planner_build(planner, &copies) == 1u);
+  assert(copies[0].source_offset == PLANNER_TEST_SLICE);
+  assert(vkr_upload_planner_submit(planner, 6u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  // The first slice is reused only once its submission completes.
+  assert(vkr_upload_planner_begin_frame(planner, 4u) ==
+         VKR_UPLOAD_PLANNER_STATUS_BUSY);
+  assert(planner->busy_frames == 1u);
+  assert(vkr_upload_planner_begin_frame(planner, 5u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner->stats.writes == 0u);
+  assert(vkr_upload_planner_build(planner, &copies) == 0u);
+
+  // A cancelled slice is immediately reusable.
+  vkr_upload_planner_cancel(planner);
+  assert(vkr_upload_planner_begin_frame(planner, 5u) ==
+         VKR_UPLOAD_PLANNER_STATUS_BUSY);
+  assert(vkr_upload_planner_begin_frame(planner, 6u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+  for (uint32_t i = 0u; i < 4u; ++i)
+    assert(planner_test_write(planner, 0u, i * 4u, 4u, 1u) ==
+           VKR_UPLOAD_PLANNER_STATUS_OK);
+  assert(planner_test_write(planner, 0u, 16u, 4u, 1u) ==
+         VKR_UPLOAD_PLANNER_STATUS_FULL);
+  vkr_upload_planner_cancel(planner);
+  assert(vkr_upload_planner_begin_frame(planner, 6u) ==
+         VKR_UPLOAD_PLANNER_STATUS_OK);
+
+  planner_test_fixture_shutdown(&fixture);
+  printf("  test_upload_planner_ring_and_overflow PASSED\n");
+}
+
+bool32_t run_upload_planner_tests() {
+  printf("--- Running upload planner tests... ---\n");
+  test_upload_planner_merges_adjacent_ranges();
+  test_upload_planner_dedups_repeated_rows();
+  test_upload_planner_ring_and_overflow();
+  printf("--- Upload planner tests completed. ---\n");
+  return true_v;
+}
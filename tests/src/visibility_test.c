@@ -2,7 +2,13 @@
 
 #include "math/vkr_frustum.h"
 #include "math/vkr_math.h"
+#include "math/vkr_transform.h"
+#include "math/vkr_triangle_bvh.h"
+#include "memory/vkr_arena_allocator.h"
 #include "renderer/renderer_frontend.h"
+#include "renderer/systems/vkr_geometry_system.h"
+#include "renderer/systems/vkr_material_system.h"
+#include "renderer/systems/vkr_mesh_manager.h"
 #include "renderer/vkr_visibility.h"
 
 #include <assert.h>
@@ -278,6 +284,502 @@ static void test_submesh_sphere_is_conservative_under_scale(void) {
          0.0001f);
 }
 
+static void test_sphere_screen_area(void) {
+  const Vec3 eye = vec3_zero();
+  // A 90 degree vertical field of view has m11 = 1, so a unit sphere at
+  // distance sqrt(2) spans a quarter of the viewport height in radius.
+  const float32_t area = vkr_visibility_sphere_screen_area(
+      vec3_new(0.0f, 0.0f, -vkr_sqrt_f32(2.0f)), 1.0f, eye, 1.0f, 800u, 400u);
+  assert(vkr_abs_f32(area - VKR_PI * 200.0f * 200.0f) < 1.0f);
+
+  const float32_t far = vkr_visibility_sphere_screen_area(
+      vec3_new(0.0f, 0.0f, -100.0f), 1.0f, eye, 1.0f, 800u, 400u);
+  assert(far > 0.0f && far < area);
+  assert(vkr_visibility_sphere_screen_area(vec3_new(0.5f, 0.0f, 0.0f), 1.0f,
+                                           eye, 1.0f, 800u, 400u) ==
+         800.0f * 400.0f);
+  assert(vkr_visibility_sphere_screen_area(vec3_new(0.0f, 0.0f, -1.01f), 1.0f,
+                                           eye, 1.0f, 800u, 400u) ==
+         800.0f * 400.0f);
+}
+
+static void test_opaque_set_version_tracks_inputs(void) {
+  VkrOpaqueSetVersion state = {0};
+  const uint64_t first = vkr_opaque_set_version_update(&state, 0u, 0u, false_v);
+  assert(first != 0u);
+  assert(vkr_opaque_set_version_update(&state, 0u, 0u, false_v) == first);
+
+  const uint64_t moved = vkr_opaque_set_version_update(&state, 1u, 0u, false_v);
+  assert(moved != first);
+  const uint64_t published =
+      vkr_opaque_set_version_update(&state, 1u, 1u, false_v);
+  assert(published != moved);
+  const uint64_t picking =
+      vkr_opaque_set_version_update(&state, 1u, 1u, true_v);
+  assert(picking != published);
+  const uint64_t unpicked =
+      vkr_opaque_set_version_update(&state, 1u, 1u, false_v);
+  assert(unpicked != picking && unpicked != published);
+  assert(vkr_opaque_set_version_update(&state, 1u, 1u, false_v) == unpicked);
+}
+
+/*
+ * Mesh manager fixture: a geometry system over a publisher that accepts
+ * everything, a material system holding one unnamed opaque material, and a
+ * manager with static batching on (and picking BVHs when asked). Unnamed
+ * materials have no lifetime entry, so references taken by the manager are
+ * no-ops.
+ */
+typedef struct MeshVersionFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrAssetPublisher publisher;
+  VkrGeometrySystem geometry_system;
+  VkrMaterialSystem material_system;
+  VkrMeshManager manager;
+  VkrMaterialHandle material;
+} MeshVersionFixture;
+
+static bool8_t mesh_version_publish_geometry(void *state,
+                                             VkrGeometryHandle handle,
+                                             const VkrGeometryConfig *config) {
+  (void)state;
+  (void)handle;
+  (void)config;
+  return true_v;
+}
+
+static bool8_t mesh_version_unpublish_geometry(void *state,
+                                               VkrGeometryHandle handle) {
+  (void)state;
+  (void)handle;
+  return true_v;
+}
+
+static void mesh_version_fixture_init(MeshVersionFixture *fixture,
+                                      bool8_t build_picking_bvh) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+
+  fixture->publisher = (VkrAssetPublisher){
+      .publish_geometry = mesh_version_publish_geometry,
+      .unpublish_geometry = mesh_version_unpublish_geometry,
+  };
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  const VkrGeometrySystemConfig geometry_config = {
+      .max_geometries = 16u,
+      .asset_publisher = &fixture->publisher,
+  };
+  assert(vkr_geometry_system_init(&fixture->geometry_system, &geometry_config,
+                                  &error));
+
+  fixture->material_system.materials =
+      array_create_VkrMaterial(&fixture->allocator, 1u);
+  fixture->material_system.materials.data[0] = (VkrMaterial){
+      .id = 1u,
+      .generation = 1u,
+      .alpha_mode = VKR_MATERIAL_ALPHA_OPAQUE,
+      .alpha_mode_explicit = true_v,
+  };
+  fixture->material = (VkrMaterialHandle){.id = 1u, .generation = 1u};
+
+  const VkrMeshManagerConfig config = {
+      .max_mesh_count = 8u,
+      .build_picking_bvh = build_picking_bvh,
+      .static_batching = true_v,
+      .static_batch_cell_size = 16.0f,
+  };
+  assert(vkr_mesh_manager_init(&fixture->manager, &fixture->geometry_system,
+                               &fixture->material_system, &config));
+}
+
+static void mesh_version_fixture_shutdown(MeshVersionFixture *fixture) {
+  vkr_mesh_manager_shutdown(&fixture->manager);
+  vkr_geometry_system_shutdown(&fixture->geometry_system);
+  arena_destroy(fixture->arena);
+}
+
+/**
+ * Stands up a loaded one-triangle asset in slot 0 the way the loader leaves
+ * one, with a retained static source. The fixture holds a reference so the
+ * asset outlives its instances.
+ */
+static VkrMeshAssetHandle
+mesh_version_add_asset(MeshVersionFixture *fixture) {
+  VkrMeshManager *manager = &fixture->manager;
+  VkrAllocator *static_allocator = &manager->static_batch_allocator;
+  VkrVertex3d *vertices = vkr_allocator_alloc(
+      static_allocator, sizeof(*vertices) * 3u, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint32_t *indices = vkr_allocator_alloc(
+      static_allocator, sizeof(*indices) * 3u, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  VkrStaticBatchSource *source = vkr_allocator_alloc(
+      static_allocator, sizeof(*source), VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  assert(vertices && indices && source);
+  const Vec3 positions[3] = {vec3_new(-1.0f, 0.0f, 0.0f),
+                             vec3_new(1.0f, 0.0f, 0.0f),
+                             vec3_new(0.0f, 1.0f, 0.0f)};
+  for (uint32_t i = 0; i < 3u; ++i) {
+    vertices[i] = (VkrVertex3d){
+        .position = {positions[i].x, positions[i].y, positions[i].z},
+        .normal = {0.0f, 0.0f, 1.0f},
+        .colour = vec4_new(1.0f, 1.0f, 1.0f, 1.0f),
+        .tangent = vec4_new(1.0f, 0.0f, 0.0f, 1.0f),
+    };
+    indices[i] = i;
+  }
+  *source = (VkrStaticBatchSource){
+      .vertices = vertices,
+      .vertex_count = 3u,
+      .indices = indices,
+      .index_size = sizeof(uint32_t),
+      .index_count = 3u,
+  };
+
+  VkrMeshAsset *asset = &manager->mesh_assets.data[0];
+  *asset = (VkrMeshAsset){
+      .id = 1u,
+      .generation = manager->asset_generation_counter++,
+      .submeshes =
+          array_create_VkrMeshAssetSubmesh(&manager->asset_allocator, 1u),
+      .bounds_valid = true_v,
+      .bounds_local_radius = 1.0f,
+      .static_source = source,
+      .loading_state = VKR_MESH_LOADING_STATE_LOADED,
+      .ref_count = 1u,
+  };
+  asset->submeshes.data[0] = (VkrMeshAssetSubmesh){
+      .geometry = fixture->geometry_system.default_geometry,
+      .material = fixture->material,
+      .index_count = 3u,
+      .min_extents = vec3_new(-1.0f, 0.0f, 0.0f),
+      .max_extents = vec3_new(1.0f, 1.0f, 0.0f),
+  };
+  manager->next_asset_index = 1u;
+  manager->asset_count = 1u;
+  return (VkrMeshAssetHandle){.id = asset->id, .generation = asset->generation};
+}
+
+static void test_mesh_manager_render_version_tracks_meshes(void) {
+  MeshVersionFixture fixture;
+  mesh_version_fixture_init(&fixture, false_v);
+  VkrMeshManager *manager = &fixture.manager;
+
+  const VkrSubMeshDesc submesh = {
+      .geometry = fixture.geometry_system.default_geometry,
+      .material = fixture.material,
+      .index_count = 3u,
+      .min_extents = vec3_new(-1.0f, -1.0f, -1.0f),
+      .max_extents = vec3_new(1.0f, 1.0f, 1.0f),
+  };
+  const VkrMeshDesc desc = {
+      .transform = vkr_transform_identity(),
+      .submeshes = &submesh,
+      .submesh_count = 1u,
+  };
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  uint32_t index = VKR_INVALID_ID;
+  uint64_t version = manager->render_version;
+  assert(vkr_mesh_manager_add(manager, &desc, &index, &error));
+  assert(manager->render_version > version);
+
+  // Re-submitting the current model is not a change.
+  version = manager->render_version;
+  VkrMesh *mesh = vkr_mesh_manager_get(manager, index);
+  assert(vkr_mesh_manager_set_model(manager, index, mesh->model));
+  vkr_mesh_manager_update_model(manager, index);
+  assert(manager->render_version == version);
+
+  Mat4 moved = mat4_translate(vec3_new(4.0f, 0.0f, 0.0f));
+  assert(vkr_mesh_manager_set_model(manager, index, moved));
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  mesh->transform = vkr_transform_from_position(vec3_new(0.0f, 2.0f, 0.0f));
+  vkr_mesh_manager_update_model(manager, index);
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  assert(vkr_mesh_manager_set_visible(manager, index, true_v));
+  assert(manager->render_version == version);
+  assert(vkr_mesh_manager_set_visible(manager, index, false_v));
+  assert(manager->render_version > version);
+
+  // Render ids feed picking only.
+  version = manager->render_version;
+  assert(vkr_mesh_manager_set_render_id(manager, index, 7u));
+  assert(manager->render_version == version);
+
+  assert(vkr_mesh_manager_set_submesh_material(manager, index, 0u,
+                                               fixture.material, &error));
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  assert(vkr_mesh_manager_remove(manager, index));
+  assert(manager->render_version > version);
+
+  mesh_version_fixture_shutdown(&fixture);
+}
+
+static void test_mesh_manager_render_version_tracks_instances(void) {
+  MeshVersionFixture fixture;
+  mesh_version_fixture_init(&fixture, false_v);
+  VkrMeshManager *manager = &fixture.manager;
+  const VkrMeshAssetHandle asset = mesh_version_add_asset(&fixture);
+
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  uint64_t version = manager->render_version;
+  const Mat4 model = mat4_identity();
+  const VkrMeshInstanceHandle instance = vkr_mesh_manager_create_instance(
+      manager, asset, model, 1u, true_v, &error);
+  assert(instance.id != 0);
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  vkr_mesh_manager_instance_sync_render_state(manager, instance, model, 2u,
+                                              true_v);
+  assert(manager->render_version == version);
+
+  vkr_mesh_manager_instance_sync_render_state(
+      manager, instance, mat4_translate(vec3_new(0.0f, 0.0f, 3.0f)), 2u,
+      true_v);
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  vkr_mesh_manager_instance_sync_render_state(manager, instance, model, 2u,
+                                              false_v);
+  assert(manager->render_version > version);
+
+  // A hidden instance ignores model changes until it is shown again.
+  version = manager->render_version;
+  vkr_mesh_manager_instance_sync_render_state(
+      manager, instance, mat4_translate(vec3_new(5.0f, 0.0f, 0.0f)), 2u,
+      false_v);
+  assert(manager->render_version == version);
+  vkr_mesh_manager_instance_sync_render_state(manager, instance, model, 2u,
+                                              true_v);
+  assert(manager->render_version > version);
+
+  version = manager->render_version;
+  assert(vkr_mesh_manager_destroy_instance(manager, instance));
+  assert(manager->render_version > version);
+
+  mesh_version_fixture_shutdown(&fixture);
+}
+
+static void test_mesh_manager_render_version_tracks_static_clusters(void) {
+  MeshVersionFixture fixture;
+  mesh_version_fixture_init(&fixture, false_v);
+  VkrMeshManager *manager = &fixture.manager;
+  const VkrMeshAssetHandle asset = mesh_version_add_asset(&fixture);
+
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  VkrMeshInstanceHandle instances[2] = {0};
+  for (uint32_t i = 0; i < ArrayCount(instances); ++i) {
+    instances[i] = vkr_mesh_manager_create_instance(
+        manager, asset, mat4_translate(vec3_new((float32_t)i, 0.0f, 0.0f)),
+        i + 1u, true_v, &error);
+    assert(instances[i].id != 0);
+    assert(vkr_mesh_manager_set_instance_static(manager, instances[i], true_v));
+  }
+
+  uint64_t version = manager->render_version;
+  vkr_mesh_manager_pump_async(manager);
+  assert(manager->static_cluster_count == 1u);
+  assert(manager->render_version > version);
+
+  // Nothing left to batch: the next pump publishes nothing.
+  version = manager->render_version;
+  vkr_mesh_manager_pump_async(manager);
+  assert(manager->render_version == version);
+
+  assert(vkr_mesh_manager_set_instance_static(manager, instances[0], false_v));
+  assert(manager->static_cluster_count == 0u);
+  assert(manager->render_version > version);
+
+  mesh_version_fixture_shutdown(&fixture);
+}
+
+/**
+ * Gives the slot 0 asset the picking BVH the loader would have built from its
+ * retained triangle, owned by the manager's picking allocator.
+ */
+static void mesh_pick_attach_bvh(MeshVersionFixture *fixture) {
+  VkrMeshManager *manager = &fixture->manager;
+  VkrMeshAsset *asset = &manager->mesh_assets.data[0];
+  const VkrStaticBatchSource *source = asset->static_source;
+  const VkrTriangleMeshSource triangles = {
+      .positions = source->vertices,
+      .position_stride = sizeof(VkrVertex3d),
+      .vertex_count = source->vertex_count,
+      .indices = source->indices,
+      .index_size = source->index_size,
+      .index_count = source->index_count,
+  };
+  VkrTriangleBvh *bvh =
+      vkr_allocator_alloc(&manager->picking_allocator, sizeof(*bvh),
+                          VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+  assert(bvh);
+  assert(vkr_triangle_bvh_create(&manager->picking_allocator, &triangles, 1u,
+                                 bvh));
+  asset->picking_bvh = bvh;
+}
+
+/*
+ * Picking scene, every instance of the unit triangle (x in [-1, 1], y in
+ * [0, 1 - |x|], z = 0) facing the origin down -Z:
+ *   render id 1: z = -5
+ *   render id 2: z = -10, scaled by two
+ *   render id 3: z = -2, hidden
+ *   render id 4: z = -3, its asset still loading when it was created
+ *   render id 5: x = 4, z = -5
+ */
+static void mesh_pick_fixture_init(MeshVersionFixture *fixture) {
+  mesh_version_fixture_init(fixture, true_v);
+  VkrMeshManager *manager = &fixture->manager;
+  const VkrMeshAssetHandle asset = mesh_version_add_asset(fixture);
+  mesh_pick_attach_bvh(fixture);
+
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  const Mat4 models[] = {
+      mat4_translate(vec3_new(0.0f, 0.0f, -5.0f)),
+      mat4_mul(mat4_translate(vec3_new(0.0f, 0.0f, -10.0f)),
+               mat4_scale(vec3_new(2.0f, 2.0f, 2.0f))),
+      mat4_translate(vec3_new(0.0f, 0.0f, -2.0f)),
+      mat4_translate(vec3_new(0.0f, 0.0f, -3.0f)),
+      mat4_translate(vec3_new(4.0f, 0.0f, -5.0f)),
+  };
+  for (uint32_t i = 0; i < ArrayCount(models); ++i) {
+    VkrMeshAsset *slot_asset = &manager->mesh_assets.data[0];
+    slot_asset->loading_state = i == 3u ? VKR_MESH_LOADING_STATE_PENDING
+                                        : VKR_MESH_LOADING_STATE_LOADED;
+    const VkrMeshInstanceHandle instance = vkr_mesh_manager_create_instance(
+        manager, asset, models[i], i + 1u, i != 2u, &error);
+    assert(instance.id != 0);
+  }
+  manager->mesh_assets.data[0].loading_state = VKR_MESH_LOADING_STATE_LOADED;
+}
+
+static bool8_t mesh_pick_skip_render_id(const VkrMeshQueryItem *item,
+                                        void *user_data) {
+  return item->render_id != *(const uint32_t *)user_data;
+}
+
+typedef struct MeshPickCollected {
+  uint32_t render_ids[8];
+  uint32_t count;
+} MeshPickCollected;
+
+static bool8_t mesh_pick_collect(const VkrMeshQueryItem *item,
+                                 void *user_data) {
+  MeshPickCollected *collected = (MeshPickCollected *)user_data;
+  assert(item->is_instance);
+  assert(collected->count < ArrayCount(collected->render_ids));
+  collected->render_ids[collected->count++] = item->render_id;
+  return true_v;
+}
+
+static void test_mesh_manager_raycast_picks_nearest_drawable(void) {
+  MeshVersionFixture fixture;
+  mesh_pick_fixture_init(&fixture);
+  VkrMeshManager *manager = &fixture.manager;
+  const Vec3 forward = vec3_new(0.0f, 0.0f, -1.0f);
+
+  // Hidden and loading instances sit in front but are not drawable.
+  VkrMeshRayHit hit = {0};
+  assert(vkr_mesh_manager_raycast(manager, vec3_new(0.0f, 0.25f, 0.0f),
+                                  vec3_scale(forward, 3.0f), 100.0f, NULL,
+                                  NULL, &hit));
+  assert(hit.item.is_instance && hit.item.render_id == 1u);
+  assert(hit.triangle_hit);
+  assert(vkr_abs_f32(hit.distance - 5.0f) < 1e-4f);
+  assert(vkr_abs_f32(hit.position.z + 5.0f) < 1e-4f);
+
+  // Inside the near bounding sphere but beside its triangle: refinement lets
+  // the ray through to the scaled instance, whose triangle is twice as wide.
+  assert(vkr_mesh_manager_raycast(manager, vec3_new(0.8f, 0.5f, 0.0f),
+                                  forward, 100.0f, NULL, NULL, &hit));
+  assert(hit.item.render_id == 2u && hit.triangle_hit);
+  assert(vkr_abs_f32(hit.distance - 10.0f) < 1e-4f);
+
+  // A filter skips an item without hiding what lies behind it.
+  uint32_t skipped = 1u;
+  assert(vkr_mesh_manager_raycast(manager, vec3_new(0.0f, 0.25f, 0.0f),
+                                  forward, 100.0f, mesh_pick_skip_render_id,
+                                  &skipped, &hit));
+  assert(hit.item.render_id == 2u);
+
+  // Misses: facing away, stopping short, and passing between instances.
+  assert(!vkr_mesh_manager_raycast(manager, vec3_new(0.0f, 0.25f, 0.0f),
+                                   vec3_new(0.0f, 0.0f, 1.0f), 100.0f, NULL,
+                                   NULL, &hit));
+  assert(!vkr_mesh_manager_raycast(manager, vec3_new(0.0f, 0.25f, 0.0f),
+                                   forward, 4.0f, NULL, NULL, &hit));
+  assert(!vkr_mesh_manager_raycast(manager, vec3_new(2.5f, 0.25f, 0.0f),
+                                   forward, 100.0f, NULL, NULL, &hit));
+
+  // Once shown, the hidden instance is the nearest hit.
+  const VkrMeshInstanceHandle hidden = {
+      .id = 3u, .generation = manager->mesh_instances.data[2].generation};
+  vkr_mesh_manager_instance_sync_render_state(
+      manager, hidden, mat4_translate(vec3_new(0.0f, 0.0f, -2.0f)), 3u,
+      true_v);
+  assert(vkr_mesh_manager_raycast(manager, vec3_new(0.0f, 0.25f, 0.0f),
+                                  forward, 100.0f, NULL, NULL, &hit));
+  assert(hit.item.render_id == 3u);
+  assert(vkr_abs_f32(hit.distance - 2.0f) < 1e-4f);
+
+  mesh_version_fixture_shutdown(&fixture);
+}
+
+static void test_mesh_manager_volume_queries_visit_drawables(void) {
+  MeshVersionFixture fixture;
+  mesh_pick_fixture_init(&fixture);
+  VkrMeshManager *manager = &fixture.manager;
+
+  // Reaches the hidden (3 away) and loading (2 away) instances too.
+  MeshPickCollected collected = {0};
+  assert(vkr_mesh_manager_query_sphere(manager, vec3_new(0.0f, 0.0f, -5.0f),
+                                       2.5f, mesh_pick_collect,
+                                       &collected) == 1u);
+  assert(collected.count == 1u && collected.render_ids[0] == 1u);
+
+  collected = (MeshPickCollected){0};
+  assert(vkr_mesh_manager_query_sphere(manager, vec3_new(2.0f, 0.0f, -5.0f),
+                                       1.5f, mesh_pick_collect,
+                                       &collected) == 2u);
+  assert(collected.render_ids[0] + collected.render_ids[1] == 6u);
+
+  collected = (MeshPickCollected){0};
+  assert(vkr_mesh_manager_query_sphere(manager, vec3_new(0.0f, 50.0f, 0.0f),
+                                       1.0f, mesh_pick_collect,
+                                       &collected) == 0u);
+
+  // A 4x4 box from z = -0.1 to -7: holds the near instance; the scaled one
+  // lies beyond the far plane and the offset one beside the box.
+  const Mat4 view =
+      mat4_look_at(vec3_zero(), vec3_new(0.0f, 0.0f, -1.0f), vec3_up());
+  const Mat4 projection =
+      mat4_ortho_zo_yinv(-2.0f, 2.0f, -2.0f, 2.0f, 0.1f, 7.0f);
+  const VkrFrustum frustum = vkr_frustum_from_view_projection(view, projection);
+  collected = (MeshPickCollected){0};
+  assert(vkr_mesh_manager_query_frustum(manager, &frustum, mesh_pick_collect,
+                                        &collected) == 1u);
+  assert(collected.count == 1u && collected.render_ids[0] == 1u);
+
+  mesh_version_fixture_shutdown(&fixture);
+}
+
+static void test_material_publication_version(void) {
+  VkrMaterialSystem system = {0};
+  const VkrMaterialHandle handle = {.id = 1u, .generation = 1u};
+  assert(vkr_material_system_publish(&system, handle, NULL));
+  assert(system.publication_version == 1u);
+  assert(vkr_material_system_unpublish(&system, handle));
+  assert(system.publication_version == 2u);
+}
+
 bool32_t run_visibility_tests(void) {
   printf("--- Starting Visibility Tests ---\n");
   test_packet_pre_recording_rejection();
@@ -291,6 +793,14 @@ bool32_t run_visibility_tests(void) {
   test_orthographic_frustum_uses_vulkan_depth();
   test_transparent_sort_and_emit();
   test_submesh_sphere_is_conservative_under_scale();
+  test_sphere_screen_area();
+  test_opaque_set_version_tracks_inputs();
+  test_mesh_manager_render_version_tracks_meshes();
+  test_mesh_manager_render_version_tracks_instances();
+  test_mesh_manager_render_version_tracks_static_clusters();
+  test_mesh_manager_raycast_picks_nearest_drawable();
+  test_mesh_manager_volume_queries_visit_drawables();
+  test_material_publication_version();
   printf("--- Visibility Tests Completed ---\n");
   return true_v;
 }
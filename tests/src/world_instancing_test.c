@@ -0,0 +1,155 @@
+#include "world_instancing_test.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define WORLD_INSTANCING_TEST_ROWS 8u
+
+typedef struct WorldInstancingTestFixture {
+  Arena *arena;
+  VkrAllocator allocator;
+  VkrWorldDrawCandidate candidates[WORLD_INSTANCING_TEST_ROWS];
+  VkrWorldInstanceRun runs[WORLD_INSTANCING_TEST_ROWS];
+} WorldInstancingTestFixture;
+
+static void
+world_instancing_test_fixture_init(WorldInstancingTestFixture *fixture) {
+  MemZero(fixture, sizeof(*fixture));
+  fixture->arena = arena_create(MB(1), MB(1));
+  fixture->allocator = (VkrAllocator){.ctx = fixture->arena};
+  assert(vkr_allocator_arena(&fixture->allocator));
+}
+
+static void
+world_instancing_test_fixture_shutdown(WorldInstancingTestFixture *fixture) {
+  arena_destroy(fixture->arena);
+}
+
+/** Row `i` draws `geometry`/`material`; its object id records `i`. */
+static void world_instancing_test_set_row(WorldInstancingTestFixture *fixture,
+                                          uint32_t i, uint32_t geometry,
+                                          uint32_t material,
+                                          uint32_t state_bucket) {
+  fixture->candidates[i] = (VkrWorldDrawCandidate){
+      .geometry = {.id = geometry, .generation = 1u},
+      .material = {.id = material, .generation = 1u},
+      .instance = {.model = mat4_identity(), .object_id = i},
+      .state_bucket = state_bucket,
+  };
+}
+
+static void test_world_instancing_groups_repeated_props(void) {
+  printf("  Running test_world_instancing_groups_repeated_props...\n");
+  WorldInstancingTestFixture fixture;
+  world_instancing_test_fixture_init(&fixture);
+
+  // Two props interleaved in emission order, plus a one-off.
+  world_instancing_test_set_row(&fixture, 0u, 1u, 1u, 0u);
+  world_instancing_test_set_row(&fixture, 1u, 2u, 1u, 0u);
+  world_instancing_test_set_row(&fixture, 2u, 1u, 1u, 0u);
+  world_instancing_test_set_row(&fixture, 3u, 2u, 1u, 0u);
+  world_instancing_test_set_row(&fixture, 4u, 1u, 1u, 0u);
+  world_instancing_test_set_row(&fixture, 5u, 3u, 2u, 0u);
+
+  uint32_t run_count = 0u;
+  VkrWorldInstancingStats stats = {0};
+  assert(vkr_world_instancing_build(&fixture.allocator, fixture.candidates, 6u,
+                                    fixture.runs, &run_count, &stats));
+  assert(run_count == 3u);
+  assert(stats.runs_formed == 2u);
+  assert(stats.rows_saved == 3u);
+
+  uint32_t covered = 0u;
+  for (uint32_t r = 0u; r < run_count; ++r) {
+    const VkrWorldInstanceRun *run = &fixture.runs[r];
+    assert(run->first_candidate == covered);
+    const VkrWorldDrawCandidate *head = &fixture.candidates[covered];
+    for (uint32_t i = 1u; i < run->instance_count; ++i) {
+      const VkrWorldDrawCandidate *row = &fixture.candidates[covered + i];
+      assert(row->geometry.id == head->geometry.id);
+      assert(row->material.id == head->material.id);
+      // Rows of a run keep their emission order.
+      assert(row->instance.object_id > row[-1].instance.object_id);
+    }
+    if (head->geometry.id == 1u)
+      assert(run->instance_count == 3u);
+    if (head->geometry.id == 2u)
+      assert(run->instance_count == 2u);
+    if (head->geometry.id == 3u)
+      assert(run->instance_count == 1u);
+    covered += run->instance_count;
+  }
+  assert(covered == 6u);
+
+  world_instancing_test_fixture_shutdown(&fixture);
+  printf("  test_world_instancing_groups_repeated_props PASSED\n");
+}
+
+static void test_world_instancing_splits_on_draw_state(void) {
+  printf("  Running test_world_instancing_splits_on_draw_state...\n");
+  WorldInstancingTestFixture fixture;
+  world_instancing_test_fixture_init(&fixture);
+
+  world_instancing_test_set_row(&fixture, 0u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_CUTOUT_BACK);
+  world_instancing_test_set_row(&fixture, 1u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_OPAQUE_BACK);
+  world_instancing_test_set_row(&fixture, 2u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_OPAQUE_BACK);
+  // Same ids, but another submesh, material generation or geometry
+  // generation is a different draw.
+  world_instancing_test_set_row(&fixture, 3u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_OPAQUE_BACK);
+  fixture.candidates[3].submesh_index = 1u;
+  world_instancing_test_set_row(&fixture, 4u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_OPAQUE_BACK);
+  fixture.candidates[4].material.generation = 2u;
+  world_instancing_test_set_row(&fixture, 5u, 1u, 1u,
+                                VKR_WORLD_DRAW_STATE_OPAQUE_BACK);
+  fixture.candidates[5].geometry.generation = 2u;
+
+  uint32_t run_count = 0u;
+  VkrWorldInstancingStats stats = {.runs_formed = 10u, .rows_saved = 10u};
+  assert(vkr_world_instancing_build(&fixture.allocator, fixture.candidates, 6u,
+                                    fixture.runs, &run_count, &stats));
+  assert(run_count == 5u);
+  // Stats accumulate across calls.
+  assert(stats.runs_formed == 11u);
+  assert(stats.rows_saved == 11u);
+
+  // State buckets order the stream: every opaque row precedes the cutout one.
+  assert(fixture.candidates[5].state_bucket ==
+         VKR_WORLD_DRAW_STATE_CUTOUT_BACK);
+  assert(fixture.candidates[5].instance.object_id == 0u);
+  for (uint32_t r = 0u; r < run_count; ++r) {
+    const VkrWorldInstanceRun *run = &fixture.runs[r];
+    const VkrWorldDrawCandidate *head =
+        &fixture.candidates[run->first_candidate];
+    assert(run->instance_count ==
+           (head->instance.object_id == 1u ? 2u : 1u));
+  }
+
+  // Sorting is deterministic: the same input yields the same order.
+  VkrWorldDrawCandidate first_order[6];
+  MemCopy(first_order, fixture.candidates, sizeof(first_order));
+  assert(vkr_world_instancing_build(&fixture.allocator, fixture.candidates, 6u,
+                                    fixture.runs, &run_count, NULL));
+  assert(MemCompare(first_order, fixture.candidates, sizeof(first_order)) ==
+         0);
+
+  // An empty stream forms no runs.
+  assert(vkr_world_instancing_build(&fixture.allocator, NULL, 0u, fixture.runs,
+                                    &run_count, NULL));
+  assert(run_count == 0u);
+
+  world_instancing_test_fixture_shutdown(&fixture);
+  printf("  test_world_instancing_splits_on_draw_state PASSED\n");
+}
+
+bool32_t run_world_instancing_tests() {
+  printf("--- Running world instancing tests... ---\n");
+  test_world_instancing_groups_repeated_props();
+  test_world_instancing_splits_on_draw_state();
+  printf("--- World instancing tests completed. ---\n");
+  return true_v;
+}
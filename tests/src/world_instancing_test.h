@@ -0,0 +1,7 @@
+#pragma once
+
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/vkr_world_instancing.h"
+#include "vkr_pch.h"
+
+bool32_t run_world_instancing_tests();
@@ -0,0 +1,606 @@
+/**
+ * @file vkr_bench.c
+ * @brief Calibration, timing, and publication for `vkr_bench`.
+ *
+ * A published benchmark run has the layout `compare` reads from a profile
+ * run: a `report.json` whose `comparison` object carries the three identity
+ * fingerprints, and one raw `samples.bin` per repetition. Metric units follow
+ * the harness conventions so the regression direction is inferred the same
+ * way.
+ */
+#include "vkr_bench.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#define VKR_BENCH_CYCLE_COUNTER "tsc"
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <x86intrin.h>
+#define VKR_BENCH_CYCLE_COUNTER "tsc"
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define VKR_BENCH_CYCLE_COUNTER "cntvct"
+#else
+#define VKR_BENCH_CYCLE_COUNTER "none"
+#endif
+
+/** Calibration stops doubling here even if a batch is still too short. */
+#define VKR_BENCH_MAX_ITERATIONS (1ull << 30)
+/** `ns_per_op` and `cycles_per_op`, in that order. */
+#define VKR_BENCH_METRICS_PER_CASE 2u
+
+static volatile uint64_t vkr_bench_sink;
+
+typedef struct VkrBenchSelection {
+  const VkrBenchCase *cases[VKR_BENCH_MAX_CASES];
+  uint64_t iterations[VKR_BENCH_MAX_CASES];
+  uint32_t count;
+} VkrBenchSelection;
+
+typedef struct VkrBenchReport {
+  char run_id[64];
+  char started_at[40];
+  char ended_at[40];
+  const VkrBenchConfig *config;
+  const VkrBenchSelection *selection;
+  VkrHarnessProvenance provenance;
+  VkrHarnessRunReference identity;
+  bool8_t pinned;
+  const VkrHarnessMetricResult *results;
+  char (*sample_digests)[VKR_HARNESS_DIGEST_MAX];
+} VkrBenchReport;
+
+VkrBenchConfig vkr_bench_config_default(void) {
+  return (VkrBenchConfig){
+      .warmup_batches = 5u,
+      .measure_batches = 40u,
+      .repetitions = 3u,
+      .batch_target_ns = 5000000u,
+      .pin_core = 0,
+      .filter = NULL,
+  };
+}
+
+bool8_t vkr_bench_register(VkrBenchRegistry *registry, VkrBenchCase bench) {
+  if (registry->case_count >= VKR_BENCH_MAX_CASES) {
+    vkr_harness_stderr("bench.register: '%s' exceeds VKR_BENCH_MAX_CASES\n",
+                       bench.name);
+    return false_v;
+  }
+  registry->cases[registry->case_count++] = bench;
+  return true_v;
+}
+
+uint64_t vkr_bench_cycles(void) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+  return __rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  uint64_t ticks;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return 0u;
+#endif
+}
+
+bool8_t vkr_bench_cycles_available(void) {
+  return !string_equals(VKR_BENCH_CYCLE_COUNTER, "none");
+}
+
+void vkr_bench_consume(uint64_t value) { vkr_bench_sink ^= value; }
+
+static void vkr_bench_time_batch(const VkrBenchCase *bench,
+                                 VkrBenchContext *context, uint64_t iterations,
+                                 float64_t *out_ns, uint64_t *out_cycles) {
+  const float64_t start = vkr_platform_get_absolute_time();
+  const uint64_t cycles_start = vkr_bench_cycles();
+  bench->run(context, iterations);
+  const uint64_t cycles_end = vkr_bench_cycles();
+  const float64_t end = vkr_platform_get_absolute_time();
+  *out_ns = (end - start) * 1e9;
+  *out_cycles = cycles_end - cycles_start;
+}
+
+uint64_t vkr_bench_calibrate(const VkrBenchCase *bench,
+                             VkrBenchContext *context,
+                             uint64_t batch_target_ns) {
+  uint64_t iterations = 1u;
+  while (iterations < VKR_BENCH_MAX_ITERATIONS) {
+    float64_t ns = 0.0;
+    uint64_t cycles = 0u;
+    vkr_bench_time_batch(bench, context, iterations, &ns, &cycles);
+    if (ns >= (float64_t)batch_target_ns) {
+      break;
+    }
+    iterations *= 2u;
+  }
+  return iterations;
+}
+
+/** Every case starts from an empty arena so no case inherits another's heap. */
+static bool8_t vkr_bench_case_begin(const VkrBenchCase *bench,
+                                    VkrBenchContext *context) {
+  arena_clear(context->arena, ARENA_MEMORY_TAG_UNKNOWN);
+  context->state = NULL;
+  return bench->setup(context);
+}
+
+static void vkr_bench_case_end(const VkrBenchCase *bench,
+                               VkrBenchContext *context) {
+  if (bench->teardown) {
+    bench->teardown(context);
+  }
+  context->state = NULL;
+}
+
+static void vkr_bench_select(const VkrBenchRegistry *registry,
+                             const char *filter,
+                             VkrBenchSelection *out_selection) {
+  out_selection->count = 0u;
+  for (uint32_t i = 0; i < registry->case_count; ++i) {
+    const VkrBenchCase *bench = &registry->cases[i];
+    if (filter && !string_find(bench->name, filter)) {
+      continue;
+    }
+    out_selection->cases[out_selection->count++] = bench;
+  }
+}
+
+/**
+ * Environment is the harness's own projection of the machine; workload is the
+ * selected cases and their units of work; policy is how they were timed. The
+ * calibrated iteration counts are deliberately excluded: they follow from the
+ * machine and the code under test, which is what a comparison measures.
+ */
+static bool8_t vkr_bench_fingerprints(const VkrBenchSelection *selection,
+                                      const VkrBenchConfig *config,
+                                      const VkrHarnessProvenance *provenance,
+                                      Arena *transient,
+                                      VkrHarnessRunReference *identity,
+                                      VkrHarnessError *error) {
+  VkrHarnessFingerprintField environment[VKR_HARNESS_ENVIRONMENT_FIELD_COUNT];
+  const uint32_t environment_count =
+      vkr_harness_environment_fields(provenance, false_v, environment);
+  Scratch scratch = scratch_create(transient);
+  VkrHarnessFingerprintField *fields =
+      arena_alloc(transient, sizeof(*fields) * (selection->count + 1u),
+                  ARENA_MEMORY_TAG_ARRAY);
+  if (!fields) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    vkr_harness_error_set(error, "bench.allocate", "$",
+                          "Unable to allocate the fingerprint fields");
+    return false_v;
+  }
+  string_format(fields[0].name, sizeof(fields[0].name), "suite");
+  string_format(fields[0].value, sizeof(fields[0].value), "vkr_bench");
+  for (uint32_t i = 0; i < selection->count; ++i) {
+    VkrHarnessFingerprintField *field = &fields[i + 1u];
+    string_format(field->name, sizeof(field->name), "%s",
+                  selection->cases[i]->name);
+    string_format(field->value, sizeof(field->value), "ops=%llu",
+                  (unsigned long long)selection->cases[i]->ops_per_iteration);
+  }
+  VkrHarnessFingerprintField policy[4] = {0};
+  string_format(policy[0].name, sizeof(policy[0].name), "warmup_batches");
+  string_format(policy[0].value, sizeof(policy[0].value), "%u",
+                config->warmup_batches);
+  string_format(policy[1].name, sizeof(policy[1].name), "measure_batches");
+  string_format(policy[1].value, sizeof(policy[1].value), "%u",
+                config->measure_batches);
+  string_format(policy[2].name, sizeof(policy[2].name), "batch_target_ns");
+  string_format(policy[2].value, sizeof(policy[2].value), "%llu",
+                (unsigned long long)config->batch_target_ns);
+  string_format(policy[3].name, sizeof(policy[3].name), "pin_core");
+  string_format(policy[3].value, sizeof(policy[3].value), "%d",
+                config->pin_core);
+  const bool8_t ok =
+      vkr_harness_fingerprint(environment, environment_count,
+                              identity->environment_fingerprint, error) &&
+      vkr_harness_fingerprint(fields, selection->count + 1u,
+                              identity->workload_fingerprint, error) &&
+      vkr_harness_fingerprint(policy, ArrayCount(policy),
+                              identity->policy_fingerprint, error);
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  return ok;
+}
+
+static void vkr_bench_catalog(const VkrBenchSelection *selection,
+                              VkrHarnessSampleMetric *catalog) {
+  for (uint32_t i = 0; i < selection->count; ++i) {
+    VkrHarnessSampleMetric *metric = &catalog[i * VKR_BENCH_METRICS_PER_CASE];
+    string_format(metric[0].name, sizeof(metric[0].name), "bench.%s.ns_per_op",
+                  selection->cases[i]->name);
+    string_format(metric[0].unit, sizeof(metric[0].unit), "ns");
+    string_format(metric[1].name, sizeof(metric[1].name),
+                  "bench.%s.cycles_per_op", selection->cases[i]->name);
+    string_format(metric[1].unit, sizeof(metric[1].unit), "cycles");
+  }
+}
+
+/**
+ * Times every selected case for one repetition. `values` and `availability`
+ * are indexed `batch * metric_count + metric` like a profile sample file.
+ */
+static bool8_t vkr_bench_measure(const VkrBenchSelection *selection,
+                                 const VkrBenchConfig *config,
+                                 VkrBenchContext *context, float64_t *values,
+                                 uint8_t *availability,
+                                 VkrHarnessError *error) {
+  const uint32_t metric_count = selection->count * VKR_BENCH_METRICS_PER_CASE;
+  const uint32_t batches = config->warmup_batches + config->measure_batches;
+  const uint8_t cycles_availability = vkr_bench_cycles_available()
+                                          ? VKR_METRIC_AVAILABILITY_VALID
+                                          : VKR_METRIC_AVAILABILITY_UNAVAILABLE;
+  for (uint32_t i = 0; i < selection->count; ++i) {
+    const VkrBenchCase *bench = selection->cases[i];
+    if (!vkr_bench_case_begin(bench, context)) {
+      vkr_harness_error_set(error, "bench.setup", bench->name,
+                            "Setup failed for '%s'", bench->name);
+      return false_v;
+    }
+    const float64_t ops = (float64_t)selection->iterations[i] *
+                          (float64_t)bench->ops_per_iteration;
+    for (uint32_t batch = 0; batch < batches; ++batch) {
+      float64_t ns = 0.0;
+      uint64_t cycles = 0u;
+      vkr_bench_time_batch(bench, context, selection->iterations[i], &ns,
+                           &cycles);
+      const uint64_t offset = (uint64_t)batch * metric_count +
+                              (uint64_t)i * VKR_BENCH_METRICS_PER_CASE;
+      values[offset] = ns / ops;
+      availability[offset] = VKR_METRIC_AVAILABILITY_VALID;
+      values[offset + 1u] = (float64_t)cycles / ops;
+      availability[offset + 1u] = cycles_availability;
+    }
+    vkr_bench_case_end(bench, context);
+  }
+  return true_v;
+}
+
+static bool8_t vkr_bench_samples_publish(const char *run_root,
+                                         uint32_t repetition,
+                                         const VkrBenchConfig *config,
+                                         uint32_t metric_count,
+                                         const VkrHarnessSampleMetric *catalog,
+                                         const float64_t *values,
+                                         const uint8_t *availability,
+                                         Arena *transient, char *out_digest,
+                                         VkrHarnessError *error) {
+  char directory[VKR_HARNESS_PATH_MAX];
+  char path[VKR_HARNESS_PATH_MAX];
+  string_format(directory, sizeof(directory), "%s/runs/%u", run_root,
+                repetition);
+  string_format(path, sizeof(path), "%s/samples.bin", directory);
+  VkrHarnessSampleFileHeader header = {0};
+  MemCopy(header.magic, VKR_HARNESS_SAMPLE_MAGIC, sizeof(header.magic));
+  header.schema_version = VKR_HARNESS_SCHEMA_VERSION;
+  header.metric_count = metric_count;
+  header.warmup_frames = config->warmup_batches;
+  header.measure_frames = config->measure_batches;
+  const VkrHarnessSampleSet samples = {
+      .header = header,
+      .metrics = catalog,
+      .values = values,
+      .availability = availability,
+  };
+  if (!vkr_harness_make_directories(directory, error) ||
+      !vkr_harness_samples_write(path, &header, &samples, transient, error)) {
+    return false_v;
+  }
+  if (!vkr_harness_sha256_file(path, out_digest)) {
+    vkr_harness_error_set(error, "bench.digest", path,
+                          "Unable to digest '%s'", path);
+    return false_v;
+  }
+  return true_v;
+}
+
+static bool8_t vkr_bench_emit_statistics(VkrJsonWriter *writer,
+                                         const VkrHarnessMetricResult *metric) {
+  const VkrHarnessStatistics *statistics = &metric->statistics;
+  return vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_string(writer, "name", metric->name) &&
+         vkr_harness_json_emit_string(writer, "unit", metric->unit) &&
+         vkr_harness_json_emit_u64(writer, "sample_count",
+                                   statistics->sample_count) &&
+         vkr_harness_json_emit_u64(writer, "invalid_count",
+                                   statistics->invalid_count) &&
+         vkr_harness_json_emit_f64(writer, "mean", statistics->mean) &&
+         vkr_harness_json_emit_f64(writer, "p50", statistics->p50) &&
+         vkr_harness_json_emit_f64(writer, "p95", statistics->p95) &&
+         vkr_harness_json_emit_f64(writer, "min", statistics->min) &&
+         vkr_harness_json_emit_f64(writer, "max", statistics->max) &&
+         vkr_harness_json_emit_f64(writer, "stddev", statistics->stddev) &&
+         vkr_json_writer_end_object(writer);
+}
+
+static bool8_t vkr_bench_report_write(const char *path,
+                                      const VkrBenchReport *report,
+                                      VkrHarnessError *error) {
+  VkrJsonFileWriter file_writer = {0};
+  if (!vkr_json_file_writer_begin(
+          &file_writer,
+          string8_create_from_cstr((const uint8_t *)path,
+                                   string_length(path)))) {
+    vkr_harness_error_set(error, "report.open", "$",
+                          "Unable to begin report '%s'", path);
+    return false_v;
+  }
+  VkrJsonWriter *writer = &file_writer.writer;
+  const VkrBenchConfig *config = report->config;
+  const VkrHarnessProvenance *provenance = &report->provenance;
+  const VkrHarnessRunReference *identity = &report->identity;
+  bool8_t ok =
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_u64(writer, "schema_version",
+                                VKR_HARNESS_SCHEMA_VERSION) &&
+      vkr_harness_json_emit_string(writer, "kind", "vkr.bench.report") &&
+      vkr_harness_json_emit_string(writer, "run_id", report->run_id) &&
+      vkr_harness_json_emit_string(writer, "status", "pass") &&
+      vkr_harness_json_emit_string(writer, "started_at", report->started_at) &&
+      vkr_harness_json_emit_string(writer, "ended_at", report->ended_at) &&
+      vkr_harness_json_emit_name(writer, "provenance") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_string(writer, "git_sha", provenance->git_sha) &&
+      vkr_harness_json_emit_bool(writer, "dirty", provenance->dirty) &&
+      vkr_harness_json_emit_string(writer, "build_type",
+                                   provenance->build_type) &&
+      vkr_harness_json_emit_string(writer, "compiler", provenance->compiler) &&
+      vkr_harness_json_emit_string(writer, "os", provenance->os) &&
+      vkr_harness_json_emit_string(writer, "cpu", provenance->cpu) &&
+      vkr_harness_json_emit_string(writer, "binary_sha256",
+                                   provenance->binary_sha256) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "comparison") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_string(writer, "environment_fingerprint",
+                                   identity->environment_fingerprint) &&
+      vkr_harness_json_emit_string(writer, "workload_fingerprint",
+                                   identity->workload_fingerprint) &&
+      vkr_harness_json_emit_string(writer, "policy_fingerprint",
+                                   identity->policy_fingerprint) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "policy") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_u64(writer, "warmup_batches",
+                                config->warmup_batches) &&
+      vkr_harness_json_emit_u64(writer, "measure_batches",
+                                config->measure_batches) &&
+      vkr_harness_json_emit_u64(writer, "repetitions", config->repetitions) &&
+      vkr_harness_json_emit_u64(writer, "batch_target_ns",
+                                config->batch_target_ns) &&
+      vkr_harness_json_emit_i64(writer, "pin_core", config->pin_core) &&
+      vkr_harness_json_emit_bool(writer, "pinned", report->pinned) &&
+      vkr_harness_json_emit_string(writer, "cycle_counter",
+                                   VKR_BENCH_CYCLE_COUNTER) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "runs") &&
+      vkr_json_writer_begin_array(writer);
+  for (uint32_t r = 0; ok && r < config->repetitions; ++r) {
+    char samples[64];
+    string_format(samples, sizeof(samples), "runs/%u/samples.bin", r);
+    ok = vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_u64(writer, "index", r) &&
+         vkr_harness_json_emit_string(writer, "samples", samples) &&
+         vkr_harness_json_emit_string(writer, "sha256",
+                                      report->sample_digests[r]) &&
+         vkr_json_writer_end_object(writer);
+  }
+  ok = ok && vkr_json_writer_end_array(writer) &&
+       vkr_harness_json_emit_name(writer, "benchmarks") &&
+       vkr_json_writer_begin_array(writer);
+  const VkrBenchSelection *selection = report->selection;
+  for (uint32_t i = 0; ok && i < selection->count; ++i) {
+    const VkrHarnessMetricResult *metrics =
+        &report->results[i * VKR_BENCH_METRICS_PER_CASE];
+    ok = vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_string(writer, "name",
+                                      selection->cases[i]->name) &&
+         vkr_harness_json_emit_u64(writer, "ops_per_iteration",
+                                   selection->cases[i]->ops_per_iteration) &&
+         vkr_harness_json_emit_u64(writer, "iterations_per_batch",
+                                   selection->iterations[i]) &&
+         vkr_harness_json_emit_name(writer, "metrics") &&
+         vkr_json_writer_begin_array(writer);
+    for (uint32_t m = 0; ok && m < VKR_BENCH_METRICS_PER_CASE; ++m) {
+      ok = vkr_bench_emit_statistics(writer, &metrics[m]);
+    }
+    ok = ok && vkr_json_writer_end_array(writer) &&
+         vkr_json_writer_end_object(writer);
+  }
+  ok = ok && vkr_json_writer_end_array(writer) &&
+       vkr_json_writer_end_object(writer);
+  if (!ok || !vkr_json_file_writer_commit(&file_writer)) {
+    vkr_json_file_writer_abort(&file_writer);
+    vkr_harness_error_set(error, "report.write", "$",
+                          "Unable to write report '%s'", path);
+    return false_v;
+  }
+  return true_v;
+}
+
+/**
+ * Concatenates the measured batches of every repetition so the report's
+ * statistics describe the same population `compare` would judge.
+ */
+static void vkr_bench_gather_measured(const VkrBenchConfig *config,
+                                      uint32_t metric_count,
+                                      const float64_t *values,
+                                      const uint8_t *availability,
+                                      float64_t *out_values,
+                                      uint8_t *out_availability) {
+  const uint64_t row = metric_count;
+  const uint64_t repetition_rows =
+      (uint64_t)config->warmup_batches + config->measure_batches;
+  for (uint32_t r = 0; r < config->repetitions; ++r) {
+    const uint64_t source =
+        (r * repetition_rows + config->warmup_batches) * row;
+    const uint64_t target = (uint64_t)r * config->measure_batches * row;
+    const uint64_t count = (uint64_t)config->measure_batches * row;
+    MemCopy(out_values + target, values + source, count * sizeof(*values));
+    MemCopy(out_availability + target, availability + source, count);
+  }
+}
+
+int vkr_bench_run(const VkrBenchRegistry *registry,
+                  const VkrBenchConfig *config, const char *executable,
+                  const char *repo_root) {
+  if (!registry || !config || !executable || !repo_root ||
+      config->measure_batches == 0u || config->repetitions == 0u ||
+      config->repetitions > VKR_HARNESS_MAX_RUNS) {
+    return VKR_HARNESS_EXIT_INVALID;
+  }
+  VkrBenchSelection selection = {0};
+  vkr_bench_select(registry, config->filter, &selection);
+  if (selection.count == 0u) {
+    vkr_harness_stderr("bench.filter: no benchmark matches '%s'\n",
+                       config->filter ? config->filter : "");
+    return VKR_HARNESS_EXIT_INVALID;
+  }
+  Arena *arena = arena_create();
+  Arena *transient = arena_create();
+  Arena *case_arena = arena_create();
+  VkrHarnessError error = {0};
+  VkrJobSystem jobs = {0};
+  bool8_t jobs_ready = false_v;
+  int result = VKR_HARNESS_EXIT_ERROR;
+  if (!arena || !transient || !case_arena) {
+    goto cleanup;
+  }
+  const VkrHarnessArenas arenas = {.persistent = arena, .transient = transient};
+  VkrBenchReport *report =
+      arena_alloc(arena, sizeof(*report), ARENA_MEMORY_TAG_STRUCT);
+  if (!report) {
+    goto cleanup;
+  }
+  MemZero(report, sizeof(*report));
+  report->config = config;
+  report->selection = &selection;
+  (void)vkr_harness_timestamp_utc(report->started_at);
+  vkr_harness_provenance_collect(executable, repo_root, &report->provenance);
+  /* Only the measuring thread is pinned. Job workers stay wherever the OS puts
+     them, as they do in the renderer, so the job cases measure that. */
+  report->pinned = config->pin_core >= 0 &&
+                   vkr_thread_pin_current((uint32_t)config->pin_core);
+  if (config->pin_core >= 0 && !report->pinned) {
+    vkr_harness_stderr("bench.pin: core %d could not be pinned; timings are "
+                       "unpinned\n",
+                       config->pin_core);
+  }
+  VkrJobSystemConfig job_config = vkr_job_system_config_default();
+  jobs_ready =
+      job_config.worker_count > 0u && vkr_job_system_init(&job_config, &jobs);
+  VkrBenchContext context = {
+      .arena = case_arena,
+      .job_system = jobs_ready ? &jobs : NULL,
+  };
+  if (!vkr_bench_fingerprints(&selection, config, &report->provenance,
+                              transient, &report->identity, &error)) {
+    goto cleanup;
+  }
+
+  const uint32_t metric_count = selection.count * VKR_BENCH_METRICS_PER_CASE;
+  const uint64_t repetition_values =
+      ((uint64_t)config->warmup_batches + config->measure_batches) *
+      metric_count;
+  const uint64_t measured_values =
+      (uint64_t)config->measure_batches * config->repetitions * metric_count;
+  VkrHarnessSampleMetric *catalog = arena_alloc(
+      arena, sizeof(*catalog) * metric_count, ARENA_MEMORY_TAG_ARRAY);
+  float64_t *values = arena_alloc(
+      arena, sizeof(*values) * repetition_values * config->repetitions,
+      ARENA_MEMORY_TAG_ARRAY);
+  uint8_t *availability = arena_alloc(
+      arena, repetition_values * config->repetitions, ARENA_MEMORY_TAG_ARRAY);
+  float64_t *measured = arena_alloc(arena, sizeof(*measured) * measured_values,
+                                    ARENA_MEMORY_TAG_ARRAY);
+  uint8_t *measured_availability =
+      arena_alloc(arena, measured_values, ARENA_MEMORY_TAG_ARRAY);
+  report->sample_digests =
+      arena_alloc(arena, sizeof(*report->sample_digests) * config->repetitions,
+                  ARENA_MEMORY_TAG_ARRAY);
+  if (!catalog || !values || !availability || !measured ||
+      !measured_availability || !report->sample_digests) {
+    goto cleanup;
+  }
+  MemZero(catalog, sizeof(*catalog) * metric_count);
+  vkr_bench_catalog(&selection, catalog);
+
+  for (uint32_t i = 0; i < selection.count; ++i) {
+    const VkrBenchCase *bench = selection.cases[i];
+    if (!vkr_bench_case_begin(bench, &context)) {
+      vkr_harness_error_set(&error, "bench.setup", bench->name,
+                            "Setup failed for '%s'", bench->name);
+      goto cleanup;
+    }
+    selection.iterations[i] =
+        vkr_bench_calibrate(bench, &context, config->batch_target_ns);
+    vkr_bench_case_end(bench, &context);
+  }
+
+  char artifact_candidate[VKR_HARNESS_PATH_MAX];
+  char artifact_root[VKR_HARNESS_PATH_MAX];
+  char run_root[VKR_HARNESS_PATH_MAX];
+  string_format(artifact_candidate, sizeof(artifact_candidate), "%s/%s",
+                repo_root, VKR_HARNESS_ARTIFACT_ROOT);
+  if (!vkr_harness_make_directories(artifact_candidate, &error) ||
+      !vkr_harness_realpath(artifact_candidate, artifact_root) ||
+      !vkr_harness_create_run_root(artifact_root, report->run_id, run_root)) {
+    goto cleanup;
+  }
+  for (uint32_t r = 0; r < config->repetitions; ++r) {
+    float64_t *repetition = values + (uint64_t)r * repetition_values;
+    uint8_t *repetition_availability =
+        availability + (uint64_t)r * repetition_values;
+    if (!vkr_bench_measure(&selection, config, &context, repetition,
+                           repetition_availability, &error) ||
+        !vkr_bench_samples_publish(run_root, r, config, metric_count, catalog,
+                                   repetition, repetition_availability,
+                                   transient, report->sample_digests[r],
+                                   &error)) {
+      goto cleanup;
+    }
+  }
+  vkr_bench_gather_measured(config, metric_count, values, availability,
+                            measured, measured_availability);
+  VkrHarnessMetricResult *results = NULL;
+  if (!vkr_harness_compute_metric_results(
+          &arenas, 0u, config->measure_batches * config->repetitions,
+          metric_count, catalog, measured, measured_availability, &results,
+          &error)) {
+    goto cleanup;
+  }
+  report->results = results;
+  (void)vkr_harness_timestamp_utc(report->ended_at);
+
+  char report_path[VKR_HARNESS_PATH_MAX];
+  char digest[VKR_HARNESS_DIGEST_MAX];
+  string_format(report_path, sizeof(report_path), "%s/report.json", run_root);
+  if (!vkr_bench_report_write(report_path, report, &error) ||
+      !vkr_harness_sha256_file(report_path, digest)) {
+    goto cleanup;
+  }
+  for (uint32_t i = 0; i < selection.count; ++i) {
+    const VkrHarnessMetricResult *metrics =
+        &results[i * VKR_BENCH_METRICS_PER_CASE];
+    vkr_harness_stderr("%-40s %12.2f ns/op %12.2f cycles/op\n",
+                       selection.cases[i]->name, metrics[0].statistics.p50,
+                       metrics[1].statistics.p50);
+  }
+  vkr_harness_stdout("{\"status\":\"pass\",\"exit_code\":%u,\"report\":"
+                     "\"%s/%s/report.json\",\"sha256\":\"%s\"}\n",
+                     VKR_HARNESS_EXIT_PASS, VKR_HARNESS_ARTIFACT_ROOT,
+                     report->run_id, digest);
+  result = VKR_HARNESS_EXIT_PASS;
+cleanup:
+  if (result != VKR_HARNESS_EXIT_PASS && error.message[0]) {
+    vkr_harness_stderr("%s: %s\n", error.code, error.message);
+  }
+  if (jobs_ready) {
+    vkr_job_system_shutdown(&jobs);
+  }
+  arena_destroy(case_arena);
+  arena_destroy(transient);
+  arena_destroy(arena);
+  return result;
+}
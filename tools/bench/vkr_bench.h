@@ -0,0 +1,107 @@
+/**
+ * @file vkr_bench.h
+ * @brief In-tree microbenchmark framework behind `vkr_bench`.
+ *
+ * Every case is calibrated once to an iteration count whose batch lasts about
+ * `batch_target_ns`, then timed for `warmup_batches + measure_batches` batches
+ * at that fixed count on one pinned thread. Each batch becomes one "frame" of a
+ * harness sample file, so `vkr_harness compare --run <run> --baseline-run
+ * <run>` judges two benchmark runs with the same statistics it applies to
+ * profile runs.
+ */
+#pragma once
+
+#include "vkr_harness_runtime.h"
+
+#define VKR_BENCH_MAX_CASES 64u
+
+/** Per-case state a setup function allocates and its run function mutates. */
+typedef struct VkrBenchContext {
+  /** Lives until the case's teardown; reset between cases. */
+  Arena *arena;
+  /** Optional shared worker pool; NULL when none could be started. */
+  VkrJobSystem *job_system;
+  void *state;
+} VkrBenchContext;
+
+typedef bool8_t (*VkrBenchSetupFn)(VkrBenchContext *context);
+/**
+ * Performs `iterations` units of work. The framework times the whole call, so
+ * per-iteration bookkeeping belongs in setup rather than here.
+ */
+typedef void (*VkrBenchRunFn)(VkrBenchContext *context, uint64_t iterations);
+typedef void (*VkrBenchTeardownFn)(VkrBenchContext *context);
+
+typedef struct VkrBenchCase {
+  /** `<module>.<operation>`; becomes metric `bench.<name>.ns_per_op`. */
+  const char *name;
+  /**
+   * Operations one iteration performs, so a case that inserts 1024 keys per
+   * iteration still reports per insert. Part of the workload fingerprint.
+   */
+  uint64_t ops_per_iteration;
+  VkrBenchSetupFn setup;
+  VkrBenchRunFn run;
+  /** Optional; arena memory is released regardless. */
+  VkrBenchTeardownFn teardown;
+} VkrBenchCase;
+
+typedef struct VkrBenchRegistry {
+  VkrBenchCase cases[VKR_BENCH_MAX_CASES];
+  uint32_t case_count;
+} VkrBenchRegistry;
+
+typedef struct VkrBenchConfig {
+  uint32_t warmup_batches;
+  uint32_t measure_batches;
+  uint32_t repetitions;
+  uint64_t batch_target_ns;
+  /** Logical core the measuring thread is pinned to; negative disables. */
+  int32_t pin_core;
+  /** Substring every selected case name must contain; NULL selects all. */
+  const char *filter;
+} VkrBenchConfig;
+
+VkrBenchConfig vkr_bench_config_default(void);
+
+/** Fails once VKR_BENCH_MAX_CASES cases are registered. */
+bool8_t vkr_bench_register(VkrBenchRegistry *registry, VkrBenchCase bench);
+
+void vkr_bench_register_containers(VkrBenchRegistry *registry);
+void vkr_bench_register_memory(VkrBenchRegistry *registry);
+void vkr_bench_register_math(VkrBenchRegistry *registry);
+void vkr_bench_register_jobs(VkrBenchRegistry *registry);
+void vkr_bench_register_world(VkrBenchRegistry *registry);
+void vkr_bench_register_texture(VkrBenchRegistry *registry);
+void vkr_bench_register_bvh(VkrBenchRegistry *registry);
+void vkr_bench_register_event(VkrBenchRegistry *registry);
+void vkr_bench_register_log(VkrBenchRegistry *registry);
+void vkr_bench_register_image(VkrBenchRegistry *registry);
+
+/**
+ * Monotonic tick counter read with no serialization: the TSC on x86-64, the
+ * virtual counter on AArch64, and 0 where neither is available.
+ */
+uint64_t vkr_bench_cycles(void);
+/** False when `vkr_bench_cycles()` always returns 0 on this target. */
+bool8_t vkr_bench_cycles_available(void);
+
+/** Keeps `value` observable so the work producing it cannot be elided. */
+void vkr_bench_consume(uint64_t value);
+
+/**
+ * Smallest power-of-two iteration count whose batch lasts at least
+ * `batch_target_ns`, capped so a pathologically cheap case still terminates.
+ */
+uint64_t vkr_bench_calibrate(const VkrBenchCase *bench,
+                             VkrBenchContext *context,
+                             uint64_t batch_target_ns);
+
+/**
+ * Runs every selected case and publishes `report.json` plus one
+ * `runs/<n>/samples.bin` per repetition as a new run under
+ * VKR_HARNESS_ARTIFACT_ROOT, the only root `compare` accepts runs from.
+ */
+int vkr_bench_run(const VkrBenchRegistry *registry,
+                  const VkrBenchConfig *config, const char *executable,
+                  const char *repo_root);
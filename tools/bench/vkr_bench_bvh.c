@@ -0,0 +1,207 @@
+/**
+ * @file vkr_bench_bvh.c
+ * @brief Picking ray queries, one case per acceleration level.
+ *
+ * A Bistro-scale synthetic scene: thousands of instance spheres in the
+ * top-level mesh bounds index, and a 256x256-cell triangle BVH standing in for
+ * the mesh under the cursor. Rays are generated in setup, so ns/op is per ray.
+ */
+#include "math/vkr_triangle_bvh.h"
+#include "memory/vkr_arena_allocator.h"
+#include "renderer/systems/vkr_mesh_bounds_index.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_BVH_CELLS 256u
+#define VKR_BENCH_BVH_ROW (VKR_BENCH_BVH_CELLS + 1u)
+#define VKR_BENCH_BVH_INSTANCES 4096u
+#define VKR_BENCH_BVH_RAYS 1024u
+
+typedef struct VkrBenchBvhState {
+  VkrAllocator allocator;
+  VkrMeshBoundsIndex index;
+  VkrTriangleBvh mesh;
+  VkrRay instance_rays[VKR_BENCH_BVH_RAYS];
+  VkrRay mesh_rays[VKR_BENCH_BVH_RAYS];
+} VkrBenchBvhState;
+
+static float32_t vkr_bench_bvh_random(uint32_t *state) {
+  *state = *state * 1664525u + 1013904223u;
+  return (float32_t)(*state >> 8) / (float32_t)(1u << 24);
+}
+
+static bool8_t vkr_bench_bvh_ray_sphere(uint32_t key, const VkrRay *ray,
+                                        float32_t max_t, float32_t *out_t,
+                                        void *user_data) {
+  const VkrMeshBoundsIndex *index = user_data;
+  const Vec4 sphere = index->spheres[key];
+  const Vec3 offset =
+      vec3_sub(ray->origin, vec3_new(sphere.x, sphere.y, sphere.z));
+  const float32_t b = vec3_dot(offset, ray->direction);
+  const float32_t c = vec3_dot(offset, offset) - sphere.w * sphere.w;
+  const float32_t discriminant = b * b - c;
+  if (discriminant < 0.0f) {
+    return false_v;
+  }
+  const float32_t t = -b - vkr_sqrt_f32(discriminant);
+  if (t < 0.0f || t >= max_t) {
+    return false_v;
+  }
+  *out_t = t;
+  return true_v;
+}
+
+/** Jittered height field, two triangles per cell. */
+static bool8_t vkr_bench_bvh_build_mesh(VkrBenchBvhState *state) {
+  const uint32_t vertex_count = VKR_BENCH_BVH_ROW * VKR_BENCH_BVH_ROW;
+  const uint32_t index_count = VKR_BENCH_BVH_CELLS * VKR_BENCH_BVH_CELLS * 6u;
+  Vec3 *vertices =
+      vkr_allocator_alloc(&state->allocator, sizeof(Vec3) * vertex_count,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  uint32_t *indices =
+      vkr_allocator_alloc(&state->allocator, sizeof(uint32_t) * index_count,
+                          VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (!vertices || !indices) {
+    return false_v;
+  }
+
+  uint32_t seed = 5u;
+  for (uint32_t z = 0; z < VKR_BENCH_BVH_ROW; ++z) {
+    for (uint32_t x = 0; x < VKR_BENCH_BVH_ROW; ++x) {
+      vertices[z * VKR_BENCH_BVH_ROW + x] =
+          vec3_new((float32_t)x * 0.5f, vkr_bench_bvh_random(&seed) * 0.5f,
+                   (float32_t)z * 0.5f);
+    }
+  }
+  uint32_t cursor = 0;
+  for (uint32_t z = 0; z < VKR_BENCH_BVH_CELLS; ++z) {
+    for (uint32_t x = 0; x < VKR_BENCH_BVH_CELLS; ++x) {
+      const uint32_t v = z * VKR_BENCH_BVH_ROW + x;
+      indices[cursor++] = v;
+      indices[cursor++] = v + VKR_BENCH_BVH_ROW;
+      indices[cursor++] = v + 1u;
+      indices[cursor++] = v + 1u;
+      indices[cursor++] = v + VKR_BENCH_BVH_ROW;
+      indices[cursor++] = v + VKR_BENCH_BVH_ROW + 1u;
+    }
+  }
+
+  const VkrTriangleMeshSource source = {
+      .positions = vertices,
+      .position_stride = sizeof(Vec3),
+      .vertex_count = vertex_count,
+      .indices = indices,
+      .index_size = sizeof(uint32_t),
+      .index_count = index_count,
+  };
+  return vkr_triangle_bvh_create(&state->allocator, &source, 1u, &state->mesh);
+}
+
+static bool8_t vkr_bench_bvh_setup(VkrBenchContext *context) {
+  VkrBenchBvhState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  state->allocator.ctx = context->arena;
+  if (!vkr_allocator_arena(&state->allocator) ||
+      !vkr_bench_bvh_build_mesh(state)) {
+    return false_v;
+  }
+  if (!vkr_mesh_bounds_index_init(&state->index, &state->allocator,
+                                  VKR_BENCH_BVH_INSTANCES, 0u)) {
+    vkr_triangle_bvh_destroy(&state->mesh);
+    return false_v;
+  }
+
+  uint32_t seed = 17u;
+  for (uint32_t slot = 0; slot < VKR_BENCH_BVH_INSTANCES; ++slot) {
+    vkr_mesh_bounds_index_set(
+        &state->index, slot,
+        vec3_new(vkr_bench_bvh_random(&seed) * 400.0f - 200.0f,
+                 vkr_bench_bvh_random(&seed) * 30.0f,
+                 vkr_bench_bvh_random(&seed) * 400.0f - 200.0f),
+        0.5f + vkr_bench_bvh_random(&seed) * 4.0f);
+  }
+  vkr_mesh_bounds_index_commit(&state->index);
+
+  const float32_t extent = (float32_t)VKR_BENCH_BVH_CELLS * 0.5f;
+  for (uint32_t i = 0; i < VKR_BENCH_BVH_RAYS; ++i) {
+    const Vec3 origin =
+        vec3_new(vkr_bench_bvh_random(&seed) * 240.0f - 120.0f,
+                 40.0f + vkr_bench_bvh_random(&seed) * 20.0f,
+                 vkr_bench_bvh_random(&seed) * 240.0f - 120.0f);
+    const Vec3 target =
+        vec3_new(vkr_bench_bvh_random(&seed) * 200.0f - 100.0f,
+                 vkr_bench_bvh_random(&seed) * 20.0f,
+                 vkr_bench_bvh_random(&seed) * 200.0f - 100.0f);
+    state->instance_rays[i] = (VkrRay){
+        .origin = origin,
+        .direction = vec3_normalize(vec3_sub(target, origin)),
+    };
+    state->mesh_rays[i] = (VkrRay){
+        .origin = vec3_new(vkr_bench_bvh_random(&seed) * extent, 10.0f,
+                           vkr_bench_bvh_random(&seed) * extent),
+        .direction = vec3_new(vkr_bench_bvh_random(&seed) - 0.5f, -1.0f,
+                              vkr_bench_bvh_random(&seed) - 0.5f),
+    };
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_bvh_teardown(VkrBenchContext *context) {
+  VkrBenchBvhState *state = context->state;
+  if (!state) {
+    return;
+  }
+  vkr_mesh_bounds_index_shutdown(&state->index);
+  vkr_triangle_bvh_destroy(&state->mesh);
+}
+
+/** Nearest instance sphere along each ray through the top-level index. */
+static void vkr_bench_bvh_pick_instances(VkrBenchContext *context,
+                                         uint64_t iterations) {
+  VkrBenchBvhState *state = context->state;
+  uint64_t hits = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_BVH_RAYS; ++i) {
+      VkrBvhRayHit hit = {0};
+      hits += vkr_mesh_bounds_index_query_ray(
+          &state->index, &state->instance_rays[i], 1000.0f,
+          vkr_bench_bvh_ray_sphere, &state->index, &hit);
+    }
+  }
+  vkr_bench_consume(hits);
+}
+
+/** Closest triangle along each ray through the mesh BVH. */
+static void vkr_bench_bvh_pick_triangles(VkrBenchContext *context,
+                                         uint64_t iterations) {
+  VkrBenchBvhState *state = context->state;
+  uint64_t hits = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_BVH_RAYS; ++i) {
+      hits += vkr_triangle_bvh_raycast(&state->mesh, &state->mesh_rays[i],
+                                       1000.0f, NULL, NULL);
+    }
+  }
+  vkr_bench_consume(hits);
+}
+
+void vkr_bench_register_bvh(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "bvh.pick_instances",
+                                   .ops_per_iteration = VKR_BENCH_BVH_RAYS,
+                                   .setup = vkr_bench_bvh_setup,
+                                   .run = vkr_bench_bvh_pick_instances,
+                                   .teardown = vkr_bench_bvh_teardown,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "bvh.pick_triangles",
+                                   .ops_per_iteration = VKR_BENCH_BVH_RAYS,
+                                   .setup = vkr_bench_bvh_setup,
+                                   .run = vkr_bench_bvh_pick_triangles,
+                                   .teardown = vkr_bench_bvh_teardown,
+                               });
+}
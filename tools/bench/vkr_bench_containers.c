@@ -0,0 +1,201 @@
+/**
+ * @file vkr_bench_containers.c
+ * @brief Hash table, sort, and JSON reader cases.
+ */
+#include "containers/vkr_hashtable.h"
+#include "core/vkr_json.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_HASH_KEYS 1024u
+#define VKR_BENCH_HASH_CAPACITY 2048u
+#define VKR_BENCH_SORT_RECORDS 16384u
+#define VKR_BENCH_JSON_OBJECTS 256u
+
+typedef struct VkrBenchHashState {
+  VkrAllocator allocator;
+  VkrHashTable_uint32_t table;
+  const char *keys[VKR_BENCH_HASH_KEYS];
+} VkrBenchHashState;
+
+typedef struct VkrBenchSortState {
+  uint64_t source[VKR_BENCH_SORT_RECORDS];
+  uint64_t records[VKR_BENCH_SORT_RECORDS];
+} VkrBenchSortState;
+
+typedef struct VkrBenchJsonState {
+  String8 document;
+} VkrBenchJsonState;
+
+/** SplitMix64; a fixed sequence keeps every run sorting the same input. */
+static uint64_t vkr_bench_next_random(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+/**
+ * Capacity is fixed at twice the key count, below the load factor, so neither
+ * case ever resizes and both measure probing rather than rehashing.
+ */
+static bool8_t vkr_bench_hash_setup(VkrBenchContext *context) {
+  VkrBenchHashState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  state->allocator = (VkrAllocator){.ctx = context->arena};
+  if (!vkr_allocator_arena(&state->allocator)) {
+    return false_v;
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_HASH_KEYS; ++i) {
+    char *key = arena_alloc(context->arena, 24u, ARENA_MEMORY_TAG_STRING);
+    if (!key) {
+      return false_v;
+    }
+    string_format(key, 24u, "resource/%05u", i * 7919u);
+    state->keys[i] = key;
+  }
+  state->table = vkr_hash_table_create_uint32_t(&state->allocator,
+                                                VKR_BENCH_HASH_CAPACITY);
+  for (uint32_t i = 0; i < VKR_BENCH_HASH_KEYS; ++i) {
+    if (!vkr_hash_table_insert_uint32_t(&state->table, state->keys[i], i)) {
+      return false_v;
+    }
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_hash_insert(VkrBenchContext *context,
+                                  uint64_t iterations) {
+  VkrBenchHashState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_hash_table_reset_uint32_t(&state->table);
+    for (uint32_t i = 0; i < VKR_BENCH_HASH_KEYS; ++i) {
+      vkr_hash_table_insert_uint32_t(&state->table, state->keys[i], i);
+    }
+  }
+  vkr_bench_consume(state->table.size);
+}
+
+static void vkr_bench_hash_get(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchHashState *state = context->state;
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_HASH_KEYS; ++i) {
+      const uint32_t *value =
+          vkr_hash_table_get_uint32_t(&state->table, state->keys[i]);
+      sum += value ? *value : 0u;
+    }
+  }
+  vkr_bench_consume(sum);
+}
+
+static bool8_t vkr_bench_sort_setup(VkrBenchContext *context) {
+  VkrBenchSortState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_ARRAY);
+  if (!state) {
+    return false_v;
+  }
+  uint64_t seed = 0x5eedu;
+  for (uint32_t i = 0; i < VKR_BENCH_SORT_RECORDS; ++i) {
+    state->source[i] = vkr_bench_next_random(&seed);
+  }
+  context->state = state;
+  return true_v;
+}
+
+static int32_t vkr_bench_sort_compare(const void *lhs, const void *rhs) {
+  const uint64_t a = *(const uint64_t *)lhs;
+  const uint64_t b = *(const uint64_t *)rhs;
+  return (a > b) - (a < b);
+}
+
+/** The copy back to unsorted input is part of every iteration's cost. */
+static void vkr_bench_sort_run(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchSortState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    MemCopy(state->records, state->source, sizeof(state->records));
+    vkr_sort(state->records, VKR_BENCH_SORT_RECORDS, sizeof(uint64_t),
+             vkr_bench_sort_compare);
+  }
+  vkr_bench_consume(state->records[VKR_BENCH_SORT_RECORDS / 2u]);
+}
+
+/** A scene-shaped array of flat objects, the reader's common workload. */
+static bool8_t vkr_bench_json_setup(VkrBenchContext *context) {
+  const uint64_t capacity = (uint64_t)VKR_BENCH_JSON_OBJECTS * 128u + 64u;
+  VkrBenchJsonState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  char *text = arena_alloc(context->arena, capacity, ARENA_MEMORY_TAG_STRING);
+  if (!state || !text) {
+    return false_v;
+  }
+  uint64_t length =
+      (uint64_t)string_format(text, capacity, "{\"version\":1,\"items\":[");
+  for (uint32_t i = 0; i < VKR_BENCH_JSON_OBJECTS; ++i) {
+    length += (uint64_t)string_format(
+        text + length, capacity - length,
+        "%s{\"id\":%u,\"name\":\"mesh_%u\",\"x\":%.3f,\"y\":%.3f,"
+        "\"visible\":true}",
+        i == 0u ? "" : ",", i, i, (float64_t)i * 0.5, (float64_t)i * -0.25);
+  }
+  length += (uint64_t)string_format(text + length, capacity - length, "]}");
+  state->document = string8_create_from_cstr((const uint8_t *)text, length);
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_json_run(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchJsonState *state = context->state;
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrJsonReader reader = vkr_json_reader_from_string(state->document);
+    if (!vkr_json_find_array(&reader, "items")) {
+      continue;
+    }
+    while (vkr_json_next_array_element(&reader)) {
+      VkrJsonReader object = {0};
+      if (!vkr_json_enter_object(&reader, &object)) {
+        break;
+      }
+      int32_t id = 0;
+      float32_t x = 0.0f;
+      String8 name = {0};
+      (void)vkr_json_get_int(&object, "id", &id);
+      (void)vkr_json_get_float(&object, "x", &x);
+      (void)vkr_json_get_string(&object, "name", &name);
+      sum += (uint64_t)id + name.length + (x > 0.0f);
+    }
+  }
+  vkr_bench_consume(sum);
+}
+
+void vkr_bench_register_containers(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "hashtable.insert",
+                                   .ops_per_iteration = VKR_BENCH_HASH_KEYS,
+                                   .setup = vkr_bench_hash_setup,
+                                   .run = vkr_bench_hash_insert,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "hashtable.get_hit",
+                                   .ops_per_iteration = VKR_BENCH_HASH_KEYS,
+                                   .setup = vkr_bench_hash_setup,
+                                   .run = vkr_bench_hash_get,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "sort.u64_16k",
+                                   .ops_per_iteration = VKR_BENCH_SORT_RECORDS,
+                                   .setup = vkr_bench_sort_setup,
+                                   .run = vkr_bench_sort_run,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "json.reader_objects",
+                                   .ops_per_iteration = VKR_BENCH_JSON_OBJECTS,
+                                   .setup = vkr_bench_json_setup,
+                                   .run = vkr_bench_json_run,
+                               });
+}
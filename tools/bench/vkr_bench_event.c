@@ -0,0 +1,305 @@
+/**
+ * @file vkr_bench_event.c
+ * @brief Event dispatch through the lock-free ring against a mutex baseline.
+ *
+ * `locked` reproduces the previous dispatch path so the two can be compared
+ * in one run: every dispatch takes a mutex, copies the payload into a shared
+ * data buffer and signals a condition variable, and the worker takes the
+ * mutex again per event and copies payload and callback list into scratch
+ * before calling out. One op is one event delivered to its callback.
+ */
+#include "containers/queue.h"
+#include "core/event.h"
+#include "memory/vkr_arena_allocator.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_EVENT_PRODUCERS 4u
+#define VKR_BENCH_EVENT_CAPACITY (1u << 17)
+
+Queue(Event);
+
+typedef struct VkrBenchLockedQueue {
+  Queue_Event queue;
+  VkrEventDataBuffer data;
+  VkrMutex mutex;
+  VkrCondVar cond;
+  VkrThread thread;
+  bool32_t running;
+  Vector_EventCallbackData callbacks;
+} VkrBenchLockedQueue;
+
+typedef struct VkrBenchEventState {
+  VkrAllocator allocator;
+  EventManager manager;
+  VkrBenchLockedQueue locked;
+  bool8_t use_ring;
+  VkrAtomicUint64 received;
+  uint64_t expected;
+} VkrBenchEventState;
+
+typedef struct VkrBenchEventPayload {
+  uint32_t producer;
+  uint32_t sequence;
+} VkrBenchEventPayload;
+
+typedef struct VkrBenchEventProducer {
+  VkrBenchEventState *state;
+  uint32_t producer;
+  uint64_t count;
+} VkrBenchEventProducer;
+
+static void *vkr_bench_locked_worker(void *arg) {
+  VkrBenchLockedQueue *locked = arg;
+  Arena *scratch_arena = arena_create(KB(64), KB(64));
+  VkrAllocator scratch = {.ctx = scratch_arena};
+  vkr_allocator_arena(&scratch);
+  for (;;) {
+    Event event;
+    vkr_mutex_lock(locked->mutex);
+    while (queue_is_empty_Event(&locked->queue) && locked->running) {
+      vkr_cond_wait(locked->cond, locked->mutex);
+    }
+    if (!queue_dequeue_Event(&locked->queue, &event)) {
+      vkr_mutex_unlock(locked->mutex);
+      break;
+    }
+
+    VkrAllocatorScope scope = vkr_allocator_begin_scope(&scratch);
+    void *payload = vkr_allocator_alloc(&scratch, event.data_size,
+                                        VKR_ALLOCATOR_MEMORY_TAG_STRUCT);
+    MemCopy(payload, event.data, event.data_size);
+    vkr_event_data_buffer_free(&locked->data, event.data_size);
+    event.data = payload;
+
+    const uint64_t count = locked->callbacks.length;
+    EventCallbackData *callbacks =
+        vkr_allocator_alloc(&scratch, count * sizeof(EventCallbackData),
+                            VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+    MemCopy(callbacks, locked->callbacks.data,
+            count * sizeof(EventCallbackData));
+    vkr_mutex_unlock(locked->mutex);
+
+    for (uint64_t i = 0; i < count; ++i) {
+      callbacks[i].callback(&event, callbacks[i].user_data);
+    }
+    vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_VECTOR);
+  }
+  arena_destroy(scratch_arena);
+  return NULL;
+}
+
+static bool32_t vkr_bench_locked_dispatch(VkrBenchLockedQueue *locked,
+                                          Event event) {
+  vkr_mutex_lock(locked->mutex);
+  void *copy = NULL;
+  if (queue_is_full_Event(&locked->queue) ||
+      !vkr_event_data_buffer_alloc(&locked->data, event.data_size, &copy)) {
+    vkr_mutex_unlock(locked->mutex);
+    return false_v;
+  }
+  MemCopy(copy, event.data, event.data_size);
+  event.data = copy;
+  queue_enqueue_Event(&locked->queue, event);
+  vkr_cond_signal(locked->cond);
+  vkr_mutex_unlock(locked->mutex);
+  return true_v;
+}
+
+static bool8_t vkr_bench_event_callback(Event *event, UserData user_data) {
+  (void)event;
+  VkrBenchEventState *state = user_data;
+  vkr_atomic_uint64_fetch_add(&state->received, 1u, VKR_MEMORY_ORDER_RELEASE);
+  return true_v;
+}
+
+static bool8_t vkr_bench_locked_create(VkrBenchEventState *state) {
+  VkrBenchLockedQueue *locked = &state->locked;
+  locked->queue =
+      queue_create_Event(&state->allocator, VKR_BENCH_EVENT_CAPACITY);
+  if (!vkr_event_data_buffer_create(&state->allocator,
+                                    DEFAULT_EVENT_DATA_RING_BUFFER_CAPACITY,
+                                    &locked->data) ||
+      !vkr_mutex_create(&state->allocator, &locked->mutex) ||
+      !vkr_cond_create(&state->allocator, &locked->cond)) {
+    return false_v;
+  }
+  locked->running = true_v;
+  locked->callbacks = vector_create_EventCallbackData(&state->allocator);
+  vector_push_EventCallbackData(
+      &locked->callbacks,
+      (EventCallbackData){vkr_bench_event_callback, state});
+  return vkr_thread_create(&state->allocator, &locked->thread,
+                           vkr_bench_locked_worker, locked);
+}
+
+static void vkr_bench_locked_destroy(VkrBenchEventState *state) {
+  VkrBenchLockedQueue *locked = &state->locked;
+  vkr_mutex_lock(locked->mutex);
+  locked->running = false_v;
+  vkr_cond_signal(locked->cond);
+  vkr_mutex_unlock(locked->mutex);
+  vkr_thread_join(locked->thread);
+  vkr_thread_destroy(&state->allocator, &locked->thread);
+  vkr_mutex_destroy(&state->allocator, &locked->mutex);
+  vkr_cond_destroy(&state->allocator, &locked->cond);
+  vector_destroy_EventCallbackData(&locked->callbacks);
+  vkr_event_data_buffer_destroy(&locked->data);
+  queue_destroy_Event(&locked->queue);
+}
+
+static bool8_t vkr_bench_event_setup_mode(VkrBenchContext *context,
+                                          bool8_t use_ring) {
+  VkrBenchEventState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  state->allocator.ctx = context->arena;
+  if (!vkr_allocator_arena(&state->allocator)) {
+    return false_v;
+  }
+  state->use_ring = use_ring;
+  if (use_ring) {
+    EventManagerConfig config = event_manager_config_default();
+    config.queue_capacity = VKR_BENCH_EVENT_CAPACITY;
+    if (!event_manager_create_with_config(&state->manager, &config)) {
+      return false_v;
+    }
+    event_manager_subscribe(&state->manager, EVENT_TYPE_MOUSE_MOVE,
+                            vkr_bench_event_callback, state);
+  } else if (!vkr_bench_locked_create(state)) {
+    return false_v;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static bool8_t vkr_bench_event_setup_locked(VkrBenchContext *context) {
+  return vkr_bench_event_setup_mode(context, false_v);
+}
+
+static bool8_t vkr_bench_event_setup_ring(VkrBenchContext *context) {
+  return vkr_bench_event_setup_mode(context, true_v);
+}
+
+static void vkr_bench_event_teardown(VkrBenchContext *context) {
+  VkrBenchEventState *state = context->state;
+  if (!state) {
+    return;
+  }
+  if (state->use_ring) {
+    event_manager_destroy(&state->manager);
+  } else {
+    vkr_bench_locked_destroy(state);
+  }
+}
+
+static bool32_t vkr_bench_event_dispatch(VkrBenchEventState *state,
+                                         uint32_t producer, uint32_t sequence) {
+  VkrBenchEventPayload payload = {.producer = producer, .sequence = sequence};
+  Event event = {.type = EVENT_TYPE_MOUSE_MOVE,
+                 .data = &payload,
+                 .data_size = sizeof(payload)};
+  return state->use_ring ? event_manager_dispatch(&state->manager, event)
+                         : vkr_bench_locked_dispatch(&state->locked, event);
+}
+
+/** Retries on a full queue, so back-pressure shows up as time, not loss. */
+static void vkr_bench_event_dispatch_blocking(VkrBenchEventState *state,
+                                              uint32_t producer,
+                                              uint32_t sequence) {
+  while (!vkr_bench_event_dispatch(state, producer, sequence)) {
+    vkr_thread_sleep(0);
+  }
+}
+
+static void vkr_bench_event_wait_for(VkrBenchEventState *state) {
+  while (vkr_atomic_uint64_load(&state->received, VKR_MEMORY_ORDER_ACQUIRE) <
+         state->expected) {
+    vkr_thread_sleep(0);
+  }
+}
+
+static void *vkr_bench_event_producer(void *arg) {
+  const VkrBenchEventProducer *producer = arg;
+  for (uint64_t i = 0; i < producer->count; ++i) {
+    vkr_bench_event_dispatch_blocking(producer->state, producer->producer,
+                                      (uint32_t)i);
+  }
+  return NULL;
+}
+
+/**
+ * Producers flood the queue, each dispatching `iterations` events; the clock
+ * stops once the consumer has run the last callback.
+ */
+static void vkr_bench_event_throughput(VkrBenchContext *context,
+                                       uint64_t iterations) {
+  VkrBenchEventState *state = context->state;
+  VkrThread threads[VKR_BENCH_EVENT_PRODUCERS] = {0};
+  VkrBenchEventProducer producers[VKR_BENCH_EVENT_PRODUCERS] = {0};
+  for (uint32_t i = 0; i < VKR_BENCH_EVENT_PRODUCERS; ++i) {
+    producers[i] = (VkrBenchEventProducer){
+        .state = state, .producer = i, .count = iterations};
+    if (!vkr_thread_create(&state->allocator, &threads[i],
+                           vkr_bench_event_producer, &producers[i])) {
+      vkr_bench_event_producer(&producers[i]);
+      threads[i] = NULL;
+    }
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_EVENT_PRODUCERS; ++i) {
+    if (threads[i]) {
+      vkr_thread_join(threads[i]);
+      vkr_thread_destroy(&state->allocator, &threads[i]);
+    }
+  }
+  state->expected += iterations * VKR_BENCH_EVENT_PRODUCERS;
+  vkr_bench_event_wait_for(state);
+  vkr_bench_consume(state->expected);
+}
+
+/** One event at a time, waiting for its callback: dispatch-to-wake latency. */
+static void vkr_bench_event_round_trip(VkrBenchContext *context,
+                                       uint64_t iterations) {
+  VkrBenchEventState *state = context->state;
+  for (uint64_t i = 0; i < iterations; ++i) {
+    vkr_bench_event_dispatch_blocking(state, 0u, (uint32_t)i);
+    state->expected++;
+    vkr_bench_event_wait_for(state);
+  }
+  vkr_bench_consume(state->expected);
+}
+
+void vkr_bench_register_event(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry,
+                     (VkrBenchCase){
+                         .name = "event.throughput_locked",
+                         .ops_per_iteration = VKR_BENCH_EVENT_PRODUCERS,
+                         .setup = vkr_bench_event_setup_locked,
+                         .run = vkr_bench_event_throughput,
+                         .teardown = vkr_bench_event_teardown,
+                     });
+  vkr_bench_register(registry,
+                     (VkrBenchCase){
+                         .name = "event.throughput_ring",
+                         .ops_per_iteration = VKR_BENCH_EVENT_PRODUCERS,
+                         .setup = vkr_bench_event_setup_ring,
+                         .run = vkr_bench_event_throughput,
+                         .teardown = vkr_bench_event_teardown,
+                     });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "event.round_trip_locked",
+                                   .ops_per_iteration = 1u,
+                                   .setup = vkr_bench_event_setup_locked,
+                                   .run = vkr_bench_event_round_trip,
+                                   .teardown = vkr_bench_event_teardown,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "event.round_trip_ring",
+                                   .ops_per_iteration = 1u,
+                                   .setup = vkr_bench_event_setup_ring,
+                                   .run = vkr_bench_event_round_trip,
+                                   .teardown = vkr_bench_event_teardown,
+                               });
+}
@@ -0,0 +1,171 @@
+/**
+ * @file vkr_bench_image.c
+ * @brief Harness image comparison on a 4K RGBA8 capture.
+ *
+ * `scalar` is the per-pixel `vkr_harness_compare_rgba8()` loop the tiled
+ * comparison replaced; `tiled` runs the tiles on the calling thread, `jobs`
+ * spreads them over the shared worker pool, and `perceptual` adds PSNR, SSIM,
+ * MS-SSIM, FLIP and the heatmap on top. One op is one pixel compared.
+ */
+#include "vkr_bench.h"
+
+#define VKR_BENCH_IMAGE_WIDTH 3840u
+#define VKR_BENCH_IMAGE_HEIGHT 2160u
+#define VKR_BENCH_IMAGE_PIXELS                                                 \
+  ((uint64_t)VKR_BENCH_IMAGE_WIDTH * VKR_BENCH_IMAGE_HEIGHT)
+
+typedef struct VkrBenchImageState {
+  uint8_t *baseline;
+  uint8_t *actual;
+  uint8_t *heatmap;
+  VkrHarnessCompareConfig thresholds;
+  VkrHarnessImageCompareDesc desc;
+} VkrBenchImageState;
+
+/**
+ * A gradient with a checker and a little grain, then sparse noise on every
+ * 17th pixel of the copy, so every metric has structure and some pixels fail.
+ */
+static bool8_t vkr_bench_image_setup(VkrBenchContext *context) {
+  VkrBenchImageState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  uint32_t tiles_x = 0u, tiles_y = 0u;
+  vkr_harness_image_tiles(VKR_BENCH_IMAGE_WIDTH, VKR_BENCH_IMAGE_HEIGHT,
+                          &tiles_x, &tiles_y);
+  state->baseline = arena_alloc(context->arena, VKR_BENCH_IMAGE_PIXELS * 4u,
+                                ARENA_MEMORY_TAG_ARRAY);
+  state->actual = arena_alloc(context->arena, VKR_BENCH_IMAGE_PIXELS * 4u,
+                              ARENA_MEMORY_TAG_ARRAY);
+  state->heatmap = arena_alloc(context->arena, (uint64_t)tiles_x * tiles_y * 4u,
+                               ARENA_MEMORY_TAG_ARRAY);
+  if (!state->baseline || !state->actual || !state->heatmap) {
+    return false_v;
+  }
+
+  uint32_t seed = 3u;
+  for (uint32_t y = 0; y < VKR_BENCH_IMAGE_HEIGHT; ++y) {
+    for (uint32_t x = 0; x < VKR_BENCH_IMAGE_WIDTH; ++x) {
+      seed = seed * 1664525u + 1013904223u;
+      uint8_t *pixel =
+          state->baseline + ((uint64_t)y * VKR_BENCH_IMAGE_WIDTH + x) * 4u;
+      pixel[0] = (uint8_t)((x * 255u) / (VKR_BENCH_IMAGE_WIDTH - 1u));
+      pixel[1] = (uint8_t)((y * 255u) / (VKR_BENCH_IMAGE_HEIGHT - 1u));
+      pixel[2] = (uint8_t)(((x / 8u + y / 8u) % 2u) * 96u + (seed >> 28u));
+      pixel[3] = 255u;
+    }
+  }
+  MemCopy(state->actual, state->baseline, VKR_BENCH_IMAGE_PIXELS * 4u);
+  seed = 5u;
+  for (uint64_t pixel = 0; pixel < VKR_BENCH_IMAGE_PIXELS; pixel += 17u) {
+    for (uint32_t c = 0; c < 3u; ++c) {
+      seed = seed * 1664525u + 1013904223u;
+      const int32_t delta = (int32_t)(seed >> 16u) % 13 - 6;
+      const int32_t value = (int32_t)state->actual[pixel * 4u + c] + delta;
+      state->actual[pixel * 4u + c] = (uint8_t)Clamp(value, 0, 255);
+    }
+  }
+
+  state->thresholds = (VkrHarnessCompareConfig){
+      .max_pixel_delta = 0.02,
+      .max_mean_absolute_error = 0.01,
+      .max_failed_pixel_ratio = 0.01,
+  };
+  state->desc = (VkrHarnessImageCompareDesc){
+      .actual = state->actual,
+      .baseline = state->baseline,
+      .width = VKR_BENCH_IMAGE_WIDTH,
+      .height = VKR_BENCH_IMAGE_HEIGHT,
+      .config = &state->thresholds,
+  };
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_image_compare_scalar(VkrBenchContext *context,
+                                           uint64_t iterations) {
+  VkrBenchImageState *state = context->state;
+  uint64_t failing = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    failing += vkr_harness_compare_rgba8(state->actual, state->baseline,
+                                         VKR_BENCH_IMAGE_PIXELS,
+                                         &state->thresholds, NULL)
+                   .failing_pixel_count;
+  }
+  vkr_bench_consume(failing);
+}
+
+static void vkr_bench_image_compare_tiled(VkrBenchContext *context,
+                                          uint64_t iterations) {
+  VkrBenchImageState *state = context->state;
+  state->desc.job_system = NULL;
+  uint64_t failing = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    failing +=
+        vkr_harness_compare_image_rgba8(&state->desc, context->arena, NULL)
+            .failing_pixel_count;
+  }
+  vkr_bench_consume(failing);
+}
+
+/** Falls back to the calling thread when no worker pool could be started. */
+static void vkr_bench_image_compare_jobs(VkrBenchContext *context,
+                                         uint64_t iterations) {
+  VkrBenchImageState *state = context->state;
+  state->desc.job_system = context->job_system;
+  uint64_t failing = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    failing +=
+        vkr_harness_compare_image_rgba8(&state->desc, context->arena, NULL)
+            .failing_pixel_count;
+  }
+  vkr_bench_consume(failing);
+}
+
+static void vkr_bench_image_compare_perceptual(VkrBenchContext *context,
+                                               uint64_t iterations) {
+  VkrBenchImageState *state = context->state;
+  state->desc.job_system = context->job_system;
+  state->desc.heatmap_rgba = state->heatmap;
+  uint64_t failing = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrHarnessImageQuality quality = {0};
+    failing += vkr_harness_compare_image_rgba8(&state->desc, context->arena,
+                                               &quality)
+                   .failing_pixel_count;
+    failing += (uint64_t)(quality.ssim * 1000.0);
+  }
+  state->desc.heatmap_rgba = NULL;
+  vkr_bench_consume(failing);
+}
+
+void vkr_bench_register_image(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "image.compare_scalar",
+                                   .ops_per_iteration = VKR_BENCH_IMAGE_PIXELS,
+                                   .setup = vkr_bench_image_setup,
+                                   .run = vkr_bench_image_compare_scalar,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "image.compare_tiled",
+                                   .ops_per_iteration = VKR_BENCH_IMAGE_PIXELS,
+                                   .setup = vkr_bench_image_setup,
+                                   .run = vkr_bench_image_compare_tiled,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "image.compare_jobs",
+                                   .ops_per_iteration = VKR_BENCH_IMAGE_PIXELS,
+                                   .setup = vkr_bench_image_setup,
+                                   .run = vkr_bench_image_compare_jobs,
+                               });
+  vkr_bench_register(registry,
+                     (VkrBenchCase){
+                         .name = "image.compare_perceptual",
+                         .ops_per_iteration = VKR_BENCH_IMAGE_PIXELS,
+                         .setup = vkr_bench_image_setup,
+                         .run = vkr_bench_image_compare_perceptual,
+                     });
+}
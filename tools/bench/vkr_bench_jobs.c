@@ -0,0 +1,108 @@
+/**
+ * @file vkr_bench_jobs.c
+ * @brief Job system submission and fan-out cases.
+ */
+#include "vkr_bench.h"
+
+#define VKR_BENCH_FANOUT_JOBS 64u
+#define VKR_BENCH_FANOUT_WORK 256u
+
+typedef struct VkrBenchJobsState {
+  VkrJobSystem *jobs;
+  Bitset8 type_mask;
+  VkrJobHandle handles[VKR_BENCH_FANOUT_JOBS];
+  uint32_t work[VKR_BENCH_FANOUT_WORK];
+} VkrBenchJobsState;
+
+typedef struct VkrBenchJobPayload {
+  const uint32_t *work;
+  uint32_t count;
+} VkrBenchJobPayload;
+
+static bool8_t vkr_bench_job_run(VkrJobContext *context, void *payload) {
+  (void)context;
+  const VkrBenchJobPayload *job = payload;
+  uint64_t sum = 0u;
+  for (uint32_t i = 0; i < job->count; ++i) {
+    sum += job->work[i];
+  }
+  vkr_bench_consume(sum);
+  return true_v;
+}
+
+static bool8_t vkr_bench_jobs_setup(VkrBenchContext *context) {
+  if (!context->job_system) {
+    return false_v;
+  }
+  VkrBenchJobsState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  state->jobs = context->job_system;
+  state->type_mask = bitset8_create();
+  bitset8_set(&state->type_mask, VKR_JOB_TYPE_GENERAL);
+  for (uint32_t i = 0; i < VKR_BENCH_FANOUT_WORK; ++i) {
+    state->work[i] = i * 2654435761u;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static bool8_t vkr_bench_job_submit(VkrBenchJobsState *state, uint32_t count,
+                                    VkrJobHandle *out_handle) {
+  const VkrBenchJobPayload payload = {.work = state->work, .count = count};
+  const VkrJobDesc desc = {
+      .priority = VKR_JOB_PRIORITY_NORMAL,
+      .type_mask = state->type_mask,
+      .run = vkr_bench_job_run,
+      .payload = &payload,
+      .payload_size = sizeof(payload),
+  };
+  return vkr_job_submit(state->jobs, &desc, out_handle);
+}
+
+/** Round trip of one empty job: queue, wake, run, complete, observe. */
+static void vkr_bench_jobs_round_trip(VkrBenchContext *context,
+                                      uint64_t iterations) {
+  VkrBenchJobsState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrJobHandle handle = {0};
+    if (vkr_bench_job_submit(state, 0u, &handle)) {
+      (void)vkr_job_wait(state->jobs, handle);
+    }
+  }
+}
+
+static void vkr_bench_jobs_fanout(VkrBenchContext *context,
+                                  uint64_t iterations) {
+  VkrBenchJobsState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    bool8_t submitted[VKR_BENCH_FANOUT_JOBS];
+    for (uint32_t i = 0; i < VKR_BENCH_FANOUT_JOBS; ++i) {
+      submitted[i] = vkr_bench_job_submit(state, VKR_BENCH_FANOUT_WORK,
+                                          &state->handles[i]);
+    }
+    for (uint32_t i = 0; i < VKR_BENCH_FANOUT_JOBS; ++i) {
+      if (submitted[i]) {
+        (void)vkr_job_wait(state->jobs, state->handles[i]);
+      }
+    }
+  }
+}
+
+void vkr_bench_register_jobs(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "jobs.round_trip",
+                                   .ops_per_iteration = 1u,
+                                   .setup = vkr_bench_jobs_setup,
+                                   .run = vkr_bench_jobs_round_trip,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "jobs.fanout_64",
+                                   .ops_per_iteration = VKR_BENCH_FANOUT_JOBS,
+                                   .setup = vkr_bench_jobs_setup,
+                                   .run = vkr_bench_jobs_fanout,
+                               });
+}
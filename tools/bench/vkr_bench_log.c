@@ -0,0 +1,132 @@
+/**
+ * @file vkr_bench_log.c
+ * @brief Logger call cost with several threads logging at once.
+ *
+ * Lines go to a sink that discards them, so the cases measure the call itself:
+ * formatting plus the console lock in synchronous mode, and the ring enqueue
+ * in asynchronous mode. One op is one message from one thread.
+ */
+#include "core/logger.h"
+#include "core/vkr_threads.h"
+#include "memory/vkr_arena_allocator.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_LOG_THREADS 4u
+
+typedef struct VkrBenchLogState {
+  VkrAllocator allocator;
+  uint64_t lines;
+  bool8_t async;
+} VkrBenchLogState;
+
+typedef struct VkrBenchLogThread {
+  uint32_t thread_index;
+  uint64_t count;
+} VkrBenchLogThread;
+
+static void vkr_bench_log_null_sink(LogLevel level, const char *line,
+                                    uint64_t length, void *user_data) {
+  (void)level;
+  (void)line;
+  (void)length;
+  (*(uint64_t *)user_data)++;
+}
+
+/* Calls _log_message directly so the cases do not depend on LOG_LEVEL. */
+static void *vkr_bench_log_thread(void *arg) {
+  const VkrBenchLogThread *thread = arg;
+  for (uint64_t i = 0; i < thread->count; ++i) {
+    _log_message(LOG_LEVEL_INFO, __FILE__, __LINE__, "bench %u %llu %s",
+                 thread->thread_index, (unsigned long long)i, "payload");
+  }
+  return NULL;
+}
+
+static bool8_t vkr_bench_log_setup_mode(VkrBenchContext *context,
+                                        bool8_t async) {
+  VkrBenchLogState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  state->allocator.ctx = context->arena;
+  if (!vkr_allocator_arena(&state->allocator)) {
+    return false_v;
+  }
+  log_set_sink(vkr_bench_log_null_sink, &state->lines);
+  if (async) {
+    LogAsyncConfig config = log_async_config_default();
+    config.max_threads = VKR_BENCH_LOG_THREADS * 2u;
+    config.ring_size = (uint32_t)KB(256);
+    config.site_rate_limit = 0;
+    if (!log_async_start(&state->allocator, &config)) {
+      log_set_sink(NULL, NULL);
+      return false_v;
+    }
+    state->async = true_v;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static bool8_t vkr_bench_log_setup_sync(VkrBenchContext *context) {
+  return vkr_bench_log_setup_mode(context, false_v);
+}
+
+static bool8_t vkr_bench_log_setup_async(VkrBenchContext *context) {
+  return vkr_bench_log_setup_mode(context, true_v);
+}
+
+static void vkr_bench_log_teardown(VkrBenchContext *context) {
+  VkrBenchLogState *state = context->state;
+  if (!state) {
+    return;
+  }
+  if (state->async) {
+    log_async_stop();
+  }
+  log_set_sink(NULL, NULL);
+}
+
+/** Each thread logs `iterations` messages; thread start-up is included. */
+static void vkr_bench_log_contended(VkrBenchContext *context,
+                                    uint64_t iterations) {
+  VkrBenchLogState *state = context->state;
+  VkrThread threads[VKR_BENCH_LOG_THREADS] = {0};
+  VkrBenchLogThread payloads[VKR_BENCH_LOG_THREADS] = {0};
+  uint32_t started = 0;
+  for (uint32_t i = 0; i < VKR_BENCH_LOG_THREADS; ++i) {
+    payloads[i] = (VkrBenchLogThread){.thread_index = i, .count = iterations};
+    if (!vkr_thread_create(&state->allocator, &threads[i],
+                           vkr_bench_log_thread, &payloads[i])) {
+      break;
+    }
+    started++;
+  }
+  for (uint32_t i = 0; i < started; ++i) {
+    vkr_thread_join(threads[i]);
+    vkr_thread_destroy(&state->allocator, &threads[i]);
+  }
+  if (state->async) {
+    log_flush();
+  }
+  vkr_bench_consume(state->lines);
+}
+
+void vkr_bench_register_log(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "log.contended_sync",
+                                   .ops_per_iteration = VKR_BENCH_LOG_THREADS,
+                                   .setup = vkr_bench_log_setup_sync,
+                                   .run = vkr_bench_log_contended,
+                                   .teardown = vkr_bench_log_teardown,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "log.contended_async",
+                                   .ops_per_iteration = VKR_BENCH_LOG_THREADS,
+                                   .setup = vkr_bench_log_setup_async,
+                                   .run = vkr_bench_log_contended,
+                                   .teardown = vkr_bench_log_teardown,
+                               });
+}
@@ -0,0 +1,107 @@
+/**
+ * @file vkr_bench_main.c
+ * @brief Command-line entry point.
+ *
+ * `vkr_bench [--filter <substring>] [--repetitions <n>] [--warmup <n>]
+ * [--measure <n>] [--batch-us <n>] [--pin-core <n|none>] [--list]`
+ *
+ * Compare two published runs with
+ * `vkr_harness compare --run <run> --baseline-run <run>`.
+ */
+#include "vkr_bench.h"
+
+static const char *vkr_bench_option(int argc, char **argv, const char *name) {
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (string_equals(argv[i], name)) {
+      return argv[i + 1];
+    }
+  }
+  return NULL;
+}
+
+static bool8_t vkr_bench_flag(int argc, char **argv, const char *name) {
+  for (int i = 1; i < argc; ++i) {
+    if (string_equals(argv[i], name)) {
+      return true_v;
+    }
+  }
+  return false_v;
+}
+
+/** Leaves `*out_value` unchanged when the option is absent. */
+static bool8_t vkr_bench_option_u32(int argc, char **argv, const char *name,
+                                    uint32_t *out_value) {
+  const char *text = vkr_bench_option(argc, argv, name);
+  if (!text) {
+    return true_v;
+  }
+  int32_t value = 0;
+  if (!string_to_i32(text, &value) || value < 0) {
+    vkr_harness_stderr("%s expects a non-negative integer\n", name);
+    return false_v;
+  }
+  *out_value = (uint32_t)value;
+  return true_v;
+}
+
+int main(int argc, char **argv) {
+  VkrBenchRegistry registry = {0};
+  vkr_bench_register_containers(&registry);
+  vkr_bench_register_memory(&registry);
+  vkr_bench_register_math(&registry);
+  vkr_bench_register_jobs(&registry);
+  vkr_bench_register_world(&registry);
+  vkr_bench_register_texture(&registry);
+  vkr_bench_register_bvh(&registry);
+  vkr_bench_register_event(&registry);
+  vkr_bench_register_log(&registry);
+  vkr_bench_register_image(&registry);
+  if (vkr_bench_flag(argc, argv, "--list")) {
+    for (uint32_t i = 0; i < registry.case_count; ++i) {
+      vkr_harness_stdout("%s\n", registry.cases[i].name);
+    }
+    return VKR_HARNESS_EXIT_PASS;
+  }
+
+  VkrBenchConfig config = vkr_bench_config_default();
+  config.filter = vkr_bench_option(argc, argv, "--filter");
+  uint32_t batch_us = (uint32_t)(config.batch_target_ns / 1000u);
+  if (!vkr_bench_option_u32(argc, argv, "--repetitions",
+                            &config.repetitions) ||
+      !vkr_bench_option_u32(argc, argv, "--warmup", &config.warmup_batches) ||
+      !vkr_bench_option_u32(argc, argv, "--measure",
+                            &config.measure_batches) ||
+      !vkr_bench_option_u32(argc, argv, "--batch-us", &batch_us)) {
+    return VKR_HARNESS_EXIT_INVALID;
+  }
+  config.batch_target_ns = (uint64_t)batch_us * 1000u;
+  const char *pin = vkr_bench_option(argc, argv, "--pin-core");
+  if (pin && string_equals(pin, "none")) {
+    config.pin_core = -1;
+  } else if (pin && (!string_to_i32(pin, &config.pin_core) ||
+                     config.pin_core < 0)) {
+    vkr_harness_stderr("--pin-core expects a core index or 'none'\n");
+    return VKR_HARNESS_EXIT_INVALID;
+  }
+  const char *repo_root = vkr_bench_option(argc, argv, "--repo-root");
+  if (!repo_root) {
+    repo_root = PROJECT_SOURCE_DIR;
+  }
+  /* The executable digest is provenance, so argv[0] must be resolved. */
+  char executable[VKR_HARNESS_PATH_MAX];
+  if (!vkr_harness_realpath(argv[0], executable)) {
+    vkr_harness_stderr("Unable to resolve the bench executable path\n");
+    return VKR_HARNESS_EXIT_ERROR;
+  }
+  if (!vkr_platform_init()) {
+    vkr_harness_stderr("Unable to initialize the platform layer\n");
+    return VKR_HARNESS_EXIT_ERROR;
+  }
+  /* The library under measurement logs; the log arena outlives every case. */
+  Arena *log_arena = arena_create(MB(1), MB(1));
+  log_init(log_arena);
+  const int result = vkr_bench_run(&registry, &config, executable, repo_root);
+  vkr_platform_shutdown();
+  arena_destroy(log_arena);
+  return result;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file vkr_bench_math.c
+ * @brief Matrix and SIMD kernel cases.
+ */
+#include "math/mat.h"
+#include "math/vkr_simd.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_MATRICES 256u
+#define VKR_BENCH_VECTORS 1024u
+
+typedef struct VkrBenchMathState {
+  Mat4 a[VKR_BENCH_MATRICES];
+  Mat4 b[VKR_BENCH_MATRICES];
+  Mat4 out[VKR_BENCH_MATRICES];
+  Vec4 vectors[VKR_BENCH_VECTORS];
+  Vec4 transformed[VKR_BENCH_VECTORS];
+} VkrBenchMathState;
+
+static uint64_t vkr_bench_f32_bits(float32_t value) {
+  uint32_t bits = 0u;
+  MemCopy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/** Invertible TRS matrices, the shape every world transform has. */
+static bool8_t vkr_bench_math_setup(VkrBenchContext *context) {
+  VkrBenchMathState *state = arena_alloc_aligned(
+      context->arena, sizeof(*state), 16u, ARENA_MEMORY_TAG_ARRAY);
+  if (!state) {
+    return false_v;
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_MATRICES; ++i) {
+    const float32_t t = (float32_t)i * 0.01f;
+    state->a[i] = mat4_mul(mat4_translate(vec3_new(t, -t, 2.0f * t)),
+                           mat4_euler_rotate_y(t));
+    const Vec3 scale = vec3_new(1.0f + t, 1.0f, 1.0f - t * 0.5f);
+    state->b[i] = mat4_mul(mat4_euler_rotate_x(-t), mat4_scale(scale));
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_VECTORS; ++i) {
+    const float32_t v = (float32_t)i;
+    state->vectors[i] = vec4_new(v, v * 0.5f, -v, 1.0f);
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_mat4_mul(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchMathState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_MATRICES; ++i) {
+      state->out[i] = mat4_mul(state->a[i], state->b[i]);
+    }
+  }
+  vkr_bench_consume(vkr_bench_f32_bits(state->out[7].m03));
+}
+
+static void vkr_bench_mat4_inverse(VkrBenchContext *context,
+                                   uint64_t iterations) {
+  VkrBenchMathState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_MATRICES; ++i) {
+      state->out[i] = mat4_inverse(state->a[i]);
+    }
+  }
+  vkr_bench_consume(vkr_bench_f32_bits(state->out[7].m00));
+}
+
+static void vkr_bench_mat4_transform(VkrBenchContext *context,
+                                     uint64_t iterations) {
+  VkrBenchMathState *state = context->state;
+  const Mat4 m = state->a[VKR_BENCH_MATRICES / 2u];
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_VECTORS; ++i) {
+      state->transformed[i] = mat4_mul_vec4(m, state->vectors[i]);
+    }
+  }
+  vkr_bench_consume(vkr_bench_f32_bits(state->transformed[11].x));
+}
+
+/** Four independent accumulators so the FMA latency chain is not the limit. */
+static void vkr_bench_simd_fma(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchMathState *state = context->state;
+  const VKR_SIMD_F32X4 scale = vkr_simd_set1_f32x4(0.999f);
+  VKR_SIMD_F32X4 sum[4] = {
+      vkr_simd_set1_f32x4(0.0f), vkr_simd_set1_f32x4(0.0f),
+      vkr_simd_set1_f32x4(0.0f), vkr_simd_set1_f32x4(0.0f)};
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_VECTORS; i += 4u) {
+      for (uint32_t lane = 0; lane < 4u; ++lane) {
+        sum[lane] =
+            vkr_simd_fma_f32x4(state->vectors[i + lane], scale, sum[lane]);
+      }
+    }
+  }
+  const VKR_SIMD_F32X4 total = vkr_simd_add_f32x4(
+      vkr_simd_add_f32x4(sum[0], sum[1]), vkr_simd_add_f32x4(sum[2], sum[3]));
+  vkr_bench_consume(vkr_bench_f32_bits(vkr_simd_hadd_f32x4(total)));
+}
+
+void vkr_bench_register_math(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "mat4.mul",
+                                   .ops_per_iteration = VKR_BENCH_MATRICES,
+                                   .setup = vkr_bench_math_setup,
+                                   .run = vkr_bench_mat4_mul,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "mat4.inverse",
+                                   .ops_per_iteration = VKR_BENCH_MATRICES,
+                                   .setup = vkr_bench_math_setup,
+                                   .run = vkr_bench_mat4_inverse,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "mat4.transform_vec4",
+                                   .ops_per_iteration = VKR_BENCH_VECTORS,
+                                   .setup = vkr_bench_math_setup,
+                                   .run = vkr_bench_mat4_transform,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "simd.fma_f32x4",
+                                   .ops_per_iteration = VKR_BENCH_VECTORS,
+                                   .setup = vkr_bench_math_setup,
+                                   .run = vkr_bench_simd_fma,
+                               });
+}
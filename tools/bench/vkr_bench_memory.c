@@ -0,0 +1,165 @@
+/**
+ * @file vkr_bench_memory.c
+ * @brief Arena, pool, and dynamic-memory allocator cases.
+ */
+#include "memory/vkr_dmemory.h"
+#include "memory/vkr_pool.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_ALLOCATIONS 1024u
+#define VKR_BENCH_SMALL_SIZE 64u
+#define VKR_BENCH_DMEMORY_ALLOCATIONS 256u
+
+typedef struct VkrBenchArenaState {
+  Arena *arena;
+} VkrBenchArenaState;
+
+typedef struct VkrBenchPoolState {
+  VkrPool pool;
+  void *chunks[VKR_BENCH_ALLOCATIONS];
+} VkrBenchPoolState;
+
+typedef struct VkrBenchDMemoryState {
+  VkrDMemory dmemory;
+  void *blocks[VKR_BENCH_DMEMORY_ALLOCATIONS];
+  uint64_t sizes[VKR_BENCH_DMEMORY_ALLOCATIONS];
+} VkrBenchDMemoryState;
+
+/** A private arena keeps the case arena's own blocks out of the measurement. */
+static bool8_t vkr_bench_arena_setup(VkrBenchContext *context) {
+  VkrBenchArenaState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  state->arena = arena_create(MB(8), KB(256));
+  if (!state->arena) {
+    return false_v;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_arena_teardown(VkrBenchContext *context) {
+  VkrBenchArenaState *state = context->state;
+  arena_destroy(state->arena);
+}
+
+static void vkr_bench_arena_run(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchArenaState *state = context->state;
+  const uint64_t mark = arena_pos(state->arena);
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_ALLOCATIONS; ++i) {
+      sum += (uint64_t)(uintptr_t)arena_alloc(
+          state->arena, VKR_BENCH_SMALL_SIZE, ARENA_MEMORY_TAG_UNKNOWN);
+    }
+    arena_reset_to(state->arena, mark, ARENA_MEMORY_TAG_UNKNOWN);
+  }
+  vkr_bench_consume(sum);
+}
+
+static bool8_t vkr_bench_pool_setup(VkrBenchContext *context) {
+  VkrBenchPoolState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  if (!vkr_pool_create(VKR_BENCH_SMALL_SIZE, VKR_BENCH_ALLOCATIONS,
+                       &state->pool)) {
+    return false_v;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_pool_teardown(VkrBenchContext *context) {
+  VkrBenchPoolState *state = context->state;
+  vkr_pool_destroy(&state->pool);
+}
+
+/** Drains the pool and refills it, so every free-list state is visited. */
+static void vkr_bench_pool_run(VkrBenchContext *context, uint64_t iterations) {
+  VkrBenchPoolState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_ALLOCATIONS; ++i) {
+      state->chunks[i] = vkr_pool_alloc(&state->pool);
+    }
+    for (uint32_t i = 0; i < VKR_BENCH_ALLOCATIONS; ++i) {
+      (void)vkr_pool_free(&state->pool, state->chunks[i]);
+    }
+  }
+  vkr_bench_consume(vkr_pool_free_chunks(&state->pool));
+}
+
+static bool8_t vkr_bench_dmemory_setup(VkrBenchContext *context) {
+  static const uint64_t sizes[] = {16u, 48u, 128u, 256u, 1024u, 4096u};
+  VkrBenchDMemoryState *state =
+      arena_alloc(context->arena, sizeof(*state), ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  if (!vkr_dmemory_create(MB(4), MB(16), &state->dmemory)) {
+    return false_v;
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_DMEMORY_ALLOCATIONS; ++i) {
+    state->sizes[i] = sizes[(i * 5u) % ArrayCount(sizes)];
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_dmemory_teardown(VkrBenchContext *context) {
+  VkrBenchDMemoryState *state = context->state;
+  vkr_dmemory_destroy(&state->dmemory);
+}
+
+/**
+ * Frees the even blocks before the odd ones so the free list fragments and
+ * coalesces every iteration instead of only ever popping its head.
+ */
+static void vkr_bench_dmemory_run(VkrBenchContext *context,
+                                  uint64_t iterations) {
+  VkrBenchDMemoryState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_DMEMORY_ALLOCATIONS; ++i) {
+      state->blocks[i] = vkr_dmemory_alloc(&state->dmemory, state->sizes[i]);
+    }
+    for (uint32_t parity = 0; parity < 2u; ++parity) {
+      for (uint32_t i = parity; i < VKR_BENCH_DMEMORY_ALLOCATIONS; i += 2u) {
+        if (state->blocks[i]) {
+          (void)vkr_dmemory_free(&state->dmemory, state->blocks[i],
+                                 state->sizes[i]);
+        }
+      }
+    }
+  }
+  vkr_bench_consume(vkr_dmemory_get_free_space(&state->dmemory));
+}
+
+void vkr_bench_register_memory(VkrBenchRegistry *registry) {
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "arena.alloc_64b",
+                                   .ops_per_iteration = VKR_BENCH_ALLOCATIONS,
+                                   .setup = vkr_bench_arena_setup,
+                                   .run = vkr_bench_arena_run,
+                                   .teardown = vkr_bench_arena_teardown,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "pool.alloc_free_64b",
+                                   .ops_per_iteration = VKR_BENCH_ALLOCATIONS,
+                                   .setup = vkr_bench_pool_setup,
+                                   .run = vkr_bench_pool_run,
+                                   .teardown = vkr_bench_pool_teardown,
+                               });
+  vkr_bench_register(registry,
+                     (VkrBenchCase){
+                         .name = "dmemory.alloc_free_mixed",
+                         .ops_per_iteration = VKR_BENCH_DMEMORY_ALLOCATIONS,
+                         .setup = vkr_bench_dmemory_setup,
+                         .run = vkr_bench_dmemory_run,
+                         .teardown = vkr_bench_dmemory_teardown,
+                     });
+}
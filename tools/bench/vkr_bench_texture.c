@@ -0,0 +1,210 @@
+/**
+ * @file vkr_bench_texture.c
+ * @brief Bulk texture conversion kernels, one case per kernel.
+ *
+ * Every case converts the same 4096-pixel tile, so ns/op is per value for the
+ * half-float and sRGB cases and per pixel for the rest. The `_scalar` cases run
+ * the per-value loops the kernels replace.
+ */
+#include "renderer/vkr_ibl_math.h"
+#include "renderer/vkr_texture_convert.h"
+#include "vkr_bench.h"
+
+#define VKR_BENCH_TEXTURE_PIXELS 4096u
+
+typedef struct VkrBenchTextureState {
+  float32_t rgba[VKR_BENCH_TEXTURE_PIXELS * 4u];
+  float32_t rgb[VKR_BENCH_TEXTURE_PIXELS * 3u];
+  float32_t scratch[VKR_BENCH_TEXTURE_PIXELS * 4u];
+  uint16_t halves[VKR_BENCH_TEXTURE_PIXELS * 4u];
+  uint8_t rgbe[VKR_BENCH_TEXTURE_PIXELS * 4u];
+  uint8_t rgba8[VKR_BENCH_TEXTURE_PIXELS * 4u];
+  uint8_t premultiplied[VKR_BENCH_TEXTURE_PIXELS * 4u];
+} VkrBenchTextureState;
+
+/** HDR-like radiance: mostly below one with a few bright samples. */
+static bool8_t vkr_bench_texture_setup(VkrBenchContext *context) {
+  VkrBenchTextureState *state = arena_alloc_aligned(
+      context->arena, sizeof(*state), 16u, ARENA_MEMORY_TAG_ARRAY);
+  if (!state) {
+    return false_v;
+  }
+  uint32_t seed = 1u;
+  for (uint32_t i = 0; i < VKR_BENCH_TEXTURE_PIXELS * 4u; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const float32_t unit = (float32_t)(seed >> 8u) / 16777216.0f;
+    state->rgba[i] = (i % 53u == 0u) ? unit * 2000.0f : unit;
+    state->rgbe[i] = (uint8_t)(seed >> 24u);
+    state->rgba8[i] = (uint8_t)(seed >> 16u);
+  }
+  for (uint32_t i = 0; i < VKR_BENCH_TEXTURE_PIXELS * 3u; ++i) {
+    state->rgb[i] = state->rgba[i];
+  }
+  vkr_texture_convert_f32_to_f16(state->rgba, state->halves,
+                                 VKR_BENCH_TEXTURE_PIXELS * 4u);
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_texture_f32_to_f16(VkrBenchContext *context,
+                                         uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_texture_convert_f32_to_f16(state->rgba, state->halves,
+                                   VKR_BENCH_TEXTURE_PIXELS * 4u);
+  }
+  vkr_bench_consume(state->halves[17]);
+}
+
+static void vkr_bench_texture_f32_to_f16_scalar(VkrBenchContext *context,
+                                                uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t i = 0; i < VKR_BENCH_TEXTURE_PIXELS * 4u; ++i) {
+      state->halves[i] = vkr_float32_to_float16(state->rgba[i]);
+    }
+  }
+  vkr_bench_consume(state->halves[17]);
+}
+
+static void vkr_bench_texture_f16_to_f32(VkrBenchContext *context,
+                                         uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_texture_convert_f16_to_f32(state->halves, state->scratch,
+                                   VKR_BENCH_TEXTURE_PIXELS * 4u);
+  }
+  vkr_bench_consume((uint64_t)state->scratch[17]);
+}
+
+static void vkr_bench_texture_hdr_rgba16f(VkrBenchContext *context,
+                                          uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  uint64_t clamped = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrTextureHdrConvertStats stats = {0};
+    vkr_texture_convert_rgb32f_to_rgba16f(state->rgb, state->halves,
+                                          VKR_BENCH_TEXTURE_PIXELS, &stats);
+    clamped += stats.clamped_count;
+  }
+  vkr_bench_consume(clamped + state->halves[17]);
+}
+
+static void vkr_bench_texture_rgbe(VkrBenchContext *context,
+                                   uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_texture_convert_rgbe_to_rgb32f(state->rgbe, state->scratch,
+                                       VKR_BENCH_TEXTURE_PIXELS);
+  }
+  vkr_bench_consume((uint64_t)state->scratch[17]);
+}
+
+static void vkr_bench_texture_srgb8(VkrBenchContext *context,
+                                    uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_texture_convert_srgb8_to_linear(state->rgba8, state->scratch,
+                                        VKR_BENCH_TEXTURE_PIXELS * 4u);
+  }
+  vkr_bench_consume((uint64_t)(state->scratch[17] * 1000.0f));
+}
+
+static void vkr_bench_texture_srgb_poly(VkrBenchContext *context,
+                                        uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    vkr_texture_convert_srgb_to_linear(state->rgba, state->scratch,
+                                       VKR_BENCH_TEXTURE_PIXELS * 4u);
+  }
+  vkr_bench_consume((uint64_t)(state->scratch[17] * 1000.0f));
+}
+
+/** Premultiplies a fresh copy each iteration so alpha never collapses. */
+static void vkr_bench_texture_premultiply(VkrBenchContext *context,
+                                          uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    MemCopy(state->premultiplied, state->rgba8, sizeof(state->rgba8));
+    vkr_texture_premultiply_rgba8(state->premultiplied,
+                                  VKR_BENCH_TEXTURE_PIXELS);
+  }
+  vkr_bench_consume(state->premultiplied[17]);
+}
+
+/**
+ * The fixed 1024-pixel normal-map sample is a quarter of this tile; real
+ * textures amortize it.
+ */
+static void vkr_bench_texture_analyze(VkrBenchContext *context,
+                                      uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  uint64_t transparent = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrTextureRgba8Analysis analysis = {0};
+    vkr_texture_analyze_rgba8(state->rgba8, VKR_BENCH_TEXTURE_PIXELS,
+                              &analysis);
+    transparent += analysis.transparent_count + analysis.channel_min[0];
+  }
+  vkr_bench_consume(transparent);
+}
+
+/** The alpha-only scan decode used to run before the sidecar write. */
+static void vkr_bench_texture_analyze_alpha_scalar(VkrBenchContext *context,
+                                                   uint64_t iterations) {
+  VkrBenchTextureState *state = context->state;
+  uint64_t transparent = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    uint64_t transparent_count = 0u;
+    uint64_t intermediate_count = 0u;
+    for (uint32_t i = 0; i < VKR_BENCH_TEXTURE_PIXELS; ++i) {
+      const uint8_t alpha = state->rgba8[i * 4u + 3u];
+      if (alpha < 255u) {
+        transparent_count++;
+        if (alpha > 0u) {
+          intermediate_count++;
+        }
+      }
+    }
+    transparent += transparent_count + intermediate_count;
+  }
+  vkr_bench_consume(transparent);
+}
+
+void vkr_bench_register_texture(VkrBenchRegistry *registry) {
+  static const struct {
+    const char *name;
+    uint64_t ops_per_iteration;
+    VkrBenchRunFn run;
+  } cases[] = {
+      {"texture.f32_to_f16", VKR_BENCH_TEXTURE_PIXELS * 4u,
+       vkr_bench_texture_f32_to_f16},
+      {"texture.f32_to_f16_scalar", VKR_BENCH_TEXTURE_PIXELS * 4u,
+       vkr_bench_texture_f32_to_f16_scalar},
+      {"texture.f16_to_f32", VKR_BENCH_TEXTURE_PIXELS * 4u,
+       vkr_bench_texture_f16_to_f32},
+      {"texture.hdr_rgb_to_rgba16f", VKR_BENCH_TEXTURE_PIXELS,
+       vkr_bench_texture_hdr_rgba16f},
+      {"texture.rgbe_to_rgb32f", VKR_BENCH_TEXTURE_PIXELS,
+       vkr_bench_texture_rgbe},
+      {"texture.srgb8_to_linear", VKR_BENCH_TEXTURE_PIXELS * 4u,
+       vkr_bench_texture_srgb8},
+      {"texture.srgb_to_linear", VKR_BENCH_TEXTURE_PIXELS * 4u,
+       vkr_bench_texture_srgb_poly},
+      {"texture.premultiply_rgba8", VKR_BENCH_TEXTURE_PIXELS,
+       vkr_bench_texture_premultiply},
+      {"texture.analyze_rgba8", VKR_BENCH_TEXTURE_PIXELS,
+       vkr_bench_texture_analyze},
+      {"texture.analyze_alpha_scalar", VKR_BENCH_TEXTURE_PIXELS,
+       vkr_bench_texture_analyze_alpha_scalar},
+  };
+  for (uint32_t i = 0; i < ArrayCount(cases); ++i) {
+    vkr_bench_register(registry,
+                       (VkrBenchCase){
+                           .name = cases[i].name,
+                           .ops_per_iteration = cases[i].ops_per_iteration,
+                           .setup = vkr_bench_texture_setup,
+                           .run = cases[i].run,
+                       });
+  }
+}
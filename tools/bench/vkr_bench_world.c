@@ -0,0 +1,773 @@
+/**
+ * @file vkr_bench_world.c
+ * @brief World payload construction on a populated mesh manager.
+ *
+ * Every payload case builds from the same renderer state: sixteen loaded
+ * assets of one or two submeshes over sixty-four materials, instanced across
+ * a cube around the camera. `serial` is the single-threaded builder
+ * the chunked one replaced, kept here as the baseline; `chunked` runs
+ * `vkr_world_payload_build()` with the instance chunks on the calling thread
+ * and `jobs` spreads them over the shared worker pool. Occlusion postdates
+ * the serial builder, so every case runs with a zero occluder budget and
+ * produces the same rows. `jobs` falls back to the calling thread when no
+ * worker pool could be started. One op is one mesh instance.
+ *
+ * The probe cases select local reflection probes for draw bounds, once from
+ * the cached probe index and once by scanning the scene's probes.
+ */
+#include "core/vkr_parallel_for.h"
+#include "math/vkr_frustum.h"
+#include "renderer/systems/vkr_picking_ids.h"
+#include "renderer/systems/vkr_scene_system.h"
+#include "renderer/systems/vkr_world_resources.h"
+#include "renderer/vkr_visibility.h"
+#include "renderer/vkr_world_instancing.h"
+#include "renderer/vkr_world_payload.h"
+#include "vkr_bench.h"
+
+#include <stdlib.h>
+
+#define VKR_BENCH_WORLD_ASSETS 16u
+#define VKR_BENCH_WORLD_MATERIALS 64u
+
+typedef enum VkrBenchWorldBuilder {
+  VKR_BENCH_WORLD_BUILDER_SERIAL = 0,
+  VKR_BENCH_WORLD_BUILDER_CHUNKED,
+  VKR_BENCH_WORLD_BUILDER_JOBS,
+} VkrBenchWorldBuilder;
+
+typedef struct VkrBenchWorldState {
+  RendererFrontend *rf;
+  VkrAssetPublisher publisher;
+  /** Case-arena allocator for the materials and each build's scratch. */
+  VkrAllocator allocator;
+  VkrParallelFor dispatch;
+  VkrOpaqueSetVersion opaque_set_version;
+  VkrBenchWorldBuilder builder;
+  bool8_t geometry_ready;
+  bool8_t mesh_manager_ready;
+} VkrBenchWorldState;
+
+static bool8_t
+vkr_bench_world_publish_geometry(void *state, VkrGeometryHandle handle,
+                                 const VkrGeometryConfig *config) {
+  (void)state;
+  (void)handle;
+  (void)config;
+  return true_v;
+}
+
+static bool8_t vkr_bench_world_unpublish_geometry(void *state,
+                                                  VkrGeometryHandle handle) {
+  (void)state;
+  (void)handle;
+  return true_v;
+}
+
+/**
+ * @brief The world payload builder before instance chunking, as a baseline.
+ *
+ * One thread counts every mesh, instance and cluster row, classifies them for
+ * the camera, then walks them again to emit. Only the helper names and the
+ * camera-visible rows (which replaced a blend-only visibility list) changed.
+ */
+static bool8_t
+vkr_bench_world_build_serial(RendererFrontend *rf, VkrAllocator *scratch,
+                             bool8_t picking,
+                             VkrOpaqueSetVersion *opaque_set_version,
+                             VkrWorldPassPayload *out_payload) {
+  const Mat4 view = rf->globals.view;
+  const VkrFrustum camera_frustum =
+      vkr_frustum_from_view_projection(view, rf->globals.projection);
+  const uint32_t mesh_count = vkr_mesh_manager_count(&rf->mesh_manager);
+  const uint32_t live_instance_count =
+      vkr_mesh_manager_instance_count(&rf->mesh_manager);
+  const uint32_t cluster_capacity =
+      picking ? 0u
+              : vkr_mesh_manager_static_cluster_capacity(&rf->mesh_manager);
+  uint64_t candidate_count_64 = 0u;
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (mesh->visible && mesh->loading_state == VKR_MESH_LOADING_STATE_LOADED)
+      candidate_count_64 += vkr_mesh_manager_submesh_count(mesh);
+  }
+  for (uint32_t i = 0; i < live_instance_count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    candidate_count_64 += asset->submeshes.length;
+    if (!picking)
+      candidate_count_64 -= instance->static_batched_count;
+  }
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    if (vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c))
+      candidate_count_64++;
+  }
+  if (candidate_count_64 > VKR_GPU_DRAW_CANDIDATE_CAPACITY) {
+    *out_payload = (VkrWorldPassPayload){
+        .gpu_candidate_count = VKR_GPU_DRAW_CANDIDATE_CAPACITY + 1u,
+    };
+    return true_v;
+  }
+
+  const uint32_t gpu_candidate_count = (uint32_t)candidate_count_64;
+  uint8_t *camera_visible = NULL;
+  if (gpu_candidate_count > 0u) {
+    camera_visible = vkr_allocator_alloc(scratch, gpu_candidate_count,
+                                         VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    if (!camera_visible) {
+      *out_payload = (VkrWorldPassPayload){0};
+      return false_v;
+    }
+    MemSet(camera_visible, 1, gpu_candidate_count);
+  }
+
+  uint32_t gpu_camera_opaque_candidate_count = 0u;
+  uint32_t transmission_gpu_candidate_count = 0u;
+  uint32_t transparent_draw_count = 0u;
+  uint32_t source_index = 0u;
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      VkrSubMesh *submesh =
+          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      gpu_camera_opaque_candidate_count +=
+          !transmissive && !alpha.world_transparent ? 1u : 0u;
+      transmission_gpu_candidate_count += transmissive ? 1u : 0u;
+      if (!transmissive && alpha.world_transparent) {
+        bool8_t visible = true_v;
+        if (mesh->bounds_valid) {
+          Vec3 center = {0};
+          float32_t radius = 0.0f;
+          vkr_visibility_submesh_sphere(mesh->model, submesh->center,
+                                        submesh->min_extents,
+                                        submesh->max_extents, &center, &radius);
+          visible = vkr_frustum_test_sphere(&camera_frustum, center, radius);
+        }
+        camera_visible[source_index] = visible;
+        transparent_draw_count += visible ? 1u : 0u;
+      }
+      source_index++;
+    }
+  }
+
+  for (uint32_t i = 0; i < live_instance_count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      if (vkr_world_payload_submesh_batched(instance, s, picking))
+        continue;
+      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      gpu_camera_opaque_candidate_count +=
+          !transmissive && !alpha.world_transparent ? 1u : 0u;
+      transmission_gpu_candidate_count += transmissive ? 1u : 0u;
+      if (!transmissive && alpha.world_transparent) {
+        bool8_t visible = true_v;
+        if (instance->bounds_valid) {
+          Vec3 center = {0};
+          float32_t radius = 0.0f;
+          vkr_visibility_submesh_sphere(instance->model, submesh->center,
+                                        submesh->min_extents,
+                                        submesh->max_extents, &center, &radius);
+          visible = vkr_frustum_test_sphere(&camera_frustum, center, radius);
+        }
+        camera_visible[source_index] = visible;
+        transparent_draw_count += visible ? 1u : 0u;
+      }
+      source_index++;
+    }
+  }
+
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    const VkrStaticBatchCluster *cluster =
+        vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c);
+    if (!cluster)
+      continue;
+    VkrWorldPayloadSource source = {0};
+    vkr_world_payload_cluster_source(rf, cluster, &source);
+    gpu_camera_opaque_candidate_count +=
+        !source.transmissive && !source.alpha.world_transparent ? 1u : 0u;
+    transmission_gpu_candidate_count += source.transmissive ? 1u : 0u;
+    if (!source.transmissive && source.alpha.world_transparent) {
+      Vec3 center = {0};
+      float32_t radius = 0.0f;
+      vkr_visibility_submesh_sphere(source.model, source.center,
+                                    source.min_extents, source.max_extents,
+                                    &center, &radius);
+      const bool8_t visible =
+          vkr_frustum_test_sphere(&camera_frustum, center, radius);
+      camera_visible[source_index] = visible;
+      transparent_draw_count += visible ? 1u : 0u;
+    }
+    source_index++;
+  }
+
+  VkrWorldDrawCandidate *gpu_candidates = NULL;
+  VkrWorldDrawCandidate *transmission_gpu_candidates = NULL;
+  VkrTransparentDrawCandidate *transparent_candidates = NULL;
+  VkrDrawItem *transparent_draws = NULL;
+  VkrInstanceDataGPU *transparent_instances = NULL;
+  if (gpu_candidate_count > 0u)
+    gpu_candidates = vkr_allocator_alloc(
+        scratch, sizeof(*gpu_candidates) * (uint64_t)gpu_candidate_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transmission_gpu_candidate_count > 0u)
+    transmission_gpu_candidates =
+        vkr_allocator_alloc(scratch,
+                            sizeof(*transmission_gpu_candidates) *
+                                (uint64_t)transmission_gpu_candidate_count,
+                            VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transparent_draw_count > 0u) {
+    transparent_candidates = vkr_allocator_alloc(
+        scratch,
+        sizeof(*transparent_candidates) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    transparent_draws = vkr_allocator_alloc(
+        scratch, sizeof(*transparent_draws) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+    transparent_instances = vkr_allocator_alloc(
+        scratch,
+        sizeof(*transparent_instances) * (uint64_t)transparent_draw_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  if ((gpu_candidate_count > 0u && !gpu_candidates) ||
+      (transmission_gpu_candidate_count > 0u && !transmission_gpu_candidates) ||
+      (transparent_draw_count > 0u &&
+       (!transparent_candidates || !transparent_draws ||
+        !transparent_instances))) {
+    *out_payload = (VkrWorldPassPayload){0};
+    return false_v;
+  }
+
+  VkrWorldPayloadEmit emit = {
+      .view = view,
+      .camera_visible = camera_visible,
+      .gpu_candidates = gpu_candidates,
+      .transmission_gpu_candidates = transmission_gpu_candidates,
+      .transparent_candidates = transparent_candidates,
+  };
+
+  for (uint32_t i = 0; i < mesh_count; ++i) {
+    uint32_t mesh_slot = 0;
+    VkrMesh *mesh = vkr_mesh_manager_get_mesh_by_live_index(&rf->mesh_manager,
+                                                            i, &mesh_slot);
+    if (!mesh->visible || mesh->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    const uint32_t object_id =
+        mesh->render_id
+            ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE, mesh->render_id)
+            : 0u;
+    const bool8_t shadow_caster =
+        !mesh->bounds_valid ||
+        vkr_shadow_system_is_caster_relevant(
+            &rf->shadow_system,
+            vkr_mesh_bounds_index_mesh_key(&rf->mesh_manager.bounds_index,
+                                           mesh_slot));
+    const uint32_t submesh_count = vkr_mesh_manager_submesh_count(mesh);
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      VkrSubMesh *submesh =
+          vkr_mesh_manager_get_submesh(&rf->mesh_manager, mesh_slot, s);
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrMaterialHandle draw_material =
+          material ? (VkrMaterialHandle){.id = material->id,
+                                         .generation = material->generation}
+                   : submesh->material;
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      const VkrWorldPayloadSource source = {
+          .mesh = {.id = mesh_slot + 1u, .generation = 0u},
+          .geometry = submesh->geometry,
+          .material = draw_material,
+          .model = mesh->model,
+          .center = submesh->center,
+          .min_extents = submesh->min_extents,
+          .max_extents = submesh->max_extents,
+          .alpha = alpha,
+          .submesh_index = s,
+          .object_id = object_id,
+          .bounds_valid = mesh->bounds_valid,
+          .transmissive = transmissive,
+          .double_sided = material ? material->double_sided : false_v,
+          .shadow_caster = shadow_caster,
+      };
+      vkr_world_payload_emit_source(&emit, &source);
+    }
+  }
+
+  for (uint32_t i = 0; i < live_instance_count; ++i) {
+    uint32_t instance_slot = 0;
+    VkrMeshInstance *instance = vkr_mesh_manager_get_instance_by_live_index(
+        &rf->mesh_manager, i, &instance_slot);
+    if (!instance->visible ||
+        instance->loading_state != VKR_MESH_LOADING_STATE_LOADED)
+      continue;
+    VkrMeshAsset *asset =
+        vkr_mesh_manager_get_live_asset(&rf->mesh_manager, instance->asset);
+    const uint32_t object_id =
+        instance->render_id ? vkr_picking_encode_id(VKR_PICKING_ID_KIND_SCENE,
+                                                    instance->render_id)
+                            : 0u;
+    const bool8_t shadow_caster =
+        !instance->bounds_valid ||
+        vkr_shadow_system_is_caster_relevant(
+            &rf->shadow_system,
+            vkr_mesh_bounds_index_instance_key(&rf->mesh_manager.bounds_index,
+                                               instance_slot));
+    const uint32_t submesh_count = (uint32_t)asset->submeshes.length;
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      if (vkr_world_payload_submesh_batched(instance, s, picking))
+        continue;
+      VkrMeshAssetSubmesh *submesh = &asset->submeshes.data[s];
+      VkrMaterial *material = vkr_world_payload_material(rf, submesh->material);
+      const VkrMaterialHandle draw_material =
+          material ? (VkrMaterialHandle){.id = material->id,
+                                         .generation = material->generation}
+                   : submesh->material;
+      const VkrDrawAlphaRouting alpha =
+          vkr_world_payload_alpha_routing(rf, material);
+      const bool8_t transmissive =
+          vkr_world_payload_is_transmissive(rf, material);
+      const VkrWorldPayloadSource source = {
+          .mesh = {.id = instance_slot + 1u,
+                   .generation = instance->generation},
+          .geometry = submesh->geometry,
+          .material = draw_material,
+          .model = instance->model,
+          .center = submesh->center,
+          .min_extents = submesh->min_extents,
+          .max_extents = submesh->max_extents,
+          .alpha = alpha,
+          .submesh_index = s,
+          .object_id = object_id,
+          .bounds_valid = instance->bounds_valid,
+          .transmissive = transmissive,
+          .double_sided = material ? material->double_sided : false_v,
+          .shadow_caster = shadow_caster,
+      };
+      vkr_world_payload_emit_source(&emit, &source);
+    }
+  }
+
+  for (uint32_t c = 0; c < cluster_capacity; ++c) {
+    const VkrStaticBatchCluster *cluster =
+        vkr_mesh_manager_get_static_cluster(&rf->mesh_manager, c);
+    if (!cluster)
+      continue;
+    VkrWorldPayloadSource source = {0};
+    vkr_world_payload_cluster_source(rf, cluster, &source);
+    vkr_world_payload_emit_source(&emit, &source);
+  }
+
+  VkrWorldInstanceRun *gpu_instance_runs = NULL;
+  VkrWorldInstanceRun *transmission_instance_runs = NULL;
+  uint32_t gpu_instance_run_count = 0u;
+  uint32_t transmission_instance_run_count = 0u;
+  if (gpu_candidate_count > 0u)
+    gpu_instance_runs = vkr_allocator_alloc(
+        scratch, sizeof(*gpu_instance_runs) * (uint64_t)gpu_candidate_count,
+        VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if (transmission_gpu_candidate_count > 0u)
+    transmission_instance_runs =
+        vkr_allocator_alloc(scratch,
+                            sizeof(*transmission_instance_runs) *
+                                (uint64_t)transmission_gpu_candidate_count,
+                            VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  if ((gpu_candidate_count > 0u && !gpu_instance_runs) ||
+      (transmission_gpu_candidate_count > 0u && !transmission_instance_runs) ||
+      !vkr_world_instancing_build(scratch, gpu_candidates, gpu_candidate_count,
+                                  gpu_instance_runs, &gpu_instance_run_count,
+                                  NULL) ||
+      !vkr_world_instancing_build(
+          scratch, transmission_gpu_candidates,
+          transmission_gpu_candidate_count, transmission_instance_runs,
+          &transmission_instance_run_count, NULL)) {
+    *out_payload = (VkrWorldPassPayload){0};
+    return false_v;
+  }
+
+  if (transparent_draw_count > 1u)
+    qsort(transparent_candidates, transparent_draw_count,
+          sizeof(*transparent_candidates), vkr_transparent_draw_depth_compare);
+  vkr_transparent_draw_emit(transparent_candidates, transparent_draw_count,
+                            transparent_draws, transparent_instances);
+
+  *out_payload = (VkrWorldPassPayload){
+      .gpu_candidates = gpu_candidates,
+      .gpu_candidate_count = gpu_candidate_count,
+      .gpu_instance_runs = gpu_instance_runs,
+      .gpu_instance_run_count = gpu_instance_run_count,
+      .gpu_camera_opaque_candidate_count = gpu_camera_opaque_candidate_count,
+      .gpu_shadow_candidate_count = emit.shadow_caster_count,
+      .opaque_set_version = vkr_opaque_set_version_update(
+          opaque_set_version, rf->mesh_manager.render_version,
+          rf->material_system.publication_version, picking),
+      .transmission_gpu_candidates = transmission_gpu_candidates,
+      .transmission_gpu_candidate_count = transmission_gpu_candidate_count,
+      .transmission_instance_runs = transmission_instance_runs,
+      .transmission_instance_run_count = transmission_instance_run_count,
+      .transparent_draws = transparent_draws,
+      .transparent_draw_count = transparent_draw_count,
+      .instances = transparent_instances,
+      .instance_count = transparent_draw_count,
+  };
+  return true_v;
+}
+
+/**
+ * Stands up loaded assets the way the loader leaves them, then scatters
+ * instances over a cube around the camera so roughly half the blended rows
+ * fall outside the frustum. Every fourth asset has a second submesh, which
+ * keeps even the largest case under VKR_GPU_DRAW_CANDIDATE_CAPACITY rows.
+ */
+static bool8_t vkr_bench_world_setup(VkrBenchContext *context,
+                                     uint32_t instance_count,
+                                     VkrBenchWorldBuilder builder) {
+  VkrBenchWorldState *state = arena_alloc_aligned(
+      context->arena, sizeof(*state), 16u, ARENA_MEMORY_TAG_STRUCT);
+  RendererFrontend *rf = arena_alloc_aligned(context->arena, sizeof(*rf), 16u,
+                                             ARENA_MEMORY_TAG_STRUCT);
+  if (!state || !rf) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  MemZero(rf, sizeof(*rf));
+  state->rf = rf;
+  state->builder = builder;
+  state->allocator = (VkrAllocator){.ctx = context->arena};
+  vkr_allocator_arena(&state->allocator);
+  // Set before anything can fail, so teardown always finds a dispatcher.
+  context->state = state;
+  vkr_parallel_for_init(&state->dispatch,
+                        builder == VKR_BENCH_WORLD_BUILDER_JOBS
+                            ? context->job_system
+                            : NULL);
+
+  state->publisher = (VkrAssetPublisher){
+      .publish_geometry = vkr_bench_world_publish_geometry,
+      .unpublish_geometry = vkr_bench_world_unpublish_geometry,
+  };
+  VkrRendererError error = VKR_RENDERER_ERROR_NONE;
+  const VkrGeometrySystemConfig geometry_config = {
+      .max_geometries = 16u,
+      .asset_publisher = &state->publisher,
+  };
+  state->geometry_ready = vkr_geometry_system_init(
+      &rf->geometry_system, &geometry_config, &error);
+  if (!state->geometry_ready) {
+    return false_v;
+  }
+
+  rf->material_system.materials =
+      array_create_VkrMaterial(&state->allocator, VKR_BENCH_WORLD_MATERIALS);
+  if (!rf->material_system.materials.data) {
+    return false_v;
+  }
+  for (uint32_t m = 0; m < VKR_BENCH_WORLD_MATERIALS; ++m) {
+    VkrMaterial material = {
+        .id = m + 1u,
+        .generation = 1u,
+        .material_type = VKR_MATERIAL_TYPE_PBR,
+        .alpha_mode = m % 4u == 0u   ? VKR_MATERIAL_ALPHA_BLEND
+                      : m % 4u == 1u ? VKR_MATERIAL_ALPHA_CUTOUT
+                                     : VKR_MATERIAL_ALPHA_OPAQUE,
+        .alpha_mode_explicit = true_v,
+        .alpha_cutoff = 0.5f,
+        .double_sided = m % 3u == 0u,
+    };
+    material.pbr.transmission_factor = m % 16u == 7u ? 1.0f : 0.0f;
+    rf->material_system.materials.data[m] = material;
+  }
+
+  const VkrMeshManagerConfig mesh_config = {.max_mesh_count = instance_count};
+  state->mesh_manager_ready =
+      vkr_mesh_manager_init(&rf->mesh_manager, &rf->geometry_system,
+                            &rf->material_system, &mesh_config);
+  if (!state->mesh_manager_ready) {
+    return false_v;
+  }
+  VkrMeshManager *manager = &rf->mesh_manager;
+  VkrMeshAssetHandle assets[VKR_BENCH_WORLD_ASSETS];
+  for (uint32_t a = 0; a < VKR_BENCH_WORLD_ASSETS; ++a) {
+    const uint32_t submesh_count = a % 4u == 3u ? 2u : 1u;
+    VkrMeshAsset *asset = &manager->mesh_assets.data[a];
+    *asset = (VkrMeshAsset){
+        .id = a + 1u,
+        .generation = manager->asset_generation_counter++,
+        .submeshes = array_create_VkrMeshAssetSubmesh(&manager->asset_allocator,
+                                                      submesh_count),
+        .bounds_valid = true_v,
+        .bounds_local_radius = 0.87f,
+        .loading_state = VKR_MESH_LOADING_STATE_LOADED,
+        .ref_count = 1u,
+    };
+    if (!asset->submeshes.data) {
+      return false_v;
+    }
+    for (uint32_t s = 0; s < submesh_count; ++s) {
+      const uint32_t material = (a * 5u + s * 11u) % VKR_BENCH_WORLD_MATERIALS;
+      asset->submeshes.data[s] = (VkrMeshAssetSubmesh){
+          .geometry = rf->geometry_system.default_geometry,
+          .material = {.id = material + 1u, .generation = 1u},
+          .index_count = 36u,
+          .min_extents = vec3_new(-0.5f, -0.5f, -0.5f),
+          .max_extents = vec3_new(0.5f, 0.5f, 0.5f),
+      };
+    }
+    assets[a] = (VkrMeshAssetHandle){.id = asset->id,
+                                     .generation = asset->generation};
+  }
+  manager->next_asset_index = VKR_BENCH_WORLD_ASSETS;
+  manager->asset_count = VKR_BENCH_WORLD_ASSETS;
+
+  uint32_t seed = 0x9E3779B9u;
+  for (uint32_t i = 0; i < instance_count; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const Vec3 position = vec3_new((float32_t)(seed & 0x3FFu) - 512.0f,
+                                   (float32_t)((seed >> 10) & 0xFFu) - 128.0f,
+                                   (float32_t)((seed >> 18) & 0x3FFu) - 512.0f);
+    const Mat4 model =
+        mat4_mul(mat4_translate(position), mat4_euler_rotate_y(position.x));
+    vkr_mesh_manager_create_instance(
+        manager, assets[i % VKR_BENCH_WORLD_ASSETS], model, i + 1u, true_v,
+        &error);
+    if (error != VKR_RENDERER_ERROR_NONE) {
+      return false_v;
+    }
+  }
+
+  rf->globals.view_position = vec3_zero();
+  rf->globals.view = mat4_look_at(rf->globals.view_position,
+                                  vec3_new(0.0f, 0.0f, -1.0f), vec3_up());
+  rf->globals.projection =
+      mat4_perspective(vkr_to_radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+  return true_v;
+}
+
+static void vkr_bench_world_run(VkrBenchContext *context,
+                                uint64_t iterations) {
+  VkrBenchWorldState *state = context->state;
+  const VkrWorldPayloadBuildDesc desc = {
+      .rf = state->rf,
+      .dispatch = &state->dispatch,
+      .scratch = &state->allocator,
+      .opaque_set_version = &state->opaque_set_version,
+  };
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    VkrAllocatorScope scope = vkr_allocator_begin_scope(&state->allocator);
+    VkrWorldPassPayload payload = {0};
+    if (state->builder == VKR_BENCH_WORLD_BUILDER_SERIAL) {
+      vkr_bench_world_build_serial(state->rf, &state->allocator, false_v,
+                                   &state->opaque_set_version, &payload);
+    } else {
+      vkr_world_payload_build(&desc, &payload, NULL);
+    }
+    sum += payload.gpu_candidate_count + payload.gpu_instance_run_count +
+           payload.transparent_draw_count;
+    vkr_allocator_end_scope(&scope, VKR_ALLOCATOR_MEMORY_TAG_ARRAY);
+  }
+  vkr_bench_consume(sum);
+}
+
+/**
+ * Helpers may still be queued; the dispatcher lives in the case arena. The
+ * mesh manager and geometry system own arenas of their own.
+ */
+static void vkr_bench_world_teardown(VkrBenchContext *context) {
+  VkrBenchWorldState *state = context->state;
+  if (!state) {
+    return;
+  }
+  vkr_parallel_for_wait_idle(&state->dispatch);
+  if (state->mesh_manager_ready) {
+    vkr_mesh_manager_shutdown(&state->rf->mesh_manager);
+  }
+  if (state->geometry_ready) {
+    vkr_geometry_system_shutdown(&state->rf->geometry_system);
+  }
+}
+
+#define VKR_BENCH_WORLD_SETUP(COUNT)                                           \
+  static bool8_t vkr_bench_world_setup_serial_##COUNT(                         \
+      VkrBenchContext *context) {                                              \
+    return vkr_bench_world_setup(context, COUNT##000u,                         \
+                                 VKR_BENCH_WORLD_BUILDER_SERIAL);              \
+  }                                                                            \
+  static bool8_t vkr_bench_world_setup_chunked_##COUNT(                        \
+      VkrBenchContext *context) {                                              \
+    return vkr_bench_world_setup(context, COUNT##000u,                         \
+                                 VKR_BENCH_WORLD_BUILDER_CHUNKED);             \
+  }                                                                            \
+  static bool8_t vkr_bench_world_setup_jobs_##COUNT(                           \
+      VkrBenchContext *context) {                                              \
+    return vkr_bench_world_setup(context, COUNT##000u,                         \
+                                 VKR_BENCH_WORLD_BUILDER_JOBS);                \
+  }
+VKR_BENCH_WORLD_SETUP(10)
+VKR_BENCH_WORLD_SETUP(50)
+VKR_BENCH_WORLD_SETUP(200)
+#undef VKR_BENCH_WORLD_SETUP
+
+
+#define VKR_BENCH_PROBE_QUERIES 1024u
+
+typedef struct VkrBenchProbeState {
+  VkrScene scene;
+  VkrWorldProbeIndex index;
+  Vec3 centers[VKR_BENCH_PROBE_QUERIES];
+  float32_t radii[VKR_BENCH_PROBE_QUERIES];
+} VkrBenchProbeState;
+
+/**
+ * A full scene of ready probes tiling a 4x4 grid of overlapping rooms, queried
+ * with draw bounds spread over the grid and a margin around it.
+ */
+static bool8_t vkr_bench_probe_setup(VkrBenchContext *context) {
+  VkrBenchProbeState *state = arena_alloc_aligned(
+      context->arena, sizeof(*state), 16u, ARENA_MEMORY_TAG_STRUCT);
+  if (!state) {
+    return false_v;
+  }
+  MemZero(state, sizeof(*state));
+  VkrScene *scene = &state->scene;
+  scene->reflection_probe_count = VKR_SCENE_REFLECTION_PROBE_MAX;
+  for (uint32_t i = 0; i < scene->reflection_probe_count; ++i) {
+    scene->reflection_probes[i] = (VkrSceneReflectionProbe){
+        .enabled = true_v,
+        .center = vec3_new((float32_t)(i % 4u) * 10.0f, 2.0f,
+                           (float32_t)(i / 4u) * 10.0f),
+        .extents = vec3_new(5.0f, 3.0f, 5.0f),
+        .blend_distance = 1.5f,
+        .bake_state = VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY,
+    };
+  }
+  vkr_world_resources_build_probe_index(scene, &state->index);
+
+  uint32_t seed = 0x2545F491u;
+  for (uint32_t q = 0; q < VKR_BENCH_PROBE_QUERIES; ++q) {
+    seed = seed * 1664525u + 1013904223u;
+    state->centers[q] =
+        vec3_new((float32_t)(seed & 0x3Fu) - 12.0f,
+                 (float32_t)((seed >> 6) & 0x7u),
+                 (float32_t)((seed >> 9) & 0x3Fu) - 12.0f);
+    state->radii[q] = (float32_t)((seed >> 15) & 0x7u) * 0.5f;
+  }
+  context->state = state;
+  return true_v;
+}
+
+static void vkr_bench_probe_run_index(VkrBenchContext *context,
+                                      uint64_t iterations) {
+  VkrBenchProbeState *state = context->state;
+  uint32_t found[VKR_WORLD_PROBE_INDEX_CAPACITY];
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t q = 0; q < VKR_BENCH_PROBE_QUERIES; ++q) {
+      const uint32_t count = vkr_world_resources_query_probe_index(
+          &state->index, state->centers[q], state->radii[q], found);
+      sum += count ? found[0] + count : 0u;
+    }
+  }
+  vkr_bench_consume(sum);
+}
+
+/** The selection loop the index replaced: filter, test and rank every probe. */
+static void vkr_bench_probe_run_scan(VkrBenchContext *context,
+                                     uint64_t iterations) {
+  VkrBenchProbeState *state = context->state;
+  const VkrScene *scene = &state->scene;
+  uint64_t sum = 0u;
+  for (uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    for (uint32_t q = 0; q < VKR_BENCH_PROBE_QUERIES; ++q) {
+      uint32_t best_index = 0xFFFFFFFFu;
+      float32_t best_score = -VKR_FLOAT_MAX;
+      uint32_t count = 0u;
+      for (uint32_t i = 0; i < scene->reflection_probe_count; ++i) {
+        const VkrSceneReflectionProbe *probe = &scene->reflection_probes[i];
+        if (!probe->enabled ||
+            probe->bake_state != VKR_SCENE_REFLECTION_PROBE_BAKE_STATE_READY ||
+            !vkr_world_resources_probe_intersects_sphere(
+                probe->center, probe->extents, probe->blend_distance,
+                state->centers[q], state->radii[q])) {
+          continue;
+        }
+        const float32_t score =
+            -vec3_length(vec3_sub(state->centers[q], probe->center));
+        if (score > best_score) {
+          best_score = score;
+          best_index = i;
+        }
+        ++count;
+      }
+      sum += count ? best_index + count : 0u;
+    }
+  }
+  vkr_bench_consume(sum);
+}
+
+void vkr_bench_register_world(VkrBenchRegistry *registry) {
+#define VKR_BENCH_WORLD_CASE(BUILDER, COUNT)                                   \
+  vkr_bench_register(registry,                                                 \
+                     (VkrBenchCase){                                           \
+                         .name = "world.payload_" #BUILDER "_" #COUNT "k",     \
+                         .ops_per_iteration = COUNT##000u,                     \
+                         .setup = vkr_bench_world_setup_##BUILDER##_##COUNT,   \
+                         .run = vkr_bench_world_run,                           \
+                         .teardown = vkr_bench_world_teardown,                 \
+                     })
+#define VKR_BENCH_WORLD_CASES(COUNT)                                           \
+  VKR_BENCH_WORLD_CASE(serial, COUNT);                                         \
+  VKR_BENCH_WORLD_CASE(chunked, COUNT);                                        \
+  VKR_BENCH_WORLD_CASE(jobs, COUNT)
+  VKR_BENCH_WORLD_CASES(10);
+  VKR_BENCH_WORLD_CASES(50);
+  VKR_BENCH_WORLD_CASES(200);
+#undef VKR_BENCH_WORLD_CASES
+#undef VKR_BENCH_WORLD_CASE
+
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "world.probe_select_index",
+                                   .ops_per_iteration = VKR_BENCH_PROBE_QUERIES,
+                                   .setup = vkr_bench_probe_setup,
+                                   .run = vkr_bench_probe_run_index,
+                               });
+  vkr_bench_register(registry, (VkrBenchCase){
+                                   .name = "world.probe_select_scan",
+                                   .ops_per_iteration = VKR_BENCH_PROBE_QUERIES,
+                                   .setup = vkr_bench_probe_setup,
+                                   .run = vkr_bench_probe_run_scan,
+                               });
+}
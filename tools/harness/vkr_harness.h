@@ -2,6 +2,7 @@
 
 #include "containers/str.h"
 #include "containers/vkr_sort.h"
+#include "core/vkr_job_system.h"
 #include "core/vkr_json_writer.h"
 #include "core/vkr_metrics.h"
 #include "defines.h"
@@ -45,8 +46,12 @@
 /** Every published capture contributes canonical data, preview, and metadata.
  */
 #define VKR_HARNESS_ARTIFACTS_PER_CAPTURE 3u
+/** A failed comparison adds its diff image and its error heatmap. */
+#define VKR_HARNESS_COMPARISON_ARTIFACTS_PER_CAPTURE 2u
 #define VKR_HARNESS_MAX_ARTIFACTS                                              \
-  ((VKR_HARNESS_MAX_CAPTURE_RESULTS * VKR_HARNESS_ARTIFACTS_PER_CAPTURE) +     \
+  ((VKR_HARNESS_MAX_CAPTURE_RESULTS *                                          \
+    (VKR_HARNESS_ARTIFACTS_PER_CAPTURE +                                       \
+     VKR_HARNESS_COMPARISON_ARTIFACTS_PER_CAPTURE)) +                          \
    VKR_HARNESS_MAX_CAPTURES + VKR_HARNESS_MAX_RUNS + 32u)
 #define VKR_HARNESS_MAX_EVENTS 4096u
 #define VKR_HARNESS_MAX_FINGERPRINT_FIELDS 256u
@@ -108,6 +113,13 @@ typedef enum VkrHarnessCacheMode {
   VKR_HARNESS_CACHE_SHARED,
 } VkrHarnessCacheMode;
 
+/** Span trace recorded over the measured frames of each repetition. */
+typedef enum VkrHarnessTraceMode {
+  VKR_HARNESS_TRACE_NONE = 0,
+  VKR_HARNESS_TRACE_CHROME,   /**< trace.json, Chrome Trace Event format. */
+  VKR_HARNESS_TRACE_PERFETTO, /**< trace.perfetto-trace protobuf. */
+} VkrHarnessTraceMode;
+
 typedef enum VkrHarnessCameraMode {
   VKR_HARNESS_CAMERA_STATIC = 0,
   VKR_HARNESS_CAMERA_KEYFRAMES,
@@ -318,6 +330,7 @@ typedef struct VkrHarnessProfile {
   bool8_t require_actual_present;
   bool8_t gpu_timing;
   bool8_t event_subjects;
+  VkrHarnessTraceMode trace;
   uint32_t minimum_repetitions;
   uint32_t warmup_stability_window;
   char warmup_stability_metric[128];
@@ -382,6 +395,91 @@ typedef struct VkrHarnessPassResult {
   uint64_t disabled_count;
 } VkrHarnessPassResult;
 
+#define VKR_HARNESS_MAX_CHANGE_POINTS 8u
+
+typedef enum VkrHarnessRegressionVerdict {
+  VKR_HARNESS_REGRESSION_INCONCLUSIVE = 0,
+  VKR_HARNESS_REGRESSION_IMPROVED,
+  VKR_HARNESS_REGRESSION_REGRESSED,
+} VkrHarnessRegressionVerdict;
+
+/**
+ * Policy for comparing one metric's baseline and candidate sample streams.
+ * `vkr_harness_regression_config_default()` is the policy `compare` applies;
+ * tests override single fields.
+ */
+typedef struct VkrHarnessRegressionConfig {
+  /** Two-sided significance level of the rank and distribution tests. */
+  float64_t alpha;
+  /** Coverage of every bootstrap interval. */
+  float64_t confidence;
+  uint32_t bootstrap_iterations;
+  /** Resampling is seeded so a comparison is reproducible. */
+  uint64_t bootstrap_seed;
+  /** Smallest relative shift that can be called a change at all. */
+  float64_t min_relative_effect;
+  /** Modified z-score above which a sample is rejected as an outlier. */
+  float64_t outlier_limit;
+  /** MSER batch size used to find the end of each repetition's warmup. */
+  uint32_t warmup_batch_size;
+  /** Batch size the change-point search averages over. */
+  uint32_t change_point_batch_size;
+  /** Streams shorter than this after filtering are never judged. */
+  uint64_t min_samples;
+  bool8_t lower_is_better;
+} VkrHarnessRegressionConfig;
+
+/**
+ * One metric's samples: `repetition_count` independent repetitions stored back
+ * to back, repetition `i` holding `repetition_lengths[i]` finite values.
+ */
+typedef struct VkrHarnessSampleStream {
+  const float64_t *values;
+  const uint64_t *repetition_lengths;
+  uint32_t repetition_count;
+} VkrHarnessSampleStream;
+
+typedef struct VkrHarnessInterval {
+  float64_t estimate;
+  float64_t lower;
+  float64_t upper;
+} VkrHarnessInterval;
+
+/** What one side contributed after warmup trimming and outlier rejection. */
+typedef struct VkrHarnessStreamSummary {
+  uint64_t sample_count;
+  uint64_t warmup_trimmed;
+  uint64_t outliers_rejected;
+  VkrHarnessInterval p50;
+  VkrHarnessInterval p95;
+  /** Sample offsets into the warmup-trimmed stream where its level shifts. */
+  uint64_t change_points[VKR_HARNESS_MAX_CHANGE_POINTS];
+  uint32_t change_point_count;
+} VkrHarnessStreamSummary;
+
+typedef struct VkrHarnessRegressionResult {
+  VkrHarnessRegressionVerdict verdict;
+  /** Stable token naming the rule that produced the verdict. */
+  const char *reason;
+  VkrHarnessStreamSummary baseline;
+  VkrHarnessStreamSummary candidate;
+  /** Candidate minus baseline, in the metric's unit. */
+  VkrHarnessInterval p50_delta;
+  VkrHarnessInterval p95_delta;
+  /** The deltas relative to the baseline estimate; unset for a zero baseline.
+   */
+  VkrHarnessInterval p50_relative;
+  VkrHarnessInterval p95_relative;
+  bool8_t relative_defined;
+  float64_t mann_whitney_u;
+  float64_t mann_whitney_z;
+  float64_t mann_whitney_p;
+  /** P(candidate > baseline) - P(candidate < baseline), in [-1, 1]. */
+  float64_t cliffs_delta;
+  float64_t ks_statistic;
+  float64_t ks_p;
+} VkrHarnessRegressionResult;
+
 typedef struct VkrHarnessProvenance {
   char started_at[40];
   char ended_at[40];
@@ -479,6 +577,35 @@ typedef struct VkrHarnessCaptureResult {
   VkrHarnessComparisonResult comparison;
 } VkrHarnessCaptureResult;
 
+/** Edge of the square tiles comparison work and heatmaps are divided into. */
+#define VKR_HARNESS_IMAGE_TILE_SIZE 32u
+/** PSNR reported for identical images, whose true PSNR is infinite. */
+#define VKR_HARNESS_PSNR_MAX_DB 100.0
+
+/**
+ * Perceptual quality of a color comparison. Reported beside the raw error
+ * statistics; the comparison verdict is still decided by the thresholds alone.
+ * Kept out of `VkrHarnessCaptureResult` so the child summary layout is
+ * unchanged.
+ */
+typedef struct VkrHarnessImageQuality {
+  bool8_t measured;
+  /** Settled by matching data digests; no pixel was decoded. */
+  bool8_t identical;
+  float64_t psnr_db;
+  /** Mean SSIM over 8x8 luma windows at full resolution. */
+  float64_t ssim;
+  float64_t ms_ssim;
+  /** FLIP-style perceived error in [0, 1], 0 meaning indistinguishable. */
+  float64_t flip_mean;
+  float64_t flip_max;
+  uint32_t tiles_x;
+  uint32_t tiles_y;
+  /** One pixel per tile, colored by the tile's mean FLIP error. */
+  char heatmap_path[VKR_HARNESS_RELATIVE_PATH_MAX];
+  char heatmap_sha256[VKR_HARNESS_DIGEST_MAX];
+} VkrHarnessImageQuality;
+
 typedef struct VkrHarnessEvent {
   char source[128];
   char subject[VKR_METRIC_EVENT_SUBJECT_MAX + 1u];
@@ -531,6 +658,8 @@ typedef struct VkrHarnessReport {
      stack of every writer. Sized once by
      `vkr_harness_report_init_storage()`. */
   VkrHarnessCaptureResult *captures;
+  /** Parallel to `captures`. */
+  VkrHarnessImageQuality *quality;
   uint32_t capture_count;
   uint32_t capture_capacity;
   VkrHarnessArtifact *artifacts;
@@ -721,6 +850,74 @@ bool8_t vkr_harness_statistics_compute(const float64_t *samples,
 bool8_t vkr_harness_gpu_pass_samples_complete(const uint8_t *flags,
                                               uint64_t sample_count);
 
+VkrHarnessRegressionConfig vkr_harness_regression_config_default(void);
+
+/**
+ * Number of leading samples to discard as warmup, by the MSER rule: the
+ * truncation point that minimizes the standard error of the remaining batch
+ * means. Only the first half of the series is considered.
+ */
+uint64_t vkr_harness_warmup_length(const float64_t *samples,
+                                   uint64_t sample_count, uint32_t batch_size);
+
+/**
+ * Compacts `samples` in place, dropping values whose modified z-score
+ * `0.6745 * |x - median| / MAD` exceeds `limit`. A zero MAD rejects nothing.
+ *
+ * @param scratch At least `sample_count` values.
+ * @return The number of samples kept.
+ */
+uint64_t vkr_harness_reject_outliers(float64_t *samples, uint64_t sample_count,
+                                     float64_t limit, float64_t *scratch);
+
+/**
+ * Binary segmentation over batch medians. A split is kept when its level shift
+ * is significant against a robust noise estimate and at least
+ * `min_relative_effect` of the series median.
+ *
+ * @return The number of change points written, ascending, as sample offsets.
+ */
+uint32_t vkr_harness_change_points(
+    const float64_t *samples, uint64_t sample_count, uint32_t batch_size,
+    float64_t min_relative_effect, Arena *transient,
+    uint64_t out_points[VKR_HARNESS_MAX_CHANGE_POINTS]);
+
+/** Two-sided Mann-Whitney U test with tie correction; `u` is the candidate's.
+ */
+bool8_t vkr_harness_mann_whitney(const float64_t *baseline,
+                                 uint64_t baseline_count,
+                                 const float64_t *candidate,
+                                 uint64_t candidate_count, Arena *transient,
+                                 float64_t *out_u, float64_t *out_z,
+                                 float64_t *out_p);
+
+/** Two-sample Kolmogorov-Smirnov test over already sorted inputs. */
+void vkr_harness_kolmogorov_smirnov(const float64_t *baseline_sorted,
+                                    uint64_t baseline_count,
+                                    const float64_t *candidate_sorted,
+                                    uint64_t candidate_count,
+                                    float64_t *out_statistic,
+                                    float64_t *out_p);
+
+/**
+ * Compares one metric. Each repetition's warmup is trimmed, outliers are
+ * rejected for the location statistics, and the verdict needs both a
+ * significant rank test and a bootstrap interval that excludes zero by at least
+ * the minimum effect; a shift confined to the tail is judged on p95 together
+ * with the Kolmogorov-Smirnov test. A stream with a level shift of its own is
+ * not one distribution and is never judged.
+ *
+ * Working memory is scoped to `transient`.
+ */
+bool8_t vkr_harness_regression_compare(
+    const VkrHarnessSampleStream *baseline,
+    const VkrHarnessSampleStream *candidate,
+    const VkrHarnessRegressionConfig *config, Arena *transient,
+    VkrHarnessRegressionResult *out_result);
+
+const char *
+vkr_harness_regression_verdict_name(VkrHarnessRegressionVerdict verdict);
+
 VkrHarnessComparisonResult vkr_harness_compare_rgba8(
     const uint8_t *actual, const uint8_t *baseline, uint64_t pixel_count,
     const VkrHarnessCompareConfig *config, uint8_t *diff_rgba);
@@ -731,6 +928,46 @@ VkrHarnessComparisonResult vkr_harness_compare_u32_le(const uint8_t *actual,
                                                       const uint8_t *baseline,
                                                       uint64_t pixel_count,
                                                       uint8_t *diff_rgba);
+
+typedef struct VkrHarnessImageCompareDesc {
+  const uint8_t *actual;
+  const uint8_t *baseline;
+  uint32_t width;
+  uint32_t height;
+  const VkrHarnessCompareConfig *config;
+  /** Optional; NULL compares every tile on the calling thread. */
+  VkrJobSystem *job_system;
+  /** Optional `width * height` RGBA8 diff, as the scalar kernels write it. */
+  uint8_t *diff_rgba;
+  /** Optional `tiles_x * tiles_y` RGBA8 FLIP heatmap. */
+  uint8_t *heatmap_rgba;
+  /** Viewing condition for the FLIP filters; 0 selects 67 (a 4K monitor at
+      arm's length). */
+  float64_t pixels_per_degree;
+} VkrHarnessImageCompareDesc;
+
+/**
+ * Tiled, job-parallel equivalent of `vkr_harness_compare_rgba8()`: the same
+ * statistics and verdict, plus PSNR, SSIM, MS-SSIM, and FLIP-style error when
+ * `out_quality` is non-NULL. Results do not depend on the job system or its
+ * worker count.
+ *
+ * Working memory is scoped to `transient`; with perceptual metrics it needs
+ * two float planes per pixel plus a band of filter planes per worker.
+ */
+VkrHarnessComparisonResult
+vkr_harness_compare_image_rgba8(const VkrHarnessImageCompareDesc *desc,
+                                Arena *transient,
+                                VkrHarnessImageQuality *out_quality);
+/** Tiled `vkr_harness_compare_f32_le()`. Depth has no perceptual metrics. */
+VkrHarnessComparisonResult
+vkr_harness_compare_image_f32_le(const VkrHarnessImageCompareDesc *desc,
+                                 Arena *transient);
+void vkr_harness_image_tiles(uint32_t width, uint32_t height,
+                             uint32_t *out_tiles_x, uint32_t *out_tiles_y);
+/** Quality of a capture whose data digest matches its baseline's. */
+void vkr_harness_image_quality_identical(uint32_t width, uint32_t height,
+                                         VkrHarnessImageQuality *out_quality);
 const char *
 vkr_harness_comparison_outcome_name(VkrHarnessComparisonOutcome outcome);
 
@@ -740,6 +977,7 @@ const char *vkr_harness_exit_code_name(VkrHarnessExitCode exit_code);
 const char *vkr_harness_target_name(VkrHarnessTarget target);
 const char *vkr_harness_present_name(VkrHarnessPresentMode present);
 const char *vkr_harness_cache_name(VkrHarnessCacheMode cache);
+const char *vkr_harness_trace_name(VkrHarnessTraceMode trace);
 const char *vkr_harness_boot_name(VkrHarnessBootProfile boot);
 const char *vkr_harness_statistic_name(VkrHarnessStatisticKind statistic);
 const char *vkr_harness_operator_name(VkrHarnessAssertionOperator operation);
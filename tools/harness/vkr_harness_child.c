@@ -10,6 +10,7 @@
 #include "vkr_harness_runtime.h"
 
 #include "application.h"
+#include "core/vkr_trace.h"
 #include "renderer/resources/ui/vkr_ui_text.h"
 #include "renderer/systems/vkr_resource_system.h"
 #include "renderer/systems/vkr_scene_system.h"
@@ -31,6 +32,8 @@ typedef struct VkrHarnessChildContext {
   uint32_t pass_catalog_stable_frames;
   /** Set once bootstrap/allocation frames are discarded and sampling begins. */
   bool8_t phase_started;
+  /** Span trace captured over the sampled frames; NONE when not tracing. */
+  VkrHarnessTraceMode trace;
   bool8_t failed;
   char failure[128];
   uint64_t last_publication;
@@ -281,6 +284,14 @@ static void vkr_harness_child_sample(Application *application) {
                                    ? (float64_t)sample->value.duration.sum_ns /
                                          (float64_t)sample->value.duration.count
                                    : 0.0;
+    } else if (sample->kind == VKR_METRIC_KIND_HISTOGRAM) {
+      /* The per-frame mean, like a duration slot; the harness derives its own
+         percentiles across frames from these samples. */
+      child->samples[offset] =
+          sample->value.histogram.count > 0u
+              ? (float64_t)sample->value.histogram.sum_ns /
+                    (float64_t)sample->value.histogram.count
+              : 0.0;
     } else if (sample->scalar == VKR_METRIC_SCALAR_F64) {
       child->samples[offset] = sample->value.f64;
     } else {
@@ -329,6 +340,11 @@ static void vkr_harness_child_drain_events(Application *application) {
       vkr_metrics_get_catalog(application->metrics, &catalog_count);
   VkrMetricEvent event = {0};
   while (vkr_metrics_event_pop(application->metrics, &event)) {
+    /* Exported percentiles summarize slots that are already sampled per
+       frame; recording them as operations would mix them into load timings. */
+    if (event.percentile_bp != 0u) {
+      continue;
+    }
     if (child->event_count >= VKR_HARNESS_MAX_EVENTS) {
       child->event_storage_dropped++;
       continue;
@@ -560,6 +576,9 @@ void application_update(Application *application, float64_t delta) {
     /* The catalog allocation happened in the preceding bootstrap frame. Drop
        that publication too so a zero-warmup case remains allocation-free. */
     child->phase_started = true_v;
+    if (child->trace != VKR_HARNESS_TRACE_NONE) {
+      vkr_trace_capture_start();
+    }
   }
   if (!vkr_harness_child_resize_round_trip(application)) {
     return;
@@ -1155,6 +1174,8 @@ int vkr_harness_child_run(const char *executable, const char *repo_root,
   VkrSubsystemMask subsystem_mask = 0u;
   VkrHarnessChildContext child = {0};
   Application application = {0};
+  Arena *trace_arena = NULL;
+  VkrAllocator trace_allocator = {0};
   /* Retained by the application for the lifetime of the run, so it must not be
      const-qualified nor go out of scope before shutdown. */
   uint64_t capture_max_batch_bytes = 0u;
@@ -1323,7 +1344,20 @@ int vkr_harness_child_run(const char *executable, const char *repo_root,
       .availability = availability,
       .capture_index = capture_index,
       .run_dir = run_dir,
+      .trace = prewarm ? VKR_HARNESS_TRACE_NONE : profile.trace,
   };
+  if (child.trace != VKR_HARNESS_TRACE_NONE) {
+    const VkrTraceConfig trace_config = vkr_trace_config_default();
+    trace_arena = arena_create(
+        MB(1) + (uint64_t)trace_config.max_threads *
+                    trace_config.records_per_thread * sizeof(VkrTraceRecord));
+    trace_allocator.ctx = trace_arena;
+    if (!trace_arena || !vkr_allocator_arena(&trace_allocator) ||
+        !vkr_trace_init(&trace_allocator, &trace_config)) {
+      vkr_harness_stderr("Unable to allocate the trace buffers\n");
+      goto cleanup;
+    }
+  }
   if (capture_index >= 0) {
     child.capture_report = arena_alloc(
         arenas.persistent, sizeof(VkrHarnessReport), ARENA_MEMORY_TAG_STRUCT);
@@ -1364,6 +1398,30 @@ int vkr_harness_child_run(const char *executable, const char *repo_root,
     application_close(&application);
   }
   vkr_harness_child_drain_events(&application);
+  if (child.trace != VKR_HARNESS_TRACE_NONE) {
+    /* Job workers may still be running; stopping waits out their writes. */
+    vkr_trace_capture_stop();
+    char trace_path[VKR_HARNESS_PATH_MAX];
+    string_format(trace_path, sizeof(trace_path),
+                  child.trace == VKR_HARNESS_TRACE_CHROME
+                      ? "%s/trace.json"
+                      : "%s/trace.perfetto-trace",
+                  run_dir);
+    const VkrTraceStats trace_stats = vkr_trace_get_stats();
+    if (!vkr_trace_export_file(
+            string8_create_from_cstr((const uint8_t *)trace_path,
+                                     string_length(trace_path)),
+            child.trace == VKR_HARNESS_TRACE_CHROME
+                ? VKR_TRACE_FORMAT_CHROME_JSON
+                : VKR_TRACE_FORMAT_PERFETTO)) {
+      vkr_harness_stderr("Unable to write trace %s\n", trace_path);
+    } else if (trace_stats.dropped > 0u) {
+      vkr_harness_stderr("Trace dropped %llu of %llu events\n",
+                         (unsigned long long)trace_stats.dropped,
+                         (unsigned long long)(trace_stats.recorded +
+                                              trace_stats.dropped));
+    }
+  }
   if (child.failed) {
     vkr_harness_stderr("Repetition did not complete: %s\n", child.failure);
   }
@@ -1382,6 +1440,7 @@ int vkr_harness_child_run(const char *executable, const char *repo_root,
   application_shutdown(&application);
   application_live = false_v;
   g_harness_child = NULL;
+  vkr_trace_shutdown();
   if (prewarm) {
     exit_code = child.failed ? VKR_HARNESS_EXIT_ERROR : VKR_HARNESS_EXIT_PASS;
     goto cleanup;
@@ -1469,6 +1528,8 @@ cleanup:
     application_shutdown(&application);
   }
   g_harness_child = NULL;
+  vkr_trace_shutdown();
+  arena_destroy(trace_arena);
   arena_destroy(arenas.transient);
   arena_destroy(arenas.persistent);
   return exit_code;
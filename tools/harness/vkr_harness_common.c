@@ -30,6 +30,10 @@ vkr_harness_renderer_backend_resolve(const VkrHarnessRendererConfig *renderer,
     *out_backend = VKR_RENDERER_BACKEND_TYPE_METAL;
     return true_v;
   }
+  if (string_equals(requested, "null")) {
+    *out_backend = VKR_RENDERER_BACKEND_TYPE_NULL;
+    return true_v;
+  }
   return false_v;
 }
 
@@ -314,6 +318,19 @@ const char *vkr_harness_cache_name(VkrHarnessCacheMode cache) {
   }
 }
 
+const char *vkr_harness_trace_name(VkrHarnessTraceMode trace) {
+  switch (trace) {
+  case VKR_HARNESS_TRACE_NONE:
+    return "none";
+  case VKR_HARNESS_TRACE_CHROME:
+    return "chrome";
+  case VKR_HARNESS_TRACE_PERFETTO:
+    return "perfetto";
+  default:
+    return "unknown";
+  }
+}
+
 const char *vkr_harness_boot_name(VkrHarnessBootProfile boot) {
   switch (boot) {
   case VKR_HARNESS_BOOT_FULL:
@@ -2,157 +2,8 @@
 
 #include <stb_image.h>
 
-static uint32_t vkr_harness_read_u32_le(const uint8_t *bytes) {
-  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8u) |
-         ((uint32_t)bytes[2] << 16u) | ((uint32_t)bytes[3] << 24u);
-}
-
-static VkrHarnessComparisonResult
-vkr_harness_comparison_finish(VkrHarnessComparisonResult result,
-                              const VkrHarnessCompareConfig *config,
-                              bool8_t exact) {
-  result.mean_absolute_error =
-      result.value_count ? result.mean_absolute_error / result.value_count
-                         : 0.0;
-  result.failed_pixel_ratio =
-      result.pixel_count
-          ? (float64_t)result.failing_pixel_count / result.pixel_count
-          : 0.0;
-  const bool8_t pass =
-      exact
-          ? result.failing_value_count == 0u
-          : result.max_absolute_error <= config->max_pixel_delta &&
-                result.mean_absolute_error <= config->max_mean_absolute_error &&
-                result.failed_pixel_ratio <= config->max_failed_pixel_ratio;
-  result.outcome =
-      pass ? VKR_HARNESS_COMPARISON_PASS : VKR_HARNESS_COMPARISON_FAIL;
-  return result;
-}
-
-/** Error magnitude as grey; a pixel over threshold is pushed to red. */
-static void vkr_harness_diff_pixel(uint8_t *diff, uint64_t pixel,
-                                   float64_t error, bool8_t failed) {
-  if (!diff) {
-    return;
-  }
-  const uint8_t value = (uint8_t)(Clamp(error, 0.0, 1.0) * 255.0 + 0.5);
-  diff[pixel * 4u + 0u] = failed ? 255u : value;
-  diff[pixel * 4u + 1u] = value;
-  diff[pixel * 4u + 2u] = value;
-  diff[pixel * 4u + 3u] = 255u;
-}
-
-VkrHarnessComparisonResult vkr_harness_compare_rgba8(
-    const uint8_t *actual, const uint8_t *baseline, uint64_t pixel_count,
-    const VkrHarnessCompareConfig *config, uint8_t *diff_rgba) {
-  VkrHarnessComparisonResult result = {
-      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
-      .value_count = pixel_count * 4u,
-      .pixel_count = pixel_count,
-  };
-  if (!actual || !baseline || !config) {
-    return result;
-  }
-  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
-    bool8_t failed = false_v;
-    float64_t pixel_error = 0.0;
-    for (uint32_t component = 0; component < 4u; ++component) {
-      const uint64_t index = pixel * 4u + component;
-      const float64_t error =
-          vkr_abs_f64((float64_t)actual[index] - baseline[index]) / 255.0;
-      result.mean_absolute_error += error;
-      result.max_absolute_error = Max(result.max_absolute_error, error);
-      pixel_error = Max(pixel_error, error);
-      if (error > config->max_pixel_delta) {
-        result.failing_value_count++;
-        failed = true_v;
-      }
-    }
-    result.failing_pixel_count += failed ? 1u : 0u;
-    vkr_harness_diff_pixel(diff_rgba, pixel, pixel_error, failed);
-  }
-  return vkr_harness_comparison_finish(result, config, false_v);
-}
-
-VkrHarnessComparisonResult vkr_harness_compare_f32_le(
-    const uint8_t *actual, const uint8_t *baseline, uint64_t pixel_count,
-    const VkrHarnessCompareConfig *config, uint8_t *diff_rgba) {
-  VkrHarnessComparisonResult result = {
-      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
-      .value_count = pixel_count,
-      .pixel_count = pixel_count,
-  };
-  if (!actual || !baseline || !config) {
-    return result;
-  }
-  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
-    const uint32_t actual_bits = vkr_harness_read_u32_le(actual + pixel * 4u);
-    const uint32_t baseline_bits =
-        vkr_harness_read_u32_le(baseline + pixel * 4u);
-    float32_t actual_value = 0.0f;
-    float32_t baseline_value = 0.0f;
-    MemCopy(&actual_value, &actual_bits, sizeof(actual_value));
-    MemCopy(&baseline_value, &baseline_bits, sizeof(baseline_value));
-    /* A non-finite sample has no meaningful distance to any baseline, so the
-       whole channel is reported incompatible rather than silently thresholded.
-     */
-    if (!vkr_is_finite_f64(actual_value) ||
-        !vkr_is_finite_f64(baseline_value)) {
-      return result;
-    }
-    const float64_t error =
-        vkr_abs_f64((float64_t)actual_value - baseline_value);
-    result.mean_absolute_error += error;
-    result.max_absolute_error = Max(result.max_absolute_error, error);
-    const bool8_t failed = error > config->max_pixel_delta;
-    result.failing_value_count += failed ? 1u : 0u;
-    result.failing_pixel_count += failed ? 1u : 0u;
-    vkr_harness_diff_pixel(diff_rgba, pixel, error, failed);
-  }
-  return vkr_harness_comparison_finish(result, config, false_v);
-}
-
-VkrHarnessComparisonResult vkr_harness_compare_u32_le(const uint8_t *actual,
-                                                      const uint8_t *baseline,
-                                                      uint64_t pixel_count,
-                                                      uint8_t *diff_rgba) {
-  VkrHarnessComparisonResult result = {
-      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
-      .value_count = pixel_count,
-      .pixel_count = pixel_count,
-  };
-  if (!actual || !baseline) {
-    return result;
-  }
-  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
-    const bool8_t failed = vkr_harness_read_u32_le(actual + pixel * 4u) !=
-                           vkr_harness_read_u32_le(baseline + pixel * 4u);
-    result.failing_value_count += failed ? 1u : 0u;
-    result.failing_pixel_count += failed ? 1u : 0u;
-    result.mean_absolute_error += failed ? 1.0 : 0.0;
-    result.max_absolute_error = failed ? 1.0 : result.max_absolute_error;
-    vkr_harness_diff_pixel(diff_rgba, pixel, failed ? 1.0 : 0.0, failed);
-  }
-  /* Identifiers admit no tolerance, so the verdict comes from the exact path
-     and the thresholds are never consulted. */
-  const VkrHarnessCompareConfig unused_thresholds = {0};
-  return vkr_harness_comparison_finish(result, &unused_thresholds, true_v);
-}
-
-const char *
-vkr_harness_comparison_outcome_name(VkrHarnessComparisonOutcome outcome) {
-  switch (outcome) {
-  case VKR_HARNESS_COMPARISON_PASS:
-    return "pass";
-  case VKR_HARNESS_COMPARISON_FAIL:
-    return "fail";
-  case VKR_HARNESS_COMPARISON_INCOMPATIBLE:
-    return "incompatible";
-  case VKR_HARNESS_COMPARISON_NOT_RUN:
-  default:
-    return "not_run";
-  }
-}
+/** Comparison is memory-bound well before it runs out of cores. */
+#define VKR_HARNESS_COMPARE_MAX_WORKERS 8u
 
 /**
  * Copies one source artifact into the compare run's own root, refusing any
@@ -204,6 +55,18 @@ void vkr_harness_compare_publish_diffs(VkrHarnessReport *report,
                                          "comparison.diff_digest_failed");
       return;
     }
+    const char *heatmap =
+        report->quality ? report->quality[i].heatmap_path : "";
+    if (!heatmap[0]) {
+      continue;
+    }
+    string_format(absolute, sizeof(absolute), "%s/%s", run_root, heatmap);
+    if (!vkr_harness_report_add_artifact(report, "comparison.heatmap", heatmap,
+                                         "image/png", absolute)) {
+      vkr_harness_report_mark_incomplete(report,
+                                         "comparison.diff_digest_failed");
+      return;
+    }
   }
 }
 
@@ -267,9 +130,12 @@ int vkr_harness_compare_run(const char *repo_root, const char *run_path) {
                 "%s", source.policy_fingerprint);
   if (!vkr_harness_create_run_root(artifact_root, report.run_id,
                                    compare_root) ||
-      !vkr_harness_report_init_storage(&report, arena, source.capture_count,
-                                       source.artifact_count +
-                                           source.capture_count + 1u)) {
+      !vkr_harness_report_init_storage(
+          &report, arena, source.capture_count,
+          source.artifact_count +
+              source.capture_count *
+                  VKR_HARNESS_COMPARISON_ARTIFACTS_PER_CAPTURE +
+              1u)) {
     goto cleanup;
   }
   report.capture_count = source.capture_count;
@@ -311,8 +177,9 @@ int vkr_harness_compare_run(const char *repo_root, const char *run_path) {
   } else {
     VkrHarnessArenas arenas = {.persistent = arena, .transient = transient};
     const VkrHarnessExitCode comparison = vkr_harness_compare_capture_sets(
-        compare_root, baseline_root, report.captures, report.capture_count,
-        baseline.captures, baseline.capture_count, &arenas, &error);
+        compare_root, baseline_root, report.captures, report.quality,
+        report.capture_count, baseline.captures, baseline.capture_count,
+        &arenas, &error);
     vkr_harness_report_set_status(
         &report, vkr_harness_exit_code_name(comparison), comparison);
     vkr_harness_compare_publish_diffs(&report, compare_root);
@@ -381,17 +248,36 @@ vkr_harness_capture_file_verified(const char *root, const char *relative,
   return string_equals(digest, expected);
 }
 
-VkrHarnessExitCode vkr_harness_compare_capture_sets(
+/** Writes `rgba` as `<actual_root>/diffs/frame_<n>_<channel><suffix>.png`. */
+static bool8_t vkr_harness_compare_write_image(
+    const char *actual_root, const VkrHarnessCaptureResult *row,
+    const char *suffix, const uint8_t *rgba, uint32_t width, uint32_t height,
+    const VkrHarnessArenas *arenas,
+    char relative[VKR_HARNESS_RELATIVE_PATH_MAX],
+    char sha256[VKR_HARNESS_DIGEST_MAX], VkrHarnessError *error) {
+  char directory[VKR_HARNESS_PATH_MAX];
+  char path[VKR_HARNESS_PATH_MAX];
+  string_format(directory, sizeof(directory), "%s/diffs", actual_root);
+  string_format(relative, VKR_HARNESS_RELATIVE_PATH_MAX,
+                "diffs/frame_%06u_%s%s.png", row->checkpoint_frame,
+                row->channel, suffix);
+  string_format(path, sizeof(path), "%s/%s", actual_root, relative);
+  return vkr_harness_make_directories(directory, error) &&
+         vkr_harness_capture_png_write(path, rgba, width, height, arenas,
+                                       error) &&
+         vkr_harness_sha256_file(path, sha256);
+}
+
+static VkrHarnessExitCode vkr_harness_compare_capture_rows(
     const char *actual_root, const char *baseline_root,
-    VkrHarnessCaptureResult *actual, uint32_t actual_count,
-    const VkrHarnessCaptureResult *baseline, uint32_t baseline_count,
+    VkrHarnessCaptureResult *actual, VkrHarnessImageQuality *quality,
+    uint32_t actual_count, const VkrHarnessCaptureResult *baseline,
+    uint32_t baseline_count, VkrJobSystem *jobs,
     const VkrHarnessArenas *arenas, VkrHarnessError *error) {
-  if (!actual_root || !baseline_root || !actual || !baseline || !arenas) {
-    return VKR_HARNESS_EXIT_ERROR;
-  }
   VkrHarnessExitCode verdict = VKR_HARNESS_EXIT_PASS;
   for (uint32_t i = 0; i < actual_count; ++i) {
     VkrHarnessCaptureResult *row = &actual[i];
+    VkrHarnessImageQuality *row_quality = quality ? &quality[i] : NULL;
     const VkrHarnessCaptureResult *reference =
         vkr_harness_baseline_capture_find(baseline, baseline_count, row);
     if (!vkr_harness_capture_compatible(row, reference)) {
@@ -416,6 +302,25 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
                   "%s", reference->data_path);
     string_format(row->baseline_data_sha256, sizeof(row->baseline_data_sha256),
                   "%s", reference->data_sha256);
+    /* Canonical encodings are deterministic, so equal digests are equal
+       pixels: the published fingerprints settle the comparison undecoded. */
+    if (string_equals(row->data_sha256, reference->data_sha256)) {
+      const uint64_t pixels = (uint64_t)row->width * row->height;
+      const bool8_t color = string_equals(row->value_kind, "color");
+      row->comparison = (VkrHarnessComparisonResult){
+          .outcome = VKR_HARNESS_COMPARISON_PASS,
+          .value_count = color ? pixels * 4u : pixels,
+          .pixel_count = pixels,
+      };
+      string_format(row->comparison_status, sizeof(row->comparison_status),
+                    "%s", vkr_harness_comparison_outcome_name(
+                              row->comparison.outcome));
+      if (row_quality && color) {
+        vkr_harness_image_quality_identical(row->width, row->height,
+                                            row_quality);
+      }
+      continue;
+    }
 
     Scratch scratch = scratch_create(arenas->transient);
     const uint64_t pixels = (uint64_t)row->width * row->height;
@@ -427,6 +332,7 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
       scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
       return VKR_HARNESS_EXIT_ERROR;
     }
+    uint8_t *heatmap = NULL;
     if (string_equals(row->value_kind, "color")) {
       int actual_width = 0, actual_height = 0, actual_channels = 0;
       int baseline_width = 0, baseline_height = 0, baseline_channels = 0;
@@ -460,8 +366,25 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
         verdict = VKR_HARNESS_EXIT_MISSING_BASELINE;
         continue;
       }
-      row->comparison = vkr_harness_compare_rgba8(
-          actual_rgba, baseline_rgba, pixels, &row->thresholds, diff);
+      uint32_t tiles_x = 0u, tiles_y = 0u;
+      vkr_harness_image_tiles(row->width, row->height, &tiles_x, &tiles_y);
+      heatmap = diff && row_quality
+                    ? arena_alloc(arenas->transient,
+                                  (uint64_t)tiles_x * tiles_y * 4u,
+                                  ARENA_MEMORY_TAG_ARRAY)
+                    : NULL;
+      const VkrHarnessImageCompareDesc desc = {
+          .actual = actual_rgba,
+          .baseline = baseline_rgba,
+          .width = row->width,
+          .height = row->height,
+          .config = &row->thresholds,
+          .job_system = jobs,
+          .diff_rgba = diff,
+          .heatmap_rgba = heatmap,
+      };
+      row->comparison = vkr_harness_compare_image_rgba8(
+          &desc, arenas->transient, row_quality);
       stbi_image_free(actual_rgba);
       stbi_image_free(baseline_rgba);
     } else {
@@ -481,10 +404,18 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
         verdict = VKR_HARNESS_EXIT_MISSING_BASELINE;
         continue;
       }
+      const VkrHarnessImageCompareDesc desc = {
+          .actual = actual_bytes,
+          .baseline = baseline_bytes,
+          .width = row->width,
+          .height = row->height,
+          .config = &row->thresholds,
+          .job_system = jobs,
+          .diff_rgba = diff,
+      };
       row->comparison =
           string_equals(row->value_kind, "depth")
-              ? vkr_harness_compare_f32_le(actual_bytes, baseline_bytes, pixels,
-                                           &row->thresholds, diff)
+              ? vkr_harness_compare_image_f32_le(&desc, arenas->transient)
               : vkr_harness_compare_u32_le(actual_bytes, baseline_bytes, pixels,
                                            diff);
     }
@@ -497,18 +428,17 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
       verdict = VKR_HARNESS_EXIT_FAIL;
     }
     if (diff && row->comparison.outcome != VKR_HARNESS_COMPARISON_PASS) {
-      char diff_dir[VKR_HARNESS_PATH_MAX];
-      char diff_path[VKR_HARNESS_PATH_MAX];
-      string_format(diff_dir, sizeof(diff_dir), "%s/diffs", actual_root);
-      string_format(row->diff_path, sizeof(row->diff_path),
-                    "diffs/frame_%06u_%s.png", row->checkpoint_frame,
-                    row->channel);
-      string_format(diff_path, sizeof(diff_path), "%s/%s", actual_root,
-                    row->diff_path);
-      if (!vkr_harness_make_directories(diff_dir, error) ||
-          !vkr_harness_capture_png_write(diff_path, diff, row->width,
-                                         row->height, arenas, error) ||
-          !vkr_harness_sha256_file(diff_path, row->diff_sha256)) {
+      const bool8_t heatmap_measured =
+          heatmap && row_quality && row_quality->measured;
+      if (!vkr_harness_compare_write_image(actual_root, row, "", diff,
+                                           row->width, row->height, arenas,
+                                           row->diff_path, row->diff_sha256,
+                                           error) ||
+          (heatmap_measured &&
+           !vkr_harness_compare_write_image(
+               actual_root, row, ".heatmap", heatmap, row_quality->tiles_x,
+               row_quality->tiles_y, arenas, row_quality->heatmap_path,
+               row_quality->heatmap_sha256, error))) {
         scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
         return VKR_HARNESS_EXIT_ERROR;
       }
@@ -520,3 +450,29 @@ VkrHarnessExitCode vkr_harness_compare_capture_sets(
   }
   return verdict;
 }
+
+VkrHarnessExitCode vkr_harness_compare_capture_sets(
+    const char *actual_root, const char *baseline_root,
+    VkrHarnessCaptureResult *actual, VkrHarnessImageQuality *quality,
+    uint32_t actual_count, const VkrHarnessCaptureResult *baseline,
+    uint32_t baseline_count, const VkrHarnessArenas *arenas,
+    VkrHarnessError *error) {
+  if (!actual_root || !baseline_root || !actual || !baseline || !arenas) {
+    return VKR_HARNESS_EXIT_ERROR;
+  }
+  /* Workers exist only for the comparison. Without any, every tile runs on
+     this thread and the results are the same. */
+  VkrJobSystemConfig config = vkr_job_system_config_default();
+  config.worker_count =
+      Min(config.worker_count, VKR_HARNESS_COMPARE_MAX_WORKERS);
+  VkrJobSystem jobs = {0};
+  const bool8_t parallel =
+      config.worker_count > 0u && vkr_job_system_init(&config, &jobs);
+  const VkrHarnessExitCode verdict = vkr_harness_compare_capture_rows(
+      actual_root, baseline_root, actual, quality, actual_count, baseline,
+      baseline_count, parallel ? &jobs : NULL, arenas, error);
+  if (parallel) {
+    vkr_job_system_shutdown(&jobs);
+  }
+  return verdict;
+}
@@ -173,6 +173,10 @@ bool8_t vkr_harness_case_fingerprints_with_scene_digest(
       vkr_harness_present_name(case_manifest->present),
       case_manifest->target_image_count);
   ADD("instrumentation", "%u,%u", profile->gpu_timing, profile->event_subjects);
+  /* Tracing perturbs timings; untraced profiles keep their fingerprints. */
+  if (profile->trace != VKR_HARNESS_TRACE_NONE) {
+    ADD("instrumentation.trace", "%s", vkr_harness_trace_name(profile->trace));
+  }
   if (tool != VKR_HARNESS_TOOL_PROFILE) {
     for (uint32_t i = 0; i < case_manifest->capture_count; ++i) {
       char name[96];
@@ -0,0 +1,1315 @@
+/**
+ * @file vkr_harness_image_compare.c
+ * @brief Capture comparison kernels: the scalar per-value reference and the
+ *        tiled, job-parallel engine with perceptual metrics.
+ *
+ * An image is cut into bands of one tile row each. A band owns its rows
+ * outright: it reads them plus a filter halo from the source images into its
+ * worker's private planes, so bands run on any worker in any order. Partial
+ * sums are reduced in band order afterwards, which keeps every result
+ * identical whether or not a job system is supplied.
+ *
+ * The scalar kernels stay the definition of the raw error statistics; the
+ * tiled engine must reproduce their verdicts exactly.
+ */
+#include "vkr_harness.h"
+
+#include "math/vkr_simd.h"
+
+/** Pixels per degree of a 0.7 m view of a 0.7 m wide 3840-pixel display. */
+#define VKR_HARNESS_FLIP_DEFAULT_PPD 67.0
+/** Widest filter halo any supported viewing condition is allowed to need. */
+#define VKR_HARNESS_FLIP_MAX_RADIUS 32u
+/** Window rows each MS-SSIM job sums before handing back its partials. */
+#define VKR_HARNESS_SSIM_ROWS_PER_JOB 16u
+#define VKR_HARNESS_SSIM_MAX_SCALES 5u
+/** Squared error units are summed in f32 for this many pixels, then flushed. */
+#define VKR_HARNESS_IMAGE_FLUSH_PIXELS 64u
+
+static uint32_t vkr_harness_read_u32_le(const uint8_t *bytes) {
+  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8u) |
+         ((uint32_t)bytes[2] << 16u) | ((uint32_t)bytes[3] << 24u);
+}
+
+static VkrHarnessComparisonResult
+vkr_harness_comparison_finish(VkrHarnessComparisonResult result,
+                              const VkrHarnessCompareConfig *config,
+                              bool8_t exact) {
+  result.mean_absolute_error =
+      result.value_count ? result.mean_absolute_error / result.value_count
+                         : 0.0;
+  result.failed_pixel_ratio =
+      result.pixel_count
+          ? (float64_t)result.failing_pixel_count / result.pixel_count
+          : 0.0;
+  const bool8_t pass =
+      exact
+          ? result.failing_value_count == 0u
+          : result.max_absolute_error <= config->max_pixel_delta &&
+                result.mean_absolute_error <= config->max_mean_absolute_error &&
+                result.failed_pixel_ratio <= config->max_failed_pixel_ratio;
+  result.outcome =
+      pass ? VKR_HARNESS_COMPARISON_PASS : VKR_HARNESS_COMPARISON_FAIL;
+  return result;
+}
+
+/** Error magnitude as grey; a pixel over threshold is pushed to red. */
+static void vkr_harness_diff_pixel(uint8_t *diff, uint64_t pixel,
+                                   float64_t error, bool8_t failed) {
+  if (!diff) {
+    return;
+  }
+  const uint8_t value = (uint8_t)(Clamp(error, 0.0, 1.0) * 255.0 + 0.5);
+  diff[pixel * 4u + 0u] = failed ? 255u : value;
+  diff[pixel * 4u + 1u] = value;
+  diff[pixel * 4u + 2u] = value;
+  diff[pixel * 4u + 3u] = 255u;
+}
+
+VkrHarnessComparisonResult vkr_harness_compare_rgba8(
+    const uint8_t *actual, const uint8_t *baseline, uint64_t pixel_count,
+    const VkrHarnessCompareConfig *config, uint8_t *diff_rgba) {
+  VkrHarnessComparisonResult result = {
+      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
+      .value_count = pixel_count * 4u,
+      .pixel_count = pixel_count,
+  };
+  if (!actual || !baseline || !config) {
+    return result;
+  }
+  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
+    bool8_t failed = false_v;
+    float64_t pixel_error = 0.0;
+    for (uint32_t component = 0; component < 4u; ++component) {
+      const uint64_t index = pixel * 4u + component;
+      const float64_t error =
+          vkr_abs_f64((float64_t)actual[index] - baseline[index]) / 255.0;
+      result.mean_absolute_error += error;
+      result.max_absolute_error = Max(result.max_absolute_error, error);
+      pixel_error = Max(pixel_error, error);
+      if (error > config->max_pixel_delta) {
+        result.failing_value_count++;
+        failed = true_v;
+      }
+    }
+    result.failing_pixel_count += failed ? 1u : 0u;
+    vkr_harness_diff_pixel(diff_rgba, pixel, pixel_error, failed);
+  }
+  return vkr_harness_comparison_finish(result, config, false_v);
+}
+
+VkrHarnessComparisonResult vkr_harness_compare_f32_le(
+    const uint8_t *actual, const uint8_t *baseline, uint64_t pixel_count,
+    const VkrHarnessCompareConfig *config, uint8_t *diff_rgba) {
+  VkrHarnessComparisonResult result = {
+      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
+      .value_count = pixel_count,
+      .pixel_count = pixel_count,
+  };
+  if (!actual || !baseline || !config) {
+    return result;
+  }
+  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
+    const uint32_t actual_bits = vkr_harness_read_u32_le(actual + pixel * 4u);
+    const uint32_t baseline_bits =
+        vkr_harness_read_u32_le(baseline + pixel * 4u);
+    float32_t actual_value = 0.0f;
+    float32_t baseline_value = 0.0f;
+    MemCopy(&actual_value, &actual_bits, sizeof(actual_value));
+    MemCopy(&baseline_value, &baseline_bits, sizeof(baseline_value));
+    /* A non-finite sample has no meaningful distance to any baseline, so the
+       whole channel is reported incompatible rather than silently thresholded.
+     */
+    if (!vkr_is_finite_f64(actual_value) ||
+        !vkr_is_finite_f64(baseline_value)) {
+      return result;
+    }
+    const float64_t error =
+        vkr_abs_f64((float64_t)actual_value - baseline_value);
+    result.mean_absolute_error += error;
+    result.max_absolute_error = Max(result.max_absolute_error, error);
+    const bool8_t failed = error > config->max_pixel_delta;
+    result.failing_value_count += failed ? 1u : 0u;
+    result.failing_pixel_count += failed ? 1u : 0u;
+    vkr_harness_diff_pixel(diff_rgba, pixel, error, failed);
+  }
+  return vkr_harness_comparison_finish(result, config, false_v);
+}
+
+VkrHarnessComparisonResult vkr_harness_compare_u32_le(const uint8_t *actual,
+                                                      const uint8_t *baseline,
+                                                      uint64_t pixel_count,
+                                                      uint8_t *diff_rgba) {
+  VkrHarnessComparisonResult result = {
+      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
+      .value_count = pixel_count,
+      .pixel_count = pixel_count,
+  };
+  if (!actual || !baseline) {
+    return result;
+  }
+  for (uint64_t pixel = 0; pixel < pixel_count; ++pixel) {
+    const bool8_t failed = vkr_harness_read_u32_le(actual + pixel * 4u) !=
+                           vkr_harness_read_u32_le(baseline + pixel * 4u);
+    result.failing_value_count += failed ? 1u : 0u;
+    result.failing_pixel_count += failed ? 1u : 0u;
+    result.mean_absolute_error += failed ? 1.0 : 0.0;
+    result.max_absolute_error = failed ? 1.0 : result.max_absolute_error;
+    vkr_harness_diff_pixel(diff_rgba, pixel, failed ? 1.0 : 0.0, failed);
+  }
+  /* Identifiers admit no tolerance, so the verdict comes from the exact path
+     and the thresholds are never consulted. */
+  const VkrHarnessCompareConfig unused_thresholds = {0};
+  return vkr_harness_comparison_finish(result, &unused_thresholds, true_v);
+}
+
+const char *
+vkr_harness_comparison_outcome_name(VkrHarnessComparisonOutcome outcome) {
+  switch (outcome) {
+  case VKR_HARNESS_COMPARISON_PASS:
+    return "pass";
+  case VKR_HARNESS_COMPARISON_FAIL:
+    return "fail";
+  case VKR_HARNESS_COMPARISON_INCOMPATIBLE:
+    return "incompatible";
+  case VKR_HARNESS_COMPARISON_NOT_RUN:
+  default:
+    return "not_run";
+  }
+}
+
+typedef enum VkrHarnessImageKind {
+  VKR_HARNESS_IMAGE_RGBA8 = 0,
+  VKR_HARNESS_IMAGE_F32,
+} VkrHarnessImageKind;
+
+/** One band's partial sums; reduced in band order, never shared. */
+typedef struct VkrHarnessImageBand {
+  float64_t absolute_sum;
+  float64_t squared_sum;
+  float64_t max_error;
+  uint64_t failing_values;
+  uint64_t failing_pixels;
+  float64_t flip_sum;
+  float64_t flip_max;
+  bool8_t non_finite;
+} VkrHarnessImageBand;
+
+typedef struct VkrHarnessSsimPartial {
+  float64_t ssim_sum;
+  float64_t cs_sum;
+  uint64_t windows;
+} VkrHarnessSsimPartial;
+
+/**
+ * The CSF and feature filters of FLIP (Andersson et al. 2020), sampled at the
+ * comparison's pixels per degree. Every kernel is `2 * radius + 1` taps wide;
+ * narrower ones are zero-padded so one loop serves them all.
+ */
+typedef struct VkrHarnessFlipFilters {
+  uint32_t radius;
+  float32_t achromatic[2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  float32_t red_green[2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  /* The blue-yellow CSF is a sum of two Gaussians: two separable passes. */
+  float32_t blue_yellow[2][2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  float32_t blue_yellow_weight[2];
+  float32_t feature_gauss[2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  float32_t feature_edge[2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  float32_t feature_point[2u * VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  float32_t color_max;
+} VkrHarnessFlipFilters;
+
+typedef struct VkrHarnessImageState VkrHarnessImageState;
+typedef void (*VkrHarnessImageBandFn)(VkrHarnessImageState *state,
+                                      uint32_t band, uint8_t *scratch);
+
+struct VkrHarnessImageState {
+  const VkrHarnessImageCompareDesc *desc;
+  VkrHarnessImageKind kind;
+  /** Largest per-channel 0..255 delta that still passes `max_pixel_delta`. */
+  float32_t passing_delta;
+  bool8_t perceptual;
+  uint32_t tiles_x;
+  VkrHarnessImageBand *bands;
+  float32_t *tile_flip;
+  float32_t *luma_actual;
+  float32_t *luma_baseline;
+  float32_t srgb_to_linear[256];
+  VkrHarnessFlipFilters flip;
+  /* Per-worker band planes; slot 0 belongs to the calling thread. */
+  uint8_t *scratch;
+  uint64_t scratch_stride;
+  /* The MS-SSIM scale the current dispatch reads. */
+  const float32_t *ssim_actual;
+  const float32_t *ssim_baseline;
+  uint32_t ssim_width;
+  uint32_t ssim_height;
+  uint32_t ssim_window_width;
+  uint32_t ssim_window_height;
+  uint32_t ssim_rows;
+  uint32_t ssim_columns;
+  VkrHarnessSsimPartial *ssim_partials;
+};
+
+typedef struct VkrHarnessImageJob {
+  VkrHarnessImageState *state;
+  VkrHarnessImageBandFn run;
+  uint32_t band;
+} VkrHarnessImageJob;
+
+static bool8_t vkr_harness_image_job_run(VkrJobContext *context,
+                                         void *payload) {
+  const VkrHarnessImageJob *job = payload;
+  VkrHarnessImageState *state = job->state;
+  job->run(state, job->band,
+           state->scratch +
+               (uint64_t)(context->worker_index + 1u) * state->scratch_stride);
+  return true_v;
+}
+
+/**
+ * Runs `run` once per band and returns when all have finished. A band whose
+ * job cannot be submitted runs on the calling thread instead.
+ */
+static bool8_t vkr_harness_image_dispatch(VkrHarnessImageState *state,
+                                          uint32_t count,
+                                          VkrHarnessImageBandFn run,
+                                          Arena *transient) {
+  VkrJobSystem *jobs = state->desc->job_system;
+  if (!jobs || count <= 1u) {
+    for (uint32_t band = 0; band < count; ++band) {
+      run(state, band, state->scratch);
+    }
+    return true_v;
+  }
+  Scratch scratch = scratch_create(transient);
+  VkrJobHandle *handles =
+      arena_alloc(transient, sizeof(*handles) * count, ARENA_MEMORY_TAG_ARRAY);
+  bool8_t *submitted = arena_alloc(transient, sizeof(*submitted) * count,
+                                   ARENA_MEMORY_TAG_ARRAY);
+  if (!handles || !submitted) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+  Bitset8 type_mask = bitset8_create();
+  bitset8_set(&type_mask, VKR_JOB_TYPE_GENERAL);
+  for (uint32_t band = 0; band < count; ++band) {
+    const VkrHarnessImageJob job = {.state = state, .run = run, .band = band};
+    const VkrJobDesc desc = {
+        .priority = VKR_JOB_PRIORITY_NORMAL,
+        .type_mask = type_mask,
+        .run = vkr_harness_image_job_run,
+        .payload = &job,
+        .payload_size = sizeof(job),
+    };
+    submitted[band] = vkr_job_submit(jobs, &desc, &handles[band]);
+    if (!submitted[band]) {
+      run(state, band, state->scratch);
+    }
+  }
+  bool8_t ok = true_v;
+  for (uint32_t band = 0; band < count; ++band) {
+    if (submitted[band] && !vkr_job_wait(jobs, handles[band])) {
+      ok = false_v;
+    }
+  }
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  return ok;
+}
+
+static void vkr_harness_image_band_rows(const VkrHarnessImageState *state,
+                                        uint32_t band, uint32_t *out_first,
+                                        uint32_t *out_end) {
+  *out_first = band * VKR_HARNESS_IMAGE_TILE_SIZE;
+  *out_end =
+      Min(*out_first + VKR_HARNESS_IMAGE_TILE_SIZE, state->desc->height);
+}
+
+/* ========================================================================== */
+/* Raw error                                                                  */
+/* ========================================================================== */
+
+/**
+ * Channel deltas stay integral in f32, so the threshold test is exact. Squared
+ * deltas overflow f32's integer range within a row and are flushed to f64
+ * every VKR_HARNESS_IMAGE_FLUSH_PIXELS pixels.
+ */
+static void vkr_harness_image_raw_rgba8(VkrHarnessImageState *state,
+                                        uint32_t band, uint8_t *scratch) {
+  (void)scratch;
+  const VkrHarnessImageCompareDesc *desc = state->desc;
+  VkrHarnessImageBand *out = &state->bands[band];
+  const VKR_SIMD_F32X4 zero = vkr_simd_set1_f32x4(0.0f);
+  const VKR_SIMD_F32X4 one = vkr_simd_set1_f32x4(1.0f);
+  const VKR_SIMD_F32X4 passing = vkr_simd_set1_f32x4(state->passing_delta);
+  const VKR_SIMD_F32X4 rgb = vkr_simd_set_f32x4(1.0f, 1.0f, 1.0f, 0.0f);
+  const VKR_SIMD_F32X4 luma_weights =
+      vkr_simd_set_f32x4(0.299f, 0.587f, 0.114f, 0.0f);
+  uint32_t first = 0u, end = 0u;
+  vkr_harness_image_band_rows(state, band, &first, &end);
+  for (uint32_t y = first; y < end; ++y) {
+    const uint64_t row = (uint64_t)y * desc->width;
+    VKR_SIMD_F32X4 absolute = zero;
+    VKR_SIMD_F32X4 squared = zero;
+    VKR_SIMD_F32X4 failing = zero;
+    for (uint32_t x = 0; x < desc->width; ++x) {
+      const uint64_t pixel = row + x;
+      const uint8_t *a = desc->actual + pixel * 4u;
+      const uint8_t *b = desc->baseline + pixel * 4u;
+      const VKR_SIMD_F32X4 va = vkr_simd_set_f32x4(a[0], a[1], a[2], a[3]);
+      const VKR_SIMD_F32X4 vb = vkr_simd_set_f32x4(b[0], b[1], b[2], b[3]);
+      const VKR_SIMD_F32X4 delta = vkr_simd_max_f32x4(
+          vkr_simd_sub_f32x4(va, vb), vkr_simd_sub_f32x4(vb, va));
+      /* Deltas and the threshold are integers: one lane per failing value. */
+      const VKR_SIMD_F32X4 over = vkr_simd_min_f32x4(
+          vkr_simd_max_f32x4(vkr_simd_sub_f32x4(delta, passing), zero), one);
+      absolute = vkr_simd_add_f32x4(absolute, delta);
+      squared = vkr_simd_fma_f32x4(squared, vkr_simd_mul_f32x4(delta, rgb),
+                                   delta);
+      failing = vkr_simd_add_f32x4(failing, over);
+      const float32_t pixel_delta =
+          Max(Max(delta.elements[0], delta.elements[1]),
+              Max(delta.elements[2], delta.elements[3]));
+      const bool8_t failed = pixel_delta > state->passing_delta;
+      out->failing_pixels += failed ? 1u : 0u;
+      out->max_error = Max(out->max_error, pixel_delta / 255.0);
+      vkr_harness_diff_pixel(desc->diff_rgba, pixel, pixel_delta / 255.0,
+                             failed);
+      if (state->perceptual) {
+        state->luma_actual[pixel] = vkr_simd_dot3_f32x4(va, luma_weights);
+        state->luma_baseline[pixel] = vkr_simd_dot3_f32x4(vb, luma_weights);
+      }
+      if ((x + 1u) % VKR_HARNESS_IMAGE_FLUSH_PIXELS == 0u ||
+          x + 1u == desc->width) {
+        out->absolute_sum += vkr_simd_hadd_f32x4(absolute) / 255.0;
+        out->squared_sum += vkr_simd_hadd_f32x4(squared);
+        out->failing_values += (uint64_t)vkr_simd_hadd_f32x4(failing);
+        absolute = zero;
+        squared = zero;
+        failing = zero;
+      }
+    }
+  }
+}
+
+static void vkr_harness_image_raw_f32(VkrHarnessImageState *state,
+                                      uint32_t band, uint8_t *scratch) {
+  (void)scratch;
+  const VkrHarnessImageCompareDesc *desc = state->desc;
+  const float64_t max_delta = desc->config->max_pixel_delta;
+  VkrHarnessImageBand *out = &state->bands[band];
+  uint32_t first = 0u, end = 0u;
+  vkr_harness_image_band_rows(state, band, &first, &end);
+  for (uint32_t y = first; y < end; ++y) {
+    const uint64_t row = (uint64_t)y * desc->width;
+    for (uint32_t x = 0; x < desc->width; ++x) {
+      const uint64_t pixel = row + x;
+      const uint32_t actual_bits =
+          vkr_harness_read_u32_le(desc->actual + pixel * 4u);
+      const uint32_t baseline_bits =
+          vkr_harness_read_u32_le(desc->baseline + pixel * 4u);
+      float32_t actual = 0.0f;
+      float32_t baseline = 0.0f;
+      MemCopy(&actual, &actual_bits, sizeof(actual));
+      MemCopy(&baseline, &baseline_bits, sizeof(baseline));
+      if (!vkr_is_finite_f64(actual) || !vkr_is_finite_f64(baseline)) {
+        out->non_finite = true_v;
+        return;
+      }
+      const float64_t error = vkr_abs_f64((float64_t)actual - baseline);
+      const bool8_t failed = error > max_delta;
+      out->absolute_sum += error;
+      out->max_error = Max(out->max_error, error);
+      out->failing_values += failed ? 1u : 0u;
+      out->failing_pixels += failed ? 1u : 0u;
+      vkr_harness_diff_pixel(desc->diff_rgba, pixel, error, failed);
+    }
+  }
+}
+
+/* ========================================================================== */
+/* FLIP-style perceptual error                                                */
+/* ========================================================================== */
+
+/* CIE XYZ of the D65 white FLIP normalizes against. */
+static const float32_t vkr_harness_white[3] = {0.950428545f, 1.0f,
+                                               1.088900371f};
+
+static void vkr_harness_linear_to_xyz(const float32_t rgb[3],
+                                      float32_t xyz[3]) {
+  xyz[0] = 0.4124564f * rgb[0] + 0.3575761f * rgb[1] + 0.1804375f * rgb[2];
+  xyz[1] = 0.2126729f * rgb[0] + 0.7151522f * rgb[1] + 0.0721750f * rgb[2];
+  xyz[2] = 0.0193339f * rgb[0] + 0.1191920f * rgb[1] + 0.9503041f * rgb[2];
+}
+
+static void vkr_harness_xyz_to_linear(const float32_t xyz[3],
+                                      float32_t rgb[3]) {
+  rgb[0] = 3.2404542f * xyz[0] - 1.5371385f * xyz[1] - 0.4985314f * xyz[2];
+  rgb[1] = -0.9692660f * xyz[0] + 1.8760108f * xyz[1] + 0.0415560f * xyz[2];
+  rgb[2] = 0.0556434f * xyz[0] - 0.2040259f * xyz[1] + 1.0572252f * xyz[2];
+}
+
+static float32_t vkr_harness_lab_f(float32_t t) {
+  const float32_t delta = 6.0f / 29.0f;
+  return t > delta * delta * delta
+             ? vkr_pow_f32(t, 1.0f / 3.0f)
+             : t / (3.0f * delta * delta) + 4.0f / 29.0f;
+}
+
+/** Linear RGB to Hunt-adjusted CIELAB, the space FLIP measures HyAB in. */
+static void vkr_harness_linear_to_hunt_lab(const float32_t rgb[3],
+                                           float32_t lab[3]) {
+  float32_t xyz[3];
+  vkr_harness_linear_to_xyz(rgb, xyz);
+  const float32_t fx = vkr_harness_lab_f(xyz[0] / vkr_harness_white[0]);
+  const float32_t fy = vkr_harness_lab_f(xyz[1] / vkr_harness_white[1]);
+  const float32_t fz = vkr_harness_lab_f(xyz[2] / vkr_harness_white[2]);
+  lab[0] = 116.0f * fy - 16.0f;
+  lab[1] = 0.01f * lab[0] * 500.0f * (fx - fy);
+  lab[2] = 0.01f * lab[0] * 200.0f * (fy - fz);
+}
+
+static float32_t vkr_harness_hyab(const float32_t a[3], const float32_t b[3]) {
+  const float32_t da = a[1] - b[1];
+  const float32_t db = a[2] - b[2];
+  return vkr_abs_f32(a[0] - b[0]) + vkr_sqrt_f32(da * da + db * db);
+}
+
+/** Samples `a * sqrt(pi / b) * exp(-pi^2 x^2 / b)` and returns its sum. */
+static float64_t vkr_harness_csf_gaussian(float64_t a, float64_t b,
+                                          float64_t ppd, uint32_t radius,
+                                          float32_t *out) {
+  float64_t sum = 0.0;
+  for (uint32_t i = 0; i <= 2u * radius; ++i) {
+    const float64_t degrees = ((float64_t)i - radius) / ppd;
+    out[i] = (float32_t)vkr_exp_f64(-VKR_PI * VKR_PI * degrees * degrees / b);
+    sum += out[i];
+  }
+  for (uint32_t i = 0; i <= 2u * radius; ++i) {
+    out[i] = (float32_t)(out[i] / sum);
+  }
+  /* The separable kernel's 2D mass is the square of the 1D sum. */
+  return a * vkr_sqrt_f64(VKR_PI / b) * sum * sum;
+}
+
+/** Scales positive and negative taps to sum to +1 and -1 respectively. */
+static void vkr_harness_normalize_signed(float32_t *taps, uint32_t count) {
+  float64_t positive = 0.0;
+  float64_t negative = 0.0;
+  for (uint32_t i = 0; i < count; ++i) {
+    positive += taps[i] > 0.0f ? taps[i] : 0.0f;
+    negative -= taps[i] < 0.0f ? taps[i] : 0.0f;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    if (taps[i] > 0.0f && positive > 0.0) {
+      taps[i] = (float32_t)(taps[i] / positive);
+    } else if (taps[i] < 0.0f && negative > 0.0) {
+      taps[i] = (float32_t)(taps[i] / negative);
+    }
+  }
+}
+
+static void vkr_harness_flip_filters_init(float64_t ppd,
+                                          VkrHarnessFlipFilters *out) {
+  MemZero(out, sizeof(*out));
+  /* Three standard deviations of the widest CSF lobe and of the feature
+     detector, whichever reaches further. */
+  const float64_t csf_sigma = vkr_sqrt_f64(0.04 / (2.0 * VKR_PI * VKR_PI));
+  const float64_t feature_sigma = 0.5 * 0.082 * ppd;
+  const uint32_t radius = (uint32_t)Min(
+      vkr_ceil_f32((float32_t)(3.0 * Max(csf_sigma * ppd, feature_sigma))),
+      (float32_t)VKR_HARNESS_FLIP_MAX_RADIUS);
+  out->radius = Max(radius, 1u);
+  const uint32_t taps = 2u * out->radius + 1u;
+  vkr_harness_csf_gaussian(1.0, 0.0047, ppd, out->radius, out->achromatic);
+  vkr_harness_csf_gaussian(1.0, 0.0053, ppd, out->radius, out->red_green);
+  const float64_t by0 = vkr_harness_csf_gaussian(34.1, 0.04, ppd, out->radius,
+                                                 out->blue_yellow[0]);
+  const float64_t by1 = vkr_harness_csf_gaussian(13.5, 0.025, ppd, out->radius,
+                                                 out->blue_yellow[1]);
+  out->blue_yellow_weight[0] = (float32_t)(by0 / (by0 + by1));
+  out->blue_yellow_weight[1] = (float32_t)(by1 / (by0 + by1));
+
+  float64_t gauss_sum = 0.0;
+  for (uint32_t i = 0; i < taps; ++i) {
+    const float64_t x = (float64_t)i - out->radius;
+    const float64_t g =
+        vkr_exp_f64(-(x * x) / (2.0 * feature_sigma * feature_sigma));
+    out->feature_gauss[i] = (float32_t)g;
+    out->feature_edge[i] = (float32_t)(-x * g);
+    out->feature_point[i] =
+        (float32_t)((x * x / (feature_sigma * feature_sigma) - 1.0) * g);
+    gauss_sum += g;
+  }
+  for (uint32_t i = 0; i < taps; ++i) {
+    out->feature_gauss[i] = (float32_t)(out->feature_gauss[i] / gauss_sum);
+  }
+  vkr_harness_normalize_signed(out->feature_edge, taps);
+  vkr_harness_normalize_signed(out->feature_point, taps);
+
+  const float32_t green[3] = {0.0f, 1.0f, 0.0f};
+  const float32_t blue[3] = {0.0f, 0.0f, 1.0f};
+  float32_t green_lab[3], blue_lab[3];
+  vkr_harness_linear_to_hunt_lab(green, green_lab);
+  vkr_harness_linear_to_hunt_lab(blue, blue_lab);
+  out->color_max = vkr_pow_f32(vkr_harness_hyab(green_lab, blue_lab), 0.7f);
+}
+
+enum {
+  VKR_HARNESS_FLIP_Y = 0,
+  VKR_HARNESS_FLIP_CX,
+  VKR_HARNESS_FLIP_CZ,
+  VKR_HARNESS_FLIP_INPUT_PLANES,
+};
+
+/* Horizontal pass results, one band tall. */
+enum {
+  VKR_HARNESS_FLIP_H_ACHROMATIC = 0,
+  VKR_HARNESS_FLIP_H_RED_GREEN,
+  VKR_HARNESS_FLIP_H_BLUE_YELLOW0,
+  VKR_HARNESS_FLIP_H_BLUE_YELLOW1,
+  VKR_HARNESS_FLIP_H_GAUSS,
+  VKR_HARNESS_FLIP_H_EDGE,
+  VKR_HARNESS_FLIP_H_POINT,
+  VKR_HARNESS_FLIP_FILTERED_PLANES,
+};
+
+/* Vertical pass results, one output row at a time. */
+enum {
+  VKR_HARNESS_FLIP_V_Y = 0,
+  VKR_HARNESS_FLIP_V_CX,
+  VKR_HARNESS_FLIP_V_CZ,
+  VKR_HARNESS_FLIP_V_EDGE_X,
+  VKR_HARNESS_FLIP_V_EDGE_Y,
+  VKR_HARNESS_FLIP_V_POINT_X,
+  VKR_HARNESS_FLIP_V_POINT_Y,
+  VKR_HARNESS_FLIP_OUTPUT_ROWS,
+};
+
+/** Planes one image needs for one band, laid out by vkr_harness_flip_layout. */
+typedef struct VkrHarnessFlipPlanes {
+  float32_t *input[VKR_HARNESS_FLIP_INPUT_PLANES];
+  float32_t *filtered[VKR_HARNESS_FLIP_FILTERED_PLANES];
+  float32_t *output[VKR_HARNESS_FLIP_OUTPUT_ROWS];
+} VkrHarnessFlipPlanes;
+
+/**
+ * Every row is processed at its padded length, a multiple of four columns, so
+ * no pass needs a scalar tail; the padding is filled with clamped edge values
+ * and its results are never read.
+ */
+typedef struct VkrHarnessFlipLayout {
+  uint32_t rows;
+  uint32_t columns;
+  /* Input rows carry `radius` clamped columns on both sides. */
+  uint64_t input_stride;
+  uint64_t image_bytes;
+} VkrHarnessFlipLayout;
+
+static VkrHarnessFlipLayout vkr_harness_flip_layout(uint32_t width,
+                                                    uint32_t radius) {
+  VkrHarnessFlipLayout layout = {
+      .rows = VKR_HARNESS_IMAGE_TILE_SIZE + 2u * radius,
+      .columns = AlignPow2(width, 4u),
+  };
+  layout.input_stride = (uint64_t)layout.columns + 2u * radius;
+  layout.image_bytes =
+      sizeof(float32_t) *
+      (layout.rows * (VKR_HARNESS_FLIP_INPUT_PLANES * layout.input_stride +
+                      VKR_HARNESS_FLIP_FILTERED_PLANES * layout.columns) +
+       VKR_HARNESS_FLIP_OUTPUT_ROWS * layout.columns);
+  return layout;
+}
+
+static VkrHarnessFlipPlanes
+vkr_harness_flip_planes(uint8_t *base, const VkrHarnessFlipLayout *layout) {
+  VkrHarnessFlipPlanes planes;
+  float32_t *cursor = (float32_t *)base;
+  for (uint32_t i = 0; i < VKR_HARNESS_FLIP_INPUT_PLANES; ++i) {
+    planes.input[i] = cursor;
+    cursor += layout->rows * layout->input_stride;
+  }
+  for (uint32_t i = 0; i < VKR_HARNESS_FLIP_FILTERED_PLANES; ++i) {
+    planes.filtered[i] = cursor;
+    cursor += (uint64_t)layout->rows * layout->columns;
+  }
+  for (uint32_t i = 0; i < VKR_HARNESS_FLIP_OUTPUT_ROWS; ++i) {
+    planes.output[i] = cursor;
+    cursor += layout->columns;
+  }
+  return planes;
+}
+
+/**
+ * Converts rows `first - radius .. end + radius` of one image to YCxCz, the
+ * opponent space FLIP filters in, clamping rows and columns at the image edge.
+ */
+static void vkr_harness_flip_convert(const VkrHarnessImageState *state,
+                                     const uint8_t *rgba, uint32_t first,
+                                     const VkrHarnessFlipLayout *layout,
+                                     const VkrHarnessFlipPlanes *planes) {
+  const uint32_t width = state->desc->width;
+  const uint32_t radius = state->flip.radius;
+  const int32_t last_row = (int32_t)state->desc->height - 1;
+  for (uint32_t r = 0; r < layout->rows; ++r) {
+    const int32_t y =
+        Clamp((int32_t)first + (int32_t)r - (int32_t)radius, 0, last_row);
+    const uint8_t *row = rgba + (uint64_t)y * width * 4u;
+    float32_t *out[VKR_HARNESS_FLIP_INPUT_PLANES];
+    for (uint32_t p = 0; p < VKR_HARNESS_FLIP_INPUT_PLANES; ++p) {
+      out[p] = planes->input[p] + r * layout->input_stride;
+    }
+    for (uint32_t x = 0; x < width; ++x) {
+      const float32_t rgb[3] = {state->srgb_to_linear[row[x * 4u + 0u]],
+                                state->srgb_to_linear[row[x * 4u + 1u]],
+                                state->srgb_to_linear[row[x * 4u + 2u]]};
+      float32_t xyz[3];
+      vkr_harness_linear_to_xyz(rgb, xyz);
+      const float32_t yn = xyz[1] / vkr_harness_white[1];
+      out[VKR_HARNESS_FLIP_Y][radius + x] = 116.0f * yn - 16.0f;
+      out[VKR_HARNESS_FLIP_CX][radius + x] =
+          500.0f * (xyz[0] / vkr_harness_white[0] - yn);
+      out[VKR_HARNESS_FLIP_CZ][radius + x] =
+          200.0f * (yn - xyz[2] / vkr_harness_white[2]);
+    }
+    for (uint32_t p = 0; p < VKR_HARNESS_FLIP_INPUT_PLANES; ++p) {
+      for (uint32_t x = 0; x < radius; ++x) {
+        out[p][x] = out[p][radius];
+      }
+      for (uint64_t x = radius + width; x < layout->input_stride; ++x) {
+        out[p][x] = out[p][radius + width - 1u];
+      }
+    }
+  }
+}
+
+/**
+ * One 1D pass over a padded row: `output[x] = scale * sum_j taps[j] *
+ * center[x + (j - radius) * step]`. Every FLIP kernel is symmetric or, for the
+ * edge detector, antisymmetric, so mirrored taps share one multiply.
+ * `accumulate` adds to `output` instead of replacing it.
+ */
+static void vkr_harness_flip_filter(float32_t *output, const float32_t *center,
+                                    uint64_t step, uint32_t columns,
+                                    const float32_t *taps, uint32_t radius,
+                                    float32_t scale, bool8_t antisymmetric,
+                                    bool8_t accumulate) {
+  float32_t weights[VKR_HARNESS_FLIP_MAX_RADIUS + 1u];
+  for (uint32_t k = 0; k <= radius; ++k) {
+    weights[k] = taps[radius + k] * scale;
+  }
+  const VKR_SIMD_F32X4 sign = vkr_simd_set1_f32x4(antisymmetric ? -1.0f : 1.0f);
+  for (uint32_t x = 0; x < columns; x += 4u) {
+    const float32_t *sample = center + x;
+    VKR_SIMD_F32X4 sum = vkr_simd_mul_f32x4(vkr_simd_load_f32x4(sample),
+                                            vkr_simd_set1_f32x4(weights[0]));
+    for (uint32_t k = 1; k <= radius; ++k) {
+      const VKR_SIMD_F32X4 ahead = vkr_simd_load_f32x4(sample + k * step);
+      const VKR_SIMD_F32X4 behind = vkr_simd_load_f32x4(sample - k * step);
+      sum = vkr_simd_fma_f32x4(sum, vkr_simd_fma_f32x4(ahead, behind, sign),
+                               vkr_simd_set1_f32x4(weights[k]));
+    }
+    if (accumulate) {
+      sum = vkr_simd_add_f32x4(sum, vkr_simd_load_f32x4(output + x));
+    }
+    vkr_simd_store_f32x4(output + x, sum);
+  }
+}
+
+static void vkr_harness_flip_filter_rows(const VkrHarnessImageState *state,
+                                         const VkrHarnessFlipLayout *layout,
+                                         const VkrHarnessFlipPlanes *planes) {
+  const VkrHarnessFlipFilters *flip = &state->flip;
+  const uint32_t radius = flip->radius;
+  /* Each filtered plane: which input it reads and with which kernel. */
+  const struct {
+    uint32_t input;
+    const float32_t *kernel;
+    bool8_t antisymmetric;
+  } passes[VKR_HARNESS_FLIP_FILTERED_PLANES] = {
+      {VKR_HARNESS_FLIP_Y, flip->achromatic, false_v},
+      {VKR_HARNESS_FLIP_CX, flip->red_green, false_v},
+      {VKR_HARNESS_FLIP_CZ, flip->blue_yellow[0], false_v},
+      {VKR_HARNESS_FLIP_CZ, flip->blue_yellow[1], false_v},
+      {VKR_HARNESS_FLIP_Y, flip->feature_gauss, false_v},
+      {VKR_HARNESS_FLIP_Y, flip->feature_edge, true_v},
+      {VKR_HARNESS_FLIP_Y, flip->feature_point, false_v},
+  };
+  for (uint32_t p = 0; p < VKR_HARNESS_FLIP_FILTERED_PLANES; ++p) {
+    for (uint32_t r = 0; r < layout->rows; ++r) {
+      vkr_harness_flip_filter(
+          planes->filtered[p] + (uint64_t)r * layout->columns,
+          planes->input[passes[p].input] + r * layout->input_stride + radius,
+          1u, layout->columns, passes[p].kernel, radius, 1.0f,
+          passes[p].antisymmetric, false_v);
+    }
+  }
+}
+
+/**
+ * Vertical pass for band row `r`. The blue-yellow weights and the feature
+ * detectors' 1/116 (they see Y' / 116, FLIP's normalized lightness, whose
+ * +16/116 offset the derivative kernels cancel) are folded into the taps.
+ */
+static void vkr_harness_flip_filter_columns(const VkrHarnessImageState *state,
+                                            const VkrHarnessFlipLayout *layout,
+                                            const VkrHarnessFlipPlanes *planes,
+                                            uint32_t r) {
+  const VkrHarnessFlipFilters *flip = &state->flip;
+  const uint32_t radius = flip->radius;
+  const float32_t feature_scale = 1.0f / 116.0f;
+  const struct {
+    uint32_t filtered;
+    const float32_t *kernel;
+    float32_t scale;
+    bool8_t antisymmetric;
+    uint32_t output;
+  } passes[] = {
+      {VKR_HARNESS_FLIP_H_ACHROMATIC, flip->achromatic, 1.0f, false_v,
+       VKR_HARNESS_FLIP_V_Y},
+      {VKR_HARNESS_FLIP_H_RED_GREEN, flip->red_green, 1.0f, false_v,
+       VKR_HARNESS_FLIP_V_CX},
+      {VKR_HARNESS_FLIP_H_BLUE_YELLOW0, flip->blue_yellow[0],
+       flip->blue_yellow_weight[0], false_v, VKR_HARNESS_FLIP_V_CZ},
+      {VKR_HARNESS_FLIP_H_BLUE_YELLOW1, flip->blue_yellow[1],
+       flip->blue_yellow_weight[1], false_v, VKR_HARNESS_FLIP_V_CZ},
+      {VKR_HARNESS_FLIP_H_EDGE, flip->feature_gauss, feature_scale, false_v,
+       VKR_HARNESS_FLIP_V_EDGE_X},
+      {VKR_HARNESS_FLIP_H_GAUSS, flip->feature_edge, feature_scale, true_v,
+       VKR_HARNESS_FLIP_V_EDGE_Y},
+      {VKR_HARNESS_FLIP_H_POINT, flip->feature_gauss, feature_scale, false_v,
+       VKR_HARNESS_FLIP_V_POINT_X},
+      {VKR_HARNESS_FLIP_H_GAUSS, flip->feature_point, feature_scale, false_v,
+       VKR_HARNESS_FLIP_V_POINT_Y},
+  };
+  for (uint32_t p = 0; p < ArrayCount(passes); ++p) {
+    /* The second blue-yellow lobe lands on the first. */
+    const bool8_t accumulate =
+        p > 0u && passes[p - 1u].output == passes[p].output;
+    vkr_harness_flip_filter(
+        planes->output[passes[p].output],
+        planes->filtered[passes[p].filtered] +
+            (uint64_t)(r + radius) * layout->columns,
+        layout->columns, layout->columns, passes[p].kernel, radius,
+        passes[p].scale, passes[p].antisymmetric, accumulate);
+  }
+}
+
+/** Edge and point feature magnitudes for four pixels of the current row. */
+static void vkr_harness_flip_features(const VkrHarnessFlipPlanes *planes,
+                                      uint32_t x, VKR_SIMD_F32X4 *out_edge,
+                                      VKR_SIMD_F32X4 *out_point) {
+  float32_t *const *row = planes->output;
+  const VKR_SIMD_F32X4 edge_x =
+      vkr_simd_load_f32x4(row[VKR_HARNESS_FLIP_V_EDGE_X] + x);
+  const VKR_SIMD_F32X4 edge_y =
+      vkr_simd_load_f32x4(row[VKR_HARNESS_FLIP_V_EDGE_Y] + x);
+  const VKR_SIMD_F32X4 point_x =
+      vkr_simd_load_f32x4(row[VKR_HARNESS_FLIP_V_POINT_X] + x);
+  const VKR_SIMD_F32X4 point_y =
+      vkr_simd_load_f32x4(row[VKR_HARNESS_FLIP_V_POINT_Y] + x);
+  *out_edge = vkr_simd_sqrt_f32x4(vkr_simd_fma_f32x4(
+      vkr_simd_mul_f32x4(edge_y, edge_y), edge_x, edge_x));
+  *out_point = vkr_simd_sqrt_f32x4(vkr_simd_fma_f32x4(
+      vkr_simd_mul_f32x4(point_y, point_y), point_x, point_x));
+}
+
+/** Filtered YCxCz back to Hunt-adjusted CIELAB, clamped to displayable RGB. */
+static void vkr_harness_flip_lab(float32_t y, float32_t cx, float32_t cz,
+                                 float32_t lab[3]) {
+  const float32_t yn = (y + 16.0f) / 116.0f;
+  const float32_t xyz[3] = {(cx / 500.0f + yn) * vkr_harness_white[0],
+                            yn * vkr_harness_white[1],
+                            (yn - cz / 200.0f) * vkr_harness_white[2]};
+  float32_t rgb[3];
+  vkr_harness_xyz_to_linear(xyz, rgb);
+  for (uint32_t c = 0; c < 3u; ++c) {
+    rgb[c] = Clamp(rgb[c], 0.0f, 1.0f);
+  }
+  vkr_harness_linear_to_hunt_lab(rgb, lab);
+}
+
+/**
+ * FLIP's color error: HyAB^0.7 mapped so differences up to 40% of the largest
+ * (green to blue) cover 95% of the range, then raised by the feature error.
+ */
+static float32_t vkr_harness_flip_error(const VkrHarnessFlipFilters *flip,
+                                        const float32_t actual_lab[3],
+                                        const float32_t baseline_lab[3],
+                                        float32_t feature) {
+  const float32_t color_max = flip->color_max;
+  const float32_t knee = 0.4f * color_max;
+  const float32_t color =
+      vkr_pow_f32(vkr_harness_hyab(actual_lab, baseline_lab), 0.7f);
+  const float32_t mapped =
+      color < knee ? (0.95f / knee) * color
+                   : 0.95f + (color - knee) / (color_max - knee) * 0.05f;
+  return vkr_pow_f32(Min(mapped, 1.0f), 1.0f - feature);
+}
+
+static void vkr_harness_image_flip_band(VkrHarnessImageState *state,
+                                        uint32_t band, uint8_t *scratch) {
+  const VkrHarnessImageCompareDesc *desc = state->desc;
+  const uint32_t width = desc->width;
+  const VkrHarnessFlipLayout layout =
+      vkr_harness_flip_layout(width, state->flip.radius);
+  const VkrHarnessFlipPlanes actual = vkr_harness_flip_planes(scratch, &layout);
+  const VkrHarnessFlipPlanes baseline =
+      vkr_harness_flip_planes(scratch + layout.image_bytes, &layout);
+  uint32_t first = 0u, end = 0u;
+  vkr_harness_image_band_rows(state, band, &first, &end);
+  vkr_harness_flip_convert(state, desc->actual, first, &layout, &actual);
+  vkr_harness_flip_convert(state, desc->baseline, first, &layout, &baseline);
+  vkr_harness_flip_filter_rows(state, &layout, &actual);
+  vkr_harness_flip_filter_rows(state, &layout, &baseline);
+
+  VkrHarnessImageBand *out = &state->bands[band];
+  float32_t *tile_flip = state->tile_flip + (uint64_t)band * state->tiles_x;
+  const float32_t inverse_sqrt2 = 0.70710678f;
+  float32_t *const *a_row = actual.output;
+  float32_t *const *b_row = baseline.output;
+  for (uint32_t y = first; y < end; ++y) {
+    vkr_harness_flip_filter_columns(state, &layout, &actual, y - first);
+    vkr_harness_flip_filter_columns(state, &layout, &baseline, y - first);
+    for (uint32_t x = 0; x < width; x += 4u) {
+      VKR_SIMD_F32X4 a_edge, a_point, b_edge, b_point;
+      vkr_harness_flip_features(&actual, x, &a_edge, &a_point);
+      vkr_harness_flip_features(&baseline, x, &b_edge, &b_point);
+      const uint32_t lanes = Min(4u, width - x);
+      float64_t sum = 0.0;
+      for (uint32_t lane = 0; lane < lanes; ++lane) {
+        const uint32_t column = x + lane;
+        const float32_t edge =
+            vkr_abs_f32(a_edge.elements[lane] - b_edge.elements[lane]);
+        const float32_t point =
+            vkr_abs_f32(a_point.elements[lane] - b_point.elements[lane]);
+        /* Neighborhoods that filter to the same color and features have no
+           error; regressions usually touch a small part of a frame. */
+        if (edge == 0.0f && point == 0.0f &&
+            a_row[VKR_HARNESS_FLIP_V_Y][column] ==
+                b_row[VKR_HARNESS_FLIP_V_Y][column] &&
+            a_row[VKR_HARNESS_FLIP_V_CX][column] ==
+                b_row[VKR_HARNESS_FLIP_V_CX][column] &&
+            a_row[VKR_HARNESS_FLIP_V_CZ][column] ==
+                b_row[VKR_HARNESS_FLIP_V_CZ][column]) {
+          continue;
+        }
+        float32_t a_lab[3], b_lab[3];
+        vkr_harness_flip_lab(a_row[VKR_HARNESS_FLIP_V_Y][column],
+                             a_row[VKR_HARNESS_FLIP_V_CX][column],
+                             a_row[VKR_HARNESS_FLIP_V_CZ][column], a_lab);
+        vkr_harness_flip_lab(b_row[VKR_HARNESS_FLIP_V_Y][column],
+                             b_row[VKR_HARNESS_FLIP_V_CX][column],
+                             b_row[VKR_HARNESS_FLIP_V_CZ][column], b_lab);
+        const float32_t feature =
+            vkr_sqrt_f32(Min(Max(edge, point) * inverse_sqrt2, 1.0f));
+        const float32_t error =
+            vkr_harness_flip_error(&state->flip, a_lab, b_lab, feature);
+        sum += error;
+        out->flip_max = Max(out->flip_max, (float64_t)error);
+      }
+      out->flip_sum += sum;
+      tile_flip[x / VKR_HARNESS_IMAGE_TILE_SIZE] += (float32_t)sum;
+    }
+  }
+}
+
+/* ========================================================================== */
+/* MS-SSIM                                                                    */
+/* ========================================================================== */
+
+/**
+ * One job's share of the windows at the current scale: 8x8 windows on a
+ * 4-pixel stride (a smaller image is one window), on 0..255 luma.
+ */
+static void vkr_harness_image_ssim_rows(VkrHarnessImageState *state,
+                                        uint32_t job, uint8_t *scratch) {
+  (void)scratch;
+  const float64_t c1 = (0.01 * 255.0) * (0.01 * 255.0);
+  const float64_t c2 = (0.03 * 255.0) * (0.03 * 255.0);
+  const uint32_t window_width = state->ssim_window_width;
+  const uint32_t window_height = state->ssim_window_height;
+  const float64_t inverse_area =
+      1.0 / (float64_t)(window_width * window_height);
+  const uint32_t first = job * VKR_HARNESS_SSIM_ROWS_PER_JOB;
+  const uint32_t end =
+      Min(first + VKR_HARNESS_SSIM_ROWS_PER_JOB, state->ssim_rows);
+  VkrHarnessSsimPartial *out = &state->ssim_partials[job];
+  MemZero(out, sizeof(*out));
+  for (uint32_t wy = first; wy < end; ++wy) {
+    for (uint32_t wx = 0; wx < state->ssim_columns; ++wx) {
+      VKR_SIMD_F32X4 sa = vkr_simd_set1_f32x4(0.0f);
+      VKR_SIMD_F32X4 sb = sa, saa = sa, sbb = sa, sab = sa;
+      float32_t ta = 0.0f, tb = 0.0f, taa = 0.0f, tbb = 0.0f, tab = 0.0f;
+      for (uint32_t y = 0; y < window_height; ++y) {
+        const uint64_t row =
+            (uint64_t)(wy * 4u + y) * state->ssim_width + wx * 4u;
+        const float32_t *a = state->ssim_actual + row;
+        const float32_t *b = state->ssim_baseline + row;
+        uint32_t x = 0;
+        for (; x + 4u <= window_width; x += 4u) {
+          const VKR_SIMD_F32X4 va = vkr_simd_load_f32x4(a + x);
+          const VKR_SIMD_F32X4 vb = vkr_simd_load_f32x4(b + x);
+          sa = vkr_simd_add_f32x4(sa, va);
+          sb = vkr_simd_add_f32x4(sb, vb);
+          saa = vkr_simd_fma_f32x4(saa, va, va);
+          sbb = vkr_simd_fma_f32x4(sbb, vb, vb);
+          sab = vkr_simd_fma_f32x4(sab, va, vb);
+        }
+        for (; x < window_width; ++x) {
+          ta += a[x];
+          tb += b[x];
+          taa += a[x] * a[x];
+          tbb += b[x] * b[x];
+          tab += a[x] * b[x];
+        }
+      }
+      /* Window moments in f64: E[x^2] - E[x]^2 cancels badly in f32. */
+      const float64_t mean_a =
+          ((float64_t)vkr_simd_hadd_f32x4(sa) + ta) * inverse_area;
+      const float64_t mean_b =
+          ((float64_t)vkr_simd_hadd_f32x4(sb) + tb) * inverse_area;
+      const float64_t var_a =
+          ((float64_t)vkr_simd_hadd_f32x4(saa) + taa) * inverse_area -
+          mean_a * mean_a;
+      const float64_t var_b =
+          ((float64_t)vkr_simd_hadd_f32x4(sbb) + tbb) * inverse_area -
+          mean_b * mean_b;
+      const float64_t covariance =
+          ((float64_t)vkr_simd_hadd_f32x4(sab) + tab) * inverse_area -
+          mean_a * mean_b;
+      const float64_t luminance = (2.0 * mean_a * mean_b + c1) /
+                                  (mean_a * mean_a + mean_b * mean_b + c1);
+      const float64_t contrast_structure =
+          (2.0 * covariance + c2) / (var_a + var_b + c2);
+      out->ssim_sum += luminance * contrast_structure;
+      out->cs_sum += contrast_structure;
+      out->windows++;
+    }
+  }
+}
+
+static bool8_t vkr_harness_image_ssim_scale(VkrHarnessImageState *state,
+                                            const float32_t *actual,
+                                            const float32_t *baseline,
+                                            uint32_t width, uint32_t height,
+                                            Arena *transient,
+                                            float64_t *out_ssim,
+                                            float64_t *out_cs) {
+  state->ssim_actual = actual;
+  state->ssim_baseline = baseline;
+  state->ssim_width = width;
+  state->ssim_height = height;
+  state->ssim_window_width = Min(width, 8u);
+  state->ssim_window_height = Min(height, 8u);
+  state->ssim_columns = (width - state->ssim_window_width) / 4u + 1u;
+  state->ssim_rows = (height - state->ssim_window_height) / 4u + 1u;
+  const uint32_t jobs =
+      (state->ssim_rows + VKR_HARNESS_SSIM_ROWS_PER_JOB - 1u) /
+      VKR_HARNESS_SSIM_ROWS_PER_JOB;
+  if (!vkr_harness_image_dispatch(state, jobs, vkr_harness_image_ssim_rows,
+                                  transient)) {
+    return false_v;
+  }
+  float64_t ssim = 0.0;
+  float64_t cs = 0.0;
+  uint64_t windows = 0u;
+  for (uint32_t i = 0; i < jobs; ++i) {
+    ssim += state->ssim_partials[i].ssim_sum;
+    cs += state->ssim_partials[i].cs_sum;
+    windows += state->ssim_partials[i].windows;
+  }
+  *out_ssim = windows ? ssim / (float64_t)windows : 1.0;
+  *out_cs = windows ? cs / (float64_t)windows : 1.0;
+  return true_v;
+}
+
+/** 2x2 box reduction; the odd trailing row or column is dropped. */
+static void vkr_harness_image_downsample(const float32_t *input,
+                                         uint32_t width, uint32_t height,
+                                         float32_t *output) {
+  const uint32_t half_width = width / 2u;
+  const uint32_t half_height = height / 2u;
+  for (uint32_t y = 0; y < half_height; ++y) {
+    const float32_t *top = input + (uint64_t)(2u * y) * width;
+    const float32_t *bottom = top + width;
+    float32_t *out = output + (uint64_t)y * half_width;
+    for (uint32_t x = 0; x < half_width; ++x) {
+      out[x] = 0.25f * (top[2u * x] + top[2u * x + 1u] + bottom[2u * x] +
+                        bottom[2u * x + 1u]);
+    }
+  }
+}
+
+/**
+ * Wang et al. 2003: contrast-structure at every scale but the coarsest, full
+ * SSIM at the coarsest. Scales stop once either side would drop below one
+ * window; the remaining weights are renormalized.
+ */
+static bool8_t vkr_harness_image_ms_ssim(VkrHarnessImageState *state,
+                                         Arena *transient,
+                                         VkrHarnessImageQuality *quality) {
+  static const float64_t weights[VKR_HARNESS_SSIM_MAX_SCALES] = {
+      0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+  uint32_t width = state->desc->width;
+  uint32_t height = state->desc->height;
+  uint32_t scales = 1u;
+  while (scales < VKR_HARNESS_SSIM_MAX_SCALES &&
+         (width >> scales) >= 8u && (height >> scales) >= 8u) {
+    scales++;
+  }
+  const uint32_t max_jobs = ((height >= 8u ? (height - 8u) / 4u : 0u) +
+                             VKR_HARNESS_SSIM_ROWS_PER_JOB) /
+                                VKR_HARNESS_SSIM_ROWS_PER_JOB +
+                            1u;
+  state->ssim_partials = arena_alloc(
+      transient, sizeof(*state->ssim_partials) * max_jobs,
+      ARENA_MEMORY_TAG_ARRAY);
+  const uint64_t level_bytes =
+      sizeof(float32_t) * (uint64_t)(width / 2u) * (height / 2u);
+  float32_t *pyramid_actual =
+      scales > 1u ? arena_alloc(transient, level_bytes, ARENA_MEMORY_TAG_ARRAY)
+                  : NULL;
+  float32_t *pyramid_baseline =
+      scales > 1u ? arena_alloc(transient, level_bytes, ARENA_MEMORY_TAG_ARRAY)
+                  : NULL;
+  if (!state->ssim_partials ||
+      (scales > 1u && (!pyramid_actual || !pyramid_baseline))) {
+    return false_v;
+  }
+  float64_t weight_sum = 0.0;
+  for (uint32_t s = 0; s < scales; ++s) {
+    weight_sum += weights[s];
+  }
+  const float32_t *actual = state->luma_actual;
+  const float32_t *baseline = state->luma_baseline;
+  float64_t ms_ssim = 1.0;
+  for (uint32_t s = 0; s < scales; ++s) {
+    float64_t ssim = 0.0;
+    float64_t cs = 0.0;
+    if (!vkr_harness_image_ssim_scale(state, actual, baseline, width, height,
+                                      transient, &ssim, &cs)) {
+      return false_v;
+    }
+    if (s == 0u) {
+      quality->ssim = ssim;
+    }
+    /* A negative mean has no real fractional power; it reads as no
+       similarity at that scale. */
+    const float64_t term = Max(s + 1u == scales ? ssim : cs, 0.0);
+    ms_ssim *= term > 0.0
+                   ? vkr_exp_f64(weights[s] / weight_sum * vkr_log_f64(term))
+                   : 0.0;
+    if (s + 1u < scales) {
+      /* Reducing in place is safe: every output index is below the inputs
+         still to be read. */
+      vkr_harness_image_downsample(actual, width, height, pyramid_actual);
+      vkr_harness_image_downsample(baseline, width, height, pyramid_baseline);
+      actual = pyramid_actual;
+      baseline = pyramid_baseline;
+      width /= 2u;
+      height /= 2u;
+    }
+  }
+  quality->ms_ssim = ms_ssim;
+  return true_v;
+}
+
+/* ========================================================================== */
+/* Entry points                                                               */
+/* ========================================================================== */
+
+void vkr_harness_image_tiles(uint32_t width, uint32_t height,
+                             uint32_t *out_tiles_x, uint32_t *out_tiles_y) {
+  *out_tiles_x =
+      (width + VKR_HARNESS_IMAGE_TILE_SIZE - 1u) / VKR_HARNESS_IMAGE_TILE_SIZE;
+  *out_tiles_y =
+      (height + VKR_HARNESS_IMAGE_TILE_SIZE - 1u) / VKR_HARNESS_IMAGE_TILE_SIZE;
+}
+
+/** Black through red and yellow to white as a tile's mean error rises. */
+static void vkr_harness_heatmap_pixel(uint8_t *out, float32_t error) {
+  const float32_t t = Clamp(error, 0.0f, 1.0f) * 3.0f;
+  out[0] = (uint8_t)(Clamp(t, 0.0f, 1.0f) * 255.0f + 0.5f);
+  out[1] = (uint8_t)(Clamp(t - 1.0f, 0.0f, 1.0f) * 255.0f + 0.5f);
+  out[2] = (uint8_t)(Clamp(t - 2.0f, 0.0f, 1.0f) * 255.0f + 0.5f);
+  out[3] = 255u;
+}
+
+static uint64_t vkr_harness_image_scratch_slots(const VkrJobSystem *jobs) {
+  return jobs ? (uint64_t)jobs->worker_count + 1u : 1u;
+}
+
+static VkrHarnessComparisonResult
+vkr_harness_image_compare(const VkrHarnessImageCompareDesc *desc,
+                          VkrHarnessImageKind kind, Arena *transient,
+                          VkrHarnessImageQuality *out_quality) {
+  const uint64_t pixel_count = desc ? (uint64_t)desc->width * desc->height : 0u;
+  VkrHarnessComparisonResult result = {
+      .outcome = VKR_HARNESS_COMPARISON_INCOMPATIBLE,
+      .value_count = kind == VKR_HARNESS_IMAGE_RGBA8 ? pixel_count * 4u
+                                                     : pixel_count,
+      .pixel_count = pixel_count,
+  };
+  if (!desc || !desc->actual || !desc->baseline || !desc->config ||
+      !transient || pixel_count == 0u) {
+    return result;
+  }
+  Scratch scratch = scratch_create(transient);
+  VkrHarnessImageState state = {
+      .desc = desc,
+      .kind = kind,
+      .perceptual = kind == VKR_HARNESS_IMAGE_RGBA8 && out_quality != NULL,
+  };
+  uint32_t tiles_y = 0u;
+  vkr_harness_image_tiles(desc->width, desc->height, &state.tiles_x, &tiles_y);
+  /* The largest 0..255 delta whose normalized value passes, found exactly as
+     the per-value test would judge it. */
+  for (uint32_t delta = 0; delta <= 255u; ++delta) {
+    if ((float64_t)delta / 255.0 <= desc->config->max_pixel_delta) {
+      state.passing_delta = (float32_t)delta;
+    }
+  }
+  if (desc->config->max_pixel_delta < 0.0) {
+    state.passing_delta = -1.0f;
+  }
+  state.bands = arena_alloc(transient, sizeof(*state.bands) * tiles_y,
+                            ARENA_MEMORY_TAG_ARRAY);
+  bool8_t ok = state.bands != NULL;
+  if (ok) {
+    MemZero(state.bands, sizeof(*state.bands) * tiles_y);
+  }
+  if (ok && state.perceptual) {
+    const float64_t ppd = desc->pixels_per_degree > 0.0
+                              ? desc->pixels_per_degree
+                              : VKR_HARNESS_FLIP_DEFAULT_PPD;
+    vkr_harness_flip_filters_init(ppd, &state.flip);
+    for (uint32_t i = 0; i < 256u; ++i) {
+      const float32_t c = (float32_t)i / 255.0f;
+      state.srgb_to_linear[i] =
+          c <= 0.04045f ? c / 12.92f
+                        : vkr_pow_f32((c + 0.055f) / 1.055f, 2.4f);
+    }
+    const VkrHarnessFlipLayout layout =
+        vkr_harness_flip_layout(desc->width, state.flip.radius);
+    state.scratch_stride = AlignPow2(2u * layout.image_bytes, 64u);
+    state.scratch =
+        arena_alloc(transient,
+                    state.scratch_stride *
+                        vkr_harness_image_scratch_slots(desc->job_system),
+                    ARENA_MEMORY_TAG_ARRAY);
+    state.luma_actual = arena_alloc(transient, sizeof(float32_t) * pixel_count,
+                                    ARENA_MEMORY_TAG_ARRAY);
+    state.luma_baseline = arena_alloc(
+        transient, sizeof(float32_t) * pixel_count, ARENA_MEMORY_TAG_ARRAY);
+    state.tile_flip =
+        arena_alloc(transient, sizeof(float32_t) * state.tiles_x * tiles_y,
+                    ARENA_MEMORY_TAG_ARRAY);
+    ok = state.scratch && state.luma_actual && state.luma_baseline &&
+         state.tile_flip;
+    if (ok) {
+      MemZero(state.tile_flip, sizeof(float32_t) * state.tiles_x * tiles_y);
+    }
+  }
+  ok = ok && vkr_harness_image_dispatch(
+                 &state, tiles_y,
+                 kind == VKR_HARNESS_IMAGE_RGBA8 ? vkr_harness_image_raw_rgba8
+                                                 : vkr_harness_image_raw_f32,
+                 transient);
+  for (uint32_t band = 0; ok && band < tiles_y; ++band) {
+    const VkrHarnessImageBand *partial = &state.bands[band];
+    /* A non-finite sample has no meaningful distance to any baseline, so the
+       whole channel is reported incompatible rather than silently
+       thresholded. */
+    if (partial->non_finite) {
+      ok = false_v;
+      break;
+    }
+    result.mean_absolute_error += partial->absolute_sum;
+    result.max_absolute_error = Max(result.max_absolute_error,
+                                    partial->max_error);
+    result.failing_value_count += partial->failing_values;
+    result.failing_pixel_count += partial->failing_pixels;
+  }
+  if (ok && state.perceptual) {
+    ok = vkr_harness_image_dispatch(&state, tiles_y,
+                                    vkr_harness_image_flip_band, transient) &&
+         vkr_harness_image_ms_ssim(&state, transient, out_quality);
+  }
+  if (ok && state.perceptual) {
+    float64_t squared_sum = 0.0;
+    float64_t flip_sum = 0.0;
+    for (uint32_t band = 0; band < tiles_y; ++band) {
+      squared_sum += state.bands[band].squared_sum;
+      flip_sum += state.bands[band].flip_sum;
+      out_quality->flip_max =
+          Max(out_quality->flip_max, state.bands[band].flip_max);
+    }
+    const float64_t mse = squared_sum / (3.0 * (float64_t)pixel_count);
+    out_quality->measured = true_v;
+    out_quality->psnr_db =
+        mse > 0.0 ? Min(10.0 * vkr_log_f64(255.0 * 255.0 / mse) /
+                            vkr_log_f64(10.0),
+                        VKR_HARNESS_PSNR_MAX_DB)
+                  : VKR_HARNESS_PSNR_MAX_DB;
+    out_quality->flip_mean = flip_sum / (float64_t)pixel_count;
+    out_quality->tiles_x = state.tiles_x;
+    out_quality->tiles_y = tiles_y;
+    for (uint32_t ty = 0; desc->heatmap_rgba && ty < tiles_y; ++ty) {
+      const uint32_t rows =
+          Min(VKR_HARNESS_IMAGE_TILE_SIZE,
+              desc->height - ty * VKR_HARNESS_IMAGE_TILE_SIZE);
+      for (uint32_t tx = 0; tx < state.tiles_x; ++tx) {
+        const uint32_t columns =
+            Min(VKR_HARNESS_IMAGE_TILE_SIZE,
+                desc->width - tx * VKR_HARNESS_IMAGE_TILE_SIZE);
+        const uint64_t tile = (uint64_t)ty * state.tiles_x + tx;
+        vkr_harness_heatmap_pixel(
+            desc->heatmap_rgba + tile * 4u,
+            state.tile_flip[tile] / (float32_t)(rows * columns));
+      }
+    }
+  }
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  if (!ok) {
+    result.mean_absolute_error = 0.0;
+    result.max_absolute_error = 0.0;
+    result.failing_value_count = 0u;
+    result.failing_pixel_count = 0u;
+    if (out_quality) {
+      MemZero(out_quality, sizeof(*out_quality));
+    }
+    return result;
+  }
+  return vkr_harness_comparison_finish(result, desc->config, false_v);
+}
+
+VkrHarnessComparisonResult
+vkr_harness_compare_image_rgba8(const VkrHarnessImageCompareDesc *desc,
+                                Arena *transient,
+                                VkrHarnessImageQuality *out_quality) {
+  if (out_quality) {
+    MemZero(out_quality, sizeof(*out_quality));
+  }
+  return vkr_harness_image_compare(desc, VKR_HARNESS_IMAGE_RGBA8, transient,
+                                   out_quality);
+}
+
+VkrHarnessComparisonResult
+vkr_harness_compare_image_f32_le(const VkrHarnessImageCompareDesc *desc,
+                                 Arena *transient) {
+  return vkr_harness_image_compare(desc, VKR_HARNESS_IMAGE_F32, transient,
+                                   NULL);
+}
+
+void vkr_harness_image_quality_identical(uint32_t width, uint32_t height,
+                                         VkrHarnessImageQuality *out_quality) {
+  MemZero(out_quality, sizeof(*out_quality));
+  out_quality->measured = true_v;
+  out_quality->identical = true_v;
+  out_quality->psnr_db = VKR_HARNESS_PSNR_MAX_DB;
+  out_quality->ssim = 1.0;
+  out_quality->ms_ssim = 1.0;
+  vkr_harness_image_tiles(width, height, &out_quality->tiles_x,
+                          &out_quality->tiles_y);
+}
@@ -99,8 +99,14 @@ int main(int argc, char **argv) {
     if (!vkr_platform_init()) {
       return VKR_HARNESS_EXIT_ERROR;
     }
-    const int result = vkr_harness_compare_run(
-        repo_root, vkr_harness_option(argc, argv, "--run"));
+    const char *run_path = vkr_harness_option(argc, argv, "--run");
+    const char *baseline_run = vkr_harness_option(argc, argv, "--baseline-run");
+    /* A baseline run selects the statistical profile comparison; without one
+       the run is a snapshot judged against its accepted images. */
+    const int result =
+        baseline_run ? vkr_harness_compare_profile_runs(repo_root, run_path,
+                                                        baseline_run)
+                     : vkr_harness_compare_run(repo_root, run_path);
     vkr_platform_shutdown();
     return result;
   }
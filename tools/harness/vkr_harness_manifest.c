@@ -169,6 +169,20 @@ static bool8_t vkr_harness_parse_present(const char *value,
   return true_v;
 }
 
+static bool8_t vkr_harness_parse_trace(const char *value,
+                                       VkrHarnessTraceMode *out) {
+  if (value[0] == '\0' || string_equals(value, "none")) {
+    *out = VKR_HARNESS_TRACE_NONE;
+  } else if (string_equals(value, "chrome")) {
+    *out = VKR_HARNESS_TRACE_CHROME;
+  } else if (string_equals(value, "perfetto")) {
+    *out = VKR_HARNESS_TRACE_PERFETTO;
+  } else {
+    return false_v;
+  }
+  return true_v;
+}
+
 static bool8_t vkr_harness_parse_camera_keys(const VkrHarnessJsonDocument *doc,
                                              int32_t token,
                                              VkrHarnessCamera *camera,
@@ -476,7 +490,8 @@ static bool8_t vkr_harness_parse_renderer(const VkrHarnessJsonDocument *doc,
       string_equals(renderer->render_mode, "material_params");
   const bool8_t backend_valid = renderer->backend[0] == '\0' ||
                                 string_equals(renderer->backend, "vulkan") ||
-                                string_equals(renderer->backend, "metal");
+                                string_equals(renderer->backend, "metal") ||
+                                string_equals(renderer->backend, "null");
   if (!preset_valid || !mode_valid || !backend_valid || cascades < 1u ||
       cascades > 8u) {
     vkr_harness_error_set(
@@ -1050,19 +1065,30 @@ bool8_t vkr_harness_profile_parse(const char *json, uint64_t json_length,
     out_profile->required_process_priority = (int32_t)priority;
     out_profile->has_required_process_priority = true_v;
   }
-  static const char *const instrumentation_fields[] = {"gpu_timing",
-                                                       "event_subjects"};
+  static const char *const instrumentation_fields[] = {
+      "gpu_timing", "event_subjects", "trace"};
+  static const char *const required_instrumentation_fields[] = {
+      "gpu_timing", "event_subjects"};
+  char trace[16] = {0};
   if (!vkr_harness_manifest_field(&doc, 0, "instrumentation", true_v,
                                   &instrumentation, out_error) ||
       !vkr_harness_json_object_validate(
           &doc, instrumentation, instrumentation_fields,
-          ArrayCount(instrumentation_fields), instrumentation_fields,
-          ArrayCount(instrumentation_fields), "$.instrumentation", out_error) ||
+          ArrayCount(instrumentation_fields), required_instrumentation_fields,
+          ArrayCount(required_instrumentation_fields), "$.instrumentation",
+          out_error) ||
       !vkr_harness_manifest_bool(&doc, instrumentation, "gpu_timing", true_v,
                                  &out_profile->gpu_timing, out_error) ||
       !vkr_harness_manifest_bool(&doc, instrumentation, "event_subjects",
                                  true_v, &out_profile->event_subjects,
-                                 out_error)) {
+                                 out_error) ||
+      !vkr_harness_manifest_string(&doc, instrumentation, "trace", false_v,
+                                   trace, sizeof(trace), out_error)) {
+    return false_v;
+  }
+  if (!vkr_harness_parse_trace(trace, &out_profile->trace)) {
+    vkr_harness_error_set(out_error, "profile.trace", "$.instrumentation.trace",
+                          "Unknown trace format '%s'", trace);
     return false_v;
   }
   static const char *const execution_fields[] = {
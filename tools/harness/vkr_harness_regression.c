@@ -0,0 +1,671 @@
+/**
+ * @file vkr_harness_regression.c
+ * @brief Statistical comparison of two metric sample streams.
+ *
+ * Frame-time samples are autocorrelated, heavy-tailed, and start with a
+ * transient, so a mean-and-threshold check flips on noise. Every stream is
+ * first cut to its steady state (MSER), then location is judged with a rank
+ * test on outlier-filtered samples and the tail with a distribution test on
+ * the unfiltered ones. Both need a seeded percentile-bootstrap interval that
+ * excludes zero before a change is called.
+ */
+#include "vkr_harness.h"
+
+/** Largest batch the change-point search takes a median over. */
+#define VKR_HARNESS_CHANGE_POINT_BATCH_MAX 64u
+/** Smallest segment, in batches, either side of a change point may have. */
+#define VKR_HARNESS_CHANGE_POINT_MIN_BATCHES 2u
+/** Family-wise false-alarm rate of one split search. */
+#define VKR_HARNESS_CHANGE_POINT_ALPHA 0.001
+
+typedef struct VkrHarnessRankedSample {
+  float64_t value;
+  bool8_t candidate;
+} VkrHarnessRankedSample;
+
+/** One side of a comparison after warmup trimming. */
+typedef struct VkrHarnessPreparedStream {
+  /** Warmup-trimmed samples, sorted; the tail statistics read these. */
+  float64_t *sorted;
+  uint64_t count;
+  /** `sorted` without outliers; the location statistics read these. */
+  float64_t *filtered;
+  uint64_t filtered_count;
+} VkrHarnessPreparedStream;
+
+static int32_t vkr_harness_regression_compare_f64(const void *a,
+                                                  const void *b) {
+  const float64_t lhs = *(const float64_t *)a;
+  const float64_t rhs = *(const float64_t *)b;
+  return lhs < rhs ? -1 : lhs > rhs ? 1 : 0;
+}
+
+static int32_t vkr_harness_ranked_compare(const void *a, const void *b) {
+  const VkrHarnessRankedSample *lhs = a;
+  const VkrHarnessRankedSample *rhs = b;
+  if (lhs->value != rhs->value) {
+    return lhs->value < rhs->value ? -1 : 1;
+  }
+  return (int32_t)lhs->candidate - (int32_t)rhs->candidate;
+}
+
+static uint64_t vkr_harness_splitmix64(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31u);
+}
+
+/** Zero-based nearest-rank index, matching vkr_harness_statistics_compute. */
+static uint64_t vkr_harness_rank_index(uint64_t count, uint32_t percent) {
+  const uint64_t rank = (count * percent + 99u) / 100u;
+  return rank > 0u ? rank - 1u : 0u;
+}
+
+/** Median of an already sorted array under the same nearest-rank rule. */
+static float64_t vkr_harness_sorted_median(const float64_t *sorted,
+                                           uint64_t count) {
+  return sorted[vkr_harness_rank_index(count, 50u)];
+}
+
+VkrHarnessRegressionConfig vkr_harness_regression_config_default(void) {
+  return (VkrHarnessRegressionConfig){
+      .alpha = 0.01,
+      .confidence = 0.95,
+      .bootstrap_iterations = 2000u,
+      .bootstrap_seed = 0x76b7217e5a0a1f3dull,
+      .min_relative_effect = 0.02,
+      .outlier_limit = 3.5,
+      .warmup_batch_size = 5u,
+      .change_point_batch_size = 16u,
+      .min_samples = 20u,
+      .lower_is_better = true_v,
+  };
+}
+
+uint64_t vkr_harness_warmup_length(const float64_t *samples,
+                                   uint64_t sample_count, uint32_t batch_size) {
+  const uint64_t batch = batch_size > 0u ? batch_size : 1u;
+  const uint64_t batch_count = samples ? sample_count / batch : 0u;
+  if (batch_count < 4u) {
+    return 0u;
+  }
+  /* Batch means are shifted by their overall mean so the running sums below
+     stay well conditioned for nanosecond-scale values. */
+  float64_t shift = 0.0;
+  for (uint64_t i = 0; i < batch_count * batch; ++i) {
+    shift += samples[i];
+  }
+  shift /= (float64_t)(batch_count * batch);
+  float64_t sum = 0.0;
+  float64_t sum_squares = 0.0;
+  float64_t best = 0.0;
+  uint64_t best_batch = 0u;
+  bool8_t have_best = false_v;
+  for (uint64_t d = batch_count; d-- > 0u;) {
+    float64_t mean = 0.0;
+    for (uint64_t i = 0; i < batch; ++i) {
+      mean += samples[d * batch + i];
+    }
+    mean = mean / (float64_t)batch - shift;
+    sum += mean;
+    sum_squares += mean * mean;
+    if (d > batch_count / 2u) {
+      continue;
+    }
+    /* MSER statistic: sum of squared deviations over the squared count. */
+    const float64_t kept = (float64_t)(batch_count - d);
+    const float64_t deviations = sum_squares - sum * sum / kept;
+    const float64_t statistic = Max(deviations, 0.0) / (kept * kept);
+    if (!have_best || statistic <= best) {
+      best = statistic;
+      best_batch = d;
+      have_best = true_v;
+    }
+  }
+  return best_batch * batch;
+}
+
+uint64_t vkr_harness_reject_outliers(float64_t *samples, uint64_t sample_count,
+                                     float64_t limit, float64_t *scratch) {
+  if (!samples || !scratch || sample_count < 3u || !(limit > 0.0)) {
+    return sample_count;
+  }
+  MemCopy(scratch, samples, (size_t)sample_count * sizeof(*scratch));
+  vkr_sort(scratch, sample_count, sizeof(*scratch),
+           vkr_harness_regression_compare_f64);
+  const float64_t median = vkr_harness_sorted_median(scratch, sample_count);
+  for (uint64_t i = 0; i < sample_count; ++i) {
+    scratch[i] = vkr_abs_f64(samples[i] - median);
+  }
+  vkr_sort(scratch, sample_count, sizeof(*scratch),
+           vkr_harness_regression_compare_f64);
+  const float64_t mad = vkr_harness_sorted_median(scratch, sample_count);
+  if (!(mad > 0.0)) {
+    return sample_count;
+  }
+  uint64_t kept = 0u;
+  for (uint64_t i = 0; i < sample_count; ++i) {
+    if (0.6745 * vkr_abs_f64(samples[i] - median) / mad <= limit) {
+      samples[kept++] = samples[i];
+    }
+  }
+  return kept;
+}
+
+uint32_t vkr_harness_change_points(
+    const float64_t *samples, uint64_t sample_count, uint32_t batch_size,
+    float64_t min_relative_effect, Arena *transient,
+    uint64_t out_points[VKR_HARNESS_MAX_CHANGE_POINTS]) {
+  const uint64_t batch =
+      Clamp(batch_size, 1u, VKR_HARNESS_CHANGE_POINT_BATCH_MAX);
+  const uint64_t batch_count = samples ? sample_count / batch : 0u;
+  if (!transient || !out_points ||
+      batch_count < 2u * VKR_HARNESS_CHANGE_POINT_MIN_BATCHES) {
+    return 0u;
+  }
+  Scratch scratch = scratch_create(transient);
+  float64_t *medians = arena_alloc(
+      transient, batch_count * sizeof(*medians), ARENA_MEMORY_TAG_ARRAY);
+  float64_t *work = arena_alloc(transient, batch_count * sizeof(*work),
+                                ARENA_MEMORY_TAG_ARRAY);
+  if (!medians || !work) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return 0u;
+  }
+  /* Batch medians rather than means: one stalled frame moves a mean as far as
+     a real level shift would, but barely moves a median. */
+  float64_t batch_values[VKR_HARNESS_CHANGE_POINT_BATCH_MAX];
+  for (uint64_t i = 0; i < batch_count; ++i) {
+    MemCopy(batch_values, samples + i * batch,
+            (size_t)batch * sizeof(*batch_values));
+    vkr_sort(batch_values, batch, sizeof(*batch_values),
+             vkr_harness_regression_compare_f64);
+    medians[i] = vkr_harness_sorted_median(batch_values, batch);
+  }
+  MemCopy(work, medians, (size_t)batch_count * sizeof(*work));
+  vkr_sort(work, batch_count, sizeof(*work),
+           vkr_harness_regression_compare_f64);
+  const float64_t level =
+      vkr_abs_f64(vkr_harness_sorted_median(work, batch_count));
+  /* Noise from successive differences, which a level shift perturbs only once
+     per change point, so the estimate is not inflated by the shift itself. */
+  for (uint64_t i = 0; i + 1u < batch_count; ++i) {
+    work[i] = vkr_abs_f64(medians[i + 1u] - medians[i]);
+  }
+  vkr_sort(work, batch_count - 1u, sizeof(*work),
+           vkr_harness_regression_compare_f64);
+  const float64_t sigma =
+      1.4826 * vkr_harness_sorted_median(work, batch_count - 1u) /
+      vkr_sqrt_f64(2.0);
+  const float64_t min_shift = min_relative_effect * level;
+
+  uint64_t stack[2u * VKR_HARNESS_MAX_CHANGE_POINTS + 2u];
+  uint32_t stack_count = 0u;
+  uint32_t point_count = 0u;
+  stack[stack_count++] = 0u;
+  stack[stack_count++] = batch_count;
+  while (stack_count > 0u && point_count < VKR_HARNESS_MAX_CHANGE_POINTS) {
+    const uint64_t end = stack[--stack_count];
+    const uint64_t begin = stack[--stack_count];
+    const uint64_t length = end - begin;
+    if (length < 2u * VKR_HARNESS_CHANGE_POINT_MIN_BATCHES) {
+      continue;
+    }
+    float64_t total = 0.0;
+    for (uint64_t i = begin; i < end; ++i) {
+      total += medians[i];
+    }
+    float64_t prefix = 0.0;
+    float64_t best_score = 0.0;
+    float64_t best_shift = 0.0;
+    uint64_t best_split = 0u;
+    for (uint64_t split = begin + 1u; split < end; ++split) {
+      prefix += medians[split - 1u];
+      const uint64_t left = split - begin;
+      const uint64_t right = end - split;
+      if (left < VKR_HARNESS_CHANGE_POINT_MIN_BATCHES ||
+          right < VKR_HARNESS_CHANGE_POINT_MIN_BATCHES) {
+        continue;
+      }
+      const float64_t shift =
+          (total - prefix) / (float64_t)right - prefix / (float64_t)left;
+      const float64_t score =
+          vkr_sqrt_f64((float64_t)left * (float64_t)right / (float64_t)length) *
+          vkr_abs_f64(shift);
+      if (score > best_score) {
+        best_score = score;
+        best_shift = shift;
+        best_split = split;
+      }
+    }
+    /* Bonferroni bound over every split position, from the Gaussian tail
+       P(|Z| > t) < exp(-t^2 / 2). */
+    const float64_t threshold = vkr_sqrt_f64(
+        2.0 * vkr_log_f64((float64_t)(length - 1u) /
+                          VKR_HARNESS_CHANGE_POINT_ALPHA));
+    const bool8_t significant =
+        sigma > 0.0 ? best_score > threshold * sigma : best_shift != 0.0;
+    if (best_split == 0u || !significant ||
+        vkr_abs_f64(best_shift) < min_shift) {
+      continue;
+    }
+    out_points[point_count++] = best_split;
+    if (stack_count + 4u <= ArrayCount(stack)) {
+      stack[stack_count++] = begin;
+      stack[stack_count++] = best_split;
+      stack[stack_count++] = best_split;
+      stack[stack_count++] = end;
+    }
+  }
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  for (uint32_t i = 1; i < point_count; ++i) {
+    const uint64_t point = out_points[i];
+    uint32_t j = i;
+    for (; j > 0u && out_points[j - 1u] > point; --j) {
+      out_points[j] = out_points[j - 1u];
+    }
+    out_points[j] = point;
+  }
+  for (uint32_t i = 0; i < point_count; ++i) {
+    out_points[i] *= batch;
+  }
+  return point_count;
+}
+
+bool8_t vkr_harness_mann_whitney(const float64_t *baseline,
+                                 uint64_t baseline_count,
+                                 const float64_t *candidate,
+                                 uint64_t candidate_count, Arena *transient,
+                                 float64_t *out_u, float64_t *out_z,
+                                 float64_t *out_p) {
+  if (!baseline || !candidate || !transient || !out_u || !out_z || !out_p ||
+      baseline_count == 0u || candidate_count == 0u) {
+    return false_v;
+  }
+  const uint64_t total = baseline_count + candidate_count;
+  Scratch scratch = scratch_create(transient);
+  VkrHarnessRankedSample *ranked = arena_alloc(
+      transient, total * sizeof(*ranked), ARENA_MEMORY_TAG_ARRAY);
+  if (!ranked) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+  for (uint64_t i = 0; i < baseline_count; ++i) {
+    ranked[i] = (VkrHarnessRankedSample){.value = baseline[i]};
+  }
+  for (uint64_t i = 0; i < candidate_count; ++i) {
+    ranked[baseline_count + i] =
+        (VkrHarnessRankedSample){.value = candidate[i], .candidate = true_v};
+  }
+  vkr_sort(ranked, total, sizeof(*ranked), vkr_harness_ranked_compare);
+  float64_t candidate_rank_sum = 0.0;
+  float64_t tie_term = 0.0;
+  for (uint64_t first = 0; first < total;) {
+    uint64_t last = first + 1u;
+    while (last < total && ranked[last].value == ranked[first].value) {
+      ++last;
+    }
+    /* Tied values share the mean of the ranks they span (1-based). */
+    const float64_t rank = ((float64_t)first + (float64_t)last + 1.0) * 0.5;
+    for (uint64_t i = first; i < last; ++i) {
+      candidate_rank_sum += ranked[i].candidate ? rank : 0.0;
+    }
+    const float64_t ties = (float64_t)(last - first);
+    tie_term += ties * ties * ties - ties;
+    first = last;
+  }
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  const float64_t n1 = (float64_t)baseline_count;
+  const float64_t n2 = (float64_t)candidate_count;
+  const float64_t n = (float64_t)total;
+  const float64_t u = candidate_rank_sum - n2 * (n2 + 1.0) * 0.5;
+  const float64_t mean = n1 * n2 * 0.5;
+  const float64_t variance =
+      n > 1.0 ? n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)))
+              : 0.0;
+  *out_u = u;
+  if (!(variance > 0.0)) {
+    *out_z = 0.0;
+    *out_p = 1.0;
+    return true_v;
+  }
+  /* Continuity correction toward the mean. */
+  const float64_t distance = vkr_abs_f64(u - mean);
+  const float64_t corrected = distance > 0.5 ? distance - 0.5 : 0.0;
+  const float64_t z = corrected / vkr_sqrt_f64(variance);
+  *out_z = u >= mean ? z : -z;
+  *out_p = Min(vkr_erfc_f64(z / vkr_sqrt_f64(2.0)), 1.0);
+  return true_v;
+}
+
+void vkr_harness_kolmogorov_smirnov(const float64_t *baseline_sorted,
+                                    uint64_t baseline_count,
+                                    const float64_t *candidate_sorted,
+                                    uint64_t candidate_count,
+                                    float64_t *out_statistic,
+                                    float64_t *out_p) {
+  *out_statistic = 0.0;
+  *out_p = 1.0;
+  if (!baseline_sorted || !candidate_sorted || baseline_count == 0u ||
+      candidate_count == 0u) {
+    return;
+  }
+  uint64_t i = 0u;
+  uint64_t j = 0u;
+  float64_t statistic = 0.0;
+  while (i < baseline_count && j < candidate_count) {
+    const float64_t value = Min(baseline_sorted[i], candidate_sorted[j]);
+    while (i < baseline_count && baseline_sorted[i] == value) {
+      ++i;
+    }
+    while (j < candidate_count && candidate_sorted[j] == value) {
+      ++j;
+    }
+    const float64_t gap =
+        vkr_abs_f64((float64_t)i / (float64_t)baseline_count -
+                    (float64_t)j / (float64_t)candidate_count);
+    statistic = Max(statistic, gap);
+  }
+  const float64_t effective_n = vkr_sqrt_f64(
+      (float64_t)baseline_count * (float64_t)candidate_count /
+      (float64_t)(baseline_count + candidate_count));
+  /* Asymptotic Kolmogorov distribution with Stephens' small-sample
+     correction. */
+  const float64_t lambda =
+      (effective_n + 0.12 + 0.11 / effective_n) * statistic;
+  float64_t p = 0.0;
+  float64_t sign = 1.0;
+  for (uint32_t k = 1; k <= 100u; ++k) {
+    const float64_t term =
+        sign * vkr_exp_f64(-2.0 * (float64_t)k * (float64_t)k * lambda *
+                           lambda);
+    p += term;
+    if (vkr_abs_f64(term) < 1e-10 * vkr_abs_f64(p)) {
+      break;
+    }
+    sign = -sign;
+  }
+  *out_statistic = statistic;
+  *out_p = lambda < 0.2 ? 1.0 : Clamp(2.0 * p, 0.0, 1.0);
+}
+
+/**
+ * Draws a bootstrap resample of `count` sorted values and returns its order
+ * statistic at `rank`. Counting how often each index is drawn and walking the
+ * counts finds the order statistic in O(n) without sorting the resample.
+ */
+static float64_t vkr_harness_bootstrap_order_statistic(const float64_t *sorted,
+                                                       uint64_t count,
+                                                       uint64_t rank,
+                                                       uint32_t *counts,
+                                                       uint64_t *rng) {
+  MemZero(counts, (size_t)count * sizeof(*counts));
+  for (uint64_t i = 0; i < count; ++i) {
+    counts[vkr_harness_splitmix64(rng) % count]++;
+  }
+  uint64_t seen = 0u;
+  for (uint64_t i = 0; i < count; ++i) {
+    seen += counts[i];
+    if (seen > rank) {
+      return sorted[i];
+    }
+  }
+  return sorted[count - 1u];
+}
+
+static VkrHarnessInterval
+vkr_harness_percentile_interval(float64_t estimate, float64_t *draws,
+                                uint32_t draw_count, float64_t confidence) {
+  vkr_sort(draws, draw_count, sizeof(*draws),
+           vkr_harness_regression_compare_f64);
+  const float64_t tail = (1.0 - confidence) * 0.5;
+  const float64_t last = (float64_t)(draw_count - 1u);
+  const uint64_t lower = (uint64_t)vkr_floor_f64(tail * last);
+  const uint64_t upper = (uint64_t)(last - vkr_floor_f64(tail * last));
+  return (VkrHarnessInterval){
+      .estimate = estimate,
+      .lower = draws[lower],
+      .upper = draws[upper],
+  };
+}
+
+/**
+ * Concatenates the steady-state part of every repetition, then sorts it and
+ * builds the outlier-filtered copy. Change points are searched in time order,
+ * before the sort.
+ */
+static bool8_t
+vkr_harness_prepare_stream(const VkrHarnessSampleStream *stream,
+                           const VkrHarnessRegressionConfig *config,
+                           Arena *transient, VkrHarnessPreparedStream *out,
+                           VkrHarnessStreamSummary *summary) {
+  uint64_t total = 0u;
+  for (uint32_t i = 0; i < stream->repetition_count; ++i) {
+    total += stream->repetition_lengths[i];
+  }
+  const uint64_t bytes = Max(total, 1u) * sizeof(float64_t);
+  out->sorted = arena_alloc(transient, bytes, ARENA_MEMORY_TAG_ARRAY);
+  out->filtered = arena_alloc(transient, bytes, ARENA_MEMORY_TAG_ARRAY);
+  float64_t *scratch = arena_alloc(transient, bytes, ARENA_MEMORY_TAG_ARRAY);
+  if (!out->sorted || !out->filtered || !scratch) {
+    return false_v;
+  }
+  const float64_t *source = stream->values;
+  uint64_t count = 0u;
+  for (uint32_t i = 0; i < stream->repetition_count; ++i) {
+    const uint64_t length = stream->repetition_lengths[i];
+    for (uint64_t j = 0; j < length; ++j) {
+      if (!vkr_is_finite_f64(source[j])) {
+        return false_v;
+      }
+    }
+    const uint64_t warmup =
+        vkr_harness_warmup_length(source, length, config->warmup_batch_size);
+    MemCopy(out->sorted + count, source + warmup,
+            (size_t)(length - warmup) * sizeof(float64_t));
+    count += length - warmup;
+    summary->warmup_trimmed += warmup;
+    source += length;
+  }
+  out->count = count;
+  summary->sample_count = count;
+  summary->change_point_count = vkr_harness_change_points(
+      out->sorted, count, config->change_point_batch_size,
+      config->min_relative_effect, transient, summary->change_points);
+  MemCopy(out->filtered, out->sorted, (size_t)count * sizeof(float64_t));
+  out->filtered_count = vkr_harness_reject_outliers(
+      out->filtered, count, config->outlier_limit, scratch);
+  summary->outliers_rejected = count - out->filtered_count;
+  vkr_sort(out->sorted, count, sizeof(float64_t),
+           vkr_harness_regression_compare_f64);
+  vkr_sort(out->filtered, out->filtered_count, sizeof(float64_t),
+           vkr_harness_regression_compare_f64);
+  return true_v;
+}
+
+/** Whether `delta` clears zero on the `direction` side, by `min_effect`. */
+static bool8_t vkr_harness_interval_shifted(const VkrHarnessInterval *delta,
+                                            const VkrHarnessInterval *relative,
+                                            bool8_t relative_defined,
+                                            float64_t direction,
+                                            float64_t min_effect) {
+  const bool8_t clears_zero =
+      direction > 0.0 ? delta->lower > 0.0 : delta->upper < 0.0;
+  return clears_zero &&
+         (!relative_defined || direction * relative->estimate >= min_effect);
+}
+
+bool8_t vkr_harness_regression_compare(
+    const VkrHarnessSampleStream *baseline,
+    const VkrHarnessSampleStream *candidate,
+    const VkrHarnessRegressionConfig *config, Arena *transient,
+    VkrHarnessRegressionResult *out_result) {
+  if (!baseline || !candidate || !config || !transient || !out_result ||
+      (baseline->repetition_count > 0u &&
+       (!baseline->values || !baseline->repetition_lengths)) ||
+      (candidate->repetition_count > 0u &&
+       (!candidate->values || !candidate->repetition_lengths)) ||
+      config->bootstrap_iterations < 2u || !(config->confidence > 0.0) ||
+      !(config->confidence < 1.0)) {
+    return false_v;
+  }
+  MemZero(out_result, sizeof(*out_result));
+  out_result->verdict = VKR_HARNESS_REGRESSION_INCONCLUSIVE;
+  Scratch scratch = scratch_create(transient);
+  VkrHarnessPreparedStream base = {0};
+  VkrHarnessPreparedStream cand = {0};
+  if (!vkr_harness_prepare_stream(baseline, config, transient, &base,
+                                  &out_result->baseline) ||
+      !vkr_harness_prepare_stream(candidate, config, transient, &cand,
+                                  &out_result->candidate)) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+  if (base.filtered_count < Max(config->min_samples, 1u) ||
+      cand.filtered_count < Max(config->min_samples, 1u)) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    out_result->reason = "samples.insufficient";
+    return true_v;
+  }
+
+  const uint64_t base_p50_rank =
+      vkr_harness_rank_index(base.filtered_count, 50u);
+  const uint64_t cand_p50_rank =
+      vkr_harness_rank_index(cand.filtered_count, 50u);
+  const uint64_t base_p95_rank = vkr_harness_rank_index(base.count, 95u);
+  const uint64_t cand_p95_rank = vkr_harness_rank_index(cand.count, 95u);
+  const float64_t base_p50 = base.filtered[base_p50_rank];
+  const float64_t cand_p50 = cand.filtered[cand_p50_rank];
+  const float64_t base_p95 = base.sorted[base_p95_rank];
+  const float64_t cand_p95 = cand.sorted[cand_p95_rank];
+
+  if (!vkr_harness_mann_whitney(base.filtered, base.filtered_count,
+                                cand.filtered, cand.filtered_count, transient,
+                                &out_result->mann_whitney_u,
+                                &out_result->mann_whitney_z,
+                                &out_result->mann_whitney_p)) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+  out_result->cliffs_delta =
+      2.0 * out_result->mann_whitney_u /
+          ((float64_t)base.filtered_count * (float64_t)cand.filtered_count) -
+      1.0;
+  vkr_harness_kolmogorov_smirnov(base.sorted, base.count, cand.sorted,
+                                 cand.count, &out_result->ks_statistic,
+                                 &out_result->ks_p);
+
+  const uint32_t iterations = config->bootstrap_iterations;
+  const uint64_t largest = Max(base.count, cand.count);
+  uint32_t *counts = arena_alloc(transient, largest * sizeof(*counts),
+                                 ARENA_MEMORY_TAG_ARRAY);
+  float64_t *draws = arena_alloc(
+      transient, 6u * (uint64_t)iterations * sizeof(*draws),
+      ARENA_MEMORY_TAG_ARRAY);
+  if (!counts || !draws) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    return false_v;
+  }
+  float64_t *base_p50_draws = draws;
+  float64_t *cand_p50_draws = draws + iterations;
+  float64_t *base_p95_draws = draws + 2u * iterations;
+  float64_t *cand_p95_draws = draws + 3u * iterations;
+  float64_t *p50_delta_draws = draws + 4u * iterations;
+  float64_t *p95_delta_draws = draws + 5u * iterations;
+  uint64_t rng = config->bootstrap_seed;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    base_p50_draws[i] = vkr_harness_bootstrap_order_statistic(
+        base.filtered, base.filtered_count, base_p50_rank, counts, &rng);
+    cand_p50_draws[i] = vkr_harness_bootstrap_order_statistic(
+        cand.filtered, cand.filtered_count, cand_p50_rank, counts, &rng);
+    base_p95_draws[i] = vkr_harness_bootstrap_order_statistic(
+        base.sorted, base.count, base_p95_rank, counts, &rng);
+    cand_p95_draws[i] = vkr_harness_bootstrap_order_statistic(
+        cand.sorted, cand.count, cand_p95_rank, counts, &rng);
+    p50_delta_draws[i] = cand_p50_draws[i] - base_p50_draws[i];
+    p95_delta_draws[i] = cand_p95_draws[i] - base_p95_draws[i];
+  }
+  const float64_t confidence = config->confidence;
+  out_result->baseline.p50 = vkr_harness_percentile_interval(
+      base_p50, base_p50_draws, iterations, confidence);
+  out_result->candidate.p50 = vkr_harness_percentile_interval(
+      cand_p50, cand_p50_draws, iterations, confidence);
+  out_result->baseline.p95 = vkr_harness_percentile_interval(
+      base_p95, base_p95_draws, iterations, confidence);
+  out_result->candidate.p95 = vkr_harness_percentile_interval(
+      cand_p95, cand_p95_draws, iterations, confidence);
+  out_result->p50_delta = vkr_harness_percentile_interval(
+      cand_p50 - base_p50, p50_delta_draws, iterations, confidence);
+  out_result->p95_delta = vkr_harness_percentile_interval(
+      cand_p95 - base_p95, p95_delta_draws, iterations, confidence);
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+
+  /* Relative effects are scaled by the baseline point estimate; a zero
+     baseline has no relative scale and is judged on the absolute interval. */
+  out_result->relative_defined = base_p50 != 0.0 && base_p95 != 0.0;
+  if (out_result->relative_defined) {
+    const float64_t p50_scale = 1.0 / vkr_abs_f64(base_p50);
+    const float64_t p95_scale = 1.0 / vkr_abs_f64(base_p95);
+    out_result->p50_relative = (VkrHarnessInterval){
+        .estimate = out_result->p50_delta.estimate * p50_scale,
+        .lower = out_result->p50_delta.lower * p50_scale,
+        .upper = out_result->p50_delta.upper * p50_scale,
+    };
+    out_result->p95_relative = (VkrHarnessInterval){
+        .estimate = out_result->p95_delta.estimate * p95_scale,
+        .lower = out_result->p95_delta.lower * p95_scale,
+        .upper = out_result->p95_delta.upper * p95_scale,
+    };
+  }
+
+  if (out_result->baseline.change_point_count > 0u ||
+      out_result->candidate.change_point_count > 0u) {
+    out_result->reason = "stream.change_point";
+    return true_v;
+  }
+  const float64_t alpha = config->alpha;
+  const float64_t min_effect = config->min_relative_effect;
+  const bool8_t location = out_result->mann_whitney_p < alpha;
+  const bool8_t tail = out_result->ks_p < alpha;
+  /* +1 is the direction in which the metric gets worse. */
+  const float64_t worse = config->lower_is_better ? 1.0 : -1.0;
+  const bool8_t relative = out_result->relative_defined;
+  if (location && vkr_harness_interval_shifted(
+                      &out_result->p50_delta, &out_result->p50_relative,
+                      relative, worse, min_effect)) {
+    out_result->verdict = VKR_HARNESS_REGRESSION_REGRESSED;
+    out_result->reason = "p50";
+  } else if (tail && vkr_harness_interval_shifted(
+                         &out_result->p95_delta, &out_result->p95_relative,
+                         relative, worse, min_effect)) {
+    out_result->verdict = VKR_HARNESS_REGRESSION_REGRESSED;
+    out_result->reason = "p95";
+  } else if (location && vkr_harness_interval_shifted(
+                             &out_result->p50_delta, &out_result->p50_relative,
+                             relative, -worse, min_effect)) {
+    out_result->verdict = VKR_HARNESS_REGRESSION_IMPROVED;
+    out_result->reason = "p50";
+  } else if (tail && vkr_harness_interval_shifted(
+                         &out_result->p95_delta, &out_result->p95_relative,
+                         relative, -worse, min_effect)) {
+    out_result->verdict = VKR_HARNESS_REGRESSION_IMPROVED;
+    out_result->reason = "p95";
+  } else {
+    out_result->reason = "not_significant";
+  }
+  return true_v;
+}
+
+const char *
+vkr_harness_regression_verdict_name(VkrHarnessRegressionVerdict verdict) {
+  switch (verdict) {
+  case VKR_HARNESS_REGRESSION_IMPROVED:
+    return "improved";
+  case VKR_HARNESS_REGRESSION_REGRESSED:
+    return "regressed";
+  case VKR_HARNESS_REGRESSION_INCONCLUSIVE:
+  default:
+    return "inconclusive";
+  }
+}
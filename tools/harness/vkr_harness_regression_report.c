@@ -0,0 +1,642 @@
+/**
+ * @file vkr_harness_regression_report.c
+ * @brief `compare --run <profile run> --baseline-run <profile run>`.
+ *
+ * Reads every repetition's raw samples from both runs, judges each metric and
+ * pass timing with `vkr_harness_regression_compare()`, and publishes one
+ * `regression.json`. Raw samples are read rather than report aggregates
+ * because every test needs the per-frame distribution, not its summary.
+ */
+#include "vkr_harness_runtime.h"
+
+typedef enum VkrHarnessMetricDirection {
+  VKR_HARNESS_DIRECTION_NONE = 0,
+  VKR_HARNESS_DIRECTION_LOWER_IS_BETTER,
+  VKR_HARNESS_DIRECTION_HIGHER_IS_BETTER,
+} VkrHarnessMetricDirection;
+
+/** Every repetition of one published profile run. */
+typedef struct VkrHarnessProfileRun {
+  char root[VKR_HARNESS_PATH_MAX];
+  VkrHarnessRunReference identity;
+  VkrHarnessSampleSet runs[VKR_HARNESS_MAX_RUNS];
+  uint32_t run_count;
+} VkrHarnessProfileRun;
+
+typedef struct VkrHarnessRegressionEntry {
+  char name[160];
+  char unit[24];
+  VkrHarnessMetricDirection direction;
+  uint64_t baseline_invalid;
+  uint64_t candidate_invalid;
+  VkrHarnessRegressionResult result;
+} VkrHarnessRegressionEntry;
+
+typedef struct VkrHarnessRegressionDocument {
+  char run_id[64];
+  const char *baseline_run;
+  const char *candidate_run;
+  const VkrHarnessProfileRun *baseline;
+  const VkrHarnessProfileRun *candidate;
+  VkrHarnessRegressionConfig config;
+  VkrHarnessRegressionVerdict verdict;
+  VkrHarnessExitCode exit_code;
+  VkrHarnessRegressionEntry *entries;
+  uint32_t entry_count;
+  char (*unmatched)[160];
+  uint32_t unmatched_count;
+} VkrHarnessRegressionDocument;
+
+/**
+ * Costs — time, memory, work — regress upward and rates regress downward.
+ * Ratios and percentages have no fixed sense, so they are measured but never
+ * called regressed or improved.
+ */
+static VkrHarnessMetricDirection
+vkr_harness_metric_direction(const char *unit) {
+  if (string_equals(unit, "ns") || string_equals(unit, "ms") ||
+      string_equals(unit, "cycles") || string_equals(unit, "bytes") ||
+      string_equals(unit, "count")) {
+    return VKR_HARNESS_DIRECTION_LOWER_IS_BETTER;
+  }
+  if (string_equals(unit, "count_per_second")) {
+    return VKR_HARNESS_DIRECTION_HIGHER_IS_BETTER;
+  }
+  return VKR_HARNESS_DIRECTION_NONE;
+}
+
+static const char *
+vkr_harness_metric_direction_name(VkrHarnessMetricDirection direction) {
+  switch (direction) {
+  case VKR_HARNESS_DIRECTION_LOWER_IS_BETTER:
+    return "lower_is_better";
+  case VKR_HARNESS_DIRECTION_HIGHER_IS_BETTER:
+    return "higher_is_better";
+  case VKR_HARNESS_DIRECTION_NONE:
+  default:
+    return "none";
+  }
+}
+
+/** Repetitions of one run must describe the same series over the same frames.
+ */
+static bool8_t vkr_harness_sample_layouts_match(const VkrHarnessSampleSet *a,
+                                                const VkrHarnessSampleSet *b) {
+  if (a->header.warmup_frames != b->header.warmup_frames ||
+      a->header.measure_frames != b->header.measure_frames ||
+      a->header.metric_count != b->header.metric_count ||
+      a->header.pass_count != b->header.pass_count) {
+    return false_v;
+  }
+  for (uint32_t i = 0; i < a->header.metric_count; ++i) {
+    if (!string_equals(a->metrics[i].name, b->metrics[i].name) ||
+        !string_equals(a->metrics[i].unit, b->metrics[i].unit)) {
+      return false_v;
+    }
+  }
+  for (uint32_t i = 0; i < a->header.pass_count; ++i) {
+    if (!string_equals(a->passes[i].name, b->passes[i].name)) {
+      return false_v;
+    }
+  }
+  return true_v;
+}
+
+static bool8_t vkr_harness_profile_run_load(const char *repo_root,
+                                            const char *relative,
+                                            const VkrHarnessArenas *arenas,
+                                            VkrHarnessProfileRun *out_run,
+                                            VkrHarnessError *error) {
+  char profile_root[VKR_HARNESS_PATH_MAX];
+  string_format(profile_root, sizeof(profile_root), "%s/%s", repo_root,
+                VKR_HARNESS_ARTIFACT_ROOT);
+  if (!relative || !vkr_harness_path_is_safe_relative(relative) ||
+      string_format(out_run->root, sizeof(out_run->root), "%s/%s", repo_root,
+                    relative) <= 0) {
+    vkr_harness_error_set(error, "compare.run_path", "$",
+                          "Run path must be repository-relative");
+    return false_v;
+  }
+  vkr_harness_path_to_run_root(out_run->root);
+  if (!vkr_harness_existing_path_is_below(profile_root, out_run->root)) {
+    vkr_harness_error_set(error, "compare.run_path", relative,
+                          "'%s' does not name a profile run", relative);
+    return false_v;
+  }
+  char report_path[VKR_HARNESS_PATH_MAX];
+  string_format(report_path, sizeof(report_path), "%s/report.json",
+                out_run->root);
+  if (!vkr_harness_report_read_fingerprints(report_path, arenas->transient,
+                                            &out_run->identity)) {
+    vkr_harness_error_set(error, "compare.report", relative,
+                          "'%s' has no readable report", relative);
+    return false_v;
+  }
+  for (uint32_t i = 0; i < VKR_HARNESS_MAX_RUNS; ++i) {
+    char samples_path[VKR_HARNESS_PATH_MAX];
+    string_format(samples_path, sizeof(samples_path), "%s/runs/%u/samples.bin",
+                  out_run->root, i);
+    FilePath path = vkr_harness_file_path(samples_path);
+    if (!file_exists(&path)) {
+      break;
+    }
+    VkrHarnessSampleSet *samples = &out_run->runs[out_run->run_count];
+    if (!vkr_harness_samples_read(samples_path, NULL, arenas->persistent,
+                                  samples) ||
+        (samples->header.flags & VKR_HARNESS_SAMPLE_FLAG_CHILD_FAILED) != 0u) {
+      vkr_harness_error_set(error, "compare.samples", relative,
+                            "Repetition %u of '%s' has no usable samples", i,
+                            relative);
+      return false_v;
+    }
+    if (out_run->run_count > 0u &&
+        !vkr_harness_sample_layouts_match(&out_run->runs[0], samples)) {
+      vkr_harness_error_set(error, "compare.samples", relative,
+                            "Repetitions of '%s' disagree on their samples",
+                            relative);
+      return false_v;
+    }
+    out_run->run_count++;
+  }
+  if (out_run->run_count == 0u) {
+    vkr_harness_error_set(error, "compare.samples", relative,
+                          "'%s' has no repetition samples", relative);
+    return false_v;
+  }
+  return true_v;
+}
+
+/**
+ * Gathers the measured, valid samples of one series from every repetition.
+ * `pass_series` is 0 for metric `column`, otherwise 1 for a pass's CPU and 2
+ * for its GPU timing.
+ */
+static VkrHarnessSampleStream
+vkr_harness_gather_series(const VkrHarnessProfileRun *run, uint32_t column,
+                          uint32_t pass_series, float64_t *values,
+                          uint64_t lengths[VKR_HARNESS_MAX_RUNS],
+                          uint64_t *out_invalid) {
+  uint64_t count = 0u;
+  *out_invalid = 0u;
+  for (uint32_t r = 0; r < run->run_count; ++r) {
+    const VkrHarnessSampleSet *samples = &run->runs[r];
+    const uint32_t warmup = samples->header.warmup_frames;
+    const uint32_t measured = samples->header.measure_frames;
+    const uint64_t stride = pass_series == 0u ? samples->header.metric_count
+                                              : samples->header.pass_count;
+    const uint64_t first = count;
+    for (uint32_t frame = warmup; frame < warmup + measured; ++frame) {
+      const uint64_t offset = (uint64_t)frame * stride + column;
+      bool8_t valid = false_v;
+      float64_t value = 0.0;
+      if (pass_series == 0u) {
+        valid = samples->availability[offset] == VKR_METRIC_AVAILABILITY_VALID;
+        value = samples->values[offset];
+      } else {
+        const uint8_t flag = pass_series == 1u
+                                 ? VKR_HARNESS_PASS_FLAG_CPU_VALID
+                                 : VKR_HARNESS_PASS_FLAG_GPU_VALID;
+        valid = (samples->pass_flags[offset] & flag) != 0u;
+        value = pass_series == 1u ? samples->pass_cpu_ms[offset]
+                                  : samples->pass_gpu_ms[offset];
+      }
+      if (valid) {
+        values[count++] = value;
+      } else {
+        (*out_invalid)++;
+      }
+    }
+    lengths[r] = count - first;
+  }
+  return (VkrHarnessSampleStream){
+      .values = values,
+      .repetition_lengths = lengths,
+      .repetition_count = run->run_count,
+  };
+}
+
+static int32_t vkr_harness_find_metric(const VkrHarnessSampleSet *samples,
+                                       const VkrHarnessSampleMetric *metric) {
+  for (uint32_t i = 0; i < samples->header.metric_count; ++i) {
+    if (string_equals(samples->metrics[i].name, metric->name) &&
+        string_equals(samples->metrics[i].unit, metric->unit)) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+static int32_t vkr_harness_find_pass(const VkrHarnessSampleSet *samples,
+                                     const char *name) {
+  for (uint32_t i = 0; i < samples->header.pass_count; ++i) {
+    if (string_equals(samples->passes[i].name, name)) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+/** Compares one series into the next entry and folds it into the verdict. */
+static bool8_t vkr_harness_regression_add(
+    VkrHarnessRegressionDocument *document, const char *name,
+    const char *unit, uint32_t baseline_column, uint32_t candidate_column,
+    uint32_t pass_series, float64_t *baseline_values,
+    float64_t *candidate_values, Arena *transient, VkrHarnessError *error) {
+  VkrHarnessRegressionEntry *entry =
+      &document->entries[document->entry_count++];
+  string_format(entry->name, sizeof(entry->name), "%s", name);
+  string_format(entry->unit, sizeof(entry->unit), "%s", unit);
+  entry->direction = vkr_harness_metric_direction(unit);
+  uint64_t baseline_lengths[VKR_HARNESS_MAX_RUNS];
+  uint64_t candidate_lengths[VKR_HARNESS_MAX_RUNS];
+  const VkrHarnessSampleStream baseline = vkr_harness_gather_series(
+      document->baseline, baseline_column, pass_series, baseline_values,
+      baseline_lengths, &entry->baseline_invalid);
+  const VkrHarnessSampleStream candidate = vkr_harness_gather_series(
+      document->candidate, candidate_column, pass_series, candidate_values,
+      candidate_lengths, &entry->candidate_invalid);
+  VkrHarnessRegressionConfig config = document->config;
+  config.lower_is_better =
+      entry->direction != VKR_HARNESS_DIRECTION_HIGHER_IS_BETTER;
+  if (!vkr_harness_regression_compare(&baseline, &candidate, &config,
+                                      transient, &entry->result)) {
+    vkr_harness_error_set(error, "compare.statistics", name,
+                          "Unable to compare '%s'", name);
+    return false_v;
+  }
+  if (entry->direction == VKR_HARNESS_DIRECTION_NONE &&
+      entry->result.verdict != VKR_HARNESS_REGRESSION_INCONCLUSIVE) {
+    entry->result.verdict = VKR_HARNESS_REGRESSION_INCONCLUSIVE;
+    entry->result.reason = "metric.undirected";
+  }
+  if (entry->result.verdict == VKR_HARNESS_REGRESSION_REGRESSED) {
+    document->verdict = VKR_HARNESS_REGRESSION_REGRESSED;
+  } else if (entry->result.verdict == VKR_HARNESS_REGRESSION_IMPROVED &&
+             document->verdict == VKR_HARNESS_REGRESSION_INCONCLUSIVE) {
+    document->verdict = VKR_HARNESS_REGRESSION_IMPROVED;
+  }
+  return true_v;
+}
+
+static void vkr_harness_regression_unmatched(
+    VkrHarnessRegressionDocument *document, const char *format,
+    const char *name) {
+  string_format(document->unmatched[document->unmatched_count++],
+                sizeof(document->unmatched[0]), format, name);
+}
+
+static bool8_t vkr_harness_regression_compare_runs(
+    VkrHarnessRegressionDocument *document, const VkrHarnessArenas *arenas,
+    VkrHarnessError *error) {
+  const VkrHarnessSampleSet *base = &document->baseline->runs[0];
+  const VkrHarnessSampleSet *cand = &document->candidate->runs[0];
+  const uint32_t capacity =
+      cand->header.metric_count + 2u * cand->header.pass_count;
+  const uint64_t baseline_capacity =
+      (uint64_t)base->header.measure_frames * document->baseline->run_count;
+  const uint64_t candidate_capacity =
+      (uint64_t)cand->header.measure_frames * document->candidate->run_count;
+  document->entries = arena_alloc(
+      arenas->persistent, Max(capacity, 1u) * sizeof(*document->entries),
+      ARENA_MEMORY_TAG_STRUCT);
+  document->unmatched = arena_alloc(
+      arenas->persistent, Max(capacity, 1u) * sizeof(*document->unmatched),
+      ARENA_MEMORY_TAG_STRUCT);
+  Scratch scratch = scratch_create(arenas->transient);
+  float64_t *baseline_values =
+      arena_alloc(arenas->transient,
+                  Max(baseline_capacity, 1u) * sizeof(*baseline_values),
+                  ARENA_MEMORY_TAG_ARRAY);
+  float64_t *candidate_values =
+      arena_alloc(arenas->transient,
+                  Max(candidate_capacity, 1u) * sizeof(*candidate_values),
+                  ARENA_MEMORY_TAG_ARRAY);
+  if (!document->entries || !document->unmatched || !baseline_values ||
+      !candidate_values) {
+    scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+    vkr_harness_error_set(error, "compare.allocate", "$",
+                          "Unable to allocate the regression tables");
+    return false_v;
+  }
+  MemZero(document->entries, Max(capacity, 1u) * sizeof(*document->entries));
+  bool8_t ok = true_v;
+  for (uint32_t i = 0; ok && i < cand->header.metric_count; ++i) {
+    const int32_t match = vkr_harness_find_metric(base, &cand->metrics[i]);
+    if (match < 0) {
+      vkr_harness_regression_unmatched(document, "%s", cand->metrics[i].name);
+      continue;
+    }
+    ok = vkr_harness_regression_add(
+        document, cand->metrics[i].name, cand->metrics[i].unit,
+        (uint32_t)match, i, 0u, baseline_values, candidate_values,
+        arenas->transient, error);
+  }
+  for (uint32_t i = 0; ok && i < cand->header.pass_count; ++i) {
+    const char *pass = cand->passes[i].name;
+    const int32_t match = vkr_harness_find_pass(base, pass);
+    if (match < 0) {
+      vkr_harness_regression_unmatched(document, "pass.%s", pass);
+      continue;
+    }
+    for (uint32_t series = 1u; ok && series <= 2u; ++series) {
+      char name[160];
+      string_format(name, sizeof(name), "pass.%s.%s", pass,
+                    series == 1u ? "cpu" : "gpu");
+      ok = vkr_harness_regression_add(document, name, "ms", (uint32_t)match, i,
+                                      series, baseline_values, candidate_values,
+                                      arenas->transient, error);
+    }
+  }
+  scratch_destroy(scratch, ARENA_MEMORY_TAG_ARRAY);
+  return ok;
+}
+
+static bool8_t vkr_harness_emit_interval(VkrJsonWriter *writer,
+                                         const char *name,
+                                         const VkrHarnessInterval *interval) {
+  return vkr_harness_json_emit_name(writer, name) &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_f64(writer, "estimate", interval->estimate) &&
+         vkr_harness_json_emit_f64(writer, "lower", interval->lower) &&
+         vkr_harness_json_emit_f64(writer, "upper", interval->upper) &&
+         vkr_json_writer_end_object(writer);
+}
+
+static bool8_t vkr_harness_emit_relative(VkrJsonWriter *writer,
+                                         const char *name,
+                                         const VkrHarnessInterval *interval,
+                                         bool8_t defined) {
+  if (!defined) {
+    return vkr_harness_json_emit_name(writer, name) &&
+           vkr_json_writer_null(writer);
+  }
+  return vkr_harness_emit_interval(writer, name, interval);
+}
+
+static bool8_t
+vkr_harness_emit_stream_summary(VkrJsonWriter *writer, const char *name,
+                                const VkrHarnessStreamSummary *summary,
+                                uint64_t invalid) {
+  bool8_t ok =
+      vkr_harness_json_emit_name(writer, name) &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_u64(writer, "samples", summary->sample_count) &&
+      vkr_harness_json_emit_u64(writer, "invalid", invalid) &&
+      vkr_harness_json_emit_u64(writer, "warmup_trimmed",
+                                summary->warmup_trimmed) &&
+      vkr_harness_json_emit_u64(writer, "outliers_rejected",
+                                summary->outliers_rejected) &&
+      vkr_harness_emit_interval(writer, "p50", &summary->p50) &&
+      vkr_harness_emit_interval(writer, "p95", &summary->p95) &&
+      vkr_harness_json_emit_name(writer, "change_points") &&
+      vkr_json_writer_begin_array(writer);
+  for (uint32_t i = 0; ok && i < summary->change_point_count; ++i) {
+    ok = vkr_json_writer_u64(writer, summary->change_points[i]);
+  }
+  return ok && vkr_json_writer_end_array(writer) &&
+         vkr_json_writer_end_object(writer);
+}
+
+static bool8_t vkr_harness_emit_regression_entry(
+    VkrJsonWriter *writer, const VkrHarnessRegressionEntry *entry) {
+  const VkrHarnessRegressionResult *result = &entry->result;
+  return vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_string(writer, "name", entry->name) &&
+         vkr_harness_json_emit_string(writer, "unit", entry->unit) &&
+         vkr_harness_json_emit_string(
+             writer, "direction",
+             vkr_harness_metric_direction_name(entry->direction)) &&
+         vkr_harness_json_emit_string(
+             writer, "verdict",
+             vkr_harness_regression_verdict_name(result->verdict)) &&
+         vkr_harness_json_emit_string(writer, "reason", result->reason) &&
+         vkr_harness_emit_stream_summary(writer, "baseline", &result->baseline,
+                                         entry->baseline_invalid) &&
+         vkr_harness_emit_stream_summary(writer, "candidate",
+                                         &result->candidate,
+                                         entry->candidate_invalid) &&
+         vkr_harness_json_emit_name(writer, "effect") &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_emit_interval(writer, "p50_delta", &result->p50_delta) &&
+         vkr_harness_emit_interval(writer, "p95_delta", &result->p95_delta) &&
+         vkr_harness_emit_relative(writer, "p50_relative",
+                                   &result->p50_relative,
+                                   result->relative_defined) &&
+         vkr_harness_emit_relative(writer, "p95_relative",
+                                   &result->p95_relative,
+                                   result->relative_defined) &&
+         vkr_harness_json_emit_f64(writer, "cliffs_delta",
+                                   result->cliffs_delta) &&
+         vkr_json_writer_end_object(writer) &&
+         vkr_harness_json_emit_name(writer, "tests") &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_name(writer, "mann_whitney") &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_f64(writer, "u", result->mann_whitney_u) &&
+         vkr_harness_json_emit_f64(writer, "z", result->mann_whitney_z) &&
+         vkr_harness_json_emit_f64(writer, "p", result->mann_whitney_p) &&
+         vkr_json_writer_end_object(writer) &&
+         vkr_harness_json_emit_name(writer, "kolmogorov_smirnov") &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_f64(writer, "d", result->ks_statistic) &&
+         vkr_harness_json_emit_f64(writer, "p", result->ks_p) &&
+         vkr_json_writer_end_object(writer) &&
+         vkr_json_writer_end_object(writer) &&
+         vkr_json_writer_end_object(writer);
+}
+
+static bool8_t vkr_harness_emit_run(VkrJsonWriter *writer, const char *name,
+                                    const char *path,
+                                    const VkrHarnessProfileRun *run) {
+  return vkr_harness_json_emit_name(writer, name) &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_string(writer, "run", path) &&
+         vkr_harness_json_emit_u64(writer, "repetitions", run->run_count) &&
+         vkr_json_writer_end_object(writer);
+}
+
+static bool8_t
+vkr_harness_regression_write(const char *path,
+                             const VkrHarnessRegressionDocument *document,
+                             VkrHarnessError *error) {
+  VkrJsonFileWriter file_writer = {0};
+  if (!vkr_json_file_writer_begin(
+          &file_writer,
+          string8_create_from_cstr((const uint8_t *)path,
+                                   string_length(path)))) {
+    vkr_harness_error_set(error, "report.open", "$",
+                          "Unable to begin report '%s'", path);
+    return false_v;
+  }
+  VkrJsonWriter *writer = &file_writer.writer;
+  const VkrHarnessRegressionConfig *config = &document->config;
+  const VkrHarnessRunReference *identity = &document->candidate->identity;
+  uint32_t tally[3] = {0};
+  for (uint32_t i = 0; i < document->entry_count; ++i) {
+    tally[document->entries[i].result.verdict]++;
+  }
+  bool8_t ok =
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_u64(writer, "schema_version",
+                                VKR_HARNESS_SCHEMA_VERSION) &&
+      vkr_harness_json_emit_string(writer, "kind", "vkr.harness.regression") &&
+      vkr_harness_json_emit_string(writer, "run_id", document->run_id) &&
+      vkr_harness_json_emit_string(
+          writer, "verdict",
+          vkr_harness_regression_verdict_name(document->verdict)) &&
+      vkr_harness_json_emit_u64(writer, "exit_code", document->exit_code) &&
+      vkr_harness_emit_run(writer, "baseline", document->baseline_run,
+                           document->baseline) &&
+      vkr_harness_emit_run(writer, "candidate", document->candidate_run,
+                           document->candidate) &&
+      vkr_harness_json_emit_name(writer, "comparison") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_string(writer, "environment_fingerprint",
+                                   identity->environment_fingerprint) &&
+      vkr_harness_json_emit_string(writer, "workload_fingerprint",
+                                   identity->workload_fingerprint) &&
+      vkr_harness_json_emit_string(writer, "policy_fingerprint",
+                                   identity->policy_fingerprint) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "policy") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_f64(writer, "alpha", config->alpha) &&
+      vkr_harness_json_emit_f64(writer, "confidence", config->confidence) &&
+      vkr_harness_json_emit_u64(writer, "bootstrap_iterations",
+                                config->bootstrap_iterations) &&
+      vkr_harness_json_emit_u64(writer, "bootstrap_seed",
+                                config->bootstrap_seed) &&
+      vkr_harness_json_emit_f64(writer, "min_relative_effect",
+                                config->min_relative_effect) &&
+      vkr_harness_json_emit_f64(writer, "outlier_limit",
+                                config->outlier_limit) &&
+      vkr_harness_json_emit_u64(writer, "warmup_batch_size",
+                                config->warmup_batch_size) &&
+      vkr_harness_json_emit_u64(writer, "change_point_batch_size",
+                                config->change_point_batch_size) &&
+      vkr_harness_json_emit_u64(writer, "min_samples", config->min_samples) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "summary") &&
+      vkr_json_writer_begin_object(writer) &&
+      vkr_harness_json_emit_u64(writer, "regressed",
+                                tally[VKR_HARNESS_REGRESSION_REGRESSED]) &&
+      vkr_harness_json_emit_u64(writer, "improved",
+                                tally[VKR_HARNESS_REGRESSION_IMPROVED]) &&
+      vkr_harness_json_emit_u64(writer, "inconclusive",
+                                tally[VKR_HARNESS_REGRESSION_INCONCLUSIVE]) &&
+      vkr_json_writer_end_object(writer) &&
+      vkr_harness_json_emit_name(writer, "metrics") &&
+      vkr_json_writer_begin_array(writer);
+  for (uint32_t i = 0; ok && i < document->entry_count; ++i) {
+    ok = vkr_harness_emit_regression_entry(writer, &document->entries[i]);
+  }
+  ok = ok && vkr_json_writer_end_array(writer) &&
+       vkr_harness_json_emit_name(writer, "unmatched") &&
+       vkr_json_writer_begin_array(writer);
+  for (uint32_t i = 0; ok && i < document->unmatched_count; ++i) {
+    const char *name = document->unmatched[i];
+    ok = vkr_json_writer_string(
+        writer,
+        string8_create_from_cstr((const uint8_t *)name, string_length(name)));
+  }
+  ok = ok && vkr_json_writer_end_array(writer) &&
+       vkr_json_writer_end_object(writer);
+  if (!ok || !vkr_json_file_writer_commit(&file_writer)) {
+    vkr_json_file_writer_abort(&file_writer);
+    vkr_harness_error_set(error, "report.write", "$",
+                          "Unable to write report '%s'", path);
+    return false_v;
+  }
+  return true_v;
+}
+
+int vkr_harness_compare_profile_runs(const char *repo_root,
+                                     const char *run_path,
+                                     const char *baseline_path) {
+  if (!repo_root || !run_path || !baseline_path) {
+    return VKR_HARNESS_EXIT_INVALID;
+  }
+  Arena *arena = arena_create();
+  Arena *transient = arena_create();
+  VkrHarnessError error = {0};
+  int result = VKR_HARNESS_EXIT_ERROR;
+  if (!arena || !transient) {
+    goto cleanup;
+  }
+  const VkrHarnessArenas arenas = {.persistent = arena, .transient = transient};
+  VkrHarnessProfileRun *baseline = arena_alloc(
+      arena, 2u * sizeof(VkrHarnessProfileRun), ARENA_MEMORY_TAG_STRUCT);
+  if (!baseline) {
+    goto cleanup;
+  }
+  MemZero(baseline, 2u * sizeof(VkrHarnessProfileRun));
+  VkrHarnessProfileRun *candidate = baseline + 1;
+  if (!vkr_harness_profile_run_load(repo_root, baseline_path, &arenas,
+                                    baseline, &error) ||
+      !vkr_harness_profile_run_load(repo_root, run_path, &arenas, candidate,
+                                    &error)) {
+    result = VKR_HARNESS_EXIT_INVALID;
+    goto cleanup;
+  }
+  /* Two runs are only comparable as one experiment on one machine; a changed
+     environment, workload, or policy would be measured as a regression. */
+  if (!string_equals(baseline->identity.environment_fingerprint,
+                     candidate->identity.environment_fingerprint) ||
+      !string_equals(baseline->identity.workload_fingerprint,
+                     candidate->identity.workload_fingerprint) ||
+      !string_equals(baseline->identity.policy_fingerprint,
+                     candidate->identity.policy_fingerprint)) {
+    vkr_harness_stderr("baseline.fingerprint_mismatch: runs are not "
+                       "comparable\n");
+    result = VKR_HARNESS_EXIT_MISSING_BASELINE;
+    goto cleanup;
+  }
+  VkrHarnessRegressionDocument document = {
+      .baseline_run = baseline_path,
+      .candidate_run = run_path,
+      .baseline = baseline,
+      .candidate = candidate,
+      .config = vkr_harness_regression_config_default(),
+      .verdict = VKR_HARNESS_REGRESSION_INCONCLUSIVE,
+  };
+  if (!vkr_harness_regression_compare_runs(&document, &arenas, &error)) {
+    goto cleanup;
+  }
+  document.exit_code =
+      document.verdict == VKR_HARNESS_REGRESSION_REGRESSED
+          ? VKR_HARNESS_EXIT_FAIL
+          : VKR_HARNESS_EXIT_PASS;
+  char artifact_candidate[VKR_HARNESS_PATH_MAX];
+  char artifact_root[VKR_HARNESS_PATH_MAX];
+  char compare_root[VKR_HARNESS_PATH_MAX];
+  string_format(artifact_candidate, sizeof(artifact_candidate), "%s/%s",
+                repo_root, "build/_artifacts/compare");
+  if (!vkr_harness_make_directories(artifact_candidate, &error) ||
+      !vkr_harness_realpath(artifact_candidate, artifact_root) ||
+      !vkr_harness_create_run_root(artifact_root, document.run_id,
+                                   compare_root)) {
+    goto cleanup;
+  }
+  char report_path[VKR_HARNESS_PATH_MAX];
+  char digest[VKR_HARNESS_DIGEST_MAX];
+  string_format(report_path, sizeof(report_path), "%s/regression.json",
+                compare_root);
+  if (!vkr_harness_regression_write(report_path, &document, &error) ||
+      !vkr_harness_sha256_file(report_path, digest)) {
+    goto cleanup;
+  }
+  vkr_harness_stdout(
+      "{\"verdict\":\"%s\",\"exit_code\":%u,\"report\":"
+      "\"build/_artifacts/compare/%s/regression.json\",\"sha256\":\"%s\"}\n",
+      vkr_harness_regression_verdict_name(document.verdict),
+      document.exit_code, document.run_id, digest);
+  result = document.exit_code;
+cleanup:
+  if (result != VKR_HARNESS_EXIT_PASS && result != VKR_HARNESS_EXIT_FAIL &&
+      error.message[0]) {
+    vkr_harness_stderr("%s: %s\n", error.code, error.message);
+  }
+  arena_destroy(transient);
+  arena_destroy(arena);
+  return result;
+}
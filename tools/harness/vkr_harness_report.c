@@ -70,6 +70,30 @@ vkr_harness_report_write_statistics(VkrJsonWriter *writer,
   return vkr_harness_report_write_statistics_reason(writer, metric, NULL);
 }
 
+/** Optional per-capture `quality`; only color comparisons that ran have one. */
+static bool8_t
+vkr_harness_report_write_quality(VkrJsonWriter *writer,
+                                 const VkrHarnessImageQuality *quality) {
+  if (!quality || !quality->measured) {
+    return true_v;
+  }
+  return vkr_harness_json_emit_name(writer, "quality") &&
+         vkr_json_writer_begin_object(writer) &&
+         vkr_harness_json_emit_bool(writer, "identical", quality->identical) &&
+         vkr_harness_json_emit_f64(writer, "psnr_db", quality->psnr_db) &&
+         vkr_harness_json_emit_f64(writer, "ssim", quality->ssim) &&
+         vkr_harness_json_emit_f64(writer, "ms_ssim", quality->ms_ssim) &&
+         vkr_harness_json_emit_f64(writer, "flip_mean", quality->flip_mean) &&
+         vkr_harness_json_emit_f64(writer, "flip_max", quality->flip_max) &&
+         vkr_harness_json_emit_u64(writer, "tiles_x", quality->tiles_x) &&
+         vkr_harness_json_emit_u64(writer, "tiles_y", quality->tiles_y) &&
+         vkr_harness_json_emit_string(writer, "heatmap_path",
+                                      quality->heatmap_path) &&
+         vkr_harness_json_emit_string(writer, "heatmap_sha256",
+                                      quality->heatmap_sha256) &&
+         vkr_json_writer_end_object(writer);
+}
+
 bool8_t vkr_harness_report_init_storage(VkrHarnessReport *report, Arena *arena,
                                         uint32_t capture_capacity,
                                         uint32_t artifact_capacity) {
@@ -80,15 +104,20 @@ bool8_t vkr_harness_report_init_storage(VkrHarnessReport *report, Arena *arena,
   artifact_capacity = Min(artifact_capacity, VKR_HARNESS_MAX_ARTIFACTS);
   const uint64_t capture_bytes =
       (uint64_t)capture_capacity * sizeof(VkrHarnessCaptureResult);
+  const uint64_t quality_bytes =
+      (uint64_t)capture_capacity * sizeof(VkrHarnessImageQuality);
   const uint64_t artifact_bytes =
       (uint64_t)artifact_capacity * sizeof(VkrHarnessArtifact);
   report->captures = capture_capacity ? arena_alloc(arena, capture_bytes,
                                                     ARENA_MEMORY_TAG_ARRAY)
                                       : NULL;
+  report->quality = capture_capacity ? arena_alloc(arena, quality_bytes,
+                                                   ARENA_MEMORY_TAG_ARRAY)
+                                     : NULL;
   report->artifacts = artifact_capacity ? arena_alloc(arena, artifact_bytes,
                                                       ARENA_MEMORY_TAG_ARRAY)
                                         : NULL;
-  if ((capture_capacity && !report->captures) ||
+  if ((capture_capacity && (!report->captures || !report->quality)) ||
       (artifact_capacity && !report->artifacts)) {
     return false_v;
   }
@@ -96,6 +125,7 @@ bool8_t vkr_harness_report_init_storage(VkrHarnessReport *report, Arena *arena,
      each row it is told exists. */
   if (report->captures) {
     MemZero(report->captures, capture_bytes);
+    MemZero(report->quality, quality_bytes);
   }
   if (report->artifacts) {
     MemZero(report->artifacts, artifact_bytes);
@@ -438,6 +468,8 @@ bool8_t vkr_harness_report_write(const char *path,
                                  VKR_METRICS_ENABLED ? true_v : false_v) &&
       vkr_harness_json_emit_bool(writer, "events_enabled",
                                  report->profile.event_subjects) &&
+      vkr_harness_json_emit_string(
+          writer, "trace", vkr_harness_trace_name(report->profile.trace)) &&
       vkr_json_writer_end_object(writer) &&
       vkr_harness_json_emit_name(writer, "execution") &&
       vkr_json_writer_begin_object(writer) &&
@@ -633,6 +665,8 @@ bool8_t vkr_harness_report_write(const char *path,
         vkr_harness_json_emit_f64(writer, "failed_pixel_ratio",
                                   capture->comparison.failed_pixel_ratio) &&
         vkr_json_writer_end_object(writer) &&
+        vkr_harness_report_write_quality(
+            writer, report->quality ? &report->quality[i] : NULL) &&
         vkr_json_writer_end_object(writer);
   }
   ok = ok && vkr_json_writer_end_array(writer) &&
@@ -102,6 +102,9 @@ bool8_t vkr_harness_samples_write(const char *path,
  * Rejects any file whose magic, schema version, frame counts, or total length
  * disagrees with what `case_manifest` requires, so a truncated or stale child
  * artifact can never be aggregated. The result borrows `persistent`.
+ *
+ * A NULL `case_manifest` takes the frame counts from the header; readers of a
+ * finished run check them against each other instead.
  */
 bool8_t vkr_harness_samples_read(const char *path,
                                  const VkrHarnessCase *case_manifest,
@@ -178,14 +181,22 @@ bool8_t vkr_harness_capture_png_write(const char *path, const uint8_t *rgba,
                                       uint32_t width, uint32_t height,
                                       const VkrHarnessArenas *arenas,
                                       VkrHarnessError *error);
+/**
+ * Compares every actual capture row against its baseline row. A row whose data
+ * digest matches the baseline's passes without being decoded. `quality` is
+ * optional and parallel to `actual`; color rows report perceptual metrics
+ * there, and a FLIP heatmap beside any diff image.
+ */
 VkrHarnessExitCode vkr_harness_compare_capture_sets(
     const char *actual_root, const char *baseline_root,
-    VkrHarnessCaptureResult *actual, uint32_t actual_count,
-    const VkrHarnessCaptureResult *baseline, uint32_t baseline_count,
-    const VkrHarnessArenas *arenas, VkrHarnessError *error);
+    VkrHarnessCaptureResult *actual, VkrHarnessImageQuality *quality,
+    uint32_t actual_count, const VkrHarnessCaptureResult *baseline,
+    uint32_t baseline_count, const VkrHarnessArenas *arenas,
+    VkrHarnessError *error);
 /**
- * Registers every diff image a comparison produced. Diffs are written beside
- * the captures they explain, so `run_root` is the report's own run root.
+ * Registers every diff and heatmap image a comparison produced. Both are
+ * written beside the captures they explain, so `run_root` is the report's own
+ * run root.
  */
 void vkr_harness_compare_publish_diffs(VkrHarnessReport *report,
                                        const char *run_root);
@@ -194,6 +205,15 @@ int vkr_harness_baseline_propose(const char *repo_root, const char *from_run,
 int vkr_harness_baseline_accept(const char *repo_root, const char *plan_path,
                                 const char *confirmation);
 int vkr_harness_compare_run(const char *repo_root, const char *run_path);
+/**
+ * Compares two `profile` runs metric by metric with
+ * `vkr_harness_regression_compare()` and publishes `regression.json` under
+ * `build/_artifacts/compare/`. Both runs must share all three comparison
+ * fingerprints. Exits FAIL when any metric regressed.
+ */
+int vkr_harness_compare_profile_runs(const char *repo_root,
+                                     const char *run_path,
+                                     const char *baseline_path);
 
 typedef struct VkrHarnessCaptureSummary {
   VkrHarnessTool tool;
@@ -115,8 +115,9 @@ bool8_t vkr_harness_samples_read(const char *path,
       header.metric_count > VKR_METRICS_MAX_SLOTS ||
       header.pass_count > VKR_METRICS_MAX_SLOTS ||
       header.event_count > VKR_HARNESS_MAX_EVENTS ||
-      header.warmup_frames != case_manifest->warmup_frames ||
-      header.measure_frames != case_manifest->measure_frames) {
+      (case_manifest &&
+       (header.warmup_frames != case_manifest->warmup_frames ||
+        header.measure_frames != case_manifest->measure_frames))) {
     return false_v;
   }
   const VkrHarnessSampleLayout layout = vkr_harness_sample_layout(&header);
@@ -248,8 +248,9 @@ int vkr_harness_snapshot_run(const char *executable, const char *repo_root,
   }
   if (!vkr_harness_report_init_storage(
           &report, summary_arena, merged_captures,
-          (merged_captures * VKR_HARNESS_ARTIFACTS_PER_CAPTURE) + replay_count +
-              merged_captures + 2u) ||
+          (merged_captures * (VKR_HARNESS_ARTIFACTS_PER_CAPTURE +
+                              VKR_HARNESS_COMPARISON_ARTIFACTS_PER_CAPTURE)) +
+              replay_count + 2u) ||
       !vkr_harness_report_init_auxiliary_runs(&report, summary_arena,
                                               replay_count)) {
     vkr_harness_stderr("Unable to size the snapshot report tables\n");
@@ -415,7 +416,7 @@ int vkr_harness_snapshot_run(const char *executable, const char *repo_root,
       const VkrHarnessExitCode comparison =
           comparison_transient
               ? vkr_harness_compare_capture_sets(
-                    run_root, baseline_root, report.captures,
+                    run_root, baseline_root, report.captures, report.quality,
                     report.capture_count, baseline.captures,
                     baseline.capture_count, &comparison_arenas, &error)
               : VKR_HARNESS_EXIT_ERROR;